@@ -0,0 +1,204 @@
+#!/bin/sh
+
+# Copyright 2018 NXP
+
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+# * Redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer.
+# * Redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution.
+# * Neither the name of the above-listed copyright holders nor the
+# names of any contributors may be used to endorse or promote products
+# derived from this software without specific prior written permission.
+
+
+# ALTERNATIVELY, this software may be distributed under the terms of the
+# GNU General Public License ("GPL") as published by the Free Software
+# Foundation, either version 2 of that License or (at your option) any
+# later version.
+
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+##	restool benchmark driver
+#
+# Runs restool operations against the simulated MC in bench/fake_mc.c for a
+# range of synthetic topologies and writes one CSV row per operation:
+#
+#	operation,objects,depth,wall_us,mc_commands,max_rss_kb
+#
+# wall_us is the best of $BENCH_RUNS runs measured inside restool-bench,
+# max_rss_kb the largest peak RSS seen. Leaf objects cycle through 8 types
+# so dpni.$last is the dpni found last by any container scan.
+#
+# Usage:
+#	run-bench.sh [-o <baseline.csv>] [-c <old-baseline.csv>]
+#		     [-b <budgets.csv>]
+#
+#	-o	where to write the results (default bench-<version>.csv)
+#	-c	print each result next to the same row of an older baseline
+#	-b	fail if an operation issues more MC commands than its budget
+#
+# A budget file has a header line then rows of
+# operation,objects,depth,max_mc_commands, '#' lines being comments. The
+# simulated MC is deterministic, so the command counts are exact and any
+# extra round trip trips the check. Results without a budget row are not
+# checked.
+#
+# BENCH_SIZES, BENCH_DEPTHS and BENCH_RUNS override the defaults below.
+##
+
+BENCH_SIZES=${BENCH_SIZES:-"10 100 1000 10000"}
+BENCH_DEPTHS=${BENCH_DEPTHS:-"1 4 16"}
+BENCH_RUNS=${BENCH_RUNS:-3}
+BENCH_TYPES=8
+
+bench_dir=$(dirname "$0")
+restool="$bench_dir/../restool-bench"
+version=$(git -C "$bench_dir" describe --always 2>/dev/null || echo unknown)
+out="bench-$version.csv"
+old=""
+budgets=""
+
+while getopts "o:c:b:" opt; do
+	case $opt in
+	o) out=$OPTARG ;;
+	c) old=$OPTARG ;;
+	b) budgets=$OPTARG ;;
+	*) echo "usage: $0 [-o <baseline.csv>] [-c <old-baseline.csv>]" \
+		"[-b <budgets.csv>]" >&2
+	   exit 1 ;;
+	esac
+done
+
+if [ ! -x "$restool" ]; then
+	echo "$restool not found, run 'make restool-bench' first" >&2
+	exit 1
+fi
+
+report=$(mktemp)
+errors=$(mktemp)
+trap 'rm -f "$report" "$errors"' EXIT
+
+# bench_op <name> <restool arguments...>
+# A failing operation ends the run: its timing would measure the error path.
+bench_op()
+{
+	name=$1
+	shift
+	: > "$report"
+	run=0
+	while [ $run -lt "$BENCH_RUNS" ]; do
+		if ! RESTOOL_BENCH_REPORT="$report" \
+			"$restool" --root=dprc.1 "$@" > /dev/null 2> "$errors"
+		then
+			echo "$name on $RESTOOL_BENCH_OBJECTS objects," \
+			     "depth $RESTOOL_BENCH_DEPTH failed:" >&2
+			cat "$errors" >&2
+			exit 1
+		fi
+		run=$((run + 1))
+	done
+	awk -v op="$name" -v n="$RESTOOL_BENCH_OBJECTS" \
+	    -v d="$RESTOOL_BENCH_DEPTH" '
+		{
+			for (i = 1; i <= NF; i++) {
+				split($i, kv, "=")
+				v[kv[1]] = kv[2] + 0
+			}
+			if (NR == 1 || v["wall_us"] < wall)
+				wall = v["wall_us"]
+			if (v["max_rss_kb"] > rss)
+				rss = v["max_rss_kb"]
+			cmds = v["mc_commands"]
+		}
+		END {
+			# no report: restool-bench crashed before exit
+			if (NR == 0)
+				wall = cmds = rss = -1
+			printf "%s,%s,%s,%d,%d,%d\n", op, n, d, wall, cmds, rss
+		}
+	' "$report" >> "$out"
+}
+
+# join on operation,objects,depth and show old -> new for every metric
+bench_compare()
+{
+	awk -F, '
+		NR == FNR { base[$1 FS $2 FS $3] = $0; next }
+		FNR == 1 {
+			printf "%-18s %7s %5s %21s %17s %17s\n", "operation",
+			       "objects", "depth", "wall_us", "mc_commands",
+			       "max_rss_kb"
+			next
+		}
+		{
+			split(base[$1 FS $2 FS $3], b, FS)
+			printf "%-18s %7s %5s %10s->%-10s %8s->%-8s %8s->%-8s\n",
+			       $1, $2, $3, b[4], $4, b[5], $5, b[6], $6
+		}
+	' "$old" "$out"
+}
+
+echo "operation,objects,depth,wall_us,mc_commands,max_rss_kb" > "$out"
+for objects in $BENCH_SIZES; do
+	for depth in $BENCH_DEPTHS; do
+		export RESTOOL_BENCH_OBJECTS=$objects
+		export RESTOOL_BENCH_DEPTH=$depth
+		last_dpni=dpni.$(((objects - 1) / BENCH_TYPES))
+
+		bench_op "dprc list" dprc list
+		bench_op "dprc show" dprc show dprc.1
+		bench_op "dpni info" dpni info "$last_dpni"
+		bench_op "dpni destroy" dpni destroy "$last_dpni"
+		bench_op "dprc generate-dpl" dprc generate-dpl dprc.1
+	done
+done
+
+if [ -z "$old" ]; then
+	column -s, -t "$out" 2>/dev/null || cat "$out"
+	echo "baseline written to $out"
+else
+	bench_compare
+fi
+
+[ -z "$budgets" ] && exit 0
+
+awk -F, '
+	NR == FNR {
+		if ($0 !~ /^#/ && $1 != "operation")
+			budget[$1 FS $2 FS $3] = $4
+		next
+	}
+	FNR == 1 { next }
+	($1 FS $2 FS $3) in budget {
+		checked++
+		if ($5 < 0) {
+			printf "%s on %s objects, depth %s did not complete\n",
+			       $1, $2, $3
+			failed++
+		} else if ($5 > budget[$1 FS $2 FS $3]) {
+			printf "MC command budget exceeded: %s on %s objects, " \
+			       "depth %s: %d > %d\n", $1, $2, $3, $5,
+			       budget[$1 FS $2 FS $3]
+			failed++
+		}
+	}
+	END {
+		printf "%d of %d MC command budgets exceeded\n",
+		       failed, checked
+		exit failed > 0
+	}
+' "$budgets" "$out"
+
@@ -37,16 +37,18 @@
 #include <fcntl.h>		/* open() */
 #include <unistd.h>		/* close() */
 #include <sys/ioctl.h>
+#include <sys/mman.h>
 #include "fsl_mc_sys.h"
 #include "fsl_mc_ioctl.h"
 #include "utils.h"
 
 int mc_io_init(struct fsl_mc_io *mc_io)
 {
+	struct restool *ctx = restool_from_mc_io(mc_io);
 	int fd = -1;
 	int error;
 
-	fd = open(restool.device_file, O_RDWR | O_SYNC);
+	fd = open(ctx->device_file, O_RDWR | O_SYNC);
 
 	if (fd < 0) {
 		error = -errno;
@@ -74,11 +76,17 @@ void mc_io_cleanup(struct fsl_mc_io *mc_io)
 		perror("close failed");
 }
 
-int mc_send_command(struct fsl_mc_io *mc_io, struct mc_command *cmd)
+static int mc_send_command_once(struct restool *ctx, struct fsl_mc_io *mc_io,
+				struct mc_command *cmd)
 {
 	int error;
 
-	if (strcmp(restool.device_file, "/dev/mc_restool") == 0)
+	trace_mc_begin(ctx, cmd->header);
+	error = container_lock_cmd(ctx, cmd);
+	if (error < 0)
+		goto out;
+
+	if (strcmp(ctx->device_file, "/dev/mc_restool") == 0)
 		error = ioctl(mc_io->fd, RESTOOL_SEND_MC_COMMAND_LEGACY, cmd);
 	else
 		error = ioctl(mc_io->fd, RESTOOL_SEND_MC_COMMAND, cmd);
@@ -90,5 +98,111 @@ int mc_send_command(struct fsl_mc_io *mc_io, struct mc_command *cmd)
 			error);
 	}
 
+	container_lock_cmd_done(ctx, cmd, error);
+out:
+	trace_mc_end(ctx, cmd->header, error);
+	return error;
+}
+
+/*
+ * Command extensions (key profiles, rule keys and masks) are read by the MC
+ * from memory. The restool driver offers no DMA mapping to user space, so the
+ * only address restool can give is the physical one of a locked page, taken
+ * from /proc/self/pagemap. It is only right when the SMMU does not translate
+ * the MC's accesses (bypass, or the kernel booted with iommu.passthrough=1)
+ * and the page stays put for the command: MAP_LOCKED keeps it resident but
+ * does not stop the kernel migrating or compacting it. The caller must opt in
+ * with --dma-phys. Reading the frame numbers requires CAP_SYS_ADMIN.
+ */
+int mc_dma_alloc(struct fsl_mc_io *mc_io, size_t size,
+		 struct mc_dma_mem *mem)
+{
+	struct restool *ctx = restool_from_mc_io(mc_io);
+	long page_size = sysconf(_SC_PAGESIZE);
+	uint64_t entry, pfn;
+	void *vaddr;
+	ssize_t n;
+	int error;
+	int fd;
+
+	if (!ctx->dma_phys) {
+		ERROR_PRINTF("this command hands memory to the MC, which restool can only do by physical address\n"
+			     "rerun with --dma-phys if the SMMU bypasses the MC\n");
+		return -EPERM;
+	}
+
+	if (size == 0 || size > (size_t)page_size)
+		return -EINVAL;
+
+	vaddr = mmap(NULL, page_size, PROT_READ | PROT_WRITE,
+		     MAP_PRIVATE | MAP_ANONYMOUS | MAP_LOCKED | MAP_POPULATE,
+		     -1, 0);
+	if (vaddr == MAP_FAILED) {
+		error = -errno;
+		DEBUG_PRINTF("mmap() failed with error %d\n", error);
+		return error;
+	}
+
+	/* fault the page in, the MC must see it written */
+	memset(vaddr, 0, page_size);
+
+	fd = open("/proc/self/pagemap", O_RDONLY);
+	if (fd < 0) {
+		error = -errno;
+		goto error;
+	}
+
+	n = pread(fd, &entry, sizeof(entry),
+		  ((uintptr_t)vaddr / page_size) * sizeof(entry));
+	error = n == sizeof(entry) ? 0 : (n < 0 ? -errno : -EIO);
+	(void)close(fd);
+	if (error < 0)
+		goto error;
+
+	/* bit 63: page present, bits 0-54: page frame number */
+	pfn = entry & ((1ULL << 55) - 1);
+	if (!(entry & (1ULL << 63)) || pfn == 0) {
+		ERROR_PRINTF("cannot get the physical address of MC command memory (needs CAP_SYS_ADMIN)\n");
+		error = -EPERM;
+		goto error;
+	}
+
+	mem->vaddr = vaddr;
+	mem->iova = pfn * page_size;
+	mem->size = size;
+	return 0;
+
+error:
+	DEBUG_PRINTF("MC command memory allocation failed (error %d)\n",
+		     error);
+	(void)munmap(vaddr, page_size);
+	return error;
+}
+
+void mc_dma_free(struct fsl_mc_io *mc_io, struct mc_dma_mem *mem)
+{
+	(void)mc_io;
+	if (mem->vaddr != NULL)
+		(void)munmap(mem->vaddr, sysconf(_SC_PAGESIZE));
+
+	mem->vaddr = NULL;
+}
+
+int mc_send_command(struct fsl_mc_io *mc_io, struct mc_command *cmd)
+{
+	struct restool *ctx = restool_from_mc_io(mc_io);
+	struct mc_retry retry = { 0 };
+	struct mc_command sent = *cmd;
+	int error;
+
+	for ( ; ; ) {
+		error = mc_send_command_once(ctx, mc_io, cmd);
+		if (!mc_retry(ctx, sent.header, error, &retry))
+			break;
+
+		/* the response overwrote the command */
+		*cmd = sent;
+	}
+
 	return error;
 }
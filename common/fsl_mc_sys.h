@@ -35,6 +35,7 @@
 #define _FSL_MC_SYS_H
 
 #include <stdint.h>
+#include <stddef.h>
 
 struct mc_command;
 
@@ -51,4 +52,21 @@ void mc_io_cleanup(struct fsl_mc_io *mc_io);
 
 int mc_send_command(struct fsl_mc_io *mc_io, struct mc_command *cmd);
 
+/**
+ * struct mc_dma_mem - Memory the MC reads command extensions from
+ * @vaddr:	CPU address
+ * @iova:	I/O virtual address passed to the MC in the command
+ * @size:	Size in bytes, at most one page
+ */
+struct mc_dma_mem {
+	void *vaddr;
+	uint64_t iova;
+	size_t size;
+};
+
+int mc_dma_alloc(struct fsl_mc_io *mc_io, size_t size,
+		 struct mc_dma_mem *mem);
+
+void mc_dma_free(struct fsl_mc_io *mc_io, struct mc_dma_mem *mem);
+
 #endif /* _FSL_MC_SYS_H */
@@ -37,6 +37,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <time.h>
+#include <endian.h>
 #include "../restool.h"
 
 #define C_ASSERT(_cond) \
@@ -47,9 +48,15 @@
 
 #define ONE_BIT_MASK(_bit_index)     (UINT32_C(0x1) << (_bit_index))
 
+/**
+ * Set by --debug, per thread so that concurrent requests do not share it
+ */
+extern __thread bool restool_debug;
+
 #define ERROR_PRINTF(_fmt, ...) \
 do { \
-	if (restool.debug) \
+	output_flush(); \
+	if (restool_debug) \
 		fprintf(stderr, "%s:%d " _fmt, \
 			__func__, __LINE__, ##__VA_ARGS__); \
 	else \
@@ -58,7 +65,7 @@ do { \
 
 #define DEBUG_PRINTF(_fmt, ...)	\
 do { \
-	if (restool.debug) \
+	if (restool_debug) \
 		fprintf(stderr, "DBG: %s:%d: " _fmt, \
 			__func__, __LINE__, ##__VA_ARGS__); \
 } while (0)
@@ -78,4 +85,33 @@ do { \
 
 void diff_time(struct timespec *, struct timespec *, struct timespec *);
 
+/**
+ * 12-bit id of an MC command, at bit 52 in both the v9 and v10 headers
+ * (v10 keeps a command version in the 4 bits below it)
+ */
+static inline uint16_t mc_header_cmd_id(uint64_t header)
+{
+	return (le64toh(header) >> 52) & 0xfff;
+}
+
+/**
+ * 12-bit id of a v10 *_CMDID_* define, which carries the command version
+ * in its low 4 bits, for comparing with mc_header_cmd_id()
+ */
+#define MC_CMDID(_cmdid)	(((_cmdid) >> 4) & 0xfff)
+
+/**
+ * Token of an MC command, moved from bit 38 (10 bits) in v9 to bit 32
+ * (16 bits) in v10
+ */
+static inline uint16_t mc_header_token(const struct restool *ctx,
+				       uint64_t header)
+{
+	header = le64toh(header);
+	if (ctx->mc_fw_version.major == MC_FW_VERSION_9)
+		return (header >> 38) & 0x3ff;
+
+	return (header >> 32) & 0xffff;
+}
+
 #endif /* _UTILS_H */
@@ -0,0 +1,338 @@
+/* Copyright 2018 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#define _GNU_SOURCE	/* F_OFD_SETLK */
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "restool.h"
+#include "utils.h"
+#include "container_lock.h"
+#include "mc_v10/fsl_dprc_cmd.h"
+#include "mc_v10/fsl_dpaiop_cmd.h"
+#include "mc_v10/fsl_dpbp_cmd.h"
+#include "mc_v10/fsl_dpci_cmd.h"
+#include "mc_v10/fsl_dpcon_cmd.h"
+#include "mc_v10/fsl_dpdcei_cmd.h"
+#include "mc_v10/fsl_dpdmai_cmd.h"
+#include "mc_v10/fsl_dpdmux_cmd.h"
+#include "mc_v10/fsl_dpio_cmd.h"
+#include "mc_v10/fsl_dpmac_cmd.h"
+#include "mc_v10/fsl_dpmcp_cmd.h"
+#include "mc_v10/fsl_dpni_cmd.h"
+#include "mc_v10/fsl_dprtc_cmd.h"
+#include "mc_v10/fsl_dpseci_cmd.h"
+#include "mc_v10/fsl_dpsw_cmd.h"
+
+C_ASSERT(CONTAINER_LOCK_MAX_TOKENS >= 2 * MAX_DPRC_NESTING);
+C_ASSERT(CONTAINER_LOCK_MAX_HELD >= MAX_DPRC_NESTING + 1);
+
+/**
+ * Object create and destroy commands, sent with the token of the
+ * container the object is created in or destroyed from (v10), or with no
+ * token on the root container (v9, which uses the same ids)
+ */
+static bool is_obj_create_destroy(uint16_t cmd_id)
+{
+	switch (cmd_id) {
+	case MC_CMDID(DPAIOP_CMDID_CREATE):
+	case MC_CMDID(DPAIOP_CMDID_DESTROY):
+	case MC_CMDID(DPBP_CMDID_CREATE):
+	case MC_CMDID(DPBP_CMDID_DESTROY):
+	case MC_CMDID(DPCI_CMDID_CREATE):
+	case MC_CMDID(DPCI_CMDID_DESTROY):
+	case MC_CMDID(DPCON_CMDID_CREATE):
+	case MC_CMDID(DPCON_CMDID_DESTROY):
+	case MC_CMDID(DPDCEI_CMDID_CREATE):
+	case MC_CMDID(DPDCEI_CMDID_DESTROY):
+	case MC_CMDID(DPDMAI_CMDID_CREATE):
+	case MC_CMDID(DPDMAI_CMDID_DESTROY):
+	case MC_CMDID(DPDMUX_CMDID_CREATE):
+	case MC_CMDID(DPDMUX_CMDID_DESTROY):
+	case MC_CMDID(DPIO_CMDID_CREATE):
+	case MC_CMDID(DPIO_CMDID_DESTROY):
+	case MC_CMDID(DPMAC_CMDID_CREATE):
+	case MC_CMDID(DPMAC_CMDID_DESTROY):
+	case MC_CMDID(DPMCP_CMDID_CREATE):
+	case MC_CMDID(DPMCP_CMDID_DESTROY):
+	case MC_CMDID(DPNI_CMDID_CREATE):
+	case MC_CMDID(DPNI_CMDID_DESTROY):
+	case MC_CMDID(DPRTC_CMDID_CREATE):
+	case MC_CMDID(DPRTC_CMDID_DESTROY):
+	case MC_CMDID(DPSECI_CMDID_CREATE):
+	case MC_CMDID(DPSECI_CMDID_DESTROY):
+	case MC_CMDID(DPSW_CMDID_CREATE):
+	case MC_CMDID(DPSW_CMDID_DESTROY):
+		return true;
+	default:
+		return false;
+	}
+}
+
+/**
+ * Commands that change what a container holds, sent with its token
+ */
+static bool is_container_update(uint16_t cmd_id)
+{
+	switch (cmd_id) {
+	case MC_CMDID(DPRC_CMDID_CREATE_CONT):
+	case MC_CMDID(DPRC_CMDID_DESTROY_CONT):
+	case MC_CMDID(DPRC_CMDID_ASSIGN):
+	case MC_CMDID(DPRC_CMDID_UNASSIGN):
+	case MC_CMDID(DPRC_CMDID_SET_OBJ_LABEL):
+	case MC_CMDID(DPRC_CMDID_CONNECT):
+	case MC_CMDID(DPRC_CMDID_DISCONNECT):
+		return true;
+	default:
+		return is_obj_create_destroy(cmd_id);
+	}
+}
+
+/**
+ * Returns the container a command changes, 0 if the token is not one of
+ * a container this request opened
+ */
+static uint32_t cmd_dprc_id(struct restool *ctx, uint16_t cmd_id,
+			    uint16_t token)
+{
+	struct container_lock *lock = &ctx->lock;
+
+	for (unsigned int i = 0; i < CONTAINER_LOCK_MAX_TOKENS; i++) {
+		if (lock->tokens[i].dprc_id != 0 &&
+		    lock->tokens[i].token == token)
+			return lock->tokens[i].dprc_id;
+	}
+
+	if (ctx->mc_fw_version.major == MC_FW_VERSION_9 &&
+	    is_obj_create_destroy(cmd_id))
+		return ctx->root_dprc_id;
+
+	return 0;
+}
+
+static void forget_token(struct container_lock *lock, uint16_t token)
+{
+	for (unsigned int i = 0; i < CONTAINER_LOCK_MAX_TOKENS; i++) {
+		if (lock->tokens[i].dprc_id != 0 &&
+		    lock->tokens[i].token == token) {
+			lock->tokens[i].dprc_id = 0;
+			return;
+		}
+	}
+}
+
+static void remember_token(struct container_lock *lock, uint16_t token,
+			   uint32_t dprc_id)
+{
+	unsigned int i;
+
+	for (i = 0; i < CONTAINER_LOCK_MAX_TOKENS; i++) {
+		if (lock->tokens[i].dprc_id == 0)
+			break;
+	}
+
+	/* more open containers than expected, forget the oldest */
+	if (i == CONTAINER_LOCK_MAX_TOKENS)
+		i = lock->next_token++ % CONTAINER_LOCK_MAX_TOKENS;
+
+	lock->tokens[i].token = token;
+	lock->tokens[i].dprc_id = dprc_id;
+}
+
+static int open_lock_file(struct container_lock *lock)
+{
+	int fd;
+
+	if (lock->fd != -1)
+		return lock->fd;
+
+	(void)mkdir(RESTOOL_RUN_DIR, 0755);
+	fd = open(CONTAINER_LOCK_FILE, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+	if (fd < 0) {
+		ERROR_PRINTF("warning: cannot open %s: %s, not locking out other restool commands\n",
+			     CONTAINER_LOCK_FILE, strerror(errno));
+		fd = -2;
+	}
+
+	lock->fd = fd;
+	return fd;
+}
+
+static int set_lock(int fd, uint32_t dprc_id, short type, bool wait)
+{
+	struct flock fl = {
+		.l_type = type,
+		.l_whence = SEEK_SET,
+		.l_start = dprc_id,
+		.l_len = 1,
+	};
+
+	while (fcntl(fd, wait ? F_OFD_SETLKW : F_OFD_SETLK, &fl) < 0) {
+		if (errno != EINTR)
+			return -errno;
+	}
+
+	return 0;
+}
+
+static int wait_lock(int fd, uint32_t dprc_id)
+{
+	int error;
+
+	DEBUG_PRINTF("waiting for the lock on dprc.%u\n", dprc_id);
+	error = set_lock(fd, dprc_id, F_WRLCK, true);
+	if (error < 0)
+		ERROR_PRINTF("warning: cannot lock dprc.%u: %s, not locking out other restool commands\n",
+			     dprc_id, strerror(-error));
+
+	return error;
+}
+
+/**
+ * Locks dprc_id, waiting for it. Waiting while holding a container with
+ * a greater id could deadlock with a request locking in the other order,
+ * so those are released first, then taken again after dprc_id, in order.
+ */
+static int lock_container(struct container_lock *lock, uint32_t dprc_id)
+{
+	unsigned int pos;
+	unsigned int n;
+	int fd;
+
+	for (pos = 0; pos < lock->num_held; pos++) {
+		if (lock->held[pos] == dprc_id)
+			return 0;
+		if (lock->held[pos] > dprc_id)
+			break;
+	}
+
+	if (lock->num_held == CONTAINER_LOCK_MAX_HELD) {
+		ERROR_PRINTF("too many containers locked\n");
+		return -ENOLCK;
+	}
+
+	fd = open_lock_file(lock);
+	if (fd < 0)
+		return 0;
+
+	if (pos < lock->num_held &&
+	    set_lock(fd, dprc_id, F_WRLCK, false) < 0) {
+		DEBUG_PRINTF("dprc.%u is busy, releasing dprc.%u and up\n",
+			     dprc_id, lock->held[pos]);
+		for (n = pos; n < lock->num_held; n++)
+			(void)set_lock(fd, lock->held[n], F_UNLCK, false);
+
+		if (wait_lock(fd, dprc_id) < 0)
+			return 0;
+
+		for (n = pos; n < lock->num_held; n++) {
+			if (wait_lock(fd, lock->held[n]) < 0)
+				return 0;
+		}
+	} else if (pos == lock->num_held && wait_lock(fd, dprc_id) < 0) {
+		return 0;
+	}
+
+	memmove(&lock->held[pos + 1], &lock->held[pos],
+		(lock->num_held - pos) * sizeof(lock->held[0]));
+	lock->held[pos] = dprc_id;
+	lock->num_held++;
+	return 0;
+}
+
+/**
+ * Called before an MC command is sent: locks the container it changes,
+ * if any
+ */
+int container_lock_cmd(struct restool *ctx, struct mc_command *cmd)
+{
+	uint16_t cmd_id = mc_header_cmd_id(cmd->header);
+	uint16_t token = mc_header_token(ctx, cmd->header);
+	uint32_t dprc_id;
+
+	if (cmd_id == MC_CMDID(DPRC_CMDID_OPEN)) {
+		ctx->lock.open_pending = true;
+		ctx->lock.open_dprc_id = le32toh(*(uint32_t *)cmd->params);
+		return 0;
+	}
+
+	if (cmd_id == MC_CMDID(DPRC_CMDID_CLOSE)) {
+		forget_token(&ctx->lock, token);
+		return 0;
+	}
+
+	if (!is_container_update(cmd_id))
+		return 0;
+
+	dprc_id = cmd_dprc_id(ctx, cmd_id, token);
+	if (dprc_id == 0) {
+		ERROR_PRINTF("cannot tell which container MC command %#x changes, not sent\n",
+			     cmd_id);
+		return -EINVAL;
+	}
+
+	return lock_container(&ctx->lock, dprc_id);
+}
+
+/**
+ * Called after an MC command completed: remembers which container the
+ * token returned by dprc_open() refers to.
+ */
+void container_lock_cmd_done(struct restool *ctx, struct mc_command *cmd,
+			     int error)
+{
+	struct container_lock *lock = &ctx->lock;
+
+	if (!lock->open_pending)
+		return;
+
+	lock->open_pending = false;
+	if (error != 0)
+		return;
+
+	remember_token(lock, mc_header_token(ctx, cmd->header),
+		       lock->open_dprc_id);
+}
+
+/**
+ * Releases every container lock this request holds
+ */
+void container_unlock_all(struct restool *ctx)
+{
+	if (ctx->lock.fd >= 0)
+		close(ctx->lock.fd);
+
+	ctx->lock.fd = -1;
+	ctx->lock.num_held = 0;
+}
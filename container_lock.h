@@ -0,0 +1,86 @@
+/* Copyright 2018 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _CONTAINER_LOCK_H_
+#define _CONTAINER_LOCK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Per-container locks shared by concurrent restool requests, in the same
+ * process or not. Commands that change a container (creating, destroying,
+ * assigning, labeling or connecting objects in it) lock that container
+ * before they are sent and keep it until the restool command completes;
+ * queries take no lock, so they never wait, and changes to different
+ * containers proceed in parallel. Locks are open file description locks
+ * on CONTAINER_LOCK_FILE, one byte per container id, owned by the
+ * request that opened the file; the kernel drops them if restool dies.
+ * A request waits for its locks in ascending container id order, so two
+ * requests never wait for each other.
+ */
+#define CONTAINER_LOCK_FILE	RESTOOL_RUN_DIR "/containers.lock"
+
+/**
+ * Number of open dprc tokens remembered and of containers locked at once,
+ * enough for MAX_DPRC_NESTING containers plus the ones a command opens
+ * itself (checked in container_lock.c, restool.h includes this file first)
+ */
+#define CONTAINER_LOCK_MAX_TOKENS	32
+#define CONTAINER_LOCK_MAX_HELD		32
+
+struct container_lock {
+	/* -1 until the lock file is opened, -2 if it cannot be */
+	int fd;
+	/* ids of the locked containers, ascending */
+	unsigned int num_held;
+	uint32_t held[CONTAINER_LOCK_MAX_HELD];
+	/* dprc_open() in flight */
+	bool open_pending;
+	uint32_t open_dprc_id;
+	/* open dprc tokens of this request, dprc_id 0 for a free entry */
+	unsigned int next_token;
+	struct {
+		uint16_t token;
+		uint32_t dprc_id;
+	} tokens[CONTAINER_LOCK_MAX_TOKENS];
+};
+
+struct restool;
+struct mc_command;
+
+int container_lock_cmd(struct restool *ctx, struct mc_command *cmd);
+void container_lock_cmd_done(struct restool *ctx, struct mc_command *cmd,
+			     int error);
+void container_unlock_all(struct restool *ctx);
+
+#endif /* _CONTAINER_LOCK_H_ */
@@ -0,0 +1,91 @@
+/* Copyright 2018 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _DISPATCH_H_
+#define _DISPATCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Command dispatch table, a perfect hash generated at build time into
+ * dispatch_table.c by scripts/gen-dispatch.awk from object_cmd_parsers[]
+ * and the object_command tables. It holds three kinds of keys:
+ * - (object type, 0, "") with the version_lut[] entry of the type
+ * - (object type, object version, "") for each command table
+ * - (object type, object version, command) with the command and the
+ *   bit mask of its options taking an argument
+ */
+struct dispatch_entry {
+	const char *obj_type;
+	uint16_t version;
+	const char *cmd_name;
+	struct object_command *cmd;
+	struct lut_entry *lut;
+	uint32_t arg_option_mask;
+	bool standalone;
+};
+
+extern const unsigned int dispatch_num_buckets;
+extern const unsigned int dispatch_num_slots;
+extern const uint16_t dispatch_displacement[];
+extern const struct dispatch_entry dispatch_table[];
+extern struct lut_entry version_lut[];
+
+/**
+ * Multiplicative string hash modulo a prime below 2^16, so that h * mult
+ * fits in 32 bits; must match hash() in scripts/gen-dispatch.awk
+ */
+#define DISPATCH_HASH_MOD	65521
+
+static inline uint32_t dispatch_hash_str(uint32_t h, uint32_t mult,
+					 const char *str)
+{
+	for (; *str != '\0'; str++)
+		h = (h * mult + (unsigned char)*str) % DISPATCH_HASH_MOD;
+
+	return h;
+}
+
+static inline uint32_t dispatch_hash(uint32_t mult, const char *obj_type,
+				     uint16_t version, const char *cmd_name)
+{
+	uint32_t h;
+
+	h = dispatch_hash_str(0, mult, obj_type);
+	h = (h * mult + '/') % DISPATCH_HASH_MOD;
+	h = (h * mult + version) % DISPATCH_HASH_MOD;
+	h = (h * mult + '/') % DISPATCH_HASH_MOD;
+	return dispatch_hash_str(h, mult, cmd_name);
+}
+
+#endif /* _DISPATCH_H_ */
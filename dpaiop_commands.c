@@ -50,6 +50,7 @@
 enum dpaiop_info_options {
 	INFO_OPT_HELP = 0,
 	INFO_OPT_VERBOSE,
+	INFO_OPT_FIELDS,
 };
 
 static struct option dpaiop_info_options[] = {
@@ -67,6 +68,13 @@ static struct option dpaiop_info_options[] = {
 		.val = 0,
 	},
 
+	[INFO_OPT_FIELDS] = {
+		.name = "fields",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
 	{ 0 },
 };
 
@@ -135,7 +143,7 @@ static const struct flib_ops dpaiop_ops = {
 	.obj_get_irq_status = dpaiop_get_irq_status,
 };
 
-static int cmd_dpaiop_help(void)
+static int cmd_dpaiop_help(struct restool *ctx)
 {
 	static const char help_msg[] =
 		"\n"
@@ -148,37 +156,43 @@ static int cmd_dpaiop_help(void)
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
 
+	(void)ctx;
 	printf(help_msg);
 	return 0;
 }
 
 static void print_dpaiop_state(uint32_t state)
 {
-	printf("DPAIOP state: ");
 	switch (state) {
 	case DPAIOP_STATE_RESET_DONE:
-		printf("DPAIOP_STATE_RESET_DONE\n");
+		output_field("state", "DPAIOP state",
+			     "DPAIOP_STATE_RESET_DONE");
 		break;
 	case DPAIOP_STATE_RESET_ONGOING:
-		printf("DPAIOP_STATE_RESET_ONGOING\n");
+		output_field("state", "DPAIOP state",
+			     "DPAIOP_STATE_RESET_ONGOING");
 		break;
 	case DPAIOP_STATE_LOAD_DONE:
-		printf("DPAIOP_STATE_LOAD_DONE\n");
+		output_field("state", "DPAIOP state", "DPAIOP_STATE_LOAD_DONE");
 		break;
 	case DPAIOP_STATE_LOAD_ONGIONG:
-		printf("DPAIOP_STATE_LOAD_ONGIONG\n");
+		output_field("state", "DPAIOP state",
+			     "DPAIOP_STATE_LOAD_ONGIONG");
 		break;
 	case DPAIOP_STATE_LOAD_ERROR:
-		printf("DPAIOP_STATE_LOAD_ERROR\n");
+		output_field("state", "DPAIOP state",
+			     "DPAIOP_STATE_LOAD_ERROR");
 		break;
 	case DPAIOP_STATE_BOOT_ONGOING:
-		printf("DPAIOP_STATE_BOOT_ONGOING\n");
+		output_field("state", "DPAIOP state",
+			     "DPAIOP_STATE_BOOT_ONGOING");
 		break;
 	case DPAIOP_STATE_BOOT_ERROR:
-		printf("DPAIOP_STATE_BOOT_ERROR\n");
+		output_field("state", "DPAIOP state",
+			     "DPAIOP_STATE_BOOT_ERROR");
 		break;
 	case DPAIOP_STATE_RUNNING:
-		printf("DPAIOP_STATE_RUNNING\n");
+		output_field("state", "DPAIOP state", "DPAIOP_STATE_RUNNING");
 		break;
 	default:
 		assert(false);
@@ -186,7 +200,7 @@ static void print_dpaiop_state(uint32_t state)
 	}
 }
 
-static int print_dpaiop_attr(uint32_t dpaiop_id,
+static int print_dpaiop_attr(struct restool *ctx, uint32_t dpaiop_id,
 			struct dprc_obj_desc *target_obj_desc)
 {
 	uint16_t dpaiop_handle;
@@ -196,11 +210,13 @@ static int print_dpaiop_attr(uint32_t dpaiop_id,
 	uint32_t state;
 	bool dpaiop_opened = false;
 
-	error = dpaiop_open(&restool.mc_io, 0, dpaiop_id, &dpaiop_handle);
+	error = dpaiop_open(&ctx->mc_io, ctx->cmd_flags, dpaiop_id,
+			    &dpaiop_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpaiop_opened = true;
@@ -213,45 +229,52 @@ static int print_dpaiop_attr(uint32_t dpaiop_id,
 	}
 
 	memset(&dpaiop_attr, 0, sizeof(dpaiop_attr));
-	error = dpaiop_get_attributes(&restool.mc_io, 0, dpaiop_handle,
+	error = dpaiop_get_attributes(&ctx->mc_io, ctx->cmd_flags,
+				      dpaiop_handle,
 					&dpaiop_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(dpaiop_id == (uint32_t)dpaiop_attr.id);
 
-	printf("dpaiop version: %u.%u\n", dpaiop_attr.version.major,
-	       dpaiop_attr.version.minor);
-	printf("dpaiop id: %d\n", dpaiop_attr.id);
-	printf("plugged state: %splugged\n",
+	output_field("version", "dpaiop version",
+		     "%u.%u", dpaiop_attr.version.major,
+		     dpaiop_attr.version.minor);
+	output_int("id", "dpaiop id", dpaiop_attr.id);
+	output_field("plugged_state", "plugged state", "%splugged",
 		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
 
 	memset(&dpaiop_sl_version, 0, sizeof(dpaiop_sl_version));
-	error = dpaiop_get_sl_version(&restool.mc_io, 0, dpaiop_handle,
+	error = dpaiop_get_sl_version(&ctx->mc_io, ctx->cmd_flags,
+				      dpaiop_handle,
 					&dpaiop_sl_version);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
-	printf("dpaiop server layer version: %u.%u.%u\n",
+	output_field("sl_version", "dpaiop server layer version", "%u.%u.%u",
 		dpaiop_sl_version.major,
 		dpaiop_sl_version.minor,
 		dpaiop_sl_version.revision);
 
-	error = dpaiop_get_state(&restool.mc_io, 0, dpaiop_handle, &state);
+	error = dpaiop_get_state(&ctx->mc_io, ctx->cmd_flags, dpaiop_handle,
+				 &state);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	print_dpaiop_state(state);
-	print_obj_label(target_obj_desc);
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -259,11 +282,13 @@ out:
 	if (dpaiop_opened) {
 		int error2;
 
-		error2 = dpaiop_close(&restool.mc_io, 0, dpaiop_handle);
+		error2 = dpaiop_close(&ctx->mc_io, ctx->cmd_flags,
+				      dpaiop_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -272,7 +297,7 @@ out:
 	return error;
 }
 
-static int print_dpaiop_attr_v10(uint32_t dpaiop_id,
+static int print_dpaiop_attr_v10(struct restool *ctx, uint32_t dpaiop_id,
 			struct dprc_obj_desc *target_obj_desc)
 {
 	struct dpaiop_sl_version_v10 dpaiop_sl_version;
@@ -281,76 +306,98 @@ static int print_dpaiop_attr_v10(uint32_t dpaiop_id,
 	bool dpaiop_opened = false;
 	uint16_t dpaiop_token;
 	uint32_t state;
-	int error;
+	int error = 0;
 
-	error = dpaiop_open_v10(&restool.mc_io, 0, dpaiop_id, &dpaiop_token);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpaiop_opened = true;
-	if (!dpaiop_token) {
-		DEBUG_PRINTF(
-			"dpaiop_open() returned invalid handle (auth 0) for dpaiop.%u\n",
-			dpaiop_id);
-		error = -ENOENT;
-		goto out;
-	}
+	if (INFO_FIELD(ATTR)) {
+		error = dpaiop_open_v10(&ctx->mc_io, ctx->cmd_flags, dpaiop_id,
+					&dpaiop_token);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		dpaiop_opened = true;
+		if (!dpaiop_token) {
+			DEBUG_PRINTF(
+				"dpaiop_open() returned invalid handle (auth 0) for dpaiop.%u\n",
+				dpaiop_id);
+			error = -ENOENT;
+			goto out;
+		}
 
-	/* get object attributes */
-	memset(&dpaiop_attr, 0, sizeof(dpaiop_attr));
-	error = dpaiop_get_attributes_v10(&restool.mc_io, 0,
-					  dpaiop_token, &dpaiop_attr);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		/* get object attributes */
+		memset(&dpaiop_attr, 0, sizeof(dpaiop_attr));
+		error = dpaiop_get_attributes_v10(&ctx->mc_io, ctx->cmd_flags,
+						  dpaiop_token, &dpaiop_attr);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		assert(dpaiop_id == (uint32_t)dpaiop_attr.id);
 	}
-	assert(dpaiop_id == (uint32_t)dpaiop_attr.id);
-	printf("dpaiop id: %d\n", dpaiop_attr.id);
+
+	if (INFO_FIELD(ID))
+		output_int("id", "dpaiop id", dpaiop_id);
 
 	/* get object version */
-	error = dpaiop_get_api_version_v10(&restool.mc_io, 0,
-				       &obj_major, &obj_minor);
-	printf("dpaiop version: %u.%u\n", obj_major, obj_minor);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+	if (INFO_FIELD(VERSION)) {
+		error = get_obj_api_version(ctx, "dpaiop",
+					    dpaiop_get_api_version_v10,
+					    &obj_major, &obj_minor);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		output_field("version", "dpaiop version",
+			     "%u.%u", obj_major, obj_minor);
 	}
 
 	/* print object state */
-	printf("plugged state: %splugged\n",
-		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-
-	/* get object server layer */
-	memset(&dpaiop_sl_version, 0, sizeof(dpaiop_sl_version));
-	error = dpaiop_get_sl_version_v10(&restool.mc_io, 0, dpaiop_token,
-					&dpaiop_sl_version);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	printf("dpaiop server layer version: %u.%u.%u\n",
-		dpaiop_sl_version.major,
-		dpaiop_sl_version.minor,
-		dpaiop_sl_version.revision);
-
-	error = dpaiop_get_state_v10(&restool.mc_io, 0, dpaiop_token, &state);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+	if (INFO_FIELD(STATE))
+		output_field("plugged_state", "plugged state", "%splugged",
+			     (target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ?
+			     "" : "un");
+
+	if (INFO_FIELD(ATTR)) {
+		/* get object server layer */
+		memset(&dpaiop_sl_version, 0, sizeof(dpaiop_sl_version));
+		error = dpaiop_get_sl_version_v10(&ctx->mc_io, ctx->cmd_flags,
+						  dpaiop_token,
+						  &dpaiop_sl_version);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		output_field("sl_version", "dpaiop server layer version",
+			     "%u.%u.%u",
+			dpaiop_sl_version.major,
+			dpaiop_sl_version.minor,
+			dpaiop_sl_version.revision);
+
+		error = dpaiop_get_state_v10(&ctx->mc_io, ctx->cmd_flags,
+					     dpaiop_token,
+					     &state);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		print_dpaiop_state(state);
 	}
-	print_dpaiop_state(state);
-	print_obj_label(target_obj_desc);
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -358,11 +405,13 @@ out:
 	if (dpaiop_opened) {
 		int error2;
 
-		error2 = dpaiop_close_v10(&restool.mc_io, 0, dpaiop_token);
+		error2 = dpaiop_close_v10(&ctx->mc_io, ctx->cmd_flags,
+					  dpaiop_token);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -371,51 +420,50 @@ out:
 	return error;
 }
 
-static int print_dpaiop_info(uint32_t dpaiop_id, int mc_fw_version)
+static int print_dpaiop_info(struct restool *ctx, uint32_t dpaiop_id,
+			     int mc_fw_version)
 {
 	int error;
 	struct dprc_obj_desc target_obj_desc;
-	uint32_t target_parent_dprc_id;
-	bool found = false;
-
-	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0, dpaiop_id,
-				"dpaiop", &target_obj_desc,
-				&target_parent_dprc_id, &found);
+
+	error = find_info_obj_desc(ctx, dpaiop_id, "dpaiop",
+				   ctx->cmd_option_mask &
+				   ONE_BIT_MASK(INFO_OPT_VERBOSE),
+				   &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (strcmp(target_obj_desc.type, "dpaiop")) {
-		printf("dpaiop.%d does not exist\n", dpaiop_id);
-		return -EINVAL;
-	}
-
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = print_dpaiop_attr(dpaiop_id, &target_obj_desc);
+		error = print_dpaiop_attr(ctx, dpaiop_id, &target_obj_desc);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = print_dpaiop_attr_v10(dpaiop_id, &target_obj_desc);
+		error = print_dpaiop_attr_v10(ctx, dpaiop_id, &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpaiop_ops);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
+		error = print_obj_verbose(ctx, &target_obj_desc, &dpaiop_ops);
 	}
 
 out:
 	return error;
 }
 
-static int info_dpaiop(int mc_fw_version)
+static int info_dpaiop(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
 		"Usage: restool dpaiop info <dpaiop-object> [--verbose]\n"
+		"                         [--fields=<field>[,<field>...]]\n"
 		"\n"
 		"OPTIONS:\n"
 		"--verbose\n"
 		"   Shows extended/verbose information about the object\n"
+		"--fields=<field>[,<field>...]\n"
+		"   Shows only the given fields and sends only the MC\n"
+		"   commands they need. <field> is one of: version, id,\n"
+		"   state, endpoint, link, mac, attr, stats, label.\n"
+		"   Requires MC firmware 10.x.\n"
 		"\n"
 		"EXAMPLE:\n"
 		"Display information about dpaiop.5:\n"
@@ -425,147 +473,162 @@ static int info_dpaiop(int mc_fw_version)
 	uint32_t obj_id;
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_FIELDS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_FIELDS);
+		error = parse_info_fields(ctx, 
+				ctx->cmd_option_args[INFO_OPT_FIELDS]);
+		if (error < 0)
+			goto out;
+	}
+
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpaiop", &obj_id);
+	error = parse_object_name(ctx->obj_name, "dpaiop", &obj_id);
 	if (error < 0)
 		goto out;
 
-	error = print_dpaiop_info(obj_id, mc_fw_version);
+	error = print_dpaiop_info(ctx, obj_id, mc_fw_version);
 out:
 	return error;
 }
 
-static int cmd_dpaiop_info(void)
+static int cmd_dpaiop_info(struct restool *ctx)
 {
-	return info_dpaiop(MC_FW_VERSION_9);
+	return info_dpaiop(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpaiop_info_v10(void)
+static int cmd_dpaiop_info_v10(struct restool *ctx)
 {
-	return info_dpaiop(MC_FW_VERSION_10);
+	return info_dpaiop(ctx, MC_FW_VERSION_10);
 }
 
-static int create_dpaiop_v9(struct dpaiop_cfg *dpaiop_cfg)
+static int create_dpaiop_v9(struct restool *ctx, struct dpaiop_cfg *dpaiop_cfg)
 {
 	struct dpaiop_attr dpaiop_attr;
 	uint16_t dpaiop_handle;
 	int error;
 
-	error = dpaiop_create(&restool.mc_io, 0, dpaiop_cfg, &dpaiop_handle);
+	error = dpaiop_create(&ctx->mc_io, ctx->cmd_flags, dpaiop_cfg,
+			      &dpaiop_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	memset(&dpaiop_attr, 0, sizeof(struct dpaiop_attr));
-	error = dpaiop_get_attributes(&restool.mc_io, 0, dpaiop_handle,
+	error = dpaiop_get_attributes(&ctx->mc_io, ctx->cmd_flags,
+				      dpaiop_handle,
 					&dpaiop_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
-	print_new_obj("dpaiop", dpaiop_attr.id, NULL);
+	print_new_obj(ctx, "dpaiop", dpaiop_attr.id, NULL);
 
-	error = dpaiop_close(&restool.mc_io, 0, dpaiop_handle);
+	error = dpaiop_close(&ctx->mc_io, ctx->cmd_flags, dpaiop_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	return 0;
 }
 
-static int create_dpaiop_v10(struct dpaiop_cfg_v10 *dpaiop_cfg)
+static int create_dpaiop_v10(struct restool *ctx,
+			     struct dpaiop_cfg_v10 *dpaiop_cfg)
 {
 	uint32_t dpaiop_id, dprc_id;
 	uint16_t dprc_handle;
 	bool dprc_opened;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
+	dprc_handle = ctx->root_dprc_handle;
 	dprc_opened = false;
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
 		error = parse_object_name(
-				restool.cmd_option_args[CREATE_OPT_PARENT_DPRC],
+				ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC],
 				"dprc", &dprc_id);
 		if (error)
 			return error;
 
-		if (restool.root_dprc_id != dprc_id) {
-			error = open_dprc(dprc_id, &dprc_handle);
+		if (ctx->root_dprc_id != dprc_id) {
+			error = open_dprc(ctx, dprc_id, &dprc_handle);
 			if (error)
 				return error;
 			dprc_opened = true;
 		}
 	}
 
-	error = dpaiop_create_v10(&restool.mc_io, dprc_handle, 0,
+	error = dpaiop_create_v10(&ctx->mc_io, dprc_handle, ctx->cmd_flags,
 				  dpaiop_cfg, &dpaiop_id);
 	if (error) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status),
-			     mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	if (dprc_opened) {
-		(void)dprc_close(&restool.mc_io, 0, dprc_handle);
-		print_new_obj("dpaiop", dpaiop_id,
-			      restool.cmd_option_args[CREATE_OPT_PARENT_DPRC]);
+		(void)dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
+		print_new_obj(ctx, "dpaiop", dpaiop_id,
+			      ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC]);
 	} else {
-		print_new_obj("dpaiop", dpaiop_id, NULL);
+		print_new_obj(ctx, "dpaiop", dpaiop_id, NULL);
 	}
 
 	return 0;
 }
 
-static int create_dpaiop(int mc_fw_version, const char *usage_msg)
+static int create_dpaiop(struct restool *ctx, int mc_fw_version,
+			 const char *usage_msg)
 {
 	int error;
 	struct dpaiop_cfg dpaiop_cfg;
 	struct dpaiop_cfg_v10 dpaiop_cfg_v10;
 	uint32_t obj_id;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name != NULL) {
+	if (ctx->obj_name != NULL) {
 		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
-			     restool.obj_name);
+			     ctx->obj_name);
 		puts(usage_msg);
 		return -EINVAL;
 	}
 
-	if (restool.cmd_option_mask &
+	if (ctx->cmd_option_mask &
 	    ONE_BIT_MASK(CREATE_OPT_AIOP_CONTAINER)) {
-		restool.cmd_option_mask &=
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_AIOP_CONTAINER);
 		error = parse_object_name(
-			restool.cmd_option_args[CREATE_OPT_AIOP_CONTAINER],
+			ctx->cmd_option_args[CREATE_OPT_AIOP_CONTAINER],
 			"dprc", &obj_id);
 		if (error < 0) {
 			puts(usage_msg);
@@ -585,16 +648,16 @@ static int create_dpaiop(int mc_fw_version, const char *usage_msg)
 	dpaiop_cfg_v10.aiop_id = 0;
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = create_dpaiop_v9(&dpaiop_cfg);
+		error = create_dpaiop_v9(ctx, &dpaiop_cfg);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = create_dpaiop_v10(&dpaiop_cfg_v10);
+		error = create_dpaiop_v10(ctx, &dpaiop_cfg_v10);
 	else
 		return -EINVAL;
 
 	return error;
 }
 
-static int cmd_dpaiop_create(void)
+static int cmd_dpaiop_create(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -607,10 +670,10 @@ static int cmd_dpaiop_create(void)
 		"   $ restool dpaiop create --aiop-container=dprc.3\n"
 		"\n";
 
-	return create_dpaiop(MC_FW_VERSION_9, usage_msg);
+	return create_dpaiop(ctx, MC_FW_VERSION_9, usage_msg);
 }
 
-static int cmd_dpaiop_create_v10(void)
+static int cmd_dpaiop_create_v10(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -629,20 +692,22 @@ static int cmd_dpaiop_create_v10(void)
 		"   $ restool dpaiop create --aiop-container=dprc.3\n"
 		"\n";
 
-	return create_dpaiop(MC_FW_VERSION_10, usage_msg);
+	return create_dpaiop(ctx, MC_FW_VERSION_10, usage_msg);
 }
 
-static int destroy_dpaiop_v9(uint32_t dpaiop_id)
+static int destroy_dpaiop_v9(struct restool *ctx, uint32_t dpaiop_id)
 {
 	bool dpaiop_opened = false;
 	uint16_t dpaiop_handle;
 	int error, error2;
 
-	error = dpaiop_open(&restool.mc_io, 0, dpaiop_id, &dpaiop_handle);
+	error = dpaiop_open(&ctx->mc_io, ctx->cmd_flags, dpaiop_id,
+			    &dpaiop_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpaiop_opened = true;
@@ -654,23 +719,26 @@ static int destroy_dpaiop_v9(uint32_t dpaiop_id)
 		goto out;
 	}
 
-	error = dpaiop_destroy(&restool.mc_io, 0, dpaiop_handle);
+	error = dpaiop_destroy(&ctx->mc_io, ctx->cmd_flags, dpaiop_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpaiop_opened = false;
-	printf("dpaiop.%u is destroyed\n", dpaiop_id);
+	print_destroyed_obj("dpaiop", dpaiop_id);
 
 out:
 	if (dpaiop_opened) {
-		error2 = dpaiop_close(&restool.mc_io, 0, dpaiop_handle);
+		error2 = dpaiop_close(&ctx->mc_io, ctx->cmd_flags,
+				      dpaiop_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -679,42 +747,43 @@ out:
 	return error;
 }
 
-static int destroy_dpaiop_v10(uint32_t dpaiop_id)
+static int destroy_dpaiop_v10(struct restool *ctx, uint32_t dpaiop_id)
 {
 	uint16_t dprc_handle;
 	uint32_t dprc_id;
 	int error = 0;
 
-	dprc_handle = restool.root_dprc_handle;
-	dprc_id = restool.root_dprc_id;
-	error = get_parent_dprc_id(dpaiop_id, "dpaiop", &dprc_id);
+	dprc_handle = ctx->root_dprc_handle;
+	dprc_id = ctx->root_dprc_id;
+	error = get_parent_dprc_id(ctx, dpaiop_id, "dpaiop", &dprc_id);
 	if (error)
 		return error;
 
-	if (dprc_id != restool.root_dprc_id) {
-		error = open_dprc(dprc_id, &dprc_handle);
+	if (dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, dprc_id, &dprc_handle);
 		if (error)
 			return error;
 	}
 
-	error = dpaiop_destroy_v10(&restool.mc_io, dprc_handle,
-				   0, dpaiop_id);
+	error = dpaiop_destroy_v10(&ctx->mc_io, dprc_handle,
+				   ctx->cmd_flags, dpaiop_id);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
-	printf("dpaiop.%u is destroyed\n", dpaiop_id);
+	print_destroyed_obj("dpaiop", dpaiop_id);
 
 out:
-	if (dprc_id != restool.root_dprc_id)
-		error = dprc_close(&restool.mc_io, 0, dprc_handle);
+	if (dprc_id != ctx->root_dprc_id)
+		error = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 
 	return error;
 }
 
-static int destroy_dpaiop(int mc_fw_version)
+static int destroy_dpaiop(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -724,37 +793,37 @@ static int destroy_dpaiop(int mc_fw_version)
 	int error;
 	uint32_t dpaiop_id;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	if (in_use(restool.obj_name, "destroyed")) {
+	if (in_use(ctx->obj_name, "destroyed")) {
 		error = -EBUSY;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpaiop", &dpaiop_id);
+	error = parse_object_name(ctx->obj_name, "dpaiop", &dpaiop_id);
 	if (error < 0)
 		goto out;
 
-	if (!find_obj("dpaiop", dpaiop_id)) {
+	if (!find_obj(ctx, "dpaiop", dpaiop_id)) {
 		error = -EINVAL;
 		goto out;
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = destroy_dpaiop_v9(dpaiop_id);
+		error = destroy_dpaiop_v9(ctx, dpaiop_id);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = destroy_dpaiop_v10(dpaiop_id);
+		error = destroy_dpaiop_v10(ctx, dpaiop_id);
 	else
 		return -EINVAL;
 
@@ -762,14 +831,14 @@ out:
 	return error;
 }
 
-static int cmd_dpaiop_destroy(void)
+static int cmd_dpaiop_destroy(struct restool *ctx)
 {
-	return destroy_dpaiop(MC_FW_VERSION_9);
+	return destroy_dpaiop(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpaiop_destroy_v10(void)
+static int cmd_dpaiop_destroy_v10(struct restool *ctx)
 {
-	return destroy_dpaiop(MC_FW_VERSION_10);
+	return destroy_dpaiop(ctx, MC_FW_VERSION_10);
 }
 
 struct object_command dpaiop_commands_v9[] = {
@@ -787,7 +856,8 @@ struct object_command dpaiop_commands_v9[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpaiop_destroy_options,
-	  .cmd_func = cmd_dpaiop_destroy },
+	  .cmd_func = cmd_dpaiop_destroy,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -807,7 +877,8 @@ struct object_command dpaiop_commands_v10[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpaiop_destroy_options,
-	  .cmd_func = cmd_dpaiop_destroy_v10 },
+	  .cmd_func = cmd_dpaiop_destroy_v10,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
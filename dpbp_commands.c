@@ -49,6 +49,7 @@
 enum dpbp_info_options {
 	INFO_OPT_HELP = 0,
 	INFO_OPT_VERBOSE,
+	INFO_OPT_FIELDS,
 };
 
 static struct option dpbp_info_options[] = {
@@ -66,6 +67,13 @@ static struct option dpbp_info_options[] = {
 		.val = 0,
 	},
 
+	[INFO_OPT_FIELDS] = {
+		.name = "fields",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
 	{ 0 },
 };
 
@@ -126,7 +134,7 @@ static const struct flib_ops dpbp_ops = {
 	.obj_get_irq_status = dpbp_get_irq_status,
 };
 
-static int cmd_dpbp_help(void)
+static int cmd_dpbp_help(struct restool *ctx)
 {
 	static const char help_msg[] =
 		"\n"
@@ -139,11 +147,12 @@ static int cmd_dpbp_help(void)
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
 
+	(void)ctx;
 	printf(help_msg);
 	return 0;
 }
 
-static int print_dpbp_attr_v9(uint32_t dpbp_id,
+static int print_dpbp_attr_v9(struct restool *ctx, uint32_t dpbp_id,
 			      struct dprc_obj_desc *target_obj_desc)
 {
 	uint16_t dpbp_handle;
@@ -151,11 +160,12 @@ static int print_dpbp_attr_v9(uint32_t dpbp_id,
 	struct dpbp_attr dpbp_attr;
 	bool dpbp_opened = false;
 
-	error = dpbp_open(&restool.mc_io, 0, dpbp_id, &dpbp_handle);
+	error = dpbp_open(&ctx->mc_io, ctx->cmd_flags, dpbp_id, &dpbp_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpbp_opened = true;
@@ -168,33 +178,37 @@ static int print_dpbp_attr_v9(uint32_t dpbp_id,
 	}
 
 	memset(&dpbp_attr, 0, sizeof(dpbp_attr));
-	error = dpbp_get_attributes(&restool.mc_io, 0, dpbp_handle, &dpbp_attr);
+	error = dpbp_get_attributes(&ctx->mc_io, ctx->cmd_flags, dpbp_handle,
+				    &dpbp_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(dpbp_id == (uint32_t)dpbp_attr.id);
 
-	printf("dpbp version: %u.%u\n", dpbp_attr.version.major,
-	       dpbp_attr.version.minor);
-	printf("dpbp id: %d\n", dpbp_attr.id);
-	printf("plugged state: %splugged\n",
+	output_field("version", "dpbp version",
+		     "%u.%u", dpbp_attr.version.major,
+		     dpbp_attr.version.minor);
+	output_int("id", "dpbp id", dpbp_attr.id);
+	output_field("plugged_state", "plugged state", "%splugged",
 		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	printf("buffer pool id: %u\n", (unsigned int)dpbp_attr.bpid);
-	print_obj_label(target_obj_desc);
+	output_uint("bpid", "buffer pool id", (unsigned int)dpbp_attr.bpid);
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 out:
 	if (dpbp_opened) {
 		int error2;
 
-		error2 = dpbp_close(&restool.mc_io, 0, dpbp_handle);
+		error2 = dpbp_close(&ctx->mc_io, ctx->cmd_flags, dpbp_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -203,68 +217,87 @@ out:
 	return error;
 }
 
-static int print_dpbp_attr_v10(uint32_t dpbp_id,
+static int print_dpbp_attr_v10(struct restool *ctx, uint32_t dpbp_id,
 			struct dprc_obj_desc *target_obj_desc)
 {
 	struct dpbp_attr_v10 dpbp_attr;
 	uint16_t obj_major, obj_minor;
 	bool dpbp_opened = false;
 	uint16_t dpbp_handle;
-	int error;
+	int error = 0;
 
-	error = dpbp_open_v10(&restool.mc_io, 0, dpbp_id, &dpbp_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpbp_opened = true;
-	if (0 == dpbp_handle) {
-		DEBUG_PRINTF(
-			"dpbp_open() returned invalid handle (auth 0) for dpbp.%u\n",
-			dpbp_id);
-		error = -ENOENT;
-		goto out;
-	}
+	if (INFO_FIELD(ATTR)) {
+		error = dpbp_open_v10(&ctx->mc_io, ctx->cmd_flags, dpbp_id,
+				      &dpbp_handle);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		dpbp_opened = true;
+		if (0 == dpbp_handle) {
+			DEBUG_PRINTF(
+				"dpbp_open() returned invalid handle (auth 0) for dpbp.%u\n",
+				dpbp_id);
+			error = -ENOENT;
+			goto out;
+		}
 
-	/* read object attributes */
-	memset(&dpbp_attr, 0, sizeof(dpbp_attr));
-	error = dpbp_get_attributes_v10(&restool.mc_io, 0,
-					dpbp_handle, &dpbp_attr);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		/* read object attributes */
+		memset(&dpbp_attr, 0, sizeof(dpbp_attr));
+		error = dpbp_get_attributes_v10(&ctx->mc_io, ctx->cmd_flags,
+						dpbp_handle, &dpbp_attr);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		assert(dpbp_id == (uint32_t)dpbp_attr.id);
 	}
-	assert(dpbp_id == (uint32_t)dpbp_attr.id);
-	printf("dpbp id: %d\n", dpbp_attr.id);
 
-	error = dpbp_get_api_version_v10(&restool.mc_io, 0, &obj_major, &obj_minor);
-	printf("dpbp version: %u.%u\n", obj_major, obj_minor);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+	if (INFO_FIELD(ID))
+		output_int("id", "dpbp id", dpbp_id);
+
+	if (INFO_FIELD(VERSION)) {
+		error = get_obj_api_version(ctx, "dpbp",
+					    dpbp_get_api_version_v10,
+					    &obj_major, &obj_minor);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		output_field("version", "dpbp version",
+			     "%u.%u", obj_major, obj_minor);
 	}
 
-	printf("plugged state: %splugged\n",
-		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	printf("buffer pool id: %u\n", (unsigned int)dpbp_attr.bpid);
-	print_obj_label(target_obj_desc);
+	if (INFO_FIELD(STATE))
+		output_field("plugged_state", "plugged state", "%splugged",
+			     (target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ?
+			     "" : "un");
+	if (INFO_FIELD(ATTR))
+		output_uint("bpid", "buffer pool id",
+			    (unsigned int)dpbp_attr.bpid);
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 out:
 	if (dpbp_opened) {
 		int error2;
 
-		error2 = dpbp_close_v10(&restool.mc_io, 0, dpbp_handle);
+		error2 = dpbp_close_v10(&ctx->mc_io, ctx->cmd_flags,
+					dpbp_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -273,51 +306,50 @@ out:
 	return error;
 }
 
-static int print_dpbp_info(uint32_t dpbp_id, int mc_fw_version)
+static int print_dpbp_info(struct restool *ctx, uint32_t dpbp_id,
+			   int mc_fw_version)
 {
 	int error;
 	struct dprc_obj_desc target_obj_desc;
-	uint32_t target_parent_dprc_id;
-	bool found = false;
-
-	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0, dpbp_id,
-				"dpbp", &target_obj_desc,
-				&target_parent_dprc_id, &found);
+
+	error = find_info_obj_desc(ctx, dpbp_id, "dpbp",
+				   ctx->cmd_option_mask &
+				   ONE_BIT_MASK(INFO_OPT_VERBOSE),
+				   &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (strcmp(target_obj_desc.type, "dpbp")) {
-		printf("dpbp.%d does not exist\n", dpbp_id);
-		return -EINVAL;
-	}
-
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = print_dpbp_attr_v9(dpbp_id, &target_obj_desc);
+		error = print_dpbp_attr_v9(ctx, dpbp_id, &target_obj_desc);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = print_dpbp_attr_v10(dpbp_id, &target_obj_desc);
+		error = print_dpbp_attr_v10(ctx, dpbp_id, &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpbp_ops);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
+		error = print_obj_verbose(ctx, &target_obj_desc, &dpbp_ops);
 	}
 
 out:
 	return error;
 }
 
-static int info_dpbp(int mc_fw_version)
+static int info_dpbp(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
 		"Usage: restool dpbp info <dpbp-object> [--verbose]\n"
+		"                         [--fields=<field>[,<field>...]]\n"
 		"\n"
 		"OPTIONS:\n"
 		"--verbose\n"
 		"   Shows extended/verbose information about the object\n"
+		"--fields=<field>[,<field>...]\n"
+		"   Shows only the given fields and sends only the MC\n"
+		"   commands they need. <field> is one of: version, id,\n"
+		"   state, endpoint, link, mac, attr, stats, label.\n"
+		"   Requires MC firmware 10.x.\n"
 		"\n"
 		"EXAMPLE:\n"
 		"Display information about dpbp.5:\n"
@@ -327,159 +359,174 @@ static int info_dpbp(int mc_fw_version)
 	uint32_t obj_id;
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_FIELDS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_FIELDS);
+		error = parse_info_fields(ctx, 
+				ctx->cmd_option_args[INFO_OPT_FIELDS]);
+		if (error < 0)
+			goto out;
+	}
+
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpbp", &obj_id);
+	error = parse_object_name(ctx->obj_name, "dpbp", &obj_id);
 	if (error < 0)
 		goto out;
 
-	error = print_dpbp_info(obj_id, mc_fw_version);
+	error = print_dpbp_info(ctx, obj_id, mc_fw_version);
 out:
 	return error;
 }
 
-static int cmd_dpbp_info_v9(void)
+static int cmd_dpbp_info_v9(struct restool *ctx)
 {
-	return info_dpbp(MC_FW_VERSION_9);
+	return info_dpbp(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpbp_info_v10(void)
+static int cmd_dpbp_info_v10(struct restool *ctx)
 {
-	return info_dpbp(MC_FW_VERSION_10);
+	return info_dpbp(ctx, MC_FW_VERSION_10);
 }
 
-static int create_dpbp_v9(struct dpbp_cfg *dpbp_cfg)
+static int create_dpbp_v9(struct restool *ctx, struct dpbp_cfg *dpbp_cfg)
 {
 	struct dpbp_attr dpbp_attr;
 	uint16_t dpbp_handle;
 	int error;
 
-	error = dpbp_create(&restool.mc_io, 0, dpbp_cfg, &dpbp_handle);
+	error = dpbp_create(&ctx->mc_io, ctx->cmd_flags, dpbp_cfg,
+			    &dpbp_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	memset(&dpbp_attr, 0, sizeof(struct dpbp_attr));
-	error = dpbp_get_attributes(&restool.mc_io, 0, dpbp_handle, &dpbp_attr);
+	error = dpbp_get_attributes(&ctx->mc_io, ctx->cmd_flags, dpbp_handle,
+				    &dpbp_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
-	print_new_obj("dpbp", dpbp_attr.id, NULL);
+	print_new_obj(ctx, "dpbp", dpbp_attr.id, NULL);
 
-	error = dpbp_close(&restool.mc_io, 0, dpbp_handle);
+	error = dpbp_close(&ctx->mc_io, ctx->cmd_flags, dpbp_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	return 0;
 }
 
-static int create_dpbp_v10(struct dpbp_cfg_v10 *dpbp_cfg)
+static int create_dpbp_v10(struct restool *ctx, struct dpbp_cfg_v10 *dpbp_cfg)
 {
 	uint32_t dpbp_id, dprc_id;
 	uint16_t dprc_handle;
 	bool dprc_opened;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
+	dprc_handle = ctx->root_dprc_handle;
 	dprc_opened = false;
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
 		error = parse_object_name(
-				restool.cmd_option_args[CREATE_OPT_PARENT_DPRC],
+				ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC],
 				"dprc", &dprc_id);
 		if (error)
 			return error;
 
-		if (restool.root_dprc_id != dprc_id) {
-			error = open_dprc(dprc_id, &dprc_handle);
+		if (ctx->root_dprc_id != dprc_id) {
+			error = open_dprc(ctx, dprc_id, &dprc_handle);
 			if (error)
 				return error;
 			dprc_opened = true;
 		}
 	}
 
-	error = dpbp_create_v10(&restool.mc_io, dprc_handle,
-				0, dpbp_cfg, &dpbp_id);
+	error = dpbp_create_v10(&ctx->mc_io, dprc_handle,
+				ctx->cmd_flags, dpbp_cfg, &dpbp_id);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	if (dprc_opened) {
-		(void)dprc_close(&restool.mc_io, 0, dprc_handle);
-		print_new_obj("dpbp", dpbp_id,
-			      restool.cmd_option_args[CREATE_OPT_PARENT_DPRC]);
+		(void)dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
+		print_new_obj(ctx, "dpbp", dpbp_id,
+			      ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC]);
 	} else {
-		print_new_obj("dpbp", dpbp_id, NULL);
+		print_new_obj(ctx, "dpbp", dpbp_id, NULL);
 	}
 
 	return 0;
 }
 
-static int create_dpbp(int mc_fw_version, const char *usage_msg)
+static int create_dpbp(struct restool *ctx, int mc_fw_version,
+		       const char *usage_msg)
 {
 	int error;
 	struct dpbp_cfg dpbp_cfg;
 	struct dpbp_cfg_v10 dpbp_cfg_v10;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name != NULL) {
+	if (ctx->obj_name != NULL) {
 		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
-			     restool.obj_name);
+			     ctx->obj_name);
 		puts(usage_msg);
 		return -EINVAL;
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = create_dpbp_v9(&dpbp_cfg);
+		error = create_dpbp_v9(ctx, &dpbp_cfg);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = create_dpbp_v10(&dpbp_cfg_v10);
+		error = create_dpbp_v10(ctx, &dpbp_cfg_v10);
 	else
 		return -EINVAL;
 
 	return error;
 }
 
-static int cmd_dpbp_create_v9(void)
+static int cmd_dpbp_create_v9(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
 		"Usage: restool dpbp create\n"
 		"\n";
 
-	return create_dpbp(MC_FW_VERSION_9, usage_msg);
+	return create_dpbp(ctx, MC_FW_VERSION_9, usage_msg);
 }
 
-static int cmd_dpbp_create_v10(void)
+static int cmd_dpbp_create_v10(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -492,20 +539,21 @@ static int cmd_dpbp_create_v10(void)
 		"   If it is not specified, the new object will be created under the default dprc.\n"
 		"\n";
 
-	return create_dpbp(MC_FW_VERSION_10, usage_msg);
+	return create_dpbp(ctx, MC_FW_VERSION_10, usage_msg);
 }
 
-static int destroy_dpbp_v9(uint32_t dpbp_id)
+static int destroy_dpbp_v9(struct restool *ctx, uint32_t dpbp_id)
 {
 	bool dpbp_opened = false;
 	uint16_t dpbp_handle;
 	int error, error2;
 
-	error = dpbp_open(&restool.mc_io, 0, dpbp_id, &dpbp_handle);
+	error = dpbp_open(&ctx->mc_io, ctx->cmd_flags, dpbp_id, &dpbp_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpbp_opened = true;
@@ -517,23 +565,25 @@ static int destroy_dpbp_v9(uint32_t dpbp_id)
 		goto out;
 	}
 
-	error = dpbp_destroy(&restool.mc_io, 0, dpbp_handle);
+	error = dpbp_destroy(&ctx->mc_io, ctx->cmd_flags, dpbp_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpbp_opened = false;
-	printf("dpbp.%u is destroyed\n", dpbp_id);
+	print_destroyed_obj("dpbp", dpbp_id);
 
 out:
 	if (dpbp_opened) {
-		error2 = dpbp_close(&restool.mc_io, 0, dpbp_handle);
+		error2 = dpbp_close(&ctx->mc_io, ctx->cmd_flags, dpbp_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -542,42 +592,43 @@ out:
 	return error;
 }
 
-static int destroy_dpbp_v10(uint32_t dpbp_id)
+static int destroy_dpbp_v10(struct restool *ctx, uint32_t dpbp_id)
 {
 	uint16_t dprc_handle;
 	uint32_t dprc_id;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
-	dprc_id = restool.root_dprc_id;
-	error = get_parent_dprc_id(dpbp_id, "dpbp", &dprc_id);
+	dprc_handle = ctx->root_dprc_handle;
+	dprc_id = ctx->root_dprc_id;
+	error = get_parent_dprc_id(ctx, dpbp_id, "dpbp", &dprc_id);
 	if (error)
 		return error;
 
-	if (dprc_id != restool.root_dprc_id) {
-		error = open_dprc(dprc_id, &dprc_handle);
+	if (dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, dprc_id, &dprc_handle);
 		if (error)
 			return error;
 	}
 
-	error = dpbp_destroy_v10(&restool.mc_io, dprc_handle,
-				 0, dpbp_id);
+	error = dpbp_destroy_v10(&ctx->mc_io, dprc_handle,
+				 ctx->cmd_flags, dpbp_id);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
-	printf("dpbp.%u is destroyed\n", dpbp_id);
+	print_destroyed_obj("dpbp", dpbp_id);
 
 out:
-	if (dprc_id != restool.root_dprc_id)
-		error = dprc_close(&restool.mc_io, 0, dprc_handle);
+	if (dprc_id != ctx->root_dprc_id)
+		error = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 
 	return error;
 }
 
-static int destroy_dpbp(int mc_fw_version)
+static int destroy_dpbp(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -588,37 +639,37 @@ static int destroy_dpbp(int mc_fw_version)
 	int error;
 	uint32_t dpbp_id;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	if (in_use(restool.obj_name, "destroyed")) {
+	if (in_use(ctx->obj_name, "destroyed")) {
 		error = -EBUSY;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpbp", &dpbp_id);
+	error = parse_object_name(ctx->obj_name, "dpbp", &dpbp_id);
 	if (error < 0)
 		goto out;
 
-	if (!find_obj("dpbp", dpbp_id)) {
+	if (!find_obj(ctx, "dpbp", dpbp_id)) {
 		error = -EINVAL;
 		goto out;
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = destroy_dpbp_v9(dpbp_id);
+		error = destroy_dpbp_v9(ctx, dpbp_id);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = destroy_dpbp_v10(dpbp_id);
+		error = destroy_dpbp_v10(ctx, dpbp_id);
 	else
 		return -EINVAL;
 
@@ -626,14 +677,14 @@ out:
 	return error;
 }
 
-static int cmd_dpbp_destroy_v9(void)
+static int cmd_dpbp_destroy_v9(struct restool *ctx)
 {
-	return destroy_dpbp(MC_FW_VERSION_9);
+	return destroy_dpbp(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpbp_destroy_v10(void)
+static int cmd_dpbp_destroy_v10(struct restool *ctx)
 {
-	return destroy_dpbp(MC_FW_VERSION_10);
+	return destroy_dpbp(ctx, MC_FW_VERSION_10);
 }
 
 struct object_command dpbp_commands_v9[] = {
@@ -651,7 +702,8 @@ struct object_command dpbp_commands_v9[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpbp_destroy_options,
-	  .cmd_func = cmd_dpbp_destroy_v9 },
+	  .cmd_func = cmd_dpbp_destroy_v9,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -671,7 +723,8 @@ struct object_command dpbp_commands_v10[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpbp_destroy_options,
-	  .cmd_func = cmd_dpbp_destroy_v10 },
+	  .cmd_func = cmd_dpbp_destroy_v10,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
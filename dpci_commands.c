@@ -50,6 +50,7 @@
 enum dpci_info_options {
 	INFO_OPT_HELP = 0,
 	INFO_OPT_VERBOSE,
+	INFO_OPT_FIELDS,
 };
 
 static struct option dpci_info_options[] = {
@@ -67,6 +68,13 @@ static struct option dpci_info_options[] = {
 		.val = 0,
 	},
 
+	[INFO_OPT_FIELDS] = {
+		.name = "fields",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
 	{ 0 },
 };
 
@@ -149,7 +157,7 @@ static struct option_entry options_map_v10[] = {
 };
 static unsigned int options_num_v10 = ARRAY_SIZE(options_map_v10);
 
-static int cmd_dpci_help(void)
+static int cmd_dpci_help(struct restool *ctx)
 {
 	static const char help_msg[] =
 		"\n"
@@ -162,11 +170,12 @@ static int cmd_dpci_help(void)
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
 
+	(void)ctx;
 	printf(help_msg);
 	return 0;
 }
 
-static int print_dpci_attr_v9(uint32_t dpci_id,
+static int print_dpci_attr_v9(struct restool *ctx, uint32_t dpci_id,
 			      struct dprc_obj_desc *target_obj_desc)
 {
 	uint16_t dpci_handle;
@@ -176,11 +185,12 @@ static int print_dpci_attr_v9(uint32_t dpci_id,
 	bool dpci_opened = false;
 	int link_state;
 
-	error = dpci_open(&restool.mc_io, 0, dpci_id, &dpci_handle);
+	error = dpci_open(&ctx->mc_io, ctx->cmd_flags, dpci_id, &dpci_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpci_opened = true;
@@ -193,52 +203,59 @@ static int print_dpci_attr_v9(uint32_t dpci_id,
 	}
 
 	memset(&dpci_attr, 0, sizeof(dpci_attr));
-	error = dpci_get_attributes(&restool.mc_io, 0, dpci_handle, &dpci_attr);
+	error = dpci_get_attributes(&ctx->mc_io, ctx->cmd_flags, dpci_handle,
+				    &dpci_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(dpci_id == (uint32_t)dpci_attr.id);
 
-	error = dpci_get_peer_attributes(&restool.mc_io, 0, dpci_handle,
+	error = dpci_get_peer_attributes(&ctx->mc_io, ctx->cmd_flags,
+					 dpci_handle,
 					 &dpci_peer_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 
-	error = dpci_get_link_state(&restool.mc_io, 0, dpci_handle,
+	error = dpci_get_link_state(&ctx->mc_io, ctx->cmd_flags, dpci_handle,
 					&link_state);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 
-	printf("dpci version: %u.%u\n", dpci_attr.version.major,
-	       dpci_attr.version.minor);
-	printf("dpci id: %d\n", dpci_attr.id);
-	printf("plugged state: %splugged\n",
+	output_field("version", "dpci version",
+		     "%u.%u", dpci_attr.version.major,
+		     dpci_attr.version.minor);
+	output_int("id", "dpci id", dpci_attr.id);
+	output_field("plugged_state", "plugged state", "%splugged",
 		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	printf("num_of_priorities: %u\n",
-	       (unsigned int)dpci_attr.num_of_priorities);
-	printf("connected peer: ");
+	output_uint("num_priorities", "num_of_priorities",
+		    (unsigned int)dpci_attr.num_of_priorities);
 	if (-1 == dpci_peer_attr.peer_id) {
-		printf("no peer\n");
+		output_field("peer", "connected peer", "no peer");
 	} else {
-		printf("dpci.%d\n", dpci_peer_attr.peer_id);
-		printf("peer's num_of_priorities: %u\n",
-		       (unsigned int)dpci_peer_attr.num_of_priorities);
+		output_field("peer", "connected peer", "dpci.%d",
+			     dpci_peer_attr.peer_id);
+		output_uint("peer_num_priorities", "peer's num_of_priorities",
+			    (unsigned int)dpci_peer_attr.num_of_priorities);
 	}
-	printf("link status: %d - ", link_state);
-	link_state == 0 ? printf("down\n") :
-	link_state == 1 ? printf("up\n") : printf("error state\n");
-	print_obj_label(target_obj_desc);
+	output_bool("link_up", "link status", link_state == 1, "%d - %s",
+		    link_state,
+		    link_state == 0 ? "down" :
+		    link_state == 1 ? "up" : "error state");
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -246,11 +263,12 @@ out:
 	if (dpci_opened) {
 		int error2;
 
-		error2 = dpci_close(&restool.mc_io, 0, dpci_handle);
+		error2 = dpci_close(&ctx->mc_io, ctx->cmd_flags, dpci_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -259,7 +277,7 @@ out:
 	return error;
 }
 
-static int print_dpci_attr_v10(uint32_t dpci_id,
+static int print_dpci_attr_v10(struct restool *ctx, uint32_t dpci_id,
 			       struct dprc_obj_desc *target_obj_desc)
 {
 	struct dpci_peer_attr_v10 dpci_peer_attr;
@@ -267,90 +285,124 @@ static int print_dpci_attr_v10(uint32_t dpci_id,
 	uint16_t obj_major, obj_minor;
 	uint16_t dpci_handle;
 	bool dpci_opened = false;
-	int error, error2;
+	int error = 0, error2;
 	int link_state;
 
-	error = dpci_open_v10(&restool.mc_io, 0, dpci_id, &dpci_handle);
-	if (error) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
+	if (INFO_FIELD(ATTR) || INFO_FIELD(ENDPOINT) || INFO_FIELD(LINK)) {
+		error = dpci_open_v10(&ctx->mc_io, ctx->cmd_flags, dpci_id,
+				      &dpci_handle);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
 
-	dpci_opened = true;
-	if (!dpci_handle) {
-		DEBUG_PRINTF(
-			"dpci_open() returned invalid handle (auth 0) for dpci.%u\n",
-			dpci_id);
-		error = -ENOENT;
-		goto out;
+		dpci_opened = true;
+		if (!dpci_handle) {
+			DEBUG_PRINTF(
+				"dpci_open() returned invalid handle (auth 0) for dpci.%u\n",
+				dpci_id);
+			error = -ENOENT;
+			goto out;
+		}
 	}
 
-	memset(&dpci_attr, 0, sizeof(dpci_attr));
-	error = dpci_get_attributes_v10(&restool.mc_io, 0,
-					dpci_handle, &dpci_attr);
-	if (error) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+	if (INFO_FIELD(ATTR)) {
+		memset(&dpci_attr, 0, sizeof(dpci_attr));
+		error = dpci_get_attributes_v10(&ctx->mc_io, ctx->cmd_flags,
+						dpci_handle, &dpci_attr);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		assert(dpci_id == (uint32_t)dpci_attr.id);
 	}
-	assert(dpci_id == (uint32_t)dpci_attr.id);
 
-	error = dpci_get_peer_attributes_v10(&restool.mc_io, 0, dpci_handle,
-					     &dpci_peer_attr);
-	if (error) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+	if (INFO_FIELD(ENDPOINT)) {
+		error = dpci_get_peer_attributes_v10(&ctx->mc_io,
+						     ctx->cmd_flags,
+						     dpci_handle,
+						     &dpci_peer_attr);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
 	}
 
-	error = dpci_get_link_state_v10(&restool.mc_io, 0, dpci_handle,
-					&link_state);
-	if (error) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+	if (INFO_FIELD(LINK)) {
+		error = dpci_get_link_state_v10(&ctx->mc_io, ctx->cmd_flags,
+						dpci_handle,
+						&link_state);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
 	}
 
-	error = dpci_get_api_version_v10(&restool.mc_io, 0, &obj_major, &obj_minor);
-	if (error) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+	if (INFO_FIELD(VERSION)) {
+		error = get_obj_api_version(ctx, "dpci",
+					    dpci_get_api_version_v10,
+					    &obj_major, &obj_minor);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		output_field("version", "dpci version",
+			     "%u.%u", obj_major, obj_minor);
+	}
+
+	if (INFO_FIELD(ID))
+		output_int("id", "dpci id", dpci_id);
+	if (INFO_FIELD(STATE))
+		output_field("plugged_state", "plugged state", "%splugged",
+			     (target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ?
+			     "" : "un");
+	if (INFO_FIELD(ATTR))
+		output_uint("num_priorities", "num_priorities",
+			    (unsigned int)dpci_attr.num_of_priorities);
+	if (INFO_FIELD(ENDPOINT)) {
+		if (-1 == dpci_peer_attr.peer_id) {
+			output_field("peer", "connected peer", "no peer");
+		} else {
+			output_field("peer", "connected peer", "dpci.%d",
+				     dpci_peer_attr.peer_id);
+			output_uint("peer_num_priorities",
+				    "peer's num_of_priorities",
+				    (unsigned int)dpci_peer_attr.num_of_priorities);
+		}
 	}
-
-	printf("dpci version: %u.%u\n", obj_major, obj_minor);
-	printf("dpci id: %d\n", dpci_id);
-	printf("plugged state: %splugged\n",
-		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	printf("num_priorities: %u\n",
-	       (unsigned int)dpci_attr.num_of_priorities);
-	printf("connected peer: ");
-	if (-1 == dpci_peer_attr.peer_id) {
-		printf("no peer\n");
-	} else {
-		printf("dpci.%d\n", dpci_peer_attr.peer_id);
-		printf("peer's num_of_priorities: %u\n",
-		       (unsigned int)dpci_peer_attr.num_of_priorities);
+	if (INFO_FIELD(LINK)) {
+		output_bool("link_up", "link status", link_state == 1,
+			    "%d - %s", link_state,
+			    link_state == 0 ? "down" :
+			    link_state == 1 ? "up" : "error state");
 	}
-	printf("link status: %d - ", link_state);
-	link_state == 0 ? printf("down\n") :
-	link_state == 1 ? printf("up\n") : printf("error state\n");
-	print_obj_label(target_obj_desc);
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 out:
 	if (dpci_opened) {
-		error2 = dpci_close_v10(&restool.mc_io, 0, dpci_handle);
+		error2 = dpci_close_v10(&ctx->mc_io, ctx->cmd_flags,
+					dpci_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -359,51 +411,50 @@ out:
 	return error;
 }
 
-static int print_dpci_info(uint32_t dpci_id, int mc_fw_version)
+static int print_dpci_info(struct restool *ctx, uint32_t dpci_id,
+			   int mc_fw_version)
 {
 	int error;
 	struct dprc_obj_desc target_obj_desc;
-	uint32_t target_parent_dprc_id;
-	bool found = false;
-
-	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0, dpci_id,
-				"dpci", &target_obj_desc,
-				&target_parent_dprc_id, &found);
+
+	error = find_info_obj_desc(ctx, dpci_id, "dpci",
+				   ctx->cmd_option_mask &
+				   ONE_BIT_MASK(INFO_OPT_VERBOSE),
+				   &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (strcmp(target_obj_desc.type, "dpci")) {
-		printf("dpci.%d does not exist\n", dpci_id);
-		return -EINVAL;
-	}
-
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = print_dpci_attr_v9(dpci_id, &target_obj_desc);
+		error = print_dpci_attr_v9(ctx, dpci_id, &target_obj_desc);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = print_dpci_attr_v10(dpci_id, &target_obj_desc);
+		error = print_dpci_attr_v10(ctx, dpci_id, &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpci_ops);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
+		error = print_obj_verbose(ctx, &target_obj_desc, &dpci_ops);
 	}
 
 out:
 	return error;
 }
 
-static int info_dpci(int mc_fw_version)
+static int info_dpci(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
 		"Usage: restool dpci info <dpci-object> [--verbose]\n"
+		"                         [--fields=<field>[,<field>...]]\n"
 		"\n"
 		"OPTIONS:\n"
 		"--verbose\n"
 		"   Shows extended/verbose information about the object\n"
+		"--fields=<field>[,<field>...]\n"
+		"   Shows only the given fields and sends only the MC\n"
+		"   commands they need. <field> is one of: version, id,\n"
+		"   state, endpoint, link, mac, attr, stats, label.\n"
+		"   Requires MC firmware 10.x.\n"
 		"\n"
 		"EXAMPLE:\n"
 		"Display information about dpci.5:\n"
@@ -413,40 +464,48 @@ static int info_dpci(int mc_fw_version)
 	uint32_t obj_id;
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_FIELDS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_FIELDS);
+		error = parse_info_fields(ctx, 
+				ctx->cmd_option_args[INFO_OPT_FIELDS]);
+		if (error < 0)
+			goto out;
+	}
+
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpci", &obj_id);
+	error = parse_object_name(ctx->obj_name, "dpci", &obj_id);
 	if (error < 0)
 		goto out;
 
-	error = print_dpci_info(obj_id, mc_fw_version);
+	error = print_dpci_info(ctx, obj_id, mc_fw_version);
 out:
 	return error;
 }
 
-static int cmd_dpci_info_v9(void)
+static int cmd_dpci_info_v9(struct restool *ctx)
 {
-	return info_dpci(MC_FW_VERSION_9);
+	return info_dpci(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpci_info_v10(void)
+static int cmd_dpci_info_v10(struct restool *ctx)
 {
-	return info_dpci(MC_FW_VERSION_10);
+	return info_dpci(ctx, MC_FW_VERSION_10);
 }
 
-static int create_dpci_v9(const char *usage_msg)
+static int create_dpci_v9(struct restool *ctx, const char *usage_msg)
 {
 	struct dpci_attr dpci_attr;
 	struct dpci_cfg dpci_cfg;
@@ -454,23 +513,23 @@ static int create_dpci_v9(const char *usage_msg)
 	int error;
 	long val;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name != NULL) {
+	if (ctx->obj_name != NULL) {
 		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
-			     restool.obj_name);
+			     ctx->obj_name);
 		puts(usage_msg);
 		return -EINVAL;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_PRIORITIES)) {
-		restool.cmd_option_mask &=
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_PRIORITIES)) {
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_NUM_PRIORITIES);
-		error = get_option_value(CREATE_OPT_NUM_PRIORITIES, &val,
+		error = get_option_value(ctx, CREATE_OPT_NUM_PRIORITIES, &val,
 					 "Invalid value: num-priorities option",
 					 1, 2);
 		if (error)
@@ -481,36 +540,41 @@ static int create_dpci_v9(const char *usage_msg)
 		dpci_cfg.num_of_priorities = 1;
 	}
 
-	error = dpci_create(&restool.mc_io, 0, &dpci_cfg, &dpci_handle);
+	error = dpci_create(&ctx->mc_io, ctx->cmd_flags, &dpci_cfg,
+			    &dpci_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	memset(&dpci_attr, 0, sizeof(struct dpci_attr));
-	error = dpci_get_attributes(&restool.mc_io, 0, dpci_handle, &dpci_attr);
+	error = dpci_get_attributes(&ctx->mc_io, ctx->cmd_flags, dpci_handle,
+				    &dpci_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
-	print_new_obj("dpci", dpci_attr.id, NULL);
+	print_new_obj(ctx, "dpci", dpci_attr.id, NULL);
 
-	error = dpci_close(&restool.mc_io, 0, dpci_handle);
+	error = dpci_close(&ctx->mc_io, ctx->cmd_flags, dpci_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	return 0;
 }
 
-static int create_dpci_v10(const char *usage_msg)
+static int create_dpci_v10(struct restool *ctx, const char *usage_msg)
 {
 	struct dpci_cfg_v10 dpci_cfg;
 	uint32_t dpci_id, dprc_id;
@@ -519,23 +583,23 @@ static int create_dpci_v10(const char *usage_msg)
 	int error;
 	long val;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name != NULL) {
+	if (ctx->obj_name != NULL) {
 		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
-			     restool.obj_name);
+			     ctx->obj_name);
 		puts(usage_msg);
 		return -EINVAL;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_OPTIONS)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_OPTIONS);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_OPTIONS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_OPTIONS);
 		error = parse_generic_create_options(
-				restool.cmd_option_args[CREATE_OPT_OPTIONS],
+				ctx->cmd_option_args[CREATE_OPT_OPTIONS],
 				(uint64_t *)&dpci_cfg.options,
 				options_map_v10,
 				options_num_v10);
@@ -547,10 +611,10 @@ static int create_dpci_v10(const char *usage_msg)
 		}
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_PRIORITIES)) {
-		restool.cmd_option_mask &=
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_PRIORITIES)) {
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_NUM_PRIORITIES);
-		error = get_option_value(CREATE_OPT_NUM_PRIORITIES, &val,
+		error = get_option_value(ctx, CREATE_OPT_NUM_PRIORITIES, &val,
 					 "Invalid value: num-priorities option",
 					 1, 2);
 		if (error)
@@ -561,45 +625,48 @@ static int create_dpci_v10(const char *usage_msg)
 		dpci_cfg.num_of_priorities = 1;
 	}
 
-	dprc_handle = restool.root_dprc_handle;
+	dprc_handle = ctx->root_dprc_handle;
 	dprc_opened = false;
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
 		error = parse_object_name(
-				restool.cmd_option_args[CREATE_OPT_PARENT_DPRC],
+				ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC],
 				"dprc", &dprc_id);
 		if (error)
 			return error;
 
-		if (restool.root_dprc_id != dprc_id) {
-			error = open_dprc(dprc_id, &dprc_handle);
+		if (ctx->root_dprc_id != dprc_id) {
+			error = open_dprc(ctx, dprc_id, &dprc_handle);
 			if (error)
 				return error;
 			dprc_opened = true;
 		}
 	}
 
-	error = dpci_create_v10(&restool.mc_io, dprc_handle, 0, &dpci_cfg, &dpci_id);
+	error = dpci_create_v10(&ctx->mc_io, dprc_handle, ctx->cmd_flags,
+				&dpci_cfg,
+				&dpci_id);
 	if (error) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	if (dprc_opened) {
-		(void)dprc_close(&restool.mc_io, 0, dprc_handle);
-		print_new_obj("dpci", dpci_id,
-			      restool.cmd_option_args[CREATE_OPT_PARENT_DPRC]);
+		(void)dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
+		print_new_obj(ctx, "dpci", dpci_id,
+			      ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC]);
 	} else {
-		print_new_obj("dpci", dpci_id, NULL);
+		print_new_obj(ctx, "dpci", dpci_id, NULL);
 
 	}
 
 	return 0;
 }
 
-static int cmd_dpci_create_v9(void)
+static int cmd_dpci_create_v9(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -619,10 +686,10 @@ static int cmd_dpci_create_v9(void)
 		"   $ restool dpci create --num-priorities=2\n"
 		"\n";
 
-	return create_dpci_v9(usage_msg);
+	return create_dpci_v9(ctx, usage_msg);
 }
 
-static int cmd_dpci_create_v10(void)
+static int cmd_dpci_create_v10(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -649,22 +716,23 @@ static int cmd_dpci_create_v10(void)
 		"   $ restool dpci create --num-priorities=2\n"
 		"\n";
 
-	return create_dpci_v10(usage_msg);
+	return create_dpci_v10(ctx, usage_msg);
 
 	return -EINVAL;
 }
 
-static int destroy_dpci_v9(uint32_t dpci_id)
+static int destroy_dpci_v9(struct restool *ctx, uint32_t dpci_id)
 {
 	bool dpci_opened = false;
 	uint16_t dpci_handle;
 	int error, error2;
 
-	error = dpci_open(&restool.mc_io, 0, dpci_id, &dpci_handle);
+	error = dpci_open(&ctx->mc_io, ctx->cmd_flags, dpci_id, &dpci_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpci_opened = true;
@@ -676,23 +744,25 @@ static int destroy_dpci_v9(uint32_t dpci_id)
 		goto out;
 	}
 
-	error = dpci_destroy(&restool.mc_io, 0, dpci_handle);
+	error = dpci_destroy(&ctx->mc_io, ctx->cmd_flags, dpci_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpci_opened = false;
-	printf("dpci.%u is destroyed\n", dpci_id);
+	print_destroyed_obj("dpci", dpci_id);
 
 out:
 	if (dpci_opened) {
-		error2 = dpci_close(&restool.mc_io, 0, dpci_handle);
+		error2 = dpci_close(&ctx->mc_io, ctx->cmd_flags, dpci_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -701,42 +771,43 @@ out:
 	return error;
 }
 
-static int destroy_dpci_v10(uint32_t dpci_id)
+static int destroy_dpci_v10(struct restool *ctx, uint32_t dpci_id)
 {
 	uint16_t dprc_handle;
 	uint32_t dprc_id;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
-	dprc_id = restool.root_dprc_id;
-	error = get_parent_dprc_id(dpci_id, "dpci", &dprc_id);
+	dprc_handle = ctx->root_dprc_handle;
+	dprc_id = ctx->root_dprc_id;
+	error = get_parent_dprc_id(ctx, dpci_id, "dpci", &dprc_id);
 	if (error)
 		return error;
 
-	if (dprc_id != restool.root_dprc_id) {
-		error = open_dprc(dprc_id, &dprc_handle);
+	if (dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, dprc_id, &dprc_handle);
 		if (error)
 			return error;
 	}
 
-	error = dpci_destroy_v10(&restool.mc_io, dprc_handle,
-				 0, dpci_id);
+	error = dpci_destroy_v10(&ctx->mc_io, dprc_handle,
+				 ctx->cmd_flags, dpci_id);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
-	printf("dpci.%u is destroyed\n", dpci_id);
+	print_destroyed_obj("dpci", dpci_id);
 
 out:
-	if (dprc_id != restool.root_dprc_id)
-		error = dprc_close(&restool.mc_io, 0, dprc_handle);
+	if (dprc_id != ctx->root_dprc_id)
+		error = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 
 	return error;
 }
 
-static int destroy_dpci(int mc_fw_version)
+static int destroy_dpci(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -747,37 +818,37 @@ static int destroy_dpci(int mc_fw_version)
 	int error;
 	uint32_t dpci_id;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	if (in_use(restool.obj_name, "destroyed")) {
+	if (in_use(ctx->obj_name, "destroyed")) {
 		error = -EBUSY;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpci", &dpci_id);
+	error = parse_object_name(ctx->obj_name, "dpci", &dpci_id);
 	if (error < 0)
 		goto out;
 
-	if (!find_obj("dpci", dpci_id)) {
+	if (!find_obj(ctx, "dpci", dpci_id)) {
 		error = -EINVAL;
 		goto out;
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = destroy_dpci_v9(dpci_id);
+		error = destroy_dpci_v9(ctx, dpci_id);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = destroy_dpci_v10(dpci_id);
+		error = destroy_dpci_v10(ctx, dpci_id);
 	else
 		return -EINVAL;
 
@@ -785,14 +856,14 @@ out:
 	return error;
 }
 
-static int cmd_dpci_destroy_v9(void)
+static int cmd_dpci_destroy_v9(struct restool *ctx)
 {
-	return destroy_dpci(MC_FW_VERSION_9);
+	return destroy_dpci(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpci_destroy_v10(void)
+static int cmd_dpci_destroy_v10(struct restool *ctx)
 {
-	return destroy_dpci(MC_FW_VERSION_10);
+	return destroy_dpci(ctx, MC_FW_VERSION_10);
 }
 
 struct object_command dpci_commands_v9[] = {
@@ -810,7 +881,8 @@ struct object_command dpci_commands_v9[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpci_destroy_options,
-	  .cmd_func = cmd_dpci_destroy_v9 },
+	  .cmd_func = cmd_dpci_destroy_v9,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -830,7 +902,8 @@ struct object_command dpci_commands_v10[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpci_destroy_options,
-	  .cmd_func = cmd_dpci_destroy_v10 },
+	  .cmd_func = cmd_dpci_destroy_v10,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
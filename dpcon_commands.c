@@ -50,6 +50,7 @@
 enum dpcon_info_options {
 	INFO_OPT_HELP = 0,
 	INFO_OPT_VERBOSE,
+	INFO_OPT_FIELDS,
 };
 
 static struct option dpcon_info_options[] = {
@@ -67,6 +68,13 @@ static struct option dpcon_info_options[] = {
 		.val = 0,
 	},
 
+	[INFO_OPT_FIELDS] = {
+		.name = "fields",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
 	{ 0 },
 };
 
@@ -135,7 +143,7 @@ static const struct flib_ops dpcon_ops = {
 	.obj_get_irq_status = dpcon_get_irq_status,
 };
 
-static int cmd_dpcon_help(void)
+static int cmd_dpcon_help(struct restool *ctx)
 {
 	static const char help_msg[] =
 		"\n"
@@ -148,11 +156,12 @@ static int cmd_dpcon_help(void)
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
 
+	(void)ctx;
 	printf(help_msg);
 	return 0;
 }
 
-static int print_dpcon_attr_v9(uint32_t dpcon_id,
+static int print_dpcon_attr_v9(struct restool *ctx, uint32_t dpcon_id,
 			       struct dprc_obj_desc *target_obj_desc)
 {
 	uint16_t dpcon_handle;
@@ -160,11 +169,13 @@ static int print_dpcon_attr_v9(uint32_t dpcon_id,
 	struct dpcon_attr dpcon_attr;
 	bool dpcon_opened = false;
 
-	error = dpcon_open(&restool.mc_io, 0, dpcon_id, &dpcon_handle);
+	error = dpcon_open(&ctx->mc_io, ctx->cmd_flags, dpcon_id,
+			   &dpcon_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpcon_opened = true;
@@ -177,26 +188,30 @@ static int print_dpcon_attr_v9(uint32_t dpcon_id,
 	}
 
 	memset(&dpcon_attr, 0, sizeof(dpcon_attr));
-	error = dpcon_get_attributes(&restool.mc_io, 0, dpcon_handle,
+	error = dpcon_get_attributes(&ctx->mc_io, ctx->cmd_flags, dpcon_handle,
 					&dpcon_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(dpcon_id == (uint32_t)dpcon_attr.id);
 
-	printf("dpcon version: %u.%u\n", dpcon_attr.version.major,
-	       dpcon_attr.version.minor);
-	printf("dpcon id: %d\n", dpcon_attr.id);
-	printf("plugged state: %splugged\n",
+	output_field("version", "dpcon version",
+		     "%u.%u", dpcon_attr.version.major,
+		     dpcon_attr.version.minor);
+	output_int("id", "dpcon id", dpcon_attr.id);
+	output_field("plugged_state", "plugged state", "%splugged",
 		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	printf("qbman channel id to be used by dequeue operation: %u\n",
+	output_uint("qbman_channel_id",
+		    "qbman channel id to be used by dequeue operation",
 		dpcon_attr.qbman_ch_id);
-	printf("number of priorities for the DPCON channel: %u\n",
+	output_uint("num_priorities",
+		    "number of priorities for the DPCON channel",
 		dpcon_attr.num_priorities);
-	print_obj_label(target_obj_desc);
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -204,11 +219,12 @@ out:
 	if (dpcon_opened) {
 		int error2;
 
-		error2 = dpcon_close(&restool.mc_io, 0, dpcon_handle);
+		error2 = dpcon_close(&ctx->mc_io, ctx->cmd_flags, dpcon_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -217,60 +233,76 @@ out:
 	return error;
 }
 
-static int print_dpcon_attr_v10(uint32_t dpcon_id,
+static int print_dpcon_attr_v10(struct restool *ctx, uint32_t dpcon_id,
 				struct dprc_obj_desc *target_obj_desc)
 {
 	struct dpcon_attr_v10 dpcon_attr;
 	uint16_t obj_major, obj_minor;
 	bool dpcon_opened = false;
 	uint16_t dpcon_handle;
-	int error;
+	int error = 0;
 
-	error = dpcon_open_v10(&restool.mc_io, 0, dpcon_id, &dpcon_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpcon_opened = true;
-	if (0 == dpcon_handle) {
-		DEBUG_PRINTF(
-			"dpcon_open() returned invalid handle (auth 0) for dpcon.%u\n",
-			dpcon_id);
-		error = -ENOENT;
-		goto out;
-	}
+	if (INFO_FIELD(ATTR)) {
+		error = dpcon_open_v10(&ctx->mc_io, ctx->cmd_flags, dpcon_id,
+				       &dpcon_handle);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		dpcon_opened = true;
+		if (0 == dpcon_handle) {
+			DEBUG_PRINTF(
+				"dpcon_open() returned invalid handle (auth 0) for dpcon.%u\n",
+				dpcon_id);
+			error = -ENOENT;
+			goto out;
+		}
 
-	memset(&dpcon_attr, 0, sizeof(dpcon_attr));
-	error = dpcon_get_attributes_v10(&restool.mc_io, 0, dpcon_handle,
-					 &dpcon_attr);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		memset(&dpcon_attr, 0, sizeof(dpcon_attr));
+		error = dpcon_get_attributes_v10(&ctx->mc_io, ctx->cmd_flags,
+						 dpcon_handle, &dpcon_attr);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		assert(dpcon_id == (uint32_t)dpcon_attr.id);
 	}
-	assert(dpcon_id == (uint32_t)dpcon_attr.id);
 
-	error = dpcon_get_api_version_v10(&restool.mc_io, 0,
-				      &obj_major, &obj_minor);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+	if (INFO_FIELD(VERSION)) {
+		error = get_obj_api_version(ctx, "dpcon",
+					    dpcon_get_api_version_v10,
+					    &obj_major, &obj_minor);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		output_field("version", "dpcon version",
+			     "%u.%u", obj_major, obj_minor);
 	}
 
-	printf("dpcon version: %u.%u\n", obj_major, obj_minor);
-	printf("dpcon id: %d\n", dpcon_attr.id);
-	printf("plugged state: %splugged\n",
-		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	printf("qbman channel id to be used by dequeue operation: %u\n",
-		dpcon_attr.qbman_ch_id);
-	printf("num_priorities: %u\n",
-		dpcon_attr.num_priorities);
-	print_obj_label(target_obj_desc);
+	if (INFO_FIELD(ID))
+		output_int("id", "dpcon id", dpcon_id);
+	if (INFO_FIELD(STATE))
+		output_field("plugged_state", "plugged state", "%splugged",
+			     (target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ?
+			     "" : "un");
+	if (INFO_FIELD(ATTR)) {
+		output_uint("qbman_channel_id",
+			    "qbman channel id to be used by dequeue operation",
+			    dpcon_attr.qbman_ch_id);
+		output_uint("num_priorities", "num_priorities",
+			dpcon_attr.num_priorities);
+	}
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -278,11 +310,13 @@ out:
 	if (dpcon_opened) {
 		int error2;
 
-		error2 = dpcon_close_v10(&restool.mc_io, 0, dpcon_handle);
+		error2 = dpcon_close_v10(&ctx->mc_io, ctx->cmd_flags,
+					 dpcon_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -291,51 +325,50 @@ out:
 	return error;
 }
 
-static int print_dpcon_info(uint32_t dpcon_id, int mc_fw_version)
+static int print_dpcon_info(struct restool *ctx, uint32_t dpcon_id,
+			    int mc_fw_version)
 {
 	int error;
 	struct dprc_obj_desc target_obj_desc;
-	uint32_t target_parent_dprc_id;
-	bool found = false;
-
-	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0, dpcon_id,
-				"dpcon", &target_obj_desc,
-				&target_parent_dprc_id, &found);
+
+	error = find_info_obj_desc(ctx, dpcon_id, "dpcon",
+				   ctx->cmd_option_mask &
+				   ONE_BIT_MASK(INFO_OPT_VERBOSE),
+				   &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (strcmp(target_obj_desc.type, "dpcon")) {
-		printf("dpcon.%d does not exist\n", dpcon_id);
-		return -EINVAL;
-	}
-
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = print_dpcon_attr_v9(dpcon_id, &target_obj_desc);
+		error = print_dpcon_attr_v9(ctx, dpcon_id, &target_obj_desc);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = print_dpcon_attr_v10(dpcon_id, &target_obj_desc);
+		error = print_dpcon_attr_v10(ctx, dpcon_id, &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpcon_ops);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
+		error = print_obj_verbose(ctx, &target_obj_desc, &dpcon_ops);
 	}
 
 out:
 	return error;
 }
 
-static int info_dpcon(int mc_fw_version)
+static int info_dpcon(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
 		"Usage: restool dpcon info <dpcon-object> [--verbose]\n"
+		"                         [--fields=<field>[,<field>...]]\n"
 		"\n"
 		"OPTIONS:\n"
 		"--verbose\n"
 		"   Shows extended/verbose information about the object\n"
+		"--fields=<field>[,<field>...]\n"
+		"   Shows only the given fields and sends only the MC\n"
+		"   commands they need. <field> is one of: version, id,\n"
+		"   state, endpoint, link, mac, attr, stats, label.\n"
+		"   Requires MC firmware 10.x.\n"
 		"\n"
 		"EXAMPLE:\n"
 		"Display information about dpcon.5:\n"
@@ -345,144 +378,159 @@ static int info_dpcon(int mc_fw_version)
 	uint32_t obj_id;
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_FIELDS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_FIELDS);
+		error = parse_info_fields(ctx, 
+				ctx->cmd_option_args[INFO_OPT_FIELDS]);
+		if (error < 0)
+			goto out;
+	}
+
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpcon", &obj_id);
+	error = parse_object_name(ctx->obj_name, "dpcon", &obj_id);
 	if (error < 0)
 		goto out;
 
-	error = print_dpcon_info(obj_id, mc_fw_version);
+	error = print_dpcon_info(ctx, obj_id, mc_fw_version);
 out:
 	return error;
 }
 
-static int cmd_dpcon_info_v9(void)
+static int cmd_dpcon_info_v9(struct restool *ctx)
 {
-	return info_dpcon(MC_FW_VERSION_9);
+	return info_dpcon(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpcon_info_v10(void)
+static int cmd_dpcon_info_v10(struct restool *ctx)
 {
-	return info_dpcon(MC_FW_VERSION_10);
+	return info_dpcon(ctx, MC_FW_VERSION_10);
 }
 
-static int create_dpcon_v9(struct dpcon_cfg *dpcon_cfg)
+static int create_dpcon_v9(struct restool *ctx, struct dpcon_cfg *dpcon_cfg)
 {
 	struct dpcon_attr dpcon_attr;
 	uint16_t dpcon_handle;
 	int error;
 
-	error = dpcon_create(&restool.mc_io, 0, dpcon_cfg, &dpcon_handle);
+	error = dpcon_create(&ctx->mc_io, ctx->cmd_flags, dpcon_cfg,
+			     &dpcon_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	memset(&dpcon_attr, 0, sizeof(struct dpcon_attr));
-	error = dpcon_get_attributes(&restool.mc_io, 0, dpcon_handle,
+	error = dpcon_get_attributes(&ctx->mc_io, ctx->cmd_flags, dpcon_handle,
 					&dpcon_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
-	print_new_obj("dpcon", dpcon_attr.id, NULL);
+	print_new_obj(ctx, "dpcon", dpcon_attr.id, NULL);
 
-	error = dpcon_close(&restool.mc_io, 0, dpcon_handle);
+	error = dpcon_close(&ctx->mc_io, ctx->cmd_flags, dpcon_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	return 0;
 }
 
-static int create_dpcon_v10(struct dpcon_cfg_v10 *dpcon_cfg)
+static int create_dpcon_v10(struct restool *ctx,
+			    struct dpcon_cfg_v10 *dpcon_cfg)
 {
 	uint32_t dpcon_id, dprc_id;
 	uint16_t dprc_handle;
 	bool dprc_opened;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
+	dprc_handle = ctx->root_dprc_handle;
 	dprc_opened = false;
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
 		error = parse_object_name(
-				restool.cmd_option_args[CREATE_OPT_PARENT_DPRC],
+				ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC],
 				"dprc", &dprc_id);
 		if (error)
 			return error;
 
-		if (restool.root_dprc_id != dprc_id) {
-			error = open_dprc(dprc_id, &dprc_handle);
+		if (ctx->root_dprc_id != dprc_id) {
+			error = open_dprc(ctx, dprc_id, &dprc_handle);
 			if (error)
 				return error;
 			dprc_opened = true;
 		}
 	}
 
-	error = dpcon_create_v10(&restool.mc_io, dprc_handle,
-				 0, dpcon_cfg, &dpcon_id);
+	error = dpcon_create_v10(&ctx->mc_io, dprc_handle,
+				 ctx->cmd_flags, dpcon_cfg, &dpcon_id);
 	if (error) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	if (dprc_opened) {
-		(void)dprc_close(&restool.mc_io, 0, dprc_handle);
-		print_new_obj("dpcon", dpcon_id,
-			      restool.cmd_option_args[CREATE_OPT_PARENT_DPRC]);
+		(void)dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
+		print_new_obj(ctx, "dpcon", dpcon_id,
+			      ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC]);
 	} else {
-		print_new_obj("dpcon", dpcon_id, NULL);
+		print_new_obj(ctx, "dpcon", dpcon_id, NULL);
 	}
 
 	return 0;
 }
 
-static int create_dpcon(int mc_fw_version, const char *usage_msg)
+static int create_dpcon(struct restool *ctx, int mc_fw_version,
+			const char *usage_msg)
 {
 	int error;
 	long val;
 	struct dpcon_cfg dpcon_cfg;
 	struct dpcon_cfg_v10 dpcon_cfg_v10;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name != NULL) {
+	if (ctx->obj_name != NULL) {
 		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
-			     restool.obj_name);
+			     ctx->obj_name);
 		puts(usage_msg);
 		return -EINVAL;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_PRIORITIES)) {
-		restool.cmd_option_mask &=
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_PRIORITIES)) {
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_NUM_PRIORITIES);
-		error = get_option_value(CREATE_OPT_NUM_PRIORITIES, &val,
+		error = get_option_value(ctx, CREATE_OPT_NUM_PRIORITIES, &val,
 					 "Invalid value: num-priorities option",
 					 1, 8);
 		if (error)
@@ -496,16 +544,16 @@ static int create_dpcon(int mc_fw_version, const char *usage_msg)
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = create_dpcon_v9(&dpcon_cfg);
+		error = create_dpcon_v9(ctx, &dpcon_cfg);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = create_dpcon_v10(&dpcon_cfg_v10);
+		error = create_dpcon_v10(ctx, &dpcon_cfg_v10);
 	else
 		return -EINVAL;
 
 	return error;
 }
 
-static int cmd_dpcon_create_v9(void)
+static int cmd_dpcon_create_v9(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -523,10 +571,10 @@ static int cmd_dpcon_create_v9(void)
 		"   $ restool dpcon create --num-priorities=2\n"
 		"\n";
 
-	return create_dpcon(MC_FW_VERSION_9, usage_msg);
+	return create_dpcon(ctx, MC_FW_VERSION_9, usage_msg);
 }
 
-static int cmd_dpcon_create_v10(void)
+static int cmd_dpcon_create_v10(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -547,20 +595,22 @@ static int cmd_dpcon_create_v10(void)
 		"   $ restool dpcon create --num-priorities=2\n"
 		"\n";
 
-	return create_dpcon(MC_FW_VERSION_10, usage_msg);
+	return create_dpcon(ctx, MC_FW_VERSION_10, usage_msg);
 }
 
-static int destroy_dpcon_v9(uint32_t dpcon_id)
+static int destroy_dpcon_v9(struct restool *ctx, uint32_t dpcon_id)
 {
 	bool dpcon_opened = false;
 	uint16_t dpcon_handle;
 	int error, error2;
 
-	error = dpcon_open(&restool.mc_io, 0, dpcon_id, &dpcon_handle);
+	error = dpcon_open(&ctx->mc_io, ctx->cmd_flags, dpcon_id,
+			   &dpcon_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpcon_opened = true;
@@ -572,23 +622,25 @@ static int destroy_dpcon_v9(uint32_t dpcon_id)
 		goto out;
 	}
 
-	error = dpcon_destroy(&restool.mc_io, 0, dpcon_handle);
+	error = dpcon_destroy(&ctx->mc_io, ctx->cmd_flags, dpcon_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpcon_opened = false;
-	printf("dpcon.%u is destroyed\n", dpcon_id);
+	print_destroyed_obj("dpcon", dpcon_id);
 
 out:
 	if (dpcon_opened) {
-		error2 = dpcon_close(&restool.mc_io, 0, dpcon_handle);
+		error2 = dpcon_close(&ctx->mc_io, ctx->cmd_flags, dpcon_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -597,42 +649,43 @@ out:
 	return error;
 }
 
-static int destroy_dpcon_v10(uint32_t dpcon_id)
+static int destroy_dpcon_v10(struct restool *ctx, uint32_t dpcon_id)
 {
 	uint16_t dprc_handle;
 	uint32_t dprc_id;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
-	dprc_id = restool.root_dprc_id;
-	error = get_parent_dprc_id(dpcon_id, "dpcon", &dprc_id);
+	dprc_handle = ctx->root_dprc_handle;
+	dprc_id = ctx->root_dprc_id;
+	error = get_parent_dprc_id(ctx, dpcon_id, "dpcon", &dprc_id);
 	if (error)
 		return error;
 
-	if (dprc_id != restool.root_dprc_id) {
-		error = open_dprc(dprc_id, &dprc_handle);
+	if (dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, dprc_id, &dprc_handle);
 		if (error)
 			return error;
 	}
 
-	error = dpcon_destroy_v10(&restool.mc_io, dprc_handle,
-				  0, dpcon_id);
+	error = dpcon_destroy_v10(&ctx->mc_io, dprc_handle,
+				  ctx->cmd_flags, dpcon_id);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
-	printf("dpcon.%u is destroyed\n", dpcon_id);
+	print_destroyed_obj("dpcon", dpcon_id);
 
 out:
-	if (dprc_id != restool.root_dprc_id)
-		error = dprc_close(&restool.mc_io, 0, dprc_handle);
+	if (dprc_id != ctx->root_dprc_id)
+		error = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 
 	return error;
 }
 
-static int destroy_dpcon(int mc_fw_version)
+static int destroy_dpcon(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -643,37 +696,37 @@ static int destroy_dpcon(int mc_fw_version)
 	int error;
 	uint32_t dpcon_id;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	if (in_use(restool.obj_name, "destroyed")) {
+	if (in_use(ctx->obj_name, "destroyed")) {
 		error = -EBUSY;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpcon", &dpcon_id);
+	error = parse_object_name(ctx->obj_name, "dpcon", &dpcon_id);
 	if (error < 0)
 		goto out;
 
-	if (!find_obj("dpcon", dpcon_id)) {
+	if (!find_obj(ctx, "dpcon", dpcon_id)) {
 		error = -EINVAL;
 		goto out;
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = destroy_dpcon_v9(dpcon_id);
+		error = destroy_dpcon_v9(ctx, dpcon_id);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = destroy_dpcon_v10(dpcon_id);
+		error = destroy_dpcon_v10(ctx, dpcon_id);
 	else
 		return -EINVAL;
 
@@ -681,14 +734,14 @@ out:
 	return error;
 }
 
-static int cmd_dpcon_destroy_v9(void)
+static int cmd_dpcon_destroy_v9(struct restool *ctx)
 {
-	return destroy_dpcon(MC_FW_VERSION_9);
+	return destroy_dpcon(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpcon_destroy_v10(void)
+static int cmd_dpcon_destroy_v10(struct restool *ctx)
 {
-	return destroy_dpcon(MC_FW_VERSION_10);
+	return destroy_dpcon(ctx, MC_FW_VERSION_10);
 }
 
 struct object_command dpcon_commands_v9[] = {
@@ -706,7 +759,8 @@ struct object_command dpcon_commands_v9[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpcon_destroy_options,
-	  .cmd_func = cmd_dpcon_destroy_v9 },
+	  .cmd_func = cmd_dpcon_destroy_v9,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -726,7 +780,8 @@ struct object_command dpcon_commands_v10[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpcon_destroy_options,
-	  .cmd_func = cmd_dpcon_destroy_v10 },
+	  .cmd_func = cmd_dpcon_destroy_v10,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -45,6 +45,7 @@
  */
 enum dpdbg_info_options {
 	INFO_OPT_HELP = 0,
+	INFO_OPT_FIELDS,
 };
 
 static struct option dpdbg_info_options[] = {
@@ -55,12 +56,19 @@ static struct option dpdbg_info_options[] = {
 		.val = 0,
 	},
 
+	[INFO_OPT_FIELDS] = {
+		.name = "fields",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
 	{ 0 },
 };
 
 C_ASSERT(ARRAY_SIZE(dpdbg_info_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-static int cmd_dpdbg_help(void)
+static int cmd_dpdbg_help(struct restool *ctx)
 {
 	static const char help_msg[] =
 		"\n"
@@ -71,62 +79,76 @@ static int cmd_dpdbg_help(void)
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
 
+	(void)ctx;
 	printf(help_msg);
 	return 0;
 }
 
-static int print_dpdbg_attr(uint32_t dpdbg_id,
+static int print_dpdbg_attr(struct restool *ctx, uint32_t dpdbg_id,
 			struct dprc_obj_desc *target_obj_desc)
 {
 	uint16_t dpdbg_handle;
-	int error;
+	int error = 0;
 	struct dpdbg_attr dpdbg_attr;
 	bool dpdbg_opened = false;
 
-	error = dpdbg_open(&restool.mc_io, 0, dpdbg_id, &dpdbg_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpdbg_opened = true;
-	if (0 == dpdbg_handle) {
-		DEBUG_PRINTF(
-			"dpdbg_open() returned invalid handle (auth 0) for dpdbg.%u\n",
-			dpdbg_id);
-		error = -ENOENT;
-		goto out;
-	}
+	/* the version is part of the attributes for this object */
+	if (INFO_FIELD(VERSION)) {
+		error = dpdbg_open(&ctx->mc_io, ctx->cmd_flags, dpdbg_id,
+				   &dpdbg_handle);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		dpdbg_opened = true;
+		if (0 == dpdbg_handle) {
+			DEBUG_PRINTF(
+				"dpdbg_open() returned invalid handle (auth 0) for dpdbg.%u\n",
+				dpdbg_id);
+			error = -ENOENT;
+			goto out;
+		}
 
-	memset(&dpdbg_attr, 0, sizeof(dpdbg_attr));
-	error = dpdbg_get_attributes(&restool.mc_io, 0, dpdbg_handle,
-				     &dpdbg_attr);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		memset(&dpdbg_attr, 0, sizeof(dpdbg_attr));
+		error = dpdbg_get_attributes(&ctx->mc_io, ctx->cmd_flags,
+					     dpdbg_handle,
+					     &dpdbg_attr);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		assert(dpdbg_id == (uint32_t)dpdbg_attr.id);
+
+		output_field("version", "dpdbg version",
+			     "%u.%u", dpdbg_attr.version.major,
+			     dpdbg_attr.version.minor);
 	}
-	assert(dpdbg_id == (uint32_t)dpdbg_attr.id);
 
-	printf("dpdbg version: %u.%u\n", dpdbg_attr.version.major,
-	       dpdbg_attr.version.minor);
-	printf("dpdbg id: %d\n", dpdbg_attr.id);
-	printf("plugged state: %splugged\n",
-		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	print_obj_label(target_obj_desc);
+	if (INFO_FIELD(ID))
+		output_int("id", "dpdbg id", dpdbg_id);
+	if (INFO_FIELD(STATE))
+		output_field("plugged_state", "plugged state", "%splugged",
+			     (target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ?
+			     "" : "un");
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 out:
 	if (dpdbg_opened) {
 		int error2;
 
-		error2 = dpdbg_close(&restool.mc_io, 0, dpdbg_handle);
+		error2 = dpdbg_close(&ctx->mc_io, ctx->cmd_flags, dpdbg_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -135,36 +157,34 @@ out:
 	return error;
 }
 
-static int print_dpdbg_info(uint32_t dpdbg_id)
+static int print_dpdbg_info(struct restool *ctx, uint32_t dpdbg_id)
 {
 	int error;
 	struct dprc_obj_desc target_obj_desc;
-	uint32_t target_parent_dprc_id;
-	bool found = false;
-
-	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0, dpdbg_id,
-				"dpdbg", &target_obj_desc,
-				&target_parent_dprc_id, &found);
+
+	error = find_info_obj_desc(ctx, dpdbg_id, "dpdbg", false,
+				   &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (strcmp(target_obj_desc.type, "dpdbg")) {
-		printf("dpdbg.%d does not exist\n", dpdbg_id);
-		return -EINVAL;
-	}
-
-	error = print_dpdbg_attr(dpdbg_id, &target_obj_desc);
+	error = print_dpdbg_attr(ctx, dpdbg_id, &target_obj_desc);
 out:
 	return error;
 }
 
-static int cmd_dpdbg_info(void)
+static int cmd_dpdbg_info(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
 		"Usage: restool dpdbg info <dpdbg-object>\n"
+		"                         [--fields=<field>[,<field>...]]\n"
+		"\n"
+		"OPTIONS:\n"
+		"--fields=<field>[,<field>...]\n"
+		"   Shows only the given fields and sends only the MC\n"
+		"   commands they need. <field> is one of: version, id,\n"
+		"   state, endpoint, link, mac, attr, stats, label.\n"
+		"   Requires MC firmware 10.x.\n"
 		"\n"
 		"EXAMPLE:\n"
 		"Display information about dpdbg.5:\n"
@@ -174,25 +194,33 @@ static int cmd_dpdbg_info(void)
 	uint32_t obj_id;
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_FIELDS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_FIELDS);
+		error = parse_info_fields(ctx, 
+				ctx->cmd_option_args[INFO_OPT_FIELDS]);
+		if (error < 0)
+			goto out;
+	}
+
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpdbg", &obj_id);
+	error = parse_object_name(ctx->obj_name, "dpdbg", &obj_id);
 	if (error < 0)
 		goto out;
 
-	error = print_dpdbg_info(obj_id);
+	error = print_dpdbg_info(ctx, obj_id);
 out:
 	return error;
 }
@@ -49,6 +49,7 @@
 enum dpdcei_info_options {
 	INFO_OPT_HELP = 0,
 	INFO_OPT_VERBOSE,
+	INFO_OPT_FIELDS,
 };
 
 static struct option dpdcei_info_options[] = {
@@ -66,6 +67,13 @@ static struct option dpdcei_info_options[] = {
 		.val = 0,
 	},
 
+	[INFO_OPT_FIELDS] = {
+		.name = "fields",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
 	{ 0 },
 };
 
@@ -142,7 +150,7 @@ static const struct flib_ops dpdcei_ops = {
 	.obj_get_irq_status = dpdcei_get_irq_status,
 };
 
-static int cmd_dpdcei_help(void)
+static int cmd_dpdcei_help(struct restool *ctx)
 {
 	static const char help_msg[] =
 		"\n"
@@ -155,19 +163,21 @@ static int cmd_dpdcei_help(void)
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
 
+	(void)ctx;
 	printf(help_msg);
 	return 0;
 }
 
 static void print_dpdcei_engine(enum dpdcei_engine engine)
 {
-	printf("DPDCEI engine: ");
 	switch (engine) {
 	case DPDCEI_ENGINE_COMPRESSION:
-		printf("DPDCEI_ENGINE_COMPRESSION\n");
+		output_field("engine", "DPDCEI engine",
+			     "DPDCEI_ENGINE_COMPRESSION");
 		break;
 	case DPDCEI_ENGINE_DECOMPRESSION:
-		printf("DPDCEI_ENGINE_DECOMPRESSION\n");
+		output_field("engine", "DPDCEI engine",
+			     "DPDCEI_ENGINE_DECOMPRESSION");
 		break;
 	default:
 		assert(false);
@@ -175,7 +185,7 @@ static void print_dpdcei_engine(enum dpdcei_engine engine)
 	}
 }
 
-static int print_dpdcei_attr_v9(uint32_t dpdcei_id,
+static int print_dpdcei_attr_v9(struct restool *ctx, uint32_t dpdcei_id,
 				struct dprc_obj_desc *target_obj_desc)
 {
 	uint16_t dpdcei_handle;
@@ -183,11 +193,13 @@ static int print_dpdcei_attr_v9(uint32_t dpdcei_id,
 	struct dpdcei_attr dpdcei_attr;
 	bool dpdcei_opened = false;
 
-	error = dpdcei_open(&restool.mc_io, 0, dpdcei_id, &dpdcei_handle);
+	error = dpdcei_open(&ctx->mc_io, ctx->cmd_flags, dpdcei_id,
+			    &dpdcei_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpdcei_opened = true;
@@ -200,23 +212,26 @@ static int print_dpdcei_attr_v9(uint32_t dpdcei_id,
 	}
 
 	memset(&dpdcei_attr, 0, sizeof(dpdcei_attr));
-	error = dpdcei_get_attributes(&restool.mc_io, 0, dpdcei_handle,
+	error = dpdcei_get_attributes(&ctx->mc_io, ctx->cmd_flags,
+				      dpdcei_handle,
 					&dpdcei_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(dpdcei_id == (uint32_t)dpdcei_attr.id);
 
-	printf("dpdcei version: %u.%u\n", dpdcei_attr.version.major,
-	       dpdcei_attr.version.minor);
-	printf("dpdcei id: %d\n", dpdcei_attr.id);
-	printf("plugged state: %splugged\n",
+	output_field("version", "dpdcei version",
+		     "%u.%u", dpdcei_attr.version.major,
+		     dpdcei_attr.version.minor);
+	output_int("id", "dpdcei id", dpdcei_attr.id);
+	output_field("plugged_state", "plugged state", "%splugged",
 		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
 	print_dpdcei_engine(dpdcei_attr.engine);
-	print_obj_label(target_obj_desc);
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -224,11 +239,13 @@ out:
 	if (dpdcei_opened) {
 		int error2;
 
-		error2 = dpdcei_close(&restool.mc_io, 0, dpdcei_handle);
+		error2 = dpdcei_close(&ctx->mc_io, ctx->cmd_flags,
+				      dpdcei_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -237,57 +254,71 @@ out:
 	return error;
 }
 
-static int print_dpdcei_attr_v10(uint32_t dpdcei_id,
+static int print_dpdcei_attr_v10(struct restool *ctx, uint32_t dpdcei_id,
 				 struct dprc_obj_desc *target_obj_desc)
 {
 	struct dpdcei_attr_v10 dpdcei_attr;
 	uint16_t obj_major, obj_minor;
 	bool dpdcei_opened = false;
 	uint16_t dpdcei_handle;
-	int error;
+	int error = 0;
 
-	error = dpdcei_open_v10(&restool.mc_io, 0, dpdcei_id, &dpdcei_handle);
-	if (error) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpdcei_opened = true;
-	if (!dpdcei_handle) {
-		DEBUG_PRINTF(
-			"dpdcei_open() returned invalid handle (auth 0) for dpdcei.%u\n",
-			dpdcei_id);
-		error = -ENOENT;
-		goto out;
-	}
+	if (INFO_FIELD(ATTR)) {
+		error = dpdcei_open_v10(&ctx->mc_io, ctx->cmd_flags, dpdcei_id,
+					&dpdcei_handle);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		dpdcei_opened = true;
+		if (!dpdcei_handle) {
+			DEBUG_PRINTF(
+				"dpdcei_open() returned invalid handle (auth 0) for dpdcei.%u\n",
+				dpdcei_id);
+			error = -ENOENT;
+			goto out;
+		}
 
-	memset(&dpdcei_attr, 0, sizeof(dpdcei_attr));
-	error = dpdcei_get_attributes_v10(&restool.mc_io, 0, dpdcei_handle,
-					  &dpdcei_attr);
-	if (error) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		memset(&dpdcei_attr, 0, sizeof(dpdcei_attr));
+		error = dpdcei_get_attributes_v10(&ctx->mc_io, ctx->cmd_flags,
+						  dpdcei_handle, &dpdcei_attr);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		assert(dpdcei_id == (uint32_t)dpdcei_attr.id);
 	}
-	assert(dpdcei_id == (uint32_t)dpdcei_attr.id);
 
-	error = dpdcei_get_api_version_v10(&restool.mc_io, 0,
-				       &obj_major, &obj_minor);
-	if (error) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+	if (INFO_FIELD(VERSION)) {
+		error = get_obj_api_version(ctx, "dpdcei",
+					    dpdcei_get_api_version_v10,
+					    &obj_major, &obj_minor);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		output_field("version", "dpdcei version",
+			     "%u.%u", obj_major, obj_minor);
 	}
 
-	printf("dpdcei version: %u.%u\n", obj_major, obj_minor);
-	printf("dpdcei id: %d\n", dpdcei_attr.id);
-	printf("plugged state: %splugged\n",
-		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	print_dpdcei_engine(dpdcei_attr.engine);
-	print_obj_label(target_obj_desc);
+	if (INFO_FIELD(ID))
+		output_int("id", "dpdcei id", dpdcei_id);
+	if (INFO_FIELD(STATE))
+		output_field("plugged_state", "plugged state", "%splugged",
+			     (target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ?
+			     "" : "un");
+	if (INFO_FIELD(ATTR))
+		print_dpdcei_engine(dpdcei_attr.engine);
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -295,11 +326,13 @@ out:
 	if (dpdcei_opened) {
 		int error2;
 
-		error2 = dpdcei_close_v10(&restool.mc_io, 0, dpdcei_handle);
+		error2 = dpdcei_close_v10(&ctx->mc_io, ctx->cmd_flags,
+					  dpdcei_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -308,51 +341,50 @@ out:
 	return error;
 }
 
-static int print_dpdcei_info(uint32_t dpdcei_id, int mc_fw_version)
+static int print_dpdcei_info(struct restool *ctx, uint32_t dpdcei_id,
+			     int mc_fw_version)
 {
 	int error;
 	struct dprc_obj_desc target_obj_desc;
-	uint32_t target_parent_dprc_id;
-	bool found = false;
-
-	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0, dpdcei_id,
-				"dpdcei", &target_obj_desc,
-				&target_parent_dprc_id, &found);
+
+	error = find_info_obj_desc(ctx, dpdcei_id, "dpdcei",
+				   ctx->cmd_option_mask &
+				   ONE_BIT_MASK(INFO_OPT_VERBOSE),
+				   &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (strcmp(target_obj_desc.type, "dpdcei")) {
-		printf("dpdcei.%d does not exist\n", dpdcei_id);
-		return -EINVAL;
-	}
-
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = print_dpdcei_attr_v9(dpdcei_id, &target_obj_desc);
+		error = print_dpdcei_attr_v9(ctx, dpdcei_id, &target_obj_desc);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = print_dpdcei_attr_v10(dpdcei_id, &target_obj_desc);
+		error = print_dpdcei_attr_v10(ctx, dpdcei_id, &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpdcei_ops);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
+		error = print_obj_verbose(ctx, &target_obj_desc, &dpdcei_ops);
 	}
 
 out:
 	return error;
 }
 
-static int info_dpdcei(int mc_fw_version)
+static int info_dpdcei(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
 		"Usage: restool dpdcei info <dpdcei-object> [--verbose]\n"
+		"                         [--fields=<field>[,<field>...]]\n"
 		"\n"
 		"OPTIONS:\n"
 		"--verbose\n"
 		"   Shows extended/verbose information about the object\n"
+		"--fields=<field>[,<field>...]\n"
+		"   Shows only the given fields and sends only the MC\n"
+		"   commands they need. <field> is one of: version, id,\n"
+		"   state, endpoint, link, mac, attr, stats, label.\n"
+		"   Requires MC firmware 10.x.\n"
 		"\n"
 		"EXAMPLE:\n"
 		"Display information about dpdcei.5:\n"
@@ -362,37 +394,45 @@ static int info_dpdcei(int mc_fw_version)
 	uint32_t obj_id;
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_FIELDS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_FIELDS);
+		error = parse_info_fields(ctx, 
+				ctx->cmd_option_args[INFO_OPT_FIELDS]);
+		if (error < 0)
+			goto out;
+	}
+
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpdcei", &obj_id);
+	error = parse_object_name(ctx->obj_name, "dpdcei", &obj_id);
 	if (error < 0)
 		goto out;
 
-	error = print_dpdcei_info(obj_id, mc_fw_version);
+	error = print_dpdcei_info(ctx, obj_id, mc_fw_version);
 out:
 	return error;
 }
 
-static int cmd_dpdcei_info_v9(void)
+static int cmd_dpdcei_info_v9(struct restool *ctx)
 {
-	return info_dpdcei(MC_FW_VERSION_9);
+	return info_dpdcei(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpdcei_info_v10(void)
+static int cmd_dpdcei_info_v10(struct restool *ctx)
 {
-	return info_dpdcei(MC_FW_VERSION_10);
+	return info_dpdcei(ctx, MC_FW_VERSION_10);
 }
 
 static int parse_dpdcei_engine(char *engine_str, enum dpdcei_engine *engine)
@@ -407,116 +447,124 @@ static int parse_dpdcei_engine(char *engine_str, enum dpdcei_engine *engine)
 		return 0;
 	}
 
-	printf("Invalid dpdcei engine input.\n");
+	output_notice("Invalid dpdcei engine input.\n");
 	return -EINVAL;
 }
 
-static int create_dpdcei_v9(struct dpdcei_cfg *dpdcei_cfg)
+static int create_dpdcei_v9(struct restool *ctx, struct dpdcei_cfg *dpdcei_cfg)
 {
 	struct dpdcei_attr dpdcei_attr;
 	uint16_t dpdcei_handle;
 	int error;
 
-	error = dpdcei_create(&restool.mc_io, 0, dpdcei_cfg, &dpdcei_handle);
+	error = dpdcei_create(&ctx->mc_io, ctx->cmd_flags, dpdcei_cfg,
+			      &dpdcei_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	memset(&dpdcei_attr, 0, sizeof(struct dpdcei_attr));
-	error = dpdcei_get_attributes(&restool.mc_io, 0, dpdcei_handle,
+	error = dpdcei_get_attributes(&ctx->mc_io, ctx->cmd_flags,
+				      dpdcei_handle,
 					&dpdcei_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
-	print_new_obj("dpdcei", dpdcei_attr.id, NULL);
+	print_new_obj(ctx, "dpdcei", dpdcei_attr.id, NULL);
 
-	error = dpdcei_close(&restool.mc_io, 0, dpdcei_handle);
+	error = dpdcei_close(&ctx->mc_io, ctx->cmd_flags, dpdcei_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	return 0;
 }
 
-static int create_dpdcei_v10(struct dpdcei_cfg_v10 *dpdcei_cfg)
+static int create_dpdcei_v10(struct restool *ctx,
+			     struct dpdcei_cfg_v10 *dpdcei_cfg)
 {
 	uint32_t dpdcei_id, dprc_id;
 	uint16_t dprc_handle;
 	bool dprc_opened;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
+	dprc_handle = ctx->root_dprc_handle;
 	dprc_opened = false;
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
 		error = parse_object_name(
-				restool.cmd_option_args[CREATE_OPT_PARENT_DPRC],
+				ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC],
 				"dprc", &dprc_id);
 		if (error)
 			return error;
 
-		if (restool.root_dprc_id != dprc_id) {
-			error = open_dprc(dprc_id, &dprc_handle);
+		if (ctx->root_dprc_id != dprc_id) {
+			error = open_dprc(ctx, dprc_id, &dprc_handle);
 			if (error)
 				return error;
 			dprc_opened = true;
 		}
 	}
 
-	error = dpdcei_create_v10(&restool.mc_io, dprc_handle, 0,
+	error = dpdcei_create_v10(&ctx->mc_io, dprc_handle, ctx->cmd_flags,
 				  dpdcei_cfg, &dpdcei_id);
 	if (error) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	if (dprc_opened) {
-		(void)dprc_close(&restool.mc_io, 0, dprc_handle);
-		print_new_obj("dpdcei", dpdcei_id,
-			      restool.cmd_option_args[CREATE_OPT_PARENT_DPRC]);
+		(void)dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
+		print_new_obj(ctx, "dpdcei", dpdcei_id,
+			      ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC]);
 	} else {
-		print_new_obj("dpdcei", dpdcei_id, NULL);
+		print_new_obj(ctx, "dpdcei", dpdcei_id, NULL);
 	}
 
 	return 0;
 }
 
-static int create_dpdcei(int mc_fw_version, const char *usage_msg)
+static int create_dpdcei(struct restool *ctx, int mc_fw_version,
+			 const char *usage_msg)
 {
 	struct dpdcei_cfg_v10 dpdcei_cfg_v10;
 	struct dpdcei_cfg dpdcei_cfg;
 	int error;
 	long val;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name != NULL) {
+	if (ctx->obj_name != NULL) {
 		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
-			     restool.obj_name);
+			     ctx->obj_name);
 		puts(usage_msg);
 		return -EINVAL;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_ENGINE)) {
-		restool.cmd_option_mask &=
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_ENGINE)) {
+		ctx->cmd_option_mask &=
 				~ONE_BIT_MASK(CREATE_OPT_ENGINE);
 		error = parse_dpdcei_engine(
-			restool.cmd_option_args[CREATE_OPT_ENGINE],
+			ctx->cmd_option_args[CREATE_OPT_ENGINE],
 			&dpdcei_cfg.engine);
 		dpdcei_cfg_v10.engine = dpdcei_cfg.engine;
 		if (error < 0) {
@@ -531,9 +579,9 @@ static int create_dpdcei(int mc_fw_version, const char *usage_msg)
 		return -EINVAL;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PRIORITY)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PRIORITY);
-		error = get_option_value(CREATE_OPT_PRIORITY, &val,
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PRIORITY)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PRIORITY);
+		error = get_option_value(ctx, CREATE_OPT_PRIORITY, &val,
 					 "Invalid value: priority option",
 					 1, 8);
 		if (error)
@@ -547,16 +595,16 @@ static int create_dpdcei(int mc_fw_version, const char *usage_msg)
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = create_dpdcei_v9(&dpdcei_cfg);
+		error = create_dpdcei_v9(ctx, &dpdcei_cfg);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = create_dpdcei_v10(&dpdcei_cfg_v10);
+		error = create_dpdcei_v10(ctx, &dpdcei_cfg_v10);
 	else
 		return -EINVAL;
 
 	return error;
 }
 
-static int cmd_dpdcei_create_v9(void)
+static int cmd_dpdcei_create_v9(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -571,10 +619,10 @@ static int cmd_dpdcei_create_v9(void)
 		"   Priority for DCE hardware processing (valid values 1-8)\n"
 		"\n";
 
-	return create_dpdcei(MC_FW_VERSION_9, usage_msg);
+	return create_dpdcei(ctx, MC_FW_VERSION_9, usage_msg);
 }
 
-static int cmd_dpdcei_create_v10(void)
+static int cmd_dpdcei_create_v10(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -595,20 +643,22 @@ static int cmd_dpdcei_create_v10(void)
 		"   If it is not specified, the new object will be created under the default dprc.\n"
 		"\n";
 
-	return create_dpdcei(MC_FW_VERSION_10, usage_msg);
+	return create_dpdcei(ctx, MC_FW_VERSION_10, usage_msg);
 }
 
-static int destroy_dpdcei_v9(uint32_t dpdcei_id)
+static int destroy_dpdcei_v9(struct restool *ctx, uint32_t dpdcei_id)
 {
 	bool dpdcei_opened = false;
 	uint16_t dpdcei_handle;
 	int error, error2;
 
-	error = dpdcei_open(&restool.mc_io, 0, dpdcei_id, &dpdcei_handle);
+	error = dpdcei_open(&ctx->mc_io, ctx->cmd_flags, dpdcei_id,
+			    &dpdcei_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpdcei_opened = true;
@@ -620,23 +670,26 @@ static int destroy_dpdcei_v9(uint32_t dpdcei_id)
 		goto out;
 	}
 
-	error = dpdcei_destroy(&restool.mc_io, 0, dpdcei_handle);
+	error = dpdcei_destroy(&ctx->mc_io, ctx->cmd_flags, dpdcei_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpdcei_opened = false;
-	printf("dpdcei.%u is destroyed\n", dpdcei_id);
+	print_destroyed_obj("dpdcei", dpdcei_id);
 
 out:
 	if (dpdcei_opened) {
-		error2 = dpdcei_close(&restool.mc_io, 0, dpdcei_handle);
+		error2 = dpdcei_close(&ctx->mc_io, ctx->cmd_flags,
+				      dpdcei_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -645,42 +698,43 @@ out:
 	return error;
 }
 
-static int destroy_dpdcei_v10(uint32_t dpdcei_id)
+static int destroy_dpdcei_v10(struct restool *ctx, uint32_t dpdcei_id)
 {
 	uint16_t dprc_handle;
 	uint32_t dprc_id;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
-	dprc_id = restool.root_dprc_id;
-	error = get_parent_dprc_id(dpdcei_id, "dpdcei", &dprc_id);
+	dprc_handle = ctx->root_dprc_handle;
+	dprc_id = ctx->root_dprc_id;
+	error = get_parent_dprc_id(ctx, dpdcei_id, "dpdcei", &dprc_id);
 	if (error)
 		return error;
 
-	if (dprc_id != restool.root_dprc_id) {
-		error = open_dprc(dprc_id, &dprc_handle);
+	if (dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, dprc_id, &dprc_handle);
 		if (error)
 			return error;
 	}
 
-	error = dpdcei_destroy_v10(&restool.mc_io, dprc_handle,
-				   0, dpdcei_id);
+	error = dpdcei_destroy_v10(&ctx->mc_io, dprc_handle,
+				   ctx->cmd_flags, dpdcei_id);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
-	printf("dpdcei.%u is destroyed\n", dpdcei_id);
+	print_destroyed_obj("dpdcei", dpdcei_id);
 
 out:
-	if (dprc_id != restool.root_dprc_id)
-		error = dprc_close(&restool.mc_io, 0, dprc_handle);
+	if (dprc_id != ctx->root_dprc_id)
+		error = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 
 	return error;
 }
 
-static int destroy_dpdcei(int mc_fw_version)
+static int destroy_dpdcei(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -691,37 +745,37 @@ static int destroy_dpdcei(int mc_fw_version)
 	int error;
 	uint32_t dpdcei_id;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	if (in_use(restool.obj_name, "destroyed")) {
+	if (in_use(ctx->obj_name, "destroyed")) {
 		error = -EBUSY;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpdcei", &dpdcei_id);
+	error = parse_object_name(ctx->obj_name, "dpdcei", &dpdcei_id);
 	if (error < 0)
 		goto out;
 
-	if (!find_obj("dpdcei", dpdcei_id)) {
+	if (!find_obj(ctx, "dpdcei", dpdcei_id)) {
 		error = -EINVAL;
 		goto out;
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = destroy_dpdcei_v9(dpdcei_id);
+		error = destroy_dpdcei_v9(ctx, dpdcei_id);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = destroy_dpdcei_v10(dpdcei_id);
+		error = destroy_dpdcei_v10(ctx, dpdcei_id);
 	else
 		return -EINVAL;
 
@@ -729,14 +783,14 @@ out:
 	return error;
 }
 
-static int cmd_dpdcei_destroy_v9(void)
+static int cmd_dpdcei_destroy_v9(struct restool *ctx)
 {
-	return destroy_dpdcei(MC_FW_VERSION_9);
+	return destroy_dpdcei(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpdcei_destroy_v10(void)
+static int cmd_dpdcei_destroy_v10(struct restool *ctx)
 {
-	return destroy_dpdcei(MC_FW_VERSION_10);
+	return destroy_dpdcei(ctx, MC_FW_VERSION_10);
 }
 
 struct object_command dpdcei_commands_v9[] = {
@@ -754,7 +808,8 @@ struct object_command dpdcei_commands_v9[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpdcei_destroy_options,
-	  .cmd_func = cmd_dpdcei_destroy_v9 },
+	  .cmd_func = cmd_dpdcei_destroy_v9,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -774,7 +829,8 @@ struct object_command dpdcei_commands_v10[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpdcei_destroy_options,
-	  .cmd_func = cmd_dpdcei_destroy_v10 },
+	  .cmd_func = cmd_dpdcei_destroy_v10,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -48,6 +48,7 @@
 enum dpdmai_info_options {
 	INFO_OPT_HELP = 0,
 	INFO_OPT_VERBOSE,
+	INFO_OPT_FIELDS,
 };
 
 static struct option dpdmai_info_options[] = {
@@ -65,6 +66,13 @@ static struct option dpdmai_info_options[] = {
 		.val = 0,
 	},
 
+	[INFO_OPT_FIELDS] = {
+		.name = "fields",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
 	{ 0 },
 };
 
@@ -141,7 +149,7 @@ static const struct flib_ops dpdmai_ops = {
 	.obj_get_irq_status = dpdmai_get_irq_status,
 };
 
-static int cmd_dpdmai_help(void)
+static int cmd_dpdmai_help(struct restool *ctx)
 {
 	static const char help_msg[] =
 		"\n"
@@ -154,11 +162,12 @@ static int cmd_dpdmai_help(void)
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
 
+	(void)ctx;
 	printf(help_msg);
 	return 0;
 }
 
-static int print_dpdmai_attr_v9(uint32_t dpdmai_id,
+static int print_dpdmai_attr_v9(struct restool *ctx, uint32_t dpdmai_id,
 				struct dprc_obj_desc *target_obj_desc)
 {
 	uint16_t dpdmai_handle;
@@ -166,11 +175,13 @@ static int print_dpdmai_attr_v9(uint32_t dpdmai_id,
 	struct dpdmai_attr dpdmai_attr;
 	bool dpdmai_opened = false;
 
-	error = dpdmai_open(&restool.mc_io, 0, dpdmai_id, &dpdmai_handle);
+	error = dpdmai_open(&ctx->mc_io, ctx->cmd_flags, dpdmai_id,
+			    &dpdmai_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpdmai_opened = true;
@@ -183,23 +194,27 @@ static int print_dpdmai_attr_v9(uint32_t dpdmai_id,
 	}
 
 	memset(&dpdmai_attr, 0, sizeof(dpdmai_attr));
-	error = dpdmai_get_attributes(&restool.mc_io, 0, dpdmai_handle,
+	error = dpdmai_get_attributes(&ctx->mc_io, ctx->cmd_flags,
+				      dpdmai_handle,
 					&dpdmai_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(dpdmai_id == (uint32_t)dpdmai_attr.id);
 
-	printf("dpdmai version: %u.%u\n", dpdmai_attr.version.major,
-	       dpdmai_attr.version.minor);
-	printf("dpdmai id: %d\n", dpdmai_attr.id);
-	printf("plugged state: %splugged\n",
+	output_field("version", "dpdmai version",
+		     "%u.%u", dpdmai_attr.version.major,
+		     dpdmai_attr.version.minor);
+	output_int("id", "dpdmai id", dpdmai_attr.id);
+	output_field("plugged_state", "plugged state", "%splugged",
 		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	printf("number of priorities: %u\n", dpdmai_attr.num_of_priorities);
-	print_obj_label(target_obj_desc);
+	output_uint("num_priorities", "number of priorities",
+		    dpdmai_attr.num_of_priorities);
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -207,11 +222,13 @@ out:
 	if (dpdmai_opened) {
 		int error2;
 
-		error2 = dpdmai_close(&restool.mc_io, 0, dpdmai_handle);
+		error2 = dpdmai_close(&ctx->mc_io, ctx->cmd_flags,
+				      dpdmai_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -220,58 +237,75 @@ out:
 	return error;
 }
 
-static int print_dpdmai_attr_v10(uint32_t dpdmai_id,
+static int print_dpdmai_attr_v10(struct restool *ctx, uint32_t dpdmai_id,
 				 struct dprc_obj_desc *target_obj_desc)
 {
 	struct dpdmai_attr_v10 dpdmai_attr;
 	uint16_t obj_major, obj_minor;
 	bool dpdmai_opened = false;
 	uint16_t dpdmai_handle;
-	int error;
+	int error = 0;
 
-	error = dpdmai_open_v10(&restool.mc_io, 0, dpdmai_id, &dpdmai_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpdmai_opened = true;
-	if (0 == dpdmai_handle) {
-		DEBUG_PRINTF(
-			"dpdmai_open() returned invalid handle (auth 0) for dpdmai.%u\n",
-			dpdmai_id);
-		error = -ENOENT;
-		goto out;
-	}
+	if (INFO_FIELD(ATTR)) {
+		error = dpdmai_open_v10(&ctx->mc_io, ctx->cmd_flags, dpdmai_id,
+					&dpdmai_handle);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		dpdmai_opened = true;
+		if (0 == dpdmai_handle) {
+			DEBUG_PRINTF(
+				"dpdmai_open() returned invalid handle (auth 0) for dpdmai.%u\n",
+				dpdmai_id);
+			error = -ENOENT;
+			goto out;
+		}
 
-	memset(&dpdmai_attr, 0, sizeof(dpdmai_attr));
-	error = dpdmai_get_attributes_v10(&restool.mc_io, 0, dpdmai_handle,
-					&dpdmai_attr);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		memset(&dpdmai_attr, 0, sizeof(dpdmai_attr));
+		error = dpdmai_get_attributes_v10(&ctx->mc_io, ctx->cmd_flags,
+						  dpdmai_handle, &dpdmai_attr);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		assert(dpdmai_id == (uint32_t)dpdmai_attr.id);
 	}
-	assert(dpdmai_id == (uint32_t)dpdmai_attr.id);
 
-	error = dpdmai_get_api_version_v10(&restool.mc_io, 0,
-				       &obj_major, &obj_minor);
-	if (error) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+	if (INFO_FIELD(VERSION)) {
+		error = get_obj_api_version(ctx, "dpdmai",
+					    dpdmai_get_api_version_v10,
+					    &obj_major, &obj_minor);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		output_field("version", "dpdmai version",
+			     "%u.%u", obj_major, obj_minor);
 	}
 
-	printf("dpdmai version: %u.%u\n", obj_major, obj_minor);
-	printf("dpdmai id: %d\n", dpdmai_attr.id);
-	printf("plugged state: %splugged\n",
-		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	printf("number of priorities: %u\n", dpdmai_attr.num_of_priorities);
-	printf("number of queues: %u\n", dpdmai_attr.num_of_queues);
-	print_obj_label(target_obj_desc);
+	if (INFO_FIELD(ID))
+		output_int("id", "dpdmai id", dpdmai_id);
+	if (INFO_FIELD(STATE))
+		output_field("plugged_state", "plugged state", "%splugged",
+			     (target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ?
+			     "" : "un");
+	if (INFO_FIELD(ATTR)) {
+		output_uint("num_priorities", "number of priorities",
+			    dpdmai_attr.num_of_priorities);
+		output_uint("num_queues", "number of queues",
+			    dpdmai_attr.num_of_queues);
+	}
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -279,11 +313,13 @@ out:
 	if (dpdmai_opened) {
 		int error2;
 
-		error2 = dpdmai_close_v10(&restool.mc_io, 0, dpdmai_handle);
+		error2 = dpdmai_close_v10(&ctx->mc_io, ctx->cmd_flags,
+					  dpdmai_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -292,51 +328,50 @@ out:
 	return error;
 }
 
-static int print_dpdmai_info(uint32_t dpdmai_id, int mc_fw_version)
+static int print_dpdmai_info(struct restool *ctx, uint32_t dpdmai_id,
+			     int mc_fw_version)
 {
 	int error;
 	struct dprc_obj_desc target_obj_desc;
-	uint32_t target_parent_dprc_id;
-	bool found = false;
-
-	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0, dpdmai_id,
-				"dpdmai", &target_obj_desc,
-				&target_parent_dprc_id, &found);
+
+	error = find_info_obj_desc(ctx, dpdmai_id, "dpdmai",
+				   ctx->cmd_option_mask &
+				   ONE_BIT_MASK(INFO_OPT_VERBOSE),
+				   &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (strcmp(target_obj_desc.type, "dpdmai")) {
-		printf("dpdmai.%d does not exist\n", dpdmai_id);
-		return -EINVAL;
-	}
-
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = print_dpdmai_attr_v9(dpdmai_id, &target_obj_desc);
+		error = print_dpdmai_attr_v9(ctx, dpdmai_id, &target_obj_desc);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = print_dpdmai_attr_v10(dpdmai_id, &target_obj_desc);
+		error = print_dpdmai_attr_v10(ctx, dpdmai_id, &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpdmai_ops);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
+		error = print_obj_verbose(ctx, &target_obj_desc, &dpdmai_ops);
 	}
 
 out:
 	return error;
 }
 
-static int info_dpdmai(int mc_fw_version)
+static int info_dpdmai(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
 		"Usage: restool dpdmai info <dpdmai-object> [--verbose]\n"
+		"                         [--fields=<field>[,<field>...]]\n"
 		"\n"
 		"OPTIONS:\n"
 		"--verbose\n"
 		"   Shows extended/verbose information about the object\n"
+		"--fields=<field>[,<field>...]\n"
+		"   Shows only the given fields and sends only the MC\n"
+		"   commands they need. <field> is one of: version, id,\n"
+		"   state, endpoint, link, mac, attr, stats, label.\n"
+		"   Requires MC firmware 10.x.\n"
 		"\n"
 		"EXAMPLE:\n"
 		"Display information about dpdmai.5:\n"
@@ -346,37 +381,45 @@ static int info_dpdmai(int mc_fw_version)
 	uint32_t obj_id;
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_FIELDS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_FIELDS);
+		error = parse_info_fields(ctx, 
+				ctx->cmd_option_args[INFO_OPT_FIELDS]);
+		if (error < 0)
+			goto out;
+	}
+
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpdmai", &obj_id);
+	error = parse_object_name(ctx->obj_name, "dpdmai", &obj_id);
 	if (error < 0)
 		goto out;
 
-	error = print_dpdmai_info(obj_id, mc_fw_version);
+	error = print_dpdmai_info(ctx, obj_id, mc_fw_version);
 out:
 	return error;
 }
 
-static int cmd_dpdmai_info_v9(void)
+static int cmd_dpdmai_info_v9(struct restool *ctx)
 {
-	return info_dpdmai(MC_FW_VERSION_9);
+	return info_dpdmai(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpdmai_info_v10(void)
+static int cmd_dpdmai_info_v10(struct restool *ctx)
 {
-	return info_dpdmai(MC_FW_VERSION_10);
+	return info_dpdmai(ctx, MC_FW_VERSION_10);
 }
 
 static int parse_dpdmai_priorities(char *priorities_str, uint8_t *priorities,
@@ -416,43 +459,49 @@ static int parse_dpdmai_priorities(char *priorities_str, uint8_t *priorities,
 	return 0;
 }
 
-static int create_dpdmai_v9(struct dpdmai_cfg *dpdmai_cfg)
+static int create_dpdmai_v9(struct restool *ctx, struct dpdmai_cfg *dpdmai_cfg)
 {
 	struct dpdmai_attr dpdmai_attr;
 	uint16_t dpdmai_handle;
 	int error;
 
-	error = dpdmai_create(&restool.mc_io, 0, dpdmai_cfg, &dpdmai_handle);
+	error = dpdmai_create(&ctx->mc_io, ctx->cmd_flags, dpdmai_cfg,
+			      &dpdmai_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	memset(&dpdmai_attr, 0, sizeof(struct dpdmai_attr));
-	error = dpdmai_get_attributes(&restool.mc_io, 0, dpdmai_handle,
+	error = dpdmai_get_attributes(&ctx->mc_io, ctx->cmd_flags,
+				      dpdmai_handle,
 					&dpdmai_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
-	print_new_obj("dpdmai", dpdmai_attr.id, NULL);
+	print_new_obj(ctx, "dpdmai", dpdmai_attr.id, NULL);
 
-	error = dpdmai_close(&restool.mc_io, 0, dpdmai_handle);
+	error = dpdmai_close(&ctx->mc_io, ctx->cmd_flags, dpdmai_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	return 0;
 }
 
-static int create_dpdmai_v10(struct dpdmai_cfg_v10 *dpdmai_cfg)
+static int create_dpdmai_v10(struct restool *ctx,
+			     struct dpdmai_cfg_v10 *dpdmai_cfg)
 {
 	uint32_t dpdmai_id, dprc_id;
 	uint16_t dprc_handle;
@@ -460,80 +509,82 @@ static int create_dpdmai_v10(struct dpdmai_cfg_v10 *dpdmai_cfg)
 	long value;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
+	dprc_handle = ctx->root_dprc_handle;
 	dprc_opened = false;
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
 		error = parse_object_name(
-				restool.cmd_option_args[CREATE_OPT_PARENT_DPRC],
+				ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC],
 				"dprc", &dprc_id);
 		if (error)
 			return error;
 
-		if (restool.root_dprc_id != dprc_id) {
-			error = open_dprc(dprc_id, &dprc_handle);
+		if (ctx->root_dprc_id != dprc_id) {
+			error = open_dprc(ctx, dprc_id, &dprc_handle);
 			if (error)
 				return error;
 			dprc_opened = true;
 		}
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_QUEUES)) {
-		restool.cmd_option_mask &=
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_QUEUES)) {
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_NUM_QUEUES);
 
-		error = get_option_value(CREATE_OPT_NUM_QUEUES, &value,
+		error = get_option_value(ctx, CREATE_OPT_NUM_QUEUES, &value,
 					 "Invalid num-queues value\n", 1, 16);
 		if (error)
 			return error;
 		dpdmai_cfg->num_queues = (uint8_t)value;
 	}
 
-	error = dpdmai_create_v10(&restool.mc_io, dprc_handle, 0,
+	error = dpdmai_create_v10(&ctx->mc_io, dprc_handle, ctx->cmd_flags,
 				  dpdmai_cfg, &dpdmai_id);
 	if (error) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	if (dprc_opened) {
-		(void)dprc_close(&restool.mc_io, 0, dprc_handle);
-		print_new_obj("dpdmai", dpdmai_id,
-			      restool.cmd_option_args[CREATE_OPT_PARENT_DPRC]);
+		(void)dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
+		print_new_obj(ctx, "dpdmai", dpdmai_id,
+			      ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC]);
 	} else {
-		print_new_obj("dpdmai", dpdmai_id, NULL);
+		print_new_obj(ctx, "dpdmai", dpdmai_id, NULL);
 	}
 
 	return 0;
 }
 
-static int create_dpdmai(int mc_fw_version, const char *usage_msg)
+static int create_dpdmai(struct restool *ctx, int mc_fw_version,
+			 const char *usage_msg)
 {
 	struct dpdmai_cfg dpdmai_cfg = { 0 };
 	struct dpdmai_cfg_v10 dpdmai_cfg_10 = { 0 };
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name != NULL) {
+	if (ctx->obj_name != NULL) {
 		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
-			     restool.obj_name);
+			     ctx->obj_name);
 		puts(usage_msg);
 		return -EINVAL;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PRIORITIES)) {
-		restool.cmd_option_mask &=
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PRIORITIES)) {
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_PRIORITIES);
 
 		error = parse_dpdmai_priorities(
-			restool.cmd_option_args[CREATE_OPT_PRIORITIES],
+			ctx->cmd_option_args[CREATE_OPT_PRIORITIES],
 			dpdmai_cfg.priorities, DPDMAI_PRIO_NUM);
 		if (error < 0) {
 			DEBUG_PRINTF(
@@ -551,16 +602,16 @@ static int create_dpdmai(int mc_fw_version, const char *usage_msg)
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = create_dpdmai_v9(&dpdmai_cfg);
+		error = create_dpdmai_v9(ctx, &dpdmai_cfg);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = create_dpdmai_v10(&dpdmai_cfg_10);
+		error = create_dpdmai_v10(ctx, &dpdmai_cfg_10);
 	else
 		return -EINVAL;
 
 	return error;
 }
 
-static int cmd_dpdmai_create_v9(void)
+static int cmd_dpdmai_create_v9(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -579,10 +630,10 @@ static int cmd_dpdmai_create_v9(void)
 		"   $ restool dpdmai create --priorities=2,4\n"
 		"\n";
 
-	return create_dpdmai(MC_FW_VERSION_9, usage_msg);
+	return create_dpdmai(ctx, MC_FW_VERSION_9, usage_msg);
 }
 
-static int cmd_dpdmai_create_v10(void)
+static int cmd_dpdmai_create_v10(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -606,20 +657,22 @@ static int cmd_dpdmai_create_v10(void)
 		"   $ restool dpdmai create --priorities=2,4\n"
 		"\n";
 
-	return create_dpdmai(MC_FW_VERSION_10, usage_msg);
+	return create_dpdmai(ctx, MC_FW_VERSION_10, usage_msg);
 }
 
-static int destroy_dpdmai_v9(uint32_t dpdmai_id)
+static int destroy_dpdmai_v9(struct restool *ctx, uint32_t dpdmai_id)
 {
 	bool dpdmai_opened = false;
 	uint16_t dpdmai_handle;
 	int error, error2;
 
-	error = dpdmai_open(&restool.mc_io, 0, dpdmai_id, &dpdmai_handle);
+	error = dpdmai_open(&ctx->mc_io, ctx->cmd_flags, dpdmai_id,
+			    &dpdmai_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpdmai_opened = true;
@@ -631,23 +684,26 @@ static int destroy_dpdmai_v9(uint32_t dpdmai_id)
 		goto out;
 	}
 
-	error = dpdmai_destroy(&restool.mc_io, 0, dpdmai_handle);
+	error = dpdmai_destroy(&ctx->mc_io, ctx->cmd_flags, dpdmai_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpdmai_opened = false;
-	printf("dpdmai.%u is destroyed\n", dpdmai_id);
+	print_destroyed_obj("dpdmai", dpdmai_id);
 
 out:
 	if (dpdmai_opened) {
-		error2 = dpdmai_close(&restool.mc_io, 0, dpdmai_handle);
+		error2 = dpdmai_close(&ctx->mc_io, ctx->cmd_flags,
+				      dpdmai_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -656,42 +712,43 @@ out:
 	return error;
 }
 
-static int destroy_dpdmai_v10(uint32_t dpdmai_id)
+static int destroy_dpdmai_v10(struct restool *ctx, uint32_t dpdmai_id)
 {
 	uint16_t dprc_handle;
 	uint32_t dprc_id;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
-	dprc_id = restool.root_dprc_id;
-	error = get_parent_dprc_id(dpdmai_id, "dpdmai", &dprc_id);
+	dprc_handle = ctx->root_dprc_handle;
+	dprc_id = ctx->root_dprc_id;
+	error = get_parent_dprc_id(ctx, dpdmai_id, "dpdmai", &dprc_id);
 	if (error)
 		return error;
 
-	if (dprc_id != restool.root_dprc_id) {
-		error = open_dprc(dprc_id, &dprc_handle);
+	if (dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, dprc_id, &dprc_handle);
 		if (error)
 			return error;
 	}
 
-	error = dpdmai_destroy_v10(&restool.mc_io, dprc_handle,
-				   0, dpdmai_id);
+	error = dpdmai_destroy_v10(&ctx->mc_io, dprc_handle,
+				   ctx->cmd_flags, dpdmai_id);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
-	printf("dpdmai.%u is destroyed\n", dpdmai_id);
+	print_destroyed_obj("dpdmai", dpdmai_id);
 
 out:
-	if (dprc_id != restool.root_dprc_id)
-		error = dprc_close(&restool.mc_io, 0, dprc_handle);
+	if (dprc_id != ctx->root_dprc_id)
+		error = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 
 	return error;
 }
 
-static int destroy_dpdmai(int mc_fw_version)
+static int destroy_dpdmai(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -702,37 +759,37 @@ static int destroy_dpdmai(int mc_fw_version)
 	int error;
 	uint32_t dpdmai_id;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	if (in_use(restool.obj_name, "destroyed")) {
+	if (in_use(ctx->obj_name, "destroyed")) {
 		error = -EBUSY;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpdmai", &dpdmai_id);
+	error = parse_object_name(ctx->obj_name, "dpdmai", &dpdmai_id);
 	if (error < 0)
 		goto out;
 
-	if (!find_obj("dpdmai", dpdmai_id)) {
+	if (!find_obj(ctx, "dpdmai", dpdmai_id)) {
 		error = -EINVAL;
 		goto out;
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = destroy_dpdmai_v9(dpdmai_id);
+		error = destroy_dpdmai_v9(ctx, dpdmai_id);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = destroy_dpdmai_v10(dpdmai_id);
+		error = destroy_dpdmai_v10(ctx, dpdmai_id);
 	else
 		return -EINVAL;
 
@@ -740,14 +797,14 @@ out:
 	return error;
 }
 
-static int cmd_dpdmai_destroy_v9(void)
+static int cmd_dpdmai_destroy_v9(struct restool *ctx)
 {
-	return destroy_dpdmai(MC_FW_VERSION_9);
+	return destroy_dpdmai(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpdmai_destroy_v10(void)
+static int cmd_dpdmai_destroy_v10(struct restool *ctx)
 {
-	return destroy_dpdmai(MC_FW_VERSION_10);
+	return destroy_dpdmai(ctx, MC_FW_VERSION_10);
 }
 
 struct object_command dpdmai_commands_v9[] = {
@@ -765,7 +822,8 @@ struct object_command dpdmai_commands_v9[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpdmai_destroy_options,
-	  .cmd_func = cmd_dpdmai_destroy_v9 },
+	  .cmd_func = cmd_dpdmai_destroy_v9,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -785,7 +843,8 @@ struct object_command dpdmai_commands_v10[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpdmai_destroy_options,
-	  .cmd_func = cmd_dpdmai_destroy_v10 },
+	  .cmd_func = cmd_dpdmai_destroy_v10,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -40,8 +40,10 @@
 #include <sys/ioctl.h>
 #include "restool.h"
 #include "utils.h"
+#include "dpkg_key.h"
 #include "mc_v9/fsl_dpdmux.h"
 #include "mc_v10/fsl_dpdmux.h"
+#include "mc_v10/fsl_dpni.h"
 
 #define ALL_DPDMUX_OPTS (		\
 	DPDMUX_OPT_BRIDGE_EN |		\
@@ -53,6 +55,7 @@
 enum dpdmux_info_options {
 	INFO_OPT_HELP = 0,
 	INFO_OPT_VERBOSE,
+	INFO_OPT_FIELDS,
 };
 
 static struct option dpdmux_info_options[] = {
@@ -70,6 +73,13 @@ static struct option dpdmux_info_options[] = {
 		.val = 0,
 	},
 
+	[INFO_OPT_FIELDS] = {
+		.name = "fields",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
 	{ 0 },
 };
 
@@ -247,6 +257,150 @@ static struct option dpdmux_destroy_options[] = {
 
 C_ASSERT(ARRAY_SIZE(dpdmux_destroy_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
+/**
+ * dpdmux if-add-l2-rule and if-remove-l2-rule command options
+ */
+enum dpdmux_l2_rule_options {
+	L2_RULE_OPT_HELP = 0,
+	L2_RULE_OPT_IF,
+	L2_RULE_OPT_RULE,
+};
+
+static struct option dpdmux_l2_rule_options[] = {
+	[L2_RULE_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[L2_RULE_OPT_IF] = {
+		.name = "if",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[L2_RULE_OPT_RULE] = {
+		.name = "rule",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpdmux_l2_rule_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpdmux set-custom-key command options
+ */
+enum dpdmux_custom_key_options {
+	CUSTOM_KEY_OPT_HELP = 0,
+	CUSTOM_KEY_OPT_KEY,
+};
+
+static struct option dpdmux_custom_key_options[] = {
+	[CUSTOM_KEY_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[CUSTOM_KEY_OPT_KEY] = {
+		.name = "key",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpdmux_custom_key_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpdmux add-custom-rule and remove-custom-rule command options
+ */
+enum dpdmux_custom_rule_options {
+	CUSTOM_RULE_OPT_HELP = 0,
+	CUSTOM_RULE_OPT_KEY,
+	CUSTOM_RULE_OPT_RULE,
+	CUSTOM_RULE_OPT_IF,
+};
+
+static struct option dpdmux_custom_rule_options[] = {
+	[CUSTOM_RULE_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[CUSTOM_RULE_OPT_KEY] = {
+		.name = "key",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[CUSTOM_RULE_OPT_RULE] = {
+		.name = "rule",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[CUSTOM_RULE_OPT_IF] = {
+		.name = "if",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpdmux_custom_rule_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpdmux load-rules command options
+ */
+enum dpdmux_load_rules_options {
+	LOAD_RULES_OPT_HELP = 0,
+	LOAD_RULES_OPT_FILE,
+	LOAD_RULES_OPT_KEY,
+};
+
+static struct option dpdmux_load_rules_options[] = {
+	[LOAD_RULES_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[LOAD_RULES_OPT_FILE] = {
+		.name = "file",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[LOAD_RULES_OPT_KEY] = {
+		.name = "key",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpdmux_load_rules_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
 static struct option_entry options_map[] = {
 	OPTION_MAP_ENTRY(DPDMUX_OPT_BRIDGE_EN),
 	OPTION_MAP_ENTRY(DPDMUX_OPT_CLS_MASK_SUPPORT),
@@ -260,7 +414,7 @@ static const struct flib_ops dpdmux_ops_v9 = {
 	.obj_get_irq_status = dpdmux_get_irq_status_v9,
 };
 
-static int cmd_dpdmux_help(void)
+static int cmd_dpdmux_help(struct restool *ctx)
 {
 	static const char help_msg[] =
 		"\n"
@@ -273,11 +427,37 @@ static int cmd_dpdmux_help(void)
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
 
+	(void)ctx;
 	printf(help_msg);
 	return 0;
 }
 
-static int print_dpdmux_endpoint(uint32_t target_id, uint16_t num_ifs)
+static int cmd_dpdmux_help_v10(struct restool *ctx)
+{
+	static const char help_msg[] =
+		"\n"
+		"Usage: restool dpdmux <command> [--help] [ARGS...]\n"
+		"Where <command> can be:\n"
+		"   info - displays detailed information about a DPDMUX object.\n"
+		"   create - creates a new child DPDMUX under the root DPRC.\n"
+		"   destroy - destroys a child DPDMUX under the root DPRC.\n"
+		"   if-add-l2-rule - forwards a MAC address and/or VLAN to an interface.\n"
+		"   if-remove-l2-rule - removes an L2 rule.\n"
+		"   set-custom-key - sets the key of the custom classification rules.\n"
+		"   add-custom-rule - adds a custom classification rule.\n"
+		"   remove-custom-rule - removes a custom classification rule.\n"
+		"   load-rules - adds the L2 or custom rules of a file.\n"
+		"\n"
+		"For command-specific help, use the --help option of each command.\n"
+		"\n";
+
+	(void)ctx;
+	printf(help_msg);
+	return 0;
+}
+
+static int print_dpdmux_endpoint(struct restool *ctx, uint32_t target_id,
+				 uint16_t num_ifs)
 {
 	struct dprc_endpoint endpoint1;
 	struct dprc_endpoint endpoint2;
@@ -285,7 +465,8 @@ static int print_dpdmux_endpoint(uint32_t target_id, uint16_t num_ifs)
 	int error = 0;
 	int k;
 
-	printf("endpoints:\n");
+	output_printf("endpoints:\n");
+	output_begin_array("endpoints");
 	for (k = 0; k < num_ifs; ++k) {
 		memset(&endpoint1, 0, sizeof(struct dprc_endpoint));
 		memset(&endpoint2, 0, sizeof(struct dprc_endpoint));
@@ -294,75 +475,93 @@ static int print_dpdmux_endpoint(uint32_t target_id, uint16_t num_ifs)
 		endpoint1.id = target_id;
 		endpoint1.if_id = k;
 
-		error = dprc_get_connection(&restool.mc_io, 0,
-					restool.root_dprc_handle,
+		error = dprc_get_connection(&ctx->mc_io, ctx->cmd_flags,
+					ctx->root_dprc_handle,
 					&endpoint1,
 					&endpoint2,
 					&state);
-		printf("interface %d:\n", k);
+		output_begin_object(NULL);
+		if (output_is_json())
+			output_int("interface", "interface", k);
+		else
+			output_printf("interface %d:\n", k);
 		if (error == 0 && state == -1) {
-			printf("\tconnection: none\n");
-			printf("\tlink state: n/a\n");
+			output_field("connection", "\tconnection", "none");
+			output_field("link_state", "\tlink state", "n/a");
 		} else if (error == 0) {
 			if (strcmp(endpoint2.type, "dpsw") == 0 ||
 			    strcmp(endpoint2.type, "dpdmux") == 0) {
-				printf("\tconnection: %s.%d.%d\n",
+				output_field("connection", "\tconnection",
+					     "%s.%d.%d",
 					endpoint2.type, endpoint2.id,
 					endpoint2.if_id);
 			} else if (endpoint2.if_id == 0) {
-				printf("\tconnection: %s.%d\n",
+				output_field("connection", "\tconnection",
+					     "%s.%d",
 					endpoint2.type, endpoint2.id);
 			}
 
 			if (state == 1)
-				printf("\tlink state: up\n");
+				output_field("link_state", "\tlink state",
+					     "up");
 			else if (state == 0)
-				printf("\tlink state: down\n");
+				output_field("link_state", "\tlink state",
+					     "down");
 			else
-				printf("\tlink state: error\n");
+				output_field("link_state", "\tlink state",
+					     "error");
 		} else {
-			mc_status = flib_error_to_mc_status(error);
+			ctx->mc_status = flib_error_to_mc_status(error);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				mc_status_to_string(mc_status), mc_status);
+				mc_status_to_string(ctx->mc_status),
+				ctx->mc_status);
 		}
-
+		output_end_object();
 	}
+	output_end_array();
 
 	return 0;
 }
 
 static void print_dpdmux_options(uint64_t options)
 {
+	output_begin_array("option_flags");
+
 	if ((options & ~ALL_DPDMUX_OPTS) != 0) {
-		printf("\tUnrecognized options found...\n");
+		output_item("Unrecognized options found...");
+		output_end_array();
 		return;
 	}
 
 	if (options & DPDMUX_OPT_BRIDGE_EN)
-		printf("\tDPDMUX_OPT_BRIDGE_EN\n");
+		output_item("DPDMUX_OPT_BRIDGE_EN");
 	if (options & DPDMUX_OPT_CLS_MASK_SUPPORT)
-		printf("\tDPDMUX_OPT_CLS_MASK_SUPPORT\n");
-
+		output_item("DPDMUX_OPT_CLS_MASK_SUPPORT");
+	output_end_array();
 }
 
 static void print_dpdmux_method(enum dpdmux_method method)
 {
-	printf("DPDMUX address table method: ");
 	switch (method) {
 	case DPDMUX_METHOD_NONE:
-		printf("DPDMUX_METHOD_NONE\n");
+		output_field("method", "DPDMUX address table method",
+			     "DPDMUX_METHOD_NONE");
 		break;
 	case DPDMUX_METHOD_C_VLAN_MAC:
-		printf("DPDMUX_METHOD_C_VLAN_MAC\n");
+		output_field("method", "DPDMUX address table method",
+			     "DPDMUX_METHOD_C_VLAN_MAC");
 		break;
 	case DPDMUX_METHOD_MAC:
-		printf("DPDMUX_METHOD_MAC\n");
+		output_field("method", "DPDMUX address table method",
+			     "DPDMUX_METHOD_MAC");
 		break;
 	case DPDMUX_METHOD_C_VLAN:
-		printf("DPDMUX_METHOD_C_VLAN\n");
+		output_field("method", "DPDMUX address table method",
+			     "DPDMUX_METHOD_C_VLAN");
 		break;
 	case DPDMUX_METHOD_CUSTOM:
-		printf("DPDMUX_METHOD_CUSTOM\n");
+		output_field("method", "DPDMUX address table method",
+			     "DPDMUX_METHOD_CUSTOM");
 		break;
 	default:
 		assert(false);
@@ -372,10 +571,10 @@ static void print_dpdmux_method(enum dpdmux_method method)
 
 static void print_dpdmux_manip(enum dpdmux_manip manip)
 {
-	printf("DPDMUX manipulation type: ");
 	switch (manip) {
 	case DPDMUX_MANIP_NONE:
-		printf("DPDMUX_MANIP_NONE\n");
+		output_field("manip", "DPDMUX manipulation type",
+			     "DPDMUX_MANIP_NONE");
 		break;
 	default:
 		assert(false);
@@ -383,7 +582,7 @@ static void print_dpdmux_manip(enum dpdmux_manip manip)
 	}
 }
 
-static int print_dpdmux_attr_v9(uint32_t dpdmux_id,
+static int print_dpdmux_attr_v9(struct restool *ctx, uint32_t dpdmux_id,
 				struct dprc_obj_desc *target_obj_desc)
 {
 	uint16_t dpdmux_handle;
@@ -391,11 +590,13 @@ static int print_dpdmux_attr_v9(uint32_t dpdmux_id,
 	struct dpdmux_attr_v9 dpdmux_attr;
 	bool dpdmux_opened = false;
 
-	error = dpdmux_open(&restool.mc_io, 0, dpdmux_id, &dpdmux_handle);
+	error = dpdmux_open(&ctx->mc_io, ctx->cmd_flags, dpdmux_id,
+			    &dpdmux_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpdmux_opened = true;
@@ -408,32 +609,36 @@ static int print_dpdmux_attr_v9(uint32_t dpdmux_id,
 	}
 
 	memset(&dpdmux_attr, 0, sizeof(dpdmux_attr));
-	error = dpdmux_get_attributes_v9(&restool.mc_io, 0, dpdmux_handle,
+	error = dpdmux_get_attributes_v9(&ctx->mc_io, ctx->cmd_flags,
+					 dpdmux_handle,
 					&dpdmux_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(dpdmux_id == (uint32_t)dpdmux_attr.id);
 
-	printf("dpdmux version: %u.%u\n", dpdmux_attr.version.major,
-	       dpdmux_attr.version.minor);
-	printf("dpdmux id: %d\n", dpdmux_attr.id);
-	printf("plugged state: %splugged\n",
+	output_field("version", "dpdmux version",
+		     "%u.%u", dpdmux_attr.version.major,
+		     dpdmux_attr.version.minor);
+	output_int("id", "dpdmux id", dpdmux_attr.id);
+	output_field("plugged_state", "plugged state", "%splugged",
 		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	print_dpdmux_endpoint(dpdmux_id, dpdmux_attr.num_ifs + 1);
-	printf("dpdmux_attr.options value is: %#llx\n",
-	       (unsigned long long)dpdmux_attr.options);
+	print_dpdmux_endpoint(ctx, dpdmux_id, dpdmux_attr.num_ifs + 1);
+	output_hex("options", "dpdmux_attr.options value is",
+		   (unsigned long long)dpdmux_attr.options);
 	print_dpdmux_options(dpdmux_attr.options);
 	print_dpdmux_method(dpdmux_attr.method);
 	print_dpdmux_manip(dpdmux_attr.manip);
-	printf("number of interfaces (excluding the uplink interface): %u\n",
-		(uint32_t)dpdmux_attr.num_ifs);
-	printf("frame storage memory size: %u\n",
+	output_uint("num_ifs",
+		    "number of interfaces (excluding the uplink interface)",
+		    (uint32_t)dpdmux_attr.num_ifs);
+	output_uint("mem_size", "frame storage memory size",
 		(uint32_t)dpdmux_attr.mem_size);
-	print_obj_label(target_obj_desc);
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -441,11 +646,13 @@ out:
 	if (dpdmux_opened) {
 		int error2;
 
-		error2 = dpdmux_close(&restool.mc_io, 0, dpdmux_handle);
+		error2 = dpdmux_close(&ctx->mc_io, ctx->cmd_flags,
+				      dpdmux_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -454,66 +661,84 @@ out:
 	return error;
 }
 
-static int print_dpdmux_attr_v10(uint32_t dpdmux_id,
+static int print_dpdmux_attr_v10(struct restool *ctx, uint32_t dpdmux_id,
 				 struct dprc_obj_desc *target_obj_desc)
 {
 	struct dpdmux_attr_v10 dpdmux_attr;
 	uint16_t obj_major, obj_minor;
 	bool dpdmux_opened = false;
 	uint16_t dpdmux_handle;
-	int error;
+	int error = 0;
 
-	error = dpdmux_open_v10(&restool.mc_io, 0, dpdmux_id, &dpdmux_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpdmux_opened = true;
-	if (0 == dpdmux_handle) {
-		DEBUG_PRINTF(
-			"dpdmux_open() returned invalid handle (auth 0) for dpdmux.%u\n",
-			dpdmux_id);
-		error = -ENOENT;
-		goto out;
-	}
+	/* the endpoint walk needs num_ifs from the attributes */
+	if (INFO_FIELD(ATTR) || INFO_FIELD(ENDPOINT) || INFO_FIELD(LINK)) {
+		error = dpdmux_open_v10(&ctx->mc_io, ctx->cmd_flags, dpdmux_id,
+					&dpdmux_handle);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		dpdmux_opened = true;
+		if (0 == dpdmux_handle) {
+			DEBUG_PRINTF(
+				"dpdmux_open() returned invalid handle (auth 0) for dpdmux.%u\n",
+				dpdmux_id);
+			error = -ENOENT;
+			goto out;
+		}
 
-	memset(&dpdmux_attr, 0, sizeof(dpdmux_attr));
-	error = dpdmux_get_attributes_v10(&restool.mc_io, 0, dpdmux_handle,
-					  &dpdmux_attr);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		memset(&dpdmux_attr, 0, sizeof(dpdmux_attr));
+		error = dpdmux_get_attributes_v10(&ctx->mc_io, ctx->cmd_flags,
+						  dpdmux_handle, &dpdmux_attr);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		assert(dpdmux_id == (uint32_t)dpdmux_attr.id);
 	}
-	assert(dpdmux_id == (uint32_t)dpdmux_attr.id);
 
-	error = dpdmux_get_api_version_v10(&restool.mc_io, 0,
-				       &obj_major, &obj_minor);
-	if (error) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+	if (INFO_FIELD(VERSION)) {
+		error = get_obj_api_version(ctx, "dpdmux",
+					    dpdmux_get_api_version_v10,
+					    &obj_major, &obj_minor);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		output_field("version", "dpdmux version",
+			     "%u.%u", obj_major, obj_minor);
 	}
 
-	printf("dpdmux version: %u.%u\n", obj_major, obj_minor);
-	printf("dpdmux id: %d\n", dpdmux_attr.id);
-	printf("plugged state: %splugged\n",
-		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	print_dpdmux_endpoint(dpdmux_id, dpdmux_attr.num_ifs + 1);
-	printf("dpdmux_attr.options value is: %#llx\n",
-	       (unsigned long long)dpdmux_attr.options);
-	print_dpdmux_options(dpdmux_attr.options);
-	print_dpdmux_method(dpdmux_attr.method);
-	print_dpdmux_manip(dpdmux_attr.manip);
-	printf("number of interfaces (excluding the uplink interface): %u\n",
-		(uint32_t)dpdmux_attr.num_ifs);
-	printf("frame storage memory size: %u\n",
-		(uint32_t)dpdmux_attr.mem_size);
-	print_obj_label(target_obj_desc);
+	if (INFO_FIELD(ID))
+		output_int("id", "dpdmux id", dpdmux_id);
+	if (INFO_FIELD(STATE))
+		output_field("plugged_state", "plugged state", "%splugged",
+			     (target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ?
+			     "" : "un");
+	if (INFO_FIELD(ENDPOINT) || INFO_FIELD(LINK))
+		print_dpdmux_endpoint(ctx, dpdmux_id, dpdmux_attr.num_ifs + 1);
+	if (INFO_FIELD(ATTR)) {
+		output_hex("options", "dpdmux_attr.options value is",
+			   (unsigned long long)dpdmux_attr.options);
+		print_dpdmux_options(dpdmux_attr.options);
+		print_dpdmux_method(dpdmux_attr.method);
+		print_dpdmux_manip(dpdmux_attr.manip);
+		output_uint("num_ifs",
+			    "number of interfaces (excluding the uplink interface)",
+			    (uint32_t)dpdmux_attr.num_ifs);
+		output_uint("mem_size", "frame storage memory size",
+			(uint32_t)dpdmux_attr.mem_size);
+	}
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -521,11 +746,13 @@ out:
 	if (dpdmux_opened) {
 		int error2;
 
-		error2 = dpdmux_close_v10(&restool.mc_io, 0, dpdmux_handle);
+		error2 = dpdmux_close_v10(&ctx->mc_io, ctx->cmd_flags,
+					  dpdmux_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -534,51 +761,51 @@ out:
 	return error;
 }
 
-static int print_dpdmux_info(uint32_t dpdmux_id, int mc_fw_version)
+static int print_dpdmux_info(struct restool *ctx, uint32_t dpdmux_id,
+			     int mc_fw_version)
 {
 	int error;
 	struct dprc_obj_desc target_obj_desc;
-	uint32_t target_parent_dprc_id;
-	bool found = false;
-
-	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0, dpdmux_id,
-				"dpdmux", &target_obj_desc,
-				&target_parent_dprc_id, &found);
+
+	error = find_info_obj_desc(ctx, dpdmux_id, "dpdmux",
+				   ctx->cmd_option_mask &
+				   ONE_BIT_MASK(INFO_OPT_VERBOSE),
+				   &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (strcmp(target_obj_desc.type, "dpdmux")) {
-		printf("dpdmux.%d does not exist\n", dpdmux_id);
-		return -EINVAL;
-	}
-
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = print_dpdmux_attr_v9(dpdmux_id, &target_obj_desc);
+		error = print_dpdmux_attr_v9(ctx, dpdmux_id, &target_obj_desc);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = print_dpdmux_attr_v10(dpdmux_id, &target_obj_desc);
+		error = print_dpdmux_attr_v10(ctx, dpdmux_id, &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpdmux_ops_v9);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
+		error = print_obj_verbose(ctx, &target_obj_desc,
+					  &dpdmux_ops_v9);
 	}
 
 out:
 	return error;
 }
 
-static int info_dpdmux(int mc_fw_version)
+static int info_dpdmux(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
 		"Usage: restool dpdmux info <dpdmux-object> [--verbose]\n"
+		"                         [--fields=<field>[,<field>...]]\n"
 		"\n"
 		"OPTIONS:\n"
 		"--verbose\n"
 		"   Shows extended/verbose information about the object\n"
+		"--fields=<field>[,<field>...]\n"
+		"   Shows only the given fields and sends only the MC\n"
+		"   commands they need. <field> is one of: version, id,\n"
+		"   state, endpoint, link, mac, attr, stats, label.\n"
+		"   Requires MC firmware 10.x.\n"
 		"\n"
 		"EXAMPLE:\n"
 		"Display information about dpdmux.5:\n"
@@ -588,38 +815,46 @@ static int info_dpdmux(int mc_fw_version)
 	uint32_t obj_id;
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_FIELDS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_FIELDS);
+		error = parse_info_fields(ctx, 
+				ctx->cmd_option_args[INFO_OPT_FIELDS]);
+		if (error < 0)
+			goto out;
+	}
+
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpdmux", &obj_id);
+	error = parse_object_name(ctx->obj_name, "dpdmux", &obj_id);
 	if (error < 0)
 		goto out;
 
-	error = print_dpdmux_info(obj_id, mc_fw_version);
+	error = print_dpdmux_info(ctx, obj_id, mc_fw_version);
 
 out:
 	return error;
 }
 
-static int cmd_dpdmux_info_v9(void)
+static int cmd_dpdmux_info_v9(struct restool *ctx)
 {
-	return info_dpdmux(MC_FW_VERSION_9);
+	return info_dpdmux(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpdmux_info_v10(void)
+static int cmd_dpdmux_info_v10(struct restool *ctx)
 {
-	return info_dpdmux(MC_FW_VERSION_10);
+	return info_dpdmux(ctx, MC_FW_VERSION_10);
 }
 
 static int parse_dpdmux_manip(char *manip_str, enum dpdmux_manip *manip)
@@ -631,7 +866,7 @@ static int parse_dpdmux_manip(char *manip_str, enum dpdmux_manip *manip)
 
 /* TODO: Enable DPDMUX_MANIP_ADD_REMOVE_S_VLAN when MC support added */
 
-	printf("Invalid dpdmux manip input.\n");
+	output_notice("Invalid dpdmux manip input.\n");
 	return -EINVAL;
 }
 
@@ -662,7 +897,7 @@ static int parse_dpdmux_method(char *method_str, enum dpdmux_method *method)
 		return 0;
 	}
 
-	printf("Invalid dpdmux method input.\n");
+	output_notice("Invalid dpdmux method input.\n");
 	return -EINVAL;
 }
 
@@ -670,7 +905,7 @@ static int parse_dpdmux_method(char *method_str, enum dpdmux_method *method)
  * Dpdmux create commands
  * Create commands for mc version 9
  */
-static int create_dpdmux_v9(const char *usage_msg)
+static int create_dpdmux_v9(struct restool *ctx, const char *usage_msg)
 {
 	int error;
 	struct dpdmux_cfg_v9 dpdmux_cfg = {0};
@@ -678,23 +913,23 @@ static int create_dpdmux_v9(const char *usage_msg)
 	long val;
 	struct dpdmux_attr_v9 dpdmux_attr;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP_V9)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP_V9)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP_V9);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP_V9);
 		return 0;
 	}
 
-	if (restool.obj_name != NULL) {
+	if (ctx->obj_name != NULL) {
 		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
-			     restool.obj_name);
+			     ctx->obj_name);
 		puts(usage_msg);
 		return -EINVAL;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_OPTIONS_V9)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_OPTIONS_V9);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_OPTIONS_V9)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_OPTIONS_V9);
 		error = parse_generic_create_options(
-				restool.cmd_option_args[CREATE_OPT_OPTIONS_V9],
+				ctx->cmd_option_args[CREATE_OPT_OPTIONS_V9],
 				&dpdmux_cfg.adv.options,
 				options_map,
 				options_num);
@@ -708,11 +943,11 @@ static int create_dpdmux_v9(const char *usage_msg)
 		dpdmux_cfg.adv.options = 0;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_METHOD_V9)) {
-		restool.cmd_option_mask &=
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_METHOD_V9)) {
+		ctx->cmd_option_mask &=
 				~ONE_BIT_MASK(CREATE_OPT_METHOD_V9);
 		error = parse_dpdmux_method(
-			restool.cmd_option_args[CREATE_OPT_METHOD_V9],
+			ctx->cmd_option_args[CREATE_OPT_METHOD_V9],
 			&dpdmux_cfg.method);
 		if (error < 0) {
 			DEBUG_PRINTF(
@@ -724,11 +959,11 @@ static int create_dpdmux_v9(const char *usage_msg)
 		dpdmux_cfg.method = DPDMUX_METHOD_C_VLAN_MAC;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MANIP_V9)) {
-		restool.cmd_option_mask &=
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MANIP_V9)) {
+		ctx->cmd_option_mask &=
 				~ONE_BIT_MASK(CREATE_OPT_MANIP_V9);
 		error = parse_dpdmux_manip(
-				restool.cmd_option_args[CREATE_OPT_MANIP_V9],
+				ctx->cmd_option_args[CREATE_OPT_MANIP_V9],
 				&dpdmux_cfg.manip);
 		if (error < 0) {
 			DEBUG_PRINTF(
@@ -740,9 +975,9 @@ static int create_dpdmux_v9(const char *usage_msg)
 		dpdmux_cfg.manip = DPDMUX_MANIP_NONE;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_IFS_V9)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_NUM_IFS_V9);
-		error = get_option_value(CREATE_OPT_NUM_IFS_V9, &val,
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_IFS_V9)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_NUM_IFS_V9);
+		error = get_option_value(ctx, CREATE_OPT_NUM_IFS_V9, &val,
 					 "Invalid number of interfaces",
 					 0, UINT16_MAX);
 		if (error)
@@ -754,11 +989,12 @@ static int create_dpdmux_v9(const char *usage_msg)
 		return -EINVAL;
 	}
 
-	if (restool.cmd_option_mask &
+	if (ctx->cmd_option_mask &
 	    ONE_BIT_MASK(CREATE_OPT_MAX_DMAT_ENTRIES_V9)) {
-		restool.cmd_option_mask &=
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_MAX_DMAT_ENTRIES_V9);
-		error = get_option_value(CREATE_OPT_MAX_DMAT_ENTRIES_V9, &val,
+		error = get_option_value(ctx, CREATE_OPT_MAX_DMAT_ENTRIES_V9,
+					 &val,
 					 "Invalid max DPDMUX address table",
 					 0, UINT16_MAX);
 		if (error)
@@ -768,11 +1004,11 @@ static int create_dpdmux_v9(const char *usage_msg)
 		dpdmux_cfg.adv.max_dmat_entries = 0;
 	}
 
-	if (restool.cmd_option_mask &
+	if (ctx->cmd_option_mask &
 	    ONE_BIT_MASK(CREATE_OPT_MAX_MC_GROUPS_V9)) {
-		restool.cmd_option_mask &=
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_MAX_MC_GROUPS_V9);
-		error = get_option_value(CREATE_OPT_MAX_MC_GROUPS_V9, &val,
+		error = get_option_value(ctx, CREATE_OPT_MAX_MC_GROUPS_V9, &val,
 					 "Invalid max multicast group",
 					 0, UINT16_MAX);
 		if (error)
@@ -782,37 +1018,41 @@ static int create_dpdmux_v9(const char *usage_msg)
 		dpdmux_cfg.adv.max_mc_groups = 0;
 	}
 
-	error = dpdmux_create_v9(&restool.mc_io, 0, &dpdmux_cfg,
+	error = dpdmux_create_v9(&ctx->mc_io, ctx->cmd_flags, &dpdmux_cfg,
 				 &dpdmux_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	memset(&dpdmux_attr, 0, sizeof(struct dpdmux_attr_v9));
-	error = dpdmux_get_attributes_v9(&restool.mc_io, 0, dpdmux_handle,
+	error = dpdmux_get_attributes_v9(&ctx->mc_io, ctx->cmd_flags,
+					 dpdmux_handle,
 					&dpdmux_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
-	print_new_obj("dpdmux", dpdmux_attr.id, NULL);
+	print_new_obj(ctx, "dpdmux", dpdmux_attr.id, NULL);
 
-	error = dpdmux_close(&restool.mc_io, 0, dpdmux_handle);
+	error = dpdmux_close(&ctx->mc_io, ctx->cmd_flags, dpdmux_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 	return 0;
 }
 
-static int cmd_dpdmux_create_v9(void)
+static int cmd_dpdmux_create_v9(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -844,10 +1084,10 @@ static int cmd_dpdmux_create_v9(void)
 		"   Number of multicast groups in DPDMUX address table. Default is 32 groups.\n"
 		"\n";
 
-	return create_dpdmux_v9(usage_msg);
+	return create_dpdmux_v9(ctx, usage_msg);
 }
 
-static int create_dpdmux_v10(const char *usage_msg)
+static int create_dpdmux_v10(struct restool *ctx, const char *usage_msg)
 {
 	struct dpdmux_cfg_v10 dpdmux_cfg = {0};
 	uint32_t dpdmux_id, dprc_id;
@@ -856,23 +1096,23 @@ static int create_dpdmux_v10(const char *usage_msg)
 	int error;
 	long val;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP_V9)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP_V9)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP_V9);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP_V9);
 		return 0;
 	}
 
-	if (restool.obj_name != NULL) {
+	if (ctx->obj_name != NULL) {
 		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
-			     restool.obj_name);
+			     ctx->obj_name);
 		puts(usage_msg);
 		return -EINVAL;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_OPTIONS_V9)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_OPTIONS_V9);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_OPTIONS_V9)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_OPTIONS_V9);
 		error = parse_generic_create_options(
-				restool.cmd_option_args[CREATE_OPT_OPTIONS_V9],
+				ctx->cmd_option_args[CREATE_OPT_OPTIONS_V9],
 				&dpdmux_cfg.adv.options,
 				options_map,
 				options_num);
@@ -886,11 +1126,11 @@ static int create_dpdmux_v10(const char *usage_msg)
 		dpdmux_cfg.adv.options = 0;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_METHOD_V9)) {
-		restool.cmd_option_mask &=
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_METHOD_V9)) {
+		ctx->cmd_option_mask &=
 				~ONE_BIT_MASK(CREATE_OPT_METHOD_V9);
 		error = parse_dpdmux_method(
-			restool.cmd_option_args[CREATE_OPT_METHOD_V9],
+			ctx->cmd_option_args[CREATE_OPT_METHOD_V9],
 			&dpdmux_cfg.method);
 		if (error < 0) {
 			DEBUG_PRINTF(
@@ -902,11 +1142,11 @@ static int create_dpdmux_v10(const char *usage_msg)
 		dpdmux_cfg.method = DPDMUX_METHOD_C_VLAN_MAC;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MANIP_V9)) {
-		restool.cmd_option_mask &=
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MANIP_V9)) {
+		ctx->cmd_option_mask &=
 				~ONE_BIT_MASK(CREATE_OPT_MANIP_V9);
 		error = parse_dpdmux_manip(
-				restool.cmd_option_args[CREATE_OPT_MANIP_V9],
+				ctx->cmd_option_args[CREATE_OPT_MANIP_V9],
 				&dpdmux_cfg.manip);
 		if (error < 0) {
 			DEBUG_PRINTF(
@@ -918,9 +1158,9 @@ static int create_dpdmux_v10(const char *usage_msg)
 		dpdmux_cfg.manip = DPDMUX_MANIP_NONE;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_IFS_V9)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_NUM_IFS_V9);
-		error = get_option_value(CREATE_OPT_NUM_IFS_V9, &val,
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_IFS_V9)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_NUM_IFS_V9);
+		error = get_option_value(ctx, CREATE_OPT_NUM_IFS_V9, &val,
 				     "Invalid number of interfaces\n",
 				     1, UINT16_MAX);
 		if (error)
@@ -932,11 +1172,12 @@ static int create_dpdmux_v10(const char *usage_msg)
 		return -EINVAL;
 	}
 
-	if (restool.cmd_option_mask &
+	if (ctx->cmd_option_mask &
 	    ONE_BIT_MASK(CREATE_OPT_MAX_DMAT_ENTRIES_V9)) {
-		restool.cmd_option_mask &=
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_MAX_DMAT_ENTRIES_V9);
-		error = get_option_value(CREATE_OPT_MAX_DMAT_ENTRIES_V9, &val,
+		error = get_option_value(ctx, CREATE_OPT_MAX_DMAT_ENTRIES_V9,
+					 &val,
 				     "Invalid max DPDMUX address table\n",
 				     1, UINT16_MAX);
 		if (error)
@@ -946,11 +1187,11 @@ static int create_dpdmux_v10(const char *usage_msg)
 		dpdmux_cfg.adv.max_dmat_entries = 0;
 	}
 
-	if (restool.cmd_option_mask &
+	if (ctx->cmd_option_mask &
 	    ONE_BIT_MASK(CREATE_OPT_MAX_MC_GROUPS_V9)) {
-		restool.cmd_option_mask &=
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_MAX_MC_GROUPS_V9);
-		error = get_option_value(CREATE_OPT_MAX_MC_GROUPS_V9, &val,
+		error = get_option_value(ctx, CREATE_OPT_MAX_MC_GROUPS_V9, &val,
 				     "Invalid max multicast group\n",
 				     1, UINT16_MAX);
 		if (error)
@@ -960,45 +1201,46 @@ static int create_dpdmux_v10(const char *usage_msg)
 		dpdmux_cfg.adv.max_mc_groups = 0;
 	}
 
-	dprc_handle = restool.root_dprc_handle;
+	dprc_handle = ctx->root_dprc_handle;
 	dprc_opened = false;
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
 		error = parse_object_name(
-				restool.cmd_option_args[CREATE_OPT_PARENT_DPRC],
+				ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC],
 				"dprc", &dprc_id);
 		if (error)
 			return error;
 
-		if (restool.root_dprc_id != dprc_id) {
-			error = open_dprc(dprc_id, &dprc_handle);
+		if (ctx->root_dprc_id != dprc_id) {
+			error = open_dprc(ctx, dprc_id, &dprc_handle);
 			if (error)
 				return error;
 			dprc_opened = true;
 		}
 	}
 
-	error = dpdmux_create_v10(&restool.mc_io, dprc_handle, 0,
+	error = dpdmux_create_v10(&ctx->mc_io, dprc_handle, ctx->cmd_flags,
 				  &dpdmux_cfg, &dpdmux_id);
 	if (error) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	if (dprc_opened) {
-		(void)dprc_close(&restool.mc_io, 0, dprc_handle);
-		print_new_obj("dpdmux", dpdmux_id,
-			      restool.cmd_option_args[CREATE_OPT_PARENT_DPRC]);
+		(void)dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
+		print_new_obj(ctx, "dpdmux", dpdmux_id,
+			      ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC]);
 	} else {
-		print_new_obj("dpdmux", dpdmux_id, NULL);
+		print_new_obj(ctx, "dpdmux", dpdmux_id, NULL);
 	}
 
 	return 0;
 }
 
-static int cmd_dpdmux_create_v10(void)
+static int cmd_dpdmux_create_v10(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -1035,20 +1277,22 @@ static int cmd_dpdmux_create_v10(void)
 		"   If it is not specified, the new object will be created under the default dprc.\n"
 		"\n";
 
-	return create_dpdmux_v10(usage_msg);
+	return create_dpdmux_v10(ctx, usage_msg);
 }
 
-static int destroy_dpdmux_v9(uint32_t dpdmux_id)
+static int destroy_dpdmux_v9(struct restool *ctx, uint32_t dpdmux_id)
 {
 	bool dpdmux_opened = false;
 	uint16_t dpdmux_handle;
 	int error, error2;
 
-	error = dpdmux_open(&restool.mc_io, 0, dpdmux_id, &dpdmux_handle);
+	error = dpdmux_open(&ctx->mc_io, ctx->cmd_flags, dpdmux_id,
+			    &dpdmux_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpdmux_opened = true;
@@ -1060,23 +1304,26 @@ static int destroy_dpdmux_v9(uint32_t dpdmux_id)
 		goto out;
 	}
 
-	error = dpdmux_destroy(&restool.mc_io, 0, dpdmux_handle);
+	error = dpdmux_destroy(&ctx->mc_io, ctx->cmd_flags, dpdmux_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpdmux_opened = false;
-	printf("dpdmux.%u is destroyed\n", dpdmux_id);
+	print_destroyed_obj("dpdmux", dpdmux_id);
 
 out:
 	if (dpdmux_opened) {
-		error2 = dpdmux_close(&restool.mc_io, 0, dpdmux_handle);
+		error2 = dpdmux_close(&ctx->mc_io, ctx->cmd_flags,
+				      dpdmux_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -1085,42 +1332,43 @@ out:
 	return error;
 }
 
-static int destroy_dpdmux_v10(uint32_t dpdmux_id)
+static int destroy_dpdmux_v10(struct restool *ctx, uint32_t dpdmux_id)
 {
 	uint16_t dprc_handle;
 	uint32_t dprc_id;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
-	dprc_id = restool.root_dprc_id;
-	error = get_parent_dprc_id(dpdmux_id, "dpdmux", &dprc_id);
+	dprc_handle = ctx->root_dprc_handle;
+	dprc_id = ctx->root_dprc_id;
+	error = get_parent_dprc_id(ctx, dpdmux_id, "dpdmux", &dprc_id);
 	if (error)
 		return error;
 
-	if (dprc_id != restool.root_dprc_id) {
-		error = open_dprc(dprc_id, &dprc_handle);
+	if (dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, dprc_id, &dprc_handle);
 		if (error)
 			return error;
 	}
 
-	error = dpdmux_destroy_v10(&restool.mc_io, dprc_handle,
-				   0, dpdmux_id);
+	error = dpdmux_destroy_v10(&ctx->mc_io, dprc_handle,
+				   ctx->cmd_flags, dpdmux_id);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
-	printf("dpdmux.%u is destroyed\n", dpdmux_id);
+	print_destroyed_obj("dpdmux", dpdmux_id);
 
 out:
-	if (dprc_id != restool.root_dprc_id)
-		error = dprc_close(&restool.mc_io, 0, dprc_handle);
+	if (dprc_id != ctx->root_dprc_id)
+		error = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 
 	return error;
 }
 
-static int destroy_dpdmux(int mc_fw_version)
+static int destroy_dpdmux(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -1131,52 +1379,725 @@ static int destroy_dpdmux(int mc_fw_version)
 	int error;
 	uint32_t dpdmux_id;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	if (in_use(restool.obj_name, "destroyed")) {
+	if (in_use(ctx->obj_name, "destroyed")) {
 		error = -EBUSY;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpdmux", &dpdmux_id);
+	error = parse_object_name(ctx->obj_name, "dpdmux", &dpdmux_id);
 	if (error < 0)
 		goto out;
 
-	if (!find_obj("dpdmux", dpdmux_id)) {
+	if (!find_obj(ctx, "dpdmux", dpdmux_id)) {
 		error = -EINVAL;
 		goto out;
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = destroy_dpdmux_v9(dpdmux_id);
+		error = destroy_dpdmux_v9(ctx, dpdmux_id);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = destroy_dpdmux_v10(dpdmux_id);
+		error = destroy_dpdmux_v10(ctx, dpdmux_id);
+	else
+		return -EINVAL;
+
+out:
+	return error;
+}
+
+static int cmd_dpdmux_destroy_v9(struct restool *ctx)
+{
+	return destroy_dpdmux(ctx, MC_FW_VERSION_9);
+}
+
+static int cmd_dpdmux_destroy_v10(struct restool *ctx)
+{
+	return destroy_dpdmux(ctx, MC_FW_VERSION_10);
+}
+
+/**
+ * State shared by the rule commands: the open DPDMUX, its attributes, the
+ * key the rules are written for and, for custom rules, the memory the MC
+ * reads a rule from (key bytes first, mask bytes DPKG_MAX_KEY_SIZE
+ * further).
+ */
+struct dpdmux_rules {
+	uint16_t dpdmux_handle;
+	struct dpdmux_attr_v10 attr;
+	bool custom;
+	struct dpkg_key key;
+	struct mc_dma_mem rule_mem;
+	struct dpdmux_rule_cfg_v10 rule_cfg;
+};
+
+/* L2 rules are written with the same syntax, against a fixed key */
+#define DPDMUX_L2_RULE_KEY	"ethdst,vlan"
+
+/* custom_key is NULL for L2 rules */
+static int dpdmux_rules_open(struct restool *ctx, const char *usage_msg,
+			     const char *custom_key, struct dpdmux_rules *r)
+{
+	uint32_t dpdmux_id;
+	int error;
+
+	memset(r, 0, sizeof(*r));
+	if (ctx->obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = parse_object_name(ctx->obj_name, "dpdmux", &dpdmux_id);
+	if (error)
+		return error;
+
+	r->custom = custom_key != NULL;
+	error = dpkg_key_parse(r->custom ? custom_key : DPDMUX_L2_RULE_KEY,
+			       &r->key);
+	if (error)
+		return error;
+
+	if (r->custom) {
+		error = mc_dma_alloc(&ctx->mc_io, 2 * DPKG_MAX_KEY_SIZE,
+				     &r->rule_mem);
+		if (error)
+			return error;
+
+		r->rule_cfg.key_iova = r->rule_mem.iova;
+		r->rule_cfg.mask_iova = r->rule_mem.iova + DPKG_MAX_KEY_SIZE;
+		r->rule_cfg.key_size = r->key.size;
+	}
+
+	error = dpdmux_open_v10(&ctx->mc_io, ctx->cmd_flags, dpdmux_id,
+				&r->dpdmux_handle);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		goto err_free;
+	}
+
+	error = dpdmux_get_attributes_v10(&ctx->mc_io, ctx->cmd_flags,
+					  r->dpdmux_handle, &r->attr);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		goto err_close;
+	}
+
+	return 0;
+
+err_close:
+	(void)dpdmux_close_v10(&ctx->mc_io, ctx->cmd_flags, r->dpdmux_handle);
+err_free:
+	mc_dma_free(&ctx->mc_io, &r->rule_mem);
+	return error;
+}
+
+static void dpdmux_rules_close(struct restool *ctx, struct dpdmux_rules *r)
+{
+	(void)dpdmux_close_v10(&ctx->mc_io, ctx->cmd_flags, r->dpdmux_handle);
+	mc_dma_free(&ctx->mc_io, &r->rule_mem);
+}
+
+static int parse_dpdmux_if(const char *str, const struct dpdmux_attr_v10 *attr,
+			   uint16_t *if_id)
+{
+	char *endptr;
+	long val;
+
+	errno = 0;
+	val = strtol(str, &endptr, 0);
+	if (STRTOL_ERROR(str, endptr, val, errno) ||
+	    val < 1 || val > attr->num_ifs) {
+		ERROR_PRINTF("Invalid interface %s, expected 1 to %u\n",
+			     str, (uint32_t)attr->num_ifs);
+		return -EINVAL;
+	}
+
+	*if_id = (uint16_t)val;
+	return 0;
+}
+
+/* L2 rules match whole fields: each one is either given or left out */
+static int dpdmux_prepare_l2_rule(struct dpdmux_rules *r, const char *rule_str,
+				  struct dpdmux_l2_rule_v10 *rule)
+{
+	uint8_t key_buf[DPKG_MAX_KEY_SIZE];
+	uint8_t mask_buf[DPKG_MAX_KEY_SIZE];
+	unsigned int i, offset = 0;
+	bool any = false;
+	int error;
+
+	error = dpkg_key_parse_rule(&r->key, rule_str, key_buf, mask_buf);
+	if (error)
+		return error;
+
+	for (i = 0; i < r->key.num_fields; i++) {
+		uint8_t size = r->key.fields[i]->size;
+		unsigned int full = 0, j;
+
+		for (j = 0; j < size; j++)
+			full += mask_buf[offset + j] == 0xff;
+		if (full != 0 && full != size) {
+			ERROR_PRINTF("L2 rules take no %s mask\n",
+				     r->key.fields[i]->name);
+			return -EINVAL;
+		}
+
+		any |= full != 0;
+		offset += size;
+	}
+
+	if (!any) {
+		ERROR_PRINTF("an L2 rule matches ethdst, vlan or both\n");
+		return -EINVAL;
+	}
+
+	memcpy(rule->mac_addr, key_buf, 6);
+	rule->vlan_id = (uint16_t)(key_buf[6] << 8 | key_buf[7]);
+	if (rule->vlan_id > 4095) {
+		ERROR_PRINTF("Invalid VLAN ID %u, expected 0 to 4095\n",
+			     (uint32_t)rule->vlan_id);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* parses a custom rule into rule_mem */
+static int dpdmux_prepare_custom_rule(struct dpdmux_rules *r,
+				      const char *rule_str)
+{
+	uint8_t *key_buf = r->rule_mem.vaddr;
+	uint8_t *mask_buf = key_buf + DPKG_MAX_KEY_SIZE;
+	int error;
+
+	error = dpkg_key_parse_rule(&r->key, rule_str, key_buf, mask_buf);
+	if (error)
+		return error;
+
+	if (r->attr.options & DPDMUX_OPT_CLS_MASK_SUPPORT)
+		return 0;
+
+	for (unsigned int i = 0; i < r->key.size; i++) {
+		if (mask_buf[i] != 0xff) {
+			ERROR_PRINTF("the classification table is exact match (no DPDMUX_OPT_CLS_MASK_SUPPORT), every key field needs a full value\n");
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+static int dpdmux_set_custom_key(struct restool *ctx, struct dpdmux_rules *r)
+{
+	struct dpkg_profile_cfg key_cfg;
+	struct mc_dma_mem key_mem;
+	int error;
+
+	dpkg_key_to_profile(&r->key, &key_cfg);
+	error = mc_dma_alloc(&ctx->mc_io, DPNI_KEY_CFG_SIZE, &key_mem);
+	if (error)
+		return error;
+
+	/* the DPDMUX takes a key profile laid out like the DPNI one */
+	error = dpni_prepare_key_cfg_v10(&key_cfg, key_mem.vaddr);
+	if (error)
+		goto out;
+
+	error = dpdmux_set_custom_key_v10(&ctx->mc_io, ctx->cmd_flags,
+					  r->dpdmux_handle, key_mem.iova);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+	}
+out:
+	mc_dma_free(&ctx->mc_io, &key_mem);
+	return error;
+}
+
+static int l2_rule_dpdmux(struct restool *ctx, const char *usage_msg,
+			  bool add)
+{
+	struct dpdmux_l2_rule_v10 rule;
+	struct dpdmux_rules r;
+	uint16_t if_id;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(L2_RULE_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(L2_RULE_OPT_HELP);
+		return 0;
+	}
+
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(L2_RULE_OPT_IF))) {
+		ERROR_PRINTF("--if option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(L2_RULE_OPT_RULE))) {
+		ERROR_PRINTF("--rule option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = dpdmux_rules_open(ctx, usage_msg, NULL, &r);
+	if (error)
+		return error;
+
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(L2_RULE_OPT_IF);
+	error = parse_dpdmux_if(ctx->cmd_option_args[L2_RULE_OPT_IF],
+				&r.attr, &if_id);
+	if (error)
+		goto out;
+
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(L2_RULE_OPT_RULE);
+	memset(&rule, 0, sizeof(rule));
+	error = dpdmux_prepare_l2_rule(&r, ctx->cmd_option_args[L2_RULE_OPT_RULE],
+				       &rule);
+	if (error)
+		goto out;
+
+	if (add)
+		error = dpdmux_if_add_l2_rule_v10(&ctx->mc_io, ctx->cmd_flags,
+						  r.dpdmux_handle, if_id,
+						  &rule);
 	else
+		error = dpdmux_if_remove_l2_rule_v10(&ctx->mc_io,
+						     ctx->cmd_flags,
+						     r.dpdmux_handle, if_id,
+						     &rule);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+	}
+out:
+	dpdmux_rules_close(ctx, &r);
+	return error;
+}
+
+static int cmd_dpdmux_if_add_l2_rule(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpdmux if-add-l2-rule <dpdmux-object> \\\n"
+		"\t\t--if=<number> --rule=<rule>\n"
+		"   e.g. restool dpdmux if-add-l2-rule dpdmux.0 --if=2 \\\n"
+		"\t\t--rule=ethdst=00:00:00:00:00:02,vlan=100\n"
+		"\n"
+		"Forwards the frames of a destination MAC address and/or C-VLAN\n"
+		"to a downlink interface, as the DPDMUX method selects. A\n"
+		"multicast address already in the table gets one more\n"
+		"interface.\n"
+		"\n"
+		"--if=<number>\n"
+		"   Downlink interface, 1 to the number of interfaces.\n"
+		"--rule=[ethdst=<mac-addr>][,vlan=<vlan-id>]\n"
+		"   Destination MAC address and VLAN ID to match.\n"
+		"\n";
+
+	return l2_rule_dpdmux(ctx, usage_msg, true);
+}
+
+static int cmd_dpdmux_if_remove_l2_rule(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpdmux if-remove-l2-rule <dpdmux-object> \\\n"
+		"\t\t--if=<number> --rule=<rule>\n"
+		"\n"
+		"Removes an L2 rule added with if-add-l2-rule, given with the\n"
+		"same interface and rule.\n"
+		"\n";
+
+	return l2_rule_dpdmux(ctx, usage_msg, false);
+}
+
+static int set_custom_key_dpdmux(struct restool *ctx, const char *usage_msg)
+{
+	struct dpdmux_rules r;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CUSTOM_KEY_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CUSTOM_KEY_OPT_HELP);
+		return 0;
+	}
+
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(CUSTOM_KEY_OPT_KEY))) {
+		ERROR_PRINTF("--key option missing\n");
+		puts(usage_msg);
 		return -EINVAL;
+	}
 
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(CUSTOM_KEY_OPT_KEY);
+	error = dpdmux_rules_open(ctx, usage_msg,
+				  ctx->cmd_option_args[CUSTOM_KEY_OPT_KEY],
+				  &r);
+	if (error)
+		return error;
+
+	error = dpdmux_set_custom_key(ctx, &r);
+	dpdmux_rules_close(ctx, &r);
+	return error;
+}
+
+static int cmd_dpdmux_set_custom_key(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpdmux set-custom-key <dpdmux-object> \\\n"
+		"\t\t--key=<field>[,<field>...]\n"
+		"   e.g. restool dpdmux set-custom-key dpdmux.0 \\\n"
+		"\t\t--key=ipdst,l4dport\n"
+		"\n"
+		"Sets the header fields the custom classification rules of a\n"
+		"DPDMUX created with DPDMUX_METHOD_CUSTOM match on. <field> is\n"
+		"one of: ethdst, ethsrc, ethtype, vlan, ipsrc, ipdst, ipproto,\n"
+		"l4sport, l4dport.\n"
+		"\n";
+
+	return set_custom_key_dpdmux(ctx, usage_msg);
+}
+
+static int custom_rule_dpdmux(struct restool *ctx, const char *usage_msg,
+			      bool add)
+{
+	struct dpdmux_cls_action_v10 action;
+	struct dpdmux_rules r;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CUSTOM_RULE_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CUSTOM_RULE_OPT_HELP);
+		return 0;
+	}
+
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(CUSTOM_RULE_OPT_KEY))) {
+		ERROR_PRINTF("--key option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(CUSTOM_RULE_OPT_RULE))) {
+		ERROR_PRINTF("--rule option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	if (add && !(ctx->cmd_option_mask & ONE_BIT_MASK(CUSTOM_RULE_OPT_IF))) {
+		ERROR_PRINTF("--if option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(CUSTOM_RULE_OPT_KEY);
+	error = dpdmux_rules_open(ctx, usage_msg,
+				  ctx->cmd_option_args[CUSTOM_RULE_OPT_KEY],
+				  &r);
+	if (error)
+		return error;
+
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(CUSTOM_RULE_OPT_RULE);
+	error = dpdmux_prepare_custom_rule(&r,
+			ctx->cmd_option_args[CUSTOM_RULE_OPT_RULE]);
+	if (error)
+		goto out;
+
+	if (add) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CUSTOM_RULE_OPT_IF);
+		error = parse_dpdmux_if(ctx->cmd_option_args[CUSTOM_RULE_OPT_IF],
+					&r.attr, &action.dest_if);
+		if (error)
+			goto out;
+
+		error = dpdmux_add_custom_cls_entry_v10(&ctx->mc_io,
+							ctx->cmd_flags,
+							r.dpdmux_handle,
+							&r.rule_cfg, &action);
+	} else {
+		error = dpdmux_remove_custom_cls_entry_v10(&ctx->mc_io,
+							   ctx->cmd_flags,
+							   r.dpdmux_handle,
+							   &r.rule_cfg);
+	}
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+	}
 out:
+	dpdmux_rules_close(ctx, &r);
 	return error;
 }
 
-static int cmd_dpdmux_destroy_v9(void)
+static int cmd_dpdmux_add_custom_rule(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpdmux add-custom-rule <dpdmux-object> \\\n"
+		"\t\t--key=<fields> --rule=<rule> --if=<number>\n"
+		"   e.g. restool dpdmux add-custom-rule dpdmux.0 \\\n"
+		"\t\t--key=ipdst,l4dport --rule=ipdst=10.0.0.2,l4dport=80 \\\n"
+		"\t\t--if=1\n"
+		"\n"
+		"Adds a custom classification rule.\n"
+		"\n"
+		"--key=<field>[,<field>...]\n"
+		"   Header fields of the lookup key, as given to set-custom-key.\n"
+		"--rule=<field>=<value>[/<mask>][,...]\n"
+		"   Values to match. Addresses take a prefix length as mask.\n"
+		"   Fields left out match anything (needs a DPDMUX created\n"
+		"   with DPDMUX_OPT_CLS_MASK_SUPPORT).\n"
+		"--if=<number>\n"
+		"   Downlink interface matching frames go to.\n"
+		"\n";
+
+	return custom_rule_dpdmux(ctx, usage_msg, true);
+}
+
+static int cmd_dpdmux_remove_custom_rule(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpdmux remove-custom-rule <dpdmux-object> \\\n"
+		"\t\t--key=<fields> --rule=<rule>\n"
+		"\n"
+		"Removes a rule added with add-custom-rule, given with the same\n"
+		"key and rule.\n"
+		"\n";
+
+	return custom_rule_dpdmux(ctx, usage_msg, false);
+}
+
+/**
+ * A rule of a rule file, parsed before the first one is added
+ */
+struct dpdmux_load_rule {
+	struct dpdmux_l2_rule_v10 l2;
+	uint8_t key[DPKG_MAX_KEY_SIZE];
+	uint8_t mask[DPKG_MAX_KEY_SIZE];
+	uint16_t if_id;
+	unsigned int line;
+};
+
+static int load_rules_parse(struct dpdmux_rules *r, const char *path,
+			    struct dpdmux_load_rule **rules_out,
+			    unsigned int *num_rules_out)
+{
+	struct dpdmux_load_rule *rules = NULL, *tmp;
+	unsigned int num_rules = 0, max_rules = 0;
+	unsigned int line = 0;
+	char buf[512];
+	int error = 0;
+	FILE *f;
+
+	f = fopen(path, "r");
+	if (f == NULL) {
+		error = -errno;
+		ERROR_PRINTF("cannot open %s: %s\n", path, strerror(errno));
+		return error;
+	}
+
+	while (fgets(buf, sizeof(buf), f) != NULL) {
+		struct dpdmux_load_rule *rule;
+		char *rule_str, *if_str, *extra, *saveptr;
+
+		line++;
+		buf[strcspn(buf, "#\n")] = '\0';
+		rule_str = strtok_r(buf, " \t", &saveptr);
+		if (rule_str == NULL)
+			continue;
+
+		if_str = strtok_r(NULL, " \t", &saveptr);
+		extra = strtok_r(NULL, " \t", &saveptr);
+		if (if_str == NULL || extra != NULL) {
+			ERROR_PRINTF("%s:%u: expected <rule> <interface>\n",
+				     path, line);
+			error = -EINVAL;
+			goto out;
+		}
+
+		if (num_rules == max_rules) {
+			max_rules = max_rules ? 2 * max_rules : 64;
+			tmp = realloc(rules, max_rules * sizeof(*rules));
+			if (tmp == NULL) {
+				error = -ENOMEM;
+				goto out;
+			}
+			rules = tmp;
+		}
+
+		rule = &rules[num_rules];
+		memset(rule, 0, sizeof(*rule));
+		error = parse_dpdmux_if(if_str, &r->attr, &rule->if_id);
+		if (!error && r->custom) {
+			error = dpdmux_prepare_custom_rule(r, rule_str);
+			memcpy(rule->key, r->rule_mem.vaddr, r->key.size);
+			memcpy(rule->mask,
+			       (uint8_t *)r->rule_mem.vaddr + DPKG_MAX_KEY_SIZE,
+			       r->key.size);
+		} else if (!error) {
+			error = dpdmux_prepare_l2_rule(r, rule_str, &rule->l2);
+		}
+		if (error) {
+			ERROR_PRINTF("%s:%u: invalid rule\n", path, line);
+			goto out;
+		}
+
+		rule->line = line;
+		num_rules++;
+	}
+
+	if (ferror(f)) {
+		error = -EIO;
+		ERROR_PRINTF("cannot read %s\n", path);
+	}
+
+out:
+	fclose(f);
+	if (error) {
+		free(rules);
+		return error;
+	}
+
+	*rules_out = rules;
+	*num_rules_out = num_rules;
+	return 0;
+}
+
+static int load_rules_dpdmux(struct restool *ctx, const char *usage_msg)
 {
-	return destroy_dpdmux(MC_FW_VERSION_9);
+	struct dpdmux_load_rule *rules = NULL;
+	struct dpdmux_cls_action_v10 action;
+	const char *custom_key = NULL;
+	unsigned int num_rules, i;
+	struct dpdmux_rules r;
+	uint8_t *key_buf;
+	const char *path;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(LOAD_RULES_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(LOAD_RULES_OPT_HELP);
+		return 0;
+	}
+
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(LOAD_RULES_OPT_FILE))) {
+		ERROR_PRINTF("--file option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(LOAD_RULES_OPT_KEY)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(LOAD_RULES_OPT_KEY);
+		custom_key = ctx->cmd_option_args[LOAD_RULES_OPT_KEY];
+	}
+
+	error = dpdmux_rules_open(ctx, usage_msg, custom_key, &r);
+	if (error)
+		return error;
+
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(LOAD_RULES_OPT_FILE);
+	path = ctx->cmd_option_args[LOAD_RULES_OPT_FILE];
+	error = load_rules_parse(&r, path, &rules, &num_rules);
+	if (error)
+		goto out;
+
+	if (r.custom) {
+		error = dpdmux_set_custom_key(ctx, &r);
+		if (error)
+			goto out;
+	}
+
+	/* one rule in flight at a time through the same memory */
+	key_buf = r.rule_mem.vaddr;
+	for (i = 0; i < num_rules; i++) {
+		if (r.custom) {
+			memcpy(key_buf, rules[i].key, r.key.size);
+			memcpy(key_buf + DPKG_MAX_KEY_SIZE, rules[i].mask,
+			       r.key.size);
+			action.dest_if = rules[i].if_id;
+			error = dpdmux_add_custom_cls_entry_v10(&ctx->mc_io,
+								ctx->cmd_flags,
+								r.dpdmux_handle,
+								&r.rule_cfg,
+								&action);
+		} else {
+			error = dpdmux_if_add_l2_rule_v10(&ctx->mc_io,
+							  ctx->cmd_flags,
+							  r.dpdmux_handle,
+							  rules[i].if_id,
+							  &rules[i].l2);
+		}
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			ERROR_PRINTF("%s:%u: rule not added, %u of %u loaded\n",
+				     path, rules[i].line, i, num_rules);
+			goto out;
+		}
+	}
+
+	if (output_is_json()) {
+		output_field("object", "object", "%s", ctx->obj_name);
+		output_field("rule_type", "rule type", "%s",
+			     r.custom ? "custom" : "l2");
+		output_uint("rules_loaded", "rules loaded", num_rules);
+	} else {
+		output_printf("%u %s rules loaded into %s\n", num_rules,
+			      r.custom ? "custom" : "L2", ctx->obj_name);
+	}
+out:
+	free(rules);
+	dpdmux_rules_close(ctx, &r);
+	return error;
 }
 
-static int cmd_dpdmux_destroy_v10(void)
+static int cmd_dpdmux_load_rules(struct restool *ctx)
 {
-	return destroy_dpdmux(MC_FW_VERSION_10);
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpdmux load-rules <dpdmux-object> \\\n"
+		"\t\t--file=<rule-file> [--key=<fields>]\n"
+		"\n"
+		"Adds the rules of a file, one per line, through a single\n"
+		"control session:\n"
+		"   <rule> <interface>\n"
+		"Blank lines and text after # are ignored. The file is checked\n"
+		"whole before the first rule is added.\n"
+		"\n"
+		"Without --key, the rules are L2 rules as taken by\n"
+		"if-add-l2-rule. With --key, the custom key is set first, as\n"
+		"by set-custom-key, and the rules are custom rules as taken by\n"
+		"add-custom-rule.\n"
+		"\n";
+
+	return load_rules_dpdmux(ctx, usage_msg);
 }
 
 struct object_command dpdmux_commands_v9[] = {
@@ -1194,7 +2115,8 @@ struct object_command dpdmux_commands_v9[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpdmux_destroy_options,
-	  .cmd_func = cmd_dpdmux_destroy_v9 },
+	  .cmd_func = cmd_dpdmux_destroy_v9,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -1202,7 +2124,7 @@ struct object_command dpdmux_commands_v9[] = {
 struct object_command dpdmux_commands_v10[] = {
 	{ .cmd_name = "help",
 	  .options = NULL,
-	  .cmd_func = cmd_dpdmux_help },
+	  .cmd_func = cmd_dpdmux_help_v10 },
 
 	{ .cmd_name = "info",
 	  .options = dpdmux_info_options,
@@ -1214,7 +2136,32 @@ struct object_command dpdmux_commands_v10[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpdmux_destroy_options,
-	  .cmd_func = cmd_dpdmux_destroy_v10 },
+	  .cmd_func = cmd_dpdmux_destroy_v10,
+	  .priority = CMD_PRIORITY_HIGH },
+
+	{ .cmd_name = "if-add-l2-rule",
+	  .options = dpdmux_l2_rule_options,
+	  .cmd_func = cmd_dpdmux_if_add_l2_rule },
+
+	{ .cmd_name = "if-remove-l2-rule",
+	  .options = dpdmux_l2_rule_options,
+	  .cmd_func = cmd_dpdmux_if_remove_l2_rule },
+
+	{ .cmd_name = "set-custom-key",
+	  .options = dpdmux_custom_key_options,
+	  .cmd_func = cmd_dpdmux_set_custom_key },
+
+	{ .cmd_name = "add-custom-rule",
+	  .options = dpdmux_custom_rule_options,
+	  .cmd_func = cmd_dpdmux_add_custom_rule },
+
+	{ .cmd_name = "remove-custom-rule",
+	  .options = dpdmux_custom_rule_options,
+	  .cmd_func = cmd_dpdmux_remove_custom_rule },
+
+	{ .cmd_name = "load-rules",
+	  .options = dpdmux_load_rules_options,
+	  .cmd_func = cmd_dpdmux_load_rules },
 
 	{ .cmd_name = NULL },
 };
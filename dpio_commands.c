@@ -43,14 +43,13 @@
 #include "mc_v9/fsl_dpio.h"
 #include "mc_v10/fsl_dpio.h"
 
-enum mc_cmd_status mc_status;
-
 /**
  * dpio info command options
  */
 enum dpio_info_options {
 	INFO_OPT_HELP = 0,
 	INFO_OPT_VERBOSE,
+	INFO_OPT_FIELDS,
 };
 
 static struct option dpio_info_options[] = {
@@ -68,6 +67,13 @@ static struct option dpio_info_options[] = {
 		.val = 0,
 	},
 
+	[INFO_OPT_FIELDS] = {
+		.name = "fields",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
 	{ 0 },
 };
 
@@ -144,7 +150,7 @@ static const struct flib_ops dpio_ops = {
 	.obj_get_irq_status = dpio_get_irq_status,
 };
 
-static int cmd_dpio_help(void)
+static int cmd_dpio_help(struct restool *ctx)
 {
 	static const char help_msg[] =
 		"\n"
@@ -157,11 +163,12 @@ static int cmd_dpio_help(void)
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
 
+	(void)ctx;
 	printf(help_msg);
 	return 0;
 }
 
-static int print_dpio_attr_v9(uint32_t dpio_id,
+static int print_dpio_attr_v9(struct restool *ctx, uint32_t dpio_id,
 			      struct dprc_obj_desc *target_obj_desc)
 {
 	uint16_t dpio_handle;
@@ -169,11 +176,12 @@ static int print_dpio_attr_v9(uint32_t dpio_id,
 	struct dpio_attr dpio_attr;
 	bool dpio_opened = false;
 
-	error = dpio_open(&restool.mc_io, 0, dpio_id, &dpio_handle);
+	error = dpio_open(&ctx->mc_io, ctx->cmd_flags, dpio_id, &dpio_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpio_opened = true;
@@ -186,35 +194,38 @@ static int print_dpio_attr_v9(uint32_t dpio_id,
 	}
 
 	memset(&dpio_attr, 0, sizeof(dpio_attr));
-	error = dpio_get_attributes(&restool.mc_io, 0, dpio_handle, &dpio_attr);
+	error = dpio_get_attributes(&ctx->mc_io, ctx->cmd_flags, dpio_handle,
+				    &dpio_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(dpio_id == (uint32_t)dpio_attr.id);
 
-	printf("dpio version: %u.%u\n", dpio_attr.version.major,
-	       dpio_attr.version.minor);
-	printf("dpio id: %d\n", dpio_attr.id);
-	printf("plugged state: %splugged\n",
+	output_field("version", "dpio version",
+		     "%u.%u", dpio_attr.version.major,
+		     dpio_attr.version.minor);
+	output_int("id", "dpio id", dpio_attr.id);
+	output_field("plugged_state", "plugged state", "%splugged",
 		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	printf(
-		"offset of qbman software portal cache-enabled area: %#llx\n",
+	output_hex("qbman_portal_ce_offset",
+		"offset of qbman software portal cache-enabled area",
 		(unsigned long long)dpio_attr.qbman_portal_ce_offset);
-	printf(
-		"offset of qbman software portal cache-inhibited area: %#llx\n",
+	output_hex("qbman_portal_ci_offset",
+		"offset of qbman software portal cache-inhibited area",
 		(unsigned long long)dpio_attr.qbman_portal_ci_offset);
-	printf("qbman software portal id: %#x\n",
-	       (unsigned int)dpio_attr.qbman_portal_id);
-	printf("dpio channel mode is: ");
-	dpio_attr.channel_mode == 0 ? printf("DPIO_NO_CHANNEL\n") :
-	dpio_attr.channel_mode == 1 ? printf("DPIO_LOCAL_CHANNEL\n") :
-	printf("wrong mode\n");
-	printf("number of priorities is: %#x\n",
-	       (unsigned int)dpio_attr.num_priorities);
-	print_obj_label(target_obj_desc);
+	output_hex("qbman_portal_id", "qbman software portal id",
+		   (unsigned int)dpio_attr.qbman_portal_id);
+	output_field("channel_mode", "dpio channel mode is", "%s",
+		     dpio_attr.channel_mode == 0 ? "DPIO_NO_CHANNEL" :
+		     dpio_attr.channel_mode == 1 ? "DPIO_LOCAL_CHANNEL" :
+		     "wrong mode");
+	output_hex("num_priorities", "number of priorities is",
+		   (unsigned int)dpio_attr.num_priorities);
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -222,11 +233,12 @@ out:
 	if (dpio_opened) {
 		int error2;
 
-		error2 = dpio_close(&restool.mc_io, 0, dpio_handle);
+		error2 = dpio_close(&ctx->mc_io, ctx->cmd_flags, dpio_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -235,69 +247,85 @@ out:
 	return error;
 }
 
-static int print_dpio_attr_v10(uint32_t dpio_id,
+static int print_dpio_attr_v10(struct restool *ctx, uint32_t dpio_id,
 			       struct dprc_obj_desc *target_obj_desc)
 {
 	struct dpio_attr_v10 dpio_attr;
 	bool dpio_opened = false;
 	uint16_t dpio_handle;
 	uint16_t obj_major, obj_minor;
-	int error;
+	int error = 0;
 
-	error = dpio_open_v10(&restool.mc_io, 0, dpio_id, &dpio_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpio_opened = true;
-	if (0 == dpio_handle) {
-		DEBUG_PRINTF(
-			"dpio_open() returned invalid handle (auth 0) for dpio.%u\n",
-			dpio_id);
-		error = -ENOENT;
-		goto out;
-	}
-
-	memset(&dpio_attr, 0, sizeof(dpio_attr));
-	error = dpio_get_attributes_v10(&restool.mc_io, 0,
-					dpio_handle, &dpio_attr);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	assert(dpio_id == (uint32_t)dpio_attr.id);
+	if (INFO_FIELD(ATTR)) {
+		error = dpio_open_v10(&ctx->mc_io, ctx->cmd_flags, dpio_id,
+				      &dpio_handle);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		dpio_opened = true;
+		if (0 == dpio_handle) {
+			DEBUG_PRINTF(
+				"dpio_open() returned invalid handle (auth 0) for dpio.%u\n",
+				dpio_id);
+			error = -ENOENT;
+			goto out;
+		}
 
-	error = dpio_get_api_version_v10(&restool.mc_io, 0, &obj_major, &obj_minor);
-	if (error) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		memset(&dpio_attr, 0, sizeof(dpio_attr));
+		error = dpio_get_attributes_v10(&ctx->mc_io, ctx->cmd_flags,
+						dpio_handle, &dpio_attr);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		assert(dpio_id == (uint32_t)dpio_attr.id);
 	}
 
-	printf("dpio version: %u.%u\n", obj_major, obj_minor);
-	printf("dpio id: %d\n", dpio_attr.id);
-	printf("plugged state: %splugged\n",
-		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	printf(
-		"offset of qbman software portal cache-enabled area: %#llx\n",
-		(unsigned long long)dpio_attr.qbman_portal_ce_offset);
-	printf(
-		"offset of qbman software portal cache-inhibited area: %#llx\n",
-		(unsigned long long)dpio_attr.qbman_portal_ci_offset);
-	printf("qbman software portal id: %#x\n",
-	       (unsigned int)dpio_attr.qbman_portal_id);
-	printf("dpio channel mode is: ");
-	dpio_attr.channel_mode == 0 ? printf("DPIO_NO_CHANNEL\n") :
-	dpio_attr.channel_mode == 1 ? printf("DPIO_LOCAL_CHANNEL\n") :
-	printf("wrong mode\n");
-	printf("number of priorities is: %#x\n",
-	       (unsigned int)dpio_attr.num_priorities);
-	print_obj_label(target_obj_desc);
+	if (INFO_FIELD(VERSION)) {
+		error = get_obj_api_version(ctx, "dpio",
+					    dpio_get_api_version_v10,
+					    &obj_major, &obj_minor);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		output_field("version", "dpio version",
+			     "%u.%u", obj_major, obj_minor);
+	}
+
+	if (INFO_FIELD(ID))
+		output_int("id", "dpio id", dpio_id);
+	if (INFO_FIELD(STATE))
+		output_field("plugged_state", "plugged state", "%splugged",
+			     (target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ?
+			     "" : "un");
+	if (INFO_FIELD(ATTR)) {
+		output_hex("qbman_portal_ce_offset",
+			"offset of qbman software portal cache-enabled area",
+			(unsigned long long)dpio_attr.qbman_portal_ce_offset);
+		output_hex("qbman_portal_ci_offset",
+			"offset of qbman software portal cache-inhibited area",
+			(unsigned long long)dpio_attr.qbman_portal_ci_offset);
+		output_hex("qbman_portal_id", "qbman software portal id",
+			   (unsigned int)dpio_attr.qbman_portal_id);
+		output_field("channel_mode", "dpio channel mode is", "%s",
+			     dpio_attr.channel_mode == 0 ? "DPIO_NO_CHANNEL" :
+			     dpio_attr.channel_mode == 1 ? "DPIO_LOCAL_CHANNEL" :
+			     "wrong mode");
+		output_hex("num_priorities", "number of priorities is",
+			   (unsigned int)dpio_attr.num_priorities);
+	}
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -305,11 +333,13 @@ out:
 	if (dpio_opened) {
 		int error2;
 
-		error2 = dpio_close_v10(&restool.mc_io, 0, dpio_handle);
+		error2 = dpio_close_v10(&ctx->mc_io, ctx->cmd_flags,
+					dpio_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -318,51 +348,50 @@ out:
 	return error;
 }
 
-static int print_dpio_info(uint32_t dpio_id, int mc_fw_version)
+static int print_dpio_info(struct restool *ctx, uint32_t dpio_id,
+			   int mc_fw_version)
 {
 	int error;
 	struct dprc_obj_desc target_obj_desc;
-	uint32_t target_parent_dprc_id;
-	bool found = false;
-
-	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0, dpio_id,
-				"dpio", &target_obj_desc,
-				&target_parent_dprc_id, &found);
+
+	error = find_info_obj_desc(ctx, dpio_id, "dpio",
+				   ctx->cmd_option_mask &
+				   ONE_BIT_MASK(INFO_OPT_VERBOSE),
+				   &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (strcmp(target_obj_desc.type, "dpio")) {
-		printf("dpio.%d does not exist\n", dpio_id);
-		return -EINVAL;
-	}
-
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = print_dpio_attr_v9(dpio_id, &target_obj_desc);
+		error = print_dpio_attr_v9(ctx, dpio_id, &target_obj_desc);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = print_dpio_attr_v10(dpio_id, &target_obj_desc);
+		error = print_dpio_attr_v10(ctx, dpio_id, &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpio_ops);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
+		error = print_obj_verbose(ctx, &target_obj_desc, &dpio_ops);
 	}
 
 out:
 	return error;
 }
 
-static int info_dpio(int mc_fw_version)
+static int info_dpio(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
 		"Usage: restool dpio info <dpio-object> [--verbose]\n"
+		"                         [--fields=<field>[,<field>...]]\n"
 		"\n"
 		"OPTIONS:\n"
 		"--verbose\n"
 		"   Shows extended/verbose information about the object\n"
+		"--fields=<field>[,<field>...]\n"
+		"   Shows only the given fields and sends only the MC\n"
+		"   commands they need. <field> is one of: version, id,\n"
+		"   state, endpoint, link, mac, attr, stats, label.\n"
+		"   Requires MC firmware 10.x.\n"
 		"\n"
 		"EXAMPLE:\n"
 		"Display information about dpio.5:\n"
@@ -372,148 +401,163 @@ static int info_dpio(int mc_fw_version)
 	uint32_t obj_id;
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_FIELDS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_FIELDS);
+		error = parse_info_fields(ctx, 
+				ctx->cmd_option_args[INFO_OPT_FIELDS]);
+		if (error < 0)
+			goto out;
+	}
+
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpio", &obj_id);
+	error = parse_object_name(ctx->obj_name, "dpio", &obj_id);
 	if (error < 0)
 		goto out;
 
-	error = print_dpio_info(obj_id, mc_fw_version);
+	error = print_dpio_info(ctx, obj_id, mc_fw_version);
 out:
 	return error;
 }
 
-static int cmd_dpio_info_v9(void)
+static int cmd_dpio_info_v9(struct restool *ctx)
 {
-	return info_dpio(MC_FW_VERSION_9);
+	return info_dpio(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpio_info_v10(void)
+static int cmd_dpio_info_v10(struct restool *ctx)
 {
-	return info_dpio(MC_FW_VERSION_10);
+	return info_dpio(ctx, MC_FW_VERSION_10);
 }
 
-static int create_dpio_v9(struct dpio_cfg *dpio_cfg)
+static int create_dpio_v9(struct restool *ctx, struct dpio_cfg *dpio_cfg)
 {
 	struct dpio_attr dpio_attr;
 	uint16_t dpio_handle;
 	int error;
 
-	error = dpio_create(&restool.mc_io, 0, dpio_cfg, &dpio_handle);
+	error = dpio_create(&ctx->mc_io, ctx->cmd_flags, dpio_cfg,
+			    &dpio_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	memset(&dpio_attr, 0, sizeof(struct dpio_attr));
-	error = dpio_get_attributes(&restool.mc_io, 0, dpio_handle, &dpio_attr);
+	error = dpio_get_attributes(&ctx->mc_io, ctx->cmd_flags, dpio_handle,
+				    &dpio_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
-	print_new_obj("dpio", dpio_attr.id, NULL);
+	print_new_obj(ctx, "dpio", dpio_attr.id, NULL);
 
-	error = dpio_close(&restool.mc_io, 0, dpio_handle);
+	error = dpio_close(&ctx->mc_io, ctx->cmd_flags, dpio_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	return 0;
 }
 
-static int create_dpio_v10(struct dpio_cfg_v10 *dpio_cfg)
+static int create_dpio_v10(struct restool *ctx, struct dpio_cfg_v10 *dpio_cfg)
 {
 	uint32_t dpio_id, dprc_id;
 	uint16_t dprc_handle;
 	bool dprc_opened;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
+	dprc_handle = ctx->root_dprc_handle;
 	dprc_opened = false;
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
 		error = parse_object_name(
-				restool.cmd_option_args[CREATE_OPT_PARENT_DPRC],
+				ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC],
 				"dprc", &dprc_id);
 		if (error)
 			return error;
 
-		if (restool.root_dprc_id != dprc_id) {
-			error = open_dprc(dprc_id, &dprc_handle);
+		if (ctx->root_dprc_id != dprc_id) {
+			error = open_dprc(ctx, dprc_id, &dprc_handle);
 			if (error)
 				return error;
 			dprc_opened = true;
 		}
 	}
 
-	error = dpio_create_v10(&restool.mc_io, dprc_handle, 0,
+	error = dpio_create_v10(&ctx->mc_io, dprc_handle, ctx->cmd_flags,
 				dpio_cfg, &dpio_id);
 	if (error) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	if (dprc_opened) {
-		(void)dprc_close(&restool.mc_io, 0, dprc_handle);
-		print_new_obj("dpio", dpio_id,
-			      restool.cmd_option_args[CREATE_OPT_PARENT_DPRC]);
+		(void)dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
+		print_new_obj(ctx, "dpio", dpio_id,
+			      ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC]);
 	} else {
-		print_new_obj("dpio", dpio_id, NULL);
+		print_new_obj(ctx, "dpio", dpio_id, NULL);
 	}
 
 	return error;
 }
 
-static int create_dpio(int mc_fw_version, const char *usage_msg)
+static int create_dpio(struct restool *ctx, int mc_fw_version,
+		       const char *usage_msg)
 {
 	int error;
 	long val;
 	struct dpio_cfg_v10 dpio_cfg_v10;
 	struct dpio_cfg dpio_cfg;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name != NULL) {
+	if (ctx->obj_name != NULL) {
 		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
-			     restool.obj_name);
+			     ctx->obj_name);
 		puts(usage_msg);
 		return -EINVAL;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_CHANNEL_MODE)) {
-		restool.cmd_option_mask &=
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_CHANNEL_MODE)) {
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_CHANNEL_MODE);
-		if (strcmp(restool.cmd_option_args[CREATE_OPT_CHANNEL_MODE],
+		if (strcmp(ctx->cmd_option_args[CREATE_OPT_CHANNEL_MODE],
 		    "DPIO_LOCAL_CHANNEL") == 0) {
 			dpio_cfg.channel_mode = DPIO_LOCAL_CHANNEL;
 			dpio_cfg_v10.channel_mode = DPIO_LOCAL_CHANNEL;
 		} else if (
-			strcmp(restool.cmd_option_args[CREATE_OPT_CHANNEL_MODE],
+			strcmp(ctx->cmd_option_args[CREATE_OPT_CHANNEL_MODE],
 			"DPIO_NO_CHANNEL") == 0) {
 			dpio_cfg.channel_mode = DPIO_NO_CHANNEL;
 			dpio_cfg_v10.channel_mode = DPIO_NO_CHANNEL;
@@ -527,10 +571,10 @@ static int create_dpio(int mc_fw_version, const char *usage_msg)
 		dpio_cfg_v10.channel_mode = DPIO_LOCAL_CHANNEL;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_PRIORITIES)) {
-		restool.cmd_option_mask &=
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_PRIORITIES)) {
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_NUM_PRIORITIES);
-		error = get_option_value(CREATE_OPT_NUM_PRIORITIES, &val,
+		error = get_option_value(ctx, CREATE_OPT_NUM_PRIORITIES, &val,
 					 "Invalid value: num-priorities option",
 					 1, 8);
 		if (error)
@@ -543,16 +587,16 @@ static int create_dpio(int mc_fw_version, const char *usage_msg)
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = create_dpio_v9(&dpio_cfg);
+		error = create_dpio_v9(ctx, &dpio_cfg);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = create_dpio_v10(&dpio_cfg_v10);
+		error = create_dpio_v10(ctx, &dpio_cfg_v10);
 	else
 		return -EINVAL;
 
 	return error;
 }
 
-static int cmd_dpio_create_v9(void)
+static int cmd_dpio_create_v9(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -573,10 +617,10 @@ static int cmd_dpio_create_v9(void)
 		"   $ restool dpio create\n"
 		"\n";
 
-	return create_dpio(MC_FW_VERSION_9, usage_msg);
+	return create_dpio(ctx, MC_FW_VERSION_9, usage_msg);
 }
 
-static int cmd_dpio_create_v10(void)
+static int cmd_dpio_create_v10(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -600,20 +644,21 @@ static int cmd_dpio_create_v10(void)
 		"   $ restool dpio create\n"
 		"\n";
 
-	return create_dpio(MC_FW_VERSION_10, usage_msg);
+	return create_dpio(ctx, MC_FW_VERSION_10, usage_msg);
 }
 
-static int destroy_dpio_v9(uint32_t dpio_id)
+static int destroy_dpio_v9(struct restool *ctx, uint32_t dpio_id)
 {
 	bool dpio_opened = false;
 	uint16_t dpio_handle;
 	int error, error2;
 
-	error = dpio_open(&restool.mc_io, 0, dpio_id, &dpio_handle);
+	error = dpio_open(&ctx->mc_io, ctx->cmd_flags, dpio_id, &dpio_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpio_opened = true;
@@ -625,23 +670,25 @@ static int destroy_dpio_v9(uint32_t dpio_id)
 		goto out;
 	}
 
-	error = dpio_destroy(&restool.mc_io, 0, dpio_handle);
+	error = dpio_destroy(&ctx->mc_io, ctx->cmd_flags, dpio_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpio_opened = false;
-	printf("dpio.%u is destroyed\n", dpio_id);
+	print_destroyed_obj("dpio", dpio_id);
 
 out:
 	if (dpio_opened) {
-		error2 = dpio_close(&restool.mc_io, 0, dpio_handle);
+		error2 = dpio_close(&ctx->mc_io, ctx->cmd_flags, dpio_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -650,42 +697,43 @@ out:
 	return error;
 }
 
-static int destroy_dpio_v10(uint32_t dpio_id)
+static int destroy_dpio_v10(struct restool *ctx, uint32_t dpio_id)
 {
 	uint16_t dprc_handle;
 	uint32_t dprc_id;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
-	dprc_id = restool.root_dprc_id;
-	error = get_parent_dprc_id(dpio_id, "dpio", &dprc_id);
+	dprc_handle = ctx->root_dprc_handle;
+	dprc_id = ctx->root_dprc_id;
+	error = get_parent_dprc_id(ctx, dpio_id, "dpio", &dprc_id);
 	if (error)
 		return error;
 
-	if (dprc_id != restool.root_dprc_id) {
-		error = open_dprc(dprc_id, &dprc_handle);
+	if (dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, dprc_id, &dprc_handle);
 		if (error)
 			return error;
 	}
 
-	error = dpio_destroy_v10(&restool.mc_io, dprc_handle,
-				 0, dpio_id);
+	error = dpio_destroy_v10(&ctx->mc_io, dprc_handle,
+				 ctx->cmd_flags, dpio_id);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
-	printf("dpio.%u is destroyed\n", dpio_id);
+	print_destroyed_obj("dpio", dpio_id);
 
 out:
-	if (dprc_id != restool.root_dprc_id)
-		error = dprc_close(&restool.mc_io, 0, dprc_handle);
+	if (dprc_id != ctx->root_dprc_id)
+		error = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 
 	return error;
 }
 
-static int destroy_dpio(int mc_fw_version)
+static int destroy_dpio(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -696,37 +744,37 @@ static int destroy_dpio(int mc_fw_version)
 	int error;
 	uint32_t dpio_id;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	if (in_use(restool.obj_name, "destroyed")) {
+	if (in_use(ctx->obj_name, "destroyed")) {
 		error = -EBUSY;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpio", &dpio_id);
+	error = parse_object_name(ctx->obj_name, "dpio", &dpio_id);
 	if (error < 0)
 		goto out;
 
-	if (!find_obj("dpio", dpio_id)) {
+	if (!find_obj(ctx, "dpio", dpio_id)) {
 		error = -EINVAL;
 		goto out;
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = destroy_dpio_v9(dpio_id);
+		error = destroy_dpio_v9(ctx, dpio_id);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = destroy_dpio_v10(dpio_id);
+		error = destroy_dpio_v10(ctx, dpio_id);
 	else
 		return -EINVAL;
 
@@ -734,14 +782,14 @@ out:
 	return error;
 }
 
-static int cmd_dpio_destroy_v9(void)
+static int cmd_dpio_destroy_v9(struct restool *ctx)
 {
-	return destroy_dpio(MC_FW_VERSION_9);
+	return destroy_dpio(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpio_destroy_v10(void)
+static int cmd_dpio_destroy_v10(struct restool *ctx)
 {
-	return destroy_dpio(MC_FW_VERSION_10);
+	return destroy_dpio(ctx, MC_FW_VERSION_10);
 }
 
 struct object_command dpio_commands_v9[] = {
@@ -759,7 +807,8 @@ struct object_command dpio_commands_v9[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpio_destroy_options,
-	  .cmd_func = cmd_dpio_destroy_v9 },
+	  .cmd_func = cmd_dpio_destroy_v9,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -779,7 +828,8 @@ struct object_command dpio_commands_v10[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpio_destroy_options,
-	  .cmd_func = cmd_dpio_destroy_v10 },
+	  .cmd_func = cmd_dpio_destroy_v10,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -0,0 +1,294 @@
+/* Copyright 2018 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <arpa/inet.h>
+#include "restool.h"
+#include "utils.h"
+#include "dpkg_key.h"
+
+/*
+ * L4 ports are extracted through the UDP fields: the parser places TCP,
+ * UDP and SCTP ports at the same offsets, so they match all three.
+ */
+static const struct dpkg_key_field dpkg_key_fields[] = {
+	{ "ethdst", NET_PROT_ETH, NH_FLD_ETH_DA, NH_FLD_ETH_ADDR_SIZE,
+	  DPKG_KEY_FORMAT_MAC },
+	{ "ethsrc", NET_PROT_ETH, NH_FLD_ETH_SA, NH_FLD_ETH_ADDR_SIZE,
+	  DPKG_KEY_FORMAT_MAC },
+	{ "ethtype", NET_PROT_ETH, NH_FLD_ETH_TYPE, 2, DPKG_KEY_FORMAT_NUM },
+	{ "vlan", NET_PROT_VLAN, NH_FLD_VLAN_TCI, 2, DPKG_KEY_FORMAT_NUM },
+	{ "ipsrc", NET_PROT_IP, NH_FLD_IP_SRC, NH_FLD_IPV4_ADDR_SIZE,
+	  DPKG_KEY_FORMAT_IPV4 },
+	{ "ipdst", NET_PROT_IP, NH_FLD_IP_DST, NH_FLD_IPV4_ADDR_SIZE,
+	  DPKG_KEY_FORMAT_IPV4 },
+	{ "ipproto", NET_PROT_IP, NH_FLD_IP_PROTO, NH_FLD_IP_PROTO_SIZE,
+	  DPKG_KEY_FORMAT_NUM },
+	{ "l4sport", NET_PROT_UDP, NH_FLD_UDP_PORT_SRC, NH_FLD_UDP_PORT_SIZE,
+	  DPKG_KEY_FORMAT_NUM },
+	{ "l4dport", NET_PROT_UDP, NH_FLD_UDP_PORT_DST, NH_FLD_UDP_PORT_SIZE,
+	  DPKG_KEY_FORMAT_NUM },
+};
+
+const struct dpkg_key_field *dpkg_key_field_find(const char *name)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(dpkg_key_fields); i++) {
+		if (strcmp(dpkg_key_fields[i].name, name) == 0)
+			return &dpkg_key_fields[i];
+	}
+
+	return NULL;
+}
+
+void dpkg_key_print_fields(FILE *fp)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(dpkg_key_fields); i++)
+		fprintf(fp, "%s%s", i ? ", " : "", dpkg_key_fields[i].name);
+	fprintf(fp, "\n");
+}
+
+static const struct dpkg_key_field *find_field_or_fail(const char *name)
+{
+	const struct dpkg_key_field *key_field = dpkg_key_field_find(name);
+
+	if (key_field == NULL) {
+		ERROR_PRINTF("unknown key field: \'%s\'\n", name);
+		fprintf(stderr, "Valid key fields: ");
+		dpkg_key_print_fields(stderr);
+	}
+
+	return key_field;
+}
+
+int dpkg_key_parse(const char *key_str, struct dpkg_key *key)
+{
+	char buf[128];
+	char *saveptr;
+	char *name;
+
+	if (strlen(key_str) >= sizeof(buf)) {
+		ERROR_PRINTF("key too long: \'%s\'\n", key_str);
+		return -EINVAL;
+	}
+
+	strcpy(buf, key_str);
+	memset(key, 0, sizeof(*key));
+	for (name = strtok_r(buf, ",", &saveptr); name != NULL;
+	     name = strtok_r(NULL, ",", &saveptr)) {
+		const struct dpkg_key_field *key_field;
+
+		key_field = find_field_or_fail(name);
+		if (key_field == NULL)
+			return -EINVAL;
+
+		for (unsigned int i = 0; i < key->num_fields; i++) {
+			if (key->fields[i] == key_field) {
+				ERROR_PRINTF("duplicated key field: \'%s\'\n",
+					     name);
+				return -EINVAL;
+			}
+		}
+
+		if (key->num_fields == DPKG_MAX_NUM_OF_EXTRACTS) {
+			ERROR_PRINTF("a key has at most %d fields\n",
+				     DPKG_MAX_NUM_OF_EXTRACTS);
+			return -EINVAL;
+		}
+
+		key->fields[key->num_fields++] = key_field;
+		key->size += key_field->size;
+	}
+
+	if (key->num_fields == 0) {
+		ERROR_PRINTF("empty key\n");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+void dpkg_key_to_profile(const struct dpkg_key *key,
+			 struct dpkg_profile_cfg *cfg)
+{
+	memset(cfg, 0, sizeof(*cfg));
+	cfg->num_extracts = key->num_fields;
+	for (unsigned int i = 0; i < key->num_fields; i++) {
+		struct dpkg_extract *extract = &cfg->extracts[i];
+
+		extract->type = DPKG_EXTRACT_FROM_HDR;
+		extract->extract.from_hdr.prot = key->fields[i]->prot;
+		extract->extract.from_hdr.type = DPKG_FULL_FIELD;
+		extract->extract.from_hdr.field = key->fields[i]->field;
+	}
+}
+
+/* value in network byte order, size bytes */
+static int parse_field_value(const struct dpkg_key_field *key_field,
+			     const char *str, uint8_t *buf)
+{
+	unsigned long val;
+	char *endptr;
+	int i;
+
+	switch (key_field->format) {
+	case DPKG_KEY_FORMAT_MAC:
+		for (i = 0; i < 6; i++) {
+			errno = 0;
+			val = strtoul(str, &endptr, 16);
+			if (errno != 0 || endptr == str || val > UINT8_MAX ||
+			    *endptr != (i < 5 ? ':' : '\0'))
+				return -EINVAL;
+
+			buf[i] = (uint8_t)val;
+			str = endptr + 1;
+		}
+
+		return 0;
+
+	case DPKG_KEY_FORMAT_IPV4:
+		return inet_pton(AF_INET, str, buf) == 1 ? 0 : -EINVAL;
+
+	case DPKG_KEY_FORMAT_NUM:
+		errno = 0;
+		val = strtoul(str, &endptr, 0);
+		if (errno != 0 || endptr == str || *endptr != '\0' ||
+		    val >> (8 * key_field->size) != 0)
+			return -EINVAL;
+
+		for (i = key_field->size - 1; i >= 0; i--) {
+			buf[i] = (uint8_t)val;
+			val >>= 8;
+		}
+
+		return 0;
+	}
+
+	return -EINVAL;
+}
+
+/* a mask is written like a value, or as a prefix length for addresses */
+static int parse_field_mask(const struct dpkg_key_field *key_field,
+			    const char *str, uint8_t *buf)
+{
+	unsigned long prefix;
+	char *endptr;
+
+	if (key_field->format == DPKG_KEY_FORMAT_IPV4 &&
+	    strchr(str, '.') == NULL) {
+		errno = 0;
+		prefix = strtoul(str, &endptr, 10);
+		if (errno != 0 || endptr == str || *endptr != '\0' ||
+		    prefix > 8UL * key_field->size)
+			return -EINVAL;
+
+		memset(buf, 0, key_field->size);
+		for (unsigned long bit = 0; bit < prefix; bit++)
+			buf[bit / 8] |= 0x80 >> (bit % 8);
+
+		return 0;
+	}
+
+	return parse_field_value(key_field, str, buf);
+}
+
+int dpkg_key_parse_rule(const struct dpkg_key *key, const char *rule_str,
+			uint8_t *key_buf, uint8_t *mask_buf)
+{
+	char buf[256];
+	char *saveptr;
+	char *term;
+
+	if (strlen(rule_str) >= sizeof(buf)) {
+		ERROR_PRINTF("rule too long: \'%s\'\n", rule_str);
+		return -EINVAL;
+	}
+
+	strcpy(buf, rule_str);
+	memset(key_buf, 0, key->size);
+	memset(mask_buf, 0, key->size);
+	for (term = strtok_r(buf, ",", &saveptr); term != NULL;
+	     term = strtok_r(NULL, ",", &saveptr)) {
+		const struct dpkg_key_field *key_field;
+		char *value, *mask;
+		unsigned int i, offset = 0;
+
+		value = strchr(term, '=');
+		if (value == NULL) {
+			ERROR_PRINTF("expected <field>=<value>: \'%s\'\n",
+				     term);
+			return -EINVAL;
+		}
+
+		*value++ = '\0';
+		mask = strchr(value, '/');
+		if (mask != NULL)
+			*mask++ = '\0';
+
+		key_field = find_field_or_fail(term);
+		if (key_field == NULL)
+			return -EINVAL;
+
+		for (i = 0; i < key->num_fields; i++) {
+			if (key->fields[i] == key_field)
+				break;
+			offset += key->fields[i]->size;
+		}
+
+		if (i == key->num_fields) {
+			ERROR_PRINTF("field \'%s\' is not part of the key\n",
+				     term);
+			return -EINVAL;
+		}
+
+		if (parse_field_value(key_field, value, &key_buf[offset])) {
+			ERROR_PRINTF("invalid %s value: \'%s\'\n", term,
+				     value);
+			return -EINVAL;
+		}
+
+		if (mask == NULL) {
+			memset(&mask_buf[offset], 0xff, key_field->size);
+		} else if (parse_field_mask(key_field, mask,
+					    &mask_buf[offset])) {
+			ERROR_PRINTF("invalid %s mask: \'%s\'\n", term, mask);
+			return -EINVAL;
+		}
+
+		for (i = 0; i < key_field->size; i++)
+			key_buf[offset + i] &= mask_buf[offset + i];
+	}
+
+	return 0;
+}
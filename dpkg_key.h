@@ -0,0 +1,99 @@
+/* Copyright 2018 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _DPKG_KEY_H_
+#define _DPKG_KEY_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include "mc_v9/fsl_dpkg.h"
+
+/**
+ * Largest lookup key the classification tables take, in bytes
+ */
+#define DPKG_MAX_KEY_SIZE	56
+
+enum dpkg_key_format {
+	DPKG_KEY_FORMAT_NUM = 0,
+	DPKG_KEY_FORMAT_MAC,
+	DPKG_KEY_FORMAT_IPV4,
+};
+
+/**
+ * Header field that can be part of a classification key, by the name used
+ * on the command line
+ */
+struct dpkg_key_field {
+	const char *name;
+	enum net_prot prot;
+	uint32_t field;
+	/* bytes the field takes in a lookup key */
+	uint8_t size;
+	/* how its values are written in rules */
+	enum dpkg_key_format format;
+};
+
+/**
+ * Ordered list of header fields making up a lookup key
+ */
+struct dpkg_key {
+	unsigned int num_fields;
+	const struct dpkg_key_field *fields[DPKG_MAX_NUM_OF_EXTRACTS];
+	/* bytes of a lookup key, the sum of the field sizes */
+	uint8_t size;
+};
+
+const struct dpkg_key_field *dpkg_key_field_find(const char *name);
+
+/**
+ * Parses a comma separated list of field names, e.g.
+ * "ipsrc,ipdst,l4sport,l4dport"
+ */
+int dpkg_key_parse(const char *key_str, struct dpkg_key *key);
+
+/**
+ * Key generation profile extracting the full fields of key, in order
+ */
+void dpkg_key_to_profile(const struct dpkg_key *key,
+			 struct dpkg_profile_cfg *cfg);
+
+/**
+ * Parses a rule "<field>=<value>[/<mask>][,...]" into the key and mask
+ * bytes of a table entry, key->size bytes each. Fields of key missing from
+ * the rule are wildcards (zero mask).
+ */
+int dpkg_key_parse_rule(const struct dpkg_key *key, const char *rule_str,
+			uint8_t *key_buf, uint8_t *mask_buf);
+
+void dpkg_key_print_fields(FILE *fp);
+
+#endif /* _DPKG_KEY_H_ */
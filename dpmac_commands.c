@@ -49,6 +49,7 @@
 enum dpmac_info_options {
 	INFO_OPT_HELP = 0,
 	INFO_OPT_VERBOSE,
+	INFO_OPT_FIELDS,
 };
 
 static struct option dpmac_info_options[] = {
@@ -66,6 +67,13 @@ static struct option dpmac_info_options[] = {
 		.val = 0,
 	},
 
+	[INFO_OPT_FIELDS] = {
+		.name = "fields",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
 	{ 0 },
 };
 
@@ -134,7 +142,7 @@ static const struct flib_ops dpmac_ops = {
 	.obj_get_irq_status = dpmac_get_irq_status,
 };
 
-static int cmd_dpmac_help(void)
+static int cmd_dpmac_help(struct restool *ctx)
 {
 	static const char help_msg[] =
 		"\n"
@@ -147,11 +155,12 @@ static int cmd_dpmac_help(void)
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
 
+	(void)ctx;
 	printf(help_msg);
 	return 0;
 }
 
-static int print_dpmac_endpoint(uint32_t target_id)
+static int print_dpmac_endpoint(struct restool *ctx, uint32_t target_id)
 {
 	struct dprc_endpoint endpoint1;
 	struct dprc_endpoint endpoint2;
@@ -166,35 +175,45 @@ static int print_dpmac_endpoint(uint32_t target_id)
 	endpoint1.id = target_id;
 	endpoint1.if_id = 0;
 
-	error = dprc_get_connection(&restool.mc_io, 0,
-					restool.root_dprc_handle,
+	error = dprc_get_connection(&ctx->mc_io, ctx->cmd_flags,
+					ctx->root_dprc_handle,
 					&endpoint1, &endpoint2, &state);
-	printf("endpoint state: %d\n", state);
+	output_int("endpoint_state", "endpoint state", state);
 
 	if (error == 0 && state == -1) {
-		printf("endpoint: No object associated\n");
+		output_field("endpoint", "endpoint", "No object associated");
 	} else if (error == 0) {
+		char peer[EP_OBJ_TYPE_MAX_LEN + 24] = "";
+		const char *link;
+
 		if (strcmp(endpoint2.type, "dpsw") == 0 ||
 		    strcmp(endpoint2.type, "dpdmux") == 0) {
-			printf("endpoint: %s.%d.%d",
+			snprintf(peer, sizeof(peer), "%s.%d.%d",
 				endpoint2.type, endpoint2.id,
 				endpoint2.if_id);
 		} else if (endpoint2.if_id == 0) {
-			printf("endpoint: %s.%d",
+			snprintf(peer, sizeof(peer), "%s.%d",
 				endpoint2.type, endpoint2.id);
 		}
 
 		if (state == 1)
-			printf(", link is up\n");
+			link = "up";
 		else if (state == 0)
-			printf(", link is down\n");
+			link = "down";
 		else
-			printf(", link is in error state\n");
-
+			link = "in error state";
+
+		if (output_is_json()) {
+			output_field("endpoint", "endpoint", "%s", peer);
+			output_field("link", "link", "%s", link);
+		} else {
+			output_field("endpoint", "endpoint",
+				     "%s, link is %s", peer, link);
+		}
 	} else {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			mc_status_to_string(mc_status), mc_status);
+			mc_status_to_string(ctx->mc_status), ctx->mc_status);
 		return error;
 	}
 
@@ -203,19 +222,22 @@ static int print_dpmac_endpoint(uint32_t target_id)
 
 static void print_dpmac_link_type(enum dpmac_link_type link_type)
 {
-	printf("DPMAC link type: ");
 	switch (link_type) {
 	case DPMAC_LINK_TYPE_NONE:
-		printf("DPMAC_LINK_TYPE_NONE\n");
+		output_field("link_type", "DPMAC link type",
+			     "DPMAC_LINK_TYPE_NONE");
 		break;
 	case DPMAC_LINK_TYPE_FIXED:
-		printf("DPMAC_LINK_TYPE_FIXED\n");
+		output_field("link_type", "DPMAC link type",
+			     "DPMAC_LINK_TYPE_FIXED");
 		break;
 	case DPMAC_LINK_TYPE_PHY:
-		printf("DPMAC_LINK_TYPE_PHY\n");
+		output_field("link_type", "DPMAC link type",
+			     "DPMAC_LINK_TYPE_PHY");
 		break;
 	case DPMAC_LINK_TYPE_BACKPLANE:
-		printf("DPMAC_LINK_TYPE_BACKPLANE\n");
+		output_field("link_type", "DPMAC link type",
+			     "DPMAC_LINK_TYPE_BACKPLANE");
 		break;
 	default:
 		assert(false);
@@ -225,34 +247,42 @@ static void print_dpmac_link_type(enum dpmac_link_type link_type)
 
 static void print_dpmac_eth_if(enum dpmac_eth_if eth_if)
 {
-	printf("DPMAC ethernet interface: ");
 	switch (eth_if) {
 	case DPMAC_ETH_IF_MII:
-		printf("DPMAC_ETH_IF_MII\n");
+		output_field("eth_if", "DPMAC ethernet interface",
+			     "DPMAC_ETH_IF_MII");
 		break;
 	case DPMAC_ETH_IF_RMII:
-		printf("DPMAC_ETH_IF_RMII\n");
+		output_field("eth_if", "DPMAC ethernet interface",
+			     "DPMAC_ETH_IF_RMII");
 		break;
 	case DPMAC_ETH_IF_SMII:
-		printf("DPMAC_ETH_IF_SMII\n");
+		output_field("eth_if", "DPMAC ethernet interface",
+			     "DPMAC_ETH_IF_SMII");
 		break;
 	case DPMAC_ETH_IF_GMII:
-		printf("DPMAC_ETH_IF_GMII\n");
+		output_field("eth_if", "DPMAC ethernet interface",
+			     "DPMAC_ETH_IF_GMII");
 		break;
 	case DPMAC_ETH_IF_RGMII:
-		printf("DPMAC_ETH_IF_RGMII\n");
+		output_field("eth_if", "DPMAC ethernet interface",
+			     "DPMAC_ETH_IF_RGMII");
 		break;
 	case DPMAC_ETH_IF_SGMII:
-		printf("DPMAC_ETH_IF_SGMII\n");
+		output_field("eth_if", "DPMAC ethernet interface",
+			     "DPMAC_ETH_IF_SGMII");
 		break;
 	case DPMAC_ETH_IF_QSGMII:
-		printf("DPMAC_ETH_IF_QSGMII\n");
+		output_field("eth_if", "DPMAC ethernet interface",
+			     "DPMAC_ETH_IF_QSGMII");
 		break;
 	case DPMAC_ETH_IF_XAUI:
-		printf("DPMAC_ETH_IF_XAUI\n");
+		output_field("eth_if", "DPMAC ethernet interface",
+			     "DPMAC_ETH_IF_XAUI");
 		break;
 	case DPMAC_ETH_IF_XFI:
-		printf("DPMAC_ETH_IF_XFI\n");
+		output_field("eth_if", "DPMAC ethernet interface",
+			     "DPMAC_ETH_IF_XFI");
 		break;
 	default:
 		assert(false);
@@ -260,7 +290,7 @@ static void print_dpmac_eth_if(enum dpmac_eth_if eth_if)
 	}
 }
 
-static int print_dpmac_attr_v9(uint32_t dpmac_id,
+static int print_dpmac_attr_v9(struct restool *ctx, uint32_t dpmac_id,
 			       struct dprc_obj_desc *target_obj_desc)
 {
 	uint16_t dpmac_handle;
@@ -268,11 +298,13 @@ static int print_dpmac_attr_v9(uint32_t dpmac_id,
 	struct dpmac_attr dpmac_attr;
 	bool dpmac_opened = false;
 
-	error = dpmac_open(&restool.mc_io, 0, dpmac_id, &dpmac_handle);
+	error = dpmac_open(&ctx->mc_io, ctx->cmd_flags, dpmac_id,
+			   &dpmac_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpmac_opened = true;
@@ -285,27 +317,33 @@ static int print_dpmac_attr_v9(uint32_t dpmac_id,
 	}
 
 	memset(&dpmac_attr, 0, sizeof(dpmac_attr));
-	error = dpmac_get_attributes(&restool.mc_io, 0,
+	error = dpmac_get_attributes(&ctx->mc_io, ctx->cmd_flags,
 					dpmac_handle, &dpmac_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(dpmac_id == (uint32_t)dpmac_attr.id);
 
-	printf("dpmac version: %u.%u\n", dpmac_attr.version.major,
-	       dpmac_attr.version.minor);
-	printf("dpmac object id/portal id: %d\n", dpmac_attr.id);
-	printf("plugged state: %splugged\n",
+	output_field("version", "dpmac version",
+		     "%u.%u", dpmac_attr.version.major,
+		     dpmac_attr.version.minor);
+	output_int("id", "dpmac object id/portal id", dpmac_attr.id);
+	output_field("plugged_state", "plugged state", "%splugged",
 		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	print_dpmac_endpoint(dpmac_id);
+	print_dpmac_endpoint(ctx, dpmac_id);
 	print_dpmac_link_type(dpmac_attr.link_type);
 	print_dpmac_eth_if(dpmac_attr.eth_if);
-	printf("maximum supported rate %lu Mbps\n",
-			(unsigned long)dpmac_attr.max_rate);
-	print_obj_label(target_obj_desc);
+	if (output_is_json())
+		output_uint("max_rate", "maximum supported rate",
+			    (unsigned long)dpmac_attr.max_rate);
+	else
+		output_printf("maximum supported rate %lu Mbps\n",
+			      (unsigned long)dpmac_attr.max_rate);
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -313,11 +351,12 @@ out:
 	if (dpmac_opened) {
 		int error2;
 
-		error2 = dpmac_close(&restool.mc_io, 0, dpmac_handle);
+		error2 = dpmac_close(&ctx->mc_io, ctx->cmd_flags, dpmac_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -326,61 +365,82 @@ out:
 	return error;
 }
 
-static int print_dpmac_attr_v10(uint32_t dpmac_id,
+static int print_dpmac_attr_v10(struct restool *ctx, uint32_t dpmac_id,
 			struct dprc_obj_desc *target_obj_desc)
 {
 	struct dpmac_attr_v10 dpmac_attr;
 	uint16_t obj_major, obj_minor;
 	bool dpmac_opened = false;
 	uint16_t dpmac_handle;
-	int error;
+	int error = 0;
 
-	error = dpmac_open_v10(&restool.mc_io, 0, dpmac_id, &dpmac_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpmac_opened = true;
-	if (0 == dpmac_handle) {
-		DEBUG_PRINTF(
-			"dpmac_open() returned invalid handle (auth 0) for dpmac.%u\n",
-			dpmac_id);
-		error = -ENOENT;
-		goto out;
-	}
+	if (INFO_FIELD(ATTR)) {
+		error = dpmac_open_v10(&ctx->mc_io, ctx->cmd_flags, dpmac_id,
+				       &dpmac_handle);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		dpmac_opened = true;
+		if (0 == dpmac_handle) {
+			DEBUG_PRINTF(
+				"dpmac_open() returned invalid handle (auth 0) for dpmac.%u\n",
+				dpmac_id);
+			error = -ENOENT;
+			goto out;
+		}
 
-	memset(&dpmac_attr, 0, sizeof(dpmac_attr));
-	error = dpmac_get_attributes_v10(&restool.mc_io, 0,
-					 dpmac_handle, &dpmac_attr);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		memset(&dpmac_attr, 0, sizeof(dpmac_attr));
+		error = dpmac_get_attributes_v10(&ctx->mc_io, ctx->cmd_flags,
+						 dpmac_handle, &dpmac_attr);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		assert(dpmac_id == (uint32_t)dpmac_attr.id);
 	}
-	assert(dpmac_id == (uint32_t)dpmac_attr.id);
 
-	error = dpmac_get_api_version_v10(&restool.mc_io, 0,
-				      &obj_major, &obj_minor);
-	if (error) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+	if (INFO_FIELD(VERSION)) {
+		error = get_obj_api_version(ctx, "dpmac",
+					    dpmac_get_api_version_v10,
+					    &obj_major, &obj_minor);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		output_field("version", "dpmac version",
+			     "%u.%u", obj_major, obj_minor);
+	}
+
+	if (INFO_FIELD(ID))
+		output_int("id", "dpmac object id/portal id", dpmac_id);
+	if (INFO_FIELD(STATE))
+		output_field("plugged_state", "plugged state", "%splugged",
+			     (target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ?
+			     "" : "un");
+	/* the connection query reports both the peer and the link state */
+	if (INFO_FIELD(ENDPOINT) || INFO_FIELD(LINK))
+		print_dpmac_endpoint(ctx, dpmac_id);
+	if (INFO_FIELD(ATTR)) {
+		print_dpmac_link_type(dpmac_attr.link_type);
+		print_dpmac_eth_if(dpmac_attr.eth_if);
+		if (output_is_json())
+			output_uint("max_rate", "maximum supported rate",
+				    (unsigned long)dpmac_attr.max_rate);
+		else
+			output_printf("maximum supported rate %lu Mbps\n",
+				      (unsigned long)dpmac_attr.max_rate);
 	}
-
-	printf("dpmac version: %u.%u\n", obj_major, obj_minor);
-	printf("dpmac object id/portal id: %d\n", dpmac_attr.id);
-	printf("plugged state: %splugged\n",
-		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	print_dpmac_endpoint(dpmac_id);
-	print_dpmac_link_type(dpmac_attr.link_type);
-	print_dpmac_eth_if(dpmac_attr.eth_if);
-	printf("maximum supported rate %lu Mbps\n",
-			(unsigned long)dpmac_attr.max_rate);
-	print_obj_label(target_obj_desc);
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -388,11 +448,13 @@ out:
 	if (dpmac_opened) {
 		int error2;
 
-		error2 = dpmac_close_v10(&restool.mc_io, 0, dpmac_handle);
+		error2 = dpmac_close_v10(&ctx->mc_io, ctx->cmd_flags,
+					 dpmac_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -401,51 +463,50 @@ out:
 	return error;
 }
 
-static int print_dpmac_info(uint32_t dpmac_id, int mc_fw_version)
+static int print_dpmac_info(struct restool *ctx, uint32_t dpmac_id,
+			    int mc_fw_version)
 {
 	int error;
 	struct dprc_obj_desc target_obj_desc;
-	uint32_t target_parent_dprc_id;
-	bool found = false;
-
-	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0, dpmac_id,
-				"dpmac", &target_obj_desc,
-				&target_parent_dprc_id, &found);
+
+	error = find_info_obj_desc(ctx, dpmac_id, "dpmac",
+				   ctx->cmd_option_mask &
+				   ONE_BIT_MASK(INFO_OPT_VERBOSE),
+				   &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (strcmp(target_obj_desc.type, "dpmac")) {
-		printf("dpmac.%d does not exist\n", dpmac_id);
-		return -EINVAL;
-	}
-
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = print_dpmac_attr_v9(dpmac_id, &target_obj_desc);
+		error = print_dpmac_attr_v9(ctx, dpmac_id, &target_obj_desc);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = print_dpmac_attr_v10(dpmac_id, &target_obj_desc);
+		error = print_dpmac_attr_v10(ctx, dpmac_id, &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpmac_ops);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
+		error = print_obj_verbose(ctx, &target_obj_desc, &dpmac_ops);
 	}
 
 out:
 	return error;
 }
 
-static int info_dpmac(int mc_fw_version)
+static int info_dpmac(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
 		"Usage: restool dpmac info <dpmac-object> [--verbose]\n"
+		"                         [--fields=<field>[,<field>...]]\n"
 		"\n"
 		"OPTIONS:\n"
 		"--verbose\n"
 		"   Shows extended/verbose information about the object\n"
+		"--fields=<field>[,<field>...]\n"
+		"   Shows only the given fields and sends only the MC\n"
+		"   commands they need. <field> is one of: version, id,\n"
+		"   state, endpoint, link, mac, attr, stats, label.\n"
+		"   Requires MC firmware 10.x.\n"
 		"\n"
 		"EXAMPLE:\n"
 		"Display information about dpmac.5:\n"
@@ -455,143 +516,157 @@ static int info_dpmac(int mc_fw_version)
 	uint32_t obj_id;
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_FIELDS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_FIELDS);
+		error = parse_info_fields(ctx, 
+				ctx->cmd_option_args[INFO_OPT_FIELDS]);
+		if (error < 0)
+			goto out;
+	}
+
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpmac", &obj_id);
+	error = parse_object_name(ctx->obj_name, "dpmac", &obj_id);
 	if (error < 0)
 		goto out;
 
-	error = print_dpmac_info(obj_id, mc_fw_version);
+	error = print_dpmac_info(ctx, obj_id, mc_fw_version);
 out:
 	return error;
 }
 
-static int cmd_dpmac_info_v9(void)
+static int cmd_dpmac_info_v9(struct restool *ctx)
 {
-	return info_dpmac(MC_FW_VERSION_9);
+	return info_dpmac(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpmac_info_v10(void)
+static int cmd_dpmac_info_v10(struct restool *ctx)
 {
-	return info_dpmac(MC_FW_VERSION_10);
+	return info_dpmac(ctx, MC_FW_VERSION_10);
 }
 
-static int create_dpmac_v9(struct dpmac_cfg *dpmac_cfg)
+static int create_dpmac_v9(struct restool *ctx, struct dpmac_cfg *dpmac_cfg)
 {
 	struct dpmac_attr dpmac_attr;
 	uint16_t dpmac_handle;
 	int error;
 
-	error = dpmac_create(&restool.mc_io, 0, dpmac_cfg, &dpmac_handle);
+	error = dpmac_create(&ctx->mc_io, ctx->cmd_flags, dpmac_cfg,
+			     &dpmac_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	memset(&dpmac_attr, 0, sizeof(struct dpmac_attr));
-	error = dpmac_get_attributes(&restool.mc_io, 0, dpmac_handle,
+	error = dpmac_get_attributes(&ctx->mc_io, ctx->cmd_flags, dpmac_handle,
 					&dpmac_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
-	print_new_obj("dpmac", dpmac_attr.id, NULL);
+	print_new_obj(ctx, "dpmac", dpmac_attr.id, NULL);
 
-	error = dpmac_close(&restool.mc_io, 0, dpmac_handle);
+	error = dpmac_close(&ctx->mc_io, ctx->cmd_flags, dpmac_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	return 0;
 }
 
-static int create_dpmac_v10(struct dpmac_cfg *dpmac_cfg)
+static int create_dpmac_v10(struct restool *ctx, struct dpmac_cfg *dpmac_cfg)
 {
 	uint32_t dpmac_id, dprc_id;
 	uint16_t dprc_handle;
 	bool dprc_opened;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
+	dprc_handle = ctx->root_dprc_handle;
 	dprc_opened = false;
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
 		error = parse_object_name(
-				restool.cmd_option_args[CREATE_OPT_PARENT_DPRC],
+				ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC],
 				"dprc", &dprc_id);
 		if (error)
 			return error;
 
-		if (restool.root_dprc_id != dprc_id) {
-			error = open_dprc(dprc_id, &dprc_handle);
+		if (ctx->root_dprc_id != dprc_id) {
+			error = open_dprc(ctx, dprc_id, &dprc_handle);
 			if (error)
 				return error;
 			dprc_opened = true;
 		}
 	}
 
-	error = dpmac_create_v10(&restool.mc_io, dprc_handle, 0,
+	error = dpmac_create_v10(&ctx->mc_io, dprc_handle, ctx->cmd_flags,
 				 dpmac_cfg, &dpmac_id);
 	if (error) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	if (dprc_opened) {
-		(void)dprc_close(&restool.mc_io, 0, dprc_handle);
-		print_new_obj("dpmac", dpmac_id,
-			      restool.cmd_option_args[CREATE_OPT_PARENT_DPRC]);
+		(void)dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
+		print_new_obj(ctx, "dpmac", dpmac_id,
+			      ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC]);
 	} else {
-		print_new_obj("dpmac", dpmac_id, NULL);
+		print_new_obj(ctx, "dpmac", dpmac_id, NULL);
 	}
 
 	return 0;
 }
 
-static int create_dpmac(int mc_fw_version, const char *usage_msg)
+static int create_dpmac(struct restool *ctx, int mc_fw_version,
+			const char *usage_msg)
 {
 	int error;
 	long val;
 	struct dpmac_cfg dpmac_cfg;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name != NULL) {
+	if (ctx->obj_name != NULL) {
 		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
-			     restool.obj_name);
+			     ctx->obj_name);
 		puts(usage_msg);
 		return -EINVAL;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAC_ID)) {
-		restool.cmd_option_mask &=
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAC_ID)) {
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_MAC_ID);
-		error = get_option_value(CREATE_OPT_MAC_ID, &val,
+		error = get_option_value(ctx, CREATE_OPT_MAC_ID, &val,
 					 "Invalid option: mac-id value",
 					 0, INT32_MAX);
 		if (error)
@@ -604,16 +679,16 @@ static int create_dpmac(int mc_fw_version, const char *usage_msg)
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = create_dpmac_v9(&dpmac_cfg);
+		error = create_dpmac_v9(ctx, &dpmac_cfg);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = create_dpmac_v10(&dpmac_cfg);
+		error = create_dpmac_v10(ctx, &dpmac_cfg);
 	else
 		return -EINVAL;
 
 	return error;
 }
 
-static int cmd_dpmac_create_v9(void)
+static int cmd_dpmac_create_v9(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -627,10 +702,10 @@ static int cmd_dpmac_create_v9(void)
 		"   $ restool dpmac create --mac-id=4\n"
 		"\n";
 
-	return create_dpmac(MC_FW_VERSION_9, usage_msg);
+	return create_dpmac(ctx, MC_FW_VERSION_9, usage_msg);
 }
 
-static int cmd_dpmac_create_v10(void)
+static int cmd_dpmac_create_v10(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -650,20 +725,22 @@ static int cmd_dpmac_create_v10(void)
 		"   $ restool dpmac create --mac-id=4\n"
 		"\n";
 
-	return create_dpmac(MC_FW_VERSION_10, usage_msg);
+	return create_dpmac(ctx, MC_FW_VERSION_10, usage_msg);
 }
 
-static int destroy_dpmac_v9(uint32_t dpmac_id)
+static int destroy_dpmac_v9(struct restool *ctx, uint32_t dpmac_id)
 {
 	bool dpmac_opened = false;
 	uint16_t dpmac_handle;
 	int error, error2;
 
-	error = dpmac_open(&restool.mc_io, 0, dpmac_id, &dpmac_handle);
+	error = dpmac_open(&ctx->mc_io, ctx->cmd_flags, dpmac_id,
+			   &dpmac_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpmac_opened = true;
@@ -675,23 +752,25 @@ static int destroy_dpmac_v9(uint32_t dpmac_id)
 		goto out;
 	}
 
-	error = dpmac_destroy(&restool.mc_io, 0, dpmac_handle);
+	error = dpmac_destroy(&ctx->mc_io, ctx->cmd_flags, dpmac_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpmac_opened = false;
-	printf("dpmac.%u is destroyed\n", dpmac_id);
+	print_destroyed_obj("dpmac", dpmac_id);
 
 out:
 	if (dpmac_opened) {
-		error2 = dpmac_close(&restool.mc_io, 0, dpmac_handle);
+		error2 = dpmac_close(&ctx->mc_io, ctx->cmd_flags, dpmac_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -700,42 +779,43 @@ out:
 	return error;
 }
 
-static int destroy_dpmac_v10(uint32_t dpmac_id)
+static int destroy_dpmac_v10(struct restool *ctx, uint32_t dpmac_id)
 {
 	uint16_t dprc_handle;
 	uint32_t dprc_id;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
-	dprc_id = restool.root_dprc_id;
-	error = get_parent_dprc_id(dpmac_id, "dpmac", &dprc_id);
+	dprc_handle = ctx->root_dprc_handle;
+	dprc_id = ctx->root_dprc_id;
+	error = get_parent_dprc_id(ctx, dpmac_id, "dpmac", &dprc_id);
 	if (error)
 		return error;
 
-	if (dprc_id != restool.root_dprc_id) {
-		error = open_dprc(dprc_id, &dprc_handle);
+	if (dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, dprc_id, &dprc_handle);
 		if (error)
 			return error;
 	}
 
-	error = dpmac_destroy_v10(&restool.mc_io, dprc_handle,
-				 0, dpmac_id);
+	error = dpmac_destroy_v10(&ctx->mc_io, dprc_handle,
+				 ctx->cmd_flags, dpmac_id);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
-	printf("dpmac.%u is destroyed\n", dpmac_id);
+	print_destroyed_obj("dpmac", dpmac_id);
 
 out:
-	if (dprc_id != restool.root_dprc_id)
-		error = dprc_close(&restool.mc_io, 0, dprc_handle);
+	if (dprc_id != ctx->root_dprc_id)
+		error = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 
 	return error;
 }
 
-static int destroy_dpmac(int mc_fw_version)
+static int destroy_dpmac(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -746,37 +826,37 @@ static int destroy_dpmac(int mc_fw_version)
 	int error;
 	uint32_t dpmac_id;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	if (in_use(restool.obj_name, "destroyed")) {
+	if (in_use(ctx->obj_name, "destroyed")) {
 		error = -EBUSY;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpmac", &dpmac_id);
+	error = parse_object_name(ctx->obj_name, "dpmac", &dpmac_id);
 	if (error < 0)
 		goto out;
 
-	if (!find_obj("dpmac", dpmac_id)) {
+	if (!find_obj(ctx, "dpmac", dpmac_id)) {
 		error = -EINVAL;
 		goto out;
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = destroy_dpmac_v9(dpmac_id);
+		error = destroy_dpmac_v9(ctx, dpmac_id);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = destroy_dpmac_v10(dpmac_id);
+		error = destroy_dpmac_v10(ctx, dpmac_id);
 	else
 		return -EINVAL;
 
@@ -784,14 +864,14 @@ out:
 	return error;
 }
 
-static int cmd_dpmac_destroy_v9(void)
+static int cmd_dpmac_destroy_v9(struct restool *ctx)
 {
-	return destroy_dpmac(MC_FW_VERSION_9);
+	return destroy_dpmac(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpmac_destroy_v10(void)
+static int cmd_dpmac_destroy_v10(struct restool *ctx)
 {
-	return destroy_dpmac(MC_FW_VERSION_10);
+	return destroy_dpmac(ctx, MC_FW_VERSION_10);
 }
 
 struct object_command dpmac_commands_v9[] = {
@@ -809,7 +889,8 @@ struct object_command dpmac_commands_v9[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpmac_destroy_options,
-	  .cmd_func = cmd_dpmac_destroy_v9 },
+	  .cmd_func = cmd_dpmac_destroy_v9,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -829,7 +910,8 @@ struct object_command dpmac_commands_v10[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpmac_destroy_options,
-	  .cmd_func = cmd_dpmac_destroy_v10 },
+	  .cmd_func = cmd_dpmac_destroy_v10,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -49,6 +49,7 @@
 enum dpmcp_info_options {
 	INFO_OPT_HELP = 0,
 	INFO_OPT_VERBOSE,
+	INFO_OPT_FIELDS,
 };
 
 static struct option dpmcp_info_options[] = {
@@ -66,6 +67,13 @@ static struct option dpmcp_info_options[] = {
 		.val = 0,
 	},
 
+	[INFO_OPT_FIELDS] = {
+		.name = "fields",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
 	{ 0 },
 };
 
@@ -126,7 +134,7 @@ static const struct flib_ops dpmcp_ops = {
 	.obj_get_irq_status = dpmcp_get_irq_status,
 };
 
-static int cmd_dpmcp_help(void)
+static int cmd_dpmcp_help(struct restool *ctx)
 {
 	static const char help_msg[] =
 		"\n"
@@ -139,11 +147,12 @@ static int cmd_dpmcp_help(void)
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
 
+	(void)ctx;
 	printf(help_msg);
 	return 0;
 }
 
-static int print_dpmcp_attr_v9(uint32_t dpmcp_id,
+static int print_dpmcp_attr_v9(struct restool *ctx, uint32_t dpmcp_id,
 			       struct dprc_obj_desc *target_obj_desc)
 {
 	uint16_t dpmcp_handle;
@@ -151,11 +160,13 @@ static int print_dpmcp_attr_v9(uint32_t dpmcp_id,
 	struct dpmcp_attr dpmcp_attr;
 	bool dpmcp_opened = false;
 
-	error = dpmcp_open(&restool.mc_io, 0, dpmcp_id, &dpmcp_handle);
+	error = dpmcp_open(&ctx->mc_io, ctx->cmd_flags, dpmcp_id,
+			   &dpmcp_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpmcp_opened = true;
@@ -168,22 +179,24 @@ static int print_dpmcp_attr_v9(uint32_t dpmcp_id,
 	}
 
 	memset(&dpmcp_attr, 0, sizeof(dpmcp_attr));
-	error = dpmcp_get_attributes(&restool.mc_io, 0, dpmcp_handle,
+	error = dpmcp_get_attributes(&ctx->mc_io, ctx->cmd_flags, dpmcp_handle,
 					&dpmcp_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(dpmcp_id == (uint32_t)dpmcp_attr.id);
 
-	printf("dpmcp version: %u.%u\n", dpmcp_attr.version.major,
-	       dpmcp_attr.version.minor);
-	printf("dpmcp object id/portal id: %d\n", dpmcp_attr.id);
-	printf("plugged state: %splugged\n",
+	output_field("version", "dpmcp version",
+		     "%u.%u", dpmcp_attr.version.major,
+		     dpmcp_attr.version.minor);
+	output_int("id", "dpmcp object id/portal id", dpmcp_attr.id);
+	output_field("plugged_state", "plugged state", "%splugged",
 		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	print_obj_label(target_obj_desc);
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -191,11 +204,12 @@ out:
 	if (dpmcp_opened) {
 		int error2;
 
-		error2 = dpmcp_close(&restool.mc_io, 0, dpmcp_handle);
+		error2 = dpmcp_close(&ctx->mc_io, ctx->cmd_flags, dpmcp_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -204,56 +218,68 @@ out:
 	return error;
 }
 
-static int print_dpmcp_attr_v10(uint32_t dpmcp_id,
-			struct dprc_obj_desc *target_obj_desc)
+static int print_dpmcp_attr_v10(struct restool *ctx, uint32_t dpmcp_id,
+				struct dprc_obj_desc *target_obj_desc)
 {
 	struct dpmcp_attr_v10 dpmcp_attr;
 	uint16_t obj_major, obj_minor;
 	bool dpmcp_opened = false;
 	uint16_t dpmcp_handle;
-	int error;
+	int error = 0;
 
-	error = dpmcp_open_v10(&restool.mc_io, 0, dpmcp_id, &dpmcp_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpmcp_opened = true;
-	if (0 == dpmcp_handle) {
-		DEBUG_PRINTF(
-			"dpmcp_open() returned invalid handle (auth 0) for dpmcp.%u\n",
-			dpmcp_id);
-		error = -ENOENT;
-		goto out;
-	}
+	if (INFO_FIELD(ATTR)) {
+		error = dpmcp_open_v10(&ctx->mc_io, ctx->cmd_flags, dpmcp_id,
+				       &dpmcp_handle);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		dpmcp_opened = true;
+		if (0 == dpmcp_handle) {
+			DEBUG_PRINTF(
+				"dpmcp_open() returned invalid handle (auth 0) for dpmcp.%u\n",
+				dpmcp_id);
+			error = -ENOENT;
+			goto out;
+		}
 
-	memset(&dpmcp_attr, 0, sizeof(dpmcp_attr));
-	error = dpmcp_get_attributes_v10(&restool.mc_io, 0, dpmcp_handle,
-					&dpmcp_attr);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		memset(&dpmcp_attr, 0, sizeof(dpmcp_attr));
+		error = dpmcp_get_attributes_v10(&ctx->mc_io, ctx->cmd_flags,
+						 dpmcp_handle, &dpmcp_attr);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		assert(dpmcp_id == (uint32_t)dpmcp_attr.id);
 	}
-	assert(dpmcp_id == (uint32_t)dpmcp_attr.id);
 
-	error = dpmcp_get_api_version_v10(&restool.mc_io, 0,
-				      &obj_major, &obj_minor);
-	if (error) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+	if (INFO_FIELD(VERSION)) {
+		error = get_obj_api_version(ctx, "dpmcp",
+					    dpmcp_get_api_version_v10,
+					    &obj_major, &obj_minor);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		output_field("version", "dpmcp version",
+			     "%u.%u", obj_major, obj_minor);
 	}
 
-	printf("dpmcp version: %u.%u\n", obj_major, obj_minor);
-	printf("dpmcp object id/portal id: %d\n", dpmcp_attr.id);
-	printf("plugged state: %splugged\n",
-		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	print_obj_label(target_obj_desc);
+	output_int("id", "dpmcp object id/portal id", dpmcp_attr.id);
+	if (INFO_FIELD(STATE))
+		output_field("plugged_state", "plugged state", "%splugged",
+			     (target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ?
+			     "" : "un");
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -261,11 +287,13 @@ out:
 	if (dpmcp_opened) {
 		int error2;
 
-		error2 = dpmcp_close_v10(&restool.mc_io, 0, dpmcp_handle);
+		error2 = dpmcp_close_v10(&ctx->mc_io, ctx->cmd_flags,
+					 dpmcp_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -274,51 +302,50 @@ out:
 	return error;
 }
 
-static int print_dpmcp_info(uint32_t dpmcp_id, int mc_fw_version)
+static int print_dpmcp_info(struct restool *ctx, uint32_t dpmcp_id,
+			    int mc_fw_version)
 {
 	int error;
 	struct dprc_obj_desc target_obj_desc;
-	uint32_t target_parent_dprc_id;
-	bool found = false;
-
-	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0, dpmcp_id,
-				"dpmcp", &target_obj_desc,
-				&target_parent_dprc_id, &found);
+
+	error = find_info_obj_desc(ctx, dpmcp_id, "dpmcp",
+				   ctx->cmd_option_mask &
+				   ONE_BIT_MASK(INFO_OPT_VERBOSE),
+				   &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (strcmp(target_obj_desc.type, "dpmcp")) {
-		printf("dpmcp.%d does not exist\n", dpmcp_id);
-		return -EINVAL;
-	}
-
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = print_dpmcp_attr_v9(dpmcp_id, &target_obj_desc);
+		error = print_dpmcp_attr_v9(ctx, dpmcp_id, &target_obj_desc);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = print_dpmcp_attr_v10(dpmcp_id, &target_obj_desc);
+		error = print_dpmcp_attr_v10(ctx, dpmcp_id, &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpmcp_ops);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
+		error = print_obj_verbose(ctx, &target_obj_desc, &dpmcp_ops);
 	}
 
 out:
 	return error;
 }
 
-static int info_dpmcp(int mc_fw_version)
+static int info_dpmcp(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 	"\n"
 		"Usage: restool dpmcp info <dpmcp-object> [--verbose]\n"
+		"                         [--fields=<field>[,<field>...]]\n"
 		"\n"
 		"OPTIONS:\n"
 		"--verbose\n"
 		"   Shows extended/verbose information about the object\n"
+		"--fields=<field>[,<field>...]\n"
+		"   Shows only the given fields and sends only the MC\n"
+		"   commands they need. <field> is one of: version, id,\n"
+		"   state, endpoint, link, mac, attr, stats, label.\n"
+		"   Requires MC firmware 10.x.\n"
 		"\n"
 		"EXAMPLE:\n"
 		"Display information about dpmcp.5:\n"
@@ -328,134 +355,148 @@ static int info_dpmcp(int mc_fw_version)
 	uint32_t obj_id;
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_FIELDS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_FIELDS);
+		error = parse_info_fields(ctx, 
+				ctx->cmd_option_args[INFO_OPT_FIELDS]);
+		if (error < 0)
+			goto out;
+	}
+
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpmcp", &obj_id);
+	error = parse_object_name(ctx->obj_name, "dpmcp", &obj_id);
 	if (error < 0)
 		goto out;
 
-	error = print_dpmcp_info(obj_id, mc_fw_version);
+	error = print_dpmcp_info(ctx, obj_id, mc_fw_version);
 out:
 	return error;
 }
 
-static int cmd_dpmcp_info_v9(void)
+static int cmd_dpmcp_info_v9(struct restool *ctx)
 {
-	return info_dpmcp(MC_FW_VERSION_9);
+	return info_dpmcp(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpmcp_info_v10(void)
+static int cmd_dpmcp_info_v10(struct restool *ctx)
 {
-	return info_dpmcp(MC_FW_VERSION_10);
+	return info_dpmcp(ctx, MC_FW_VERSION_10);
 }
 
-static int create_dpmcp_v9(struct dpmcp_cfg *dpmcp_cfg)
+static int create_dpmcp_v9(struct restool *ctx, struct dpmcp_cfg *dpmcp_cfg)
 {
 	struct dpmcp_attr dpmcp_attr;
 	uint16_t dpmcp_handle;
 	int error;
 
-	error = dpmcp_create(&restool.mc_io, 0, dpmcp_cfg, &dpmcp_handle);
+	error = dpmcp_create(&ctx->mc_io, ctx->cmd_flags, dpmcp_cfg,
+			     &dpmcp_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	memset(&dpmcp_attr, 0, sizeof(struct dpmcp_attr));
-	error = dpmcp_get_attributes(&restool.mc_io, 0, dpmcp_handle,
+	error = dpmcp_get_attributes(&ctx->mc_io, ctx->cmd_flags, dpmcp_handle,
 					&dpmcp_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
-	print_new_obj("dpmcp", dpmcp_attr.id, NULL);
+	print_new_obj(ctx, "dpmcp", dpmcp_attr.id, NULL);
 
-	error = dpmcp_close(&restool.mc_io, 0, dpmcp_handle);
+	error = dpmcp_close(&ctx->mc_io, ctx->cmd_flags, dpmcp_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	return 0;
 }
 
-static int create_dpmcp_v10(struct dpmcp_cfg *dpmcp_cfg)
+static int create_dpmcp_v10(struct restool *ctx, struct dpmcp_cfg *dpmcp_cfg)
 {
 	uint32_t dpmcp_id, dprc_id;
 	uint16_t dprc_handle;
 	bool dprc_opened;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
+	dprc_handle = ctx->root_dprc_handle;
 	dprc_opened = false;
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
 		error = parse_object_name(
-				restool.cmd_option_args[CREATE_OPT_PARENT_DPRC],
+				ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC],
 				"dprc", &dprc_id);
 		if (error)
 			return error;
 
-		if (restool.root_dprc_id != dprc_id) {
-			error = open_dprc(dprc_id, &dprc_handle);
+		if (ctx->root_dprc_id != dprc_id) {
+			error = open_dprc(ctx, dprc_id, &dprc_handle);
 			if (error)
 				return error;
 			dprc_opened = true;
 		}
 	}
 
-	error = dpmcp_create_v10(&restool.mc_io, dprc_handle, 0,
+	error = dpmcp_create_v10(&ctx->mc_io, dprc_handle, ctx->cmd_flags,
 				 dpmcp_cfg, &dpmcp_id);
 	if (error) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	if (dprc_opened) {
-		(void)dprc_close(&restool.mc_io, 0, dprc_handle);
-		print_new_obj("dpmcp", dpmcp_id,
-			      restool.cmd_option_args[CREATE_OPT_PARENT_DPRC]);
+		(void)dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
+		print_new_obj(ctx, "dpmcp", dpmcp_id,
+			      ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC]);
 	} else {
-		print_new_obj("dpmcp", dpmcp_id, NULL);
+		print_new_obj(ctx, "dpmcp", dpmcp_id, NULL);
 	}
 
 	return 0;
 }
 
-static int create_dpmcp(int mc_fw_version, const char *usage_msg)
+static int create_dpmcp(struct restool *ctx, int mc_fw_version,
+			const char *usage_msg)
 {
 	struct dpmcp_cfg dpmcp_cfg = {0};
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name != NULL) {
+	if (ctx->obj_name != NULL) {
 		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
-			     restool.obj_name);
+			     ctx->obj_name);
 		puts(usage_msg);
 		return -EINVAL;
 	}
@@ -463,26 +504,26 @@ static int create_dpmcp(int mc_fw_version, const char *usage_msg)
 	dpmcp_cfg.portal_id = DPMCP_GET_PORTAL_ID_FROM_POOL;
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = create_dpmcp_v9(&dpmcp_cfg);
+		error = create_dpmcp_v9(ctx, &dpmcp_cfg);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = create_dpmcp_v10(&dpmcp_cfg);
+		error = create_dpmcp_v10(ctx, &dpmcp_cfg);
 	else
 		return -EINVAL;
 
 	return error;
 }
 
-static int cmd_dpmcp_create_v9(void)
+static int cmd_dpmcp_create_v9(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
 		"Usage: restool dpmcp create\n"
 		"\n";
 
-	return create_dpmcp(MC_FW_VERSION_9, usage_msg);
+	return create_dpmcp(ctx, MC_FW_VERSION_9, usage_msg);
 }
 
-static int cmd_dpmcp_create_v10(void)
+static int cmd_dpmcp_create_v10(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -495,20 +536,22 @@ static int cmd_dpmcp_create_v10(void)
 		"   If it is not specified, the new object will be created under the default dprc.\n"
 		"\n";
 
-	return create_dpmcp(MC_FW_VERSION_10, usage_msg);
+	return create_dpmcp(ctx, MC_FW_VERSION_10, usage_msg);
 }
 
-static int destroy_dpmcp_v9(uint32_t dpmcp_id)
+static int destroy_dpmcp_v9(struct restool *ctx, uint32_t dpmcp_id)
 {
 	bool dpmcp_opened = false;
 	uint16_t dpmcp_handle;
 	int error, error2;
 
-	error = dpmcp_open(&restool.mc_io, 0, dpmcp_id, &dpmcp_handle);
+	error = dpmcp_open(&ctx->mc_io, ctx->cmd_flags, dpmcp_id,
+			   &dpmcp_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out_v9;
 	}
 	dpmcp_opened = true;
@@ -520,23 +563,25 @@ static int destroy_dpmcp_v9(uint32_t dpmcp_id)
 		goto out_v9;
 	}
 
-	error = dpmcp_destroy(&restool.mc_io, 0, dpmcp_handle);
+	error = dpmcp_destroy(&ctx->mc_io, ctx->cmd_flags, dpmcp_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out_v9;
 	}
 	dpmcp_opened = false;
-	printf("dpmcp.%u is destroyed\n", dpmcp_id);
+	print_destroyed_obj("dpmcp", dpmcp_id);
 
 out_v9:
 	if (dpmcp_opened) {
-		error2 = dpmcp_close(&restool.mc_io, 0, dpmcp_handle);
+		error2 = dpmcp_close(&ctx->mc_io, ctx->cmd_flags, dpmcp_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -545,42 +590,43 @@ out_v9:
 	return error;
 }
 
-static int destroy_dpmcp_v10(uint32_t dpmcp_id)
+static int destroy_dpmcp_v10(struct restool *ctx, uint32_t dpmcp_id)
 {
 	uint16_t dprc_handle;
 	uint32_t dprc_id;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
-	dprc_id = restool.root_dprc_id;
-	error = get_parent_dprc_id(dpmcp_id, "dpmcp", &dprc_id);
+	dprc_handle = ctx->root_dprc_handle;
+	dprc_id = ctx->root_dprc_id;
+	error = get_parent_dprc_id(ctx, dpmcp_id, "dpmcp", &dprc_id);
 	if (error)
 		return error;
 
-	if (dprc_id != restool.root_dprc_id) {
-		error = open_dprc(dprc_id, &dprc_handle);
+	if (dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, dprc_id, &dprc_handle);
 		if (error)
 			return error;
 	}
 
-	error = dpmcp_destroy_v10(&restool.mc_io, dprc_handle,
-				 0, dpmcp_id);
+	error = dpmcp_destroy_v10(&ctx->mc_io, dprc_handle,
+				 ctx->cmd_flags, dpmcp_id);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
-	printf("dpmcp.%u is destroyed\n", dpmcp_id);
+	print_destroyed_obj("dpmcp", dpmcp_id);
 
 out:
-	if (dprc_id != restool.root_dprc_id)
-		error = dprc_close(&restool.mc_io, 0, dprc_handle);
+	if (dprc_id != ctx->root_dprc_id)
+		error = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 
 	return error;
 }
 
-static int destroy_dpmcp(int mc_fw_version)
+static int destroy_dpmcp(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -591,37 +637,37 @@ static int destroy_dpmcp(int mc_fw_version)
 	int error;
 	uint32_t dpmcp_id;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	if (in_use(restool.obj_name, "destroyed")) {
+	if (in_use(ctx->obj_name, "destroyed")) {
 		error = -EBUSY;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpmcp", &dpmcp_id);
+	error = parse_object_name(ctx->obj_name, "dpmcp", &dpmcp_id);
 	if (error < 0)
 		goto out;
 
-	if (!find_obj("dpmcp", dpmcp_id)) {
+	if (!find_obj(ctx, "dpmcp", dpmcp_id)) {
 		error = -EINVAL;
 		goto out;
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = destroy_dpmcp_v9(dpmcp_id);
+		error = destroy_dpmcp_v9(ctx, dpmcp_id);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = destroy_dpmcp_v10(dpmcp_id);
+		error = destroy_dpmcp_v10(ctx, dpmcp_id);
 	else
 		return -EINVAL;
 
@@ -629,14 +675,14 @@ out:
 	return error;
 }
 
-static int cmd_dpmcp_destroy_v9(void)
+static int cmd_dpmcp_destroy_v9(struct restool *ctx)
 {
-	return destroy_dpmcp(MC_FW_VERSION_9);
+	return destroy_dpmcp(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpmcp_destroy_v10(void)
+static int cmd_dpmcp_destroy_v10(struct restool *ctx)
 {
-	return destroy_dpmcp(MC_FW_VERSION_10);
+	return destroy_dpmcp(ctx, MC_FW_VERSION_10);
 }
 
 struct object_command dpmcp_commands_v9[] = {
@@ -654,7 +700,8 @@ struct object_command dpmcp_commands_v9[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpmcp_destroy_options,
-	  .cmd_func = cmd_dpmcp_destroy_v9 },
+	  .cmd_func = cmd_dpmcp_destroy_v9,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -674,7 +721,8 @@ struct object_command dpmcp_commands_v10[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpmcp_destroy_options,
-	  .cmd_func = cmd_dpmcp_destroy_v10 },
+	  .cmd_func = cmd_dpmcp_destroy_v10,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -38,8 +38,10 @@
 #include <assert.h>
 #include <getopt.h>
 #include <sys/ioctl.h>
+#include <sys/stat.h>
 #include "restool.h"
 #include "utils.h"
+#include "dpkg_key.h"
 #include "mc_v9/fsl_dpni.h"
 #include "mc_v10/fsl_dpni.h"
 
@@ -76,6 +78,11 @@
  */
 #define MAX_DIST_SIZE	1024
 
+static const uint16_t dist_sizes[] = {
+	1, 2, 3, 4, 6, 7, 8, 12, 14, 16, 24, 28, 32, 48, 56, 64, 96,
+	112, 128, 192, 224, 256, 384, 448, 512, 768, 896, 1024
+};
+
 struct dpni_config {
 	struct dpni_extended_cfg dpni_extended_cfg;
 	struct dpni_cfg_v9 dpni_cfg;
@@ -95,6 +102,7 @@ struct dpni_config {
 enum dpni_info_options {
 	INFO_OPT_HELP = 0,
 	INFO_OPT_VERBOSE,
+	INFO_OPT_FIELDS,
 };
 
 static struct option dpni_info_options[] = {
@@ -112,6 +120,13 @@ static struct option dpni_info_options[] = {
 		.val = 0,
 	},
 
+	[INFO_OPT_FIELDS] = {
+		.name = "fields",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
 	{ 0 },
 };
 
@@ -350,1522 +365,5493 @@ static struct option dpni_update_options_v10[] = {
 
 C_ASSERT(ARRAY_SIZE(dpni_update_options_v10) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-static const struct flib_ops dpni_ops = {
-	.obj_open = dpni_open,
-	.obj_close = dpni_close,
-	.obj_get_irq_mask = dpni_get_irq_mask,
-	.obj_get_irq_status = dpni_get_irq_status,
+/**
+ * dpni set-rx-dist command options
+ */
+enum dpni_set_rx_dist_options {
+	SET_RX_DIST_OPT_HELP = 0,
+	SET_RX_DIST_OPT_TC,
+	SET_RX_DIST_OPT_DIST_SIZE,
+	SET_RX_DIST_OPT_HASH_KEY,
+	SET_RX_DIST_OPT_FS_KEY,
+	SET_RX_DIST_OPT_MISS,
 };
 
-static struct option_entry options_map_v9[] = {
-	OPTION_MAP_ENTRY(DPNI_OPT_ALLOW_DIST_KEY_PER_TC),
-	OPTION_MAP_ENTRY(DPNI_OPT_TX_CONF_DISABLED),
-	OPTION_MAP_ENTRY(DPNI_OPT_PRIVATE_TX_CONF_ERROR_DISABLED),
-	OPTION_MAP_ENTRY(DPNI_OPT_DIST_HASH),
-	OPTION_MAP_ENTRY(DPNI_OPT_DIST_FS),
-	OPTION_MAP_ENTRY(DPNI_OPT_UNICAST_FILTER),
-	OPTION_MAP_ENTRY(DPNI_OPT_MULTICAST_FILTER),
-	OPTION_MAP_ENTRY(DPNI_OPT_VLAN_FILTER),
-	OPTION_MAP_ENTRY(DPNI_OPT_IPR),
-	OPTION_MAP_ENTRY(DPNI_OPT_IPF),
-	OPTION_MAP_ENTRY(DPNI_OPT_VLAN_MANIPULATION),
-	OPTION_MAP_ENTRY(DPNI_OPT_QOS_MASK_SUPPORT),
-	OPTION_MAP_ENTRY(DPNI_OPT_FS_MASK_SUPPORT),
-};
-static unsigned int options_num_v9 = ARRAY_SIZE(options_map_v9);
+static struct option dpni_set_rx_dist_options[] = {
+	[SET_RX_DIST_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
 
-static struct option_entry options_map_v10_0[] = {
-	OPTION_MAP_ENTRY(DPNI_OPT_TX_FRM_RELEASE),
-	OPTION_MAP_ENTRY(DPNI_OPT_NO_MAC_FILTER),
-	OPTION_MAP_ENTRY(DPNI_OPT_HAS_POLICING),
-	OPTION_MAP_ENTRY(DPNI_OPT_SHARED_CONGESTION),
-	OPTION_MAP_ENTRY(DPNI_OPT_HAS_KEY_MASKING),
-	OPTION_MAP_ENTRY(DPNI_OPT_NO_FS),
-};
-static unsigned int options_num_v10_0 = ARRAY_SIZE(options_map_v10_0);
+	[SET_RX_DIST_OPT_TC] = {
+		.name = "tc",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
 
-static struct option_entry options_map_v10_1[] = {
-	OPTION_MAP_ENTRY(DPNI_OPT_TX_FRM_RELEASE),
-	OPTION_MAP_ENTRY(DPNI_OPT_NO_MAC_FILTER),
-	OPTION_MAP_ENTRY(DPNI_OPT_HAS_POLICING),
-	OPTION_MAP_ENTRY(DPNI_OPT_SHARED_CONGESTION),
-	OPTION_MAP_ENTRY(DPNI_OPT_HAS_KEY_MASKING),
-	OPTION_MAP_ENTRY(DPNI_OPT_NO_FS),
-	OPTION_MAP_ENTRY(DPNI_OPT_HAS_OPR),
-	OPTION_MAP_ENTRY(DPNI_OPT_OPR_PER_TC),
-	OPTION_MAP_ENTRY(DPNI_OPT_SINGLE_SENDER),
-};
-static unsigned int options_num_v10_1 = ARRAY_SIZE(options_map_v10_1);
+	[SET_RX_DIST_OPT_DIST_SIZE] = {
+		.name = "dist-size",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
 
-#define DPNI_STATS_PER_PAGE_V10 6
+	[SET_RX_DIST_OPT_HASH_KEY] = {
+		.name = "hash-key",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
 
-static const char *dpni_stats_v10[][DPNI_STATS_PER_PAGE_V10] = {
-	{
-	"ingress_all_frames",
-	"ingress_all_bytes",
-	"ingress_multicast_frames",
-	"ingress_multicast_bytes",
-	"ingress_broadcast_frames",
-	"ingress_broadcast_bytes",
-	}, {
-	"egress_all_frames",
-	"egress_all_bytes",
-	"egress_multicast_frames",
-	"egress_multicast_bytes",
-	"egress_broadcast_frames",
-	"egress_broadcast_bytes",
-	}, {
-	"ingress_filtered_frames",
-	"ingress_discarded_frames",
-	"ingress_nobuffer_discards",
-	"egress_discarded_frames",
-	"egress_confirmed_frames",
-	""
+	[SET_RX_DIST_OPT_FS_KEY] = {
+		.name = "fs-key",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
 	},
-};
 
-static int cmd_dpni_help(void)
-{
-	static const char help_msg[] =
-		"\n"
-		"Usage: restool dpni <command> [--help] [ARGS...]\n"
-		"Where <command> can be:\n"
-		"   info - displays detailed information about a DPNI object.\n"
-		"   create - creates a new child DPNI under the root DPRC.\n"
-		"   destroy - destroys a child DPNI under the root DPRC.\n"
-		"\n"
-		"For command-specific help, use the --help option of each command.\n"
-		"\n";
+	[SET_RX_DIST_OPT_MISS] = {
+		.name = "miss-queue",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
 
-	printf(help_msg);
-	return 0;
-}
+	{ 0 },
+};
 
-static int cmd_dpni_help_v10(void)
-{
-	static const char help_msg[] =
-		"\n"
-		"Usage: restool dpni <command> [--help] [ARGS...]\n"
-		"Where <command> can be:\n"
-		"   info - displays detailed information about a DPNI object.\n"
-		"   create - creates a new child DPNI under the root DPRC.\n"
-		"   destroy - destroys a child DPNI under the root DPRC.\n"
-		"   update - update attributes of already created DPNI.\n"
-		"\n"
-		"For command-specific help, use the --help option of each command.\n"
-		"\n";
+C_ASSERT(ARRAY_SIZE(dpni_set_rx_dist_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-	printf(help_msg);
-	return 0;
-}
+/**
+ * dpni fs-add, fs-del and fs-clear command options
+ */
+enum dpni_fs_options {
+	FS_OPT_HELP = 0,
+	FS_OPT_TC,
+	FS_OPT_KEY,
+	FS_OPT_RULE,
+	FS_OPT_QUEUE,
+	FS_OPT_INDEX,
+};
 
-static void print_dpni_options(uint32_t options)
-{
-	if ((options & ~ALL_DPNI_OPTS) != 0) {
-		printf("\tUnrecognized options found...\n");
-		return;
-	}
+static struct option dpni_fs_add_options[] = {
+	[FS_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
 
-	if (options & DPNI_OPT_ALLOW_DIST_KEY_PER_TC)
-		printf("\tDPNI_OPT_ALLOW_DIST_KEY_PER_TC\n");
+	[FS_OPT_TC] = {
+		.name = "tc",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
 
-	if (options & DPNI_OPT_TX_CONF_DISABLED)
-		printf("\tDPNI_OPT_TX_CONF_DISABLED\n");
+	[FS_OPT_KEY] = {
+		.name = "key",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
 
-	if (options & DPNI_OPT_PRIVATE_TX_CONF_ERROR_DISABLED)
-		printf("\tDPNI_OPT_PRIVATE_TX_CONF_ERROR_DISABLED\n");
+	[FS_OPT_RULE] = {
+		.name = "rule",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
 
-	if (options & DPNI_OPT_DIST_HASH)
-		printf("\tDPNI_OPT_DIST_HASH\n");
+	[FS_OPT_QUEUE] = {
+		.name = "queue",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
 
-	if (options & DPNI_OPT_DIST_FS)
-		printf("\tDPNI_OPT_DIST_FS\n");
+	[FS_OPT_INDEX] = {
+		.name = "index",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
 
-	if (options & DPNI_OPT_UNICAST_FILTER)
-		printf("\tDPNI_OPT_UNICAST_FILTER\n");
+	{ 0 },
+};
 
-	if (options & DPNI_OPT_MULTICAST_FILTER)
-		printf("\tDPNI_OPT_MULTICAST_FILTER\n");
+C_ASSERT(ARRAY_SIZE(dpni_fs_add_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-	if (options & DPNI_OPT_VLAN_FILTER)
-		printf("\tDPNI_OPT_VLAN_FILTER\n");
+static struct option dpni_fs_del_options[] = {
+	[FS_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
 
-	if (options & DPNI_OPT_IPR)
-		printf("\tDPNI_OPT_IPR\n");
+	[FS_OPT_TC] = {
+		.name = "tc",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
 
-	if (options & DPNI_OPT_IPF)
-		printf("\tDPNI_OPT_IPF\n");
+	[FS_OPT_KEY] = {
+		.name = "key",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
 
-	if (options & DPNI_OPT_VLAN_MANIPULATION)
-		printf("\tDPNI_OPT_VLAN_MANIPULATION\n");
+	[FS_OPT_RULE] = {
+		.name = "rule",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
 
-	if (options & DPNI_OPT_QOS_MASK_SUPPORT)
-		printf("\tDPNI_OPT_QOS_MASK_SUPPORT\n");
+	{ 0 },
+};
 
-	if (options & DPNI_OPT_FS_MASK_SUPPORT)
-		printf("\tDPNI_OPT_FS_MASK_SUPPORT\n");
-}
+C_ASSERT(ARRAY_SIZE(dpni_fs_del_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-static void print_dpni_options_v10(uint32_t options)
-{
-	if ((options & ~ALL_DPNI_OPTS_V10) != 0) {
-		printf("\tUnrecognized options found...\n");
-		return;
-	}
+static struct option dpni_fs_clear_options[] = {
+	[FS_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
 
-	if (options & DPNI_OPT_TX_FRM_RELEASE)
-		printf("\tDPNI_OPT_TX_FRM_RELEASE\n");
+	[FS_OPT_TC] = {
+		.name = "tc",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
 
-	if (options & DPNI_OPT_NO_MAC_FILTER)
-		printf("\tDPNI_OPT_NO_MAC_FILTER\n");
+	{ 0 },
+};
 
-	if (options & DPNI_OPT_HAS_POLICING)
-		printf("\tDPNI_OPT_HAS_POLICING\n");
+C_ASSERT(ARRAY_SIZE(dpni_fs_clear_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-	if (options & DPNI_OPT_SHARED_CONGESTION)
-		printf("\tDPNI_OPT_SHARED_CONGESTION\n");
+/**
+ * dpni fs-load command options, TC and KEY at the indexes of the other fs
+ * commands
+ */
+enum dpni_fs_load_options {
+	FS_LOAD_OPT_HELP = 0,
+	FS_LOAD_OPT_TC,
+	FS_LOAD_OPT_KEY,
+	FS_LOAD_OPT_FILE,
+};
 
-	if (options & DPNI_OPT_HAS_KEY_MASKING)
-		printf("\tDPNI_OPT_HAS_KEY_MASKING\n");
+C_ASSERT((int)FS_LOAD_OPT_TC == (int)FS_OPT_TC &&
+	 (int)FS_LOAD_OPT_KEY == (int)FS_OPT_KEY);
 
-	if (options & DPNI_OPT_NO_FS)
-		printf("\tDPNI_OPT_NO_FS\n");
+static struct option dpni_fs_load_options[] = {
+	[FS_LOAD_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
 
-	if (options & DPNI_OPT_HAS_OPR)
-		printf("\tDPNI_OPT_HAS_OPR\n");
+	[FS_LOAD_OPT_TC] = {
+		.name = "tc",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
 
-	if (options & DPNI_OPT_OPR_PER_TC)
-		printf("\tDPNI_OPT_OPR_PER_TC\n");
+	[FS_LOAD_OPT_KEY] = {
+		.name = "key",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
 
-	if (options & DPNI_OPT_SINGLE_SENDER)
-		printf("\tDPNI_OPT_SINGLE_SENDER\n");
-}
+	[FS_LOAD_OPT_FILE] = {
+		.name = "file",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
 
-static int print_dpni_endpoint(uint32_t target_id)
-{
-	struct dprc_endpoint endpoint1;
-	struct dprc_endpoint endpoint2;
-	int state;
-	int error = 0;
+	{ 0 },
+};
 
-	memset(&endpoint1, 0, sizeof(struct dprc_endpoint));
-	memset(&endpoint2, 0, sizeof(struct dprc_endpoint));
+C_ASSERT(ARRAY_SIZE(dpni_fs_load_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-	strncpy(endpoint1.type, "dpni", EP_OBJ_TYPE_MAX_LEN);
-	endpoint1.type[EP_OBJ_TYPE_MAX_LEN] = '\0';
-	endpoint1.id = target_id;
+/**
+ * dpni set-pools command options
+ */
+enum dpni_set_pools_options {
+	SET_POOLS_OPT_HELP = 0,
+	SET_POOLS_OPT_DPBP,
+};
+
+static struct option dpni_set_pools_options[] = {
+	[SET_POOLS_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[SET_POOLS_OPT_DPBP] = {
+		.name = "dpbp",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_set_pools_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpni set-buffer-layout command options
+ */
+enum dpni_set_buffer_layout_options {
+	SET_BUF_LAYOUT_OPT_HELP = 0,
+	SET_BUF_LAYOUT_OPT_QUEUE,
+	SET_BUF_LAYOUT_OPT_HEADROOM,
+	SET_BUF_LAYOUT_OPT_DATA_ALIGN,
+	SET_BUF_LAYOUT_OPT_TIMESTAMP,
+	SET_BUF_LAYOUT_OPT_PARSER_RESULT,
+	SET_BUF_LAYOUT_OPT_FRAME_STATUS,
+};
+
+static struct option dpni_set_buffer_layout_options[] = {
+	[SET_BUF_LAYOUT_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[SET_BUF_LAYOUT_OPT_QUEUE] = {
+		.name = "queue",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[SET_BUF_LAYOUT_OPT_HEADROOM] = {
+		.name = "headroom",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[SET_BUF_LAYOUT_OPT_DATA_ALIGN] = {
+		.name = "data-align",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[SET_BUF_LAYOUT_OPT_TIMESTAMP] = {
+		.name = "pass-timestamp",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[SET_BUF_LAYOUT_OPT_PARSER_RESULT] = {
+		.name = "pass-parser-result",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[SET_BUF_LAYOUT_OPT_FRAME_STATUS] = {
+		.name = "pass-frame-status",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_set_buffer_layout_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpni set-taildrop and get-taildrop command options
+ */
+enum dpni_taildrop_options {
+	TAILDROP_OPT_HELP = 0,
+	TAILDROP_OPT_TC,
+	TAILDROP_OPT_QUEUE,
+	TAILDROP_OPT_THRESHOLD,
+	TAILDROP_OPT_UNITS,
+};
+
+static struct option dpni_set_taildrop_options[] = {
+	[TAILDROP_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[TAILDROP_OPT_TC] = {
+		.name = "tc",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[TAILDROP_OPT_QUEUE] = {
+		.name = "queue",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[TAILDROP_OPT_THRESHOLD] = {
+		.name = "threshold",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[TAILDROP_OPT_UNITS] = {
+		.name = "units",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_set_taildrop_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+static struct option dpni_get_taildrop_options[] = {
+	[TAILDROP_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[TAILDROP_OPT_TC] = {
+		.name = "tc",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[TAILDROP_OPT_QUEUE] = {
+		.name = "queue",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_get_taildrop_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpni set-congestion-notification and get-congestion-notification command
+ * options
+ */
+enum dpni_cong_options {
+	CONG_OPT_HELP = 0,
+	CONG_OPT_TC,
+	CONG_OPT_UNITS,
+	CONG_OPT_ENTRY,
+	CONG_OPT_EXIT,
+	CONG_OPT_DEST,
+	CONG_OPT_PRIORITY,
+	CONG_OPT_NOTIFY,
+	CONG_OPT_MESSAGE_CTX,
+};
+
+static struct option dpni_set_cong_options[] = {
+	[CONG_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[CONG_OPT_TC] = {
+		.name = "tc",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[CONG_OPT_UNITS] = {
+		.name = "units",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[CONG_OPT_ENTRY] = {
+		.name = "threshold-entry",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[CONG_OPT_EXIT] = {
+		.name = "threshold-exit",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[CONG_OPT_DEST] = {
+		.name = "dest",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[CONG_OPT_PRIORITY] = {
+		.name = "priority",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[CONG_OPT_NOTIFY] = {
+		.name = "notify",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[CONG_OPT_MESSAGE_CTX] = {
+		.name = "message-ctx",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_set_cong_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+static struct option dpni_get_cong_options[] = {
+	[CONG_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[CONG_OPT_TC] = {
+		.name = "tc",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_get_cong_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpni set-tx-priorities command options
+ */
+enum dpni_set_tx_priorities_options {
+	TX_PRIO_OPT_HELP = 0,
+	TX_PRIO_OPT_SCHED,
+	TX_PRIO_OPT_PRIO_A,
+	TX_PRIO_OPT_PRIO_B,
+	TX_PRIO_OPT_SEPARATE,
+};
+
+static struct option dpni_set_tx_priorities_options[] = {
+	[TX_PRIO_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[TX_PRIO_OPT_SCHED] = {
+		.name = "sched",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[TX_PRIO_OPT_PRIO_A] = {
+		.name = "prio-a",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[TX_PRIO_OPT_PRIO_B] = {
+		.name = "prio-b",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[TX_PRIO_OPT_SEPARATE] = {
+		.name = "separate-groups",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_set_tx_priorities_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpni set-tx-shaping command options
+ */
+enum dpni_set_tx_shaping_options {
+	TX_SHAPING_OPT_HELP = 0,
+	TX_SHAPING_OPT_CR,
+	TX_SHAPING_OPT_CR_BURST,
+	TX_SHAPING_OPT_ER,
+	TX_SHAPING_OPT_ER_BURST,
+};
+
+static struct option dpni_set_tx_shaping_options[] = {
+	[TX_SHAPING_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[TX_SHAPING_OPT_CR] = {
+		.name = "committed-rate",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[TX_SHAPING_OPT_CR_BURST] = {
+		.name = "committed-burst",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[TX_SHAPING_OPT_ER] = {
+		.name = "excess-rate",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[TX_SHAPING_OPT_ER_BURST] = {
+		.name = "excess-burst",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_set_tx_shaping_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpni queues command options
+ */
+enum dpni_queues_options {
+	QUEUES_OPT_HELP = 0,
+};
+
+static struct option dpni_queues_options[] = {
+	[QUEUES_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_queues_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpni set-offload command options
+ */
+enum dpni_set_offload_options {
+	OFFLOAD_OPT_HELP = 0,
+	OFFLOAD_OPT_RX_L3_CSUM,
+	OFFLOAD_OPT_RX_L4_CSUM,
+	OFFLOAD_OPT_TX_L3_CSUM,
+	OFFLOAD_OPT_TX_L4_CSUM,
+};
+
+static struct option dpni_set_offload_options[] = {
+	[OFFLOAD_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[OFFLOAD_OPT_RX_L3_CSUM] = {
+		.name = "rx-l3-csum",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[OFFLOAD_OPT_RX_L4_CSUM] = {
+		.name = "rx-l4-csum",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[OFFLOAD_OPT_TX_L3_CSUM] = {
+		.name = "tx-l3-csum",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[OFFLOAD_OPT_TX_L4_CSUM] = {
+		.name = "tx-l4-csum",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_set_offload_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpni mac-filter-add/del and vlan-filter-add/del command options
+ */
+enum dpni_filter_options {
+	FILTER_OPT_HELP = 0,
+	FILTER_OPT_ENTRY,
+};
+
+static struct option dpni_mac_filter_options[] = {
+	[FILTER_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[FILTER_OPT_ENTRY] = {
+		.name = "mac-addr",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_mac_filter_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+static struct option dpni_vlan_filter_options[] = {
+	[FILTER_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[FILTER_OPT_ENTRY] = {
+		.name = "vlan-id",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_vlan_filter_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpni mac-filter-load and vlan-filter-load command options
+ */
+enum dpni_filter_load_options {
+	FILTER_LOAD_OPT_HELP = 0,
+	FILTER_LOAD_OPT_FILE,
+};
+
+static struct option dpni_filter_load_options[] = {
+	[FILTER_LOAD_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[FILTER_LOAD_OPT_FILE] = {
+		.name = "file",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_filter_load_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpni mac-filter-clear and vlan-filter-clear command options
+ */
+enum dpni_filter_clear_options {
+	FILTER_CLEAR_OPT_HELP = 0,
+};
+
+static struct option dpni_filter_clear_options[] = {
+	[FILTER_CLEAR_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_filter_clear_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+static const struct flib_ops dpni_ops = {
+	.obj_open = dpni_open,
+	.obj_close = dpni_close,
+	.obj_get_irq_mask = dpni_get_irq_mask,
+	.obj_get_irq_status = dpni_get_irq_status,
+};
+
+static struct option_entry options_map_v9[] = {
+	OPTION_MAP_ENTRY(DPNI_OPT_ALLOW_DIST_KEY_PER_TC),
+	OPTION_MAP_ENTRY(DPNI_OPT_TX_CONF_DISABLED),
+	OPTION_MAP_ENTRY(DPNI_OPT_PRIVATE_TX_CONF_ERROR_DISABLED),
+	OPTION_MAP_ENTRY(DPNI_OPT_DIST_HASH),
+	OPTION_MAP_ENTRY(DPNI_OPT_DIST_FS),
+	OPTION_MAP_ENTRY(DPNI_OPT_UNICAST_FILTER),
+	OPTION_MAP_ENTRY(DPNI_OPT_MULTICAST_FILTER),
+	OPTION_MAP_ENTRY(DPNI_OPT_VLAN_FILTER),
+	OPTION_MAP_ENTRY(DPNI_OPT_IPR),
+	OPTION_MAP_ENTRY(DPNI_OPT_IPF),
+	OPTION_MAP_ENTRY(DPNI_OPT_VLAN_MANIPULATION),
+	OPTION_MAP_ENTRY(DPNI_OPT_QOS_MASK_SUPPORT),
+	OPTION_MAP_ENTRY(DPNI_OPT_FS_MASK_SUPPORT),
+};
+static unsigned int options_num_v9 = ARRAY_SIZE(options_map_v9);
+
+static struct option_entry options_map_v10_0[] = {
+	OPTION_MAP_ENTRY(DPNI_OPT_TX_FRM_RELEASE),
+	OPTION_MAP_ENTRY(DPNI_OPT_NO_MAC_FILTER),
+	OPTION_MAP_ENTRY(DPNI_OPT_HAS_POLICING),
+	OPTION_MAP_ENTRY(DPNI_OPT_SHARED_CONGESTION),
+	OPTION_MAP_ENTRY(DPNI_OPT_HAS_KEY_MASKING),
+	OPTION_MAP_ENTRY(DPNI_OPT_NO_FS),
+};
+static unsigned int options_num_v10_0 = ARRAY_SIZE(options_map_v10_0);
+
+static struct option_entry options_map_v10_1[] = {
+	OPTION_MAP_ENTRY(DPNI_OPT_TX_FRM_RELEASE),
+	OPTION_MAP_ENTRY(DPNI_OPT_NO_MAC_FILTER),
+	OPTION_MAP_ENTRY(DPNI_OPT_HAS_POLICING),
+	OPTION_MAP_ENTRY(DPNI_OPT_SHARED_CONGESTION),
+	OPTION_MAP_ENTRY(DPNI_OPT_HAS_KEY_MASKING),
+	OPTION_MAP_ENTRY(DPNI_OPT_NO_FS),
+	OPTION_MAP_ENTRY(DPNI_OPT_HAS_OPR),
+	OPTION_MAP_ENTRY(DPNI_OPT_OPR_PER_TC),
+	OPTION_MAP_ENTRY(DPNI_OPT_SINGLE_SENDER),
+};
+static unsigned int options_num_v10_1 = ARRAY_SIZE(options_map_v10_1);
+
+#define DPNI_STATS_PER_PAGE_V10 6
+
+static const char *dpni_stats_v10[][DPNI_STATS_PER_PAGE_V10] = {
+	{
+	"ingress_all_frames",
+	"ingress_all_bytes",
+	"ingress_multicast_frames",
+	"ingress_multicast_bytes",
+	"ingress_broadcast_frames",
+	"ingress_broadcast_bytes",
+	}, {
+	"egress_all_frames",
+	"egress_all_bytes",
+	"egress_multicast_frames",
+	"egress_multicast_bytes",
+	"egress_broadcast_frames",
+	"egress_broadcast_bytes",
+	}, {
+	"ingress_filtered_frames",
+	"ingress_discarded_frames",
+	"ingress_nobuffer_discards",
+	"egress_discarded_frames",
+	"egress_confirmed_frames",
+	""
+	},
+};
+
+static int cmd_dpni_help(struct restool *ctx)
+{
+	static const char help_msg[] =
+		"\n"
+		"Usage: restool dpni <command> [--help] [ARGS...]\n"
+		"Where <command> can be:\n"
+		"   info - displays detailed information about a DPNI object.\n"
+		"   create - creates a new child DPNI under the root DPRC.\n"
+		"   destroy - destroys a child DPNI under the root DPRC.\n"
+		"\n"
+		"For command-specific help, use the --help option of each command.\n"
+		"\n";
+
+	(void)ctx;
+	printf(help_msg);
+	return 0;
+}
+
+static int cmd_dpni_help_v10(struct restool *ctx)
+{
+	static const char help_msg[] =
+		"\n"
+		"Usage: restool dpni <command> [--help] [ARGS...]\n"
+		"Where <command> can be:\n"
+		"   info - displays detailed information about a DPNI object.\n"
+		"   create - creates a new child DPNI under the root DPRC.\n"
+		"   destroy - destroys a child DPNI under the root DPRC.\n"
+		"   update - update attributes of already created DPNI.\n"
+		"   set-rx-dist - sets the hash or flow steering distribution of ingress traffic.\n"
+		"   fs-add - adds a flow steering rule.\n"
+		"   fs-del - removes a flow steering rule.\n"
+		"   fs-clear - removes all the flow steering rules of a traffic class.\n"
+		"   fs-load - replaces the flow steering rules with those of a file.\n"
+		"   set-pools - binds buffer pools to a DPNI.\n"
+		"   set-buffer-layout - sets the buffer layout of a queue type.\n"
+		"   set-taildrop - sets the Rx taildrop thresholds.\n"
+		"   get-taildrop - shows the Rx taildrop thresholds.\n"
+		"   set-congestion-notification - sets the Rx congestion notification.\n"
+		"   get-congestion-notification - shows the Rx congestion notification.\n"
+		"   set-tx-priorities - sets the Tx scheduling of the traffic classes.\n"
+		"   set-tx-shaping - sets the Tx rate limit.\n"
+		"   queues - shows the queues of a DPNI and their counters.\n"
+		"   set-offload - enables or disables checksum offloads.\n"
+		"   mac-filter-add - adds an address to the MAC filter table.\n"
+		"   mac-filter-del - removes an address from the MAC filter table.\n"
+		"   mac-filter-load - loads the MAC filter table from a file.\n"
+		"   mac-filter-clear - empties the MAC filter table.\n"
+		"   vlan-filter-add - adds a VLAN ID to the VLAN filter table.\n"
+		"   vlan-filter-del - removes a VLAN ID from the VLAN filter table.\n"
+		"   vlan-filter-load - loads the VLAN filter table from a file.\n"
+		"   vlan-filter-clear - empties the VLAN filter table.\n"
+		"\n"
+		"For command-specific help, use the --help option of each command.\n"
+		"\n";
+
+	(void)ctx;
+	printf(help_msg);
+	return 0;
+}
+
+static void print_dpni_options(uint32_t options)
+{
+	output_begin_array("option_flags");
+
+	if ((options & ~ALL_DPNI_OPTS) != 0) {
+		output_item("Unrecognized options found...");
+		output_end_array();
+		return;
+	}
+
+	if (options & DPNI_OPT_ALLOW_DIST_KEY_PER_TC)
+		output_item("DPNI_OPT_ALLOW_DIST_KEY_PER_TC");
+
+	if (options & DPNI_OPT_TX_CONF_DISABLED)
+		output_item("DPNI_OPT_TX_CONF_DISABLED");
+
+	if (options & DPNI_OPT_PRIVATE_TX_CONF_ERROR_DISABLED)
+		output_item("DPNI_OPT_PRIVATE_TX_CONF_ERROR_DISABLED");
+
+	if (options & DPNI_OPT_DIST_HASH)
+		output_item("DPNI_OPT_DIST_HASH");
+
+	if (options & DPNI_OPT_DIST_FS)
+		output_item("DPNI_OPT_DIST_FS");
+
+	if (options & DPNI_OPT_UNICAST_FILTER)
+		output_item("DPNI_OPT_UNICAST_FILTER");
+
+	if (options & DPNI_OPT_MULTICAST_FILTER)
+		output_item("DPNI_OPT_MULTICAST_FILTER");
+
+	if (options & DPNI_OPT_VLAN_FILTER)
+		output_item("DPNI_OPT_VLAN_FILTER");
+
+	if (options & DPNI_OPT_IPR)
+		output_item("DPNI_OPT_IPR");
+
+	if (options & DPNI_OPT_IPF)
+		output_item("DPNI_OPT_IPF");
+
+	if (options & DPNI_OPT_VLAN_MANIPULATION)
+		output_item("DPNI_OPT_VLAN_MANIPULATION");
+
+	if (options & DPNI_OPT_QOS_MASK_SUPPORT)
+		output_item("DPNI_OPT_QOS_MASK_SUPPORT");
+
+	if (options & DPNI_OPT_FS_MASK_SUPPORT)
+		output_item("DPNI_OPT_FS_MASK_SUPPORT");
+	output_end_array();
+}
+
+static void print_dpni_options_v10(uint32_t options)
+{
+	output_begin_array("option_flags");
+
+	if ((options & ~ALL_DPNI_OPTS_V10) != 0) {
+		output_item("Unrecognized options found...");
+		output_end_array();
+		return;
+	}
+
+	if (options & DPNI_OPT_TX_FRM_RELEASE)
+		output_item("DPNI_OPT_TX_FRM_RELEASE");
+
+	if (options & DPNI_OPT_NO_MAC_FILTER)
+		output_item("DPNI_OPT_NO_MAC_FILTER");
+
+	if (options & DPNI_OPT_HAS_POLICING)
+		output_item("DPNI_OPT_HAS_POLICING");
+
+	if (options & DPNI_OPT_SHARED_CONGESTION)
+		output_item("DPNI_OPT_SHARED_CONGESTION");
+
+	if (options & DPNI_OPT_HAS_KEY_MASKING)
+		output_item("DPNI_OPT_HAS_KEY_MASKING");
+
+	if (options & DPNI_OPT_NO_FS)
+		output_item("DPNI_OPT_NO_FS");
+
+	if (options & DPNI_OPT_HAS_OPR)
+		output_item("DPNI_OPT_HAS_OPR");
+
+	if (options & DPNI_OPT_OPR_PER_TC)
+		output_item("DPNI_OPT_OPR_PER_TC");
+
+	if (options & DPNI_OPT_SINGLE_SENDER)
+		output_item("DPNI_OPT_SINGLE_SENDER");
+	output_end_array();
+}
+
+static int print_dpni_endpoint(struct restool *ctx, uint32_t target_id)
+{
+	struct dprc_endpoint endpoint1;
+	struct dprc_endpoint endpoint2;
+	int state;
+	int error = 0;
+
+	memset(&endpoint1, 0, sizeof(struct dprc_endpoint));
+	memset(&endpoint2, 0, sizeof(struct dprc_endpoint));
+
+	strncpy(endpoint1.type, "dpni", EP_OBJ_TYPE_MAX_LEN);
+	endpoint1.type[EP_OBJ_TYPE_MAX_LEN] = '\0';
+	endpoint1.id = target_id;
 	endpoint1.if_id = 0;
 
-	error = dprc_get_connection(&restool.mc_io, 0,
-					restool.root_dprc_handle,
-					&endpoint1, &endpoint2, &state);
-	printf("endpoint state: %d\n", state);
+	error = dprc_get_connection(&ctx->mc_io, ctx->cmd_flags,
+					ctx->root_dprc_handle,
+					&endpoint1, &endpoint2, &state);
+	output_int("endpoint_state", "endpoint state", state);
+
+	if (error == 0 && state == -1) {
+		output_field("endpoint", "endpoint", "No object associated");
+	} else if (error == 0) {
+		char peer[EP_OBJ_TYPE_MAX_LEN + 24] = "";
+		const char *link;
+
+		if (strcmp(endpoint2.type, "dpsw") == 0 ||
+		    strcmp(endpoint2.type, "dpdmux") == 0) {
+			snprintf(peer, sizeof(peer), "%s.%d.%d",
+				endpoint2.type, endpoint2.id,
+				endpoint2.if_id);
+		} else if (endpoint2.if_id == 0) {
+			snprintf(peer, sizeof(peer), "%s.%d",
+				endpoint2.type, endpoint2.id);
+		}
+
+		if (state == 1)
+			link = "up";
+		else if (state == 0)
+			link = "down";
+		else
+			link = "in error state";
+
+		if (output_is_json()) {
+			output_field("endpoint", "endpoint", "%s", peer);
+			output_field("link", "link", "%s", link);
+		} else {
+			output_field("endpoint", "endpoint",
+				     "%s, link is %s", peer, link);
+		}
+	} else {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			mc_status_to_string(ctx->mc_status), ctx->mc_status);
+		return error;
+	}
+
+	return 0;
+}
+
+static void print_mac_address(uint8_t mac_addr[6])
+{
+	output_field("mac_address", "mac address",
+		     "%02x:%02x:%02x:%02x:%02x:%02x",
+		     mac_addr[0], mac_addr[1], mac_addr[2],
+		     mac_addr[3], mac_addr[4], mac_addr[5]);
+}
+
+static int print_dpni_attr_v9(struct restool *ctx, uint32_t dpni_id,
+			      struct dprc_obj_desc *target_obj_desc)
+{
+	uint16_t dpni_handle;
+	int error;
+	int i;
+	struct dpni_attr_v9 dpni_attr;
+	struct dpni_extended_cfg ext_cfg;
+	uint8_t mac_addr[6];
+	bool dpni_opened = false;
+	struct dpni_link_state link_state;
+
+	error = dpni_open(&ctx->mc_io, ctx->cmd_flags, dpni_id, &dpni_handle);
+	if (error < 0) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		goto out;
+	}
+	dpni_opened = true;
+	if (0 == dpni_handle) {
+		DEBUG_PRINTF(
+			"dpni_open() returned invalid handle (auth 0) for dpni.%u\n",
+			dpni_id);
+		error = -ENOENT;
+		goto out;
+	}
+
+	memset(&dpni_attr, 0, sizeof(dpni_attr));
+
+	error = dpni_get_attributes_v9(&ctx->mc_io, ctx->cmd_flags, dpni_handle,
+				       &dpni_attr, &ext_cfg);
+	if (error < 0) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		goto out;
+	}
+
+	assert(dpni_id == (uint32_t)dpni_attr.id);
+	assert(DPNI_MAX_TC >= dpni_attr.max_tcs);
+
+	error = dpni_get_primary_mac_addr(&ctx->mc_io, ctx->cmd_flags,
+					dpni_handle, mac_addr);
+	if (error < 0) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		goto out;
+	}
+
+	memset(&link_state, 0, sizeof(link_state));
+	error = dpni_get_link_state(&ctx->mc_io, ctx->cmd_flags, dpni_handle,
+					&link_state);
+	if (error < 0) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		goto out;
+	}
+
+	output_field("version", "dpni version",
+		     "%u.%u", dpni_attr.version.major,
+		     dpni_attr.version.minor);
+	output_int("id", "dpni id", dpni_attr.id);
+	output_field("plugged_state", "plugged state", "%splugged",
+		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
+	print_dpni_endpoint(ctx, dpni_id);
+	output_bool("link_up", "link status", link_state.up == 1,
+		    "%d - %s", link_state.up,
+		    link_state.up == 0 ? "down" :
+		    link_state.up == 1 ? "up" : "error state");
+	print_mac_address(mac_addr);
+	output_hex("options", "dpni_attr.options value is",
+		   (unsigned long)dpni_attr.options);
+	print_dpni_options(dpni_attr.options);
+	output_uint("max_senders", "max senders",
+		    (uint32_t)dpni_attr.max_senders);
+	output_uint("max_tcs", "max traffic classes",
+		    (uint32_t)dpni_attr.max_tcs);
+	for (i = 0; i < dpni_attr.max_tcs; i++)
+		output_printf("\ttc[%d]: max_dist=%d, max_fs_entries=%d\n",
+			i,
+			ext_cfg.tc_cfg[i].max_dist,
+			dpni_attr.options & DPNI_OPT_DIST_FS ?
+				ext_cfg.tc_cfg[i].max_fs_entries : 0);
+	output_uint("max_unicast_filters", "max unicast filters",
+		    (uint32_t)dpni_attr.max_unicast_filters);
+	output_uint("max_multicast_filters", "max multicast filters",
+		    (uint32_t)dpni_attr.max_multicast_filters);
+	output_uint("max_vlan_filters", "max vlan filters",
+		    (uint32_t)dpni_attr.max_vlan_filters);
+	output_uint("max_qos_entries", "max QoS entries",
+		    (uint32_t)dpni_attr.max_qos_entries);
+	output_uint("max_qos_key_size", "max QoS key size",
+		    (uint32_t)dpni_attr.max_qos_key_size);
+	output_uint("max_dist_key_size", "max distribution key size",
+		    (uint32_t)dpni_attr.max_dist_key_size);
+	output_uint("max_policers", "max policers",
+		    (uint32_t)dpni_attr.max_policers);
+	output_uint("max_congestion_ctrl", "max congestion control",
+		(uint32_t)dpni_attr.max_congestion_ctrl);
+
+	output_printf("max_dist per RX traffic class:\n");
+	for (int k = 0; k < dpni_attr.max_tcs; ++k)
+		output_printf("\tclass %d's max_dist: %u\n", k,
+			      (uint32_t)ext_cfg.tc_cfg[k].max_dist);
+
+	output_printf("max_fs_entries per RX traffic class:\n");
+	for (int m = 0; m < dpni_attr.max_tcs; ++m)
+		output_printf("\tclass %d's max_fs_entries: %u\n", m,
+			      (uint32_t)ext_cfg.tc_cfg[m].max_fs_entries);
+
+	output_uint("max_reass_frm_size", "max_reass_frm_size",
+		(uint32_t)ext_cfg.ipr_cfg.max_reass_frm_size);
+	output_uint("min_frag_size_ipv4", "min_frag_size_ipv4",
+		(uint32_t)ext_cfg.ipr_cfg.min_frag_size_ipv4);
+	output_uint("min_frag_size_ipv6", "min_frag_size_ipv6",
+		(uint32_t)ext_cfg.ipr_cfg.min_frag_size_ipv6);
+	output_uint("max_open_frames_ipv4", "max_open_frames_ipv4",
+		(uint32_t)ext_cfg.ipr_cfg.max_open_frames_ipv4);
+	output_uint("max_open_frames_ipv6", "max_open_frames_ipv6",
+		(uint32_t)ext_cfg.ipr_cfg.max_open_frames_ipv6);
+
+	print_obj_label(ctx, target_obj_desc);
+
+	error = 0;
+
+out:
+	if (dpni_opened) {
+		int error2;
+
+		error2 = dpni_close(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
+		if (error2 < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error2);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			if (error == 0)
+				error = error2;
+		}
+	}
+
+	return error;
+}
+
+static void dpni_print_stats(const char *strings[],
+			     union dpni_statistics_v10 dpni_stats)
+{
+	uint64_t *stat;
+	int i;
+
+	stat = (uint64_t *)&dpni_stats.raw;
+	for (i = 0; i < DPNI_STATS_PER_PAGE_V10; i++) {
+		if (strcmp(strings[i], "\0") == 0)
+			break;
+		output_uint(NULL, strings[i], *stat);
+		stat++;
+	}
+}
+
+static const struct {
+	const char *name;
+	enum dpni_offload type;
+} dpni_csum_offloads[] = {
+	{ "rx_l3_csum", DPNI_OFF_RX_L3_CSUM },
+	{ "rx_l4_csum", DPNI_OFF_RX_L4_CSUM },
+	{ "tx_l3_csum", DPNI_OFF_TX_L3_CSUM },
+	{ "tx_l4_csum", DPNI_OFF_TX_L4_CSUM },
+};
+
+static void print_dpni_offloads_v10(struct restool *ctx, uint16_t dpni_handle)
+{
+	uint32_t config;
+	unsigned int i;
+	int error;
+
+	for (i = 0; i < ARRAY_SIZE(dpni_csum_offloads); i++) {
+		error = dpni_get_offload_v10(&ctx->mc_io, ctx->cmd_flags,
+					     dpni_handle,
+					     dpni_csum_offloads[i].type,
+					     &config);
+		/*
+		 * Older MC firmware does not know the offload commands,
+		 * which is not a reason to fail the whole info command.
+		 */
+		output_field(NULL, dpni_csum_offloads[i].name, "%s",
+			     error < 0 ? "n/a" :
+			     config ? "enabled" : "disabled");
+	}
+}
+
+static int print_dpni_attr_v10(struct restool *ctx, uint32_t dpni_id,
+			      struct dprc_obj_desc *target_obj_desc)
+{
+	struct dpni_attr_v10 dpni_attr;
+	union dpni_statistics_v10 dpni_stats;
+	uint16_t dpni_handle, dpni_major, dpni_minor;
+	struct dpni_link_state_v10 link_state;
+	bool dpni_opened = false;
+	uint8_t mac_addr[6];
+	int error = 0;
+	int error2;
+	unsigned int page;
+
+	if (INFO_FIELD(LINK) || INFO_FIELD(MAC) || INFO_FIELD(ATTR) ||
+	    INFO_FIELD(STATS)) {
+		error = dpni_open_v10(&ctx->mc_io, ctx->cmd_flags, dpni_id,
+				      &dpni_handle);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		dpni_opened = true;
+		if (0 == dpni_handle) {
+			DEBUG_PRINTF(
+				"dpni_open() returned invalid handle (auth 0) for dpni.%u\n",
+				dpni_id);
+			error = -ENOENT;
+			goto out;
+		}
+	}
+
+	if (INFO_FIELD(ATTR)) {
+		memset(&dpni_attr, 0, sizeof(dpni_attr));
+		error = dpni_get_attributes_v10(&ctx->mc_io, ctx->cmd_flags,
+						dpni_handle, &dpni_attr);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+	}
+
+	if (INFO_FIELD(VERSION)) {
+		error = get_obj_api_version(ctx, "dpni",
+					    dpni_get_api_version_v10,
+					    &dpni_major, &dpni_minor);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+	}
+
+	if (INFO_FIELD(MAC)) {
+		error = dpni_get_primary_mac_addr_v10(&ctx->mc_io,
+						      ctx->cmd_flags,
+						      dpni_handle, mac_addr);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+	}
+
+	if (INFO_FIELD(LINK)) {
+		memset(&link_state, 0, sizeof(link_state));
+		error = dpni_get_link_state_v10(&ctx->mc_io, ctx->cmd_flags,
+						dpni_handle,
+						&link_state);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+	}
+
+	if (INFO_FIELD(VERSION))
+		output_field("version", "dpni version",
+			     "%u.%u", dpni_major, dpni_minor);
+	if (INFO_FIELD(ID))
+		output_int("id", "dpni id", dpni_id);
+
+	if (INFO_FIELD(STATE))
+		output_field("plugged_state", "plugged state", "%splugged",
+			     (target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ?
+			     "" : "un");
+	if (INFO_FIELD(ENDPOINT))
+		print_dpni_endpoint(ctx, dpni_id);
+	if (INFO_FIELD(LINK)) {
+		output_bool("link_up", "link status", link_state.up == 1,
+			    "%d - %s", link_state.up,
+			    link_state.up == 0 ? "down" :
+			    link_state.up == 1 ? "up" : "error state");
+	}
+
+	if (INFO_FIELD(MAC))
+		print_mac_address(mac_addr);
+
+	if (INFO_FIELD(ATTR)) {
+		output_hex("options", "dpni_attr.options value is",
+			   (unsigned long)dpni_attr.options);
+		print_dpni_options_v10(dpni_attr.options);
+
+		output_uint("num_queues", "num_queues",
+			    (uint32_t)dpni_attr.num_queues);
+		output_uint("num_rx_tcs", "num_rx_tcs",
+			    (uint32_t)dpni_attr.num_rx_tcs);
+		output_uint("num_tx_tcs", "num_tx_tcs",
+			    (uint32_t)dpni_attr.num_tx_tcs);
+		output_uint("mac_entries", "mac_entries",
+			    (uint32_t)dpni_attr.mac_filter_entries);
+		output_uint("vlan_entries", "vlan_entries",
+			    (uint32_t)dpni_attr.vlan_filter_entries);
+		output_uint("qos_entries", "qos_entries",
+			    (uint32_t)dpni_attr.qos_entries);
+		output_uint("fs_entries", "fs_entries",
+			    (uint32_t)dpni_attr.fs_entries);
+		output_uint("qos_key_size", "qos_key_size",
+			    (uint32_t)dpni_attr.qos_key_size);
+		output_uint("fs_key_size", "fs_key_size",
+			    (uint32_t)dpni_attr.fs_key_size);
+		print_dpni_offloads_v10(ctx, dpni_handle);
+	}
+
+	if (INFO_FIELD(STATS)) {
+		for (page = 0; page < 3; page++) {
+			error = dpni_get_statistics_v10(&ctx->mc_io,
+							ctx->cmd_flags,
+							dpni_handle, page, 0,
+							&dpni_stats);
+			dpni_print_stats(dpni_stats_v10[page], dpni_stats);
+		}
+	}
+
+	print_obj_label(ctx, target_obj_desc);
+
+out:
+	if (dpni_opened) {
+
+		error2 = dpni_close_v10(&ctx->mc_io, ctx->cmd_flags,
+					dpni_handle);
+		if (error2 < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error2);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			if (error == 0)
+				error = error2;
+		}
+	}
+
+	return error;
+}
+
+static int print_dpni_info(struct restool *ctx, uint32_t dpni_id,
+			   int mc_fw_version)
+{
+	int error;
+	struct dprc_obj_desc target_obj_desc;
+
+	error = find_info_obj_desc(ctx, dpni_id, "dpni",
+				   ctx->cmd_option_mask &
+				   ONE_BIT_MASK(INFO_OPT_VERBOSE),
+				   &target_obj_desc);
+	if (error < 0)
+		goto out;
+
+	if (mc_fw_version == MC_FW_VERSION_9)
+		error = print_dpni_attr_v9(ctx, dpni_id, &target_obj_desc);
+	else if (mc_fw_version == MC_FW_VERSION_10)
+		error = print_dpni_attr_v10(ctx, dpni_id, &target_obj_desc);
+	if (error < 0)
+		goto out;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
+		error = print_obj_verbose(ctx, &target_obj_desc, &dpni_ops);
+	}
+
+out:
+	return error;
+}
+
+static int info_dpni(struct restool *ctx, int mc_fw_version)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni info <dpni-object> [--verbose]\n"
+		"                         [--fields=<field>[,<field>...]]\n"
+		"\n"
+		"OPTIONS:\n"
+		"--verbose\n"
+		"   Shows extended/verbose information about the object\n"
+		"--fields=<field>[,<field>...]\n"
+		"   Shows only the given fields and sends only the MC\n"
+		"   commands they need. <field> is one of: version, id,\n"
+		"   state, endpoint, link, mac, attr, stats, label.\n"
+		"   Requires MC firmware 10.x.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Display information about dpni.5:\n"
+		"   $ restool dpni info dpni.5\n"
+		"\n";
+
+	uint32_t obj_id;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
+		error = 0;
+		goto out;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_FIELDS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_FIELDS);
+		error = parse_info_fields(ctx, 
+				ctx->cmd_option_args[INFO_OPT_FIELDS]);
+		if (error < 0)
+			goto out;
+	}
+
+	if (ctx->obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		error = -EINVAL;
+		goto out;
+	}
+
+	error = parse_object_name(ctx->obj_name, "dpni", &obj_id);
+	if (error < 0)
+		goto out;
+
+	error = print_dpni_info(ctx, obj_id, mc_fw_version);
+
+out:
+	return error;
+}
+
+static int cmd_dpni_info_v9(struct restool *ctx)
+{
+	return info_dpni(ctx, MC_FW_VERSION_9);
+}
+
+static int cmd_dpni_info_v10(struct restool *ctx)
+{
+	return info_dpni(ctx, MC_FW_VERSION_10);
+}
+
+static int parse_dpni_mac_addr(char *mac_addr_str, uint8_t *mac_addr)
+{
+	char *cursor = NULL;
+	char *endptr;
+	char *mac_str = strtok_r(mac_addr_str, ":", &cursor);
+	long val;
+	int i = 0;
+
+	while (mac_str != NULL) {
+		if (i >= 6) { /* mac address is more than 6 parts */
+			ERROR_PRINTF("Invalid MAC address.\n");
+			ERROR_PRINTF(
+				"Please enter 48 bits MAC address, eg. 00:0e:0c:55:12:03\n");
+			return -EINVAL;
+		}
+
+		errno = 0;
+		val = strtol(mac_str, &endptr, 16);
+
+		if (STRTOL_ERROR(mac_str, endptr, val, errno) ||
+		    (val < 0 || val > UINT8_MAX)) {
+			ERROR_PRINTF("Invalid MAC address.\n");
+			ERROR_PRINTF(
+				"Please enter 48 bits MAC address, eg. 00:0e:0c:55:12:03\n");
+			return -EINVAL;
+		}
+
+		mac_addr[i] = (uint8_t)val;
+		mac_str = strtok_r(NULL, ":", &cursor);
+		++i;
+	}
+
+	if (6 != i) { /* mac address is less than 6 parts */
+		ERROR_PRINTF("Invalid MAC address.\n");
+		ERROR_PRINTF(
+			"Please enter 48 bits MAC address, eg. 00:0e:0c:55:12:03\n");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int parse_dpni_max_dist_per_tc_v9(char *max_dist_per_tc_str,
+	struct dpni_extended_cfg *dpni_extended_cfg, uint8_t max_tcs)
+{
+	char *cursor = NULL;
+	char *endptr;
+	char *max_dist_str = strtok_r(max_dist_per_tc_str, ",", &cursor);
+	int i = 0;
+	long val;
+
+	while (max_dist_str != NULL) {
+		if (i >= DPNI_MAX_TC) {
+			ERROR_PRINTF("Invalid max-dist-per-tc\n");
+			ERROR_PRINTF("maximum number of traffic class <= %d\n",
+			     DPNI_MAX_TC);
+			return -EINVAL;
+		}
+
+		errno = 0;
+		val = strtol(max_dist_str, &endptr, 0);
+
+		if (STRTOL_ERROR(max_dist_str, endptr, val, errno) ||
+		    (val < 0 || val > MAX_DIST_SIZE)) {
+			ERROR_PRINTF("Invalid dist-size.\n");
+			return -EINVAL;
+		}
+
+		dpni_extended_cfg->tc_cfg[i].max_dist = (uint16_t)val;
+		max_dist_str = strtok_r(NULL, ",", &cursor);
+		++i;
+	}
+
+	if (max_tcs != i) {
+		ERROR_PRINTF(
+			"size of max_dist_per_tc does not match max_tcs: %u\n",
+			(unsigned int)max_tcs);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int parse_dpni_max_fs_entries_per_tc(char *max_fs_entries_per_tc_str,
+	struct dpni_extended_cfg *dpni_extended_cfg, uint8_t max_tcs)
+{
+	char *cursor = NULL;
+	char *endptr;
+	char *max_fs_entries_str =
+			strtok_r(max_fs_entries_per_tc_str, ",", &cursor);
+	int i = 0;
+	long val;
+
+	while (max_fs_entries_str != NULL) {
+		if (i >= DPNI_MAX_TC) {
+			ERROR_PRINTF("Invalid max-dist-per-tc\n");
+			ERROR_PRINTF("maximum number of traffic class <= %d\n",
+			     DPNI_MAX_TC);
+			return -EINVAL;
+		}
+
+		errno = 0;
+		val = strtol(max_fs_entries_str, &endptr, 0);
+
+		if (STRTOL_ERROR(max_fs_entries_str, endptr, val, errno) ||
+		    (val < 0 || val > MAX_DIST_SIZE)) {
+			ERROR_PRINTF("Invalid dist-size.\n");
+			return -EINVAL;
+		}
+
+		dpni_extended_cfg->tc_cfg[i].max_fs_entries = (uint16_t)val;
+		max_fs_entries_str = strtok_r(NULL, ",", &cursor);
+		++i;
+	}
+
+	if (max_tcs != i) {
+		ERROR_PRINTF(
+			"size of max_fs_entries_per_tc does not match max_tcs: %u\n",
+			(unsigned int)max_tcs);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/**
+ * VLAN ids restool put in the filter table of each DPNI. The MC cannot
+ * report how many entries the table holds, and a table left empty with
+ * filtering on drops every tagged frame, so vlan-filter-del needs this to
+ * know it removed the last one.
+ */
+#define VLAN_FILTER_STATE_FILE	RESTOOL_RUN_DIR "/dpni.%u.vlan_ids"
+
+#define VLAN_ID_MAX		4094
+
+static const bool no_vlan_ids[VLAN_ID_MAX + 1];
+
+static void vlan_filter_state_path(uint32_t dpni_id, char *path, size_t size)
+{
+	snprintf(path, size, VLAN_FILTER_STATE_FILE, dpni_id);
+}
+
+/**
+ * Reads the VLAN ids recorded for a DPNI, returns false if there is no
+ * record
+ */
+static bool vlan_filter_state_read(uint32_t dpni_id, bool *ids)
+{
+	char path[64];
+	unsigned int id;
+	FILE *fp;
+
+	vlan_filter_state_path(dpni_id, path, sizeof(path));
+	fp = fopen(path, "r");
+	if (fp == NULL)
+		return false;
+
+	while (fscanf(fp, "%u\n", &id) == 1) {
+		if (id >= 1 && id <= VLAN_ID_MAX)
+			ids[id] = true;
+	}
+
+	fclose(fp);
+	return true;
+}
+
+static void vlan_filter_state_write(uint32_t dpni_id, const bool *ids)
+{
+	char path[64];
+	char tmp_file[sizeof(path) + 8];
+	FILE *fp;
+	int fd;
+
+	vlan_filter_state_path(dpni_id, path, sizeof(path));
+	snprintf(tmp_file, sizeof(tmp_file), "%s.XXXXXX", path);
+	(void)mkdir(RESTOOL_RUN_DIR, 0755);
+	fd = mkstemp(tmp_file);
+	if (fd < 0) {
+		DEBUG_PRINTF("cannot create %s: %s\n", tmp_file,
+			     strerror(errno));
+		return;
+	}
+
+	(void)fchmod(fd, 0644);
+	fp = fdopen(fd, "w");
+	if (fp == NULL) {
+		close(fd);
+		unlink(tmp_file);
+		return;
+	}
+
+	for (unsigned int id = 1; id <= VLAN_ID_MAX; id++) {
+		if (ids[id])
+			fprintf(fp, "%u\n", id);
+	}
+
+	if (fclose(fp) != 0 || rename(tmp_file, path) < 0) {
+		DEBUG_PRINTF("cannot write %s: %s\n", path, strerror(errno));
+		unlink(tmp_file);
+	}
+}
+
+/**
+ * Forgets the VLAN ids of a DPNI, when they are no longer known
+ */
+static void vlan_filter_state_remove(uint32_t dpni_id)
+{
+	char path[64];
+
+	vlan_filter_state_path(dpni_id, path, sizeof(path));
+	(void)unlink(path);
+}
+
+static int create_dpni_v9(struct restool *ctx, const char *usage_msg)
+{
+	struct dpni_extended_cfg dpni_extended_cfg;
+	struct dpni_attr_v9 dpni_attr;
+	struct dpni_cfg_v9 dpni_cfg;
+	uint16_t dpni_handle;
+	int error;
+	long val;
+
+	memset(&dpni_cfg, 0, sizeof(dpni_cfg));
+	memset(&dpni_extended_cfg, 0, sizeof(dpni_extended_cfg));
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		return 0;
+	}
+
+	if (ctx->obj_name != NULL) {
+		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
+			     ctx->obj_name);
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_OPTIONS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_OPTIONS);
+		error = parse_generic_create_options(
+				ctx->cmd_option_args[CREATE_OPT_OPTIONS],
+				(uint64_t *)&dpni_cfg.adv.options,
+				options_map_v9,
+				options_num_v9);
+		if (error < 0) {
+			DEBUG_PRINTF(
+				"parse_generic_create_options() failed with error %d, cannot get options-mask\n",
+				error);
+			return error;
+		}
+	} else {
+		dpni_cfg.adv.options = DPNI_OPT_UNICAST_FILTER |
+				       DPNI_OPT_MULTICAST_FILTER;
+	}
+
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAC_ADDR))) {
+		ERROR_PRINTF("--mac-addr option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_MAC_ADDR);
+	error  = parse_dpni_mac_addr(
+			ctx->cmd_option_args[CREATE_OPT_MAC_ADDR],
+			dpni_cfg.mac_addr);
+	if (error < 0) {
+		DEBUG_PRINTF(
+			"parse_dpni_mac_addr() failed with error %d, cannot get mac address\n",
+			error);
+		return error;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAX_TCS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_MAX_TCS);
+		error = get_option_value(ctx, CREATE_OPT_MAX_TCS, &val,
+					 "Invalid max tcs", 0, DPNI_MAX_TC);
+		if (error)
+			return error;
+		dpni_cfg.adv.max_tcs = (uint8_t)val;
+	} else {
+		dpni_cfg.adv.max_tcs = 1;
+	}
+
+	if (ctx->cmd_option_mask &
+	    ONE_BIT_MASK(CREATE_OPT_MAX_DIST_PER_TC)) {
+		ctx->cmd_option_mask &=
+			~ONE_BIT_MASK(CREATE_OPT_MAX_DIST_PER_TC);
+		error = parse_dpni_max_dist_per_tc_v9(
+			ctx->cmd_option_args[CREATE_OPT_MAX_DIST_PER_TC],
+			&dpni_extended_cfg,
+			dpni_cfg.adv.max_tcs);
+		if (error < 0) {
+			DEBUG_PRINTF(
+				"parse_dpni_max_dist_per_tc_v9() failed with error %d, cannot get maximum distribution's size per RX traffic-class\n",
+				error);
+			return error;
+		}
+	} else {
+		for (int i = 0; i < dpni_cfg.adv.max_tcs; ++i)
+			dpni_extended_cfg.tc_cfg[i].max_dist = 1;
+	}
+
+	if (ctx->cmd_option_mask &
+	    ONE_BIT_MASK(CREATE_OPT_MAX_FS_ENTRIES_PER_TC)) {
+		ctx->cmd_option_mask &=
+			~ONE_BIT_MASK(CREATE_OPT_MAX_FS_ENTRIES_PER_TC);
+		error = parse_dpni_max_fs_entries_per_tc(
+		ctx->cmd_option_args[CREATE_OPT_MAX_FS_ENTRIES_PER_TC],
+			&dpni_extended_cfg,
+			dpni_cfg.adv.max_tcs);
+		if (error < 0) {
+			DEBUG_PRINTF(
+				"parse_dpni_max_fs_entries_per_tc() failed with error %d, cannot get max_fs_entries per RX traffic-class\n",
+				error);
+			return error;
+		}
+	} else {
+		for (int i = 0; i < dpni_cfg.adv.max_tcs; ++i)
+			dpni_extended_cfg.tc_cfg[i].max_fs_entries = 1;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAX_SENDERS)) {
+		ctx->cmd_option_mask &=
+				~ONE_BIT_MASK(CREATE_OPT_MAX_SENDERS);
+		error = get_option_value(ctx, CREATE_OPT_MAX_SENDERS, &val,
+					 "Invalid max senders", 0, UINT8_MAX);
+		if (error)
+			return error;
+		dpni_cfg.adv.max_senders = (uint8_t)val;
+	} else {
+		dpni_cfg.adv.max_senders = 1;
+	}
+
+	if (ctx->cmd_option_mask &
+	    ONE_BIT_MASK(CREATE_OPT_MAX_UNICAST_FILTERS)) {
+		ctx->cmd_option_mask &=
+			~ONE_BIT_MASK(CREATE_OPT_MAX_UNICAST_FILTERS);
+		error = get_option_value(ctx, CREATE_OPT_MAX_UNICAST_FILTERS,
+					 &val,
+					 "Invalid max unicast filters", 0, UINT8_MAX);
+		if (error)
+			return error;
+		dpni_cfg.adv.max_unicast_filters = (uint8_t)val;
+	} else {
+		dpni_cfg.adv.max_unicast_filters = 0;
+	}
+
+	if (ctx->cmd_option_mask &
+	    ONE_BIT_MASK(CREATE_OPT_MAX_MULTICAST_FILTERS)) {
+		ctx->cmd_option_mask &=
+			~ONE_BIT_MASK(CREATE_OPT_MAX_MULTICAST_FILTERS);
+		error = get_option_value(ctx, CREATE_OPT_MAX_MULTICAST_FILTERS,
+					 &val,
+					 "Invalid max multicast filters",
+					 0, UINT8_MAX);
+		if (error)
+			return error;
+		dpni_cfg.adv.max_multicast_filters = (uint8_t)val;
+	} else {
+		dpni_cfg.adv.max_multicast_filters = 0;
+	}
+
+	if (ctx->cmd_option_mask &
+	    ONE_BIT_MASK(CREATE_OPT_MAX_VLAN_FILTERS)) {
+		ctx->cmd_option_mask &=
+			~ONE_BIT_MASK(CREATE_OPT_MAX_VLAN_FILTERS);
+		error = get_option_value(ctx, CREATE_OPT_MAX_VLAN_FILTERS, &val,
+					 "Invalid max vlan filters",
+					 0, UINT8_MAX);
+		if (error)
+			return error;
+		dpni_cfg.adv.max_vlan_filters = (uint8_t)val;
+	} else {
+		dpni_cfg.adv.max_vlan_filters = 0;
+	}
+
+	if (ctx->cmd_option_mask &
+	    ONE_BIT_MASK(CREATE_OPT_MAX_QOS_ENTRIES)) {
+		ctx->cmd_option_mask &=
+			~ONE_BIT_MASK(CREATE_OPT_MAX_QOS_ENTRIES);
+		error = get_option_value(ctx, CREATE_OPT_MAX_QOS_ENTRIES, &val,
+					 "Invalid max qos", 0, UINT8_MAX);
+		if (error)
+			return error;
+		dpni_cfg.adv.max_qos_entries = (uint8_t)val;
+	} else {
+		dpni_cfg.adv.max_qos_entries = 0;
+	}
+
+	if (ctx->cmd_option_mask &
+	    ONE_BIT_MASK(CREATE_OPT_MAX_QOS_KEY_SIZE)) {
+		ctx->cmd_option_mask &=
+			~ONE_BIT_MASK(CREATE_OPT_MAX_QOS_KEY_SIZE);
+		error = get_option_value(ctx, CREATE_OPT_MAX_QOS_KEY_SIZE, &val,
+					 "Invalid max qos key size", 0, UINT8_MAX);
+		if (error)
+			return error;
+		dpni_cfg.adv.max_qos_key_size = (uint8_t)val;
+	} else {
+		dpni_cfg.adv.max_qos_key_size = 0;
+	}
+
+	if (ctx->cmd_option_mask &
+	    ONE_BIT_MASK(CREATE_OPT_MAX_DIST_KEY_SIZE)) {
+		ctx->cmd_option_mask &=
+			~ONE_BIT_MASK(CREATE_OPT_MAX_DIST_KEY_SIZE);
+		error = get_option_value(ctx, CREATE_OPT_MAX_DIST_KEY_SIZE,
+					 &val,
+					 "Invalid max dist key size",
+					 0, UINT8_MAX);
+		if (error)
+			return error;
+		dpni_cfg.adv.max_dist_key_size = (uint8_t)val;
+	} else {
+		dpni_cfg.adv.max_dist_key_size = 0;
+	}
+
+	/**
+	 * hack to get get 0.8.x flibs to work with mc
+	 */
+	error = dpni_create_v9(&ctx->mc_io, ctx->cmd_flags, &dpni_cfg,
+			       &dpni_extended_cfg,
+			       &dpni_handle);
+	if (error < 0) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			mc_status_to_string(ctx->mc_status), ctx->mc_status);
+		return error;
+	}
+
+	memset(&dpni_attr, 0, sizeof(dpni_attr));
+	error = dpni_get_attributes_v9(&ctx->mc_io, ctx->cmd_flags, dpni_handle,
+				       &dpni_attr, &dpni_extended_cfg);
+	if (error < 0) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		return error;
+	}
+	print_new_obj(ctx, "dpni", dpni_attr.id, NULL);
+
+	error = dpni_close(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
+	if (error < 0) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		return error;
+	}
+	return 0;
+}
+
+static int cmd_dpni_create_v9(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni create --mac-addr=<addr> [OPTIONS]\n"
+		"   --mac-addr=<addr>\n"
+		"	String specifying primary MAC address (e.g. 00:00:05:00:00:05).\n"
+		"\n"
+		"OPTIONS:\n"
+		"--max-senders=<number>\n"
+		"	maximum number of different senders;\n"
+		"	will be used as the number of dedicated TX flows;\n"
+		"	If it is not a power of two it will be rounded up to the next\n"
+		"	power of two value.\n"
+		"--options=<options-mask>\n"
+		"   Where <options-mask> is a comma or space separated list of DPNI options:\n"
+		"	DPNI_OPT_ALLOW_DIST_KEY_PER_TC\n"
+		"	DPNI_OPT_TX_CONF_DISABLED\n"
+		"	DPNI_OPT_PRIVATE_TX_CONF_ERROR_DISABLED\n"
+		"	DPNI_OPT_DIST_HASH\n"
+		"	DPNI_OPT_DIST_FS\n"
+		"	DPNI_OPT_UNICAST_FILTER\n"
+		"	DPNI_OPT_MULTICAST_FILTER\n"
+		"	DPNI_OPT_VLAN_FILTER\n"
+		"	DPNI_OPT_QOS_MASK_SUPPORT\n"
+		"	DPNI_OPT_FS_MASK_SUPPORT\n"
+		"--max-tcs=<number>\n"
+		"	Specifies the maximum number of traffic-classes\n"
+		"	0 will be treated as 1\n"
+		"--max-dist-per-tc=<dist-size>,<dist-size>,...\n"
+		"	Comma separated list of counts specifying the\n"
+		"	maximum distribution's size per RX traffic-class\n"
+		"--max-fs-entries-per-tc=<fs-entries>,<fs-entries>,...\n"
+		"	Comma separated list of counts specifying the\n"
+		"	maximum fs-entries per RX traffic-class\n"
+		"--max-unicast-filters=<number>\n"
+		"	maximum number of unicast filters (0 will be treated as 16)\n"
+		"--max-multicast-filters=<number>\n"
+		"	maximum number of multicast filters (0 will be treated as 64)\n"
+		"--max-vlan-filters=<number>\n"
+		"	maximum number of vlan filters (0 will be treated as 16)\n"
+		"--max-qos-entries=<number>\n"
+		"	if max_tcs > 1, declares the maximum entries for\n"
+		"	the QoS table; '0' will be treated as '64'\n"
+		"--max-qos-key-size=<number>\n"
+		"	maximum key size for the QoS look-up;\n"
+		"	'0' will be treated as '24' which enough for IPv4 5-tuple\n"
+		"--max-dist-key-size=<number>\n"
+		"	maximum key size for the distribution;\n"
+		"	'0' will be treated as '24' which enough for IPv4 5-tuple\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Create a DPNI object with all default options:\n"
+		"   $ restool dpni create --mac-addr=<addr>\n"
+		"\n";
+
+	return create_dpni_v9(ctx, usage_msg);
+}
+
+static int create_dpni_v10(struct restool *ctx, const char *usage_msg)
+{
+	struct dpni_cfg_v10 dpni_cfg;
+	uint32_t dpni_id, dprc_id;
+	uint16_t dprc_handle;
+	bool dprc_opened;
+	long value;
+	int error;
+
+	memset(&dpni_cfg, 0, sizeof(dpni_cfg));
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		return 0;
+	}
+
+	if (ctx->obj_name != NULL) {
+		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
+			     ctx->obj_name);
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAC_ENTRIES) &&
+	    ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAC_FILTER_ENTRIES)) {
+		ERROR_PRINTF("Please only use on of the following options " \
+			     "since they are interchangeable:" \
+			     " --mac-entries, --mac-filter-entries.\n");
+		return -EINVAL;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_VLAN_ENTRIES) &&
+	    ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_VLAN_FILTER_ENTRIES)) {
+		ERROR_PRINTF("Please only use on of the following options " \
+			     "since they are interchangeable:" \
+			     " --vlan-entries, --vlan-filter-entries.\n");
+		return -EINVAL;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_OPTIONS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_OPTIONS);
+
+		if (ctx->mc_fw_version.minor == 0)
+			error = parse_generic_create_options(
+					ctx->cmd_option_args[CREATE_OPT_OPTIONS],
+					(uint64_t *)&dpni_cfg.options,
+					options_map_v10_0,
+					options_num_v10_0);
+		else
+			error = parse_generic_create_options(
+					ctx->cmd_option_args[CREATE_OPT_OPTIONS],
+					(uint64_t *)&dpni_cfg.options,
+					options_map_v10_1,
+					options_num_v10_1);
+
+		if (error) {
+			DEBUG_PRINTF("parse_generic_create_options() = %d\n",
+				     error);
+			return error;
+		}
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_QUEUES)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_NUM_QUEUES);
+		error = get_option_value(ctx, CREATE_OPT_NUM_QUEUES, &value,
+				     "Invalid num-queues value\n", 1, 8);
+		if (error)
+			return error;
+		dpni_cfg.num_queues = (uint8_t)value;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_TCS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_NUM_TCS);
+		error = get_option_value(ctx, CREATE_OPT_NUM_TCS, &value,
+				     "Invalid num-tcs value\n", 1, 16);
+		if (error)
+			return error;
+		dpni_cfg.num_tcs = (uint8_t)value;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAC_ENTRIES)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_MAC_ENTRIES);
+		error = get_option_value(ctx, CREATE_OPT_MAC_ENTRIES, &value,
+				     "Invalid mac-entries value\n", 1, 80);
+		if (error)
+			return error;
+		dpni_cfg.mac_filter_entries = (uint8_t)value;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAC_FILTER_ENTRIES)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_MAC_FILTER_ENTRIES);
+		error = get_option_value(ctx, CREATE_OPT_MAC_FILTER_ENTRIES,
+					 &value,
+				     "Invalid mac-filter-entries value\n", 1, 80);
+		if (error)
+			return error;
+		dpni_cfg.mac_filter_entries = (uint8_t)value;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_VLAN_ENTRIES)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_VLAN_ENTRIES);
+		error = get_option_value(ctx, CREATE_OPT_VLAN_ENTRIES, &value,
+				     "Invalid vlan-entries value\n", 1, 16);
+		if (error)
+			return error;
+		dpni_cfg.vlan_filter_entries = (uint8_t)value;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_VLAN_FILTER_ENTRIES)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_VLAN_FILTER_ENTRIES);
+		error = get_option_value(ctx, CREATE_OPT_VLAN_FILTER_ENTRIES,
+					 &value,
+				     "Invalid vlan-filter-entries value\n", 1, 16);
+		if (error)
+			return error;
+		dpni_cfg.vlan_filter_entries = (uint8_t)value;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_QOS_ENTRIES)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_QOS_ENTRIES);
+		error = get_option_value(ctx, CREATE_OPT_QOS_ENTRIES, &value,
+				     "Invalid qos-entries value\n", 1, 64);
+		if (error)
+			return error;
+		dpni_cfg.qos_entries = (uint8_t)value;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_FS_ENTRIES)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_FS_ENTRIES);
+		error = get_option_value(ctx, CREATE_OPT_FS_ENTRIES, &value,
+				     "Invalid fs-entries value\n", 1, 1024);
+		if (error)
+			return error;
+		dpni_cfg.fs_entries = (uint16_t)value;
+	}
+
+	dprc_handle = ctx->root_dprc_handle;
+	dprc_opened = false;
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
+		error = parse_object_name(
+				ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC],
+				"dprc", &dprc_id);
+		if (error)
+			return error;
+
+		if (ctx->root_dprc_id != dprc_id) {
+			error = open_dprc(ctx, dprc_id, &dprc_handle);
+			if (error)
+				return error;
+			dprc_opened = true;
+		}
+	}
+
+	error = dpni_create_v10(&ctx->mc_io, dprc_handle, ctx->cmd_flags,
+				&dpni_cfg, &dpni_id);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			mc_status_to_string(ctx->mc_status), ctx->mc_status);
+		return error;
+	}
+
+	/* the VLAN filter table of a new DPNI is empty */
+	vlan_filter_state_write(dpni_id, no_vlan_ids);
+	if (dprc_opened) {
+		(void)dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
+		print_new_obj(ctx, "dpni", dpni_id,
+			      ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC]);
+	} else {
+		print_new_obj(ctx, "dpni", dpni_id, NULL);
+	}
+
+	return 0;
+}
+static int cmd_dpni_create_v10(struct restool *ctx)
+{
+	static const char usage_msg_v10_0[] =
+		"\n"
+		"Usage: restool dpni create [OPTIONS]\n"
+		"\n"
+		"OPTIONS:\n"
+		"--options=<options-mask>\n"
+		"   Where <options-mask> is a comma or space separated list of DPNI options:\n"
+		"	DPNI_OPT_TX_FRM_RELEASE\n"
+		"	DPNI_OPT_NO_MAC_FILTER\n"
+		"	DPNI_OPT_HAS_POLICING\n"
+		"	DPNI_OPT_SHARED_CONGESTION\n"
+		"	DPNI_OPT_HAS_KEY_MASKING\n"
+		"	DPNI_OPT_NO_FS\n"
+		"--num-queues=<number>\n"
+		"   Number of TX/RX queues use for traffic distribution.\n"
+		"   Used to distribute traffic to multiple GPP cores,\n"
+		"   Defaults to one queue. Maximim supported value is 8\n"
+		"--num-tcs=<number>\n"
+		"   Number of traffic classes (TCs), reserved for the DPNI.\n"
+		"   Defaults to one TC. Maximum supported value is 8\n"
+		"--mac-filter-entries=<number>\n"
+		"   Number of entries in the MAC address filtering table.\n"
+		"   Allows both unicast and multicast entries.\n"
+		"   By default, there are 80 entries.Maximum supported value is 80.\n"
+		"   This option is the former --mac-entries which can still be used.\n"
+		"   The change was made to align with the options passed through DPL.\n"
+		"--vlan-filter-entries=<number>\n"
+		"   Number of entries in the VLAN address filtering table\n"
+		"   By default, VLAN filtering is disabled. Maximum values is 16\n"
+		"   This option is the former --vlan-entries which can still be used.\n"
+		"   The change was made to align with the options passed through DPL.\n"
+		"--qos-entries=<number>\n"
+		"   Number of entries in the QoS classification table.\n"
+		"   Ignored of DPNI has a single TC. By default, set to 64.\n"
+		"--fs-entries=<number>\n"
+		"   Number of entries in the flow steering table.\n"
+		"   Defaults to 64. Maximum value is 1024\n"
+		"--container=<container-name>\n"
+		"   Specifies the parent container name. e.g. dprc.2, dprc.3 etc.\n"
+		"\n";
+
+	static const char usage_msg_v10_1[] =
+		"\n"
+		"Usage: restool dpni create [OPTIONS]\n"
+		"\n"
+		"OPTIONS:\n"
+		"--options=<options-mask>\n"
+		"   Where <options-mask> is a comma or space separated list of DPNI options:\n"
+		"	DPNI_OPT_TX_FRM_RELEASE\n"
+		"	DPNI_OPT_NO_MAC_FILTER\n"
+		"	DPNI_OPT_HAS_POLICING\n"
+		"	DPNI_OPT_SHARED_CONGESTION\n"
+		"	DPNI_OPT_HAS_KEY_MASKING\n"
+		"	DPNI_OPT_NO_FS\n"
+		"	DPNI_OPT_HAS_OPR\n"
+		"	DPNI_OPT_OPR_PER_TC\n"
+		"	DPNI_OPT_SINGLE_SENDER\n"
+		"--num-queues=<number>\n"
+		"   Number of TX/RX queues use for traffic distribution.\n"
+		"   Used to distribute traffic to multiple GPP cores,\n"
+		"   Defaults to one queue. Maximim supported value is 8\n"
+		"--num-tcs=<number>\n"
+		"   Number of traffic classes (TCs), reserved for the DPNI.\n"
+		"   Defaults to one TC. Maximum supported value is 16.\n"
+		"   There are maximum 16 TCs for Tx and 8 TCs for Rx.\n"
+		"   When num_tcs > 8, Tx will use this value but Rx will have\n"
+		"   only 8 traffic classes.\n"
+		"--mac-filter-entries=<number>\n"
+		"   Number of entries in the MAC address filtering table.\n"
+		"   Allows both unicast and multicast entries.\n"
+		"   By default, there are 80 entries.Maximum supported value is 80.\n"
+		"   This option is the former --mac-entries which can still be used.\n"
+		"   The change was made to align with the options passed through DPL.\n"
+		"--vlan-filter-entries=<number>\n"
+		"   Number of entries in the VLAN address filtering table\n"
+		"   By default, VLAN filtering is disabled. Maximum values is 16\n"
+		"   This option is the former --vlan-entries which can still be used.\n"
+		"   The change was made to align with the options passed through DPL.\n"
+		"--qos-entries=<number>\n"
+		"   Number of entries in the QoS classification table.\n"
+		"   Ignored of DPNI has a single TC. By default, set to 64.\n"
+		"--fs-entries=<number>\n"
+		"   Number of entries in the flow steering table.\n"
+		"   Defaults to 64. Maximum value is 1024\n"
+		"--container=<container-name>\n"
+		"   Specifies the parent container name. e.g. dprc.2, dprc.3 etc.\n"
+		"\n";
+
+	if (ctx->mc_fw_version.minor == 0)
+		return create_dpni_v10(ctx, usage_msg_v10_0);
+	else
+		return create_dpni_v10(ctx, usage_msg_v10_1);
+	return -EINVAL;
+}
+
+static int destroy_dpni_v9(struct restool *ctx, uint32_t dpni_id)
+{
+	bool dpni_opened = false;
+	uint16_t dpni_handle;
+	int error, error2;
+
+	error = dpni_open(&ctx->mc_io, ctx->cmd_flags, dpni_id, &dpni_handle);
+	if (error < 0) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		goto out;
+	}
+	dpni_opened = true;
+	if (0 == dpni_handle) {
+		DEBUG_PRINTF(
+			"dpni_open() returned invalid handle (auth 0) for dpni.%u\n",
+			dpni_id);
+		error = -ENOENT;
+		goto out;
+	}
+
+	error = dpni_destroy(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
+	if (error < 0) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		goto out;
+	}
+	dpni_opened = false;
+	print_destroyed_obj("dpni", dpni_id);
+
+out:
+	if (dpni_opened) {
+		error2 = dpni_close(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
+		if (error2 < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error2);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			if (error == 0)
+				error = error2;
+		}
+	}
+
+	return error;
+}
+
+static int destroy_dpni_v10(struct restool *ctx, uint32_t dpni_id)
+{
+	uint16_t dprc_handle;
+	uint32_t dprc_id;
+	int error;
+
+	dprc_handle = ctx->root_dprc_handle;
+	dprc_id = ctx->root_dprc_id;
+	error = get_parent_dprc_id(ctx, dpni_id, "dpni", &dprc_id);
+	if (error)
+		return error;
+
+	if (dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, dprc_id, &dprc_handle);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				mc_status_to_string(ctx->mc_status),
+				ctx->mc_status);
+			return error;
+		}
+	}
+
+	error = dpni_destroy_v10(&ctx->mc_io, dprc_handle,
+				 ctx->cmd_flags, dpni_id);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			mc_status_to_string(ctx->mc_status), ctx->mc_status);
+		goto out;
+	}
+	vlan_filter_state_remove(dpni_id);
+	print_destroyed_obj("dpni", dpni_id);
+
+out:
+	if (dprc_id != ctx->root_dprc_id) {
+		error = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				mc_status_to_string(ctx->mc_status),
+				ctx->mc_status);
+		}
+	}
+
+	return error;
+}
+
+static int destroy_dpni(struct restool *ctx, int mc_fw_version)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni destroy <dpni-object>\n"
+		"   e.g. restool dpni destroy dpni.9\n"
+		"\n";
+
+	int error;
+	uint32_t dpni_id;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
+		return 0;
+	}
+
+	if (ctx->obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		error = -EINVAL;
+		goto out;
+	}
+
+	if (in_use(ctx->obj_name, "destroyed")) {
+		error = -EBUSY;
+		goto out;
+	}
+
+	error = parse_object_name(ctx->obj_name, "dpni", &dpni_id);
+	if (error < 0)
+		goto out;
+
+	if (!find_obj(ctx, "dpni", dpni_id)) {
+		error = -EINVAL;
+		goto out;
+	}
+
+	if (mc_fw_version == MC_FW_VERSION_9)
+		error = destroy_dpni_v9(ctx, dpni_id);
+	else if (mc_fw_version == MC_FW_VERSION_10)
+		error = destroy_dpni_v10(ctx, dpni_id);
+	else
+		return -EINVAL;
+out:
+	return error;
+}
+
+static int cmd_dpni_destroy_v9(struct restool *ctx)
+{
+	return destroy_dpni(ctx, MC_FW_VERSION_9);
+}
+
+static int cmd_dpni_destroy_v10(struct restool *ctx)
+{
+	return destroy_dpni(ctx, MC_FW_VERSION_10);
+}
+
+static int update_dpni_v10(struct restool *ctx, const char *usage_msg)
+{
+	uint8_t mac_addr[6];
+	uint16_t dpni_handle;
+	uint32_t dpni_id;
+	int error = 0;
+	bool minimal_options = false;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		return 0;
+	}
+
+	if (ctx->obj_name == NULL) {
+		ERROR_PRINTF("Should provide a dpni!\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = parse_object_name(ctx->obj_name, "dpni", &dpni_id);
+	if (error) {
+		puts(usage_msg);
+		goto out;
+	}
+
+	error = dpni_open_v10(&ctx->mc_io, ctx->cmd_flags, dpni_id,
+			      &dpni_handle);
+	if (error) {
+		ERROR_PRINTF("Could not open specified object!\n");
+		puts(usage_msg);
+		goto out;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(UPDATE_MAC_ADDR)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(UPDATE_MAC_ADDR);
+		error  = parse_dpni_mac_addr(
+				ctx->cmd_option_args[UPDATE_MAC_ADDR],
+				mac_addr);
+
+		error = dpni_set_primary_mac_addr_v10(&ctx->mc_io,
+						      ctx->cmd_flags,
+						      dpni_handle, mac_addr);
+		if (error)
+			ERROR_PRINTF("dpni_set_primary_mac_addr_v10() = %d\n", error);
+
+		minimal_options = true;
+	}
+
+	dpni_close_v10(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
+out:
+
+	if (!minimal_options && !error) {
+		ERROR_PRINTF("Specify at least an option to update!\n");
+		puts(usage_msg);
+	}
+
+	return error;
+}
+
+static int cmd_dpni_update_v10(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni update dpni.X [OPTIONS]\n"
+		"\n"
+		"OPTIONS:\n"
+		"   --mac-addr=<addr>\n"
+		"	String specifying primary MAC address (e.g. 00:00:05:00:00:05).\n"
+		"\n";
+
+	return update_dpni_v10(ctx, usage_msg);
+}
+
+/* "drop", or an Rx queue of the DPNI */
+static int parse_fs_queue(const char *str, const struct dpni_attr_v10 *attr,
+			  struct dpni_fs_action_cfg_v10 *action)
+{
+	unsigned long queue;
+	char *endptr;
+
+	memset(action, 0, sizeof(*action));
+	if (strcmp(str, "drop") == 0) {
+		action->options = DPNI_FS_OPT_DISCARD;
+		return 0;
+	}
+
+	errno = 0;
+	queue = strtoul(str, &endptr, 0);
+	if (errno != 0 || endptr == str || *endptr != '\0' ||
+	    queue >= attr->num_queues) {
+		ERROR_PRINTF("Invalid queue \'%s\', expected drop or 0-%u\n",
+			     str, attr->num_queues - 1);
+		return -EINVAL;
+	}
+
+	action->flow_id = (uint16_t)queue;
+	return 0;
+}
+
+static int set_rx_dist_dpni(struct restool *ctx, const char *usage_msg)
+{
+	struct dpni_rx_tc_dist_cfg_v10 dist_cfg;
+	struct dpkg_profile_cfg key_cfg;
+	struct mc_dma_mem key_mem = { 0 };
+	struct dpni_fs_action_cfg_v10 miss;
+	struct dpni_attr_v10 attr;
+	struct dpkg_key key;
+	uint16_t dpni_handle;
+	uint32_t dpni_id;
+	uint8_t tc = 0;
+	const char *key_str;
+	long value;
+	int error;
+	unsigned int i;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(SET_RX_DIST_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(SET_RX_DIST_OPT_HELP);
+		return 0;
+	}
+
+	if (ctx->obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = parse_object_name(ctx->obj_name, "dpni", &dpni_id);
+	if (error)
+		return error;
+
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(SET_RX_DIST_OPT_DIST_SIZE)) ||
+	    !(ctx->cmd_option_mask & ONE_BIT_MASK(SET_RX_DIST_OPT_HASH_KEY)) ==
+	    !(ctx->cmd_option_mask & ONE_BIT_MASK(SET_RX_DIST_OPT_FS_KEY))) {
+		ERROR_PRINTF("--dist-size and one of --hash-key, --fs-key are required\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(SET_RX_DIST_OPT_TC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(SET_RX_DIST_OPT_TC);
+		error = get_option_value(ctx, SET_RX_DIST_OPT_TC, &value,
+					 "Invalid tc value", 0,
+					 DPNI_MAX_TC - 1);
+		if (error)
+			return error;
+		tc = (uint8_t)value;
+	}
+
+	memset(&dist_cfg, 0, sizeof(dist_cfg));
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(SET_RX_DIST_OPT_DIST_SIZE);
+	error = get_option_value(ctx, SET_RX_DIST_OPT_DIST_SIZE, &value,
+				 "Invalid dist-size value", 1, MAX_DIST_SIZE);
+	if (error)
+		return error;
+
+	for (i = 0; i < ARRAY_SIZE(dist_sizes); i++) {
+		if (dist_sizes[i] == value)
+			break;
+	}
+
+	if (i == ARRAY_SIZE(dist_sizes)) {
+		ERROR_PRINTF("Unsupported dist-size %ld\n", value);
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	dist_cfg.dist_size = (uint16_t)value;
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(SET_RX_DIST_OPT_HASH_KEY)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(SET_RX_DIST_OPT_HASH_KEY);
+		key_str = ctx->cmd_option_args[SET_RX_DIST_OPT_HASH_KEY];
+		dist_cfg.dist_mode = DPNI_DIST_MODE_HASH;
+	} else {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(SET_RX_DIST_OPT_FS_KEY);
+		key_str = ctx->cmd_option_args[SET_RX_DIST_OPT_FS_KEY];
+		dist_cfg.dist_mode = DPNI_DIST_MODE_FS;
+	}
+
+	error = dpkg_key_parse(key_str, &key);
+	if (error)
+		return error;
+
+	dpkg_key_to_profile(&key, &key_cfg);
+	error = mc_dma_alloc(&ctx->mc_io, DPNI_KEY_CFG_SIZE, &key_mem);
+	if (error)
+		return error;
+
+	error = dpni_prepare_key_cfg_v10(&key_cfg, key_mem.vaddr);
+	if (error)
+		goto out;
+
+	dist_cfg.key_cfg_iova = key_mem.iova;
+
+	error = dpni_open_v10(&ctx->mc_io, ctx->cmd_flags, dpni_id,
+			      &dpni_handle);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		goto out;
+	}
+
+	error = dpni_get_attributes_v10(&ctx->mc_io, ctx->cmd_flags,
+					dpni_handle, &attr);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		goto out_close;
+	}
+
+	if (dist_cfg.dist_mode == DPNI_DIST_MODE_FS) {
+		if (ctx->cmd_option_mask & ONE_BIT_MASK(SET_RX_DIST_OPT_MISS)) {
+			ctx->cmd_option_mask &=
+				~ONE_BIT_MASK(SET_RX_DIST_OPT_MISS);
+			error = parse_fs_queue(
+				ctx->cmd_option_args[SET_RX_DIST_OPT_MISS],
+				&attr, &miss);
+			if (error)
+				goto out_close;
+
+			if (miss.options & DPNI_FS_OPT_DISCARD)
+				dist_cfg.fs_cfg.miss_action = DPNI_FS_MISS_DROP;
+			else
+				dist_cfg.fs_cfg.miss_action =
+					DPNI_FS_MISS_EXPLICIT_FLOWID;
+			dist_cfg.fs_cfg.default_flow_id = miss.flow_id;
+		} else {
+			dist_cfg.fs_cfg.miss_action =
+				DPNI_FS_MISS_EXPLICIT_FLOWID;
+		}
+	}
+
+	error = dpni_set_rx_tc_dist_v10(&ctx->mc_io, ctx->cmd_flags,
+					dpni_handle, tc, &dist_cfg);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+	}
+
+out_close:
+	(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
+out:
+	mc_dma_free(&ctx->mc_io, &key_mem);
+	return error;
+}
+
+static int cmd_dpni_set_rx_dist(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni set-rx-dist <dpni-object> [OPTIONS]\n"
+		"   e.g. restool dpni set-rx-dist dpni.5 --dist-size=8 \\\n"
+		"\t\t--hash-key=ipsrc,ipdst,l4sport,l4dport\n"
+		"\n"
+		"Spreads the ingress frames of a traffic class over its first\n"
+		"<dist-size> queues, by a hash of the --hash-key header fields\n"
+		"or by the flow steering rules of fs-add and fs-load, which\n"
+		"match on the --fs-key header fields.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--tc=<number>\n"
+		"   Rx traffic class, 0 by default.\n"
+		"--dist-size=<number>\n"
+		"   Number of queues to spread over, one of 1, 2, 3, 4, 6, 7,\n"
+		"   8, 12, 14, 16, 24, 28, 32, 48, 56, 64, 96, 112, 128, 192,\n"
+		"   224, 256, 384, 448, 512, 768, 896, 1024.\n"
+		"--hash-key=<field>[,<field>...]\n"
+		"   Header fields hashed, from: ethdst, ethsrc, ethtype, vlan,\n"
+		"   ipsrc, ipdst, ipproto, l4sport, l4dport.\n"
+		"--fs-key=<field>[,<field>...]\n"
+		"   Header fields the flow steering rules match on.\n"
+		"--miss-queue=<number>|drop\n"
+		"   With --fs-key, where frames matching no rule go, queue 0 by\n"
+		"   default.\n"
+		"\n";
+
+	return set_rx_dist_dpni(ctx, usage_msg);
+}
+
+/**
+ * State shared by the fs-* commands: the open DPNI, its attributes, the key
+ * the rules are written for and the memory the MC reads a rule from (key
+ * bytes first, mask bytes DPKG_MAX_KEY_SIZE further).
+ */
+struct dpni_fs {
+	uint16_t dpni_handle;
+	struct dpni_attr_v10 attr;
+	uint8_t tc;
+	struct dpkg_key key;
+	struct mc_dma_mem rule_mem;
+	struct dpni_rule_cfg rule_cfg;
+};
+
+static int dpni_fs_open(struct restool *ctx, const char *usage_msg,
+			bool need_key, struct dpni_fs *fs)
+{
+	uint32_t dpni_id;
+	long value;
+	int error;
+
+	memset(fs, 0, sizeof(*fs));
+	if (ctx->obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = parse_object_name(ctx->obj_name, "dpni", &dpni_id);
+	if (error)
+		return error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(FS_OPT_TC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(FS_OPT_TC);
+		error = get_option_value(ctx, FS_OPT_TC, &value,
+					 "Invalid tc value", 0,
+					 DPNI_MAX_TC - 1);
+		if (error)
+			return error;
+		fs->tc = (uint8_t)value;
+	}
+
+	if (need_key) {
+		if (!(ctx->cmd_option_mask & ONE_BIT_MASK(FS_OPT_KEY))) {
+			ERROR_PRINTF("--key option missing\n");
+			puts(usage_msg);
+			return -EINVAL;
+		}
+
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(FS_OPT_KEY);
+		error = dpkg_key_parse(ctx->cmd_option_args[FS_OPT_KEY],
+				       &fs->key);
+		if (error)
+			return error;
+
+		error = mc_dma_alloc(&ctx->mc_io, 2 * DPKG_MAX_KEY_SIZE,
+				     &fs->rule_mem);
+		if (error)
+			return error;
+
+		fs->rule_cfg.key_iova = fs->rule_mem.iova;
+		fs->rule_cfg.mask_iova = fs->rule_mem.iova + DPKG_MAX_KEY_SIZE;
+		fs->rule_cfg.key_size = fs->key.size;
+	}
+
+	error = dpni_open_v10(&ctx->mc_io, ctx->cmd_flags, dpni_id,
+			      &fs->dpni_handle);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		goto err_free;
+	}
+
+	error = dpni_get_attributes_v10(&ctx->mc_io, ctx->cmd_flags,
+					fs->dpni_handle, &fs->attr);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		goto err_close;
+	}
+
+	error = -EINVAL;
+	if (fs->attr.options & DPNI_OPT_NO_FS) {
+		ERROR_PRINTF("%s was created without a flow steering table\n",
+			     ctx->obj_name);
+		goto err_close;
+	}
+
+	if (fs->tc >= fs->attr.num_rx_tcs) {
+		ERROR_PRINTF("%s has %u Rx traffic classes\n",
+			     ctx->obj_name, fs->attr.num_rx_tcs);
+		goto err_close;
+	}
+
+	if (need_key && fs->key.size > fs->attr.fs_key_size) {
+		ERROR_PRINTF("%u byte key, %s takes at most %u bytes\n",
+			     fs->key.size, ctx->obj_name,
+			     fs->attr.fs_key_size);
+		goto err_close;
+	}
+
+	return 0;
+
+err_close:
+	(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags, fs->dpni_handle);
+err_free:
+	mc_dma_free(&ctx->mc_io, &fs->rule_mem);
+	return error;
+}
+
+static void dpni_fs_close(struct restool *ctx, struct dpni_fs *fs)
+{
+	(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags, fs->dpni_handle);
+	mc_dma_free(&ctx->mc_io, &fs->rule_mem);
+}
+
+/* parses a rule into rule_mem */
+static int dpni_fs_prepare_rule(struct dpni_fs *fs, const char *rule_str)
+{
+	uint8_t *key_buf = fs->rule_mem.vaddr;
+	uint8_t *mask_buf = key_buf + DPKG_MAX_KEY_SIZE;
+	int error;
+
+	error = dpkg_key_parse_rule(&fs->key, rule_str, key_buf, mask_buf);
+	if (error)
+		return error;
+
+	if (fs->attr.options & DPNI_OPT_HAS_KEY_MASKING)
+		return 0;
+
+	for (unsigned int i = 0; i < fs->key.size; i++) {
+		if (mask_buf[i] != 0xff) {
+			ERROR_PRINTF("the flow steering table is exact match (no DPNI_OPT_HAS_KEY_MASKING), every key field needs a full value\n");
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+static int fs_add_dpni(struct restool *ctx, const char *usage_msg)
+{
+	struct dpni_fs_action_cfg_v10 action;
+	uint16_t index = 0;
+	struct dpni_fs fs;
+	long value;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(FS_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(FS_OPT_HELP);
+		return 0;
+	}
+
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(FS_OPT_RULE)) ||
+	    !(ctx->cmd_option_mask & ONE_BIT_MASK(FS_OPT_QUEUE))) {
+		ERROR_PRINTF("--rule and --queue are required\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = dpni_fs_open(ctx, usage_msg, true, &fs);
+	if (error)
+		return error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(FS_OPT_INDEX)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(FS_OPT_INDEX);
+		error = get_option_value(ctx, FS_OPT_INDEX, &value,
+					 "Invalid index value", 0,
+					 fs.attr.fs_entries - 1);
+		if (error)
+			goto out;
+		index = (uint16_t)value;
+	}
+
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(FS_OPT_QUEUE);
+	error = parse_fs_queue(ctx->cmd_option_args[FS_OPT_QUEUE], &fs.attr,
+			       &action);
+	if (error)
+		goto out;
+
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(FS_OPT_RULE);
+	error = dpni_fs_prepare_rule(&fs, ctx->cmd_option_args[FS_OPT_RULE]);
+	if (error)
+		goto out;
+
+	error = dpni_add_fs_entry_v10(&ctx->mc_io, ctx->cmd_flags,
+				      fs.dpni_handle, fs.tc, index,
+				      &fs.rule_cfg, &action);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+	}
+out:
+	dpni_fs_close(ctx, &fs);
+	return error;
+}
+
+static int cmd_dpni_fs_add(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni fs-add <dpni-object> --key=<fields> \\\n"
+		"\t\t--rule=<rule> --queue=<number>|drop [OPTIONS]\n"
+		"   e.g. restool dpni fs-add dpni.5 --key=ipdst,l4dport \\\n"
+		"\t\t--rule=ipdst=10.0.0.2,l4dport=5201 --queue=3\n"
+		"\n"
+		"Adds a rule to the flow steering table of a traffic class.\n"
+		"\n"
+		"--key=<field>[,<field>...]\n"
+		"   Header fields of the lookup key, the --fs-key given to\n"
+		"   set-rx-dist.\n"
+		"--rule=<field>=<value>[/<mask>][,...]\n"
+		"   Values to match. Addresses take a prefix length as mask.\n"
+		"   Fields left out match anything (needs a DPNI created with\n"
+		"   DPNI_OPT_HAS_KEY_MASKING).\n"
+		"--queue=<number>|drop\n"
+		"   Rx queue matching frames go to, or drop them.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--tc=<number>\n"
+		"   Rx traffic class, 0 by default.\n"
+		"--index=<number>\n"
+		"   Position in a masked table, lower positions win. 0 by\n"
+		"   default.\n"
+		"\n";
+
+	return fs_add_dpni(ctx, usage_msg);
+}
+
+static int fs_del_dpni(struct restool *ctx, const char *usage_msg)
+{
+	struct dpni_fs fs;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(FS_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(FS_OPT_HELP);
+		return 0;
+	}
+
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(FS_OPT_RULE))) {
+		ERROR_PRINTF("--rule option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = dpni_fs_open(ctx, usage_msg, true, &fs);
+	if (error)
+		return error;
+
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(FS_OPT_RULE);
+	error = dpni_fs_prepare_rule(&fs, ctx->cmd_option_args[FS_OPT_RULE]);
+	if (error)
+		goto out;
+
+	error = dpni_remove_fs_entry_v10(&ctx->mc_io, ctx->cmd_flags,
+					 fs.dpni_handle, fs.tc, &fs.rule_cfg);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+	}
+out:
+	dpni_fs_close(ctx, &fs);
+	return error;
+}
+
+static int cmd_dpni_fs_del(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni fs-del <dpni-object> --key=<fields> \\\n"
+		"\t\t--rule=<rule> [--tc=<number>]\n"
+		"\n"
+		"Removes a rule added with fs-add, given with the same key and\n"
+		"rule.\n"
+		"\n";
+
+	return fs_del_dpni(ctx, usage_msg);
+}
+
+static int fs_clear_dpni(struct restool *ctx, const char *usage_msg)
+{
+	struct dpni_fs fs;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(FS_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(FS_OPT_HELP);
+		return 0;
+	}
+
+	error = dpni_fs_open(ctx, usage_msg, false, &fs);
+	if (error)
+		return error;
+
+	error = dpni_clear_fs_entries_v10(&ctx->mc_io, ctx->cmd_flags,
+					  fs.dpni_handle, fs.tc);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+	}
+
+	dpni_fs_close(ctx, &fs);
+	return error;
+}
+
+static int cmd_dpni_fs_clear(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni fs-clear <dpni-object> [--tc=<number>]\n"
+		"\n"
+		"Removes all the rules of the flow steering table of a traffic\n"
+		"class.\n"
+		"\n";
+
+	return fs_clear_dpni(ctx, usage_msg);
+}
+
+/**
+ * A rule of a rule file, parsed before the table is touched
+ */
+struct dpni_fs_load_rule {
+	uint8_t key[DPKG_MAX_KEY_SIZE];
+	uint8_t mask[DPKG_MAX_KEY_SIZE];
+	struct dpni_fs_action_cfg_v10 action;
+	unsigned int line;
+};
+
+static int fs_load_parse(struct dpni_fs *fs, const char *path,
+			 struct dpni_fs_load_rule **rules_out,
+			 unsigned int *num_rules_out)
+{
+	struct dpni_fs_load_rule *rules;
+	unsigned int num_rules = 0;
+	unsigned int line = 0;
+	char buf[512];
+	int error = 0;
+	FILE *f;
+
+	f = fopen(path, "r");
+	if (f == NULL) {
+		error = -errno;
+		ERROR_PRINTF("cannot open %s: %s\n", path, strerror(errno));
+		return error;
+	}
+
+	rules = calloc(fs->attr.fs_entries, sizeof(*rules));
+	if (rules == NULL && fs->attr.fs_entries != 0) {
+		error = -ENOMEM;
+		goto out;
+	}
+
+	while (fgets(buf, sizeof(buf), f) != NULL) {
+		uint8_t *key_buf = fs->rule_mem.vaddr;
+		char *rule_str, *queue_str, *extra, *saveptr;
+
+		line++;
+		buf[strcspn(buf, "#\n")] = '\0';
+		rule_str = strtok_r(buf, " \t", &saveptr);
+		if (rule_str == NULL)
+			continue;
+
+		queue_str = strtok_r(NULL, " \t", &saveptr);
+		extra = strtok_r(NULL, " \t", &saveptr);
+		if (queue_str == NULL || extra != NULL) {
+			ERROR_PRINTF("%s:%u: expected <rule> <queue>|drop\n",
+				     path, line);
+			error = -EINVAL;
+			goto out;
+		}
+
+		if (num_rules == fs->attr.fs_entries) {
+			ERROR_PRINTF("%s:%u: more rules than the %u entries of the flow steering table\n",
+				     path, line, fs->attr.fs_entries);
+			error = -EINVAL;
+			goto out;
+		}
+
+		error = dpni_fs_prepare_rule(fs, rule_str);
+		if (!error)
+			error = parse_fs_queue(queue_str, &fs->attr,
+					       &rules[num_rules].action);
+		if (error) {
+			ERROR_PRINTF("%s:%u: invalid rule\n", path, line);
+			goto out;
+		}
+
+		memcpy(rules[num_rules].key, key_buf, fs->key.size);
+		memcpy(rules[num_rules].mask, key_buf + DPKG_MAX_KEY_SIZE,
+		       fs->key.size);
+		rules[num_rules].line = line;
+		num_rules++;
+	}
+
+	if (ferror(f)) {
+		error = -EIO;
+		ERROR_PRINTF("cannot read %s\n", path);
+	}
+
+out:
+	fclose(f);
+	if (error) {
+		free(rules);
+		return error;
+	}
+
+	*rules_out = rules;
+	*num_rules_out = num_rules;
+	return 0;
+}
+
+static int fs_load_dpni(struct restool *ctx, const char *usage_msg)
+{
+	struct dpni_fs_load_rule *rules = NULL;
+	const char *path;
+	unsigned int num_rules, i;
+	uint8_t *key_buf;
+	struct dpni_fs fs;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(FS_LOAD_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(FS_LOAD_OPT_HELP);
+		return 0;
+	}
+
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(FS_LOAD_OPT_FILE))) {
+		ERROR_PRINTF("--file option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = dpni_fs_open(ctx, usage_msg, true, &fs);
+	if (error)
+		return error;
+
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(FS_LOAD_OPT_FILE);
+	path = ctx->cmd_option_args[FS_LOAD_OPT_FILE];
+	error = fs_load_parse(&fs, path, &rules, &num_rules);
+	if (error)
+		goto out;
+
+	error = dpni_clear_fs_entries_v10(&ctx->mc_io, ctx->cmd_flags,
+					  fs.dpni_handle, fs.tc);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		goto out;
+	}
+
+	/* one rule in flight at a time through the same memory */
+	key_buf = fs.rule_mem.vaddr;
+	for (i = 0; i < num_rules; i++) {
+		memcpy(key_buf, rules[i].key, fs.key.size);
+		memcpy(key_buf + DPKG_MAX_KEY_SIZE, rules[i].mask,
+		       fs.key.size);
+		error = dpni_add_fs_entry_v10(&ctx->mc_io, ctx->cmd_flags,
+					      fs.dpni_handle, fs.tc, i,
+					      &fs.rule_cfg, &rules[i].action);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			ERROR_PRINTF("%s:%u: rule not added, %u of %u loaded\n",
+				     path, rules[i].line, i, num_rules);
+			goto out;
+		}
+	}
+
+	if (output_is_json()) {
+		output_field("object", "object", "%s", ctx->obj_name);
+		output_uint("tc", "tc", fs.tc);
+		output_uint("rules_loaded", "rules loaded", num_rules);
+	} else {
+		output_printf("%u flow steering rules loaded into %s tc %u\n",
+			      num_rules, ctx->obj_name, fs.tc);
+	}
+out:
+	free(rules);
+	dpni_fs_close(ctx, &fs);
+	return error;
+}
+
+static int cmd_dpni_fs_load(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni fs-load <dpni-object> --key=<fields> \\\n"
+		"\t\t--file=<rule-file> [--tc=<number>]\n"
+		"\n"
+		"Replaces the flow steering table of a traffic class with the\n"
+		"rules of a file, one per line:\n"
+		"   <field>=<value>[/<mask>][,...] <queue>|drop\n"
+		"Blank lines and text after # are ignored. The file is checked\n"
+		"whole before the table is cleared; earlier lines take lower\n"
+		"positions, so they win in a masked table. See fs-add for the\n"
+		"rule syntax.\n"
+		"\n";
+
+	return fs_load_dpni(ctx, usage_msg);
+}
+
+static int parse_pools(const char *str, struct dpni_pools_cfg_v10 *cfg)
+{
+	char buf[256];
+	char *item, *saveptr, *size_str, *endptr;
+	unsigned long size;
+	uint32_t dpbp_id;
+	int error;
+
+	if (strlen(str) >= sizeof(buf)) {
+		ERROR_PRINTF("--dpbp value too long\n");
+		return -EINVAL;
+	}
+
+	strcpy(buf, str);
+	memset(cfg, 0, sizeof(*cfg));
+	for (item = strtok_r(buf, ",", &saveptr); item != NULL;
+	     item = strtok_r(NULL, ",", &saveptr)) {
+		if (cfg->num_dpbp == DPNI_MAX_DPBP) {
+			ERROR_PRINTF("at most %d buffer pools\n",
+				     DPNI_MAX_DPBP);
+			return -EINVAL;
+		}
+
+		size_str = strchr(item, ':');
+		if (size_str == NULL) {
+			ERROR_PRINTF("expected <dpbp>:<buffer-size>, got \'%s\'\n",
+				     item);
+			return -EINVAL;
+		}
+
+		*size_str++ = '\0';
+		error = parse_object_name(item, "dpbp", &dpbp_id);
+		if (error)
+			return error;
+
+		errno = 0;
+		size = strtoul(size_str, &endptr, 0);
+		if (errno != 0 || endptr == size_str || *endptr != '\0' ||
+		    size == 0 || size > UINT16_MAX) {
+			ERROR_PRINTF("Invalid buffer size \'%s\' for dpbp.%u\n",
+				     size_str, dpbp_id);
+			return -EINVAL;
+		}
+
+		cfg->pools[cfg->num_dpbp].dpbp_id = (int)dpbp_id;
+		cfg->pools[cfg->num_dpbp].buffer_size = (uint16_t)size;
+		cfg->num_dpbp++;
+	}
+
+	if (cfg->num_dpbp == 0) {
+		ERROR_PRINTF("--dpbp lists no buffer pool\n");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int set_pools_dpni(struct restool *ctx, const char *usage_msg)
+{
+	struct dpni_pools_cfg_v10 pools_cfg;
+	uint16_t dpni_handle;
+	uint32_t dpni_id;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(SET_POOLS_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(SET_POOLS_OPT_HELP);
+		return 0;
+	}
+
+	if (ctx->obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = parse_object_name(ctx->obj_name, "dpni", &dpni_id);
+	if (error)
+		return error;
+
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(SET_POOLS_OPT_DPBP))) {
+		ERROR_PRINTF("--dpbp option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(SET_POOLS_OPT_DPBP);
+	error = parse_pools(ctx->cmd_option_args[SET_POOLS_OPT_DPBP],
+			    &pools_cfg);
+	if (error)
+		return error;
+
+	error = dpni_open_v10(&ctx->mc_io, ctx->cmd_flags, dpni_id,
+			      &dpni_handle);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		return error;
+	}
+
+	error = dpni_set_pools_v10(&ctx->mc_io, ctx->cmd_flags, dpni_handle,
+				   &pools_cfg);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+	}
+
+	(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
+	return error;
+}
 
-	if (error == 0 && state == -1) {
-		printf("endpoint: No object associated\n");
-	} else if (error == 0) {
-		if (strcmp(endpoint2.type, "dpsw") == 0 ||
-		    strcmp(endpoint2.type, "dpdmux") == 0) {
-			printf("endpoint: %s.%d.%d",
-				endpoint2.type, endpoint2.id,
-				endpoint2.if_id);
-		} else if (endpoint2.if_id == 0) {
-			printf("endpoint: %s.%d",
-				endpoint2.type, endpoint2.id);
-		}
+static int cmd_dpni_set_pools(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni set-pools <dpni-object> \\\n"
+		"\t\t--dpbp=<dpbp-object>:<buffer-size>[,...]\n"
+		"   e.g. restool dpni set-pools dpni.5 --dpbp=dpbp.1:2048\n"
+		"\n"
+		"Binds buffer pools to a DPNI, replacing those bound before.\n"
+		"Ingress frames are written to buffers taken from the pools,\n"
+		"the smallest whose buffers fit the frame first. Up to 8\n"
+		"pools; the DPNI must be disabled.\n"
+		"\n";
 
-		if (state == 1)
-			printf(", link is up\n");
-		else if (state == 0)
-			printf(", link is down\n");
-		else
-			printf(", link is in error state\n");
+	return set_pools_dpni(ctx, usage_msg);
+}
+
+static int set_buffer_layout_dpni(struct restool *ctx, const char *usage_msg)
+{
+	struct dpni_buffer_layout_v10 layout;
+	enum dpni_queue_type qtype;
+	uint16_t dpni_handle;
+	uint32_t dpni_id;
+	const char *queue;
+	long value;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(SET_BUF_LAYOUT_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(SET_BUF_LAYOUT_OPT_HELP);
+		return 0;
+	}
+
+	if (ctx->obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = parse_object_name(ctx->obj_name, "dpni", &dpni_id);
+	if (error)
+		return error;
+
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(SET_BUF_LAYOUT_OPT_QUEUE))) {
+		ERROR_PRINTF("--queue option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
 
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(SET_BUF_LAYOUT_OPT_QUEUE);
+	queue = ctx->cmd_option_args[SET_BUF_LAYOUT_OPT_QUEUE];
+	if (strcmp(queue, "rx") == 0) {
+		qtype = DPNI_QUEUE_RX;
+	} else if (strcmp(queue, "tx") == 0) {
+		qtype = DPNI_QUEUE_TX;
+	} else if (strcmp(queue, "tx-conf") == 0) {
+		qtype = DPNI_QUEUE_TX_CONFIRM;
 	} else {
-		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("Invalid queue \'%s\', expected rx, tx or tx-conf\n",
+			     queue);
+		return -EINVAL;
+	}
+
+	memset(&layout, 0, sizeof(layout));
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(SET_BUF_LAYOUT_OPT_HEADROOM)) {
+		ctx->cmd_option_mask &=
+			~ONE_BIT_MASK(SET_BUF_LAYOUT_OPT_HEADROOM);
+		error = get_option_value(ctx, SET_BUF_LAYOUT_OPT_HEADROOM,
+					 &value, "Invalid headroom value",
+					 0, UINT16_MAX);
+		if (error)
+			return error;
+		layout.data_head_room = (uint16_t)value;
+		layout.options |= DPNI_BUF_LAYOUT_OPT_DATA_HEAD_ROOM;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(SET_BUF_LAYOUT_OPT_DATA_ALIGN)) {
+		ctx->cmd_option_mask &=
+			~ONE_BIT_MASK(SET_BUF_LAYOUT_OPT_DATA_ALIGN);
+		error = get_option_value(ctx, SET_BUF_LAYOUT_OPT_DATA_ALIGN,
+					 &value, "Invalid data-align value",
+					 1, UINT16_MAX);
+		if (error)
+			return error;
+		if (value & (value - 1)) {
+			ERROR_PRINTF("data-align must be a power of 2\n");
+			return -EINVAL;
+		}
+		layout.data_align = (uint16_t)value;
+		layout.options |= DPNI_BUF_LAYOUT_OPT_DATA_ALIGN;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(SET_BUF_LAYOUT_OPT_TIMESTAMP)) {
+		ctx->cmd_option_mask &=
+			~ONE_BIT_MASK(SET_BUF_LAYOUT_OPT_TIMESTAMP);
+		error = get_option_value(ctx, SET_BUF_LAYOUT_OPT_TIMESTAMP,
+					 &value, "Invalid pass-timestamp value",
+					 0, 1);
+		if (error)
+			return error;
+		layout.pass_timestamp = (int)value;
+		layout.options |= DPNI_BUF_LAYOUT_OPT_TIMESTAMP;
+	}
+
+	if (ctx->cmd_option_mask &
+	    ONE_BIT_MASK(SET_BUF_LAYOUT_OPT_PARSER_RESULT)) {
+		ctx->cmd_option_mask &=
+			~ONE_BIT_MASK(SET_BUF_LAYOUT_OPT_PARSER_RESULT);
+		if (qtype != DPNI_QUEUE_RX) {
+			ERROR_PRINTF("--pass-parser-result only applies to rx\n");
+			return -EINVAL;
+		}
+		error = get_option_value(ctx, SET_BUF_LAYOUT_OPT_PARSER_RESULT,
+					 &value,
+					 "Invalid pass-parser-result value",
+					 0, 1);
+		if (error)
+			return error;
+		layout.pass_parser_result = (int)value;
+		layout.options |= DPNI_BUF_LAYOUT_OPT_PARSER_RESULT;
+	}
+
+	if (ctx->cmd_option_mask &
+	    ONE_BIT_MASK(SET_BUF_LAYOUT_OPT_FRAME_STATUS)) {
+		ctx->cmd_option_mask &=
+			~ONE_BIT_MASK(SET_BUF_LAYOUT_OPT_FRAME_STATUS);
+		error = get_option_value(ctx, SET_BUF_LAYOUT_OPT_FRAME_STATUS,
+					 &value,
+					 "Invalid pass-frame-status value",
+					 0, 1);
+		if (error)
+			return error;
+		layout.pass_frame_status = (int)value;
+		layout.options |= DPNI_BUF_LAYOUT_OPT_FRAME_STATUS;
+	}
+
+	if (layout.options == 0) {
+		ERROR_PRINTF("nothing to set\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = dpni_open_v10(&ctx->mc_io, ctx->cmd_flags, dpni_id,
+			      &dpni_handle);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
-	return 0;
+	error = dpni_set_buffer_layout_v10(&ctx->mc_io, ctx->cmd_flags,
+					   dpni_handle, qtype, &layout);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+	}
+
+	(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
+	return error;
 }
 
-static void print_mac_address(uint8_t mac_addr[6])
+static int cmd_dpni_set_buffer_layout(struct restool *ctx)
 {
-	printf("mac address: ");
-	for (int j = 0; j < 5; ++j)
-		printf("%02x:", mac_addr[j]);
-	printf("%02x\n", mac_addr[5]);
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni set-buffer-layout <dpni-object> \\\n"
+		"\t\t--queue=rx|tx|tx-conf [OPTIONS]\n"
+		"   e.g. restool dpni set-buffer-layout dpni.5 --queue=rx \\\n"
+		"\t\t--headroom=256 --data-align=64 --pass-parser-result=1\n"
+		"\n"
+		"Sets where frame data starts in the buffers of a queue type\n"
+		"and which frame annotations are written ahead of it. Settings\n"
+		"not given are left as they are; the DPNI must be disabled.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--headroom=<bytes>\n"
+		"   Room left in front of the frame data.\n"
+		"--data-align=<bytes>\n"
+		"   Alignment of the frame data start, a power of 2.\n"
+		"--pass-timestamp=0|1\n"
+		"   Write the frame timestamp annotation.\n"
+		"--pass-parser-result=0|1\n"
+		"   Write the parse result annotation, rx only.\n"
+		"--pass-frame-status=0|1\n"
+		"   Write the frame status annotation.\n"
+		"\n";
+
+	return set_buffer_layout_dpni(ctx, usage_msg);
 }
 
-static int print_dpni_attr_v9(uint32_t dpni_id,
-			      struct dprc_obj_desc *target_obj_desc)
+/* "all" or a single value below limit */
+static int parse_dpni_range(struct restool *ctx, int option, const char *what,
+			    unsigned int limit, unsigned int *first,
+			    unsigned int *last)
 {
-	uint16_t dpni_handle;
+	char error_msg[64];
+	long value;
 	int error;
-	int i;
-	struct dpni_attr_v9 dpni_attr;
-	struct dpni_extended_cfg ext_cfg;
-	uint8_t mac_addr[6];
-	bool dpni_opened = false;
-	struct dpni_link_state link_state;
 
-	error = dpni_open(&restool.mc_io, 0, dpni_id, &dpni_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+	if (strcmp(ctx->cmd_option_args[option], "all") == 0) {
+		*first = 0;
+		*last = limit - 1;
+		return 0;
 	}
-	dpni_opened = true;
-	if (0 == dpni_handle) {
-		DEBUG_PRINTF(
-			"dpni_open() returned invalid handle (auth 0) for dpni.%u\n",
-			dpni_id);
-		error = -ENOENT;
-		goto out;
+
+	snprintf(error_msg, sizeof(error_msg),
+		 "Invalid %s value, expected all or 0-%u", what, limit - 1);
+	error = get_option_value(ctx, option, &value, error_msg, 0, limit - 1);
+	if (error)
+		return error;
+
+	*first = (unsigned int)value;
+	*last = (unsigned int)value;
+	return 0;
+}
+
+static int parse_congestion_units(const char *str,
+				  enum dpni_congestion_unit *units)
+{
+	if (strcmp(str, "bytes") == 0) {
+		*units = DPNI_CONGESTION_UNIT_BYTES;
+	} else if (strcmp(str, "frames") == 0) {
+		*units = DPNI_CONGESTION_UNIT_FRAMES;
+	} else {
+		ERROR_PRINTF("Invalid units \'%s\', expected bytes or frames\n",
+			     str);
+		return -EINVAL;
 	}
 
-	memset(&dpni_attr, 0, sizeof(dpni_attr));
+	return 0;
+}
 
-	error = dpni_get_attributes_v9(&restool.mc_io, 0, dpni_handle,
-				       &dpni_attr, &ext_cfg);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+static const char *congestion_units_str(enum dpni_congestion_unit units)
+{
+	return units == DPNI_CONGESTION_UNIT_FRAMES ? "frames" : "bytes";
+}
+
+static int open_dpni(struct restool *ctx, const char *usage_msg,
+		     uint16_t *dpni_handle)
+{
+	uint32_t dpni_id;
+	int error;
+
+	if (ctx->obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
 	}
 
-	assert(dpni_id == (uint32_t)dpni_attr.id);
-	assert(DPNI_MAX_TC >= dpni_attr.max_tcs);
+	error = parse_object_name(ctx->obj_name, "dpni", &dpni_id);
+	if (error)
+		return error;
 
-	error = dpni_get_primary_mac_addr(&restool.mc_io, 0,
-					dpni_handle, mac_addr);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+	error = dpni_open_v10(&ctx->mc_io, ctx->cmd_flags, dpni_id,
+			      dpni_handle);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 	}
 
-	memset(&link_state, 0, sizeof(link_state));
-	error = dpni_get_link_state(&restool.mc_io, 0, dpni_handle,
-					&link_state);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+	return error;
+}
+
+static int open_dpni_attr(struct restool *ctx, const char *usage_msg,
+			  uint16_t *dpni_handle, struct dpni_attr_v10 *attr)
+{
+	int error;
+
+	error = open_dpni(ctx, usage_msg, dpni_handle);
+	if (error)
+		return error;
+
+	error = dpni_get_attributes_v10(&ctx->mc_io, ctx->cmd_flags,
+					*dpni_handle, attr);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags,
+				     *dpni_handle);
 	}
 
-	printf("dpni version: %u.%u\n", dpni_attr.version.major,
-	       dpni_attr.version.minor);
-	printf("dpni id: %d\n", dpni_attr.id);
-	printf("plugged state: %splugged\n",
-		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	print_dpni_endpoint(dpni_id);
-	printf("link status: %d - ", link_state.up);
-	link_state.up == 0 ? printf("down\n") :
-	link_state.up == 1 ? printf("up\n") : printf("error state\n");
-	print_mac_address(mac_addr);
-	printf("dpni_attr.options value is: %#lx\n",
-	       (unsigned long)dpni_attr.options);
-	print_dpni_options(dpni_attr.options);
-	printf("max senders: %u\n", (uint32_t)dpni_attr.max_senders);
-	printf("max traffic classes: %u\n", (uint32_t)dpni_attr.max_tcs);
-	for (i = 0; i < dpni_attr.max_tcs; i++)
-		printf("\ttc[%d]: max_dist=%d, max_fs_entries=%d\n",
-			i,
-			ext_cfg.tc_cfg[i].max_dist,
-			dpni_attr.options & DPNI_OPT_DIST_FS ?
-				ext_cfg.tc_cfg[i].max_fs_entries : 0);
-	printf("max unicast filters: %u\n",
-	       (uint32_t)dpni_attr.max_unicast_filters);
-	printf("max multicast filters: %u\n",
-	       (uint32_t)dpni_attr.max_multicast_filters);
-	printf("max vlan filters: %u\n", (uint32_t)dpni_attr.max_vlan_filters);
-	printf("max QoS entries: %u\n", (uint32_t)dpni_attr.max_qos_entries);
-	printf("max QoS key size: %u\n", (uint32_t)dpni_attr.max_qos_key_size);
-	printf("max distribution key size: %u\n",
-	       (uint32_t)dpni_attr.max_dist_key_size);
-	printf("max policers: %u\n", (uint32_t)dpni_attr.max_policers);
-	printf("max congestion control: %u\n",
-		(uint32_t)dpni_attr.max_congestion_ctrl);
+	return error;
+}
 
-	printf("max_dist per RX traffic class:\n");
-	for (int k = 0; k < dpni_attr.max_tcs; ++k)
-		printf("\tclass %d's max_dist: %u\n", k,
-		       (uint32_t)ext_cfg.tc_cfg[k].max_dist);
+static int set_taildrop_dpni(struct restool *ctx, const char *usage_msg)
+{
+	enum dpni_congestion_point cg_point = DPNI_CP_GROUP;
+	unsigned int tc, first_tc = 0, last_tc = 0;
+	unsigned int q, first_q = 0, last_q = 0;
+	struct dpni_taildrop_v10 taildrop;
+	struct dpni_attr_v10 attr;
+	uint16_t dpni_handle;
+	long value;
+	int error;
 
-	printf("max_fs_entries per RX traffic class:\n");
-	for (int m = 0; m < dpni_attr.max_tcs; ++m)
-		printf("\tclass %d's max_fs_entries: %u\n", m,
-		       (uint32_t)ext_cfg.tc_cfg[m].max_fs_entries);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TAILDROP_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TAILDROP_OPT_HELP);
+		return 0;
+	}
 
-	printf("max_reass_frm_size: %u\n",
-		(uint32_t)ext_cfg.ipr_cfg.max_reass_frm_size);
-	printf("min_frag_size_ipv4: %u\n",
-		(uint32_t)ext_cfg.ipr_cfg.min_frag_size_ipv4);
-	printf("min_frag_size_ipv6: %u\n",
-		(uint32_t)ext_cfg.ipr_cfg.min_frag_size_ipv6);
-	printf("max_open_frames_ipv4: %u\n",
-		(uint32_t)ext_cfg.ipr_cfg.max_open_frames_ipv4);
-	printf("max_open_frames_ipv6: %u\n",
-		(uint32_t)ext_cfg.ipr_cfg.max_open_frames_ipv6);
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(TAILDROP_OPT_THRESHOLD))) {
+		ERROR_PRINTF("--threshold option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	memset(&taildrop, 0, sizeof(taildrop));
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(TAILDROP_OPT_THRESHOLD);
+	error = get_option_value(ctx, TAILDROP_OPT_THRESHOLD, &value,
+				 "Invalid threshold value", 0, UINT32_MAX);
+	if (error)
+		return error;
+	taildrop.threshold = (uint32_t)value;
+	taildrop.enable = taildrop.threshold != 0;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TAILDROP_OPT_QUEUE))
+		cg_point = DPNI_CP_QUEUE;
+
+	/* queue thresholds only count bytes, TC group ones count frames */
+	taildrop.units = cg_point == DPNI_CP_QUEUE ?
+			 DPNI_CONGESTION_UNIT_BYTES :
+			 DPNI_CONGESTION_UNIT_FRAMES;
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TAILDROP_OPT_UNITS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TAILDROP_OPT_UNITS);
+		error = parse_congestion_units(
+				ctx->cmd_option_args[TAILDROP_OPT_UNITS],
+				&taildrop.units);
+		if (error)
+			return error;
+	}
 
-	print_obj_label(target_obj_desc);
+	if (cg_point == DPNI_CP_QUEUE &&
+	    taildrop.units != DPNI_CONGESTION_UNIT_BYTES) {
+		ERROR_PRINTF("queue taildrop thresholds are in bytes\n");
+		return -EINVAL;
+	}
 
-	error = 0;
+	error = open_dpni_attr(ctx, usage_msg, &dpni_handle, &attr);
+	if (error)
+		return error;
 
-out:
-	if (dpni_opened) {
-		int error2;
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TAILDROP_OPT_TC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TAILDROP_OPT_TC);
+		error = parse_dpni_range(ctx, TAILDROP_OPT_TC, "tc",
+					 attr.num_rx_tcs, &first_tc, &last_tc);
+		if (error)
+			goto out;
+	}
 
-		error2 = dpni_close(&restool.mc_io, 0, dpni_handle);
-		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
-			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
-			if (error == 0)
-				error = error2;
+	if (cg_point == DPNI_CP_QUEUE) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TAILDROP_OPT_QUEUE);
+		error = parse_dpni_range(ctx, TAILDROP_OPT_QUEUE, "queue",
+					 attr.num_queues, &first_q, &last_q);
+		if (error)
+			goto out;
+	}
+
+	for (tc = first_tc; tc <= last_tc; tc++) {
+		for (q = first_q; q <= last_q; q++) {
+			error = dpni_set_taildrop_v10(&ctx->mc_io,
+						      ctx->cmd_flags,
+						      dpni_handle, cg_point,
+						      DPNI_QUEUE_RX, tc, q,
+						      &taildrop);
+			if (error) {
+				ctx->mc_status = flib_error_to_mc_status(error);
+				ERROR_PRINTF("MC error: %s (status %#x)\n",
+					     mc_status_to_string(ctx->mc_status),
+					     ctx->mc_status);
+				goto out;
+			}
 		}
 	}
 
+out:
+	(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
 	return error;
 }
 
-static void dpni_print_stats(const char *strings[],
-			     union dpni_statistics_v10 dpni_stats)
+static int cmd_dpni_set_taildrop(struct restool *ctx)
 {
-	uint64_t *stat;
-	int i;
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni set-taildrop <dpni-object> \\\n"
+		"\t\t--threshold=<number> [OPTIONS]\n"
+		"   e.g. restool dpni set-taildrop dpni.5 --tc=all \\\n"
+		"\t\t--queue=all --threshold=262144\n"
+		"\n"
+		"Sets the Rx fill level above which frames are dropped, for\n"
+		"each queue of a traffic class or, without --queue, for the\n"
+		"traffic class as a whole (the whole DPNI when it was created\n"
+		"with DPNI_OPT_SHARED_CONGESTION).\n"
+		"\n"
+		"--threshold=<number>\n"
+		"   Drop threshold, 0 to disable taildrop.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--tc=<number>|all\n"
+		"   Rx traffic class, 0 by default.\n"
+		"--queue=<number>|all\n"
+		"   Rx queue of the traffic class.\n"
+		"--units=bytes|frames\n"
+		"   Unit of the threshold; queues count bytes only. frames by\n"
+		"   default for a traffic class.\n"
+		"\n";
 
-	stat = (uint64_t *)&dpni_stats.raw;
-	for (i = 0; i < DPNI_STATS_PER_PAGE_V10; i++) {
-		if (strcmp(strings[i], "\0") == 0)
-			break;
-		printf("%s: %lu\n", strings[i], *stat);
-		stat++;
-	}
+	return set_taildrop_dpni(ctx, usage_msg);
 }
 
-static int print_dpni_attr_v10(uint32_t dpni_id,
-			      struct dprc_obj_desc *target_obj_desc)
+static int show_taildrop(struct restool *ctx, uint16_t dpni_handle,
+			 enum dpni_congestion_point cg_point,
+			 unsigned int tc, unsigned int queue)
 {
-	struct dpni_attr_v10 dpni_attr;
-	union dpni_statistics_v10 dpni_stats;
-	uint16_t dpni_handle, dpni_major, dpni_minor;
-	struct dpni_link_state_v10 link_state;
-	bool dpni_opened = false;
-	uint8_t mac_addr[6];
-	int error = 0;
-	int error2;
-	unsigned int page;
+	struct dpni_taildrop_v10 taildrop;
+	char point[16];
+	int error;
 
-	error = dpni_open_v10(&restool.mc_io, 0, dpni_id, &dpni_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+	memset(&taildrop, 0, sizeof(taildrop));
+	error = dpni_get_taildrop_v10(&ctx->mc_io, ctx->cmd_flags, dpni_handle,
+				      cg_point, DPNI_QUEUE_RX, tc, queue,
+				      &taildrop);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		return error;
 	}
-	dpni_opened = true;
-	if (0 == dpni_handle) {
-		DEBUG_PRINTF(
-			"dpni_open() returned invalid handle (auth 0) for dpni.%u\n",
-			dpni_id);
-		error = -ENOENT;
-		goto out;
+
+	if (cg_point == DPNI_CP_GROUP)
+		snprintf(point, sizeof(point), "group");
+	else
+		snprintf(point, sizeof(point), "%u", queue);
+
+	output_begin_object(NULL);
+	if (output_is_json()) {
+		output_uint("tc", "tc", tc);
+		output_field("queue", "queue", "%s", point);
+		output_bool("enabled", "enabled", taildrop.enable,
+			    "%d", taildrop.enable ? 1 : 0);
+		output_uint("threshold", "threshold", taildrop.threshold);
+		output_field("units", "units", "%s",
+			     congestion_units_str(taildrop.units));
+	} else if (taildrop.enable) {
+		output_printf("tc %u queue %s: %u %s\n", tc, point,
+			      taildrop.threshold,
+			      congestion_units_str(taildrop.units));
+	} else {
+		output_printf("tc %u queue %s: disabled\n", tc, point);
 	}
+	output_end_object();
+
+	return 0;
+}
 
-	memset(&dpni_attr, 0, sizeof(dpni_attr));
-	error = dpni_get_attributes_v10(&restool.mc_io, 0,
-					dpni_handle, &dpni_attr);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+static int get_taildrop_dpni(struct restool *ctx, const char *usage_msg)
+{
+	unsigned int tc, first_tc, last_tc;
+	unsigned int q, first_q, last_q;
+	struct dpni_attr_v10 attr;
+	uint16_t dpni_handle;
+	bool group = true;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TAILDROP_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TAILDROP_OPT_HELP);
+		return 0;
 	}
 
-	error = dpni_get_api_version_v10(&restool.mc_io, 0,
-					 &dpni_major, &dpni_minor);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+	error = open_dpni_attr(ctx, usage_msg, &dpni_handle, &attr);
+	if (error)
+		return error;
+
+	first_tc = 0;
+	last_tc = attr.num_rx_tcs - 1;
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TAILDROP_OPT_TC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TAILDROP_OPT_TC);
+		error = parse_dpni_range(ctx, TAILDROP_OPT_TC, "tc",
+					 attr.num_rx_tcs, &first_tc, &last_tc);
+		if (error)
+			goto out;
 	}
 
-	error = dpni_get_primary_mac_addr_v10(&restool.mc_io, 0,
-					      dpni_handle, mac_addr);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+	first_q = 0;
+	last_q = attr.num_queues - 1;
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TAILDROP_OPT_QUEUE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TAILDROP_OPT_QUEUE);
+		error = parse_dpni_range(ctx, TAILDROP_OPT_QUEUE, "queue",
+					 attr.num_queues, &first_q, &last_q);
+		if (error)
+			goto out;
+		group = false;
 	}
 
-	memset(&link_state, 0, sizeof(link_state));
-	error = dpni_get_link_state_v10(&restool.mc_io, 0, dpni_handle,
-					&link_state);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+	output_printf("taildrop:\n");
+	output_begin_array("taildrop");
+	for (tc = first_tc; tc <= last_tc && !error; tc++) {
+		if (group)
+			error = show_taildrop(ctx, dpni_handle, DPNI_CP_GROUP,
+					      tc, 0);
+
+		for (q = first_q; q <= last_q && !error; q++)
+			error = show_taildrop(ctx, dpni_handle, DPNI_CP_QUEUE,
+					      tc, q);
 	}
+	output_end_array();
 
-	printf("dpni version: %u.%u\n", dpni_major, dpni_minor);
-	printf("dpni id: %d\n", dpni_id);
+out:
+	(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
+	return error;
+}
 
-	printf("plugged state: %splugged\n",
-		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	print_dpni_endpoint(dpni_id);
-	printf("link status: %d - ", link_state.up);
-	link_state.up == 0 ? printf("down\n") :
-	link_state.up == 1 ? printf("up\n") : printf("error state\n");
+static int cmd_dpni_get_taildrop(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni get-taildrop <dpni-object> [OPTIONS]\n"
+		"\n"
+		"Shows the Rx taildrop thresholds in effect, per traffic class\n"
+		"(queue \"group\") and per queue.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--tc=<number>|all\n"
+		"   Rx traffic class, all by default.\n"
+		"--queue=<number>|all\n"
+		"   Show only the given queues, not the traffic class.\n"
+		"\n";
 
-	print_mac_address(mac_addr);
+	return get_taildrop_dpni(ctx, usage_msg);
+}
 
-	printf("dpni_attr.options value is: %#lx\n",
-	       (unsigned long)dpni_attr.options);
-	print_dpni_options_v10(dpni_attr.options);
+static const struct {
+	const char *name;
+	uint16_t mode;
+} cong_notify_modes[] = {
+	{ "enter", DPNI_CONG_OPT_NOTIFY_DEST_ON_ENTER },
+	{ "exit", DPNI_CONG_OPT_NOTIFY_DEST_ON_EXIT },
+	{ "no-coalescing", DPNI_CONG_OPT_INTR_COALESCING_DISABLE },
+	{ "flow-control", DPNI_CONG_OPT_FLOW_CONTROL },
+};
 
-	printf("num_queues: %u\n", (uint32_t)dpni_attr.num_queues);
-	printf("num_rx_tcs: %u\n", (uint32_t)dpni_attr.num_rx_tcs);
-	printf("num_tx_tcs: %u\n", (uint32_t)dpni_attr.num_tx_tcs);
-	printf("mac_entries: %u\n",
-	       (uint32_t)dpni_attr.mac_filter_entries);
-	printf("vlan_entries: %u\n",
-	       (uint32_t)dpni_attr.vlan_filter_entries);
-	printf("qos_entries: %u\n", (uint32_t)dpni_attr.qos_entries);
-	printf("fs_entries: %u\n", (uint32_t)dpni_attr.fs_entries);
-	printf("qos_key_size: %u\n", (uint32_t)dpni_attr.qos_key_size);
-	printf("fs_key_size: %u\n", (uint32_t)dpni_attr.fs_key_size);
+static int parse_cong_notify(const char *str, uint16_t *mode)
+{
+	char buf[128];
+	char *item, *saveptr;
+	unsigned int i;
 
-	for (page = 0; page < 3; page++) {
-		error = dpni_get_statistics_v10(&restool.mc_io, 0,
-						dpni_handle, page, 0, &dpni_stats);
-		dpni_print_stats(dpni_stats_v10[page], dpni_stats);
+	if (strlen(str) >= sizeof(buf)) {
+		ERROR_PRINTF("--notify value too long\n");
+		return -EINVAL;
 	}
 
-	print_obj_label(target_obj_desc);
-
-out:
-	if (dpni_opened) {
+	strcpy(buf, str);
+	*mode = 0;
+	for (item = strtok_r(buf, ",", &saveptr); item != NULL;
+	     item = strtok_r(NULL, ",", &saveptr)) {
+		for (i = 0; i < ARRAY_SIZE(cong_notify_modes); i++) {
+			if (strcmp(item, cong_notify_modes[i].name) == 0)
+				break;
+		}
 
-		error2 = dpni_close_v10(&restool.mc_io, 0, dpni_handle);
-		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
-			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
-			if (error == 0)
-				error = error2;
+		if (i == ARRAY_SIZE(cong_notify_modes)) {
+			ERROR_PRINTF("Invalid notify event \'%s\', expected enter, exit, no-coalescing or flow-control\n",
+				     item);
+			return -EINVAL;
 		}
+
+		*mode |= cong_notify_modes[i].mode;
 	}
 
-	return error;
+	return 0;
 }
 
-static int print_dpni_info(uint32_t dpni_id, int mc_fw_version)
+static int parse_cong_dest(const char *str, struct dpni_dest_cfg_v10 *dest)
 {
+	uint32_t dest_id;
 	int error;
-	struct dprc_obj_desc target_obj_desc;
-	uint32_t target_parent_dprc_id;
-	bool found = false;
-
-	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0, dpni_id,
-				"dpni", &target_obj_desc,
-				&target_parent_dprc_id, &found);
-	if (error < 0)
-		goto out;
 
-	if (strcmp(target_obj_desc.type, "dpni")) {
-		printf("dpni.%d does not exist\n", dpni_id);
-		return -EINVAL;
+	if (strcmp(str, "none") == 0) {
+		dest->dest_type = DPNI_DEST_NONE;
+		return 0;
 	}
 
-	if (mc_fw_version == MC_FW_VERSION_9)
-		error = print_dpni_attr_v9(dpni_id, &target_obj_desc);
-	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = print_dpni_attr_v10(dpni_id, &target_obj_desc);
-	if (error < 0)
-		goto out;
-
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpni_ops);
+	if (strncmp(str, "dpio.", strlen("dpio.")) == 0) {
+		dest->dest_type = DPNI_DEST_DPIO;
+		error = parse_object_name(str, "dpio", &dest_id);
+	} else {
+		dest->dest_type = DPNI_DEST_DPCON;
+		error = parse_object_name(str, "dpcon", &dest_id);
 	}
+	if (error)
+		return error;
 
-out:
-	return error;
+	dest->dest_id = (int)dest_id;
+	return 0;
 }
 
-static int info_dpni(int mc_fw_version)
+static int set_congestion_notification_dpni(struct restool *ctx,
+					    const char *usage_msg)
 {
-	static const char usage_msg[] =
-		"\n"
-		"Usage: restool dpni info <dpni-object> [--verbose]\n"
-		"\n"
-		"OPTIONS:\n"
-		"--verbose\n"
-		"   Shows extended/verbose information about the object\n"
-		"\n"
-		"EXAMPLE:\n"
-		"Display information about dpni.5:\n"
-		"   $ restool dpni info dpni.5\n"
-		"\n";
-
-	uint32_t obj_id;
+	struct dpni_congestion_notification_cfg_v10 cfg;
+	unsigned int tc, first_tc = 0, last_tc = 0;
+	struct dpni_attr_v10 attr;
+	uint16_t dpni_handle;
+	long value;
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CONG_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
-		error = 0;
-		goto out;
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CONG_OPT_HELP);
+		return 0;
 	}
 
-	if (restool.obj_name == NULL) {
-		ERROR_PRINTF("<object> argument missing\n");
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(CONG_OPT_ENTRY)) ||
+	    !(ctx->cmd_option_mask & ONE_BIT_MASK(CONG_OPT_EXIT))) {
+		ERROR_PRINTF("--threshold-entry and --threshold-exit are required\n");
 		puts(usage_msg);
-		error = -EINVAL;
-		goto out;
+		return -EINVAL;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpni", &obj_id);
-	if (error < 0)
-		goto out;
+	memset(&cfg, 0, sizeof(cfg));
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(CONG_OPT_ENTRY);
+	error = get_option_value(ctx, CONG_OPT_ENTRY, &value,
+				 "Invalid threshold-entry value",
+				 0, UINT32_MAX);
+	if (error)
+		return error;
+	cfg.threshold_entry = (uint32_t)value;
 
-	error = print_dpni_info(obj_id, mc_fw_version);
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(CONG_OPT_EXIT);
+	error = get_option_value(ctx, CONG_OPT_EXIT, &value,
+				 "Invalid threshold-exit value",
+				 0, cfg.threshold_entry);
+	if (error)
+		return error;
+	cfg.threshold_exit = (uint32_t)value;
 
-out:
-	return error;
-}
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CONG_OPT_UNITS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CONG_OPT_UNITS);
+		error = parse_congestion_units(
+				ctx->cmd_option_args[CONG_OPT_UNITS],
+				&cfg.units);
+		if (error)
+			return error;
+	}
 
-static int cmd_dpni_info_v9(void)
-{
-	return info_dpni(MC_FW_VERSION_9);
-}
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CONG_OPT_DEST)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CONG_OPT_DEST);
+		error = parse_cong_dest(ctx->cmd_option_args[CONG_OPT_DEST],
+					&cfg.dest_cfg);
+		if (error)
+			return error;
+	}
 
-static int cmd_dpni_info_v10(void)
-{
-	return info_dpni(MC_FW_VERSION_10);
-}
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CONG_OPT_PRIORITY)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CONG_OPT_PRIORITY);
+		error = get_option_value(ctx, CONG_OPT_PRIORITY, &value,
+					 "Invalid priority value", 0, 7);
+		if (error)
+			return error;
+		cfg.dest_cfg.priority = (uint8_t)value;
+	}
 
-static int parse_dpni_mac_addr(char *mac_addr_str, uint8_t *mac_addr)
-{
-	char *cursor = NULL;
-	char *endptr;
-	char *mac_str = strtok_r(mac_addr_str, ":", &cursor);
-	long val;
-	int i = 0;
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CONG_OPT_NOTIFY)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CONG_OPT_NOTIFY);
+		error = parse_cong_notify(ctx->cmd_option_args[CONG_OPT_NOTIFY],
+					  &cfg.notification_mode);
+		if (error)
+			return error;
+	}
 
-	while (mac_str != NULL) {
-		if (i >= 6) { /* mac address is more than 6 parts */
-			ERROR_PRINTF("Invalid MAC address.\n");
-			ERROR_PRINTF(
-				"Please enter 48 bits MAC address, eg. 00:0e:0c:55:12:03\n");
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CONG_OPT_MESSAGE_CTX)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CONG_OPT_MESSAGE_CTX);
+		errno = 0;
+		cfg.message_ctx = strtoull(
+				ctx->cmd_option_args[CONG_OPT_MESSAGE_CTX],
+				NULL, 0);
+		if (errno != 0) {
+			ERROR_PRINTF("Invalid message-ctx value\n");
 			return -EINVAL;
 		}
+	}
 
-		errno = 0;
-		val = strtol(mac_str, &endptr, 16);
+	if ((cfg.notification_mode & (DPNI_CONG_OPT_NOTIFY_DEST_ON_ENTER |
+				      DPNI_CONG_OPT_NOTIFY_DEST_ON_EXIT)) &&
+	    cfg.dest_cfg.dest_type == DPNI_DEST_NONE) {
+		ERROR_PRINTF("--notify=enter or exit needs a --dest\n");
+		return -EINVAL;
+	}
 
-		if (STRTOL_ERROR(mac_str, endptr, val, errno) ||
-		    (val < 0 || val > UINT8_MAX)) {
-			ERROR_PRINTF("Invalid MAC address.\n");
-			ERROR_PRINTF(
-				"Please enter 48 bits MAC address, eg. 00:0e:0c:55:12:03\n");
-			return -EINVAL;
-		}
+	error = open_dpni_attr(ctx, usage_msg, &dpni_handle, &attr);
+	if (error)
+		return error;
 
-		mac_addr[i] = (uint8_t)val;
-		mac_str = strtok_r(NULL, ":", &cursor);
-		++i;
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CONG_OPT_TC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CONG_OPT_TC);
+		error = parse_dpni_range(ctx, CONG_OPT_TC, "tc",
+					 attr.num_rx_tcs, &first_tc, &last_tc);
+		if (error)
+			goto out;
 	}
 
-	if (6 != i) { /* mac address is less than 6 parts */
-		ERROR_PRINTF("Invalid MAC address.\n");
-		ERROR_PRINTF(
-			"Please enter 48 bits MAC address, eg. 00:0e:0c:55:12:03\n");
-		return -EINVAL;
+	for (tc = first_tc; tc <= last_tc; tc++) {
+		error = dpni_set_congestion_notification_v10(&ctx->mc_io,
+							     ctx->cmd_flags,
+							     dpni_handle,
+							     DPNI_QUEUE_RX,
+							     tc, &cfg);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			break;
+		}
 	}
 
-	return 0;
+out:
+	(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
+	return error;
 }
 
-static int parse_dpni_max_dist_per_tc_v9(char *max_dist_per_tc_str,
-	struct dpni_extended_cfg *dpni_extended_cfg, uint8_t max_tcs)
+static int cmd_dpni_set_congestion_notification(struct restool *ctx)
 {
-	char *cursor = NULL;
-	char *endptr;
-	char *max_dist_str = strtok_r(max_dist_per_tc_str, ",", &cursor);
-	int i = 0;
-	long val;
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni set-congestion-notification <dpni-object> \\\n"
+		"\t\t--threshold-entry=<number> --threshold-exit=<number> \\\n"
+		"\t\t[OPTIONS]\n"
+		"   e.g. restool dpni set-congestion-notification dpni.5 \\\n"
+		"\t\t--tc=all --units=frames --threshold-entry=1024 \\\n"
+		"\t\t--threshold-exit=768 --notify=flow-control\n"
+		"\n"
+		"Sets when the Rx queues of a traffic class are counted as\n"
+		"congested and what is done on entering and leaving that\n"
+		"state.\n"
+		"\n"
+		"--threshold-entry=<number>\n"
+		"   Fill level the congestion state is entered at, 0 to\n"
+		"   disable.\n"
+		"--threshold-exit=<number>\n"
+		"   Fill level the congestion state is left at, at most the\n"
+		"   entry threshold.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--tc=<number>|all\n"
+		"   Rx traffic class, 0 by default.\n"
+		"--units=bytes|frames\n"
+		"   Unit of the thresholds, bytes by default.\n"
+		"--notify=<event>[,<event>...]\n"
+		"   enter, exit: send a notification to --dest.\n"
+		"   no-coalescing: raise the portal interrupt immediately.\n"
+		"   flow-control: send pause frames while congested.\n"
+		"--dest=none|<dpio-object>|<dpcon-object>\n"
+		"   Where enter and exit notifications are sent.\n"
+		"--priority=<number>\n"
+		"   Priority of the notifications in the --dest channel.\n"
+		"--message-ctx=<number>\n"
+		"   Context value carried by the notifications.\n"
+		"\n";
 
-	while (max_dist_str != NULL) {
-		if (i >= DPNI_MAX_TC) {
-			ERROR_PRINTF("Invalid max-dist-per-tc\n");
-			ERROR_PRINTF("maximum number of traffic class <= %d\n",
-			     DPNI_MAX_TC);
-			return -EINVAL;
-		}
+	return set_congestion_notification_dpni(ctx, usage_msg);
+}
 
-		errno = 0;
-		val = strtol(max_dist_str, &endptr, 0);
+static void print_congestion_notification(unsigned int tc,
+		const struct dpni_congestion_notification_cfg_v10 *cfg)
+{
+	const struct dpni_dest_cfg_v10 *dest = &cfg->dest_cfg;
+	unsigned int i;
 
-		if (STRTOL_ERROR(max_dist_str, endptr, val, errno) ||
-		    (val < 0 || val > MAX_DIST_SIZE)) {
-			ERROR_PRINTF("Invalid dist-size.\n");
-			return -EINVAL;
+	output_begin_object(NULL);
+	if (output_is_json())
+		output_uint("tc", "tc", tc);
+	else
+		output_printf("tc %u:\n", tc);
+	output_field("units", "\tunits",
+		     "%s", congestion_units_str(cfg->units));
+	output_uint("threshold_entry", "\tthreshold entry",
+		    cfg->threshold_entry);
+	output_uint("threshold_exit", "\tthreshold exit", cfg->threshold_exit);
+	if (dest->dest_type == DPNI_DEST_DPIO)
+		output_field("dest", "\tdest", "dpio.%d", dest->dest_id);
+	else if (dest->dest_type == DPNI_DEST_DPCON)
+		output_field("dest", "\tdest", "dpcon.%d", dest->dest_id);
+	else
+		output_field("dest", "\tdest", "none");
+	output_uint("priority", "\tpriority", (uint32_t)dest->priority);
+	output_hex("message_ctx", "\tmessage ctx",
+		   (unsigned long long)cfg->message_ctx);
+
+	output_printf("\tnotify:");
+	output_begin_array("notify");
+	for (i = 0; i < ARRAY_SIZE(cong_notify_modes); i++) {
+		if (cfg->notification_mode & cong_notify_modes[i].mode) {
+			if (output_is_json())
+				output_item("%s", cong_notify_modes[i].name);
+			else
+				output_printf(" %s", cong_notify_modes[i].name);
 		}
+	}
+	output_end_array();
+	output_printf("\n");
+	output_end_object();
+}
 
-		dpni_extended_cfg->tc_cfg[i].max_dist = (uint16_t)val;
-		max_dist_str = strtok_r(NULL, ",", &cursor);
-		++i;
+static int get_congestion_notification_dpni(struct restool *ctx,
+					    const char *usage_msg)
+{
+	struct dpni_congestion_notification_cfg_v10 cfg;
+	unsigned int tc, first_tc, last_tc;
+	struct dpni_attr_v10 attr;
+	uint16_t dpni_handle;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CONG_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CONG_OPT_HELP);
+		return 0;
 	}
 
-	if (max_tcs != i) {
-		ERROR_PRINTF(
-			"size of max_dist_per_tc does not match max_tcs: %u\n",
-			(unsigned int)max_tcs);
-		return -EINVAL;
+	error = open_dpni_attr(ctx, usage_msg, &dpni_handle, &attr);
+	if (error)
+		return error;
+
+	first_tc = 0;
+	last_tc = attr.num_rx_tcs - 1;
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CONG_OPT_TC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CONG_OPT_TC);
+		error = parse_dpni_range(ctx, CONG_OPT_TC, "tc",
+					 attr.num_rx_tcs, &first_tc, &last_tc);
+		if (error)
+			goto out;
 	}
 
-	return 0;
+	output_printf("congestion notification:\n");
+	output_begin_array("congestion_notification");
+	for (tc = first_tc; tc <= last_tc; tc++) {
+		memset(&cfg, 0, sizeof(cfg));
+		error = dpni_get_congestion_notification_v10(&ctx->mc_io,
+							     ctx->cmd_flags,
+							     dpni_handle,
+							     DPNI_QUEUE_RX,
+							     tc, &cfg);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			break;
+		}
+
+		print_congestion_notification(tc, &cfg);
+	}
+	output_end_array();
+
+out:
+	(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
+	return error;
 }
 
-static int parse_dpni_max_fs_entries_per_tc(char *max_fs_entries_per_tc_str,
-	struct dpni_extended_cfg *dpni_extended_cfg, uint8_t max_tcs)
+static int cmd_dpni_get_congestion_notification(struct restool *ctx)
 {
-	char *cursor = NULL;
-	char *endptr;
-	char *max_fs_entries_str =
-			strtok_r(max_fs_entries_per_tc_str, ",", &cursor);
-	int i = 0;
-	long val;
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni get-congestion-notification <dpni-object> \\\n"
+		"\t\t[--tc=<number>|all]\n"
+		"\n"
+		"Shows the Rx congestion notification settings in effect, for\n"
+		"all traffic classes by default.\n"
+		"\n";
 
-	while (max_fs_entries_str != NULL) {
-		if (i >= DPNI_MAX_TC) {
-			ERROR_PRINTF("Invalid max-dist-per-tc\n");
-			ERROR_PRINTF("maximum number of traffic class <= %d\n",
-			     DPNI_MAX_TC);
+	return get_congestion_notification_dpni(ctx, usage_msg);
+}
+
+/* <mode>[,<mode>...], one per Tx TC: strict, a:<weight> or b:<weight> */
+static int parse_tx_sched(const char *str, unsigned int num_tcs,
+			  struct dpni_tx_priorities_cfg_v10 *cfg)
+{
+	struct dpni_tx_schedule_cfg_v10 *sched;
+	char buf[128];
+	char *item, *saveptr, *endptr;
+	unsigned long weight;
+	unsigned int tc = 0;
+
+	if (strlen(str) >= sizeof(buf)) {
+		ERROR_PRINTF("--sched value too long\n");
+		return -EINVAL;
+	}
+
+	strcpy(buf, str);
+	for (item = strtok_r(buf, ",", &saveptr); item != NULL;
+	     item = strtok_r(NULL, ",", &saveptr), tc++) {
+		if (tc == num_tcs) {
+			ERROR_PRINTF("--sched lists more than the %u Tx traffic classes\n",
+				     num_tcs);
 			return -EINVAL;
 		}
 
-		errno = 0;
-		val = strtol(max_fs_entries_str, &endptr, 0);
+		sched = &cfg->tc_sched[tc];
+		if (strcmp(item, "strict") == 0) {
+			sched->mode = DPNI_TX_SCHED_STRICT_PRIORITY;
+			continue;
+		}
 
-		if (STRTOL_ERROR(max_fs_entries_str, endptr, val, errno) ||
-		    (val < 0 || val > MAX_DIST_SIZE)) {
-			ERROR_PRINTF("Invalid dist-size.\n");
+		if ((item[0] != 'a' && item[0] != 'b') || item[1] != ':') {
+			ERROR_PRINTF("tc %u: expected strict, a:<weight> or b:<weight>, got \'%s\'\n",
+				     tc, item);
+			return -EINVAL;
+		}
+
+		sched->mode = item[0] == 'a' ? DPNI_TX_SCHED_WEIGHTED_A :
+					       DPNI_TX_SCHED_WEIGHTED_B;
+		errno = 0;
+		weight = strtoul(item + 2, &endptr, 0);
+		if (errno != 0 || endptr == item + 2 || *endptr != '\0' ||
+		    weight < 100 || weight > 10000) {
+			ERROR_PRINTF("tc %u: weight must be 100-10000\n", tc);
 			return -EINVAL;
 		}
-
-		dpni_extended_cfg->tc_cfg[i].max_fs_entries = (uint16_t)val;
-		max_fs_entries_str = strtok_r(NULL, ",", &cursor);
-		++i;
-	}
-
-	if (max_tcs != i) {
-		ERROR_PRINTF(
-			"size of max_fs_entries_per_tc does not match max_tcs: %u\n",
-			(unsigned int)max_tcs);
-		return -EINVAL;
+		sched->delta_bandwidth = (uint16_t)weight;
 	}
 
 	return 0;
 }
 
-static int create_dpni_v9(const char *usage_msg)
+static int set_tx_priorities_dpni(struct restool *ctx, const char *usage_msg)
 {
-	struct dpni_extended_cfg dpni_extended_cfg;
-	struct dpni_attr_v9 dpni_attr;
-	struct dpni_cfg_v9 dpni_cfg;
+	struct dpni_tx_priorities_cfg_v10 cfg;
+	struct dpni_attr_v10 attr;
 	uint16_t dpni_handle;
+	long value;
 	int error;
-	long val;
-
-	memset(&dpni_cfg, 0, sizeof(dpni_cfg));
-	memset(&dpni_extended_cfg, 0, sizeof(dpni_extended_cfg));
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TX_PRIO_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TX_PRIO_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name != NULL) {
-		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
-			     restool.obj_name);
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(TX_PRIO_OPT_SCHED))) {
+		ERROR_PRINTF("--sched option missing\n");
 		puts(usage_msg);
 		return -EINVAL;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_OPTIONS)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_OPTIONS);
-		error = parse_generic_create_options(
-				restool.cmd_option_args[CREATE_OPT_OPTIONS],
-				(uint64_t *)&dpni_cfg.adv.options,
-				options_map_v9,
-				options_num_v9);
-		if (error < 0) {
-			DEBUG_PRINTF(
-				"parse_generic_create_options() failed with error %d, cannot get options-mask\n",
-				error);
+	memset(&cfg, 0, sizeof(cfg));
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TX_PRIO_OPT_PRIO_A)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TX_PRIO_OPT_PRIO_A);
+		error = get_option_value(ctx, TX_PRIO_OPT_PRIO_A, &value,
+					 "Invalid prio-a value", 0,
+					 DPNI_MAX_TC - 1);
+		if (error)
 			return error;
-		}
-	} else {
-		dpni_cfg.adv.options = DPNI_OPT_UNICAST_FILTER |
-				       DPNI_OPT_MULTICAST_FILTER;
-	}
-
-	if (!(restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAC_ADDR))) {
-		ERROR_PRINTF("--mac-addr option missing\n");
-		puts(usage_msg);
-		return -EINVAL;
-	}
-
-	restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_MAC_ADDR);
-	error  = parse_dpni_mac_addr(
-			restool.cmd_option_args[CREATE_OPT_MAC_ADDR],
-			dpni_cfg.mac_addr);
-	if (error < 0) {
-		DEBUG_PRINTF(
-			"parse_dpni_mac_addr() failed with error %d, cannot get mac address\n",
-			error);
-		return error;
+		cfg.prio_group_A = (uint32_t)value;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAX_TCS)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_MAX_TCS);
-		error = get_option_value(CREATE_OPT_MAX_TCS, &val,
-					 "Invalid max tcs", 0, DPNI_MAX_TC);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TX_PRIO_OPT_PRIO_B)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TX_PRIO_OPT_PRIO_B);
+		error = get_option_value(ctx, TX_PRIO_OPT_PRIO_B, &value,
+					 "Invalid prio-b value", 0,
+					 DPNI_MAX_TC - 1);
 		if (error)
 			return error;
-		dpni_cfg.adv.max_tcs = (uint8_t)val;
-	} else {
-		dpni_cfg.adv.max_tcs = 1;
+		cfg.prio_group_B = (uint32_t)value;
 	}
 
-	if (restool.cmd_option_mask &
-	    ONE_BIT_MASK(CREATE_OPT_MAX_DIST_PER_TC)) {
-		restool.cmd_option_mask &=
-			~ONE_BIT_MASK(CREATE_OPT_MAX_DIST_PER_TC);
-		error = parse_dpni_max_dist_per_tc_v9(
-			restool.cmd_option_args[CREATE_OPT_MAX_DIST_PER_TC],
-			&dpni_extended_cfg,
-			dpni_cfg.adv.max_tcs);
-		if (error < 0) {
-			DEBUG_PRINTF(
-				"parse_dpni_max_dist_per_tc_v9() failed with error %d, cannot get maximum distribution's size per RX traffic-class\n",
-				error);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TX_PRIO_OPT_SEPARATE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TX_PRIO_OPT_SEPARATE);
+		error = get_option_value(ctx, TX_PRIO_OPT_SEPARATE, &value,
+					 "Invalid separate-groups value", 0, 1);
+		if (error)
 			return error;
-		}
-	} else {
-		for (int i = 0; i < dpni_cfg.adv.max_tcs; ++i)
-			dpni_extended_cfg.tc_cfg[i].max_dist = 1;
+		cfg.separate_groups = (uint8_t)value;
 	}
 
-	if (restool.cmd_option_mask &
-	    ONE_BIT_MASK(CREATE_OPT_MAX_FS_ENTRIES_PER_TC)) {
-		restool.cmd_option_mask &=
-			~ONE_BIT_MASK(CREATE_OPT_MAX_FS_ENTRIES_PER_TC);
-		error = parse_dpni_max_fs_entries_per_tc(
-		restool.cmd_option_args[CREATE_OPT_MAX_FS_ENTRIES_PER_TC],
-			&dpni_extended_cfg,
-			dpni_cfg.adv.max_tcs);
-		if (error < 0) {
-			DEBUG_PRINTF(
-				"parse_dpni_max_fs_entries_per_tc() failed with error %d, cannot get max_fs_entries per RX traffic-class\n",
-				error);
-			return error;
-		}
-	} else {
-		for (int i = 0; i < dpni_cfg.adv.max_tcs; ++i)
-			dpni_extended_cfg.tc_cfg[i].max_fs_entries = 1;
-	}
+	error = open_dpni_attr(ctx, usage_msg, &dpni_handle, &attr);
+	if (error)
+		return error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAX_SENDERS)) {
-		restool.cmd_option_mask &=
-				~ONE_BIT_MASK(CREATE_OPT_MAX_SENDERS);
-		error = get_option_value(CREATE_OPT_MAX_SENDERS, &val,
-					 "Invalid max senders", 0, UINT8_MAX);
-		if (error)
-			return error;
-		dpni_cfg.adv.max_senders = (uint8_t)val;
-	} else {
-		dpni_cfg.adv.max_senders = 1;
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(TX_PRIO_OPT_SCHED);
+	error = parse_tx_sched(ctx->cmd_option_args[TX_PRIO_OPT_SCHED],
+			       attr.num_tx_tcs, &cfg);
+	if (error)
+		goto out;
+
+	error = dpni_set_tx_priorities_v10(&ctx->mc_io, ctx->cmd_flags,
+					   dpni_handle, &cfg);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 	}
 
-	if (restool.cmd_option_mask &
-	    ONE_BIT_MASK(CREATE_OPT_MAX_UNICAST_FILTERS)) {
-		restool.cmd_option_mask &=
-			~ONE_BIT_MASK(CREATE_OPT_MAX_UNICAST_FILTERS);
-		error = get_option_value(CREATE_OPT_MAX_UNICAST_FILTERS, &val,
-					 "Invalid max unicast filters", 0, UINT8_MAX);
-		if (error)
-			return error;
-		dpni_cfg.adv.max_unicast_filters = (uint8_t)val;
-	} else {
-		dpni_cfg.adv.max_unicast_filters = 0;
+out:
+	(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
+	return error;
+}
+
+static int cmd_dpni_set_tx_priorities(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni set-tx-priorities <dpni-object> \\\n"
+		"\t\t--sched=<mode>[,<mode>...] [OPTIONS]\n"
+		"   e.g. restool dpni set-tx-priorities dpni.5 \\\n"
+		"\t\t--sched=strict,a:4000,a:1000 --prio-a=1\n"
+		"\n"
+		"Sets how the Tx traffic classes share the link. Strict\n"
+		"priority classes are served in order, the lowest number\n"
+		"first; weighted classes share the bandwidth of their group\n"
+		"(A or B) in proportion to their weights. The DPNI must be\n"
+		"disabled.\n"
+		"\n"
+		"--sched=<mode>[,<mode>...]\n"
+		"   Mode of Tx traffic class 0, 1, ... in order: strict,\n"
+		"   a:<weight> or b:<weight>, weights 100-10000. Classes not\n"
+		"   listed are strict priority.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--prio-a=<number>\n"
+		"   Strict priority level of group A, 0 by default.\n"
+		"--prio-b=<number>\n"
+		"   Strict priority level of group B, 0 by default.\n"
+		"--separate-groups=0|1\n"
+		"   Schedule groups A and B separately rather than as one.\n"
+		"\n";
+
+	return set_tx_priorities_dpni(ctx, usage_msg);
+}
+
+static int set_tx_shaping_dpni(struct restool *ctx, const char *usage_msg)
+{
+	struct dpni_tx_shaping_cfg_v10 cr_shaper, er_shaper;
+	uint16_t dpni_handle;
+	uint32_t dpni_id;
+	long value;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TX_SHAPING_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TX_SHAPING_OPT_HELP);
+		return 0;
 	}
 
-	if (restool.cmd_option_mask &
-	    ONE_BIT_MASK(CREATE_OPT_MAX_MULTICAST_FILTERS)) {
-		restool.cmd_option_mask &=
-			~ONE_BIT_MASK(CREATE_OPT_MAX_MULTICAST_FILTERS);
-		error = get_option_value(CREATE_OPT_MAX_MULTICAST_FILTERS, &val,
-					 "Invalid max multicast filters",
-					 0, UINT8_MAX);
-		if (error)
-			return error;
-		dpni_cfg.adv.max_multicast_filters = (uint8_t)val;
-	} else {
-		dpni_cfg.adv.max_multicast_filters = 0;
+	if (ctx->obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
 	}
 
-	if (restool.cmd_option_mask &
-	    ONE_BIT_MASK(CREATE_OPT_MAX_VLAN_FILTERS)) {
-		restool.cmd_option_mask &=
-			~ONE_BIT_MASK(CREATE_OPT_MAX_VLAN_FILTERS);
-		error = get_option_value(CREATE_OPT_MAX_VLAN_FILTERS, &val,
-					 "Invalid max vlan filters",
-					 0, UINT8_MAX);
-		if (error)
-			return error;
-		dpni_cfg.adv.max_vlan_filters = (uint8_t)val;
-	} else {
-		dpni_cfg.adv.max_vlan_filters = 0;
+	error = parse_object_name(ctx->obj_name, "dpni", &dpni_id);
+	if (error)
+		return error;
+
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(TX_SHAPING_OPT_CR))) {
+		ERROR_PRINTF("--committed-rate option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
 	}
 
-	if (restool.cmd_option_mask &
-	    ONE_BIT_MASK(CREATE_OPT_MAX_QOS_ENTRIES)) {
-		restool.cmd_option_mask &=
-			~ONE_BIT_MASK(CREATE_OPT_MAX_QOS_ENTRIES);
-		error = get_option_value(CREATE_OPT_MAX_QOS_ENTRIES, &val,
-					 "Invalid max qos", 0, UINT8_MAX);
+	memset(&cr_shaper, 0, sizeof(cr_shaper));
+	memset(&er_shaper, 0, sizeof(er_shaper));
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(TX_SHAPING_OPT_CR);
+	error = get_option_value(ctx, TX_SHAPING_OPT_CR, &value,
+				 "Invalid committed-rate value",
+				 0, UINT32_MAX);
+	if (error)
+		return error;
+	cr_shaper.rate_limit = (uint32_t)value;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TX_SHAPING_OPT_CR_BURST)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TX_SHAPING_OPT_CR_BURST);
+		error = get_option_value(ctx, TX_SHAPING_OPT_CR_BURST, &value,
+					 "Invalid committed-burst value",
+					 0, UINT16_MAX);
 		if (error)
 			return error;
-		dpni_cfg.adv.max_qos_entries = (uint8_t)val;
-	} else {
-		dpni_cfg.adv.max_qos_entries = 0;
+		cr_shaper.max_burst_size = (uint16_t)value;
 	}
 
-	if (restool.cmd_option_mask &
-	    ONE_BIT_MASK(CREATE_OPT_MAX_QOS_KEY_SIZE)) {
-		restool.cmd_option_mask &=
-			~ONE_BIT_MASK(CREATE_OPT_MAX_QOS_KEY_SIZE);
-		error = get_option_value(CREATE_OPT_MAX_QOS_KEY_SIZE, &val,
-					 "Invalid max qos key size", 0, UINT8_MAX);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TX_SHAPING_OPT_ER)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TX_SHAPING_OPT_ER);
+		error = get_option_value(ctx, TX_SHAPING_OPT_ER, &value,
+					 "Invalid excess-rate value",
+					 0, UINT32_MAX);
 		if (error)
 			return error;
-		dpni_cfg.adv.max_qos_key_size = (uint8_t)val;
-	} else {
-		dpni_cfg.adv.max_qos_key_size = 0;
+		er_shaper.rate_limit = (uint32_t)value;
 	}
 
-	if (restool.cmd_option_mask &
-	    ONE_BIT_MASK(CREATE_OPT_MAX_DIST_KEY_SIZE)) {
-		restool.cmd_option_mask &=
-			~ONE_BIT_MASK(CREATE_OPT_MAX_DIST_KEY_SIZE);
-		error = get_option_value(CREATE_OPT_MAX_DIST_KEY_SIZE, &val,
-					 "Invalid max dist key size",
-					 0, UINT8_MAX);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TX_SHAPING_OPT_ER_BURST)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TX_SHAPING_OPT_ER_BURST);
+		error = get_option_value(ctx, TX_SHAPING_OPT_ER_BURST, &value,
+					 "Invalid excess-burst value",
+					 0, UINT16_MAX);
 		if (error)
 			return error;
-		dpni_cfg.adv.max_dist_key_size = (uint8_t)val;
-	} else {
-		dpni_cfg.adv.max_dist_key_size = 0;
+		er_shaper.max_burst_size = (uint16_t)value;
 	}
 
-	/**
-	 * hack to get get 0.8.x flibs to work with mc
-	 */
-	error = dpni_create_v9(&restool.mc_io, 0, &dpni_cfg, &dpni_extended_cfg,
-			       &dpni_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+	error = dpni_open_v10(&ctx->mc_io, ctx->cmd_flags, dpni_id,
+			      &dpni_handle);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
-	memset(&dpni_attr, 0, sizeof(struct dpni_attr));
-	error = dpni_get_attributes_v9(&restool.mc_io, 0, dpni_handle,
-				       &dpni_attr, &dpni_extended_cfg);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+	error = dpni_set_tx_shaping_v10(&ctx->mc_io, ctx->cmd_flags,
+					dpni_handle, &cr_shaper, &er_shaper);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		return error;
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 	}
-	print_new_obj("dpni", dpni_attr.id, NULL);
 
-	error = dpni_close(&restool.mc_io, 0, dpni_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		return error;
-	}
-	return 0;
+	(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
+	return error;
 }
 
-static int cmd_dpni_create_v9(void)
+static int cmd_dpni_set_tx_shaping(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
-		"Usage: restool dpni create --mac-addr=<addr> [OPTIONS]\n"
-		"   --mac-addr=<addr>\n"
-		"	String specifying primary MAC address (e.g. 00:00:05:00:00:05).\n"
+		"Usage: restool dpni set-tx-shaping <dpni-object> \\\n"
+		"\t\t--committed-rate=<number> [OPTIONS]\n"
+		"   e.g. restool dpni set-tx-shaping dpni.5 \\\n"
+		"\t\t--committed-rate=2000 --committed-burst=16384\n"
 		"\n"
-		"OPTIONS:\n"
-		"--max-senders=<number>\n"
-		"	maximum number of different senders;\n"
-		"	will be used as the number of dedicated TX flows;\n"
-		"	If it is not a power of two it will be rounded up to the next\n"
-		"	power of two value.\n"
-		"--options=<options-mask>\n"
-		"   Where <options-mask> is a comma or space separated list of DPNI options:\n"
-		"	DPNI_OPT_ALLOW_DIST_KEY_PER_TC\n"
-		"	DPNI_OPT_TX_CONF_DISABLED\n"
-		"	DPNI_OPT_PRIVATE_TX_CONF_ERROR_DISABLED\n"
-		"	DPNI_OPT_DIST_HASH\n"
-		"	DPNI_OPT_DIST_FS\n"
-		"	DPNI_OPT_UNICAST_FILTER\n"
-		"	DPNI_OPT_MULTICAST_FILTER\n"
-		"	DPNI_OPT_VLAN_FILTER\n"
-		"	DPNI_OPT_QOS_MASK_SUPPORT\n"
-		"	DPNI_OPT_FS_MASK_SUPPORT\n"
-		"--max-tcs=<number>\n"
-		"	Specifies the maximum number of traffic-classes\n"
-		"	0 will be treated as 1\n"
-		"--max-dist-per-tc=<dist-size>,<dist-size>,...\n"
-		"	Comma separated list of counts specifying the\n"
-		"	maximum distribution's size per RX traffic-class\n"
-		"--max-fs-entries-per-tc=<fs-entries>,<fs-entries>,...\n"
-		"	Comma separated list of counts specifying the\n"
-		"	maximum fs-entries per RX traffic-class\n"
-		"--max-unicast-filters=<number>\n"
-		"	maximum number of unicast filters (0 will be treated as 16)\n"
-		"--max-multicast-filters=<number>\n"
-		"	maximum number of multicast filters (0 will be treated as 64)\n"
-		"--max-vlan-filters=<number>\n"
-		"	maximum number of vlan filters (0 will be treated as 16)\n"
-		"--max-qos-entries=<number>\n"
-		"	if max_tcs > 1, declares the maximum entries for\n"
-		"	the QoS table; '0' will be treated as '64'\n"
-		"--max-qos-key-size=<number>\n"
-		"	maximum key size for the QoS look-up;\n"
-		"	'0' will be treated as '24' which enough for IPv4 5-tuple\n"
-		"--max-dist-key-size=<number>\n"
-		"	maximum key size for the distribution;\n"
-		"	'0' will be treated as '24' which enough for IPv4 5-tuple\n"
+		"Limits the Tx rate of the DPNI, shared by its traffic classes\n"
+		"as set with set-tx-priorities.\n"
 		"\n"
-		"EXAMPLE:\n"
-		"Create a DPNI object with all default options:\n"
-		"   $ restool dpni create --mac-addr=<addr>\n"
+		"--committed-rate=<number>\n"
+		"   Committed rate (Mbits/s), 0 to disable shaping.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--committed-burst=<bytes>\n"
+		"   Largest burst at the committed rate, up to 65535.\n"
+		"--excess-rate=<number>\n"
+		"   Excess rate (Mbits/s) allowed above the committed rate.\n"
+		"--excess-burst=<bytes>\n"
+		"   Largest burst at the excess rate, up to 65535.\n"
 		"\n";
 
-	return create_dpni_v9(usage_msg);
+	return set_tx_shaping_dpni(ctx, usage_msg);
 }
 
-static int create_dpni_v10(const char *usage_msg)
+static void print_queue_dest(const struct dpni_queue_v10 *queue)
 {
-	struct dpni_cfg_v10 dpni_cfg;
-	uint32_t dpni_id, dprc_id;
-	uint16_t dprc_handle;
-	bool dprc_opened;
-	long value;
-	int error;
-
-	memset(&dpni_cfg, 0, sizeof(dpni_cfg));
+	char dest[32];
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
-		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
-		return 0;
-	}
+	if (queue->destination.type == DPNI_DEST_DPIO)
+		snprintf(dest, sizeof(dest), "dpio.%u", queue->destination.id);
+	else if (queue->destination.type == DPNI_DEST_DPCON)
+		snprintf(dest, sizeof(dest), "dpcon.%u",
+			 queue->destination.id);
+	else
+		snprintf(dest, sizeof(dest), "none");
 
-	if (restool.obj_name != NULL) {
-		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
-			     restool.obj_name);
-		puts(usage_msg);
-		return -EINVAL;
+	if (output_is_json()) {
+		output_field("dest", "dest", "%s", dest);
+		output_uint("priority", "priority",
+			    (uint32_t)queue->destination.priority);
+	} else {
+		output_printf("  %-10s %4u", dest,
+			      (uint32_t)queue->destination.priority);
 	}
+}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAC_ENTRIES) &&
-	    restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAC_FILTER_ENTRIES)) {
-		ERROR_PRINTF("Please only use on of the following options " \
-			     "since they are interchangeable:" \
-			     " --mac-entries, --mac-filter-entries.\n");
-		return -EINVAL;
-	}
+static int get_queue_or_report(struct restool *ctx, uint16_t dpni_handle,
+			       enum dpni_queue_type qtype, uint8_t tc,
+			       uint8_t index, struct dpni_queue_v10 *queue,
+			       struct dpni_queue_id_v10 *qid)
+{
+	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_VLAN_ENTRIES) &&
-	    restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_VLAN_FILTER_ENTRIES)) {
-		ERROR_PRINTF("Please only use on of the following options " \
-			     "since they are interchangeable:" \
-			     " --vlan-entries, --vlan-filter-entries.\n");
-		return -EINVAL;
+	memset(queue, 0, sizeof(*queue));
+	memset(qid, 0, sizeof(*qid));
+	error = dpni_get_queue_v10(&ctx->mc_io, ctx->cmd_flags, dpni_handle,
+				   qtype, tc, index, queue, qid);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_OPTIONS)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_OPTIONS);
+	return error;
+}
 
-		if (restool.mc_fw_version.minor == 0)
-			error = parse_generic_create_options(
-					restool.cmd_option_args[CREATE_OPT_OPTIONS],
-					(uint64_t *)&dpni_cfg.options,
-					options_map_v10_0,
-					options_num_v10_0);
-		else
-			error = parse_generic_create_options(
-					restool.cmd_option_args[CREATE_OPT_OPTIONS],
-					(uint64_t *)&dpni_cfg.options,
-					options_map_v10_1,
-					options_num_v10_1);
+static int print_rx_queues(struct restool *ctx, uint16_t dpni_handle,
+			   const struct dpni_attr_v10 *attr)
+{
+	union dpni_statistics_v10 stats;
+	struct dpni_queue_id_v10 qid;
+	struct dpni_queue_v10 queue;
+	unsigned int tc, q;
+	int error;
 
-		if (error) {
-			DEBUG_PRINTF("parse_generic_create_options() = %d\n",
-				     error);
-			return error;
+	output_printf("rx queues:\n  tc queue       fqid  dest       prio\n");
+	output_begin_array("rx_queues");
+	for (tc = 0; tc < attr->num_rx_tcs; tc++) {
+		for (q = 0; q < attr->num_queues; q++) {
+			error = get_queue_or_report(ctx, dpni_handle,
+						    DPNI_QUEUE_RX, tc, q,
+						    &queue, &qid);
+			if (error)
+				return error;
+
+			output_begin_object(NULL);
+			if (output_is_json()) {
+				output_uint("tc", "tc", tc);
+				output_uint("queue", "queue", q);
+				output_hex("fqid", "fqid", qid.fqid);
+			} else {
+				output_printf("  %2u %5u %#10x", tc, q,
+					      qid.fqid);
+			}
+			print_queue_dest(&queue);
+			output_printf("\n");
+			output_end_object();
 		}
 	}
-
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_QUEUES)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_NUM_QUEUES);
-		error = get_option_value(CREATE_OPT_NUM_QUEUES, &value,
-				     "Invalid num-queues value\n", 1, 8);
-		if (error)
-			return error;
-		dpni_cfg.num_queues = (uint8_t)value;
+	output_end_array();
+
+	/* the MC counts Rx drops per traffic class congestion group only */
+	output_printf("rx congestion drops:\n  tc           frames            bytes\n");
+	output_begin_array("rx_congestion_drops");
+	for (tc = 0; tc < attr->num_rx_tcs; tc++) {
+		error = dpni_get_statistics_v10(&ctx->mc_io, ctx->cmd_flags,
+						dpni_handle, 4, tc, &stats);
+		output_begin_object(NULL);
+		if (output_is_json()) {
+			output_uint("tc", "tc", tc);
+			if (!error) {
+				output_uint("frames", "frames",
+					    (unsigned long long)
+					    stats.page_4.cgr_reject_frames);
+				output_uint("bytes", "bytes",
+					    (unsigned long long)
+					    stats.page_4.cgr_reject_bytes);
+			}
+		} else if (error) {
+			output_printf("  %2u %16s %16s\n", tc, "n/a", "n/a");
+		} else {
+			output_printf("  %2u %16llu %16llu\n", tc,
+				      (unsigned long long)
+				      stats.page_4.cgr_reject_frames,
+				      (unsigned long long)
+				      stats.page_4.cgr_reject_bytes);
+		}
+		output_end_object();
 	}
+	output_end_array();
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_TCS)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_NUM_TCS);
-		error = get_option_value(CREATE_OPT_NUM_TCS, &value,
-				     "Invalid num-tcs value\n", 1, 16);
-		if (error)
-			return error;
-		dpni_cfg.num_tcs = (uint8_t)value;
-	}
+	return 0;
+}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAC_ENTRIES)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_MAC_ENTRIES);
-		error = get_option_value(CREATE_OPT_MAC_ENTRIES, &value,
-				     "Invalid mac-entries value\n", 1, 80);
+static int print_tx_conf_queues(struct restool *ctx, uint16_t dpni_handle,
+				const struct dpni_attr_v10 *attr)
+{
+	struct dpni_queue_id_v10 qid;
+	struct dpni_queue_v10 queue;
+	unsigned int q;
+	int error;
+
+	/* released frames are not confirmed */
+	if (attr->options & DPNI_OPT_TX_FRM_RELEASE)
+		return 0;
+
+	output_printf("tx confirmation queues:\n  queue       fqid  dest       prio\n");
+	output_begin_array("tx_confirmation_queues");
+	for (q = 0; q < attr->num_queues; q++) {
+		error = get_queue_or_report(ctx, dpni_handle,
+					    DPNI_QUEUE_TX_CONFIRM, 0, q,
+					    &queue, &qid);
 		if (error)
 			return error;
-		dpni_cfg.mac_filter_entries = (uint8_t)value;
+
+		output_begin_object(NULL);
+		if (output_is_json()) {
+			output_uint("queue", "queue", q);
+			output_hex("fqid", "fqid", qid.fqid);
+		} else {
+			output_printf("  %5u %#10x", q, qid.fqid);
+		}
+		print_queue_dest(&queue);
+		output_printf("\n");
+		output_end_object();
 	}
+	output_end_array();
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAC_FILTER_ENTRIES)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_MAC_FILTER_ENTRIES);
-		error = get_option_value(CREATE_OPT_MAC_FILTER_ENTRIES, &value,
-				     "Invalid mac-filter-entries value\n", 1, 80);
+	return 0;
+}
+
+static int print_tx_queues(struct restool *ctx, uint16_t dpni_handle,
+			   const struct dpni_attr_v10 *attr)
+{
+	union dpni_statistics_v10 stats[DPNI_MAX_TC];
+	bool have_stats[DPNI_MAX_TC];
+	uint16_t qdbin[DPNI_MAX_TC];
+	struct dpni_queue_id_v10 qid;
+	struct dpni_queue_v10 queue;
+	unsigned long long total = 0;
+	unsigned int tc, share;
+	int error;
+
+	/* collect first, the share column needs the total */
+	for (tc = 0; tc < attr->num_tx_tcs && tc < DPNI_MAX_TC; tc++) {
+		error = get_queue_or_report(ctx, dpni_handle, DPNI_QUEUE_TX,
+					    tc, 0, &queue, &qid);
 		if (error)
 			return error;
-		dpni_cfg.mac_filter_entries = (uint8_t)value;
+		qdbin[tc] = qid.qdbin;
+
+		have_stats[tc] = dpni_get_statistics_v10(&ctx->mc_io,
+							 ctx->cmd_flags,
+							 dpni_handle, 3, tc,
+							 &stats[tc]) == 0;
+		if (have_stats[tc])
+			total += stats[tc].page_3.ceetm_dequeue_frames;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_VLAN_ENTRIES)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_VLAN_ENTRIES);
-		error = get_option_value(CREATE_OPT_VLAN_ENTRIES, &value,
-				     "Invalid vlan-entries value\n", 1, 16);
-		if (error)
-			return error;
-		dpni_cfg.vlan_filter_entries = (uint8_t)value;
+	output_printf("tx queues:\n  tc  qdbin     dequeued frames      dequeued bytes     rejected frames  share\n");
+	output_begin_array("tx_queues");
+	for (tc = 0; tc < attr->num_tx_tcs && tc < DPNI_MAX_TC; tc++) {
+		share = 0;
+		if (have_stats[tc] && total != 0)
+			share = (unsigned int)(100 *
+				stats[tc].page_3.ceetm_dequeue_frames / total);
+
+		output_begin_object(NULL);
+		if (output_is_json()) {
+			output_uint("tc", "tc", tc);
+			output_uint("qdbin", "qdbin", (uint32_t)qdbin[tc]);
+			if (have_stats[tc]) {
+				output_uint("dequeued_frames",
+					    "dequeued frames",
+					    (unsigned long long)
+					    stats[tc].page_3.ceetm_dequeue_frames);
+				output_uint("dequeued_bytes", "dequeued bytes",
+					    (unsigned long long)
+					    stats[tc].page_3.ceetm_dequeue_bytes);
+				output_uint("rejected_frames",
+					    "rejected frames",
+					    (unsigned long long)
+					    stats[tc].page_3.ceetm_reject_frames);
+				output_uint("rejected_bytes", "rejected bytes",
+					    (unsigned long long)
+					    stats[tc].page_3.ceetm_reject_bytes);
+				output_uint("share", "share", share);
+			}
+		} else if (have_stats[tc]) {
+			output_printf("  %2u %6u %19llu %19llu %19llu %5u%%\n",
+				      tc, (uint32_t)qdbin[tc],
+				      (unsigned long long)
+				      stats[tc].page_3.ceetm_dequeue_frames,
+				      (unsigned long long)
+				      stats[tc].page_3.ceetm_dequeue_bytes,
+				      (unsigned long long)
+				      stats[tc].page_3.ceetm_reject_frames,
+				      share);
+		} else {
+			output_printf("  %2u %6u %19s %19s %19s %6s\n", tc,
+				      (uint32_t)qdbin[tc], "n/a", "n/a",
+				      "n/a", "n/a");
+		}
+		output_end_object();
 	}
+	output_end_array();
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_VLAN_FILTER_ENTRIES)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_VLAN_FILTER_ENTRIES);
-		error = get_option_value(CREATE_OPT_VLAN_FILTER_ENTRIES, &value,
-				     "Invalid vlan-filter-entries value\n", 1, 16);
-		if (error)
-			return error;
-		dpni_cfg.vlan_filter_entries = (uint8_t)value;
+	return 0;
+}
+
+static int queues_dpni(struct restool *ctx, const char *usage_msg)
+{
+	struct dpni_attr_v10 attr;
+	uint16_t dpni_handle;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(QUEUES_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(QUEUES_OPT_HELP);
+		return 0;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_QOS_ENTRIES)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_QOS_ENTRIES);
-		error = get_option_value(CREATE_OPT_QOS_ENTRIES, &value,
-				     "Invalid qos-entries value\n", 1, 64);
-		if (error)
-			return error;
-		dpni_cfg.qos_entries = (uint8_t)value;
+	error = open_dpni_attr(ctx, usage_msg, &dpni_handle, &attr);
+	if (error)
+		return error;
+
+	error = print_rx_queues(ctx, dpni_handle, &attr);
+	if (!error)
+		error = print_tx_conf_queues(ctx, dpni_handle, &attr);
+	if (!error)
+		error = print_tx_queues(ctx, dpni_handle, &attr);
+
+	(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
+	return error;
+}
+
+static int cmd_dpni_queues(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni queues <dpni-object>\n"
+		"\n"
+		"Shows every queue of a DPNI: the FQID, destination and\n"
+		"priority of the Rx and Tx confirmation queues, the Rx\n"
+		"congestion drops of each traffic class, and the queueing bin,\n"
+		"dequeue and reject counts and share of dequeued frames of each\n"
+		"Tx traffic class. Counters the MC does not provide show n/a.\n"
+		"\n";
+
+	return queues_dpni(ctx, usage_msg);
+}
+
+static int set_offload_dpni(struct restool *ctx, const char *usage_msg)
+{
+	long config[ARRAY_SIZE(dpni_csum_offloads)];
+	bool given[ARRAY_SIZE(dpni_csum_offloads)];
+	bool any = false;
+	uint16_t dpni_handle;
+	uint32_t dpni_id;
+	unsigned int i;
+	int opt;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(OFFLOAD_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(OFFLOAD_OPT_HELP);
+		return 0;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_FS_ENTRIES)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_FS_ENTRIES);
-		error = get_option_value(CREATE_OPT_FS_ENTRIES, &value,
-				     "Invalid fs-entries value\n", 1, 1024);
-		if (error)
-			return error;
-		dpni_cfg.fs_entries = (uint16_t)value;
+	if (ctx->obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
 	}
 
-	dprc_handle = restool.root_dprc_handle;
-	dprc_opened = false;
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
-		error = parse_object_name(
-				restool.cmd_option_args[CREATE_OPT_PARENT_DPRC],
-				"dprc", &dprc_id);
+	error = parse_object_name(ctx->obj_name, "dpni", &dpni_id);
+	if (error)
+		return error;
+
+	/* The options follow the order of dpni_csum_offloads[] */
+	for (i = 0; i < ARRAY_SIZE(dpni_csum_offloads); i++) {
+		opt = OFFLOAD_OPT_RX_L3_CSUM + i;
+		given[i] = ctx->cmd_option_mask & ONE_BIT_MASK(opt);
+		if (!given[i])
+			continue;
+
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(opt);
+		error = get_option_value(ctx, opt, &config[i],
+					 "Invalid checksum offload value",
+					 0, 1);
 		if (error)
 			return error;
+		any = true;
+	}
 
-		if (restool.root_dprc_id != dprc_id) {
-			error = open_dprc(dprc_id, &dprc_handle);
-			if (error)
-				return error;
-			dprc_opened = true;
-		}
+	if (!any) {
+		ERROR_PRINTF("no offload option given\n");
+		puts(usage_msg);
+		return -EINVAL;
 	}
 
-	error = dpni_create_v10(&restool.mc_io, dprc_handle, 0,
-				&dpni_cfg, &dpni_id);
+	error = dpni_open_v10(&ctx->mc_io, ctx->cmd_flags, dpni_id,
+			      &dpni_handle);
 	if (error) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
-	if (dprc_opened) {
-		(void)dprc_close(&restool.mc_io, 0, dprc_handle);
-		print_new_obj("dpni", dpni_id,
-			      restool.cmd_option_args[CREATE_OPT_PARENT_DPRC]);
-	} else {
-		print_new_obj("dpni", dpni_id, NULL);
+	for (i = 0; i < ARRAY_SIZE(dpni_csum_offloads); i++) {
+		if (!given[i])
+			continue;
+
+		error = dpni_set_offload_v10(&ctx->mc_io, ctx->cmd_flags,
+					     dpni_handle,
+					     dpni_csum_offloads[i].type,
+					     (uint32_t)config[i]);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			break;
+		}
 	}
 
-	return 0;
+	(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
+	return error;
 }
-static int cmd_dpni_create_v10(void)
+
+static int cmd_dpni_set_offload(struct restool *ctx)
 {
-	static const char usage_msg_v10_0[] =
-		"\n"
-		"Usage: restool dpni create [OPTIONS]\n"
+	static const char usage_msg[] =
 		"\n"
-		"OPTIONS:\n"
-		"--options=<options-mask>\n"
-		"   Where <options-mask> is a comma or space separated list of DPNI options:\n"
-		"	DPNI_OPT_TX_FRM_RELEASE\n"
-		"	DPNI_OPT_NO_MAC_FILTER\n"
-		"	DPNI_OPT_HAS_POLICING\n"
-		"	DPNI_OPT_SHARED_CONGESTION\n"
-		"	DPNI_OPT_HAS_KEY_MASKING\n"
-		"	DPNI_OPT_NO_FS\n"
-		"--num-queues=<number>\n"
-		"   Number of TX/RX queues use for traffic distribution.\n"
-		"   Used to distribute traffic to multiple GPP cores,\n"
-		"   Defaults to one queue. Maximim supported value is 8\n"
-		"--num-tcs=<number>\n"
-		"   Number of traffic classes (TCs), reserved for the DPNI.\n"
-		"   Defaults to one TC. Maximum supported value is 8\n"
-		"--mac-filter-entries=<number>\n"
-		"   Number of entries in the MAC address filtering table.\n"
-		"   Allows both unicast and multicast entries.\n"
-		"   By default, there are 80 entries.Maximum supported value is 80.\n"
-		"   This option is the former --mac-entries which can still be used.\n"
-		"   The change was made to align with the options passed through DPL.\n"
-		"--vlan-filter-entries=<number>\n"
-		"   Number of entries in the VLAN address filtering table\n"
-		"   By default, VLAN filtering is disabled. Maximum values is 16\n"
-		"   This option is the former --vlan-entries which can still be used.\n"
-		"   The change was made to align with the options passed through DPL.\n"
-		"--qos-entries=<number>\n"
-		"   Number of entries in the QoS classification table.\n"
-		"   Ignored of DPNI has a single TC. By default, set to 64.\n"
-		"--fs-entries=<number>\n"
-		"   Number of entries in the flow steering table.\n"
-		"   Defaults to 64. Maximum value is 1024\n"
-		"--container=<container-name>\n"
-		"   Specifies the parent container name. e.g. dprc.2, dprc.3 etc.\n"
-		"\n";
-
-	static const char usage_msg_v10_1[] =
+		"Usage: restool dpni set-offload <dpni-object> [OPTIONS]\n"
+		"   e.g. restool dpni set-offload dpni.5 \\\n"
+		"\t\t--rx-l3-csum=1 --rx-l4-csum=1\n"
 		"\n"
-		"Usage: restool dpni create [OPTIONS]\n"
+		"Enables (1) or disables (0) the checksum offloads of a DPNI.\n"
+		"Offloads not given are left unchanged. The current settings\n"
+		"are shown by 'dpni info'.\n"
 		"\n"
 		"OPTIONS:\n"
-		"--options=<options-mask>\n"
-		"   Where <options-mask> is a comma or space separated list of DPNI options:\n"
-		"	DPNI_OPT_TX_FRM_RELEASE\n"
-		"	DPNI_OPT_NO_MAC_FILTER\n"
-		"	DPNI_OPT_HAS_POLICING\n"
-		"	DPNI_OPT_SHARED_CONGESTION\n"
-		"	DPNI_OPT_HAS_KEY_MASKING\n"
-		"	DPNI_OPT_NO_FS\n"
-		"	DPNI_OPT_HAS_OPR\n"
-		"	DPNI_OPT_OPR_PER_TC\n"
-		"	DPNI_OPT_SINGLE_SENDER\n"
-		"--num-queues=<number>\n"
-		"   Number of TX/RX queues use for traffic distribution.\n"
-		"   Used to distribute traffic to multiple GPP cores,\n"
-		"   Defaults to one queue. Maximim supported value is 8\n"
-		"--num-tcs=<number>\n"
-		"   Number of traffic classes (TCs), reserved for the DPNI.\n"
-		"   Defaults to one TC. Maximum supported value is 16.\n"
-		"   There are maximum 16 TCs for Tx and 8 TCs for Rx.\n"
-		"   When num_tcs > 8, Tx will use this value but Rx will have\n"
-		"   only 8 traffic classes.\n"
-		"--mac-filter-entries=<number>\n"
-		"   Number of entries in the MAC address filtering table.\n"
-		"   Allows both unicast and multicast entries.\n"
-		"   By default, there are 80 entries.Maximum supported value is 80.\n"
-		"   This option is the former --mac-entries which can still be used.\n"
-		"   The change was made to align with the options passed through DPL.\n"
-		"--vlan-filter-entries=<number>\n"
-		"   Number of entries in the VLAN address filtering table\n"
-		"   By default, VLAN filtering is disabled. Maximum values is 16\n"
-		"   This option is the former --vlan-entries which can still be used.\n"
-		"   The change was made to align with the options passed through DPL.\n"
-		"--qos-entries=<number>\n"
-		"   Number of entries in the QoS classification table.\n"
-		"   Ignored of DPNI has a single TC. By default, set to 64.\n"
-		"--fs-entries=<number>\n"
-		"   Number of entries in the flow steering table.\n"
-		"   Defaults to 64. Maximum value is 1024\n"
-		"--container=<container-name>\n"
-		"   Specifies the parent container name. e.g. dprc.2, dprc.3 etc.\n"
+		"--rx-l3-csum=0|1\n"
+		"   Validate the IP header checksum of received frames.\n"
+		"--rx-l4-csum=0|1\n"
+		"   Validate the TCP/UDP checksum of received frames.\n"
+		"--tx-l3-csum=0|1\n"
+		"   Generate the IP header checksum of transmitted frames.\n"
+		"--tx-l4-csum=0|1\n"
+		"   Generate the TCP/UDP checksum of transmitted frames.\n"
 		"\n";
 
-	if (restool.mc_fw_version.minor == 0)
-		return create_dpni_v10(usage_msg_v10_0);
-	else
-		return create_dpni_v10(usage_msg_v10_1);
-	return -EINVAL;
+	return set_offload_dpni(ctx, usage_msg);
+}
+
+union dpni_filter_entry {
+	uint8_t mac_addr[6];
+	uint16_t vlan_id;
+};
+
+enum filter_track_op {
+	FILTER_TRACK_ADD,
+	FILTER_TRACK_REMOVE,
+	/* the table now holds exactly the given entries */
+	FILTER_TRACK_SET,
+};
+
+/**
+ * A MAC or VLAN filter table and the MC commands that fill it
+ */
+struct dpni_filter_table {
+	const char *name;
+	const char *opt_name;
+	int (*parse)(char *str, union dpni_filter_entry *entry);
+	int (*add)(struct fsl_mc_io *mc_io, uint32_t cmd_flags,
+		   uint16_t token, const union dpni_filter_entry *entry);
+	int (*remove)(struct fsl_mc_io *mc_io, uint32_t cmd_flags,
+		      uint16_t token, const union dpni_filter_entry *entry);
+	int (*clear)(struct fsl_mc_io *mc_io, uint32_t cmd_flags,
+		     uint16_t token);
+	/* NULL when the table filters as soon as it has entries */
+	int (*enable)(struct fsl_mc_io *mc_io, uint32_t cmd_flags,
+		      uint16_t token, int en);
+	unsigned int (*entries)(const struct dpni_attr_v10 *attr);
+	/*
+	 * Records the entries restool put in the table, see
+	 * vlan_filter_track(); NULL when the count is not needed
+	 */
+	int (*track)(uint32_t dpni_id, enum filter_track_op op,
+		     const union dpni_filter_entry *entries,
+		     unsigned int num_entries);
+};
+
+static int mac_filter_parse(char *str, union dpni_filter_entry *entry)
+{
+	return parse_dpni_mac_addr(str, entry->mac_addr);
+}
+
+static int mac_filter_add(struct fsl_mc_io *mc_io, uint32_t cmd_flags,
+			  uint16_t token,
+			  const union dpni_filter_entry *entry)
+{
+	return dpni_add_mac_addr_v10(mc_io, cmd_flags, token,
+				     entry->mac_addr);
+}
+
+static int mac_filter_remove(struct fsl_mc_io *mc_io, uint32_t cmd_flags,
+			     uint16_t token,
+			     const union dpni_filter_entry *entry)
+{
+	return dpni_remove_mac_addr_v10(mc_io, cmd_flags, token,
+					entry->mac_addr);
+}
+
+static int mac_filter_clear(struct fsl_mc_io *mc_io, uint32_t cmd_flags,
+			    uint16_t token)
+{
+	return dpni_clear_mac_filters_v10(mc_io, cmd_flags, token, 1, 1);
+}
+
+static unsigned int mac_filter_entries(const struct dpni_attr_v10 *attr)
+{
+	return attr->mac_filter_entries;
+}
+
+static int vlan_filter_parse(char *str, union dpni_filter_entry *entry)
+{
+	char *endptr;
+	long val;
+
+	errno = 0;
+	val = strtol(str, &endptr, 0);
+	if (STRTOL_ERROR(str, endptr, val, errno) || val < 1 ||
+	    val > VLAN_ID_MAX) {
+		ERROR_PRINTF("Invalid VLAN ID %s, expected 1 to 4094\n", str);
+		return -EINVAL;
+	}
+
+	entry->vlan_id = (uint16_t)val;
+	return 0;
 }
 
-static int destroy_dpni_v9(uint32_t dpni_id)
+static int vlan_filter_add(struct fsl_mc_io *mc_io, uint32_t cmd_flags,
+			   uint16_t token,
+			   const union dpni_filter_entry *entry)
 {
-	bool dpni_opened = false;
-	uint16_t dpni_handle;
-	int error, error2;
+	return dpni_add_vlan_id_v10(mc_io, cmd_flags, token, entry->vlan_id);
+}
 
-	error = dpni_open(&restool.mc_io, 0, dpni_id, &dpni_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpni_opened = true;
-	if (0 == dpni_handle) {
-		DEBUG_PRINTF(
-			"dpni_open() returned invalid handle (auth 0) for dpni.%u\n",
-			dpni_id);
-		error = -ENOENT;
-		goto out;
-	}
+static int vlan_filter_remove(struct fsl_mc_io *mc_io, uint32_t cmd_flags,
+			      uint16_t token,
+			      const union dpni_filter_entry *entry)
+{
+	return dpni_remove_vlan_id_v10(mc_io, cmd_flags, token,
+				       entry->vlan_id);
+}
 
-	error = dpni_destroy(&restool.mc_io, 0, dpni_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpni_opened = false;
-	printf("dpni.%u is destroyed\n", dpni_id);
+static unsigned int vlan_filter_entries(const struct dpni_attr_v10 *attr)
+{
+	return attr->vlan_filter_entries;
+}
 
-out:
-	if (dpni_opened) {
-		error2 = dpni_close(&restool.mc_io, 0, dpni_handle);
-		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
-			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
-			if (error == 0)
-				error = error2;
+/**
+ * Updates the VLAN ids recorded for a DPNI and returns how many it holds,
+ * or -1 if that is not known. The record starts when the table is known
+ * to be empty or reloaded: dpni create, vlan-filter-clear and
+ * vlan-filter-load. Removing an id it does not hold means someone else,
+ * the kernel driver for instance, fills the table too, and drops it.
+ */
+static int vlan_filter_track(uint32_t dpni_id, enum filter_track_op op,
+			     const union dpni_filter_entry *entries,
+			     unsigned int num_entries)
+{
+	bool ids[VLAN_ID_MAX + 1] = { false };
+	int count = 0;
+
+	if (op != FILTER_TRACK_SET && !vlan_filter_state_read(dpni_id, ids))
+		return -1;
+
+	for (unsigned int i = 0; i < num_entries; i++) {
+		if (op == FILTER_TRACK_REMOVE && !ids[entries[i].vlan_id]) {
+			vlan_filter_state_remove(dpni_id);
+			return -1;
 		}
+		ids[entries[i].vlan_id] = op != FILTER_TRACK_REMOVE;
 	}
 
-	return error;
+	vlan_filter_state_write(dpni_id, ids);
+	for (unsigned int id = 1; id <= VLAN_ID_MAX; id++)
+		count += ids[id];
+
+	return count;
 }
 
-static int destroy_dpni_v10(uint32_t dpni_id)
+static const struct dpni_filter_table dpni_mac_filter = {
+	.name = "MAC",
+	.opt_name = "--mac-addr",
+	.parse = mac_filter_parse,
+	.add = mac_filter_add,
+	.remove = mac_filter_remove,
+	.clear = mac_filter_clear,
+	.enable = NULL,
+	.entries = mac_filter_entries,
+	.track = NULL,
+};
+
+static const struct dpni_filter_table dpni_vlan_filter = {
+	.name = "VLAN",
+	.opt_name = "--vlan-id",
+	.parse = vlan_filter_parse,
+	.add = vlan_filter_add,
+	.remove = vlan_filter_remove,
+	.clear = dpni_clear_vlan_filters_v10,
+	.enable = dpni_enable_vlan_filter_v10,
+	.entries = vlan_filter_entries,
+	.track = vlan_filter_track,
+};
+
+static int filter_enable(struct restool *ctx, uint16_t dpni_handle,
+			 const struct dpni_filter_table *table, int en)
 {
-	uint16_t dprc_handle;
-	uint32_t dprc_id;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
-	dprc_id = restool.root_dprc_id;
-	error = get_parent_dprc_id(dpni_id, "dpni", &dprc_id);
-	if (error)
-		return error;
-
-	if (dprc_id != restool.root_dprc_id) {
-		error = open_dprc(dprc_id, &dprc_handle);
-		if (error) {
-			mc_status = flib_error_to_mc_status(error);
-			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				mc_status_to_string(mc_status), mc_status);
-			return error;
-		}
-	}
+	if (table->enable == NULL)
+		return 0;
 
-	error = dpni_destroy_v10(&restool.mc_io, dprc_handle,
-				 0, dpni_id);
+	error = table->enable(&ctx->mc_io, ctx->cmd_flags, dpni_handle, en);
 	if (error) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	printf("dpni.%u is destroyed\n", dpni_id);
-
-out:
-	if (dprc_id != restool.root_dprc_id) {
-		error = dprc_close(&restool.mc_io, 0, dprc_handle);
-		if (error) {
-			mc_status = flib_error_to_mc_status(error);
-			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				mc_status_to_string(mc_status), mc_status);
-		}
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 	}
 
 	return error;
 }
 
-static int destroy_dpni(int mc_fw_version)
+static int filter_track(struct restool *ctx,
+			const struct dpni_filter_table *table,
+			enum filter_track_op op,
+			const union dpni_filter_entry *entries,
+			unsigned int num_entries)
 {
-	static const char usage_msg[] =
-		"\n"
-		"Usage: restool dpni destroy <dpni-object>\n"
-		"   e.g. restool dpni destroy dpni.9\n"
-		"\n";
+	uint32_t dpni_id;
+
+	if (table->track == NULL ||
+	    parse_object_name(ctx->obj_name, "dpni", &dpni_id) != 0)
+		return -1;
+
+	return table->track(dpni_id, op, entries, num_entries);
+}
 
+static int filter_add_del_dpni(struct restool *ctx, const char *usage_msg,
+			       const struct dpni_filter_table *table,
+			       bool add)
+{
+	union dpni_filter_entry entry;
+	uint16_t dpni_handle;
 	int error;
-	uint32_t dpni_id;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(FILTER_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(FILTER_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name == NULL) {
-		ERROR_PRINTF("<object> argument missing\n");
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(FILTER_OPT_ENTRY))) {
+		ERROR_PRINTF("%s option missing\n", table->opt_name);
 		puts(usage_msg);
-		error = -EINVAL;
-		goto out;
+		return -EINVAL;
 	}
 
-	if (in_use(restool.obj_name, "destroyed")) {
-		error = -EBUSY;
-		goto out;
-	}
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(FILTER_OPT_ENTRY);
+	memset(&entry, 0, sizeof(entry));
+	error = table->parse(ctx->cmd_option_args[FILTER_OPT_ENTRY], &entry);
+	if (error)
+		return error;
 
-	error = parse_object_name(restool.obj_name, "dpni", &dpni_id);
-	if (error < 0)
-		goto out;
+	error = open_dpni(ctx, usage_msg, &dpni_handle);
+	if (error)
+		return error;
 
-	if (!find_obj("dpni", dpni_id)) {
-		error = -EINVAL;
+	if (add)
+		error = table->add(&ctx->mc_io, ctx->cmd_flags, dpni_handle,
+				   &entry);
+	else
+		error = table->remove(&ctx->mc_io, ctx->cmd_flags,
+				      dpni_handle, &entry);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 
-	if (mc_fw_version == MC_FW_VERSION_9)
-		error = destroy_dpni_v9(dpni_id);
-	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = destroy_dpni_v10(dpni_id);
-	else
-		return -EINVAL;
+	if (add) {
+		(void)filter_track(ctx, table, FILTER_TRACK_ADD, &entry, 1);
+		error = filter_enable(ctx, dpni_handle, table, 1);
+	} else if (filter_track(ctx, table, FILTER_TRACK_REMOVE,
+				&entry, 1) == 0) {
+		/* as for clear, an empty table must not filter */
+		error = filter_enable(ctx, dpni_handle, table, 0);
+	}
 out:
+	(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
 	return error;
 }
 
-static int cmd_dpni_destroy_v9(void)
+static int filter_clear_dpni(struct restool *ctx, const char *usage_msg,
+			     const struct dpni_filter_table *table)
 {
-	return destroy_dpni(MC_FW_VERSION_9);
+	uint16_t dpni_handle;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(FILTER_CLEAR_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(FILTER_CLEAR_OPT_HELP);
+		return 0;
+	}
+
+	error = open_dpni(ctx, usage_msg, &dpni_handle);
+	if (error)
+		return error;
+
+	error = table->clear(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
+	if (error) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		goto out;
+	}
+
+	/* an empty table that still filters would drop every tagged frame */
+	(void)filter_track(ctx, table, FILTER_TRACK_SET, NULL, 0);
+	error = filter_enable(ctx, dpni_handle, table, 0);
+out:
+	(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
+	return error;
 }
 
-static int cmd_dpni_destroy_v10(void)
+static int filter_load_parse(const struct dpni_filter_table *table,
+			     const char *path, unsigned int max_entries,
+			     union dpni_filter_entry **entries_out,
+			     unsigned int **lines_out,
+			     unsigned int *num_entries_out)
 {
-	return destroy_dpni(MC_FW_VERSION_10);
+	union dpni_filter_entry *entries;
+	unsigned int num_entries = 0;
+	unsigned int line = 0;
+	unsigned int *lines;
+	char *str, *extra, *saveptr;
+	char buf[128];
+	int error = 0;
+	FILE *f;
+
+	f = fopen(path, "r");
+	if (f == NULL) {
+		error = -errno;
+		ERROR_PRINTF("cannot open %s: %s\n", path, strerror(errno));
+		return error;
+	}
+
+	entries = calloc(max_entries, sizeof(*entries));
+	lines = calloc(max_entries, sizeof(*lines));
+	if ((entries == NULL || lines == NULL) && max_entries != 0) {
+		error = -ENOMEM;
+		goto out;
+	}
+
+	while (fgets(buf, sizeof(buf), f) != NULL) {
+		line++;
+		buf[strcspn(buf, "#\n")] = '\0';
+		str = strtok_r(buf, " \t", &saveptr);
+		if (str == NULL)
+			continue;
+
+		extra = strtok_r(NULL, " \t", &saveptr);
+		if (extra != NULL) {
+			ERROR_PRINTF("%s:%u: expected one entry per line\n",
+				     path, line);
+			error = -EINVAL;
+			goto out;
+		}
+
+		if (num_entries == max_entries) {
+			ERROR_PRINTF("%s:%u: more entries than the %u of the %s filter table\n",
+				     path, line, max_entries, table->name);
+			error = -EINVAL;
+			goto out;
+		}
+
+		error = table->parse(str, &entries[num_entries]);
+		if (error) {
+			ERROR_PRINTF("%s:%u: invalid entry\n", path, line);
+			goto out;
+		}
+
+		lines[num_entries] = line;
+		num_entries++;
+	}
+
+	if (ferror(f)) {
+		error = -EIO;
+		ERROR_PRINTF("cannot read %s\n", path);
+	}
+
+out:
+	fclose(f);
+	if (error) {
+		free(entries);
+		free(lines);
+		return error;
+	}
+
+	*entries_out = entries;
+	*lines_out = lines;
+	*num_entries_out = num_entries;
+	return 0;
 }
 
-static int update_dpni_v10(const char *usage_msg)
+static int filter_load_dpni(struct restool *ctx, const char *usage_msg,
+			    const struct dpni_filter_table *table)
 {
-	uint8_t mac_addr[6];
+	union dpni_filter_entry *entries = NULL;
+	unsigned int *lines = NULL;
+	unsigned int num_entries, max_entries, i;
+	struct dpni_attr_v10 attr;
 	uint16_t dpni_handle;
-	uint32_t dpni_id;
-	int error = 0;
-	bool minimal_options = false;
+	const char *path;
+	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(FILTER_LOAD_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(FILTER_LOAD_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name == NULL) {
-		ERROR_PRINTF("Should provide a dpni!\n");
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(FILTER_LOAD_OPT_FILE))) {
+		ERROR_PRINTF("--file option missing\n");
 		puts(usage_msg);
 		return -EINVAL;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpni", &dpni_id);
-	if (error) {
-		puts(usage_msg);
+	error = open_dpni_attr(ctx, usage_msg, &dpni_handle, &attr);
+	if (error)
+		return error;
+
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(FILTER_LOAD_OPT_FILE);
+	path = ctx->cmd_option_args[FILTER_LOAD_OPT_FILE];
+	max_entries = table->entries(&attr);
+	error = filter_load_parse(table, path, max_entries, &entries, &lines,
+				  &num_entries);
+	if (error)
 		goto out;
-	}
 
-	error = dpni_open_v10(&restool.mc_io, 0, dpni_id, &dpni_handle);
+	error = table->clear(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
 	if (error) {
-		ERROR_PRINTF("Could not open specified object!\n");
-		puts(usage_msg);
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(UPDATE_MAC_ADDR)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(UPDATE_MAC_ADDR);
-		error  = parse_dpni_mac_addr(
-				restool.cmd_option_args[UPDATE_MAC_ADDR],
-				mac_addr);
+	for (i = 0; i < num_entries; i++) {
+		error = table->add(&ctx->mc_io, ctx->cmd_flags, dpni_handle,
+				   &entries[i]);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			ERROR_PRINTF("%s:%u: entry not added, %u of %u loaded\n",
+				     path, lines[i], i, num_entries);
+			(void)filter_track(ctx, table, FILTER_TRACK_SET,
+					   entries, i);
+			goto out;
+		}
+	}
 
-		error = dpni_set_primary_mac_addr_v10(&restool.mc_io, 0,
-						      dpni_handle, mac_addr);
-		if (error)
-			ERROR_PRINTF("dpni_set_primary_mac_addr_v10() = %d\n", error);
+	(void)filter_track(ctx, table, FILTER_TRACK_SET, entries, num_entries);
+	error = filter_enable(ctx, dpni_handle, table, num_entries != 0);
+	if (error)
+		goto out;
 
-		minimal_options = true;
+	if (output_is_json()) {
+		output_field("object", "object", "%s", ctx->obj_name);
+		output_field("table", "table", "%s", table->name);
+		output_uint("entries_loaded", "entries loaded", num_entries);
+		output_uint("entries_free", "entries free",
+			    max_entries - num_entries);
+	} else {
+		output_printf("%u %s filter entries loaded into %s, %u of %u free\n",
+			      num_entries, table->name, ctx->obj_name,
+			      max_entries - num_entries, max_entries);
 	}
-
-	dpni_close_v10(&restool.mc_io, 0, dpni_handle);
 out:
+	free(entries);
+	free(lines);
+	(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
+	return error;
+}
 
-	if (!minimal_options && !error) {
-		ERROR_PRINTF("Specify at least an option to update!\n");
-		puts(usage_msg);
-	}
+static int cmd_dpni_mac_filter_add(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni mac-filter-add <dpni-object> \\\n"
+		"\t\t--mac-addr=<addr>\n"
+		"   e.g. restool dpni mac-filter-add dpni.5 \\\n"
+		"\t\t--mac-addr=01:00:5e:00:00:fb\n"
+		"\n"
+		"Adds a unicast or multicast address to the MAC filter table\n"
+		"of a DPNI, so frames to it are accepted without promiscuous\n"
+		"mode.\n"
+		"\n";
 
-	return error;
+	return filter_add_del_dpni(ctx, usage_msg, &dpni_mac_filter, true);
 }
 
-static int cmd_dpni_update_v10(void)
+static int cmd_dpni_mac_filter_del(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
-		"Usage: restool dpni update dpni.X [OPTIONS]\n"
+		"Usage: restool dpni mac-filter-del <dpni-object> \\\n"
+		"\t\t--mac-addr=<addr>\n"
 		"\n"
-		"OPTIONS:\n"
-		"   --mac-addr=<addr>\n"
-		"	String specifying primary MAC address (e.g. 00:00:05:00:00:05).\n"
+		"Removes an address from the MAC filter table of a DPNI.\n"
+		"\n";
+
+	return filter_add_del_dpni(ctx, usage_msg, &dpni_mac_filter, false);
+}
+
+static int cmd_dpni_mac_filter_load(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni mac-filter-load <dpni-object> \\\n"
+		"\t\t--file=<address-file>\n"
+		"\n"
+		"Replaces the MAC filter table of a DPNI with the addresses of\n"
+		"a file, one per line. Blank lines and text after # are\n"
+		"ignored. The file is checked whole, against the\n"
+		"mac_entries of the DPNI, before the table is cleared. The\n"
+		"primary MAC address is kept.\n"
+		"\n";
+
+	return filter_load_dpni(ctx, usage_msg, &dpni_mac_filter);
+}
+
+static int cmd_dpni_mac_filter_clear(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni mac-filter-clear <dpni-object>\n"
+		"\n"
+		"Removes all the addresses of the MAC filter table of a DPNI\n"
+		"but the primary MAC address.\n"
+		"\n";
+
+	return filter_clear_dpni(ctx, usage_msg, &dpni_mac_filter);
+}
+
+static int cmd_dpni_vlan_filter_add(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni vlan-filter-add <dpni-object> \\\n"
+		"\t\t--vlan-id=<number>\n"
+		"   e.g. restool dpni vlan-filter-add dpni.5 --vlan-id=100\n"
+		"\n"
+		"Adds a VLAN ID to the VLAN filter table of a DPNI and turns\n"
+		"VLAN filtering on: tagged frames of other VLANs are dropped.\n"
+		"\n";
+
+	return filter_add_del_dpni(ctx, usage_msg, &dpni_vlan_filter, true);
+}
+
+static int cmd_dpni_vlan_filter_del(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni vlan-filter-del <dpni-object> \\\n"
+		"\t\t--vlan-id=<number>\n"
+		"\n"
+		"Removes a VLAN ID from the VLAN filter table of a DPNI.\n"
+		"Removing the last one turns VLAN filtering off, as\n"
+		"vlan-filter-clear does. restool counts the IDs it added since\n"
+		"the DPNI was created, cleared or loaded; while the table also\n"
+		"holds IDs added by other software, filtering stays on.\n"
+		"\n";
+
+	return filter_add_del_dpni(ctx, usage_msg, &dpni_vlan_filter, false);
+}
+
+static int cmd_dpni_vlan_filter_load(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni vlan-filter-load <dpni-object> \\\n"
+		"\t\t--file=<vlan-file>\n"
+		"\n"
+		"Replaces the VLAN filter table of a DPNI with the VLAN IDs of\n"
+		"a file, one per line. Blank lines and text after # are\n"
+		"ignored. The file is checked whole, against the\n"
+		"vlan_entries of the DPNI, before the table is cleared. VLAN\n"
+		"filtering is on unless the file is empty.\n"
+		"\n";
+
+	return filter_load_dpni(ctx, usage_msg, &dpni_vlan_filter);
+}
+
+static int cmd_dpni_vlan_filter_clear(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni vlan-filter-clear <dpni-object>\n"
+		"\n"
+		"Removes all the VLAN IDs of the VLAN filter table of a DPNI\n"
+		"and turns VLAN filtering off.\n"
 		"\n";
 
-	return update_dpni_v10(usage_msg);
+	return filter_clear_dpni(ctx, usage_msg, &dpni_vlan_filter);
 }
 
 struct object_command dpni_commands_v9[] = {
@@ -1883,7 +5869,8 @@ struct object_command dpni_commands_v9[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpni_destroy_options,
-	  .cmd_func = cmd_dpni_destroy_v9 },
+	  .cmd_func = cmd_dpni_destroy_v9,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -1903,12 +5890,105 @@ struct object_command dpni_commands_v10[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpni_destroy_options,
-	  .cmd_func = cmd_dpni_destroy_v10 },
+	  .cmd_func = cmd_dpni_destroy_v10,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = "update",
 	  .options = dpni_update_options_v10,
 	  .cmd_func = cmd_dpni_update_v10 },
 
+	{ .cmd_name = "set-rx-dist",
+	  .options = dpni_set_rx_dist_options,
+	  .cmd_func = cmd_dpni_set_rx_dist },
+
+	{ .cmd_name = "fs-add",
+	  .options = dpni_fs_add_options,
+	  .cmd_func = cmd_dpni_fs_add },
+
+	{ .cmd_name = "fs-del",
+	  .options = dpni_fs_del_options,
+	  .cmd_func = cmd_dpni_fs_del },
+
+	{ .cmd_name = "fs-clear",
+	  .options = dpni_fs_clear_options,
+	  .cmd_func = cmd_dpni_fs_clear },
+
+	{ .cmd_name = "fs-load",
+	  .options = dpni_fs_load_options,
+	  .cmd_func = cmd_dpni_fs_load },
+
+	{ .cmd_name = "set-pools",
+	  .options = dpni_set_pools_options,
+	  .cmd_func = cmd_dpni_set_pools },
+
+	{ .cmd_name = "set-buffer-layout",
+	  .options = dpni_set_buffer_layout_options,
+	  .cmd_func = cmd_dpni_set_buffer_layout },
+
+	{ .cmd_name = "set-taildrop",
+	  .options = dpni_set_taildrop_options,
+	  .cmd_func = cmd_dpni_set_taildrop },
+
+	{ .cmd_name = "get-taildrop",
+	  .options = dpni_get_taildrop_options,
+	  .cmd_func = cmd_dpni_get_taildrop },
+
+	{ .cmd_name = "set-congestion-notification",
+	  .options = dpni_set_cong_options,
+	  .cmd_func = cmd_dpni_set_congestion_notification },
+
+	{ .cmd_name = "get-congestion-notification",
+	  .options = dpni_get_cong_options,
+	  .cmd_func = cmd_dpni_get_congestion_notification },
+
+	{ .cmd_name = "set-tx-priorities",
+	  .options = dpni_set_tx_priorities_options,
+	  .cmd_func = cmd_dpni_set_tx_priorities },
+
+	{ .cmd_name = "set-tx-shaping",
+	  .options = dpni_set_tx_shaping_options,
+	  .cmd_func = cmd_dpni_set_tx_shaping },
+
+	{ .cmd_name = "queues",
+	  .options = dpni_queues_options,
+	  .cmd_func = cmd_dpni_queues },
+
+	{ .cmd_name = "set-offload",
+	  .options = dpni_set_offload_options,
+	  .cmd_func = cmd_dpni_set_offload },
+
+	{ .cmd_name = "mac-filter-add",
+	  .options = dpni_mac_filter_options,
+	  .cmd_func = cmd_dpni_mac_filter_add },
+
+	{ .cmd_name = "mac-filter-del",
+	  .options = dpni_mac_filter_options,
+	  .cmd_func = cmd_dpni_mac_filter_del },
+
+	{ .cmd_name = "mac-filter-load",
+	  .options = dpni_filter_load_options,
+	  .cmd_func = cmd_dpni_mac_filter_load },
+
+	{ .cmd_name = "mac-filter-clear",
+	  .options = dpni_filter_clear_options,
+	  .cmd_func = cmd_dpni_mac_filter_clear },
+
+	{ .cmd_name = "vlan-filter-add",
+	  .options = dpni_vlan_filter_options,
+	  .cmd_func = cmd_dpni_vlan_filter_add },
+
+	{ .cmd_name = "vlan-filter-del",
+	  .options = dpni_vlan_filter_options,
+	  .cmd_func = cmd_dpni_vlan_filter_del },
+
+	{ .cmd_name = "vlan-filter-load",
+	  .options = dpni_filter_load_options,
+	  .cmd_func = cmd_dpni_vlan_filter_load },
+
+	{ .cmd_name = "vlan-filter-clear",
+	  .options = dpni_filter_clear_options,
+	  .cmd_func = cmd_dpni_vlan_filter_clear },
+
 	{ .cmd_name = NULL },
 };
 
@@ -37,7 +37,6 @@
 #include <errno.h>
 #include <assert.h>
 #include <getopt.h>
-#include <math.h>
 #include <sys/ioctl.h>
 #include "restool.h"
 #include "utils.h"
@@ -122,6 +121,7 @@ C_ASSERT(ARRAY_SIZE(dprc_show_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 enum dprc_info_options {
 	INFO_OPT_HELP = 0,
 	INFO_OPT_VERBOSE,
+	INFO_OPT_FIELDS,
 };
 
 static struct option dprc_info_options[] = {
@@ -133,6 +133,11 @@ static struct option dprc_info_options[] = {
 		.name = "verbose",
 	},
 
+	[INFO_OPT_FIELDS] = {
+		.name = "fields",
+		.has_arg = 1,
+	},
+
 	{ 0 },
 };
 
@@ -355,7 +360,7 @@ static struct option_entry options_map[] = {
 };
 static unsigned int options_num = ARRAY_SIZE(options_map);
 
-static int cmd_dprc_help(void)
+static int cmd_dprc_help(struct restool *ctx)
 {
 	static const char help_msg[] =
 		"\n"
@@ -379,11 +384,12 @@ static int cmd_dprc_help(void)
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
 
+	(void)ctx;
 	printf(help_msg);
 	return 0;
 }
 
-static int cmd_dprc_sync(void)
+static int cmd_dprc_sync(struct restool *ctx)
 {
 	int error;
 
@@ -392,15 +398,15 @@ static int cmd_dprc_sync(void)
 		"Usage: restool dprc sync\n"
 		"\n";
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(SYNC_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(SYNC_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(SYNC_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(SYNC_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name != NULL) {
+	if (ctx->obj_name != NULL) {
 		ERROR_PRINTF(
-			"Unexpected argument: \'%s\'\n\n", restool.obj_name);
+			"Unexpected argument: \'%s\'\n\n", ctx->obj_name);
 		puts(usage_msg);
 		return -EINVAL;
 	}
@@ -420,17 +426,23 @@ static int cmd_dprc_sync(void)
 /**
  * Lists nested DPRCs inside a given DPRC, recursively
  */
-static int list_dprc(uint32_t dprc_id, uint16_t dprc_handle,
+static int list_dprc(struct restool *ctx, uint32_t dprc_id,
+		     uint16_t dprc_handle,
 		     int nesting_level, bool show_non_dprc_objects,
 		     char *full_path)
 {
 	char *updated_full_path = NULL;
+	bool children_listed = false;
 	int num_child_devices;
 	int error = 0;
 	int full_path_len;
 
 	assert(nesting_level <= MAX_DPRC_NESTING);
 
+	output_begin_object(NULL);
+	if (output_is_json())
+		output_field("name", "name", "dprc.%u", dprc_id);
+
 	if (full_path) {
 		full_path_len = strlen(full_path);
 		updated_full_path = malloc(full_path_len + 10);
@@ -442,30 +454,33 @@ static int list_dprc(uint32_t dprc_id, uint16_t dprc_handle,
 			sprintf(updated_full_path, "%s/dprc.%d", full_path, dprc_id);
 		else
 			sprintf(updated_full_path, "dprc.%d", dprc_id);
-		printf("%s\n", updated_full_path);
+		output_printf("%s\n", updated_full_path);
 	} else {
 		for (int i = 0; i < nesting_level; i++)
-			printf("  ");
-		printf("dprc.%u\n", dprc_id);
+			output_printf("  ");
+		output_printf("dprc.%u\n", dprc_id);
 	}
 
-	error = dprc_get_obj_count(&restool.mc_io, 0,
+	error = dprc_get_obj_count(&ctx->mc_io, ctx->cmd_flags,
 				   dprc_handle,
 				   &num_child_devices);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 
+	output_begin_array("children");
+	children_listed = true;
 	for (int i = 0; i < num_child_devices; i++) {
 		struct dprc_obj_desc obj_desc;
 		uint16_t child_dprc_handle;
 		int error2;
 
 		error = dprc_get_obj(
-				&restool.mc_io, 0,
+				&ctx->mc_io, ctx->cmd_flags,
 				dprc_handle,
 				i,
 				&obj_desc);
@@ -479,29 +494,38 @@ static int list_dprc(uint32_t dprc_id, uint16_t dprc_handle,
 		if (strcmp(obj_desc.type, "dprc") != 0) {
 			if (show_non_dprc_objects) {
 				for (int i = 0; i < nesting_level + 1; i++)
-					printf("  ");
-
-				printf("%s.%u\n", obj_desc.type, obj_desc.id);
+					output_printf("  ");
+
+				output_printf("%s.%u\n", obj_desc.type, obj_desc.id);
+				if (output_is_json()) {
+					output_begin_object(NULL);
+					output_field("name", "name", "%s.%u",
+						     obj_desc.type,
+						     obj_desc.id);
+					output_end_object();
+				}
 			}
 
 			continue;
 		}
 
-		error = open_dprc(obj_desc.id, &child_dprc_handle);
+		error = open_dprc(ctx, obj_desc.id, &child_dprc_handle);
 		if (error < 0)
 			goto out;
 
-		error = list_dprc(obj_desc.id,
+		error = list_dprc(ctx, obj_desc.id,
 				  child_dprc_handle,
 				  nesting_level + 1,
 				  show_non_dprc_objects,
 				  updated_full_path);
 
-		error2 = dprc_close(&restool.mc_io, 0, child_dprc_handle);
+		error2 = dprc_close(&ctx->mc_io, ctx->cmd_flags,
+				    child_dprc_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 
@@ -510,13 +534,16 @@ static int list_dprc(uint32_t dprc_id, uint16_t dprc_handle,
 	}
 
 out:
+	if (children_listed)
+		output_end_array();
+	output_end_object();
 	if (full_path)
 		free(updated_full_path);
 
 	return error;
 }
 
-static int cmd_dprc_list(void)
+static int cmd_dprc_list(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -528,32 +555,36 @@ static int cmd_dprc_list(void)
 		"   format like: dprc.1/dprc.2\n"
 		"\n";
 	bool full_path = false;
+	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(LIST_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(LIST_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(LIST_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(LIST_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(LIST_OPT_FULL_PATH)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(LIST_OPT_FULL_PATH);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(LIST_OPT_FULL_PATH)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(LIST_OPT_FULL_PATH);
 		full_path = true;
 	}
 
-	if (restool.obj_name != NULL) {
+	if (ctx->obj_name != NULL) {
 		ERROR_PRINTF(
-			"Unexpected argument: \'%s\'\n\n", restool.obj_name);
+			"Unexpected argument: \'%s\'\n\n", ctx->obj_name);
 		puts(usage_msg);
 		return -EINVAL;
 	}
 
-	return list_dprc(restool.root_dprc_id,
-			 restool.root_dprc_handle,
-			 0, false,
-			 full_path ? "" : NULL);
+	output_begin_array("containers");
+	error = list_dprc(ctx, ctx->root_dprc_id,
+			  ctx->root_dprc_handle,
+			  0, false,
+			  full_path ? "" : NULL);
+	output_end_array();
+	return error;
 }
 
-static int show_one_resource_type(uint16_t dprc_handle,
+static int show_one_resource_type(struct restool *ctx, uint16_t dprc_handle,
 				      const char *mc_res_type)
 {
 	int res_count;
@@ -561,17 +592,19 @@ static int show_one_resource_type(uint16_t dprc_handle,
 	struct dprc_res_ids_range_desc range_desc;
 	int error;
 
-	error = dprc_get_res_count(&restool.mc_io, 0, dprc_handle,
+	output_begin_array("resources");
+	error = dprc_get_res_count(&ctx->mc_io, ctx->cmd_flags, dprc_handle,
 				   (char *)mc_res_type, &res_count);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 
 	if (res_count == 0) {
-		printf("Don't have any %s resource\n", mc_res_type);
+		output_printf("Don't have any %s resource\n", mc_res_type);
 		goto out;
 	}
 
@@ -580,21 +613,29 @@ static int show_one_resource_type(uint16_t dprc_handle,
 	do {
 		int id;
 
-		error = dprc_get_res_ids(&restool.mc_io, 0, dprc_handle,
+		error = dprc_get_res_ids(&ctx->mc_io, ctx->cmd_flags,
+					 dprc_handle,
 					 (char *)mc_res_type, &range_desc);
 		if (error < 0) {
-			mc_status = flib_error_to_mc_status(error);
+			ctx->mc_status = flib_error_to_mc_status(error);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			goto out;
 		}
 
-		if (range_desc.base_id == range_desc.last_id)
-			printf("%s.%d\n", mc_res_type, range_desc.base_id);
+		if (output_is_json()) {
+			output_begin_object(NULL);
+			output_field("type", "type", "%s", mc_res_type);
+			output_int("base_id", "base id", range_desc.base_id);
+			output_int("last_id", "last id", range_desc.last_id);
+			output_end_object();
+		} else if (range_desc.base_id == range_desc.last_id)
+			output_printf("%s.%d\n", mc_res_type, range_desc.base_id);
 		else
-			printf("%s.%d - %s.%d\n",
-			       mc_res_type, range_desc.base_id,
-			       mc_res_type, range_desc.last_id);
+			output_printf("%s.%d - %s.%d\n",
+				      mc_res_type, range_desc.base_id,
+				      mc_res_type, range_desc.last_id);
 
 		for (id = range_desc.base_id; id <= range_desc.last_id; id++)
 			res_discovered_count++;
@@ -602,26 +643,29 @@ static int show_one_resource_type(uint16_t dprc_handle,
 	} while (res_discovered_count < res_count &&
 		 range_desc.iter_status != DPRC_ITER_STATUS_LAST);
 out:
+	output_end_array();
 	return error;
 }
 
-static int show_one_resource_type_count(uint16_t dprc_handle,
+static int show_one_resource_type_count(struct restool *ctx,
+					uint16_t dprc_handle,
 				      const char *mc_res_type)
 {
 	int res_count = -1;
 	int error;
 
-	error = dprc_get_res_count(&restool.mc_io, 0, dprc_handle,
+	error = dprc_get_res_count(&ctx->mc_io, ctx->cmd_flags, dprc_handle,
 				   (char *)mc_res_type, &res_count);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 
 	assert(res_count >= 0);
-	printf("%s: %d\n", mc_res_type, res_count);
+	output_int(NULL, mc_res_type, res_count);
 out:
 	return error;
 }
@@ -629,30 +673,32 @@ out:
 /**
  * List resources of all types found in the container specified by dprc_handle
  */
-static int show_mc_resources(uint16_t dprc_handle)
+static int show_mc_resources(struct restool *ctx, uint16_t dprc_handle)
 {
 	int pool_count;
 	char res_type[RES_TYPE_MAX_LENGTH + 1];
 	int error;
 	int ret_error = 0;
 
-	error = dprc_get_pool_count(&restool.mc_io, 0, dprc_handle,
+	output_begin_object("resources");
+	error = dprc_get_pool_count(&ctx->mc_io, ctx->cmd_flags, dprc_handle,
 				    &pool_count);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 
 	assert(pool_count >= 0);
 	if (0 == pool_count) {
-		printf("Don't have any resource in current dprc container.\n");
-		return 0;
+		output_printf("Don't have any resource in current dprc container.\n");
+		goto out;
 	}
 	for (int i = 0; i < pool_count; i++) {
 		memset(res_type, 0, sizeof(res_type));
-		error = dprc_get_pool(&restool.mc_io, 0, dprc_handle,
+		error = dprc_get_pool(&ctx->mc_io, ctx->cmd_flags, dprc_handle,
 				      i, res_type);
 
 		/* check for buffer overrun: */
@@ -669,7 +715,8 @@ static int show_mc_resources(uint16_t dprc_handle)
 		}
 
 		DEBUG_PRINTF("pool index %d: ", i);
-		error = show_one_resource_type_count(dprc_handle, res_type);
+		error = show_one_resource_type_count(ctx, dprc_handle,
+						     res_type);
 		if (error < 0) {
 			if (ret_error == 0)
 				ret_error = error;
@@ -678,10 +725,12 @@ static int show_mc_resources(uint16_t dprc_handle)
 		}
 	}
 out:
+	output_end_object();
 	return ret_error;
 }
 
-static int show_mc_objects(uint16_t dprc_handle, const char *dprc_name)
+static int show_mc_objects(struct restool *ctx, uint16_t dprc_handle,
+			   const char *dprc_name)
 {
 	int num_child_devices;
 	int error;
@@ -689,25 +738,31 @@ static int show_mc_objects(uint16_t dprc_handle, const char *dprc_name)
 	int labelen;
 	char plug_stat[10] = {'\0'};
 	struct dprc_obj_desc obj_desc;
+	bool listed = false;
 
-	error = dprc_get_obj_count(&restool.mc_io, 0,
+	error = dprc_get_obj_count(&ctx->mc_io, ctx->cmd_flags,
 				   dprc_handle,
 				   &num_child_devices);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 
-	printf("%s contains %u objects%c\n", dprc_name, num_child_devices,
-	       num_child_devices == 0 ? '.' : ':');
-	printf("object\t\tlabel\t\tplugged-state\n");
+	output_printf("%s contains %u objects%c\n", dprc_name, num_child_devices,
+		      num_child_devices == 0 ? '.' : ':');
+	output_printf("object\t\tlabel\t\tplugged-state\n");
+	if (output_is_json())
+		output_field("container", "container", "%s", dprc_name);
+	output_begin_array("objects");
+	listed = true;
 
 	for (int i = 0; i < num_child_devices; i++) {
 		plug_stat[0] = '\0';
 		memset(&obj_desc, 0, sizeof(obj_desc));
-		error = dprc_get_obj(&restool.mc_io, 0,
+		error = dprc_get_obj(&ctx->mc_io, ctx->cmd_flags,
 				     dprc_handle,
 				     i,
 				     &obj_desc);
@@ -719,15 +774,7 @@ static int show_mc_objects(uint16_t dprc_handle, const char *dprc_name)
 		}
 		assert(strlen(obj_desc.label) <= MC_OBJ_LABEL_MAX_LENGTH);
 
-		if (obj_desc.id < 0)
-			width = strlen(obj_desc.type) + 1 +
-				(2 + (int)log10(0 - obj_desc.id));
-		else if (obj_desc.id == 0)
-			width = strlen(obj_desc.type) + 1 + 1;
-		else
-			width = strlen(obj_desc.type) + 1 +
-				(1 + (int)log10(obj_desc.id));
-
+		width = snprintf(NULL, 0, "%s.%d", obj_desc.type, obj_desc.id);
 		labelen = strlen(obj_desc.label);
 
 		DEBUG_PRINTF("%s.%d name length=%d\n",
@@ -743,26 +790,32 @@ static int show_mc_objects(uint16_t dprc_handle, const char *dprc_name)
 			strncpy(plug_stat, "unplugged", 10);
 		plug_stat[9] = '\0';
 
-		if (width < 8 && labelen < 8)
-			printf("%s.%d\t\t%s\t\t%s\n",
-			obj_desc.type, obj_desc.id, obj_desc.label, plug_stat);
-		else if (width < 8 && labelen >= 8)
-			printf("%s.%d\t\t%s\t%s\n",
-			obj_desc.type, obj_desc.id, obj_desc.label, plug_stat);
-		else if (width >= 8 && labelen < 8)
-			printf("%s.%d\t%s\t\t%s\n",
-			obj_desc.type, obj_desc.id, obj_desc.label, plug_stat);
-		else
-			printf("%s.%d\t%s\t%s\n",
-			obj_desc.type, obj_desc.id, obj_desc.label, plug_stat);
+		if (output_is_json()) {
+			output_begin_object(NULL);
+			output_field("object", "object", "%s.%d",
+				     obj_desc.type, obj_desc.id);
+			output_field("label", "label", "%s", obj_desc.label);
+			output_field("plugged_state", "plugged state",
+				     "%s", plug_stat);
+			output_end_object();
+			continue;
+		}
+
+		/* one or two tabs keep the columns lined up */
+		output_printf("%s.%d%s%s%s%s\n",
+			      obj_desc.type, obj_desc.id,
+			      width < 8 ? "\t\t" : "\t", obj_desc.label,
+			      labelen < 8 ? "\t\t" : "\t", plug_stat);
 	}
 
 	error = 0;
 out:
+	if (listed)
+		output_end_array();
 	return error;
 }
 
-static int cmd_dprc_show(void)
+static int cmd_dprc_show(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -776,21 +829,21 @@ static int cmd_dprc_show(void)
 	bool dprc_opened = false;
 	const char *res_type;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(SHOW_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(SHOW_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(SHOW_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(SHOW_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	dprc_name = restool.obj_name;
+	dprc_name = ctx->obj_name;
 	if (strcmp(dprc_name, "mc.global") == 0)
 		dprc_name = "dprc.0";
 
@@ -798,42 +851,43 @@ static int cmd_dprc_show(void)
 	if (error < 0)
 		goto out;
 
-	if (dprc_id != restool.root_dprc_id) {
-		error = open_dprc(dprc_id, &dprc_handle);
+	if (dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, dprc_id, &dprc_handle);
 		if (error < 0)
 			goto out;
 
 		dprc_opened = true;
 	} else {
-		dprc_handle = restool.root_dprc_handle;
+		dprc_handle = ctx->root_dprc_handle;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(SHOW_OPT_RESOURCES)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(SHOW_OPT_RESOURCES);
-		error = show_mc_resources(dprc_handle);
-	} else if (restool.cmd_option_mask & ONE_BIT_MASK(SHOW_OPT_RES_TYPE)) {
-		assert(restool.cmd_option_args[SHOW_OPT_RES_TYPE] != NULL);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(SHOW_OPT_RESOURCES)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(SHOW_OPT_RESOURCES);
+		error = show_mc_resources(ctx, dprc_handle);
+	} else if (ctx->cmd_option_mask & ONE_BIT_MASK(SHOW_OPT_RES_TYPE)) {
+		assert(ctx->cmd_option_args[SHOW_OPT_RES_TYPE] != NULL);
 		error = check_resource_type(
-			restool.cmd_option_args[SHOW_OPT_RES_TYPE]);
+			ctx->cmd_option_args[SHOW_OPT_RES_TYPE]);
 		if (error < 0) {
 			puts(usage_msg);
 			goto out;
 		}
-		res_type = restool.cmd_option_args[SHOW_OPT_RES_TYPE];
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(SHOW_OPT_RES_TYPE);
-		error = show_one_resource_type(dprc_handle, res_type);
+		res_type = ctx->cmd_option_args[SHOW_OPT_RES_TYPE];
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(SHOW_OPT_RES_TYPE);
+		error = show_one_resource_type(ctx, dprc_handle, res_type);
 	} else {
-		error = show_mc_objects(dprc_handle, dprc_name);
+		error = show_mc_objects(ctx, dprc_handle, dprc_name);
 	}
 out:
 	if (dprc_opened) {
 		int error2;
 
-		error2 = dprc_close(&restool.mc_io, 0, dprc_handle);
+		error2 = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -844,69 +898,77 @@ out:
 
 static void print_dprc_options(uint64_t options)
 {
+	output_begin_array("option_flags");
+
 	if ((options & ~ALL_DPRC_OPTS) != 0) {
-		printf("\tUnrecognized options found...\n");
+		output_item("Unrecognized options found...");
+		output_end_array();
 		return;
 	}
 
 	if (options & DPRC_CFG_OPT_SPAWN_ALLOWED)
-		printf("\tDPRC_CFG_OPT_SPAWN_ALLOWED\n");
+		output_item("DPRC_CFG_OPT_SPAWN_ALLOWED");
 
 	if (options & DPRC_CFG_OPT_ALLOC_ALLOWED)
-		printf("\tDPRC_CFG_OPT_ALLOC_ALLOWED\n");
+		output_item("DPRC_CFG_OPT_ALLOC_ALLOWED");
 
 	if (options & DPRC_CFG_OPT_OBJ_CREATE_ALLOWED)
-		printf("\tDPRC_CFG_OPT_OBJ_CREATE_ALLOWED\n");
+		output_item("DPRC_CFG_OPT_OBJ_CREATE_ALLOWED");
 
 	if (options & DPRC_CFG_OPT_TOPOLOGY_CHANGES_ALLOWED)
-		printf("\tDPRC_CFG_OPT_TOPOLOGY_CHANGES_ALLOWED\n");
+		output_item("DPRC_CFG_OPT_TOPOLOGY_CHANGES_ALLOWED");
 
 	if (options & DPRC_CFG_OPT_AIOP)
-		printf("\tDPRC_CFG_OPT_AIOP\n");
+		output_item("DPRC_CFG_OPT_AIOP");
 
 	if (options & DPRC_CFG_OPT_IRQ_CFG_ALLOWED)
-		printf("\tDPRC_CFG_OPT_IRQ_CFG_ALLOWED\n");
+		output_item("DPRC_CFG_OPT_IRQ_CFG_ALLOWED");
+	output_end_array();
 }
 
-static int print_dprc_attr(uint32_t dprc_id,
+static int print_dprc_attr(struct restool *ctx, uint32_t dprc_id,
 			   struct dprc_obj_desc *target_obj_desc)
 {
 	uint16_t dprc_handle;
-	int error;
+	int error = 0;
 	struct dprc_attributes dprc_attr;
 	bool dprc_opened = false;
 
-	if (dprc_id != restool.root_dprc_id) {
-		error = open_dprc(dprc_id, &dprc_handle);
+	if (INFO_FIELD(ID))
+		output_int("container_id", "container id", dprc_id);
+
+	if (!INFO_FIELD(ATTR))
+		goto label;
+
+	if (dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, dprc_id, &dprc_handle);
 		if (error < 0)
 			goto out;
 
 		dprc_opened = true;
 	} else {
-		dprc_handle = restool.root_dprc_handle;
+		dprc_handle = ctx->root_dprc_handle;
 	}
 
 	memset(&dprc_attr, 0, sizeof(dprc_attr));
-	error = dprc_get_attributes(&restool.mc_io, 0, dprc_handle, &dprc_attr);
+	error = dprc_get_attributes(&ctx->mc_io, ctx->cmd_flags, dprc_handle,
+				    &dprc_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 
 	assert(dprc_id == (uint32_t)dprc_attr.container_id);
-	printf(
-		"container id: %d\n"
-		"icid: %u\n"
-		"portal id: %d\n"
-		"dprc options: %#llx\n",
-		dprc_attr.container_id,
-		dprc_attr.icid,
-		dprc_attr.portal_id,
-		(unsigned long long)dprc_attr.options);
+	output_uint("icid", "icid", dprc_attr.icid);
+	output_int("portal_id", "portal id", dprc_attr.portal_id);
+	output_hex("options", "dprc options",
+		   (unsigned long long)dprc_attr.options);
 	print_dprc_options(dprc_attr.options);
-	print_obj_label(target_obj_desc);
+label:
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -914,11 +976,12 @@ out:
 	if (dprc_opened) {
 		int error2;
 
-		error2 = dprc_close(&restool.mc_io, 0, dprc_handle);
+		error2 = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -927,48 +990,46 @@ out:
 	return error;
 }
 
-static int print_dprc_info(uint32_t dprc_id)
+static int print_dprc_info(struct restool *ctx, uint32_t dprc_id)
 {
 	int error;
 	struct dprc_obj_desc target_obj_desc;
-	uint32_t target_parent_dprc_id;
-	bool found = false;
 
-	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0, dprc_id,
-				"dprc", &target_obj_desc,
-				&target_parent_dprc_id, &found);
+	error = find_info_obj_desc(ctx, dprc_id, "dprc",
+				   ctx->cmd_option_mask &
+				   ONE_BIT_MASK(INFO_OPT_VERBOSE),
+				   &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (strcmp(target_obj_desc.type, "dprc")) {
-		printf("dprc.%d does not exist\n", dprc_id);
-		return -EINVAL;
-	}
-
-	error = print_dprc_attr(dprc_id, &target_obj_desc);
+	error = print_dprc_attr(ctx, dprc_id, &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dprc_ops);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
+		error = print_obj_verbose(ctx, &target_obj_desc, &dprc_ops);
 	}
 
 out:
 	return error;
 }
 
-static int cmd_dprc_info(void)
+static int cmd_dprc_info(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
 		"Usage: restool dprc info <dprc-object> [--verbose]\n"
+		"                         [--fields=<field>[,<field>...]]\n"
 		"\n"
 		"OPTIONS:\n"
 		"--verbose\n"
 		"   Shows extended/verbose information about the object\n"
+		"--fields=<field>[,<field>...]\n"
+		"   Shows only the given fields and sends only the MC\n"
+		"   commands they need. <field> is one of: version, id,\n"
+		"   state, endpoint, link, mac, attr, stats, label.\n"
+		"   Requires MC firmware 10.x.\n"
 		"\n"
 		"EXAMPLE:\n"
 		"Display information about dprc.5:\n"
@@ -979,21 +1040,29 @@ static int cmd_dprc_info(void)
 	const char *dprc_name;
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_FIELDS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_FIELDS);
+		error = parse_info_fields(ctx, 
+				ctx->cmd_option_args[INFO_OPT_FIELDS]);
+		if (error < 0)
+			goto out;
+	}
+
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	dprc_name = restool.obj_name;
+	dprc_name = ctx->obj_name;
 	if (strcmp(dprc_name, "mc.global") == 0)
 		dprc_name = "dprc.0";
 
@@ -1001,7 +1070,7 @@ static int cmd_dprc_info(void)
 	if (error < 0)
 		goto out;
 
-	error = print_dprc_info(dprc_id);
+	error = print_dprc_info(ctx, dprc_id);
 out:
 	return error;
 }
@@ -1010,7 +1079,8 @@ out:
  * Create a DPRC object in the MC, as a child of the container
  * referred by 'dprc_handle'.
  */
-static int create_child_dprc(uint16_t dprc_handle, uint64_t options,
+static int create_child_dprc(struct restool *ctx, uint16_t dprc_handle,
+			     uint64_t options,
 			     bool has_label)
 {
 	int error;
@@ -1027,26 +1097,27 @@ static int create_child_dprc(uint16_t dprc_handle, uint64_t options,
 	cfg.options = options;
 	if (has_label) {
 		strncpy(cfg.label,
-			restool.cmd_option_args[CREATE_OPT_LABEL],
+			ctx->cmd_option_args[CREATE_OPT_LABEL],
 			MC_OBJ_LABEL_MAX_LENGTH);
 		cfg.label[15] = '\0';
 	} else
 		cfg.label[0] = '\0';
 	error = dprc_create_container(
-			&restool.mc_io, 0,
+			&ctx->mc_io, ctx->cmd_flags,
 			dprc_handle,
 			&cfg,
 			&child_dprc_id,
 			&mc_portal_offset);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto error;
 	}
 
 	child_dprc_created = true;
-	print_new_obj("dprc", child_dprc_id, restool.obj_name);
+	print_new_obj(ctx, "dprc", child_dprc_id, ctx->obj_name);
 	DEBUG_PRINTF("dprc.%u's MC portal id %u, portal addr %#llx\n",
 		child_dprc_id,
 		(unsigned int)MC_PORTAL_OFFSET_TO_PORTAL_ID(mc_portal_offset),
@@ -1055,19 +1126,21 @@ static int create_child_dprc(uint16_t dprc_handle, uint64_t options,
 	return 0;
 error:
 	if (child_dprc_created) {
-		error2 = dprc_destroy_container(&restool.mc_io, 0, dprc_handle,
+		error2 = dprc_destroy_container(&ctx->mc_io, ctx->cmd_flags,
+						dprc_handle,
 						child_dprc_id);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 		}
 	}
 
 	return error;
 }
 
-static int cmd_dprc_create_child(void)
+static int cmd_dprc_create_child(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -1100,40 +1173,40 @@ static int cmd_dprc_create_child(void)
 	uint32_t dprc_id;
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name,
+	error = parse_object_name(ctx->obj_name,
 				  "dprc", &dprc_id);
 	if (error < 0)
 		goto out;
 
-	if (dprc_id != restool.root_dprc_id) {
-		error = open_dprc(dprc_id, &dprc_handle);
+	if (dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, dprc_id, &dprc_handle);
 		if (error < 0)
 			goto out;
 
 		dprc_opened = true;
 	} else {
-		dprc_handle = restool.root_dprc_handle;
+		dprc_handle = ctx->root_dprc_handle;
 	}
 	DEBUG_PRINTF("dprc.%d's handle is: %#x\n", dprc_id, dprc_handle);
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_OPTIONS)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_OPTIONS);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_OPTIONS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_OPTIONS);
 		error = parse_generic_create_options(
-				restool.cmd_option_args[CREATE_OPT_OPTIONS],
+				ctx->cmd_option_args[CREATE_OPT_OPTIONS],
 				&options,
 				options_map,
 				options_num);
@@ -1146,12 +1219,12 @@ static int cmd_dprc_create_child(void)
 			  DPRC_CFG_OPT_IRQ_CFG_ALLOWED;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_LABEL)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_LABEL);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_LABEL)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_LABEL);
 		has_label = true;
 		DEBUG_PRINTF("Object label length: %d\n",
-		(int)strlen(restool.cmd_option_args[CREATE_OPT_LABEL]));
-		if (strlen(restool.cmd_option_args[CREATE_OPT_LABEL]) >
+		(int)strlen(ctx->cmd_option_args[CREATE_OPT_LABEL]));
+		if (strlen(ctx->cmd_option_args[CREATE_OPT_LABEL]) >
 		    MC_OBJ_LABEL_MAX_LENGTH) {
 			ERROR_PRINTF("object label length exceeding %d\n",
 					MC_OBJ_LABEL_MAX_LENGTH);
@@ -1163,16 +1236,17 @@ static int cmd_dprc_create_child(void)
 		has_label = false;
 	}
 
-	error = create_child_dprc(dprc_handle, options, has_label);
+	error = create_child_dprc(ctx, dprc_handle, options, has_label);
 out:
 	if (dprc_opened) {
 		int error2;
 
-		error2 = dprc_close(&restool.mc_io, 0, dprc_handle);
+		error2 = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -1181,7 +1255,7 @@ out:
 	return error;
 }
 
-static int cmd_dprc_destroy_child(void)
+static int cmd_dprc_destroy_child(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -1198,53 +1272,53 @@ static int cmd_dprc_destroy_child(void)
 	uint16_t parent_dprc_handle;
 	bool found = false;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		error = -EINVAL;
 		goto out;
 	}
 
-	if (in_use(restool.obj_name, "destroyed")) {
+	if (in_use(ctx->obj_name, "destroyed")) {
 		error = -EBUSY;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name,
+	error = parse_object_name(ctx->obj_name,
 				  "dprc", &child_dprc_id);
 	if (error < 0)
 		goto out;
 
-	if (child_dprc_id == restool.root_dprc_id) {
+	if (child_dprc_id == ctx->root_dprc_id) {
 		ERROR_PRINTF("The root DPRC (%s) cannot be destroyed\n",
-			     restool.obj_name);
+			     ctx->obj_name);
 		error = -EINVAL;
 		goto out;
 	}
 
 	memset(&child_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0,
+	error = find_target_obj_desc(ctx, ctx->root_dprc_id,
+				ctx->root_dprc_handle, 0,
 				child_dprc_id, "dprc", &child_obj_desc,
 				&parent_dprc_id, &found);
 
 	if (!found) {
 		if (error == 0)
-			printf("%s does not exist\n", restool.obj_name);
+			output_notice("%s does not exist\n", ctx->obj_name);
 		error = -EINVAL;
 		goto out;
 	}
 
-	if (parent_dprc_id == restool.root_dprc_id)
-		parent_dprc_handle = restool.root_dprc_handle;
+	if (parent_dprc_id == ctx->root_dprc_id)
+		parent_dprc_handle = ctx->root_dprc_handle;
 	else {
-		error = open_dprc(parent_dprc_id,
+		error = open_dprc(ctx, parent_dprc_id,
 				&parent_dprc_handle);
 		if (error < 0)
 			goto out;
@@ -1252,26 +1326,29 @@ static int cmd_dprc_destroy_child(void)
 	/*
 	 * Destroy child container in the MC:
 	 */
-	error = dprc_destroy_container(&restool.mc_io, 0, parent_dprc_handle,
+	error = dprc_destroy_container(&ctx->mc_io, ctx->cmd_flags,
+				       parent_dprc_handle,
 					child_dprc_id);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 
 		goto out;
 	}
 
-	printf("dprc.%u is destroyed\n", child_dprc_id);
+	print_destroyed_obj("dprc", child_dprc_id);
 
-	if (parent_dprc_id != restool.root_dprc_id)
-		error = dprc_close(&restool.mc_io, 0, parent_dprc_handle);
+	if (parent_dprc_id != ctx->root_dprc_id)
+		error = dprc_close(&ctx->mc_io, ctx->cmd_flags,
+				   parent_dprc_handle);
 
 out:
 	return error;
 }
 
-static int lookup_obj_desc(uint32_t parent_dprc_id,
+static int lookup_obj_desc(struct restool *ctx, uint32_t parent_dprc_id,
 			   const char *obj_type,
 			   int obj_id,
 			   struct dprc_obj_desc *obj_desc_out)
@@ -1282,30 +1359,37 @@ static int lookup_obj_desc(uint32_t parent_dprc_id,
 	int num_child_devices;
 	bool dprc_opened = false;
 
-	if (parent_dprc_id != restool.root_dprc_id) {
-		error = open_dprc(parent_dprc_id, &dprc_handle);
+	if (parent_dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, parent_dprc_id, &dprc_handle);
 		if (error < 0)
 			goto out;
 
 		dprc_opened = true;
 	} else {
-		dprc_handle = restool.root_dprc_handle;
+		dprc_handle = ctx->root_dprc_handle;
+	}
+
+	if (get_child_obj_desc(ctx, dprc_handle, obj_type, obj_id,
+			       obj_desc_out)) {
+		error = 0;
+		goto out;
 	}
 
-	error = dprc_get_obj_count(&restool.mc_io, 0,
+	error = dprc_get_obj_count(&ctx->mc_io, ctx->cmd_flags,
 				   dprc_handle,
 				   &num_child_devices);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 
 	for (i = 0; i < num_child_devices; i++) {
 		struct dprc_obj_desc obj_desc;
 
-		error = dprc_get_obj(&restool.mc_io, 0,
+		error = dprc_get_obj(&ctx->mc_io, ctx->cmd_flags,
 				     dprc_handle,
 				     i,
 				     &obj_desc);
@@ -1333,11 +1417,12 @@ out:
 	if (dprc_opened) {
 		int error2;
 
-		error2 = dprc_close(&restool.mc_io, 0, dprc_handle);
+		error2 = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -1346,7 +1431,8 @@ out:
 	return error;
 }
 
-static int do_dprc_assign_or_unassign(const char *usage_msg, bool do_assign)
+static int do_dprc_assign_or_unassign(struct restool *ctx,
+				      const char *usage_msg, bool do_assign)
 {
 	uint16_t dprc_handle;
 	int error;
@@ -1355,14 +1441,14 @@ static int do_dprc_assign_or_unassign(const char *usage_msg, bool do_assign)
 	uint32_t child_dprc_id;
 	struct dprc_res_req res_req;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(ASSIGN_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(ASSIGN_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(ASSIGN_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(ASSIGN_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<parent-container> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
@@ -1370,26 +1456,26 @@ static int do_dprc_assign_or_unassign(const char *usage_msg, bool do_assign)
 	}
 
 	memset(&res_req, 0, sizeof(res_req));
-	error = parse_object_name(restool.obj_name,
+	error = parse_object_name(ctx->obj_name,
 				  "dprc", &parent_dprc_id);
 	if (error < 0)
 		goto out;
 
-	if (parent_dprc_id != restool.root_dprc_id) {
-		error = open_dprc(parent_dprc_id, &dprc_handle);
+	if (parent_dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, parent_dprc_id, &dprc_handle);
 		if (error < 0)
 			goto out;
 
 		dprc_opened = true;
 	} else {
-		dprc_handle = restool.root_dprc_handle;
+		dprc_handle = ctx->root_dprc_handle;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(ASSIGN_OPT_CHILD)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(ASSIGN_OPT_CHILD);
-		assert(restool.cmd_option_args[ASSIGN_OPT_CHILD] != NULL);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(ASSIGN_OPT_CHILD)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(ASSIGN_OPT_CHILD);
+		assert(ctx->cmd_option_args[ASSIGN_OPT_CHILD] != NULL);
 		error = parse_object_name(
-				restool.cmd_option_args[ASSIGN_OPT_CHILD],
+				ctx->cmd_option_args[ASSIGN_OPT_CHILD],
 				"dprc", &child_dprc_id);
 		if (error < 0)
 			goto out;
@@ -1397,20 +1483,20 @@ static int do_dprc_assign_or_unassign(const char *usage_msg, bool do_assign)
 		child_dprc_id = parent_dprc_id;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(ASSIGN_OPT_RES_TYPE)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(ASSIGN_OPT_RES_TYPE)) {
 		/* moving resource case */
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(ASSIGN_OPT_RES_TYPE);
-		assert(restool.cmd_option_args[ASSIGN_OPT_RES_TYPE] != NULL);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(ASSIGN_OPT_RES_TYPE);
+		assert(ctx->cmd_option_args[ASSIGN_OPT_RES_TYPE] != NULL);
 		error = check_resource_type(
-			restool.cmd_option_args[ASSIGN_OPT_RES_TYPE]);
+			ctx->cmd_option_args[ASSIGN_OPT_RES_TYPE]);
 		if (error < 0) {
 			puts(usage_msg);
 			goto out;
 		}
 		strcpy(res_req.type,
-		       restool.cmd_option_args[ASSIGN_OPT_RES_TYPE]);
+		       ctx->cmd_option_args[ASSIGN_OPT_RES_TYPE]);
 
-		if (!(restool.cmd_option_mask &
+		if (!(ctx->cmd_option_mask &
 		    ONE_BIT_MASK(ASSIGN_OPT_COUNT))) {
 			ERROR_PRINTF("--count option missing\n");
 			puts(usage_msg);
@@ -1418,8 +1504,8 @@ static int do_dprc_assign_or_unassign(const char *usage_msg, bool do_assign)
 			goto out;
 		}
 
-		assert(restool.cmd_option_args[ASSIGN_OPT_COUNT] != NULL);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(ASSIGN_OPT_COUNT);
+		assert(ctx->cmd_option_args[ASSIGN_OPT_COUNT] != NULL);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(ASSIGN_OPT_COUNT);
 
 		if (parent_dprc_id == child_dprc_id && !do_assign) {
 			ERROR_PRINTF(
@@ -1428,30 +1514,30 @@ static int do_dprc_assign_or_unassign(const char *usage_msg, bool do_assign)
 			error = -EINVAL;
 			goto out;
 		}
-		res_req.num = atoi(restool.cmd_option_args[ASSIGN_OPT_COUNT]);
+		res_req.num = atoi(ctx->cmd_option_args[ASSIGN_OPT_COUNT]);
 		if (res_req.num <= 0) {
 			ERROR_PRINTF("Invalid --count arg: %s\n",
-				     restool.cmd_option_args[ASSIGN_OPT_COUNT]);
+				     ctx->cmd_option_args[ASSIGN_OPT_COUNT]);
 			error = -EINVAL;
 			goto out;
 		}
 
 		res_req.options = 0;
 		res_req.id_base_align = 0;
-	} else if (restool.cmd_option_mask & ONE_BIT_MASK(ASSIGN_OPT_OBJECT)) {
+	} else if (ctx->cmd_option_mask & ONE_BIT_MASK(ASSIGN_OPT_OBJECT)) {
 		/* changing plugged state, moving object case */
 		int n;
 		int state;
 
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(ASSIGN_OPT_OBJECT);
-		assert(restool.cmd_option_args[ASSIGN_OPT_OBJECT] != NULL);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(ASSIGN_OPT_OBJECT);
+		assert(ctx->cmd_option_args[ASSIGN_OPT_OBJECT] != NULL);
 
-		n = sscanf(restool.cmd_option_args[ASSIGN_OPT_OBJECT],
+		n = sscanf(ctx->cmd_option_args[ASSIGN_OPT_OBJECT],
 			   "%" STRINGIFY(OBJ_TYPE_MAX_LENGTH) "[a-z].%d",
 			   res_req.type, &res_req.id_base_align);
 		if (n != 2) {
 			ERROR_PRINTF("Invalid --object arg: \'%s\'\n",
-				restool.cmd_option_args[ASSIGN_OPT_OBJECT]);
+				ctx->cmd_option_args[ASSIGN_OPT_OBJECT]);
 
 			error = -EINVAL;
 			goto out;
@@ -1466,10 +1552,10 @@ static int do_dprc_assign_or_unassign(const char *usage_msg, bool do_assign)
 
 		res_req.options = DPRC_RES_REQ_OPT_EXPLICIT;
 
-		if (restool.cmd_option_mask &
+		if (ctx->cmd_option_mask &
 		    ONE_BIT_MASK(ASSIGN_OPT_PLUGGED)) {
 			/* changing plugged state case*/
-			restool.cmd_option_mask &=
+			ctx->cmd_option_mask &=
 				~ONE_BIT_MASK(ASSIGN_OPT_PLUGGED);
 
 			if (!do_assign) {
@@ -1478,21 +1564,21 @@ static int do_dprc_assign_or_unassign(const char *usage_msg, bool do_assign)
 				error = -EINVAL;
 				goto out;
 			}
-			if (in_use(restool.cmd_option_args[ASSIGN_OPT_OBJECT],
+			if (in_use(ctx->cmd_option_args[ASSIGN_OPT_OBJECT],
 			    "changed plugged state")) {
 				error = -EBUSY;
 				goto out;
 			}
 
-			assert(restool.cmd_option_args[ASSIGN_OPT_PLUGGED] !=
+			assert(ctx->cmd_option_args[ASSIGN_OPT_PLUGGED] !=
 			       NULL);
-			state = atoi(restool.
-					cmd_option_args[ASSIGN_OPT_PLUGGED]);
+			state = atoi(
+				ctx->cmd_option_args[ASSIGN_OPT_PLUGGED]);
 
 			if (state < 0 || state > 1) {
 				ERROR_PRINTF(
 				    "Invalid --plugged arg: \'%s\'\n",
-				restool.cmd_option_args[ASSIGN_OPT_PLUGGED]);
+				ctx->cmd_option_args[ASSIGN_OPT_PLUGGED]);
 				error = -EINVAL;
 				goto out;
 			}
@@ -1508,7 +1594,7 @@ static int do_dprc_assign_or_unassign(const char *usage_msg, bool do_assign)
 				error = -EINVAL;
 				goto out;
 			}
-			if (in_use(restool.cmd_option_args[ASSIGN_OPT_OBJECT],
+			if (in_use(ctx->cmd_option_args[ASSIGN_OPT_OBJECT],
 			    "moved"))  {
 				error = -EBUSY;
 				goto out;
@@ -1516,7 +1602,8 @@ static int do_dprc_assign_or_unassign(const char *usage_msg, bool do_assign)
 
 			struct dprc_obj_desc obj_desc;
 
-			error = lookup_obj_desc(do_assign ? parent_dprc_id :
+			error = lookup_obj_desc(ctx,
+						do_assign ? parent_dprc_id :
 							    child_dprc_id,
 						res_req.type,
 						res_req.id_base_align,
@@ -1527,7 +1614,7 @@ static int do_dprc_assign_or_unassign(const char *usage_msg, bool do_assign)
 				ERROR_PRINTF(
 				"%s cannot be moved because it is currently in plugged state\n"
 				"unplug it first\n",
-				restool.cmd_option_args[ASSIGN_OPT_OBJECT]);
+				ctx->cmd_option_args[ASSIGN_OPT_OBJECT]);
 
 				error = -EBUSY;
 				goto out;
@@ -1541,35 +1628,38 @@ static int do_dprc_assign_or_unassign(const char *usage_msg, bool do_assign)
 	}
 
 	if (do_assign) {
-		error = dprc_assign(&restool.mc_io, 0,
+		error = dprc_assign(&ctx->mc_io, ctx->cmd_flags,
 				    dprc_handle,
 				    child_dprc_id,
 				    &res_req);
 		if (error < 0) {
-			mc_status = flib_error_to_mc_status(error);
+			ctx->mc_status = flib_error_to_mc_status(error);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 		}
 	} else {
-		error = dprc_unassign(&restool.mc_io, 0,
+		error = dprc_unassign(&ctx->mc_io, ctx->cmd_flags,
 				      dprc_handle,
 				      child_dprc_id,
 				      &res_req);
 		if (error < 0) {
-			mc_status = flib_error_to_mc_status(error);
+			ctx->mc_status = flib_error_to_mc_status(error);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 		}
 	}
 out:
 	if (dprc_opened) {
 		int error2;
 
-		error2 = dprc_close(&restool.mc_io, 0, dprc_handle);
+		error2 = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -1578,7 +1668,7 @@ out:
 	return error;
 }
 
-static int cmd_dprc_assign(void)
+static int cmd_dprc_assign(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -1619,10 +1709,10 @@ static int cmd_dprc_assign(void)
 		"  $ restool dprc assign dprc.1 --object=dprc.2 --plugged=1\n"
 		"\n";
 
-	return do_dprc_assign_or_unassign(usage_msg, true);
+	return do_dprc_assign_or_unassign(ctx, usage_msg, true);
 }
 
-static int cmd_dprc_unassign(void)
+static int cmd_dprc_unassign(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -1644,10 +1734,10 @@ static int cmd_dprc_unassign(void)
 		"   $ restool dprc unassign dprc.1 --child=dprc.4 --object=dpni.2\n"
 		"\n";
 
-	return do_dprc_assign_or_unassign(usage_msg, false);
+	return do_dprc_assign_or_unassign(ctx, usage_msg, false);
 }
 
-static int cmd_dprc_set_label(void)
+static int cmd_dprc_set_label(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -1675,37 +1765,37 @@ static int cmd_dprc_set_label(void)
 	bool found;
 
 	memset(&target_obj_desc, 0, sizeof(target_obj_desc));
-	if (restool.cmd_option_mask & ONE_BIT_MASK(SET_LABEL_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(SET_LABEL_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(SET_LABEL_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(SET_LABEL_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	n = sscanf(restool.obj_name, "%" STRINGIFY(OBJ_TYPE_MAX_LENGTH)
+	n = sscanf(ctx->obj_name, "%" STRINGIFY(OBJ_TYPE_MAX_LENGTH)
 		   "[a-z].%u", obj_type, &obj_id);
 	if (n != 2) {
-		ERROR_PRINTF("Invalid MC object name: %s\n", restool.obj_name);
+		ERROR_PRINTF("Invalid MC object name: %s\n", ctx->obj_name);
 		return -EINVAL;
 	}
 
-	if (strcmp(obj_type, "dprc") == 0 && obj_id == restool.root_dprc_id) {
+	if (strcmp(obj_type, "dprc") == 0 && obj_id == ctx->root_dprc_id) {
 		ERROR_PRINTF("CANNOT set label for root dprc, i.e. dprc.1\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(SET_LABEL_OPT_LABEL)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(SET_LABEL_OPT_LABEL);
-		if (strlen(restool.cmd_option_args[SET_LABEL_OPT_LABEL]) >
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(SET_LABEL_OPT_LABEL)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(SET_LABEL_OPT_LABEL);
+		if (strlen(ctx->cmd_option_args[SET_LABEL_OPT_LABEL]) >
 		    MC_OBJ_LABEL_MAX_LENGTH) {
 			ERROR_PRINTF("label length > %d characters\n",
 					MC_OBJ_LABEL_MAX_LENGTH);
@@ -1713,7 +1803,7 @@ static int cmd_dprc_set_label(void)
 			error = -EINVAL;
 			goto out;
 		}
-		if (strlen(restool.cmd_option_args[SET_LABEL_OPT_LABEL]) == 0) {
+		if (strlen(ctx->cmd_option_args[SET_LABEL_OPT_LABEL]) == 0) {
 			ERROR_PRINTF("label length = 0 charcter\n");
 			puts(usage_msg);
 			error = -EINVAL;
@@ -1726,13 +1816,13 @@ static int cmd_dprc_set_label(void)
 		goto out;
 	}
 
-	error = find_target_obj_desc(restool.root_dprc_id,
-			restool.root_dprc_handle, 0, obj_id, obj_type,
+	error = find_target_obj_desc(ctx, ctx->root_dprc_id,
+			ctx->root_dprc_handle, 0, obj_id, obj_type,
 			&target_obj_desc, &target_parent_dprc_id, &found);
 
 	if (!found) {
 		if (error == 0)
-			printf("%s does not exist\n", restool.obj_name);
+			output_notice("%s does not exist\n", ctx->obj_name);
 		error = -EINVAL;
 		goto out;
 	}
@@ -1740,23 +1830,23 @@ static int cmd_dprc_set_label(void)
 	if (error < 0)
 		goto out;
 
-	if (target_parent_dprc_id == restool.root_dprc_id)
-		target_parent_dprc_handle = restool.root_dprc_handle;
+	if (target_parent_dprc_id == ctx->root_dprc_id)
+		target_parent_dprc_handle = ctx->root_dprc_handle;
 	else {
-		error = open_dprc(target_parent_dprc_id,
+		error = open_dprc(ctx, target_parent_dprc_id,
 				&target_parent_dprc_handle);
 		if (error < 0)
 			goto out;
 		target_parent_dprc_opened = true;
 	}
 
-	error = dprc_set_obj_label(&restool.mc_io, 0,
+	error = dprc_set_obj_label(&ctx->mc_io, ctx->cmd_flags,
 			target_parent_dprc_handle, obj_type, obj_id,
-			restool.cmd_option_args[SET_LABEL_OPT_LABEL]);
+			ctx->cmd_option_args[SET_LABEL_OPT_LABEL]);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-		     mc_status_to_string(mc_status), mc_status);
+		     mc_status_to_string(ctx->mc_status), ctx->mc_status);
 		goto out;
 	}
 
@@ -1766,12 +1856,13 @@ out:
 	if (target_parent_dprc_opened) {
 		int error2;
 
-		error2 = dprc_close(&restool.mc_io, 0,
+		error2 = dprc_close(&ctx->mc_io, ctx->cmd_flags,
 					target_parent_dprc_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -1799,7 +1890,7 @@ static int parse_endpoint(char *endpoint_str, struct dprc_endpoint *endpoint)
 	return 0;
 }
 
-static int cmd_dprc_connect(void)
+static int cmd_dprc_connect(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -1844,72 +1935,73 @@ static int cmd_dprc_connect(void)
 	long value;
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CONNECT_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CONNECT_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CONNECT_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CONNECT_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<parent-container> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name,
+	error = parse_object_name(ctx->obj_name,
 				  "dprc", &parent_dprc_id);
 	if (error < 0)
 		goto out;
 
-	if (parent_dprc_id != restool.root_dprc_id) {
-		error = open_dprc(parent_dprc_id, &dprc_handle);
+	if (parent_dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, parent_dprc_id, &dprc_handle);
 		if (error < 0)
 			goto out;
 
 		dprc_opened = true;
 	} else {
-		dprc_handle = restool.root_dprc_handle;
+		dprc_handle = ctx->root_dprc_handle;
 	}
 
-	if (!(restool.cmd_option_mask & ONE_BIT_MASK(CONNECT_OPT_ENDPOINT1))) {
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(CONNECT_OPT_ENDPOINT1))) {
 		ERROR_PRINTF("--endpoint1 option missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	restool.cmd_option_mask &= ~ONE_BIT_MASK(CONNECT_OPT_ENDPOINT1);
-	assert(restool.cmd_option_args[CONNECT_OPT_ENDPOINT1] != NULL);
-	error = parse_endpoint(restool.cmd_option_args[CONNECT_OPT_ENDPOINT1],
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(CONNECT_OPT_ENDPOINT1);
+	assert(ctx->cmd_option_args[CONNECT_OPT_ENDPOINT1] != NULL);
+	error = parse_endpoint(ctx->cmd_option_args[CONNECT_OPT_ENDPOINT1],
 			       &endpoint1);
 	if (error < 0) {
 		ERROR_PRINTF("Invalid --endpoint1 arg: '%s'\n",
-			     restool.cmd_option_args[CONNECT_OPT_ENDPOINT1]);
+			     ctx->cmd_option_args[CONNECT_OPT_ENDPOINT1]);
 		goto out;
 	}
 
-	if (!(restool.cmd_option_mask & ONE_BIT_MASK(CONNECT_OPT_ENDPOINT2))) {
+	if (!(ctx->cmd_option_mask & ONE_BIT_MASK(CONNECT_OPT_ENDPOINT2))) {
 		ERROR_PRINTF("--endpoint2 option missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	restool.cmd_option_mask &= ~ONE_BIT_MASK(CONNECT_OPT_ENDPOINT2);
-	assert(restool.cmd_option_args[CONNECT_OPT_ENDPOINT2] != NULL);
-	error = parse_endpoint(restool.cmd_option_args[CONNECT_OPT_ENDPOINT2],
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(CONNECT_OPT_ENDPOINT2);
+	assert(ctx->cmd_option_args[CONNECT_OPT_ENDPOINT2] != NULL);
+	error = parse_endpoint(ctx->cmd_option_args[CONNECT_OPT_ENDPOINT2],
 			       &endpoint2);
 	if (error < 0) {
 		ERROR_PRINTF("Invalid --endpoint2 arg: '%s'\n",
-			     restool.cmd_option_args[CONNECT_OPT_ENDPOINT2]);
+			     ctx->cmd_option_args[CONNECT_OPT_ENDPOINT2]);
 		goto out;
 	}
 
-	if (restool.cmd_option_args[CONNECT_OPT_COMMITTED_RATE]) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CONNECT_OPT_COMMITTED_RATE);
-		error = get_option_value(CONNECT_OPT_COMMITTED_RATE, &value,
+	if (ctx->cmd_option_args[CONNECT_OPT_COMMITTED_RATE]) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CONNECT_OPT_COMMITTED_RATE);
+		error = get_option_value(ctx, CONNECT_OPT_COMMITTED_RATE,
+					 &value,
 					 "Invalid committed-rate value\n",
 					 1, UINT32_MAX);
 		if (error)
@@ -1920,9 +2012,9 @@ static int cmd_dprc_connect(void)
 		dprc_connection_cfg.committed_rate = 0;
 	}
 
-	if (restool.cmd_option_args[CONNECT_OPT_MAX_RATE]) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CONNECT_OPT_MAX_RATE);
-		error = get_option_value(CONNECT_OPT_MAX_RATE, &value,
+	if (ctx->cmd_option_args[CONNECT_OPT_MAX_RATE]) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CONNECT_OPT_MAX_RATE);
+		error = get_option_value(ctx, CONNECT_OPT_MAX_RATE, &value,
 					 "Invalid max-rate value\n",
 					 1, UINT32_MAX);
 		if (error)
@@ -1943,26 +2035,28 @@ static int cmd_dprc_connect(void)
 		return -EINVAL;
 	}
 
-	error = dprc_connect(&restool.mc_io, 0,
+	error = dprc_connect(&ctx->mc_io, ctx->cmd_flags,
 			     dprc_handle,
 			     &endpoint1,
 			     &endpoint2,
 			     &dprc_connection_cfg);
 
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 	}
 out:
 	if (dprc_opened) {
 		int error2;
 
-		error2 = dprc_close(&restool.mc_io, 0, dprc_handle);
+		error2 = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -1971,7 +2065,7 @@ out:
 	return error;
 }
 
-static int cmd_dprc_disconnect(void)
+static int cmd_dprc_disconnect(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -1997,36 +2091,36 @@ static int cmd_dprc_disconnect(void)
 	uint32_t parent_dprc_id;
 	struct dprc_endpoint endpoint;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(DISCONNECT_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(DISCONNECT_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(DISCONNECT_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(DISCONNECT_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<parent-container> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name,
+	error = parse_object_name(ctx->obj_name,
 				  "dprc", &parent_dprc_id);
 	if (error < 0)
 		goto out;
 
-	if (parent_dprc_id != restool.root_dprc_id) {
-		error = open_dprc(parent_dprc_id, &dprc_handle);
+	if (parent_dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, parent_dprc_id, &dprc_handle);
 		if (error < 0)
 			goto out;
 
 		dprc_opened = true;
 	} else {
-		dprc_handle = restool.root_dprc_handle;
+		dprc_handle = ctx->root_dprc_handle;
 	}
 
-	if (!(restool.cmd_option_mask &
+	if (!(ctx->cmd_option_mask &
 	    ONE_BIT_MASK(DISCONNECT_OPT_ENDPOINT))) {
 		ERROR_PRINTF("--endpoint option missing\n");
 		puts(usage_msg);
@@ -2034,34 +2128,36 @@ static int cmd_dprc_disconnect(void)
 		goto out;
 	}
 
-	restool.cmd_option_mask &= ~ONE_BIT_MASK(DISCONNECT_OPT_ENDPOINT);
-	assert(restool.cmd_option_args[DISCONNECT_OPT_ENDPOINT] != NULL);
-	error = parse_endpoint(restool.cmd_option_args[DISCONNECT_OPT_ENDPOINT],
+	ctx->cmd_option_mask &= ~ONE_BIT_MASK(DISCONNECT_OPT_ENDPOINT);
+	assert(ctx->cmd_option_args[DISCONNECT_OPT_ENDPOINT] != NULL);
+	error = parse_endpoint(ctx->cmd_option_args[DISCONNECT_OPT_ENDPOINT],
 			       &endpoint);
 	if (error < 0) {
 		ERROR_PRINTF("Invalid --endpoint arg: '%s'\n",
-			     restool.cmd_option_args[DISCONNECT_OPT_ENDPOINT]);
+			     ctx->cmd_option_args[DISCONNECT_OPT_ENDPOINT]);
 		goto out;
 	}
 
-	error = dprc_disconnect(&restool.mc_io, 0,
+	error = dprc_disconnect(&ctx->mc_io, ctx->cmd_flags,
 				dprc_handle,
 				&endpoint);
 
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 	}
 out:
 	if (dprc_opened) {
 		int error2;
 
-		error2 = dprc_close(&restool.mc_io, 0, dprc_handle);
+		error2 = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -2070,7 +2166,7 @@ out:
 	return error;
 }
 
-static int cmd_dpl_generate(void)
+static int cmd_dpl_generate(struct restool *ctx)
 {
 	int error;
 
@@ -2088,13 +2184,13 @@ static int cmd_dpl_generate(void)
 		"   $ restool dprc generate-dpl dprc.1\n"
 		"\n";
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(GENERATE_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(GENERATE_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(GENERATE_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(GENERATE_OPT_HELP);
 		return 0;
 	}
 
-	error = dpl_generate();
+	error = dpl_generate(ctx);
 
 	return error;
 }
@@ -2129,7 +2225,8 @@ struct object_command dprc_commands[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dprc_destroy_options,
-	  .cmd_func = cmd_dprc_destroy_child },
+	  .cmd_func = cmd_dprc_destroy_child,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = "assign",
 	  .options = dprc_assign_options,
@@ -2137,7 +2234,8 @@ struct object_command dprc_commands[] = {
 
 	{ .cmd_name = "unassign",
 	  .options = dprc_assign_options,
-	  .cmd_func = cmd_dprc_unassign },
+	  .cmd_func = cmd_dprc_unassign,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = "set-label",
 	  .options = dprc_set_label_options,
@@ -2149,7 +2247,8 @@ struct object_command dprc_commands[] = {
 
 	{ .cmd_name = "disconnect",
 	  .options = dprc_disconnect_options,
-	  .cmd_func = cmd_dprc_disconnect },
+	  .cmd_func = cmd_dprc_disconnect,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = "generate-dpl",
 	  .options = dpl_generate_options,
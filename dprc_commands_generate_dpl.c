@@ -175,10 +175,13 @@ struct container_list {
 	uint64_t options;
 };
 
-static int container_count;
-static struct container_list *container_head;
-static struct obj_list *obj_head;
-static struct conn_list *conn_head;
+static __thread int container_count;
+static __thread struct container_list *container_head;
+static __thread struct obj_list *obj_head;
+static __thread struct conn_list *conn_head;
+
+/* stdout, or a memory stream with --output=json */
+static __thread FILE *dpl_fp;
 
 /**
  * compare_insert_obj - compare the newly added object node with existing ones,
@@ -252,7 +255,7 @@ static int compare_insert_obj(struct obj_list **head, struct obj_list *target)
 	return 0;
 }
 
-static int find_all_obj_desc(uint32_t dprc_id,
+static int find_all_obj_desc(struct restool *ctx, uint32_t dprc_id,
 			     uint16_t dprc_handle,
 			     int nesting_level,
 			     struct container_list **prev,
@@ -292,23 +295,25 @@ static int find_all_obj_desc(uint32_t dprc_id,
 	prev_cont = curr_cont;
 
 	memset(&dprc_attr, 0, sizeof(dprc_attr));
-	error = dprc_get_attributes(&restool.mc_io, 0,
+	error = dprc_get_attributes(&ctx->mc_io, ctx->cmd_flags,
 				dprc_handle, &dprc_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	curr_cont->options = dprc_attr.options;
 	container_count++;
-	error = dprc_get_obj_count(&restool.mc_io, 0,
+	error = dprc_get_obj_count(&ctx->mc_io, ctx->cmd_flags,
 				   dprc_handle,
 				   &num_child_devices);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 
@@ -318,7 +323,7 @@ static int find_all_obj_desc(uint32_t dprc_id,
 		int error2;
 
 		error = dprc_get_obj(
-				&restool.mc_io, 0,
+				&ctx->mc_io, ctx->cmd_flags,
 				dprc_handle,
 				i,
 				&obj_desc);
@@ -333,13 +338,13 @@ static int find_all_obj_desc(uint32_t dprc_id,
 
 		if (strcmp(obj_desc.type, "dprc") == 0) {
 
-			error = open_dprc(obj_desc.id, &child_dprc_handle);
+			error = open_dprc(ctx, obj_desc.id, &child_dprc_handle);
 			if (error < 0)
 				goto out;
 
 			DEBUG_PRINTF("entering %s.%u\n", obj_desc.type,
 					obj_desc.id);
-			error = find_all_obj_desc(obj_desc.id,
+			error = find_all_obj_desc(ctx, obj_desc.id,
 					child_dprc_handle,
 					nesting_level + 1,
 					&prev_cont,
@@ -347,12 +352,13 @@ static int find_all_obj_desc(uint32_t dprc_id,
 			if (prev)
 				*prev = prev_cont;
 
-			error2 = dprc_close(&restool.mc_io, 0,
+			error2 = dprc_close(&ctx->mc_io, ctx->cmd_flags,
 						child_dprc_handle);
 			if (error2 < 0) {
-				mc_status = flib_error_to_mc_status(error2);
+				ctx->mc_status = flib_error_to_mc_status(error2);
 				ERROR_PRINTF("MC error: %s (status %#x)\n",
-				mc_status_to_string(mc_status), mc_status);
+				mc_status_to_string(ctx->mc_status),
+				ctx->mc_status);
 				if (error == 0)
 					error = error2;
 
@@ -401,7 +407,7 @@ out:
 	return error;
 }
 
-static int parse_layout(uint32_t dprc_id)
+static int parse_layout(struct restool *ctx, uint32_t dprc_id)
 {
 	int error;
 
@@ -410,28 +416,31 @@ static int parse_layout(uint32_t dprc_id)
 	uint16_t dprc_handle;
 
 	/* if no dprc specified, use root dprc */
-	if (restool.obj_name == NULL || dprc_id == restool.root_dprc_id) {
-		dprc_id = restool.root_dprc_id;
-		dprc_handle = restool.root_dprc_handle;
+	if (ctx->obj_name == NULL || dprc_id == ctx->root_dprc_id) {
+		dprc_id = ctx->root_dprc_id;
+		dprc_handle = ctx->root_dprc_handle;
 	} else {
-		error = dprc_open(&restool.mc_io, 0, dprc_id, &dprc_handle);
+		error = dprc_open(&ctx->mc_io, ctx->cmd_flags, dprc_id,
+				  &dprc_handle);
 		if (error < 0) {
-			mc_status = flib_error_to_mc_status(error);
+			ctx->mc_status = flib_error_to_mc_status(error);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			goto out;
 		}
 		opened = true;
 	}
 
-	error = find_all_obj_desc(dprc_id, dprc_handle, 0, NULL, 0);
+	error = find_all_obj_desc(ctx, dprc_id, dprc_handle, 0, NULL, 0);
 
 	if (opened == true) {
-		error = dprc_close(&restool.mc_io, 0, dprc_handle);
+		error = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 		if (error < 0) {
-			mc_status = flib_error_to_mc_status(error);
+			ctx->mc_status = flib_error_to_mc_status(error);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			goto out;
 		}
 
@@ -525,7 +534,7 @@ static char *to_upper(char *string)
 static int write_obj_set(char *obj_type, int start_index, int end_index)
 {
 	char *obj_type_upper;
-	FILE *fp = stdout;
+	FILE *fp = dpl_fp;
 	int i;
 
 	obj_type_upper = to_upper(obj_type);
@@ -548,7 +557,7 @@ static int write_obj_set(char *obj_type, int start_index, int end_index)
 	return 0;
 }
 
-static int write_containers(void)
+static int write_containers(struct restool *ctx)
 {
 	struct container_list *curr_cont;
 	struct obj_list *curr_obj;
@@ -558,7 +567,7 @@ static int write_containers(void)
 	int curr_obj_id;
 	int obj_num = 99;
 	int base = 100;
-	FILE *fp = stdout;
+	FILE *fp = dpl_fp;
 
 	fprintf(fp,
 		"\t/*****************************************************************\n");
@@ -600,14 +609,14 @@ static int write_containers(void)
 				obj_num = obj_num + base - remain;
 			}
 
-			if (restool.mc_fw_version.major <= MC_FW_VERSION_9) {
+			if (ctx->mc_fw_version.major <= MC_FW_VERSION_9) {
 				fprintf(fp, "\n");
 				fprintf(fp, "\t\t\t\tobj@%d {\n", obj_num);
 				fprintf(fp, "\t\t\t\t\tobj_name = \"%s@%d\";\n",
 					curr_obj->type, curr_obj->id);
 				parse_obj_label(fp, curr_obj->label);
 				fprintf(fp, "\t\t\t\t};\n");
-			} else if (restool.mc_fw_version.major == MC_FW_VERSION_10) {
+			} else if (ctx->mc_fw_version.major == MC_FW_VERSION_10) {
 				if (curr_obj_type[0] == '\0') {
 					memcpy(curr_obj_type, curr_obj->type, OBJ_TYPE_MAX_LENGTH);
 					curr_obj_id = curr_obj->id;
@@ -751,18 +760,20 @@ static int parse_dpaiop(FILE *fp, struct obj_list *curr)
 	return 0;
 }
 
-static int parse_dpcon(FILE *fp, struct obj_list *curr)
+static int parse_dpcon(struct restool *ctx, FILE *fp, struct obj_list *curr)
 {
 	uint16_t dpcon_handle;
 	int error;
 	struct dpcon_attr dpcon_attr;
 	bool dpcon_opened = false;
 
-	error = dpcon_open(&restool.mc_io, 0, curr->id, &dpcon_handle);
+	error = dpcon_open(&ctx->mc_io, ctx->cmd_flags, curr->id,
+			   &dpcon_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpcon_opened = true;
@@ -775,12 +786,13 @@ static int parse_dpcon(FILE *fp, struct obj_list *curr)
 	}
 
 	memset(&dpcon_attr, 0, sizeof(dpcon_attr));
-	error = dpcon_get_attributes(&restool.mc_io, 0, dpcon_handle,
+	error = dpcon_get_attributes(&ctx->mc_io, ctx->cmd_flags, dpcon_handle,
 					&dpcon_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(curr->id == dpcon_attr.id);
@@ -794,11 +806,12 @@ out:
 	if (dpcon_opened) {
 		int error2;
 
-		error2 = dpcon_close(&restool.mc_io, 0, dpcon_handle);
+		error2 = dpcon_close(&ctx->mc_io, ctx->cmd_flags, dpcon_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -807,7 +820,7 @@ out:
 	return error;
 }
 
-static int parse_dpdcei(FILE *fp, struct obj_list *curr)
+static int parse_dpdcei(struct restool *ctx, FILE *fp, struct obj_list *curr)
 {
 	/* dpdcei_attr{} does not have a field called priority */
 	uint16_t dpdcei_handle;
@@ -815,11 +828,13 @@ static int parse_dpdcei(FILE *fp, struct obj_list *curr)
 	struct dpdcei_attr dpdcei_attr;
 	bool dpdcei_opened = false;
 
-	error = dpdcei_open(&restool.mc_io, 0, curr->id, &dpdcei_handle);
+	error = dpdcei_open(&ctx->mc_io, ctx->cmd_flags, curr->id,
+			    &dpdcei_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpdcei_opened = true;
@@ -832,12 +847,14 @@ static int parse_dpdcei(FILE *fp, struct obj_list *curr)
 	}
 
 	memset(&dpdcei_attr, 0, sizeof(dpdcei_attr));
-	error = dpdcei_get_attributes(&restool.mc_io, 0, dpdcei_handle,
+	error = dpdcei_get_attributes(&ctx->mc_io, ctx->cmd_flags,
+				      dpdcei_handle,
 					&dpdcei_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(curr->id == dpdcei_attr.id);
@@ -860,11 +877,13 @@ out:
 	if (dpdcei_opened) {
 		int error2;
 
-		error2 = dpdcei_close(&restool.mc_io, 0, dpdcei_handle);
+		error2 = dpdcei_close(&ctx->mc_io, ctx->cmd_flags,
+				      dpdcei_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -873,18 +892,20 @@ out:
 	return error;
 }
 
-static int parse_dpdmai(FILE *fp, struct obj_list *curr)
+static int parse_dpdmai(struct restool *ctx, FILE *fp, struct obj_list *curr)
 {
 	uint16_t dpdmai_handle;
 	int error;
 	struct dpdmai_attr dpdmai_attr;
 	bool dpdmai_opened = false;
 
-	error = dpdmai_open(&restool.mc_io, 0, curr->id, &dpdmai_handle);
+	error = dpdmai_open(&ctx->mc_io, ctx->cmd_flags, curr->id,
+			    &dpdmai_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpdmai_opened = true;
@@ -897,12 +918,14 @@ static int parse_dpdmai(FILE *fp, struct obj_list *curr)
 	}
 
 	memset(&dpdmai_attr, 0, sizeof(dpdmai_attr));
-	error = dpdmai_get_attributes(&restool.mc_io, 0, dpdmai_handle,
+	error = dpdmai_get_attributes(&ctx->mc_io, ctx->cmd_flags,
+				      dpdmai_handle,
 					&dpdmai_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(curr->id == dpdmai_attr.id);
@@ -916,11 +939,13 @@ out:
 	if (dpdmai_opened) {
 		int error2;
 
-		error2 = dpdmai_close(&restool.mc_io, 0, dpdmai_handle);
+		error2 = dpdmai_close(&ctx->mc_io, ctx->cmd_flags,
+				      dpdmai_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -929,18 +954,19 @@ out:
 	return error;
 }
 
-static int parse_dpio(FILE *fp, struct obj_list *curr)
+static int parse_dpio(struct restool *ctx, FILE *fp, struct obj_list *curr)
 {
 	uint16_t dpio_handle;
 	int error;
 	struct dpio_attr dpio_attr;
 	bool dpio_opened = false;
 
-	error = dpio_open(&restool.mc_io, 0, curr->id, &dpio_handle);
+	error = dpio_open(&ctx->mc_io, ctx->cmd_flags, curr->id, &dpio_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpio_opened = true;
@@ -953,11 +979,13 @@ static int parse_dpio(FILE *fp, struct obj_list *curr)
 	}
 
 	memset(&dpio_attr, 0, sizeof(dpio_attr));
-	error = dpio_get_attributes(&restool.mc_io, 0, dpio_handle, &dpio_attr);
+	error = dpio_get_attributes(&ctx->mc_io, ctx->cmd_flags, dpio_handle,
+				    &dpio_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(curr->id == dpio_attr.id);
@@ -975,11 +1003,12 @@ out:
 	if (dpio_opened) {
 		int error2;
 
-		error2 = dpio_close(&restool.mc_io, 0, dpio_handle);
+		error2 = dpio_close(&ctx->mc_io, ctx->cmd_flags, dpio_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -988,7 +1017,7 @@ out:
 	return error;
 }
 
-static int parse_dpseci(FILE *fp, struct obj_list *curr)
+static int parse_dpseci(struct restool *ctx, FILE *fp, struct obj_list *curr)
 {
 	int error;
 	uint16_t dpseci_handle;
@@ -997,11 +1026,13 @@ static int parse_dpseci(FILE *fp, struct obj_list *curr)
 	struct dpseci_tx_queue_attr tx_attr;
 	char *priorities;
 
-	error = dpseci_open(&restool.mc_io, 0, curr->id, &dpseci_handle);
+	error = dpseci_open(&ctx->mc_io, ctx->cmd_flags, curr->id,
+			    &dpseci_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpseci_opened = true;
@@ -1015,12 +1046,14 @@ static int parse_dpseci(FILE *fp, struct obj_list *curr)
 	memset(&tx_attr, 0, sizeof(tx_attr));
 	memset(&dpseci_attr, 0, sizeof(dpseci_attr));
 
-	error = dpseci_get_attributes(&restool.mc_io, 0, dpseci_handle,
+	error = dpseci_get_attributes(&ctx->mc_io, ctx->cmd_flags,
+				      dpseci_handle,
 					&dpseci_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 
@@ -1032,13 +1065,15 @@ static int parse_dpseci(FILE *fp, struct obj_list *curr)
 	}
 
 	for (int i = 0; i < dpseci_attr.num_tx_queues; i++) {
-		error = dpseci_get_tx_queue(&restool.mc_io, 0, dpseci_handle,
+		error = dpseci_get_tx_queue(&ctx->mc_io, ctx->cmd_flags,
+					    dpseci_handle,
 					    i, &tx_attr);
 
 		if (error < 0) {
-			mc_status = flib_error_to_mc_status(error);
+			ctx->mc_status = flib_error_to_mc_status(error);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			free(priorities);
 			goto out;
 		}
@@ -1057,11 +1092,13 @@ out:
 	if (dpseci_opened) {
 		int error2;
 
-		error2 = dpseci_close(&restool.mc_io, 0, dpseci_handle);
+		error2 = dpseci_close(&ctx->mc_io, ctx->cmd_flags,
+				      dpseci_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				mc_status_to_string(mc_status), mc_status);
+				mc_status_to_string(ctx->mc_status),
+				ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -1070,7 +1107,7 @@ out:
 }
 
 /* following objects have possible connections*/
-static int parse_dpci(FILE *fp, struct obj_list *curr)
+static int parse_dpci(struct restool *ctx, FILE *fp, struct obj_list *curr)
 {
 	uint16_t dpci_handle;
 	int error;
@@ -1079,11 +1116,12 @@ static int parse_dpci(FILE *fp, struct obj_list *curr)
 	bool dpci_opened = false;
 	struct conn_list *curr_conn;
 
-	error = dpci_open(&restool.mc_io, 0, curr->id, &dpci_handle);
+	error = dpci_open(&ctx->mc_io, ctx->cmd_flags, curr->id, &dpci_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpci_opened = true;
@@ -1096,21 +1134,25 @@ static int parse_dpci(FILE *fp, struct obj_list *curr)
 	}
 
 	memset(&dpci_attr, 0, sizeof(dpci_attr));
-	error = dpci_get_attributes(&restool.mc_io, 0, dpci_handle, &dpci_attr);
+	error = dpci_get_attributes(&ctx->mc_io, ctx->cmd_flags, dpci_handle,
+				    &dpci_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(curr->id == dpci_attr.id);
 
-	error = dpci_get_peer_attributes(&restool.mc_io, 0, dpci_handle,
+	error = dpci_get_peer_attributes(&ctx->mc_io, ctx->cmd_flags,
+					 dpci_handle,
 					 &dpci_peer_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 
@@ -1146,11 +1188,12 @@ out:
 	if (dpci_opened) {
 		int error2;
 
-		error2 = dpci_close(&restool.mc_io, 0, dpci_handle);
+		error2 = dpci_close(&ctx->mc_io, ctx->cmd_flags, dpci_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -1297,7 +1340,8 @@ static void parse_dpni_options_v10(FILE *fp, uint32_t options)
 	fprintf(fp, "%s\n", buf);
 }
 
-static int parse_endpoint_dpl(struct obj_list *curr_obj, uint16_t num_ifs)
+static int parse_endpoint_dpl(struct restool *ctx, struct obj_list *curr_obj,
+			      uint16_t num_ifs)
 {
 	struct dprc_endpoint endpoint1;
 	struct dprc_endpoint endpoint2;
@@ -1319,8 +1363,8 @@ static int parse_endpoint_dpl(struct obj_list *curr_obj, uint16_t num_ifs)
 		endpoint1.id = curr_obj->id;
 		endpoint1.if_id = k;
 
-		error = dprc_get_connection(&restool.mc_io, 0,
-					restool.root_dprc_handle,
+		error = dprc_get_connection(&ctx->mc_io, ctx->cmd_flags,
+					ctx->root_dprc_handle,
 					&endpoint1,
 					&endpoint2,
 					&state);
@@ -1404,9 +1448,10 @@ static int parse_endpoint_dpl(struct obj_list *curr_obj, uint16_t num_ifs)
 				DEBUG_PRINTF(", link is in error state\n");
 
 		} else {
-			mc_status = flib_error_to_mc_status(error);
+			ctx->mc_status = flib_error_to_mc_status(error);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				mc_status_to_string(mc_status), mc_status);
+				mc_status_to_string(ctx->mc_status),
+				ctx->mc_status);
 			return error;
 		}
 
@@ -1417,7 +1462,7 @@ static int parse_endpoint_dpl(struct obj_list *curr_obj, uint16_t num_ifs)
 	return 0;
 }
 
-static int parse_dpni_v9(FILE *fp, struct obj_list *curr)
+static int parse_dpni_v9(struct restool *ctx, FILE *fp, struct obj_list *curr)
 {
 	uint16_t dpni_handle;
 	int error;
@@ -1429,11 +1474,12 @@ static int parse_dpni_v9(FILE *fp, struct obj_list *curr)
 	memset(&dpni_extended_cfg, 0, sizeof(dpni_extended_cfg));
 	memset(&dpni_attr, 0, sizeof(dpni_attr));
 
-	error = dpni_open(&restool.mc_io, 0, curr->id, &dpni_handle);
+	error = dpni_open(&ctx->mc_io, ctx->cmd_flags, curr->id, &dpni_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpni_opened = true;
@@ -1445,29 +1491,31 @@ static int parse_dpni_v9(FILE *fp, struct obj_list *curr)
 		goto out;
 	}
 
-	error = dpni_get_attributes_v9(&restool.mc_io, 0, dpni_handle,
+	error = dpni_get_attributes_v9(&ctx->mc_io, ctx->cmd_flags, dpni_handle,
 				       &dpni_attr, &dpni_extended_cfg);
 
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 
 	assert(curr->id == dpni_attr.id);
 	assert(DPNI_MAX_TC >= dpni_attr.max_tcs);
 
-	error = dpni_get_primary_mac_addr(&restool.mc_io, 0,
+	error = dpni_get_primary_mac_addr(&ctx->mc_io, ctx->cmd_flags,
 					dpni_handle, mac_addr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 
-	parse_endpoint_dpl(curr, 1000);
+	parse_endpoint_dpl(ctx, curr, 1000);
 
 	fprintf(fp, "\t\t\tmac_addr = <");
 	for (int j = 0; j < 5; ++j)
@@ -1542,11 +1590,12 @@ out:
 	if (dpni_opened) {
 		int error2;
 
-		error2 = dpni_close(&restool.mc_io, 0, dpni_handle);
+		error2 = dpni_close(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -1555,7 +1604,7 @@ out:
 	return error;
 }
 
-static int parse_dpni_v10(FILE *fp, struct obj_list *curr)
+static int parse_dpni_v10(struct restool *ctx, FILE *fp, struct obj_list *curr)
 {
 	struct dpni_attr_v10 dpni_attr;
 	uint16_t dpni_handle;
@@ -1563,11 +1612,12 @@ static int parse_dpni_v10(FILE *fp, struct obj_list *curr)
 	int error = 0;
 	int error2;
 
-	error = dpni_open(&restool.mc_io, 0, curr->id, &dpni_handle);
+	error = dpni_open(&ctx->mc_io, ctx->cmd_flags, curr->id, &dpni_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpni_opened = true;
@@ -1580,16 +1630,17 @@ static int parse_dpni_v10(FILE *fp, struct obj_list *curr)
 	}
 
 	memset(&dpni_attr, 0, sizeof(dpni_attr));
-	error = dpni_get_attributes_v10(&restool.mc_io, 0,
+	error = dpni_get_attributes_v10(&ctx->mc_io, ctx->cmd_flags,
 					dpni_handle, &dpni_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 
-	parse_endpoint_dpl(curr, 1000);
+	parse_endpoint_dpl(ctx, curr, 1000);
 
 	fprintf(fp, "\t\t\ttype = \"DPNI_TYPE_NIC\";\n");
 
@@ -1605,11 +1656,12 @@ static int parse_dpni_v10(FILE *fp, struct obj_list *curr)
 out:
 	if (dpni_opened) {
 
-		error2 = dpni_close(&restool.mc_io, 0, dpni_handle);
+		error2 = dpni_close(&ctx->mc_io, ctx->cmd_flags, dpni_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -1692,18 +1744,20 @@ static void parse_dpdmux_manip(FILE *fp, enum dpdmux_manip manip)
 	}
 }
 
-static int parse_dpdmux_v9(FILE *fp, struct obj_list *curr)
+static int parse_dpdmux_v9(struct restool *ctx, FILE *fp, struct obj_list *curr)
 {
 	uint16_t dpdmux_handle;
 	int error;
 	struct dpdmux_attr_v9 dpdmux_attr;
 	bool dpdmux_opened = false;
 
-	error = dpdmux_open(&restool.mc_io, 0, curr->id, &dpdmux_handle);
+	error = dpdmux_open(&ctx->mc_io, ctx->cmd_flags, curr->id,
+			    &dpdmux_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpdmux_opened = true;
@@ -1716,17 +1770,19 @@ static int parse_dpdmux_v9(FILE *fp, struct obj_list *curr)
 	}
 
 	memset(&dpdmux_attr, 0, sizeof(dpdmux_attr));
-	error = dpdmux_get_attributes_v9(&restool.mc_io, 0, dpdmux_handle,
+	error = dpdmux_get_attributes_v9(&ctx->mc_io, ctx->cmd_flags,
+					 dpdmux_handle,
 					&dpdmux_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(curr->id == dpdmux_attr.id);
 
-	parse_endpoint_dpl(curr, dpdmux_attr.num_ifs + 1);
+	parse_endpoint_dpl(ctx, curr, dpdmux_attr.num_ifs + 1);
 	parse_dpdmux_options(fp, dpdmux_attr.options);
 	parse_dpdmux_method(fp, dpdmux_attr.method);
 	parse_dpdmux_manip(fp, dpdmux_attr.manip);
@@ -1739,11 +1795,13 @@ out:
 	if (dpdmux_opened) {
 		int error2;
 
-		error2 = dpdmux_close(&restool.mc_io, 0, dpdmux_handle);
+		error2 = dpdmux_close(&ctx->mc_io, ctx->cmd_flags,
+				      dpdmux_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -1798,18 +1856,19 @@ static void parse_dpsw_options(FILE *fp, uint64_t options)
 
 }
 
-static int parse_dpsw_v9(FILE *fp, struct obj_list *curr)
+static int parse_dpsw_v9(struct restool *ctx, FILE *fp, struct obj_list *curr)
 {
 	uint16_t dpsw_handle;
 	int error;
 	struct dpsw_attr_v9 dpsw_attr;
 	bool dpsw_opened = false;
 
-	error = dpsw_open(&restool.mc_io, 0, curr->id, &dpsw_handle);
+	error = dpsw_open(&ctx->mc_io, ctx->cmd_flags, curr->id, &dpsw_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpsw_opened = true;
@@ -1822,17 +1881,18 @@ static int parse_dpsw_v9(FILE *fp, struct obj_list *curr)
 	}
 
 	memset(&dpsw_attr, 0, sizeof(dpsw_attr));
-	error = dpsw_get_attributes_v9(&restool.mc_io, 0, dpsw_handle,
+	error = dpsw_get_attributes_v9(&ctx->mc_io, ctx->cmd_flags, dpsw_handle,
 				       &dpsw_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(curr->id == dpsw_attr.id);
 
-	parse_endpoint_dpl(curr, dpsw_attr.num_ifs);
+	parse_endpoint_dpl(ctx, curr, dpsw_attr.num_ifs);
 	parse_dpsw_options(fp, dpsw_attr.options);
 	fprintf(fp, "\t\t\tmax_vlans = <%#x>;\n",
 		(uint32_t)dpsw_attr.max_vlans);
@@ -1856,11 +1916,12 @@ out:
 	if (dpsw_opened) {
 		int error2;
 
-		error2 = dpsw_close(&restool.mc_io, 0, dpsw_handle);
+		error2 = dpsw_close(&ctx->mc_io, ctx->cmd_flags, dpsw_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -1869,10 +1930,10 @@ out:
 	return error;
 }
 
-static int write_objects(void)
+static int write_objects(struct restool *ctx)
 {
 	struct obj_list *curr_obj;
-	FILE *fp = stdout;
+	FILE *fp = dpl_fp;
 
 	fprintf(fp, "\n");
 	fprintf(fp,
@@ -1910,46 +1971,46 @@ static int write_objects(void)
 			parse_dpaiop(fp, curr_obj);
 
 		if (strcmp(curr_obj->type, "dpcon") == 0)
-			parse_dpcon(fp, curr_obj);
+			parse_dpcon(ctx, fp, curr_obj);
 
 		if (strcmp(curr_obj->type, "dpdcei") == 0)
-			parse_dpdcei(fp, curr_obj);
+			parse_dpdcei(ctx, fp, curr_obj);
 
 		if (strcmp(curr_obj->type, "dpdmai") == 0)
-			parse_dpdmai(fp, curr_obj);
+			parse_dpdmai(ctx, fp, curr_obj);
 
 		if (strcmp(curr_obj->type, "dpio") == 0)
-			parse_dpio(fp, curr_obj);
+			parse_dpio(ctx, fp, curr_obj);
 
 		if (strcmp(curr_obj->type, "dpseci") == 0)
-			parse_dpseci(fp, curr_obj);
+			parse_dpseci(ctx, fp, curr_obj);
 
 		/* following objects have possible connections */
 		if (strcmp(curr_obj->type, "dpci") == 0)
-			parse_dpci(fp, curr_obj);
+			parse_dpci(ctx, fp, curr_obj);
 
 		if (strcmp(curr_obj->type, "dpmac") == 0)
 			parse_dpmac(fp, curr_obj);
 			/* dpmac do not need to be parsed now */
 
 		if (strcmp(curr_obj->type, "dpni") == 0) {
-			if (restool.mc_fw_version.major == 9)
-				parse_dpni_v9(fp, curr_obj);
-			else if (restool.mc_fw_version.major == 10)
-				parse_dpni_v10(fp, curr_obj);
+			if (ctx->mc_fw_version.major == 9)
+				parse_dpni_v9(ctx, fp, curr_obj);
+			else if (ctx->mc_fw_version.major == 10)
+				parse_dpni_v10(ctx, fp, curr_obj);
 		}
 
 		/* following objects have possible connections and interface*/
 		if (strcmp(curr_obj->type, "dpdmux") == 0) {
-			if (restool.mc_fw_version.major == 9 ||
-			    restool.mc_fw_version.major == 10)
-				parse_dpdmux_v9(fp, curr_obj);
+			if (ctx->mc_fw_version.major == 9 ||
+			    ctx->mc_fw_version.major == 10)
+				parse_dpdmux_v9(ctx, fp, curr_obj);
 		}
 
 		if (strcmp(curr_obj->type, "dpsw") == 0) {
-			if (restool.mc_fw_version.major == 9 ||
-			    restool.mc_fw_version.major == 10)
-				parse_dpsw_v9(fp, curr_obj);
+			if (ctx->mc_fw_version.major == 9 ||
+			    ctx->mc_fw_version.major == 10)
+				parse_dpsw_v9(ctx, fp, curr_obj);
 		}
 
 		fprintf(fp, "\t\t};\n");
@@ -1964,7 +2025,7 @@ static int write_connections(void)
 {
 	struct conn_list *curr_conn;
 	int conn_num = 1;
-	FILE *fp = stdout;
+	FILE *fp = dpl_fp;
 
 	fprintf(fp, "\n");
 	fprintf(fp,
@@ -2048,52 +2109,73 @@ static void delete_all_list(void)
 		free(tmp_cont);
 	}
 	container_head = NULL;
+	container_count = 0;
 }
 
-int dpl_generate(void)
+int dpl_generate(struct restool *ctx)
 {
 	int error;
 	uint32_t dprc_id = 0;
+	char *json_dpl = NULL;
+	size_t json_dpl_size = 0;
 
-	if (restool.obj_name != NULL) {
-		error = parse_object_name(restool.obj_name, "dprc", &dprc_id);
+	if (ctx->obj_name != NULL) {
+		error = parse_object_name(ctx->obj_name, "dprc", &dprc_id);
 		if (error < 0)
 			return error;
 	}
 
-	FILE *fp = stdout;
+	/* the DPL goes into a single JSON string */
+	if (output_is_json()) {
+		dpl_fp = open_memstream(&json_dpl, &json_dpl_size);
+		if (dpl_fp == NULL)
+			return -ENOMEM;
+	} else {
+		dpl_fp = stdout;
+	}
+
+	FILE *fp = dpl_fp;
 
 	fprintf(fp, "/dts-v1/;\n");
 	fprintf(fp, "/ {\n");
-	fprintf(fp, "\tdpl-version = <%d>;\n", restool.mc_fw_version.major);
+	fprintf(fp, "\tdpl-version = <%d>;\n", ctx->mc_fw_version.major);
 
-	error = parse_layout(dprc_id);
+	error = parse_layout(ctx, dprc_id);
 	if (error) {
 		ERROR_PRINTF("parse_layout() failed, error=%d\n", error);
-		return error;
+		goto out;
 	}
 
-	error = write_containers();
+	error = write_containers(ctx);
 	if (error) {
 		ERROR_PRINTF("write_containers() failed, error=%d\n", error);
-		return error;
+		goto out;
 	}
 
-	error = write_objects();
+	error = write_objects(ctx);
 	if (error) {
 		ERROR_PRINTF("write_objects() failed, error=%d\n", error);
-		return error;
+		goto out;
 	}
 
 	error = write_connections();
 	if (error) {
 		ERROR_PRINTF("write_connections() failed, error=%d\n", error);
-		return error;
+		goto out;
 	}
 
 	fprintf(fp, "};\n");
 
 	delete_all_list();
 
-	return 0;
+out:
+	if (fp != stdout) {
+		fclose(fp);
+		if (error == 0)
+			output_field("dpl", "dpl", "%s", json_dpl);
+		free(json_dpl);
+	}
+
+	dpl_fp = NULL;
+	return error;
 }
@@ -34,4 +34,4 @@
  * dpl generate command options
  */
 
-int dpl_generate(void);
+int dpl_generate(struct restool *ctx);
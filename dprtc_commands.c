@@ -48,6 +48,7 @@
 enum dprtc_info_options {
 	INFO_OPT_HELP = 0,
 	INFO_OPT_VERBOSE,
+	INFO_OPT_FIELDS,
 };
 
 static struct option dprtc_info_options[] = {
@@ -65,6 +66,13 @@ static struct option dprtc_info_options[] = {
 		.val = 0,
 	},
 
+	[INFO_OPT_FIELDS] = {
+		.name = "fields",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
 	{ 0 },
 };
 
@@ -125,7 +133,7 @@ static const struct flib_ops dprtc_ops = {
 	.obj_get_irq_status = dprtc_get_irq_status,
 };
 
-static int cmd_dprtc_help(void)
+static int cmd_dprtc_help(struct restool *ctx)
 {
 	static const char help_msg[] =
 		"\n"
@@ -138,11 +146,12 @@ static int cmd_dprtc_help(void)
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
 
+	(void)ctx;
 	printf(help_msg);
 	return 0;
 }
 
-static int print_dprtc_attr_v9(uint32_t dprtc_id,
+static int print_dprtc_attr_v9(struct restool *ctx, uint32_t dprtc_id,
 			       struct dprc_obj_desc *target_obj_desc)
 {
 	uint16_t dprtc_handle;
@@ -150,11 +159,13 @@ static int print_dprtc_attr_v9(uint32_t dprtc_id,
 	struct dprtc_attr dprtc_attr;
 	bool dprtc_opened = false;
 
-	error = dprtc_open(&restool.mc_io, 0, dprtc_id, &dprtc_handle);
+	error = dprtc_open(&ctx->mc_io, ctx->cmd_flags, dprtc_id,
+			   &dprtc_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dprtc_opened = true;
@@ -167,33 +178,36 @@ static int print_dprtc_attr_v9(uint32_t dprtc_id,
 	}
 
 	memset(&dprtc_attr, 0, sizeof(dprtc_attr));
-	error = dprtc_get_attributes(&restool.mc_io, 0, dprtc_handle,
+	error = dprtc_get_attributes(&ctx->mc_io, ctx->cmd_flags, dprtc_handle,
 				     &dprtc_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(dprtc_id == (uint32_t)dprtc_attr.id);
 
-	printf("dprtc version: %u.%u\n", dprtc_attr.version.major,
-	       dprtc_attr.version.minor);
-	printf("dprtc id: %d\n", dprtc_attr.id);
-	printf("plugged state: %splugged\n",
+	output_field("version", "dprtc version",
+		     "%u.%u", dprtc_attr.version.major,
+		     dprtc_attr.version.minor);
+	output_int("id", "dprtc id", dprtc_attr.id);
+	output_field("plugged_state", "plugged state", "%splugged",
 		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	print_obj_label(target_obj_desc);
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 out:
 	if (dprtc_opened) {
 		int error2;
 
-		error2 = dprtc_close(&restool.mc_io, 0, dprtc_handle);
+		error2 = dprtc_close(&ctx->mc_io, ctx->cmd_flags, dprtc_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -202,67 +216,82 @@ out:
 	return error;
 }
 
-static int print_dprtc_attr_v10(uint32_t dprtc_id,
+static int print_dprtc_attr_v10(struct restool *ctx, uint32_t dprtc_id,
 				struct dprc_obj_desc *target_obj_desc)
 {
 	struct dprtc_attr_v10 dprtc_attr;
 	uint16_t obj_major, obj_minor;
 	bool dprtc_opened = false;
 	uint16_t dprtc_handle;
-	int error;
+	int error = 0;
 
-	error = dprtc_open_v10(&restool.mc_io, 0, dprtc_id, &dprtc_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dprtc_opened = true;
-	if (0 == dprtc_handle) {
-		DEBUG_PRINTF(
-			"dprtc_open() returned invalid handle (auth 0) for dprtc.%u\n",
-			dprtc_id);
-		error = -ENOENT;
-		goto out;
-	}
+	if (INFO_FIELD(ATTR)) {
+		error = dprtc_open_v10(&ctx->mc_io, ctx->cmd_flags, dprtc_id,
+				       &dprtc_handle);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		dprtc_opened = true;
+		if (0 == dprtc_handle) {
+			DEBUG_PRINTF(
+				"dprtc_open() returned invalid handle (auth 0) for dprtc.%u\n",
+				dprtc_id);
+			error = -ENOENT;
+			goto out;
+		}
 
-	memset(&dprtc_attr, 0, sizeof(dprtc_attr));
-	error = dprtc_get_attributes_v10(&restool.mc_io, 0, dprtc_handle,
-					 &dprtc_attr);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		memset(&dprtc_attr, 0, sizeof(dprtc_attr));
+		error = dprtc_get_attributes_v10(&ctx->mc_io, ctx->cmd_flags,
+						 dprtc_handle, &dprtc_attr);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		assert(dprtc_id == (uint32_t)dprtc_attr.id);
 	}
-	assert(dprtc_id == (uint32_t)dprtc_attr.id);
 
-	error = dprtc_get_api_version_v10(&restool.mc_io, 0,
-				      &obj_major, &obj_minor);
-	if (error) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+	if (INFO_FIELD(VERSION)) {
+		error = get_obj_api_version(ctx, "dprtc",
+					    dprtc_get_api_version_v10,
+					    &obj_major, &obj_minor);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		output_field("version", "dprtc version",
+			     "%u.%u", obj_major, obj_minor);
 	}
 
-	printf("dprtc version: %u.%u\n", obj_major, obj_minor);
-	printf("dprtc id: %d\n", dprtc_attr.id);
-	printf("plugged state: %splugged\n",
-		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	print_obj_label(target_obj_desc);
+	if (INFO_FIELD(ID))
+		output_int("id", "dprtc id", dprtc_id);
+	if (INFO_FIELD(STATE))
+		output_field("plugged_state", "plugged state", "%splugged",
+			     (target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ?
+			     "" : "un");
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 out:
 	if (dprtc_opened) {
 		int error2;
 
-		error2 = dprtc_close_v10(&restool.mc_io, 0, dprtc_handle);
+		error2 = dprtc_close_v10(&ctx->mc_io, ctx->cmd_flags,
+					 dprtc_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -271,51 +300,50 @@ out:
 	return error;
 }
 
-static int print_dprtc_info(uint32_t dprtc_id, int mc_fw_version)
+static int print_dprtc_info(struct restool *ctx, uint32_t dprtc_id,
+			    int mc_fw_version)
 {
 	int error;
 	struct dprc_obj_desc target_obj_desc;
-	uint32_t target_parent_dprc_id;
-	bool found = false;
-
-	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0, dprtc_id,
-				"dprtc", &target_obj_desc,
-				&target_parent_dprc_id, &found);
+
+	error = find_info_obj_desc(ctx, dprtc_id, "dprtc",
+				   ctx->cmd_option_mask &
+				   ONE_BIT_MASK(INFO_OPT_VERBOSE),
+				   &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (strcmp(target_obj_desc.type, "dprtc")) {
-		printf("dprtc.%d does not exist\n", dprtc_id);
-		return -EINVAL;
-	}
-
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = print_dprtc_attr_v9(dprtc_id, &target_obj_desc);
+		error = print_dprtc_attr_v9(ctx, dprtc_id, &target_obj_desc);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = print_dprtc_attr_v10(dprtc_id, &target_obj_desc);
+		error = print_dprtc_attr_v10(ctx, dprtc_id, &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dprtc_ops);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
+		error = print_obj_verbose(ctx, &target_obj_desc, &dprtc_ops);
 	}
 
 out:
 	return error;
 }
 
-static int info_dprtc(int mc_fw_version)
+static int info_dprtc(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
 		"Usage: restool dprtc info <dprtc-object> [--verbose]\n"
+		"                         [--fields=<field>[,<field>...]]\n"
 		"\n"
 		"OPTIONS:\n"
 		"--verbose\n"
 		"   Shows extended/verbose information about the object\n"
+		"--fields=<field>[,<field>...]\n"
+		"   Shows only the given fields and sends only the MC\n"
+		"   commands they need. <field> is one of: version, id,\n"
+		"   state, endpoint, link, mac, attr, stats, label.\n"
+		"   Requires MC firmware 10.x.\n"
 		"\n"
 		"EXAMPLE:\n"
 		"Display information about dprtc.5:\n"
@@ -325,159 +353,173 @@ static int info_dprtc(int mc_fw_version)
 	uint32_t obj_id;
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_FIELDS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_FIELDS);
+		error = parse_info_fields(ctx, 
+				ctx->cmd_option_args[INFO_OPT_FIELDS]);
+		if (error < 0)
+			goto out;
+	}
+
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dprtc", &obj_id);
+	error = parse_object_name(ctx->obj_name, "dprtc", &obj_id);
 	if (error < 0)
 		goto out;
 
-	error = print_dprtc_info(obj_id, mc_fw_version);
+	error = print_dprtc_info(ctx, obj_id, mc_fw_version);
 out:
 	return error;
 }
 
-static int cmd_dprtc_info_v9(void)
+static int cmd_dprtc_info_v9(struct restool *ctx)
 {
-	return info_dprtc(MC_FW_VERSION_9);
+	return info_dprtc(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dprtc_info_v10(void)
+static int cmd_dprtc_info_v10(struct restool *ctx)
 {
-	return info_dprtc(MC_FW_VERSION_10);
+	return info_dprtc(ctx, MC_FW_VERSION_10);
 }
 
-static int create_dprtc_v9(struct dprtc_cfg *dprtc_cfg)
+static int create_dprtc_v9(struct restool *ctx, struct dprtc_cfg *dprtc_cfg)
 {
 	struct dprtc_attr dprtc_attr;
 	uint16_t dprtc_handle;
 	int error;
 
-	error = dprtc_create(&restool.mc_io, 0, dprtc_cfg, &dprtc_handle);
+	error = dprtc_create(&ctx->mc_io, ctx->cmd_flags, dprtc_cfg,
+			     &dprtc_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	memset(&dprtc_attr, 0, sizeof(struct dprtc_attr));
-	error = dprtc_get_attributes(&restool.mc_io, 0, dprtc_handle,
+	error = dprtc_get_attributes(&ctx->mc_io, ctx->cmd_flags, dprtc_handle,
 				     &dprtc_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
-	print_new_obj("dprtc", dprtc_attr.id, NULL);
+	print_new_obj(ctx, "dprtc", dprtc_attr.id, NULL);
 
-	error = dprtc_close(&restool.mc_io, 0, dprtc_handle);
+	error = dprtc_close(&ctx->mc_io, ctx->cmd_flags, dprtc_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	return 0;
 }
 
-static int create_dprtc_v10(struct dprtc_cfg *dprtc_cfg)
+static int create_dprtc_v10(struct restool *ctx, struct dprtc_cfg *dprtc_cfg)
 {
 	uint32_t dprtc_id, dprc_id;
 	uint16_t dprc_handle;
 	bool dprc_opened;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
+	dprc_handle = ctx->root_dprc_handle;
 	dprc_opened = false;
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
 		error = parse_object_name(
-				restool.cmd_option_args[CREATE_OPT_PARENT_DPRC],
+				ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC],
 				"dprc", &dprc_id);
 		if (error)
 			return error;
 
-		if (restool.root_dprc_id != dprc_id) {
-			error = open_dprc(dprc_id, &dprc_handle);
+		if (ctx->root_dprc_id != dprc_id) {
+			error = open_dprc(ctx, dprc_id, &dprc_handle);
 			if (error)
 				return error;
 			dprc_opened = true;
 		}
 	}
 
-	error = dprtc_create_v10(&restool.mc_io, dprc_handle,
-				 0, dprtc_cfg, &dprtc_id);
+	error = dprtc_create_v10(&ctx->mc_io, dprc_handle,
+				 ctx->cmd_flags, dprtc_cfg, &dprtc_id);
 	if (error) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	if (dprc_opened) {
-		(void)dprc_close(&restool.mc_io, 0, dprc_handle);
-		print_new_obj("dprtc", dprtc_id,
-			      restool.cmd_option_args[CREATE_OPT_PARENT_DPRC]);
+		(void)dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
+		print_new_obj(ctx, "dprtc", dprtc_id,
+			      ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC]);
 	} else {
-		print_new_obj("dprtc", dprtc_id, NULL);
+		print_new_obj(ctx, "dprtc", dprtc_id, NULL);
 	}
 
 	return 0;
 }
 
-static int create_dprtc(int mc_fw_version, const char *usage_msg)
+static int create_dprtc(struct restool *ctx, int mc_fw_version,
+			const char *usage_msg)
 {
 	int error;
 	struct dprtc_cfg dprtc_cfg;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name != NULL) {
+	if (ctx->obj_name != NULL) {
 		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
-			     restool.obj_name);
+			     ctx->obj_name);
 		puts(usage_msg);
 		return -EINVAL;
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = create_dprtc_v9(&dprtc_cfg);
+		error = create_dprtc_v9(ctx, &dprtc_cfg);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = create_dprtc_v10(&dprtc_cfg);
+		error = create_dprtc_v10(ctx, &dprtc_cfg);
 	else
 		return -EINVAL;
 
 	return error;
 }
 
-static int cmd_dprtc_create_v9(void)
+static int cmd_dprtc_create_v9(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
 		"Usage: restool dprtc create\n"
 		"\n";
 
-	return create_dprtc(MC_FW_VERSION_9, usage_msg);
+	return create_dprtc(ctx, MC_FW_VERSION_9, usage_msg);
 }
 
-static int cmd_dprtc_create_v10(void)
+static int cmd_dprtc_create_v10(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -490,20 +532,22 @@ static int cmd_dprtc_create_v10(void)
 		"   If it is not specified, the new object will be created under the default dprc.\n"
 		"\n";
 
-	return create_dprtc(MC_FW_VERSION_10, usage_msg);
+	return create_dprtc(ctx, MC_FW_VERSION_10, usage_msg);
 }
 
-static int destroy_dprtc_v9(uint32_t dprtc_id)
+static int destroy_dprtc_v9(struct restool *ctx, uint32_t dprtc_id)
 {
 	bool dprtc_opened = false;
 	uint16_t dprtc_handle;
 	int error, error2;
 
-	error = dprtc_open(&restool.mc_io, 0, dprtc_id, &dprtc_handle);
+	error = dprtc_open(&ctx->mc_io, ctx->cmd_flags, dprtc_id,
+			   &dprtc_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out_v9;
 	}
 	dprtc_opened = true;
@@ -515,23 +559,25 @@ static int destroy_dprtc_v9(uint32_t dprtc_id)
 		goto out_v9;
 	}
 
-	error = dprtc_destroy(&restool.mc_io, 0, dprtc_handle);
+	error = dprtc_destroy(&ctx->mc_io, ctx->cmd_flags, dprtc_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out_v9;
 	}
 	dprtc_opened = false;
-	printf("dprtc.%u is destroyed\n", dprtc_id);
+	print_destroyed_obj("dprtc", dprtc_id);
 
 out_v9:
 	if (dprtc_opened) {
-		error2 = dprtc_close(&restool.mc_io, 0, dprtc_handle);
+		error2 = dprtc_close(&ctx->mc_io, ctx->cmd_flags, dprtc_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -540,42 +586,43 @@ out_v9:
 	return error;
 }
 
-static int destroy_dprtc_v10(uint32_t dprtc_id)
+static int destroy_dprtc_v10(struct restool *ctx, uint32_t dprtc_id)
 {
 	uint16_t dprc_handle;
 	uint32_t dprc_id;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
-	dprc_id = restool.root_dprc_id;
-	error = get_parent_dprc_id(dprtc_id, "dprtc", &dprc_id);
+	dprc_handle = ctx->root_dprc_handle;
+	dprc_id = ctx->root_dprc_id;
+	error = get_parent_dprc_id(ctx, dprtc_id, "dprtc", &dprc_id);
 	if (error)
 		return error;
 
-	if (dprc_id != restool.root_dprc_id) {
-		error = open_dprc(dprc_id, &dprc_handle);
+	if (dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, dprc_id, &dprc_handle);
 		if (error)
 			return error;
 	}
 
-	error = dprtc_destroy_v10(&restool.mc_io, dprc_handle,
-				 0, dprtc_id);
+	error = dprtc_destroy_v10(&ctx->mc_io, dprc_handle,
+				 ctx->cmd_flags, dprtc_id);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
-	printf("dprtc.%u is destroyed\n", dprtc_id);
+	print_destroyed_obj("dprtc", dprtc_id);
 
 out:
-	if (dprc_id != restool.root_dprc_id)
-		error = dprc_close(&restool.mc_io, 0, dprc_handle);
+	if (dprc_id != ctx->root_dprc_id)
+		error = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 
 	return error;
 }
 
-static int destroy_dprtc(int mc_fw_version)
+static int destroy_dprtc(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -586,37 +633,37 @@ static int destroy_dprtc(int mc_fw_version)
 	int error;
 	uint32_t dprtc_id;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	if (in_use(restool.obj_name, "destroyed")) {
+	if (in_use(ctx->obj_name, "destroyed")) {
 		error = -EBUSY;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dprtc", &dprtc_id);
+	error = parse_object_name(ctx->obj_name, "dprtc", &dprtc_id);
 	if (error < 0)
 		goto out;
 
-	if (!find_obj("dprtc", dprtc_id)) {
+	if (!find_obj(ctx, "dprtc", dprtc_id)) {
 		error = -EINVAL;
 		goto out;
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = destroy_dprtc_v9(dprtc_id);
+		error = destroy_dprtc_v9(ctx, dprtc_id);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = destroy_dprtc_v10(dprtc_id);
+		error = destroy_dprtc_v10(ctx, dprtc_id);
 	else
 		return -EINVAL;
 
@@ -624,14 +671,14 @@ out:
 	return error;
 }
 
-static int cmd_dprtc_destroy_v9(void)
+static int cmd_dprtc_destroy_v9(struct restool *ctx)
 {
-	return destroy_dprtc(MC_FW_VERSION_9);
+	return destroy_dprtc(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dprtc_destroy_v10(void)
+static int cmd_dprtc_destroy_v10(struct restool *ctx)
 {
-	return destroy_dprtc(MC_FW_VERSION_10);
+	return destroy_dprtc(ctx, MC_FW_VERSION_10);
 }
 
 struct object_command dprtc_commands_v9[] = {
@@ -649,7 +696,8 @@ struct object_command dprtc_commands_v9[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dprtc_destroy_options,
-	  .cmd_func = cmd_dprtc_destroy_v9 },
+	  .cmd_func = cmd_dprtc_destroy_v9,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -669,7 +717,8 @@ struct object_command dprtc_commands_v10[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dprtc_destroy_options,
-	  .cmd_func = cmd_dprtc_destroy_v10 },
+	  .cmd_func = cmd_dprtc_destroy_v10,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -49,6 +49,7 @@
 enum dpseci_info_options {
 	INFO_OPT_HELP = 0,
 	INFO_OPT_VERBOSE,
+	INFO_OPT_FIELDS,
 };
 
 static struct option dpseci_info_options[] = {
@@ -66,6 +67,13 @@ static struct option dpseci_info_options[] = {
 		.val = 0,
 	},
 
+	[INFO_OPT_FIELDS] = {
+		.name = "fields",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
 	{ 0 },
 };
 
@@ -157,7 +165,7 @@ static struct option_entry options_map_v10_1[] = {
 };
 static unsigned int options_num_v10_1 = ARRAY_SIZE(options_map_v10_1);
 
-static int cmd_dpseci_help(void)
+static int cmd_dpseci_help(struct restool *ctx)
 {
 	static const char help_msg[] =
 		"\n"
@@ -170,11 +178,12 @@ static int cmd_dpseci_help(void)
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
 
+	(void)ctx;
 	printf(help_msg);
 	return 0;
 }
 
-static int print_dpseci_attr_v9(uint32_t dpseci_id,
+static int print_dpseci_attr_v9(struct restool *ctx, uint32_t dpseci_id,
 			struct dprc_obj_desc *target_obj_desc)
 {
 	uint16_t dpseci_handle;
@@ -184,11 +193,13 @@ static int print_dpseci_attr_v9(uint32_t dpseci_id,
 	struct dpseci_tx_queue_attr tx_attr;
 	uint8_t *priorities;
 
-	error = dpseci_open(&restool.mc_io, 0, dpseci_id, &dpseci_handle);
+	error = dpseci_open(&ctx->mc_io, ctx->cmd_flags, dpseci_id,
+			    &dpseci_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpseci_opened = true;
@@ -201,23 +212,28 @@ static int print_dpseci_attr_v9(uint32_t dpseci_id,
 	}
 
 	memset(&dpseci_attr, 0, sizeof(dpseci_attr));
-	error = dpseci_get_attributes(&restool.mc_io, 0, dpseci_handle,
+	error = dpseci_get_attributes(&ctx->mc_io, ctx->cmd_flags,
+				      dpseci_handle,
 					&dpseci_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(dpseci_id == (uint32_t)dpseci_attr.id);
 
-	printf("dpseci version: %u.%u\n", dpseci_attr.version.major,
-	       dpseci_attr.version.minor);
-	printf("dpseci id: %d\n", dpseci_attr.id);
-	printf("plugged state: %splugged\n",
+	output_field("version", "dpseci version",
+		     "%u.%u", dpseci_attr.version.major,
+		     dpseci_attr.version.minor);
+	output_int("id", "dpseci id", dpseci_attr.id);
+	output_field("plugged_state", "plugged state", "%splugged",
 		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	printf("number of transmit queues: %u\n", dpseci_attr.num_tx_queues);
-	printf("number of receive queues: %u\n", dpseci_attr.num_rx_queues);
+	output_uint("num_tx_queues", "number of transmit queues",
+		    dpseci_attr.num_tx_queues);
+	output_uint("num_rx_queues", "number of receive queues",
+		    dpseci_attr.num_rx_queues);
 
 	priorities = malloc(dpseci_attr.num_tx_queues * sizeof(*priorities));
 	if (priorities == NULL) {
@@ -227,28 +243,38 @@ static int print_dpseci_attr_v9(uint32_t dpseci_id,
 	}
 
 	for (int i = 0; i < dpseci_attr.num_tx_queues; i++) {
-		error = dpseci_get_tx_queue(&restool.mc_io, 0, dpseci_handle,
+		error = dpseci_get_tx_queue(&ctx->mc_io, ctx->cmd_flags,
+					    dpseci_handle,
 					    i, &tx_attr);
 
 		if (error < 0) {
-			mc_status = flib_error_to_mc_status(error);
+			ctx->mc_status = flib_error_to_mc_status(error);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			free(priorities);
 			goto out;
 		}
 
 		priorities[i] = tx_attr.priority;
 	}
-	printf("tx priorities: ");
-	for (int i = 0; i < dpseci_attr.num_tx_queues-1; i++)
-		printf("%d,", priorities[i]);
+	if (output_is_json()) {
+		output_begin_array("tx_priorities");
+		for (int i = 0; i < dpseci_attr.num_tx_queues; i++)
+			output_item_int(priorities[i]);
+		output_end_array();
+	} else {
+		output_printf("tx priorities: ");
+		for (int i = 0; i < dpseci_attr.num_tx_queues-1; i++)
+			output_printf("%d,", priorities[i]);
 
-	printf("%d\n", priorities[dpseci_attr.num_tx_queues-1]);
+		output_printf("%d\n",
+			      priorities[dpseci_attr.num_tx_queues-1]);
+	}
 
 	free(priorities);
 
-	print_obj_label(target_obj_desc);
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -256,11 +282,13 @@ out:
 	if (dpseci_opened) {
 		int error2;
 
-		error2 = dpseci_close(&restool.mc_io, 0, dpseci_handle);
+		error2 = dpseci_close(&ctx->mc_io, ctx->cmd_flags,
+				      dpseci_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -269,7 +297,7 @@ out:
 	return error;
 }
 
-static int print_dpseci_attr_v10(uint32_t dpseci_id,
+static int print_dpseci_attr_v10(struct restool *ctx, uint32_t dpseci_id,
 				 struct dprc_obj_desc *target_obj_desc)
 {
 	struct dpseci_tx_queue_attr_v10 tx_attr;
@@ -278,81 +306,109 @@ static int print_dpseci_attr_v10(uint32_t dpseci_id,
 	bool dpseci_opened = false;
 	uint16_t dpseci_handle;
 	uint8_t *priorities;
-	int error;
-
-	error = dpseci_open_v10(&restool.mc_io, 0, dpseci_id, &dpseci_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpseci_opened = true;
-	if (0 == dpseci_handle) {
-		DEBUG_PRINTF(
-			"dpseci_open() returned invalid handle (auth 0) for dpseci.%u\n",
-			dpseci_id);
-		error = -ENOENT;
-		goto out;
-	}
-
-	memset(&dpseci_attr, 0, sizeof(dpseci_attr));
-	error = dpseci_get_attributes_v10(&restool.mc_io, 0, dpseci_handle,
-					  &dpseci_attr);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	assert(dpseci_id == (uint32_t)dpseci_attr.id);
+	int error = 0;
 
-	error = dpseci_get_api_version_v10(&restool.mc_io, 0,
-				       &obj_major, &obj_minor);
-	if (error) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-
-	printf("dpseci version: %u.%u\n", obj_major, obj_minor);
-	printf("dpseci id: %d\n", dpseci_attr.id);
-	printf("plugged state: %splugged\n",
-		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	printf("number of transmit queues: %u\n", dpseci_attr.num_tx_queues);
-	printf("number of receive queues: %u\n", dpseci_attr.num_rx_queues);
+	if (INFO_FIELD(ATTR)) {
+		error = dpseci_open_v10(&ctx->mc_io, ctx->cmd_flags, dpseci_id,
+					&dpseci_handle);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		dpseci_opened = true;
+		if (0 == dpseci_handle) {
+			DEBUG_PRINTF(
+				"dpseci_open() returned invalid handle (auth 0) for dpseci.%u\n",
+				dpseci_id);
+			error = -ENOENT;
+			goto out;
+		}
 
-	priorities = malloc(dpseci_attr.num_tx_queues * sizeof(*priorities));
-	if (priorities == NULL) {
-		ERROR_PRINTF("malloc failed\n");
-		error = -errno;
-		goto out;
+		memset(&dpseci_attr, 0, sizeof(dpseci_attr));
+		error = dpseci_get_attributes_v10(&ctx->mc_io, ctx->cmd_flags,
+						  dpseci_handle, &dpseci_attr);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		assert(dpseci_id == (uint32_t)dpseci_attr.id);
 	}
 
-	for (int i = 0; i < dpseci_attr.num_tx_queues; i++) {
-		error = dpseci_get_tx_queue_v10(&restool.mc_io, 0, dpseci_handle,
-						i, &tx_attr);
-
-		if (error < 0) {
-			mc_status = flib_error_to_mc_status(error);
+	if (INFO_FIELD(VERSION)) {
+		error = get_obj_api_version(ctx, "dpseci",
+					    dpseci_get_api_version_v10,
+					    &obj_major, &obj_minor);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
-			free(priorities);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		output_field("version", "dpseci version",
+			     "%u.%u", obj_major, obj_minor);
+	}
+
+	if (INFO_FIELD(ID))
+		output_int("id", "dpseci id", dpseci_id);
+	if (INFO_FIELD(STATE))
+		output_field("plugged_state", "plugged state", "%splugged",
+			     (target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ?
+			     "" : "un");
+	if (INFO_FIELD(ATTR)) {
+		output_uint("num_tx_queues", "number of transmit queues",
+			    dpseci_attr.num_tx_queues);
+		output_uint("num_rx_queues", "number of receive queues",
+			    dpseci_attr.num_rx_queues);
+
+		priorities = malloc(dpseci_attr.num_tx_queues *
+				    sizeof(*priorities));
+		if (priorities == NULL) {
+			ERROR_PRINTF("malloc failed\n");
+			error = -errno;
 			goto out;
 		}
 
-		priorities[i] = tx_attr.priority;
-	}
-	printf("tx priorities: ");
-	for (int i = 0; i < dpseci_attr.num_tx_queues-1; i++)
-		printf("%d,", priorities[i]);
+		for (int i = 0; i < dpseci_attr.num_tx_queues; i++) {
+			error = dpseci_get_tx_queue_v10(&ctx->mc_io,
+							ctx->cmd_flags,
+							dpseci_handle, i,
+							&tx_attr);
 
-	printf("%d\n", priorities[dpseci_attr.num_tx_queues-1]);
+			if (error < 0) {
+				ctx->mc_status = flib_error_to_mc_status(error);
+				ERROR_PRINTF("MC error: %s (status %#x)\n",
+					     mc_status_to_string(ctx->mc_status),
+					     ctx->mc_status);
+				free(priorities);
+				goto out;
+			}
 
-	free(priorities);
+			priorities[i] = tx_attr.priority;
+		}
+		if (output_is_json()) {
+			output_begin_array("tx_priorities");
+			for (int i = 0; i < dpseci_attr.num_tx_queues; i++)
+				output_item_int(priorities[i]);
+			output_end_array();
+		} else {
+			output_printf("tx priorities: ");
+			for (int i = 0; i < dpseci_attr.num_tx_queues-1; i++)
+				output_printf("%d,", priorities[i]);
+
+			output_printf("%d\n",
+				      priorities[dpseci_attr.num_tx_queues-1]);
+		}
 
-	print_obj_label(target_obj_desc);
+		free(priorities);
+	}
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -360,11 +416,13 @@ out:
 	if (dpseci_opened) {
 		int error2;
 
-		error2 = dpseci_close_v10(&restool.mc_io, 0, dpseci_handle);
+		error2 = dpseci_close_v10(&ctx->mc_io, ctx->cmd_flags,
+					  dpseci_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -373,51 +431,50 @@ out:
 	return error;
 }
 
-static int print_dpseci_info(uint32_t dpseci_id, int mc_fw_version)
+static int print_dpseci_info(struct restool *ctx, uint32_t dpseci_id,
+			     int mc_fw_version)
 {
 	int error;
 	struct dprc_obj_desc target_obj_desc;
-	uint32_t target_parent_dprc_id;
-	bool found = false;
-
-	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0, dpseci_id,
-				"dpseci", &target_obj_desc,
-				&target_parent_dprc_id, &found);
+
+	error = find_info_obj_desc(ctx, dpseci_id, "dpseci",
+				   ctx->cmd_option_mask &
+				   ONE_BIT_MASK(INFO_OPT_VERBOSE),
+				   &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (strcmp(target_obj_desc.type, "dpseci")) {
-		printf("dpseci.%d does not exist\n", dpseci_id);
-		return -EINVAL;
-	}
-
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = print_dpseci_attr_v9(dpseci_id, &target_obj_desc);
+		error = print_dpseci_attr_v9(ctx, dpseci_id, &target_obj_desc);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = print_dpseci_attr_v10(dpseci_id, &target_obj_desc);
+		error = print_dpseci_attr_v10(ctx, dpseci_id, &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpseci_ops);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
+		error = print_obj_verbose(ctx, &target_obj_desc, &dpseci_ops);
 	}
 
 out:
 	return error;
 }
 
-static int info_dpseci(int mc_fw_version)
+static int info_dpseci(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
 		"Usage: restool dpseci info <dpseci-object> [--verbose]\n"
+		"                         [--fields=<field>[,<field>...]]\n"
 		"\n"
 		"OPTIONS:\n"
 		"--verbose\n"
 		"   Shows extended/verbose information about the object\n"
+		"--fields=<field>[,<field>...]\n"
+		"   Shows only the given fields and sends only the MC\n"
+		"   commands they need. <field> is one of: version, id,\n"
+		"   state, endpoint, link, mac, attr, stats, label.\n"
+		"   Requires MC firmware 10.x.\n"
 		"\n"
 		"EXAMPLE:\n"
 		"Display information about dpseci.5:\n"
@@ -427,37 +484,45 @@ static int info_dpseci(int mc_fw_version)
 	uint32_t obj_id;
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_FIELDS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_FIELDS);
+		error = parse_info_fields(ctx, 
+				ctx->cmd_option_args[INFO_OPT_FIELDS]);
+		if (error < 0)
+			goto out;
+	}
+
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpseci", &obj_id);
+	error = parse_object_name(ctx->obj_name, "dpseci", &obj_id);
 	if (error < 0)
 		goto out;
 
-	error = print_dpseci_info(obj_id, mc_fw_version);
+	error = print_dpseci_info(ctx, obj_id, mc_fw_version);
 out:
 	return error;
 }
 
-static int cmd_dpseci_info_v9(void)
+static int cmd_dpseci_info_v9(struct restool *ctx)
 {
-	return info_dpseci(MC_FW_VERSION_9);
+	return info_dpseci(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpseci_info_v10(void)
+static int cmd_dpseci_info_v10(struct restool *ctx)
 {
-	return info_dpseci(MC_FW_VERSION_10);
+	return info_dpseci(ctx, MC_FW_VERSION_10);
 }
 
 static int parse_dpseci_priorities(char *priorities_str, uint8_t *priorities,
@@ -497,7 +562,7 @@ static int parse_dpseci_priorities(char *priorities_str, uint8_t *priorities,
 	return 0;
 }
 
-static int create_dpseci_v9(const char *usage_msg)
+static int create_dpseci_v9(struct restool *ctx, const char *usage_msg)
 {
 	struct dpseci_cfg dpseci_cfg = { 0 };
 	struct dpseci_attr dpseci_attr;
@@ -505,26 +570,26 @@ static int create_dpseci_v9(const char *usage_msg)
 	int error;
 	long val;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name != NULL) {
+	if (ctx->obj_name != NULL) {
 		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
-			     restool.obj_name);
+			     ctx->obj_name);
 		puts(usage_msg);
 		return -EINVAL;
 	}
 
-	if ((restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_QUEUES)) &&
-	    (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PRIORITIES))) {
-		restool.cmd_option_mask &=
+	if ((ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_QUEUES)) &&
+	    (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PRIORITIES))) {
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_NUM_QUEUES);
-		restool.cmd_option_mask &=
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_PRIORITIES);
-		error = get_option_value(CREATE_OPT_NUM_QUEUES, &val,
+		error = get_option_value(ctx, CREATE_OPT_NUM_QUEUES, &val,
 					 "Invalid number of queues range",
 					 1, DPSECI_PRIO_NUM);
 		if (error)
@@ -533,7 +598,7 @@ static int create_dpseci_v9(const char *usage_msg)
 		dpseci_cfg.num_rx_queues = val;
 
 		error = parse_dpseci_priorities(
-			restool.cmd_option_args[CREATE_OPT_PRIORITIES],
+			ctx->cmd_option_args[CREATE_OPT_PRIORITIES],
 			dpseci_cfg.priorities, val);
 		if (error < 0) {
 			DEBUG_PRINTF(
@@ -547,36 +612,41 @@ static int create_dpseci_v9(const char *usage_msg)
 		return -EINVAL;
 	}
 
-	error = dpseci_create(&restool.mc_io, 0, &dpseci_cfg, &dpseci_handle);
+	error = dpseci_create(&ctx->mc_io, ctx->cmd_flags, &dpseci_cfg,
+			      &dpseci_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 	memset(&dpseci_attr, 0, sizeof(struct dpseci_attr));
-	error = dpseci_get_attributes(&restool.mc_io, 0, dpseci_handle,
+	error = dpseci_get_attributes(&ctx->mc_io, ctx->cmd_flags,
+				      dpseci_handle,
 					&dpseci_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
-	print_new_obj("dpseci", dpseci_attr.id, NULL);
+	print_new_obj(ctx, "dpseci", dpseci_attr.id, NULL);
 
-	error = dpseci_close(&restool.mc_io, 0, dpseci_handle);
+	error = dpseci_close(&ctx->mc_io, ctx->cmd_flags, dpseci_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	return 0;
 }
 
-static int create_dpseci_v10(const char *usage_msg)
+static int create_dpseci_v10(struct restool *ctx, const char *usage_msg)
 {
 	struct dpseci_cfg_v10 dpseci_cfg = { 0 };
 	uint32_t dpseci_id, dprc_id;
@@ -585,24 +655,24 @@ static int create_dpseci_v10(const char *usage_msg)
 	int error;
 	long val;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name != NULL) {
+	if (ctx->obj_name != NULL) {
 		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
-			     restool.obj_name);
+			     ctx->obj_name);
 		puts(usage_msg);
 		return -EINVAL;
 	}
 
-	if (restool.mc_fw_version.minor >= 1) {
-		if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_OPTIONS)) {
-			restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_OPTIONS);
+	if (ctx->mc_fw_version.minor >= 1) {
+		if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_OPTIONS)) {
+			ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_OPTIONS);
 			error = parse_generic_create_options(
-					restool.cmd_option_args[CREATE_OPT_OPTIONS],
+					ctx->cmd_option_args[CREATE_OPT_OPTIONS],
 					(uint64_t *)&dpseci_cfg.options,
 					options_map_v10_1,
 					options_num_v10_1);
@@ -615,13 +685,13 @@ static int create_dpseci_v10(const char *usage_msg)
 		}
 	}
 
-	if ((restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_QUEUES)) &&
-	    (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PRIORITIES))) {
-		restool.cmd_option_mask &=
+	if ((ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_QUEUES)) &&
+	    (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PRIORITIES))) {
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_NUM_QUEUES);
-		restool.cmd_option_mask &=
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_PRIORITIES);
-		error = get_option_value(CREATE_OPT_NUM_QUEUES, &val,
+		error = get_option_value(ctx, CREATE_OPT_NUM_QUEUES, &val,
 					 "Invalid number of queues range",
 					 1, DPSECI_PRIO_NUM);
 		if (error)
@@ -630,7 +700,7 @@ static int create_dpseci_v10(const char *usage_msg)
 		dpseci_cfg.num_rx_queues = val;
 
 		error = parse_dpseci_priorities(
-			restool.cmd_option_args[CREATE_OPT_PRIORITIES],
+			ctx->cmd_option_args[CREATE_OPT_PRIORITIES],
 			dpseci_cfg.priorities, val);
 		if (error < 0) {
 			DEBUG_PRINTF(
@@ -644,44 +714,47 @@ static int create_dpseci_v10(const char *usage_msg)
 		return -EINVAL;
 	}
 
-	dprc_handle = restool.root_dprc_handle;
+	dprc_handle = ctx->root_dprc_handle;
 	dprc_opened = false;
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
 		error = parse_object_name(
-				restool.cmd_option_args[CREATE_OPT_PARENT_DPRC],
+				ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC],
 				"dprc", &dprc_id);
 		if (error)
 			return error;
 
-		if (restool.root_dprc_id != dprc_id) {
-			error = open_dprc(dprc_id, &dprc_handle);
+		if (ctx->root_dprc_id != dprc_id) {
+			error = open_dprc(ctx, dprc_id, &dprc_handle);
 			if (error)
 				return error;
 			dprc_opened = true;
 		}
 	}
 
-	error = dpseci_create_v10(&restool.mc_io, dprc_handle, 0, &dpseci_cfg, &dpseci_id);
+	error = dpseci_create_v10(&ctx->mc_io, dprc_handle, ctx->cmd_flags,
+				  &dpseci_cfg,
+				  &dpseci_id);
 	if (error) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	if (dprc_opened) {
-		(void)dprc_close(&restool.mc_io, 0, dprc_handle);
-		print_new_obj("dpseci", dpseci_id,
-			      restool.cmd_option_args[CREATE_OPT_PARENT_DPRC]);
+		(void)dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
+		print_new_obj(ctx, "dpseci", dpseci_id,
+			      ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC]);
 	} else {
-		print_new_obj("dpseci", dpseci_id, NULL);
+		print_new_obj(ctx, "dpseci", dpseci_id, NULL);
 	}
 
 	return 0;
 }
 
-static int cmd_dpseci_create_v9(void)
+static int cmd_dpseci_create_v9(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -698,10 +771,10 @@ static int cmd_dpseci_create_v9(void)
 		"   $ restool dpseci create --num-queues=2 --priorities=2,4\n"
 		"\n";
 
-	return create_dpseci_v9(usage_msg);
+	return create_dpseci_v9(ctx, usage_msg);
 }
 
-static int cmd_dpseci_create_v10(void)
+static int cmd_dpseci_create_v10(struct restool *ctx)
 {
 	static const char usage_msg_0[] =
 		"\n"
@@ -750,25 +823,27 @@ static int cmd_dpseci_create_v10(void)
 		"   $ restool dpseci create --num-queues=2 --priorities=2,4\n"
 		"\n";
 
-	if (restool.mc_fw_version.minor == 0)
-		return create_dpseci_v10(usage_msg_0);
+	if (ctx->mc_fw_version.minor == 0)
+		return create_dpseci_v10(ctx, usage_msg_0);
 	else
-		return create_dpseci_v10(usage_msg_1);
+		return create_dpseci_v10(ctx, usage_msg_1);
 
 	return -EINVAL;
 }
 
-static int destroy_dpseci_v9(uint32_t dpseci_id)
+static int destroy_dpseci_v9(struct restool *ctx, uint32_t dpseci_id)
 {
 	bool dpseci_opened = false;
 	uint16_t dpseci_handle;
 	int error, error2;
 
-	error = dpseci_open(&restool.mc_io, 0, dpseci_id, &dpseci_handle);
+	error = dpseci_open(&ctx->mc_io, ctx->cmd_flags, dpseci_id,
+			    &dpseci_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpseci_opened = true;
@@ -780,23 +855,26 @@ static int destroy_dpseci_v9(uint32_t dpseci_id)
 		goto out;
 	}
 
-	error = dpseci_destroy(&restool.mc_io, 0, dpseci_handle);
+	error = dpseci_destroy(&ctx->mc_io, ctx->cmd_flags, dpseci_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpseci_opened = false;
-	printf("dpseci.%u is destroyed\n", dpseci_id);
+	print_destroyed_obj("dpseci", dpseci_id);
 
 out:
 	if (dpseci_opened) {
-		error2 = dpseci_close(&restool.mc_io, 0, dpseci_handle);
+		error2 = dpseci_close(&ctx->mc_io, ctx->cmd_flags,
+				      dpseci_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -804,42 +882,43 @@ out:
 	return error;
 }
 
-static int destroy_dpseci_v10(uint32_t dpseci_id)
+static int destroy_dpseci_v10(struct restool *ctx, uint32_t dpseci_id)
 {
 	uint16_t dprc_handle;
 	uint32_t dprc_id;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
-	dprc_id = restool.root_dprc_id;
-	error = get_parent_dprc_id(dpseci_id, "dpseci", &dprc_id);
+	dprc_handle = ctx->root_dprc_handle;
+	dprc_id = ctx->root_dprc_id;
+	error = get_parent_dprc_id(ctx, dpseci_id, "dpseci", &dprc_id);
 	if (error)
 		return error;
 
-	if (dprc_id != restool.root_dprc_id) {
-		error = open_dprc(dprc_id, &dprc_handle);
+	if (dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, dprc_id, &dprc_handle);
 		if (error)
 			return error;
 	}
 
-	error = dpseci_destroy_v10(&restool.mc_io, dprc_handle,
-				 0, dpseci_id);
+	error = dpseci_destroy_v10(&ctx->mc_io, dprc_handle,
+				 ctx->cmd_flags, dpseci_id);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
-	printf("dpseci.%u is destroyed\n", dpseci_id);
+	print_destroyed_obj("dpseci", dpseci_id);
 
 out:
-	if (dprc_id != restool.root_dprc_id)
-		error = dprc_close(&restool.mc_io, 0, dprc_handle);
+	if (dprc_id != ctx->root_dprc_id)
+		error = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 
 	return error;
 }
 
-static int destroy_dpseci(int mc_fw_version)
+static int destroy_dpseci(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -850,37 +929,37 @@ static int destroy_dpseci(int mc_fw_version)
 	int error;
 	uint32_t dpseci_id;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	if (in_use(restool.obj_name, "destroyed")) {
+	if (in_use(ctx->obj_name, "destroyed")) {
 		error = -EBUSY;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpseci", &dpseci_id);
+	error = parse_object_name(ctx->obj_name, "dpseci", &dpseci_id);
 	if (error < 0)
 		goto out;
 
-	if (!find_obj("dpseci", dpseci_id)) {
+	if (!find_obj(ctx, "dpseci", dpseci_id)) {
 		error = -EINVAL;
 		goto out;
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = destroy_dpseci_v9(dpseci_id);
+		error = destroy_dpseci_v9(ctx, dpseci_id);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = destroy_dpseci_v10(dpseci_id);
+		error = destroy_dpseci_v10(ctx, dpseci_id);
 	else
 		return -EINVAL;
 
@@ -888,14 +967,14 @@ out:
 	return error;
 }
 
-static int cmd_dpseci_destroy_v9(void)
+static int cmd_dpseci_destroy_v9(struct restool *ctx)
 {
-	return destroy_dpseci(MC_FW_VERSION_9);
+	return destroy_dpseci(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpseci_destroy_v10(void)
+static int cmd_dpseci_destroy_v10(struct restool *ctx)
 {
-	return destroy_dpseci(MC_FW_VERSION_10);
+	return destroy_dpseci(ctx, MC_FW_VERSION_10);
 }
 
 struct object_command dpseci_commands_v9[] = {
@@ -913,7 +992,8 @@ struct object_command dpseci_commands_v9[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpseci_destroy_options,
-	  .cmd_func = cmd_dpseci_destroy_v9 },
+	  .cmd_func = cmd_dpseci_destroy_v9,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -933,7 +1013,8 @@ struct object_command dpseci_commands_v10[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpseci_destroy_options,
-	  .cmd_func = cmd_dpseci_destroy_v10 },
+	  .cmd_func = cmd_dpseci_destroy_v10,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
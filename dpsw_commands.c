@@ -56,6 +56,7 @@
 enum dpsw_info_options {
 	INFO_OPT_HELP = 0,
 	INFO_OPT_VERBOSE,
+	INFO_OPT_FIELDS,
 };
 
 static struct option dpsw_info_options[] = {
@@ -73,6 +74,13 @@ static struct option dpsw_info_options[] = {
 		.val = 0,
 	},
 
+	[INFO_OPT_FIELDS] = {
+		.name = "fields",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
 	{ 0 },
 };
 
@@ -198,7 +206,7 @@ static struct option_entry options_map[] = {
 };
 static unsigned int options_num = ARRAY_SIZE(options_map);
 
-static int cmd_dpsw_help(void)
+static int cmd_dpsw_help(struct restool *ctx)
 {
 	static const char help_msg[] =
 		"\n"
@@ -211,34 +219,40 @@ static int cmd_dpsw_help(void)
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
 
+	(void)ctx;
 	printf(help_msg);
 	return 0;
 }
 
 static void print_dpsw_options(uint64_t options)
 {
+	output_begin_array("option_flags");
+
 	if ((options & ~ALL_DPSW_OPTS) != 0) {
-		printf("\tUnrecognized options found...\n");
+		output_item("Unrecognized options found...");
+		output_end_array();
 		return;
 	}
 
 	if (options & DPSW_OPT_FLOODING_DIS)
-		printf("\tDPSW_OPT_FLOODING_DIS\n");
+		output_item("DPSW_OPT_FLOODING_DIS");
 
 	if (options & DPSW_OPT_MULTICAST_DIS)
-		printf("\tDPSW_OPT_MULTICAST_DIS\n");
+		output_item("DPSW_OPT_MULTICAST_DIS");
 
 	if (options & DPSW_OPT_CTRL_IF_DIS)
-		printf("\tDPSW_OPT_CTRL_IF_DIS\n");
+		output_item("DPSW_OPT_CTRL_IF_DIS");
 
 	if (options & DPSW_OPT_FLOODING_METERING_DIS)
-		printf("\tDPSW_OPT_FLOODING_METERING_DIS\n");
+		output_item("DPSW_OPT_FLOODING_METERING_DIS");
 
 	if (options & DPSW_OPT_METERING_EN)
-		printf("\tDPSW_OPT_METERING_EN\n");
+		output_item("DPSW_OPT_METERING_EN");
+	output_end_array();
 }
 
-static int print_dpsw_endpoint(uint32_t target_id, uint16_t num_ifs)
+static int print_dpsw_endpoint(struct restool *ctx, uint32_t target_id,
+			       uint16_t num_ifs)
 {
 	struct dprc_endpoint endpoint1;
 	struct dprc_endpoint endpoint2;
@@ -246,7 +260,8 @@ static int print_dpsw_endpoint(uint32_t target_id, uint16_t num_ifs)
 	int error = 0;
 	int k;
 
-	printf("endpoints:\n");
+	output_printf("endpoints:\n");
+	output_begin_array("endpoints");
 	for (k = 0; k < num_ifs; ++k) {
 		memset(&endpoint1, 0, sizeof(struct dprc_endpoint));
 		memset(&endpoint2, 0, sizeof(struct dprc_endpoint));
@@ -255,43 +270,55 @@ static int print_dpsw_endpoint(uint32_t target_id, uint16_t num_ifs)
 		endpoint1.id = target_id;
 		endpoint1.if_id = k;
 
-		error = dprc_get_connection(&restool.mc_io, 0,
-					restool.root_dprc_handle,
+		error = dprc_get_connection(&ctx->mc_io, ctx->cmd_flags,
+					ctx->root_dprc_handle,
 					&endpoint1,
 					&endpoint2,
 					&state);
-		printf("interface %d:\n", k);
+		output_begin_object(NULL);
+		if (output_is_json())
+			output_int("interface", "interface", k);
+		else
+			output_printf("interface %d:\n", k);
 		if (error == 0 && state == -1) {
-			printf("\tconnection: none\n");
-			printf("\tlink state: n/a\n");
+			output_field("connection", "\tconnection", "none");
+			output_field("link_state", "\tlink state", "n/a");
 		} else if (error == 0) {
 			if (strcmp(endpoint2.type, "dpsw") == 0 ||
 			    strcmp(endpoint2.type, "dpdmux") == 0) {
-				printf("\tconnection: %s.%d.%d\n",
+				output_field("connection", "\tconnection",
+					     "%s.%d.%d",
 					endpoint2.type, endpoint2.id,
 					endpoint2.if_id);
 			} else if (endpoint2.if_id == 0) {
-				printf("\tconnection: %s.%d\n",
+				output_field("connection", "\tconnection",
+					     "%s.%d",
 					endpoint2.type, endpoint2.id);
 			}
 
 			if (state == 1)
-				printf("\tlink state: up\n");
+				output_field("link_state", "\tlink state",
+					     "up");
 			else if (state == 0)
-				printf("\tlink state: down\n");
+				output_field("link_state", "\tlink state",
+					     "down");
 			else
-				printf("\tlink state: error\n");
+				output_field("link_state", "\tlink state",
+					     "error");
 		} else {
-			mc_status = flib_error_to_mc_status(error);
+			ctx->mc_status = flib_error_to_mc_status(error);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				mc_status_to_string(mc_status), mc_status);
+				mc_status_to_string(ctx->mc_status),
+				ctx->mc_status);
 		}
+		output_end_object();
 	}
+	output_end_array();
 
 	return 0;
 }
 
-static int print_dpsw_attr_v9(uint32_t dpsw_id,
+static int print_dpsw_attr_v9(struct restool *ctx, uint32_t dpsw_id,
 			struct dprc_obj_desc *target_obj_desc)
 {
 	uint16_t dpsw_handle;
@@ -299,11 +326,12 @@ static int print_dpsw_attr_v9(uint32_t dpsw_id,
 	struct dpsw_attr_v9 dpsw_attr;
 	bool dpsw_opened = false;
 
-	error = dpsw_open(&restool.mc_io, 0, dpsw_id, &dpsw_handle);
+	error = dpsw_open(&ctx->mc_io, ctx->cmd_flags, dpsw_id, &dpsw_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpsw_opened = true;
@@ -316,33 +344,38 @@ static int print_dpsw_attr_v9(uint32_t dpsw_id,
 	}
 
 	memset(&dpsw_attr, 0, sizeof(dpsw_attr));
-	error = dpsw_get_attributes_v9(&restool.mc_io, 0, dpsw_handle,
+	error = dpsw_get_attributes_v9(&ctx->mc_io, ctx->cmd_flags, dpsw_handle,
 				       &dpsw_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	assert(dpsw_id == (uint32_t)dpsw_attr.id);
 
-	printf("dpsw version: %u.%u\n", dpsw_attr.version.major,
-	       dpsw_attr.version.minor);
-	printf("dpsw id: %d\n", dpsw_attr.id);
-	printf("plugged state: %splugged\n",
+	output_field("version", "dpsw version",
+		     "%u.%u", dpsw_attr.version.major,
+		     dpsw_attr.version.minor);
+	output_int("id", "dpsw id", dpsw_attr.id);
+	output_field("plugged_state", "plugged state", "%splugged",
 		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	print_dpsw_endpoint(dpsw_id, dpsw_attr.num_ifs);
-	printf("dpsw_attr.options value is: %#llx\n",
-	       (unsigned long long)dpsw_attr.options);
+	print_dpsw_endpoint(ctx, dpsw_id, dpsw_attr.num_ifs);
+	output_hex("options", "dpsw_attr.options value is",
+		   (unsigned long long)dpsw_attr.options);
 	print_dpsw_options(dpsw_attr.options);
-	printf("max VLANs: %u\n", (uint32_t)dpsw_attr.max_vlans);
-	printf("max FDBs: %u\n", (uint32_t)dpsw_attr.max_fdbs);
-	printf("frame storage memory size: %u\n",
-	       (uint32_t)dpsw_attr.mem_size);
-	printf("number of interfaces: %u\n", (uint32_t)dpsw_attr.num_ifs);
-	printf("current number of VLANs: %u\n", (uint32_t)dpsw_attr.num_vlans);
-	printf("current number of FDBs: %u\n", (uint32_t)dpsw_attr.num_fdbs);
-	print_obj_label(target_obj_desc);
+	output_uint("max_vlans", "max VLANs", (uint32_t)dpsw_attr.max_vlans);
+	output_uint("max_fdbs", "max FDBs", (uint32_t)dpsw_attr.max_fdbs);
+	output_uint("mem_size", "frame storage memory size",
+		    (uint32_t)dpsw_attr.mem_size);
+	output_uint("num_ifs", "number of interfaces",
+		    (uint32_t)dpsw_attr.num_ifs);
+	output_uint("num_vlans", "current number of VLANs",
+		    (uint32_t)dpsw_attr.num_vlans);
+	output_uint("num_fdbs", "current number of FDBs",
+		    (uint32_t)dpsw_attr.num_fdbs);
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -350,11 +383,12 @@ out:
 	if (dpsw_opened) {
 		int error2;
 
-		error2 = dpsw_close(&restool.mc_io, 0, dpsw_handle);
+		error2 = dpsw_close(&ctx->mc_io, ctx->cmd_flags, dpsw_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -363,66 +397,89 @@ out:
 	return error;
 }
 
-static int print_dpsw_attr_v10(uint32_t dpsw_id,
+static int print_dpsw_attr_v10(struct restool *ctx, uint32_t dpsw_id,
 			       struct dprc_obj_desc *target_obj_desc)
 {
 	struct dpsw_attr_v10 dpsw_attr;
 	uint16_t obj_major, obj_minor;
 	bool dpsw_opened = false;
 	uint16_t dpsw_handle;
-	int error;
+	int error = 0;
 
-	error = dpsw_open_v10(&restool.mc_io, 0, dpsw_id, &dpsw_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpsw_opened = true;
-	if (0 == dpsw_handle) {
-		DEBUG_PRINTF(
-			"dpsw_open() returned invalid handle (auth 0) for dpsw.%u\n",
-			dpsw_id);
-		error = -ENOENT;
-		goto out;
-	}
+	/* the endpoint walk needs num_ifs from the attributes */
+	if (INFO_FIELD(ATTR) || INFO_FIELD(ENDPOINT) || INFO_FIELD(LINK)) {
+		error = dpsw_open_v10(&ctx->mc_io, ctx->cmd_flags, dpsw_id,
+				      &dpsw_handle);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		dpsw_opened = true;
+		if (0 == dpsw_handle) {
+			DEBUG_PRINTF(
+				"dpsw_open() returned invalid handle (auth 0) for dpsw.%u\n",
+				dpsw_id);
+			error = -ENOENT;
+			goto out;
+		}
 
-	memset(&dpsw_attr, 0, sizeof(dpsw_attr));
-	error = dpsw_get_attributes_v10(&restool.mc_io, 0, dpsw_handle,
-					&dpsw_attr);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		memset(&dpsw_attr, 0, sizeof(dpsw_attr));
+		error = dpsw_get_attributes_v10(&ctx->mc_io, ctx->cmd_flags,
+						dpsw_handle, &dpsw_attr);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		assert(dpsw_id == (uint32_t)dpsw_attr.id);
 	}
-	assert(dpsw_id == (uint32_t)dpsw_attr.id);
 
-	error = dpsw_get_api_version_v10(&restool.mc_io, 0, &obj_major, &obj_minor);
-	if (error) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+	if (INFO_FIELD(VERSION)) {
+		error = get_obj_api_version(ctx, "dpsw",
+					    dpsw_get_api_version_v10,
+					    &obj_major, &obj_minor);
+		if (error) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			goto out;
+		}
+		output_field("version", "dpsw version",
+			     "%u.%u", obj_major, obj_minor);
 	}
 
-	printf("dpsw version: %u.%u\n", obj_major, obj_minor);
-	printf("dpsw id: %d\n", dpsw_attr.id);
-	printf("plugged state: %splugged\n",
-		(target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ? "" : "un");
-	print_dpsw_endpoint(dpsw_id, dpsw_attr.num_ifs);
-	printf("dpsw_attr.options value is: %#llx\n",
-	       (unsigned long long)dpsw_attr.options);
-	print_dpsw_options(dpsw_attr.options);
-	printf("max VLANs: %u\n", (uint32_t)dpsw_attr.max_vlans);
-	printf("max FDBs: %u\n", (uint32_t)dpsw_attr.max_fdbs);
-	printf("frame storage memory size: %u\n",
-	       (uint32_t)dpsw_attr.mem_size);
-	printf("number of interfaces: %u\n", (uint32_t)dpsw_attr.num_ifs);
-	printf("current number of VLANs: %u\n", (uint32_t)dpsw_attr.num_vlans);
-	printf("current number of FDBs: %u\n", (uint32_t)dpsw_attr.num_fdbs);
-	print_obj_label(target_obj_desc);
+	if (INFO_FIELD(ID))
+		output_int("id", "dpsw id", dpsw_id);
+	if (INFO_FIELD(STATE))
+		output_field("plugged_state", "plugged state", "%splugged",
+			     (target_obj_desc->state & DPRC_OBJ_STATE_PLUGGED) ?
+			     "" : "un");
+	if (INFO_FIELD(ENDPOINT) || INFO_FIELD(LINK))
+		print_dpsw_endpoint(ctx, dpsw_id, dpsw_attr.num_ifs);
+	if (INFO_FIELD(ATTR)) {
+		output_hex("options", "dpsw_attr.options value is",
+			   (unsigned long long)dpsw_attr.options);
+		print_dpsw_options(dpsw_attr.options);
+		output_uint("max_vlans", "max VLANs",
+			    (uint32_t)dpsw_attr.max_vlans);
+		output_uint("max_fdbs", "max FDBs",
+			    (uint32_t)dpsw_attr.max_fdbs);
+		output_uint("mem_size", "frame storage memory size",
+			    (uint32_t)dpsw_attr.mem_size);
+		output_uint("num_ifs", "number of interfaces",
+			    (uint32_t)dpsw_attr.num_ifs);
+		output_uint("num_vlans", "current number of VLANs",
+			    (uint32_t)dpsw_attr.num_vlans);
+		output_uint("num_fdbs", "current number of FDBs",
+			    (uint32_t)dpsw_attr.num_fdbs);
+	}
+	print_obj_label(ctx, target_obj_desc);
 
 	error = 0;
 
@@ -430,11 +487,13 @@ out:
 	if (dpsw_opened) {
 		int error2;
 
-		error2 = dpsw_close_v10(&restool.mc_io, 0, dpsw_handle);
+		error2 = dpsw_close_v10(&ctx->mc_io, ctx->cmd_flags,
+					dpsw_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -443,51 +502,50 @@ out:
 	return error;
 }
 
-static int print_dpsw_info(uint32_t dpsw_id, int mc_fw_version)
+static int print_dpsw_info(struct restool *ctx, uint32_t dpsw_id,
+			   int mc_fw_version)
 {
 	int error;
 	struct dprc_obj_desc target_obj_desc;
-	uint32_t target_parent_dprc_id;
-	bool found = false;
-
-	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0, dpsw_id,
-				"dpsw", &target_obj_desc,
-				&target_parent_dprc_id, &found);
+
+	error = find_info_obj_desc(ctx, dpsw_id, "dpsw",
+				   ctx->cmd_option_mask &
+				   ONE_BIT_MASK(INFO_OPT_VERBOSE),
+				   &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (strcmp(target_obj_desc.type, "dpsw")) {
-		printf("dpsw.%d does not exist\n", dpsw_id);
-		return -EINVAL;
-	}
-
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = print_dpsw_attr_v9(dpsw_id, &target_obj_desc);
+		error = print_dpsw_attr_v9(ctx, dpsw_id, &target_obj_desc);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = print_dpsw_attr_v10(dpsw_id, &target_obj_desc);
+		error = print_dpsw_attr_v10(ctx, dpsw_id, &target_obj_desc);
 	if (error < 0)
 		goto out;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpsw_ops);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
+		error = print_obj_verbose(ctx, &target_obj_desc, &dpsw_ops);
 	}
 
 out:
 	return error;
 }
 
-static int info_dpsw(int mc_fw_version)
+static int info_dpsw(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
 		"Usage: restool dpsw info <dpsw-object> [--verbose]\n"
+		"                         [--fields=<field>[,<field>...]]\n"
 		"\n"
 		"OPTIONS:\n"
 		"--verbose\n"
 		"   Shows extended/verbose information about the object\n"
+		"--fields=<field>[,<field>...]\n"
+		"   Shows only the given fields and sends only the MC\n"
+		"   commands they need. <field> is one of: version, id,\n"
+		"   state, endpoint, link, mac, attr, stats, label.\n"
+		"   Requires MC firmware 10.x.\n"
 		"\n"
 		"EXAMPLE:\n"
 		"Display information about dpsw.0:\n"
@@ -497,41 +555,49 @@ static int info_dpsw(int mc_fw_version)
 	uint32_t obj_id;
 	int error;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_HELP);
 		error = 0;
 		goto out;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(INFO_OPT_FIELDS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_FIELDS);
+		error = parse_info_fields(ctx, 
+				ctx->cmd_option_args[INFO_OPT_FIELDS]);
+		if (error < 0)
+			goto out;
+	}
+
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpsw", &obj_id);
+	error = parse_object_name(ctx->obj_name, "dpsw", &obj_id);
 	if (error < 0)
 		goto out;
 
-	error = print_dpsw_info(obj_id, mc_fw_version);
+	error = print_dpsw_info(ctx, obj_id, mc_fw_version);
 
 out:
 	return error;
 }
 
-static int cmd_dpsw_info_v9(void)
+static int cmd_dpsw_info_v9(struct restool *ctx)
 {
-	return info_dpsw(MC_FW_VERSION_9);
+	return info_dpsw(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpsw_info_v10(void)
+static int cmd_dpsw_info_v10(struct restool *ctx)
 {
-	return info_dpsw(MC_FW_VERSION_10);
+	return info_dpsw(ctx, MC_FW_VERSION_10);
 }
 
-static int create_dpsw_v9(const char *usage_msg)
+static int create_dpsw_v9(struct restool *ctx, const char *usage_msg)
 {
 	struct dpsw_cfg_v9 dpsw_cfg = {0};
 	struct dpsw_attr_v9 dpsw_attr;
@@ -539,22 +605,22 @@ static int create_dpsw_v9(const char *usage_msg)
 	int error;
 	long val;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name != NULL) {
+	if (ctx->obj_name != NULL) {
 		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
-			     restool.obj_name);
+			     ctx->obj_name);
 		puts(usage_msg);
 		return -EINVAL;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_IFS)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_NUM_IFS);
-		error = get_option_value(CREATE_OPT_NUM_IFS, &val,
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_IFS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_NUM_IFS);
+		error = get_option_value(ctx, CREATE_OPT_NUM_IFS, &val,
 					 "Invalid number of interfaces",
 					 0, UINT16_MAX);
 		if (error)
@@ -564,10 +630,10 @@ static int create_dpsw_v9(const char *usage_msg)
 		dpsw_cfg.num_ifs = 4; /* Todo: default value not defined */
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_OPTIONS)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_OPTIONS);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_OPTIONS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_OPTIONS);
 		error = parse_generic_create_options(
-				restool.cmd_option_args[CREATE_OPT_OPTIONS],
+				ctx->cmd_option_args[CREATE_OPT_OPTIONS],
 				&dpsw_cfg.adv.options,
 				options_map,
 				options_num);
@@ -581,9 +647,9 @@ static int create_dpsw_v9(const char *usage_msg)
 		dpsw_cfg.adv.options = 0;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAX_VLANS)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_MAX_VLANS);
-		error = get_option_value(CREATE_OPT_MAX_VLANS, &val,
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAX_VLANS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_MAX_VLANS);
+		error = get_option_value(ctx, CREATE_OPT_MAX_VLANS, &val,
 					 "Invalid max vlans",
 					 0, UINT16_MAX);
 		if (error)
@@ -593,11 +659,11 @@ static int create_dpsw_v9(const char *usage_msg)
 		dpsw_cfg.adv.max_vlans = 0;
 	}
 
-	if (restool.cmd_option_mask &
+	if (ctx->cmd_option_mask &
 	    ONE_BIT_MASK(CREATE_OPT_MAX_FDBS)) {
-		restool.cmd_option_mask &=
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_MAX_FDBS);
-		error = get_option_value(CREATE_OPT_MAX_FDBS, &val,
+		error = get_option_value(ctx, CREATE_OPT_MAX_FDBS, &val,
 					 "Invalid max FDB", 0, UINT8_MAX);
 		if (error)
 			return -EINVAL;
@@ -606,11 +672,11 @@ static int create_dpsw_v9(const char *usage_msg)
 		dpsw_cfg.adv.max_fdbs = 0;
 	}
 
-	if (restool.cmd_option_mask &
+	if (ctx->cmd_option_mask &
 	    ONE_BIT_MASK(CREATE_OPT_MAX_FDB_ENTRIES)) {
-		restool.cmd_option_mask &=
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_MAX_FDB_ENTRIES);
-		error = get_option_value(CREATE_OPT_MAX_FDB_ENTRIES, &val,
+		error = get_option_value(ctx, CREATE_OPT_MAX_FDB_ENTRIES, &val,
 					 "Invalid number of FDB entries",
 					 0, UINT16_MAX);
 		if (error)
@@ -620,11 +686,11 @@ static int create_dpsw_v9(const char *usage_msg)
 		dpsw_cfg.adv.max_fdb_entries = 0;
 	}
 
-	if (restool.cmd_option_mask &
+	if (ctx->cmd_option_mask &
 	    ONE_BIT_MASK(CREATE_OPT_FDB_AGING_TIME)) {
-		restool.cmd_option_mask &=
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_FDB_AGING_TIME);
-		error = get_option_value(CREATE_OPT_FDB_AGING_TIME, &val,
+		error = get_option_value(ctx, CREATE_OPT_FDB_AGING_TIME, &val,
 					 "Invalid FDB aging time",
 					 0, UINT16_MAX);
 		if (error)
@@ -634,11 +700,12 @@ static int create_dpsw_v9(const char *usage_msg)
 		dpsw_cfg.adv.fdb_aging_time = 0;
 	}
 
-	if (restool.cmd_option_mask &
+	if (ctx->cmd_option_mask &
 	    ONE_BIT_MASK(CREATE_OPT_MAX_FDB_MC_GROUPS)) {
-		restool.cmd_option_mask &=
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_MAX_FDB_MC_GROUPS);
-		error = get_option_value(CREATE_OPT_MAX_FDB_MC_GROUPS, &val,
+		error = get_option_value(ctx, CREATE_OPT_MAX_FDB_MC_GROUPS,
+					 &val,
 					 "Invalid number of multicast groups",
 					 0, UINT16_MAX);
 		if (error)
@@ -648,35 +715,40 @@ static int create_dpsw_v9(const char *usage_msg)
 		dpsw_cfg.adv.max_fdb_mc_groups = 0;
 	}
 
-	error = dpsw_create_v9(&restool.mc_io, 0, &dpsw_cfg, &dpsw_handle);
+	error = dpsw_create_v9(&ctx->mc_io, ctx->cmd_flags, &dpsw_cfg,
+			       &dpsw_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	memset(&dpsw_attr, 0, sizeof(struct dpsw_attr_v9));
-	error = dpsw_get_attributes_v9(&restool.mc_io, 0, dpsw_handle, &dpsw_attr);
+	error = dpsw_get_attributes_v9(&ctx->mc_io, ctx->cmd_flags, dpsw_handle,
+				       &dpsw_attr);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
-	print_new_obj("dpsw", dpsw_attr.id, NULL);
+	print_new_obj(ctx, "dpsw", dpsw_attr.id, NULL);
 
-	error = dpsw_close(&restool.mc_io, 0, dpsw_handle);
+	error = dpsw_close(&ctx->mc_io, ctx->cmd_flags, dpsw_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 	return 0;
 }
 
-static int cmd_dpsw_create_v9(void)
+static int cmd_dpsw_create_v9(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -709,10 +781,10 @@ static int cmd_dpsw_create_v9(void)
 		"   $ restool dpsw create\n"
 		"\n";
 
-	return create_dpsw_v9(usage_msg);
+	return create_dpsw_v9(ctx, usage_msg);
 }
 
-static int create_dpsw_v10(const char *usage_msg)
+static int create_dpsw_v10(struct restool *ctx, const char *usage_msg)
 {
 	struct dpsw_cfg_v10 dpsw_cfg = {0};
 	uint32_t dpsw_id, dprc_id;
@@ -721,22 +793,22 @@ static int create_dpsw_v10(const char *usage_msg)
 	int error;
 	long val;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name != NULL) {
+	if (ctx->obj_name != NULL) {
 		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
-			     restool.obj_name);
+			     ctx->obj_name);
 		puts(usage_msg);
 		return -EINVAL;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_IFS)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_NUM_IFS);
-		error = get_option_value(CREATE_OPT_NUM_IFS, &val,
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_NUM_IFS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_NUM_IFS);
+		error = get_option_value(ctx, CREATE_OPT_NUM_IFS, &val,
 				     "Invalid number of interfaces\n",
 				     1, UINT16_MAX);
 		if (error)
@@ -746,10 +818,10 @@ static int create_dpsw_v10(const char *usage_msg)
 		dpsw_cfg.num_ifs = 4; /* Todo: default value not defined */
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_OPTIONS)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_OPTIONS);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_OPTIONS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_OPTIONS);
 		error = parse_generic_create_options(
-				restool.cmd_option_args[CREATE_OPT_OPTIONS],
+				ctx->cmd_option_args[CREATE_OPT_OPTIONS],
 				&dpsw_cfg.adv.options,
 				options_map,
 				options_num);
@@ -763,9 +835,9 @@ static int create_dpsw_v10(const char *usage_msg)
 		dpsw_cfg.adv.options = 0;
 	}
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAX_VLANS)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_MAX_VLANS);
-		error = get_option_value(CREATE_OPT_MAX_VLANS, &val,
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_MAX_VLANS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_MAX_VLANS);
+		error = get_option_value(ctx, CREATE_OPT_MAX_VLANS, &val,
 				     "Invalid max vlans\n", 1, UINT16_MAX);
 		if (error)
 			return error;
@@ -774,10 +846,10 @@ static int create_dpsw_v10(const char *usage_msg)
 		dpsw_cfg.adv.max_vlans = 0;
 	}
 
-	if (restool.cmd_option_mask &
+	if (ctx->cmd_option_mask &
 	    ONE_BIT_MASK(CREATE_OPT_MAX_FDBS)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_MAX_FDBS);
-		error = get_option_value(CREATE_OPT_MAX_FDBS, &val,
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_MAX_FDBS);
+		error = get_option_value(ctx, CREATE_OPT_MAX_FDBS, &val,
 				     "Invalid max FDB\n", 1, UINT8_MAX);
 		if (error)
 			return error;
@@ -786,11 +858,11 @@ static int create_dpsw_v10(const char *usage_msg)
 		dpsw_cfg.adv.max_fdbs = 0;
 	}
 
-	if (restool.cmd_option_mask &
+	if (ctx->cmd_option_mask &
 	    ONE_BIT_MASK(CREATE_OPT_MAX_FDB_ENTRIES)) {
-		restool.cmd_option_mask &=
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_MAX_FDB_ENTRIES);
-		error = get_option_value(CREATE_OPT_MAX_FDB_ENTRIES, &val,
+		error = get_option_value(ctx, CREATE_OPT_MAX_FDB_ENTRIES, &val,
 				     "Invalid number of FDB entries\n",
 				     1, UINT16_MAX);
 		if (error)
@@ -800,11 +872,11 @@ static int create_dpsw_v10(const char *usage_msg)
 		dpsw_cfg.adv.max_fdb_entries = 0;
 	}
 
-	if (restool.cmd_option_mask &
+	if (ctx->cmd_option_mask &
 	    ONE_BIT_MASK(CREATE_OPT_FDB_AGING_TIME)) {
-		restool.cmd_option_mask &=
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_FDB_AGING_TIME);
-		error = get_option_value(CREATE_OPT_FDB_AGING_TIME, &val,
+		error = get_option_value(ctx, CREATE_OPT_FDB_AGING_TIME, &val,
 				     "Invalid FDB aging time\n", 1, UINT16_MAX);
 		if (error)
 			return error;
@@ -813,11 +885,12 @@ static int create_dpsw_v10(const char *usage_msg)
 		dpsw_cfg.adv.fdb_aging_time = 0;
 	}
 
-	if (restool.cmd_option_mask &
+	if (ctx->cmd_option_mask &
 	    ONE_BIT_MASK(CREATE_OPT_MAX_FDB_MC_GROUPS)) {
-		restool.cmd_option_mask &=
+		ctx->cmd_option_mask &=
 			~ONE_BIT_MASK(CREATE_OPT_MAX_FDB_MC_GROUPS);
-		error = get_option_value(CREATE_OPT_MAX_FDB_MC_GROUPS, &val,
+		error = get_option_value(ctx, CREATE_OPT_MAX_FDB_MC_GROUPS,
+					 &val,
 				     "Invalid number of multicast groups\n",
 				     1, UINT16_MAX);
 		if (error)
@@ -827,45 +900,46 @@ static int create_dpsw_v10(const char *usage_msg)
 		dpsw_cfg.adv.max_fdb_mc_groups = 0;
 	}
 
-	dprc_handle = restool.root_dprc_handle;
+	dprc_handle = ctx->root_dprc_handle;
 	dprc_opened = false;
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PARENT_DPRC);
 		error = parse_object_name(
-				restool.cmd_option_args[CREATE_OPT_PARENT_DPRC],
+				ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC],
 				"dprc", &dprc_id);
 		if (error)
 			return error;
 
-		if (restool.root_dprc_id != dprc_id) {
-			error = open_dprc(dprc_id, &dprc_handle);
+		if (ctx->root_dprc_id != dprc_id) {
+			error = open_dprc(ctx, dprc_id, &dprc_handle);
 			if (error)
 				return error;
 			dprc_opened = true;
 		}
 	}
 
-	error = dpsw_create_v10(&restool.mc_io, dprc_handle, 0,
+	error = dpsw_create_v10(&ctx->mc_io, dprc_handle, ctx->cmd_flags,
 				&dpsw_cfg, &dpsw_id);
 	if (error) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		return error;
 	}
 
 	if (dprc_opened) {
-		(void)dprc_close(&restool.mc_io, 0, dprc_handle);
-		print_new_obj("dpsw", dpsw_id,
-			      restool.cmd_option_args[CREATE_OPT_PARENT_DPRC]);
+		(void)dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
+		print_new_obj(ctx, "dpsw", dpsw_id,
+			      ctx->cmd_option_args[CREATE_OPT_PARENT_DPRC]);
 	} else {
-		print_new_obj("dpsw", dpsw_id, NULL);
+		print_new_obj(ctx, "dpsw", dpsw_id, NULL);
 	}
 
 	return error;
 }
 
-static int cmd_dpsw_create_v10(void)
+static int cmd_dpsw_create_v10(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -901,20 +975,21 @@ static int cmd_dpsw_create_v10(void)
 		"   $ restool dpsw create\n"
 		"\n";
 
-	return create_dpsw_v10(usage_msg);
+	return create_dpsw_v10(ctx, usage_msg);
 }
 
-static int destroy_dpsw_v9(uint32_t dpsw_id)
+static int destroy_dpsw_v9(struct restool *ctx, uint32_t dpsw_id)
 {
 	bool dpsw_opened = false;
 	uint16_t dpsw_handle;
 	int error, error2;
 
-	error = dpsw_open(&restool.mc_io, 0, dpsw_id, &dpsw_handle);
+	error = dpsw_open(&ctx->mc_io, ctx->cmd_flags, dpsw_id, &dpsw_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpsw_opened = true;
@@ -926,23 +1001,25 @@ static int destroy_dpsw_v9(uint32_t dpsw_id)
 		goto out;
 	}
 
-	error = dpsw_destroy(&restool.mc_io, 0, dpsw_handle);
+	error = dpsw_destroy(&ctx->mc_io, ctx->cmd_flags, dpsw_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 	dpsw_opened = false;
-	printf("dpsw.%u is destroyed\n", dpsw_id);
+	print_destroyed_obj("dpsw", dpsw_id);
 
 out:
 	if (dpsw_opened) {
-		error2 = dpsw_close(&restool.mc_io, 0, dpsw_handle);
+		error2 = dpsw_close(&ctx->mc_io, ctx->cmd_flags, dpsw_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
@@ -951,42 +1028,43 @@ out:
 	return error;
 }
 
-static int destroy_dpsw_v10(uint32_t dpsw_id)
+static int destroy_dpsw_v10(struct restool *ctx, uint32_t dpsw_id)
 {
 	uint16_t dprc_handle;
 	uint32_t dprc_id;
 	int error;
 
-	dprc_handle = restool.root_dprc_handle;
-	dprc_id = restool.root_dprc_id;
-	error = get_parent_dprc_id(dpsw_id, "dpsw", &dprc_id);
+	dprc_handle = ctx->root_dprc_handle;
+	dprc_id = ctx->root_dprc_id;
+	error = get_parent_dprc_id(ctx, dpsw_id, "dpsw", &dprc_id);
 	if (error)
 		return error;
 
-	if (dprc_id != restool.root_dprc_id) {
-		error = open_dprc(dprc_id, &dprc_handle);
+	if (dprc_id != ctx->root_dprc_id) {
+		error = open_dprc(ctx, dprc_id, &dprc_handle);
 		if (error)
 			return error;
 	}
 
-	error = dpsw_destroy_v10(&restool.mc_io, dprc_handle,
-				 0, dpsw_id);
+	error = dpsw_destroy_v10(&ctx->mc_io, dprc_handle,
+				 ctx->cmd_flags, dpsw_id);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
-	printf("dpsw.%u is destroyed\n", dpsw_id);
+	print_destroyed_obj("dpsw", dpsw_id);
 
 out:
-	if (dprc_id != restool.root_dprc_id)
-		error = dprc_close(&restool.mc_io, 0, dprc_handle);
+	if (dprc_id != ctx->root_dprc_id)
+		error = dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
 
 	return error;
 }
 
-static int destroy_dpsw(int mc_fw_version)
+static int destroy_dpsw(struct restool *ctx, int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
@@ -997,37 +1075,37 @@ static int destroy_dpsw(int mc_fw_version)
 	int error;
 	uint32_t dpsw_id;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_HELP);
 		return 0;
 	}
 
-	if (restool.obj_name == NULL) {
+	if (ctx->obj_name == NULL) {
 		ERROR_PRINTF("<object> argument missing\n");
 		puts(usage_msg);
 		error = -EINVAL;
 		goto out;
 	}
 
-	if (in_use(restool.obj_name, "destroyed")) {
+	if (in_use(ctx->obj_name, "destroyed")) {
 		error = -EBUSY;
 		goto out;
 	}
 
-	error = parse_object_name(restool.obj_name, "dpsw", &dpsw_id);
+	error = parse_object_name(ctx->obj_name, "dpsw", &dpsw_id);
 	if (error < 0)
 		goto out;
 
-	if (!find_obj("dpsw", dpsw_id)) {
+	if (!find_obj(ctx, "dpsw", dpsw_id)) {
 		error = -EINVAL;
 		goto out;
 	}
 
 	if (mc_fw_version == MC_FW_VERSION_9)
-		error = destroy_dpsw_v9(dpsw_id);
+		error = destroy_dpsw_v9(ctx, dpsw_id);
 	else if (mc_fw_version == MC_FW_VERSION_10)
-		error = destroy_dpsw_v10(dpsw_id);
+		error = destroy_dpsw_v10(ctx, dpsw_id);
 	else
 		return -EINVAL;
 
@@ -1035,14 +1113,14 @@ out:
 	return error;
 }
 
-static int cmd_dpsw_destroy_v9(void)
+static int cmd_dpsw_destroy_v9(struct restool *ctx)
 {
-	return destroy_dpsw(MC_FW_VERSION_9);
+	return destroy_dpsw(ctx, MC_FW_VERSION_9);
 }
 
-static int cmd_dpsw_destroy_v10(void)
+static int cmd_dpsw_destroy_v10(struct restool *ctx)
 {
-	return destroy_dpsw(MC_FW_VERSION_10);
+	return destroy_dpsw(ctx, MC_FW_VERSION_10);
 }
 
 struct object_command dpsw_commands_v9[] = {
@@ -1060,7 +1138,8 @@ struct object_command dpsw_commands_v9[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpsw_destroy_options,
-	  .cmd_func = cmd_dpsw_destroy_v9 },
+	  .cmd_func = cmd_dpsw_destroy_v9,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
@@ -1080,7 +1159,8 @@ struct object_command dpsw_commands_v10[] = {
 
 	{ .cmd_name = "destroy",
 	  .options = dpsw_destroy_options,
-	  .cmd_func = cmd_dpsw_destroy_v10 },
+	  .cmd_func = cmd_dpsw_destroy_v10,
+	  .priority = CMD_PRIORITY_HIGH },
 
 	{ .cmd_name = NULL },
 };
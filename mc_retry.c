@@ -0,0 +1,181 @@
+/* Copyright 2018 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <time.h>
+#include "restool.h"
+#include "utils.h"
+#include "mc_retry.h"
+#include "mc_v10/fsl_dpaiop_cmd.h"
+#include "mc_v10/fsl_dpbp_cmd.h"
+#include "mc_v10/fsl_dpci_cmd.h"
+#include "mc_v10/fsl_dpcon_cmd.h"
+#include "mc_v10/fsl_dpdcei_cmd.h"
+#include "mc_v10/fsl_dpdmai_cmd.h"
+#include "mc_v10/fsl_dpdmux_cmd.h"
+#include "mc_v10/fsl_dpio_cmd.h"
+#include "mc_v10/fsl_dpmac_cmd.h"
+#include "mc_v10/fsl_dpmcp_cmd.h"
+#include "mc_v10/fsl_dpmng_cmd.h"
+#include "mc_v10/fsl_dpni_cmd.h"
+#include "mc_v10/fsl_dprc_cmd.h"
+#include "mc_v10/fsl_dprtc_cmd.h"
+#include "mc_v10/fsl_dpseci_cmd.h"
+#include "mc_v10/fsl_dpsw_cmd.h"
+
+static uint64_t mc_retry_delay_us(struct restool *ctx, unsigned int attempt)
+{
+	uint64_t delay = MC_RETRY_MAX_DELAY_US;
+
+	if (attempt < 16)
+		delay = (uint64_t)MC_RETRY_FIRST_DELAY_US << attempt;
+	if (delay > MC_RETRY_MAX_DELAY_US)
+		delay = MC_RETRY_MAX_DELAY_US;
+
+	/* spread requests that were turned away together */
+	return delay / 2 + rand_r(&ctx->retry_seed) % (delay / 2 + 1);
+}
+
+/**
+ * Commands that only read MC state. Sending them twice does no harm, so
+ * they are also retried after the MC timed out, when the first one may
+ * have run. Ids are unique across object types except for get_attr and
+ * the irq getters, which every type has at the same id.
+ */
+static bool is_query(uint16_t cmd_id)
+{
+	switch (cmd_id) {
+	case MC_CMDID(DPRC_CMDID_GET_ATTR):
+	case MC_CMDID(DPRC_CMDID_GET_IRQ_MASK):
+	case MC_CMDID(DPRC_CMDID_GET_IRQ_STATUS):
+	case MC_CMDID(DPRC_CMDID_GET_CONT_ID):
+	case MC_CMDID(DPRC_CMDID_GET_OBJ_COUNT):
+	case MC_CMDID(DPRC_CMDID_GET_OBJ):
+	case MC_CMDID(DPRC_CMDID_GET_OBJ_DESC):
+	case MC_CMDID(DPRC_CMDID_GET_RES_COUNT):
+	case MC_CMDID(DPRC_CMDID_GET_RES_IDS):
+	case MC_CMDID(DPRC_CMDID_GET_POOL):
+	case MC_CMDID(DPRC_CMDID_GET_POOL_COUNT):
+	case MC_CMDID(DPRC_CMDID_GET_CONNECTION):
+	case MC_CMDID(DPMNG_CMDID_GET_VERSION):
+	case MC_CMDID(DPMNG_CMDID_GET_SOC_VERSION):
+	case MC_CMDID(DPNI_CMDID_GET_LINK_STATE):
+	case MC_CMDID(DPNI_CMDID_GET_PRIM_MAC):
+	case MC_CMDID(DPNI_CMDID_GET_STATISTICS):
+	case MC_CMDID(DPNI_CMDID_GET_QUEUE):
+	case MC_CMDID(DPNI_CMDID_GET_TAILDROP):
+	case MC_CMDID(DPNI_CMDID_GET_CONGESTION_NOTIFICATION):
+	case MC_CMDID(DPNI_CMDID_GET_OFFLOAD):
+	case MC_CMDID(DPMAC_CMDID_GET_COUNTER):
+	case MC_CMDID(DPCI_CMDID_GET_LINK_STATE):
+	case MC_CMDID(DPCI_CMDID_GET_PEER_ATTR):
+	case MC_CMDID(DPSECI_CMDID_GET_TX_QUEUE):
+	case MC_CMDID(DPAIOP_CMDID_GET_SL_VERSION):
+	case MC_CMDID(DPAIOP_CMDID_GET_STATE):
+	case MC_CMDID(DPAIOP_CMDID_GET_API_VERSION):
+	case MC_CMDID(DPBP_CMDID_GET_API_VERSION):
+	case MC_CMDID(DPCI_CMDID_GET_API_VERSION):
+	case MC_CMDID(DPCON_CMDID_GET_API_VERSION):
+	case MC_CMDID(DPDCEI_CMDID_GET_API_VERSION):
+	case MC_CMDID(DPDMAI_CMDID_GET_API_VERSION):
+	case MC_CMDID(DPDMUX_CMDID_GET_API_VERSION):
+	case MC_CMDID(DPIO_CMDID_GET_API_VERSION):
+	case MC_CMDID(DPMAC_CMDID_GET_API_VERSION):
+	case MC_CMDID(DPMCP_CMDID_GET_API_VERSION):
+	case MC_CMDID(DPNI_CMDID_GET_API_VERSION):
+	case MC_CMDID(DPRC_CMDID_GET_API_VERSION):
+	case MC_CMDID(DPRTC_CMDID_GET_API_VERSION):
+	case MC_CMDID(DPSECI_CMDID_GET_API_VERSION):
+	case MC_CMDID(DPSW_CMDID_GET_API_VERSION):
+		return true;
+	default:
+		return false;
+	}
+}
+
+/**
+ * Called after an MC command was sent: returns true, after backing off,
+ * if it should be sent again
+ */
+bool mc_retry(struct restool *ctx, uint64_t header, int error,
+	      struct mc_retry *retry)
+{
+	uint64_t max_wait_us = (uint64_t)ctx->retry_wait_ms * 1000;
+	struct timespec delay;
+	uint64_t delay_us;
+
+	/* a timed out command may have run, only queries are sent again */
+	if (error != -EBUSY &&
+	    (error != -ETIMEDOUT || !is_query(mc_header_cmd_id(header))))
+		return false;
+
+	if (retry->waited_us >= max_wait_us) {
+		if (retry->attempt != 0)
+			DEBUG_PRINTF("giving up after %u retries\n",
+				     retry->attempt);
+		return false;
+	}
+
+	delay_us = mc_retry_delay_us(ctx, retry->attempt);
+	if (delay_us > max_wait_us - retry->waited_us)
+		delay_us = max_wait_us - retry->waited_us;
+
+	DEBUG_PRINTF("MC command failed with %d, retry %u in %llu us\n",
+		     error, retry->attempt + 1, (unsigned long long)delay_us);
+	delay.tv_sec = delay_us / 1000000;
+	delay.tv_nsec = (delay_us % 1000000) * 1000;
+	while (nanosleep(&delay, &delay) < 0 && errno == EINTR)
+		continue;
+
+	retry->attempt++;
+	retry->waited_us += delay_us;
+	ctx->mc_retries++;
+	ctx->mc_retry_wait_us += delay_us;
+	return true;
+}
+
+/**
+ * Tells how often the MC turned commands of this request away, so that
+ * callers see contention before it makes commands fail
+ */
+void mc_retry_report(struct restool *ctx)
+{
+	if (ctx->mc_retries == 0)
+		return;
+
+	output_flush();
+	fprintf(stderr, "MC busy: %lu command retries, %llu.%03llu ms waited\n",
+		ctx->mc_retries,
+		(unsigned long long)(ctx->mc_retry_wait_us / 1000),
+		(unsigned long long)(ctx->mc_retry_wait_us % 1000));
+}
@@ -0,0 +1,63 @@
+/* Copyright 2018 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _MC_RETRY_H_
+#define _MC_RETRY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * MC commands the MC answers with MC_CMD_STATUS_BUSY (-EBUSY), and queries
+ * it answers with MC_CMD_STATUS_TIMEOUT (-ETIMEDOUT), are sent again after
+ * a jittered exponential backoff: the n-th retry waits between half and all of
+ * MC_RETRY_FIRST_DELAY_US << n, at most MC_RETRY_MAX_DELAY_US, until the
+ * command has waited --retry-wait milliseconds in total.
+ */
+#define MC_RETRY_DEFAULT_WAIT_MS	2000
+#define MC_RETRY_MAX_WAIT_MS		600000
+#define MC_RETRY_FIRST_DELAY_US		500
+#define MC_RETRY_MAX_DELAY_US		100000
+
+/* backoff state of one MC command */
+struct mc_retry {
+	unsigned int attempt;
+	uint64_t waited_us;
+};
+
+struct restool;
+
+bool mc_retry(struct restool *ctx, uint64_t header, int error,
+	      struct mc_retry *retry);
+void mc_retry_report(struct restool *ctx);
+
+#endif /* _MC_RETRY_H_ */
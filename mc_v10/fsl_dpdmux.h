@@ -134,4 +134,63 @@ int dpdmux_get_api_version_v10(struct fsl_mc_io *mc_io,
 			       uint16_t *major_ver,
 			       uint16_t *minor_ver);
 
+/**
+ * struct dpdmux_l2_rule_v10 - Structure representing L2 rule
+ * @mac_addr: MAC address
+ * @vlan_id: VLAN ID
+ */
+struct dpdmux_l2_rule_v10 {
+	uint8_t mac_addr[6];
+	uint16_t vlan_id;
+};
+
+int dpdmux_if_add_l2_rule_v10(struct fsl_mc_io *mc_io,
+			      uint32_t cmd_flags,
+			      uint16_t token,
+			      uint16_t if_id,
+			      const struct dpdmux_l2_rule_v10 *rule);
+
+int dpdmux_if_remove_l2_rule_v10(struct fsl_mc_io *mc_io,
+				 uint32_t cmd_flags,
+				 uint16_t token,
+				 uint16_t if_id,
+				 const struct dpdmux_l2_rule_v10 *rule);
+
+int dpdmux_set_custom_key_v10(struct fsl_mc_io *mc_io,
+			      uint32_t cmd_flags,
+			      uint16_t token,
+			      uint64_t key_cfg_iova);
+
+/**
+ * struct dpdmux_rule_cfg_v10 - Custom classification rule.
+ * @key_iova: DMA address of the key to match
+ * @mask_iova: DMA address of the mask applied to the key; only honored
+ *	when the DPDMUX was created with DPDMUX_OPT_CLS_MASK_SUPPORT
+ * @key_size: Size of the key, in bytes
+ */
+struct dpdmux_rule_cfg_v10 {
+	uint64_t key_iova;
+	uint64_t mask_iova;
+	uint8_t key_size;
+};
+
+/**
+ * struct dpdmux_cls_action_v10 - Action of a custom classification rule
+ * @dest_if: Interface matching frames are forwarded to
+ */
+struct dpdmux_cls_action_v10 {
+	uint16_t dest_if;
+};
+
+int dpdmux_add_custom_cls_entry_v10(struct fsl_mc_io *mc_io,
+				    uint32_t cmd_flags,
+				    uint16_t token,
+				    const struct dpdmux_rule_cfg_v10 *rule,
+				    const struct dpdmux_cls_action_v10 *action);
+
+int dpdmux_remove_custom_cls_entry_v10(struct fsl_mc_io *mc_io,
+				       uint32_t cmd_flags,
+				       uint16_t token,
+				       const struct dpdmux_rule_cfg_v10 *rule);
+
 #endif /* __FSL_DPDMUX_H */
@@ -54,6 +54,12 @@
 #define DPDMUX_CMDID_GET_IRQ_MASK		DPDMUX_CMD(0x015)
 #define DPDMUX_CMDID_GET_IRQ_STATUS		DPDMUX_CMD(0x016)
 
+#define DPDMUX_CMDID_IF_ADD_L2_RULE		DPDMUX_CMD(0x0b0)
+#define DPDMUX_CMDID_IF_REMOVE_L2_RULE		DPDMUX_CMD(0x0b1)
+#define DPDMUX_CMDID_SET_CUSTOM_KEY		DPDMUX_CMD(0x0b5)
+#define DPDMUX_CMDID_ADD_CUSTOM_CLS_ENTRY	DPDMUX_CMD(0x0b6)
+#define DPDMUX_CMDID_REMOVE_CUSTOM_CLS_ENTRY	DPDMUX_CMD(0x0b7)
+
 #define DPDMUX_MASK(field)        \
 	GENMASK(DPDMUX_##field##_SHIFT + DPDMUX_##field##_SIZE - 1, \
 		DPDMUX_##field##_SHIFT)
@@ -123,5 +129,35 @@ struct dpdmux_rsp_get_api_version {
 	uint16_t minor;
 };
 
+struct dpdmux_cmd_if_l2_rule {
+	uint16_t if_id;
+	uint8_t mac_addr[6];
+
+	uint32_t pad;
+	uint16_t vlan_id;
+};
+
+struct dpdmux_set_custom_key {
+	uint64_t pad[6];
+	uint64_t key_cfg_iova;
+};
+
+struct dpdmux_cmd_add_custom_cls_entry {
+	uint8_t pad[3];
+	uint8_t key_size;
+	uint16_t pad1;
+	uint16_t dest_if;
+	uint64_t key_iova;
+	uint64_t mask_iova;
+};
+
+struct dpdmux_cmd_remove_custom_cls_entry {
+	uint8_t pad[3];
+	uint8_t key_size;
+	uint32_t pad1;
+	uint64_t key_iova;
+	uint64_t mask_iova;
+};
+
 #pragma pack(pop)
 #endif /* _FSL_DPDMUX_CMD_H */
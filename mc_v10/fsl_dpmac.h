@@ -61,6 +61,23 @@ int dpmac_destroy_v10(struct fsl_mc_io *mc_io,
 		      uint32_t cmd_flags,
 		      uint32_t object_id);
 
+/**
+ * DPMAC IRQ Index and Events
+ */
+
+/**
+ * IRQ index
+ */
+#define DPMAC_IRQ_INDEX				0
+/**
+ * IRQ event - indicates a change in link state
+ */
+#define DPMAC_IRQ_EVENT_LINK_CFG_REQ		0x00000001
+/**
+ * IRQ event - Indicates that the link state changed
+ */
+#define DPMAC_IRQ_EVENT_LINK_CHANGED		0x00000002
+
 int dpmac_get_irq_mask_v10(struct fsl_mc_io *mc_io,
 			   uint32_t cmd_flags,
 			   uint16_t token,
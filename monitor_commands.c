@@ -0,0 +1,650 @@
+/* Copyright 2018 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <assert.h>
+#include <getopt.h>
+#include <signal.h>
+#include <time.h>
+#include "restool.h"
+#include "utils.h"
+#include "mc_v10/fsl_dprc.h"
+#include "mc_v10/fsl_dpni.h"
+#include "mc_v10/fsl_dpmac.h"
+
+#define MONITOR_DEFAULT_INTERVAL_MS	1000
+#define MONITOR_DEFAULT_RESYNC		10
+#define MONITOR_MAX_INTERVAL_MS		3600000
+
+/**
+ * monitor command options
+ */
+enum monitor_options {
+	MONITOR_OPT_HELP = 0,
+	MONITOR_OPT_INTERVAL,
+	MONITOR_OPT_COUNT,
+	MONITOR_OPT_RESYNC,
+};
+
+static struct option monitor_options[] = {
+	[MONITOR_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[MONITOR_OPT_INTERVAL] = {
+		.name = "interval",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[MONITOR_OPT_COUNT] = {
+		.name = "count",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[MONITOR_OPT_RESYNC] = {
+		.name = "resync",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(monitor_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * Object tracked by the monitor. Handles of containers, DPNIs and DPMACs
+ * are kept open for the whole session so that polling only costs the
+ * IRQ status reads.
+ */
+struct monitor_obj {
+	char type[OBJ_TYPE_MAX_LENGTH + 1];
+	int id;
+	uint32_t parent_dprc_id;
+	uint32_t state;
+	/* -1 unknown/not applicable, 0 link down, 1 link up */
+	int link;
+	uint16_t handle;
+	bool seen;
+	bool gone;
+};
+
+static __thread struct monitor_obj *monitor_objs;
+static __thread int monitor_num_objs;
+static __thread int monitor_max_objs;
+
+static void monitor_event(const struct monitor_obj *obj, const char *event)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_REALTIME, &now);
+	if (output_is_json()) {
+		output_begin_object(NULL);
+		output_field("timestamp", "timestamp", "%ld.%03ld",
+			     (long)now.tv_sec, now.tv_nsec / 1000000);
+		output_field("object", "object", "%s.%d", obj->type, obj->id);
+		output_field("event", "event", "%s", event);
+		output_end_object();
+	} else {
+		output_printf("%ld.%03ld %s.%d %s\n", (long)now.tv_sec,
+			      now.tv_nsec / 1000000, obj->type, obj->id,
+			      event);
+	}
+	output_flush();
+}
+
+static int monitor_get_obj_count(struct restool *ctx, uint16_t dprc_handle,
+				 int *num_child_devices)
+{
+	int error;
+
+	error = dprc_get_obj_count(&ctx->mc_io, ctx->cmd_flags, dprc_handle,
+				   num_child_devices);
+	if (error < 0) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+	}
+
+	return error;
+}
+
+static struct monitor_obj *monitor_find(const char *type, int id)
+{
+	for (int i = 0; i < monitor_num_objs; i++) {
+		if (monitor_objs[i].id == id && !monitor_objs[i].gone &&
+		    strcmp(monitor_objs[i].type, type) == 0)
+			return &monitor_objs[i];
+	}
+
+	return NULL;
+}
+
+static int monitor_read_link(struct restool *ctx, struct monitor_obj *obj)
+{
+	int error = 0;
+
+	if (strcmp(obj->type, "dpni") == 0) {
+		struct dpni_link_state_v10 link_state;
+
+		memset(&link_state, 0, sizeof(link_state));
+		error = dpni_get_link_state_v10(&ctx->mc_io, ctx->cmd_flags,
+						obj->handle, &link_state);
+		if (error == 0)
+			obj->link = link_state.up ? 1 : 0;
+	} else if (strcmp(obj->type, "dpmac") == 0) {
+		struct dprc_endpoint endpoint1;
+		struct dprc_endpoint endpoint2;
+		int state = -1;
+
+		memset(&endpoint1, 0, sizeof(struct dprc_endpoint));
+		memset(&endpoint2, 0, sizeof(struct dprc_endpoint));
+		strcpy(endpoint1.type, "dpmac");
+		endpoint1.id = obj->id;
+
+		error = dprc_get_connection(&ctx->mc_io, ctx->cmd_flags,
+					    ctx->root_dprc_handle,
+					    &endpoint1, &endpoint2, &state);
+		if (error == 0)
+			obj->link = state == 1 ? 1 : 0;
+	}
+
+	if (error < 0) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+	}
+
+	return error;
+}
+
+static int monitor_open(struct restool *ctx, struct monitor_obj *obj)
+{
+	int error = 0;
+
+	if (strcmp(obj->type, "dprc") == 0)
+		error = dprc_open(&ctx->mc_io, ctx->cmd_flags, obj->id,
+				  &obj->handle);
+	else if (strcmp(obj->type, "dpni") == 0)
+		error = dpni_open_v10(&ctx->mc_io, ctx->cmd_flags, obj->id,
+				      &obj->handle);
+	else if (strcmp(obj->type, "dpmac") == 0)
+		error = dpmac_open_v10(&ctx->mc_io, ctx->cmd_flags, obj->id,
+				       &obj->handle);
+
+	if (error < 0) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		obj->handle = 0;
+		return error;
+	}
+
+	if (obj->handle == 0)
+		return 0;
+
+	if (strcmp(obj->type, "dprc") == 0)
+		return 0;
+
+	return monitor_read_link(ctx, obj);
+}
+
+static void monitor_close(struct restool *ctx, struct monitor_obj *obj)
+{
+	if (obj->handle == 0)
+		return;
+
+	/*
+	 * The object may already be destroyed, so close errors are ignored
+	 */
+	if (strcmp(obj->type, "dprc") == 0)
+		(void)dprc_close(&ctx->mc_io, ctx->cmd_flags, obj->handle);
+	else if (strcmp(obj->type, "dpni") == 0)
+		(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags, obj->handle);
+	else if (strcmp(obj->type, "dpmac") == 0)
+		(void)dpmac_close_v10(&ctx->mc_io, ctx->cmd_flags, obj->handle);
+
+	obj->handle = 0;
+}
+
+static struct monitor_obj *monitor_add(struct restool *ctx,
+				       uint32_t parent_dprc_id,
+				       struct dprc_obj_desc *obj_desc)
+{
+	struct monitor_obj *obj;
+
+	if (monitor_num_objs == monitor_max_objs) {
+		int max_objs = monitor_max_objs ? monitor_max_objs * 2 : 64;
+
+		obj = realloc(monitor_objs, max_objs * sizeof(*obj));
+		if (obj == NULL) {
+			ERROR_PRINTF("realloc() failed\n");
+			return NULL;
+		}
+
+		monitor_objs = obj;
+		monitor_max_objs = max_objs;
+	}
+
+	obj = &monitor_objs[monitor_num_objs++];
+	memset(obj, 0, sizeof(*obj));
+	strncpy(obj->type, obj_desc->type, OBJ_TYPE_MAX_LENGTH);
+	obj->id = obj_desc->id;
+	obj->parent_dprc_id = parent_dprc_id;
+	obj->state = obj_desc->state;
+	obj->link = -1;
+	obj->seen = true;
+
+	/*
+	 * A failure to open is not fatal, the object is still tracked
+	 * for plug state and removal events
+	 */
+	(void)monitor_open(ctx, obj);
+
+	return obj;
+}
+
+static int monitor_add_cb(struct restool *ctx, uint32_t parent_dprc_id,
+			  uint16_t parent_dprc_handle,
+			  struct dprc_obj_desc *obj_desc,
+			  void *arg)
+{
+	(void)parent_dprc_handle;
+	(void)arg;
+
+	return monitor_add(ctx, parent_dprc_id, obj_desc) ? 0 : -ENOMEM;
+}
+
+static void monitor_remove(struct restool *ctx, struct monitor_obj *obj)
+{
+	uint32_t dprc_id = obj->id;
+	bool is_dprc = strcmp(obj->type, "dprc") == 0;
+
+	monitor_close(ctx, obj);
+	obj->gone = true;
+	monitor_event(obj, "removed");
+
+	if (!is_dprc)
+		return;
+
+	for (int i = 0; i < monitor_num_objs; i++) {
+		if (!monitor_objs[i].gone &&
+		    monitor_objs[i].parent_dprc_id == dprc_id)
+			monitor_remove(ctx, &monitor_objs[i]);
+	}
+}
+
+static int monitor_scan_dprc(struct restool *ctx, uint32_t dprc_id,
+			     uint16_t dprc_handle)
+{
+	int num_child_devices;
+	int first_new = monitor_num_objs;
+	int error;
+
+	error = monitor_get_obj_count(ctx, dprc_handle, &num_child_devices);
+	if (error < 0)
+		return error;
+
+	for (int i = 0; i < monitor_num_objs; i++) {
+		if (monitor_objs[i].parent_dprc_id == dprc_id)
+			monitor_objs[i].seen = false;
+	}
+
+	for (int i = 0; i < num_child_devices; i++) {
+		struct dprc_obj_desc obj_desc;
+		struct monitor_obj *obj;
+
+		error = dprc_get_obj(&ctx->mc_io, ctx->cmd_flags, dprc_handle,
+				     i,
+				     &obj_desc);
+		if (error < 0) {
+			DEBUG_PRINTF(
+				"dprc_get_object(%u) failed with error %d\n",
+				i, error);
+			return error;
+		}
+
+		obj = monitor_find(obj_desc.type, obj_desc.id);
+		if (obj == NULL) {
+			obj = monitor_add(ctx, dprc_id, &obj_desc);
+			if (obj == NULL)
+				return -ENOMEM;
+
+			monitor_event(obj, "added");
+			continue;
+		}
+
+		obj->seen = true;
+		if ((obj->state ^ obj_desc.state) & DPRC_OBJ_STATE_PLUGGED)
+			monitor_event(obj,
+				      (obj_desc.state & DPRC_OBJ_STATE_PLUGGED) ?
+				      "plugged" : "unplugged");
+		obj->state = obj_desc.state;
+	}
+
+	for (int i = 0; i < first_new; i++) {
+		if (!monitor_objs[i].seen && !monitor_objs[i].gone &&
+		    monitor_objs[i].parent_dprc_id == dprc_id)
+			monitor_remove(ctx, &monitor_objs[i]);
+	}
+
+	/*
+	 * Child containers created since the last poll are scanned right
+	 * away, their objects would otherwise go unreported
+	 */
+	for (int i = first_new; i < monitor_num_objs; i++) {
+		if (strcmp(monitor_objs[i].type, "dprc") == 0 &&
+		    monitor_objs[i].handle != 0) {
+			error = monitor_scan_dprc(ctx, monitor_objs[i].id,
+						  monitor_objs[i].handle);
+			if (error < 0)
+				return error;
+		}
+	}
+
+	return 0;
+}
+
+static int monitor_check_link(struct restool *ctx, struct monitor_obj *obj,
+			      bool resync)
+{
+	uint32_t status = 0;
+	int prev_link = obj->link;
+	int error;
+
+	if (!resync) {
+		if (strcmp(obj->type, "dpni") == 0) {
+			error = dpni_get_irq_status_v10(&ctx->mc_io,
+							ctx->cmd_flags,
+							obj->handle,
+							DPNI_IRQ_INDEX,
+							&status);
+			status &= DPNI_IRQ_EVENT_LINK_CHANGED;
+		} else {
+			error = dpmac_get_irq_status_v10(&ctx->mc_io,
+							 ctx->cmd_flags,
+							 obj->handle,
+							 DPMAC_IRQ_INDEX,
+							 &status);
+			status &= DPMAC_IRQ_EVENT_LINK_CHANGED;
+		}
+
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			return error;
+		}
+
+		if (status == 0)
+			return 0;
+	}
+
+	error = monitor_read_link(ctx, obj);
+	if (error < 0)
+		return error;
+
+	if (obj->link != prev_link)
+		monitor_event(obj, obj->link ? "link up" : "link down");
+
+	return 0;
+}
+
+/**
+ * Rescans a container when its IRQ status is set. The status bits are
+ * only read, never cleared, since they belong to the kernel drivers.
+ */
+static int monitor_check_dprc(struct restool *ctx, uint32_t dprc_id,
+			      uint16_t dprc_handle, bool resync)
+{
+	uint32_t status = 0;
+	int error;
+
+	if (!resync) {
+		error = dprc_get_irq_status(&ctx->mc_io, ctx->cmd_flags,
+					    dprc_handle, DPRC_IRQ_INDEX,
+					    &status);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			return error;
+		}
+
+		if (status == 0)
+			return 0;
+	}
+
+	return monitor_scan_dprc(ctx, dprc_id, dprc_handle);
+}
+
+/**
+ * Runs one polling pass, which only reads the IRQ status registers; a
+ * link or container is re-read when its status is set. The kernel
+ * drivers may clear a status before the monitor sees it, so a resync
+ * pass re-reads everything regardless. Events are emitted on actual
+ * state changes.
+ */
+static int monitor_poll(struct restool *ctx, uint32_t dprc_id,
+			uint16_t dprc_handle, bool resync)
+{
+	int num_objs;
+	int error;
+
+	error = monitor_check_dprc(ctx, dprc_id, dprc_handle, resync);
+	if (error < 0)
+		return error;
+
+	/*
+	 * Objects added by a rescan are already up to date
+	 */
+	num_objs = monitor_num_objs;
+	for (int i = 0; i < num_objs; i++) {
+		struct monitor_obj *obj = &monitor_objs[i];
+
+		if (obj->gone || obj->handle == 0)
+			continue;
+
+		if (strcmp(obj->type, "dprc") == 0)
+			error = monitor_check_dprc(ctx, obj->id, obj->handle,
+						   resync);
+		else
+			error = monitor_check_link(ctx, obj, resync);
+		if (error < 0)
+			return error;
+	}
+
+	/*
+	 * Drop the objects removed during this pass
+	 */
+	num_objs = 0;
+	for (int i = 0; i < monitor_num_objs; i++) {
+		if (!monitor_objs[i].gone)
+			monitor_objs[num_objs++] = monitor_objs[i];
+	}
+	monitor_num_objs = num_objs;
+
+	return 0;
+}
+
+static int cmd_monitor(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool monitor [<container>] [--interval=<ms>] [--count=<n>]\n"
+		"                       [--resync=<n>]\n"
+		"\n"
+		"Watches <container> (root container by default) and its child\n"
+		"containers, printing a line each time a link goes up or down, an\n"
+		"object is plugged or unplugged, or an object is added or removed:\n"
+		"   <seconds.milliseconds> <object> <event>\n"
+		"\n"
+		"OPTIONS:\n"
+		"--interval=<ms>\n"
+		"   Polling period in milliseconds. Default is 1000.\n"
+		"--count=<n>\n"
+		"   Stop after <n> polls. Default is to run until interrupted.\n"
+		"--resync=<n>\n"
+		"   Re-read the full state every <n> polls, regardless of the IRQ\n"
+		"   status registers, which the kernel drivers may clear first.\n"
+		"   Default is 10, 0 disables it.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Report link changes under dprc.2 every 200ms:\n"
+		"   $ restool monitor dprc.2 --interval=200\n"
+		"\n";
+
+	long interval_ms = MONITOR_DEFAULT_INTERVAL_MS;
+	long count = 0;
+	long resync = MONITOR_DEFAULT_RESYNC;
+	sigset_t old_mask;
+	struct timespec period;
+	uint32_t dprc_id;
+	uint16_t dprc_handle;
+	bool dprc_opened = false;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(MONITOR_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(MONITOR_OPT_HELP);
+		return 0;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(MONITOR_OPT_INTERVAL)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(MONITOR_OPT_INTERVAL);
+		error = get_option_value(ctx, MONITOR_OPT_INTERVAL,
+					 &interval_ms,
+					 "Invalid interval value",
+					 1, MONITOR_MAX_INTERVAL_MS);
+		if (error)
+			return -EINVAL;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(MONITOR_OPT_COUNT)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(MONITOR_OPT_COUNT);
+		error = get_option_value(ctx, MONITOR_OPT_COUNT, &count,
+					 "Invalid count value", 1, LONG_MAX);
+		if (error)
+			return -EINVAL;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(MONITOR_OPT_RESYNC)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(MONITOR_OPT_RESYNC);
+		error = get_option_value(ctx, MONITOR_OPT_RESYNC, &resync,
+					 "Invalid resync value", 0, LONG_MAX);
+		if (error)
+			return -EINVAL;
+	}
+
+	dprc_id = ctx->root_dprc_id;
+	dprc_handle = ctx->root_dprc_handle;
+	if (ctx->obj_name != NULL) {
+		error = parse_object_name(ctx->obj_name, "dprc", &dprc_id);
+		if (error < 0)
+			return error;
+
+		if (dprc_id != ctx->root_dprc_id) {
+			error = open_dprc(ctx, dprc_id, &dprc_handle);
+			if (error < 0)
+				return error;
+			dprc_opened = true;
+		}
+	}
+
+	error = walk_dprc_tree(ctx, dprc_id, dprc_handle, 0, monitor_add_cb,
+			       NULL);
+	if (error < 0)
+		goto out;
+
+	block_stop_signals(&old_mask);
+
+	period.tv_sec = interval_ms / 1000;
+	period.tv_nsec = (interval_ms % 1000) * 1000000;
+
+	output_begin_array("events");
+	for (long polls = 1; ; polls++) {
+		if (wait_stop(ctx, &period))
+			break;
+
+		error = monitor_poll(ctx, dprc_id, dprc_handle,
+				     resync != 0 && polls % resync == 0);
+		if (error < 0)
+			break;
+
+		if (count != 0 && polls >= count)
+			break;
+	}
+	output_end_array();
+
+	unblock_stop_signals(ctx, &old_mask);
+	if (error < 0)
+		goto out;
+
+	error = 0;
+out:
+	for (int i = 0; i < monitor_num_objs; i++)
+		monitor_close(ctx, &monitor_objs[i]);
+	free(monitor_objs);
+	monitor_objs = NULL;
+	monitor_num_objs = 0;
+	monitor_max_objs = 0;
+
+	if (dprc_opened)
+		(void)dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
+
+	return error;
+}
+
+struct object_command monitor_commands[] = {
+	{ .cmd_name = "monitor",
+	  .options = monitor_options,
+	  .cmd_func = cmd_monitor,
+	  .priority = CMD_PRIORITY_HIGH },
+
+	{ .cmd_name = NULL },
+};
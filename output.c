@@ -0,0 +1,518 @@
+/* Copyright 2018 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <errno.h>
+#include <assert.h>
+#include <unistd.h>
+#include "restool.h"
+#include "utils.h"
+
+/**
+ * Initial size of the output buffer, it grows as needed
+ */
+#define OUTPUT_BUF_SIZE		4096
+
+/**
+ * Past this size the buffer is written out even before output_finish()
+ */
+#define OUTPUT_FLUSH_SIZE	(1024 * 1024)
+
+/**
+ * Maximum nesting of JSON objects and arrays, including the root object.
+ * list_dprc() nests two levels per container.
+ */
+#define OUTPUT_MAX_DEPTH	(2 * MAX_DPRC_NESTING + 8)
+
+static __thread struct {
+	enum output_format format;
+	char *buf;
+	size_t len;
+	size_t size;
+
+	/**
+	 * JSON state: the root object is opened by the first element, and
+	 * for each open level we track whether it is an array and whether
+	 * it still has no element (to place the commas).
+	 */
+	bool started;
+	int depth;
+	bool in_array[OUTPUT_MAX_DEPTH];
+	bool empty[OUTPUT_MAX_DEPTH];
+} output;
+
+static void output_write(const char *data, size_t len)
+{
+	ssize_t n;
+
+	while (len > 0) {
+		n = write(STDOUT_FILENO, data, len);
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+
+			DEBUG_PRINTF("write() failed: %s\n", strerror(errno));
+			return;
+		}
+
+		data += n;
+		len -= n;
+	}
+}
+
+void output_flush(void)
+{
+	/* keep the order with anything still printed through stdio */
+	fflush(stdout);
+	if (output.len == 0)
+		return;
+
+	output_write(output.buf, output.len);
+	output.len = 0;
+}
+
+static bool output_reserve(size_t len)
+{
+	size_t size;
+	char *buf;
+
+	if (output.len + len <= output.size)
+		return true;
+
+	size = output.size != 0 ? output.size : OUTPUT_BUF_SIZE;
+	while (size < output.len + len)
+		size *= 2;
+
+	buf = realloc(output.buf, size);
+	if (buf == NULL)
+		return false;
+
+	output.buf = buf;
+	output.size = size;
+	return true;
+}
+
+static void output_append(const char *data, size_t len)
+{
+	if (!output_reserve(len)) {
+		output_flush();
+		output_write(data, len);
+		return;
+	}
+
+	memcpy(output.buf + output.len, data, len);
+	output.len += len;
+}
+
+static void output_puts(const char *str)
+{
+	output_append(str, strlen(str));
+}
+
+static void output_vappend(const char *fmt, va_list ap)
+{
+	char small[256];
+	va_list ap2;
+	int len;
+
+	va_copy(ap2, ap);
+	len = vsnprintf(small, sizeof(small), fmt, ap2);
+	va_end(ap2);
+	if (len < 0)
+		return;
+
+	if ((size_t)len < sizeof(small)) {
+		output_append(small, len);
+		return;
+	}
+
+	if (!output_reserve(len + 1)) {
+		output_flush();
+		vfprintf(stdout, fmt, ap);
+		fflush(stdout);
+		return;
+	}
+
+	vsnprintf(output.buf + output.len, len + 1, fmt, ap);
+	output.len += len;
+}
+
+static void output_check_size(void)
+{
+	if (output.len >= OUTPUT_FLUSH_SIZE)
+		output_flush();
+}
+
+int output_set_format(const char *name)
+{
+	if (strcmp(name, "text") == 0) {
+		output.format = OUTPUT_TEXT;
+	} else if (strcmp(name, "json") == 0) {
+		output.format = OUTPUT_JSON;
+	} else {
+		ERROR_PRINTF("Invalid output format: \'%s\'\n"
+			     "Valid formats: text, json\n", name);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+bool output_is_json(void)
+{
+	return output.format == OUTPUT_JSON;
+}
+
+static void json_string(const char *str)
+{
+	char esc[8];
+
+	output_puts("\"");
+	for (; *str != '\0'; str++) {
+		unsigned char c = *str;
+
+		if (c == '"' || c == '\\') {
+			esc[0] = '\\';
+			esc[1] = c;
+			output_append(esc, 2);
+		} else if (c == '\n') {
+			output_puts("\\n");
+		} else if (c == '\t') {
+			output_puts("\\t");
+		} else if (c < 0x20) {
+			snprintf(esc, sizeof(esc), "\\u%04x", c);
+			output_puts(esc);
+		} else {
+			output_append((const char *)&c, 1);
+		}
+	}
+	output_puts("\"");
+}
+
+/**
+ * Key of a field whose label is only known at run time, such as a counter
+ * name from a table: the label lowercased, other characters folded to '_'
+ */
+static void json_label_key(const char *label)
+{
+	char key[64];
+	unsigned int len = 0;
+
+	for (; *label != '\0' && len < sizeof(key) - 1; label++) {
+		if (isalnum((unsigned char)*label))
+			key[len++] = tolower((unsigned char)*label);
+		else if (len > 0 && key[len - 1] != '_')
+			key[len++] = '_';
+	}
+
+	while (len > 0 && key[len - 1] == '_')
+		len--;
+	key[len] = '\0';
+
+	json_string(key);
+	output_puts(":");
+}
+
+/**
+ * Opens the root object if needed and places the comma before a new
+ * element of the current level, then its key when the level is an object
+ */
+static void json_begin_element(const char *key, const char *label)
+{
+	if (!output.started) {
+		output_puts("{");
+		output.started = true;
+		output.depth = 0;
+		output.in_array[0] = false;
+		output.empty[0] = true;
+	}
+
+	if (!output.empty[output.depth])
+		output_puts(",");
+	output.empty[output.depth] = false;
+
+	if (output.in_array[output.depth])
+		return;
+
+	if (key != NULL) {
+		json_string(key);
+		output_puts(":");
+	} else {
+		json_label_key(label != NULL ? label : "value");
+	}
+}
+
+static void json_push(bool in_array)
+{
+	assert(output.depth + 1 < OUTPUT_MAX_DEPTH);
+	output.depth++;
+	output.in_array[output.depth] = in_array;
+	output.empty[output.depth] = true;
+	output_puts(in_array ? "[" : "{");
+}
+
+static void json_pop(void)
+{
+	assert(output.started && output.depth > 0);
+	output_puts(output.in_array[output.depth] ? "]" : "}");
+	output.depth--;
+}
+
+void output_printf(const char *fmt, ...)
+{
+	va_list ap;
+
+	if (output.format == OUTPUT_JSON)
+		return;
+
+	va_start(ap, fmt);
+	output_vappend(fmt, ap);
+	va_end(ap);
+	output_check_size();
+}
+
+/**
+ * Messages restool always printed on stdout, where scripts look for them,
+ * such as "dpni.7 does not exist". In JSON mode they go to stderr so that
+ * stdout holds nothing but the JSON document.
+ */
+void output_notice(const char *fmt, ...)
+{
+	va_list ap;
+
+	va_start(ap, fmt);
+	if (output.format == OUTPUT_JSON) {
+		output_flush();
+		vfprintf(stderr, fmt, ap);
+	} else {
+		output_vappend(fmt, ap);
+		output_check_size();
+	}
+	va_end(ap);
+}
+
+static void output_value(const char *key, const char *label,
+			 const char *fmt, va_list ap)
+{
+	char small[256];
+	char *value = small;
+	va_list ap2;
+	int len;
+
+	va_copy(ap2, ap);
+	len = vsnprintf(small, sizeof(small), fmt, ap2);
+	va_end(ap2);
+	if (len < 0)
+		return;
+
+	if ((size_t)len >= sizeof(small)) {
+		value = malloc(len + 1);
+		if (value == NULL)
+			return;
+
+		vsnprintf(value, len + 1, fmt, ap);
+	}
+
+	json_begin_element(key, label);
+	json_string(value);
+
+	if (value != small)
+		free(value);
+}
+
+void output_field(const char *key, const char *label, const char *fmt, ...)
+{
+	va_list ap;
+
+	va_start(ap, fmt);
+	if (output.format == OUTPUT_JSON) {
+		output_value(key, label, fmt, ap);
+	} else {
+		output_puts(label);
+		output_puts(": ");
+		output_vappend(fmt, ap);
+		output_puts("\n");
+	}
+	va_end(ap);
+	output_check_size();
+}
+
+/**
+ * A number field, text is how text mode prints it
+ */
+static void output_number(const char *key, const char *label,
+			  const char *text, const char *number)
+{
+	if (output.format == OUTPUT_JSON) {
+		json_begin_element(key, label);
+		output_puts(number);
+	} else {
+		output_puts(label);
+		output_puts(": ");
+		output_puts(text);
+		output_puts("\n");
+	}
+	output_check_size();
+}
+
+void output_uint(const char *key, const char *label, uint64_t value)
+{
+	char number[24];
+
+	snprintf(number, sizeof(number), "%llu", (unsigned long long)value);
+	output_number(key, label, number, number);
+}
+
+void output_int(const char *key, const char *label, int64_t value)
+{
+	char number[24];
+
+	snprintf(number, sizeof(number), "%lld", (long long)value);
+	output_number(key, label, number, number);
+}
+
+void output_hex(const char *key, const char *label, uint64_t value)
+{
+	char text[24];
+	char number[24];
+
+	snprintf(text, sizeof(text), "%#llx", (unsigned long long)value);
+	snprintf(number, sizeof(number), "%llu", (unsigned long long)value);
+	output_number(key, label, text, number);
+}
+
+void output_bool(const char *key, const char *label, bool value,
+		 const char *fmt, ...)
+{
+	va_list ap;
+
+	if (output.format == OUTPUT_JSON) {
+		json_begin_element(key, label);
+		output_puts(value ? "true" : "false");
+		return;
+	}
+
+	va_start(ap, fmt);
+	output_puts(label);
+	output_puts(": ");
+	output_vappend(fmt, ap);
+	output_puts("\n");
+	va_end(ap);
+	output_check_size();
+}
+
+void output_item(const char *fmt, ...)
+{
+	va_list ap;
+
+	va_start(ap, fmt);
+	if (output.format == OUTPUT_JSON) {
+		output_value(NULL, NULL, fmt, ap);
+	} else {
+		output_puts("\t");
+		output_vappend(fmt, ap);
+		output_puts("\n");
+	}
+	va_end(ap);
+	output_check_size();
+}
+
+void output_item_int(int64_t value)
+{
+	char number[24];
+
+	snprintf(number, sizeof(number), "%lld", (long long)value);
+	if (output.format == OUTPUT_JSON) {
+		json_begin_element(NULL, NULL);
+		output_puts(number);
+	} else {
+		output_puts("\t");
+		output_puts(number);
+		output_puts("\n");
+	}
+	output_check_size();
+}
+
+void output_begin_object(const char *key)
+{
+	if (output.format != OUTPUT_JSON)
+		return;
+
+	json_begin_element(key, NULL);
+	json_push(false);
+}
+
+void output_end_object(void)
+{
+	if (output.format == OUTPUT_JSON)
+		json_pop();
+}
+
+void output_begin_array(const char *key)
+{
+	if (output.format != OUTPUT_JSON)
+		return;
+
+	json_begin_element(key, NULL);
+	json_push(true);
+}
+
+void output_end_array(void)
+{
+	if (output.format == OUTPUT_JSON)
+		json_pop();
+}
+
+/**
+ * Closes the JSON document, including any level left open by a command
+ * that failed half way, and writes out the buffer. The next request on
+ * this thread starts over in text format.
+ */
+void output_finish(void)
+{
+	if (output.format == OUTPUT_JSON && output.started) {
+		while (output.depth > 0)
+			json_pop();
+		output_puts("}\n");
+		output.started = false;
+	}
+
+	output_flush();
+	free(output.buf);
+	output.buf = NULL;
+	output.len = 0;
+	output.size = 0;
+	output.format = OUTPUT_TEXT;
+}
@@ -0,0 +1,87 @@
+/* Copyright 2018 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _OUTPUT_H_
+#define _OUTPUT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Buffered writer for command output. Text and JSON output both go
+ * through it, and the buffer reaches stdout with a single write() when
+ * output_finish() runs at exit, or earlier with output_flush().
+ *
+ * In text mode output_field() prints "<label>: <value>", output_item()
+ * prints "\t<value>" and the object/array calls print nothing. In JSON
+ * mode output_printf() text is dropped and fields are written under their
+ * snake_case key, which stays the same when the text label changes. A NULL
+ * key is derived from the label (lowercase, other characters folded to
+ * '_'), for labels that come from tables such as counter names.
+ * output_field() and output_item() values are always JSON strings, labels
+ * and names that look like numbers included; output_uint(), output_int()
+ * and output_hex() values are JSON numbers (output_hex() prints "%#llx" in
+ * text mode) and output_bool() values are true or false.
+ */
+enum output_format {
+	OUTPUT_TEXT = 0,
+	OUTPUT_JSON,
+};
+
+int output_set_format(const char *name);
+bool output_is_json(void);
+
+void output_printf(const char *fmt, ...)
+	__attribute__((format(printf, 1, 2)));
+void output_notice(const char *fmt, ...)
+	__attribute__((format(printf, 1, 2)));
+void output_field(const char *key, const char *label, const char *fmt, ...)
+	__attribute__((format(printf, 3, 4)));
+void output_uint(const char *key, const char *label, uint64_t value);
+void output_int(const char *key, const char *label, int64_t value);
+void output_hex(const char *key, const char *label, uint64_t value);
+void output_bool(const char *key, const char *label, bool value,
+		 const char *fmt, ...)
+	__attribute__((format(printf, 4, 5)));
+void output_item(const char *fmt, ...)
+	__attribute__((format(printf, 1, 2)));
+void output_item_int(int64_t value);
+
+void output_begin_object(const char *key);
+void output_end_object(void);
+void output_begin_array(const char *key);
+void output_end_array(void);
+
+void output_flush(void);
+void output_finish(void);
+
+#endif /* _OUTPUT_H_ */
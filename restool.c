@@ -38,9 +38,14 @@
 #include <errno.h>
 #include <assert.h>
 #include <getopt.h>
+#include <unistd.h>
 #include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <pthread.h>
 #include "restool.h"
 #include "utils.h"
+#include "dispatch.h"
 
 static struct option global_options[] = {
 	[GLOBAL_OPT_HELP] = {
@@ -74,6 +79,35 @@ static struct option global_options[] = {
 		.has_arg = optional_argument,
 	},
 
+	[GLOBAL_OPT_OUTPUT] = {
+		.name = "output",
+		.val = 'o',
+		.has_arg = required_argument,
+	},
+
+	[GLOBAL_OPT_TRACE] = {
+		.name = "trace",
+		.val = 't',
+		.has_arg = required_argument,
+	},
+
+	[GLOBAL_OPT_RETRY_WAIT] = {
+		.name = "retry-wait",
+		.val = 'w',
+		.has_arg = required_argument,
+	},
+
+	[GLOBAL_OPT_PRIORITY] = {
+		.name = "priority",
+		.val = 'p',
+		.has_arg = required_argument,
+	},
+
+	[GLOBAL_OPT_DMA_PHYS] = {
+		.name = "dma-phys",
+		.val = 'y',
+	},
+
 	{ 0 },
 };
 
@@ -159,7 +193,27 @@ static const struct obj_command_versions dpdmai_command_versions[] = {
 	{ .version = 0, .obj_commands = NULL },
 };
 
-static const struct object_cmd_parser object_cmd_parsers[] = {
+static const struct obj_command_versions monitor_command_versions[] = {
+	{ .version = 1, .obj_commands = monitor_commands },
+	{ .version = 0, .obj_commands = NULL },
+};
+
+static const struct obj_command_versions top_command_versions[] = {
+	{ .version = 1, .obj_commands = top_commands },
+	{ .version = 0, .obj_commands = NULL },
+};
+
+static const struct obj_command_versions stats_command_versions[] = {
+	{ .version = 1, .obj_commands = stats_commands },
+	{ .version = 0, .obj_commands = NULL },
+};
+
+/*
+ * The object and command tables are not walked at run time: the build
+ * turns them into the perfect hash table of dispatch.h, see
+ * scripts/gen-dispatch.awk
+ */
+const struct object_cmd_parser object_cmd_parsers[] = {
 	{ .obj_type = "dprc",   .obj_commands_versions = dprc_command_versions   },
 	{ .obj_type = "dpni",   .obj_commands_versions = dpni_command_versions   },
 	{ .obj_type = "dpio",   .obj_commands_versions = dpio_command_versions   },
@@ -176,6 +230,11 @@ static const struct object_cmd_parser object_cmd_parsers[] = {
 	{ .obj_type = "dpdbg",  .obj_commands_versions = dpdbg_command_versions },
 	{ .obj_type = "dprtc",  .obj_commands_versions = dprtc_command_versions },
 	{ .obj_type = "dpdmai", .obj_commands_versions = dpdmai_command_versions },
+	{ .obj_type = "monitor", .obj_commands_versions = monitor_command_versions,
+	  .standalone = true },
+	{ .obj_type = "top", .obj_commands_versions = top_command_versions,
+	  .standalone = true },
+	{ .obj_type = "stats", .obj_commands_versions = stats_command_versions },
 };
 /**
  * Individual object structs to hold the mapping of the MC Version
@@ -265,6 +324,18 @@ struct version_table dprtc_version_table[] = {
 	{ .mc_major_version = 10, .object_version = 2 },
 	{ .mc_major_version = 0 }
 };
+struct version_table monitor_version_table[] = {
+	{ .mc_major_version = 10, .object_version = 1 },
+	{ .mc_major_version = 0 }
+};
+struct version_table top_version_table[] = {
+	{ .mc_major_version = 10, .object_version = 1 },
+	{ .mc_major_version = 0 }
+};
+struct version_table stats_version_table[] = {
+	{ .mc_major_version = 10, .object_version = 1 },
+	{ .mc_major_version = 0 }
+};
 
 /**
  * Lookup table used to map a specific MC Version to its corresponding
@@ -287,9 +358,12 @@ struct lut_entry version_lut[] = {
 	{ .object = "dpsw",   .versions_table = dpsw_version_table   },
 	{ .object = "dpdbg",  .versions_table = dpdbg_version_table  },
 	{ .object = "dprtc",  .versions_table = dprtc_version_table  },
+	{ .object = "monitor", .versions_table = monitor_version_table },
+	{ .object = "top",    .versions_table = top_version_table    },
+	{ .object = "stats",  .versions_table = stats_version_table  },
 };
 
-struct restool restool;
+__thread bool restool_debug;
 
 enum mc_cmd_status flib_error_to_mc_status(int error)
 {
@@ -348,7 +422,42 @@ const char *mc_status_to_string(enum mc_cmd_status status)
 	return status_strings[status];
 }
 
-int find_target_obj_desc(uint32_t dprc_id, uint16_t dprc_handle,
+/**
+ * Asks the container open as dprc_handle directly for the descriptor of one
+ * of its objects. Returns false if the object is not there, or if the MC
+ * could not answer; the caller then falls back to scanning the container
+ * with dprc_get_obj().
+ */
+bool get_child_obj_desc(struct restool *ctx, uint16_t dprc_handle,
+			const char *obj_type, uint32_t obj_id,
+			struct dprc_obj_desc *obj_desc)
+{
+	int error;
+
+	if (ctx->no_get_obj_desc)
+		return false;
+
+	error = dprc_get_obj_desc(&ctx->mc_io, ctx->cmd_flags, dprc_handle,
+				  (char *)obj_type, obj_id, obj_desc);
+	if (error == -524) {
+		/* ENOTSUPP: firmware without the command */
+		DEBUG_PRINTF("dprc_get_obj_desc() not supported\n");
+		ctx->no_get_obj_desc = true;
+		return false;
+	}
+
+	if (error < 0) {
+		DEBUG_PRINTF("dprc_get_obj_desc(%s.%u) failed with error %d\n",
+			     obj_type, obj_id, error);
+		return false;
+	}
+
+	return strcmp(obj_desc->type, obj_type) == 0 &&
+	       (uint32_t)obj_desc->id == obj_id;
+}
+
+int find_target_obj_desc(struct restool *ctx, uint32_t dprc_id,
+			 uint16_t dprc_handle,
 			int nesting_level,
 			uint32_t target_id, char *target_type,
 			struct dprc_obj_desc *target_obj_desc,
@@ -360,30 +469,59 @@ int find_target_obj_desc(uint32_t dprc_id, uint16_t dprc_handle,
 	assert(nesting_level <= MAX_DPRC_NESTING);
 
 	if (strcmp(target_type, "dprc") == 0 &&
-	    target_id == restool.root_dprc_id) {
+	    target_id == ctx->root_dprc_id) {
 		DEBUG_PRINTF("This is root dprc.\n");
 		strcpy(target_obj_desc->type, "dprc");
 		target_obj_desc->id = 1;
+		*found = true;
+		return 0;
+	}
+
+	/*
+	 * The container the walk starts from is where callers expect the
+	 * object, it is asked directly before anything else.
+	 */
+	if (nesting_level == 0 &&
+	    get_child_obj_desc(ctx, dprc_handle, target_type, target_id,
+			       target_obj_desc)) {
+		*target_parent_dprc_id = dprc_id;
+		DEBUG_PRINTF("object found in dprc.%u\n", dprc_id);
+		*found = true;
 		return 0;
 	}
 
-	error = dprc_get_obj_count(&restool.mc_io, 0,
+	error = dprc_get_obj_count(&ctx->mc_io, ctx->cmd_flags,
 				   dprc_handle,
 				   &num_child_devices);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
 		goto out;
 	}
 
+	/*
+	 * Below it, a container is only asked when scanning it costs more
+	 * than the one command asking does; a miss is still scanned, to
+	 * find the containers to descend into.
+	 */
+	if (nesting_level > 0 && num_child_devices > 1 &&
+	    get_child_obj_desc(ctx, dprc_handle, target_type, target_id,
+			       target_obj_desc)) {
+		*target_parent_dprc_id = dprc_id;
+		DEBUG_PRINTF("object found in dprc.%u\n", dprc_id);
+		*found = true;
+		return 0;
+	}
+
 	for (int i = 0; i < num_child_devices; i++) {
 		struct dprc_obj_desc obj_desc;
 		uint16_t child_dprc_handle;
 		int error2;
 
 		error = dprc_get_obj(
-				&restool.mc_io, 0,
+				&ctx->mc_io, ctx->cmd_flags,
 				dprc_handle,
 				i,
 				&obj_desc);
@@ -408,13 +546,13 @@ int find_target_obj_desc(uint32_t dprc_id, uint16_t dprc_handle,
 		} else if (strcmp(obj_desc.type, "dprc") == 0) {
 			bool found2 = false;
 
-			error = open_dprc(obj_desc.id, &child_dprc_handle);
+			error = open_dprc(ctx, obj_desc.id, &child_dprc_handle);
 			if (error < 0)
 				goto out;
 
 			DEBUG_PRINTF("entering %s.%u\n", obj_desc.type,
 					obj_desc.id);
-			error = find_target_obj_desc(obj_desc.id,
+			error = find_target_obj_desc(ctx, obj_desc.id,
 					child_dprc_handle,
 					nesting_level + 1,
 					target_id,
@@ -423,12 +561,13 @@ int find_target_obj_desc(uint32_t dprc_id, uint16_t dprc_handle,
 					target_parent_dprc_id,
 					&found2);
 
-			error2 = dprc_close(&restool.mc_io, 0,
+			error2 = dprc_close(&ctx->mc_io, ctx->cmd_flags,
 						child_dprc_handle);
 			if (error2 < 0) {
-				mc_status = flib_error_to_mc_status(error2);
+				ctx->mc_status = flib_error_to_mc_status(error2);
 				ERROR_PRINTF("MC error: %s (status %#x)\n",
-				mc_status_to_string(mc_status), mc_status);
+				mc_status_to_string(ctx->mc_status),
+				ctx->mc_status);
 				if (error == 0)
 					error = error2;
 
@@ -438,7 +577,7 @@ int find_target_obj_desc(uint32_t dprc_id, uint16_t dprc_handle,
 			DEBUG_PRINTF("exiting %s.%u\n", obj_desc.type,
 					obj_desc.id);
 			if (found2) {
-				*found = found;
+				*found = true;
 				goto out;
 			}
 		} else {
@@ -450,7 +589,7 @@ out:
 	return error;
 }
 
-bool find_obj(char *obj_type, uint32_t obj_id)
+bool find_obj(struct restool *ctx, char *obj_type, uint32_t obj_id)
 {
 	struct dprc_obj_desc target_obj_desc;
 	uint32_t target_parent_dprc_id;
@@ -458,90 +597,217 @@ bool find_obj(char *obj_type, uint32_t obj_id)
 	bool found = false;
 
 	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0, obj_id,
+	error = find_target_obj_desc(ctx, ctx->root_dprc_id,
+				ctx->root_dprc_handle, 0, obj_id,
 				obj_type, &target_obj_desc,
 				&target_parent_dprc_id, &found);
 
 	if (!found) {
 		if (error == 0)
-			printf("%s.%u does not exist\n", obj_type, obj_id);
+			output_notice("%s.%u does not exist\n", obj_type, obj_id);
 		return false;
 	}
 
 	return true;
 }
 
-void print_obj_label(struct dprc_obj_desc *target_obj_desc)
+/**
+ * Walks the DPRC tree starting at dprc_id and calls cb for every object,
+ * child containers included. Child containers are opened and closed on the way.
+ */
+int walk_dprc_tree(struct restool *ctx, uint32_t dprc_id, uint16_t dprc_handle,
+		   int nesting_level, walk_obj_cb_t *cb, void *arg)
+{
+	int num_child_devices;
+	int error;
+
+	assert(nesting_level <= MAX_DPRC_NESTING);
+
+	error = dprc_get_obj_count(&ctx->mc_io, ctx->cmd_flags,
+				   dprc_handle,
+				   &num_child_devices);
+	if (error < 0) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		return error;
+	}
+
+	for (int i = 0; i < num_child_devices; i++) {
+		struct dprc_obj_desc obj_desc;
+		uint16_t child_dprc_handle;
+		int error2;
+
+		error = dprc_get_obj(&ctx->mc_io, ctx->cmd_flags,
+				     dprc_handle,
+				     i,
+				     &obj_desc);
+		if (error < 0) {
+			DEBUG_PRINTF(
+				"dprc_get_object(%u) failed with error %d\n",
+				i, error);
+			return error;
+		}
+
+		error = cb(ctx, dprc_id, dprc_handle, &obj_desc, arg);
+		if (error < 0)
+			return error;
+
+		if (strcmp(obj_desc.type, "dprc") != 0)
+			continue;
+
+		error = open_dprc(ctx, obj_desc.id, &child_dprc_handle);
+		if (error < 0)
+			return error;
+
+		error = walk_dprc_tree(ctx, obj_desc.id, child_dprc_handle,
+				       nesting_level + 1, cb, arg);
+
+		error2 = dprc_close(&ctx->mc_io, ctx->cmd_flags,
+				    child_dprc_handle);
+		if (error2 < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error2);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			if (error == 0)
+				error = error2;
+		}
+
+		if (error < 0)
+			return error;
+	}
+
+	return 0;
+}
+
+/**
+ * Long-running commands block SIGINT and SIGTERM in their thread and wait
+ * for them between passes with wait_stop(), rather than installing
+ * process-wide handlers that would outlive the command
+ */
+void block_stop_signals(sigset_t *old_mask)
+{
+	sigset_t stop_signals;
+
+	sigemptyset(&stop_signals);
+	sigaddset(&stop_signals, SIGINT);
+	sigaddset(&stop_signals, SIGTERM);
+	pthread_sigmask(SIG_BLOCK, &stop_signals, old_mask);
+}
+
+void unblock_stop_signals(struct restool *ctx, const sigset_t *old_mask)
+{
+	pthread_sigmask(SIG_SETMASK, old_mask, NULL);
+	/* a stop request only ends the command it reached */
+	ctx->stop = 0;
+}
+
+/**
+ * Sleeps for timeout, returns true early if SIGINT or SIGTERM arrives or
+ * ctx->stop is set
+ */
+bool wait_stop(struct restool *ctx, const struct timespec *timeout)
+{
+	sigset_t stop_signals;
+
+	if (ctx->stop)
+		return true;
+
+	sigemptyset(&stop_signals);
+	sigaddset(&stop_signals, SIGINT);
+	sigaddset(&stop_signals, SIGTERM);
+	if (sigtimedwait(&stop_signals, NULL, timeout) >= 0)
+		return true;
+
+	return ctx->stop != 0;
+}
+
+void print_obj_label(struct restool *ctx, struct dprc_obj_desc *target_obj_desc)
 {
+	if (!INFO_FIELD(LABEL))
+		return;
+
 	assert(strlen(target_obj_desc->label) <= MC_OBJ_LABEL_MAX_LENGTH);
-	if (!(target_obj_desc->id == (int)restool.root_dprc_id &&
+	if (!(target_obj_desc->id == (int)ctx->root_dprc_id &&
 	    strcmp(target_obj_desc->type, "dprc") == 0) &&
 	    strlen(target_obj_desc->label) > 0)
-		printf("object label: %s\n", target_obj_desc->label);
+		output_field("label", "object label",
+			     "%s", target_obj_desc->label);
 }
 
-int print_obj_verbose(struct dprc_obj_desc *target_obj_desc,
+int print_obj_verbose(struct restool *ctx,
+		      struct dprc_obj_desc *target_obj_desc,
 			const struct flib_ops *ops)
 {
 	uint16_t obj_handle;
 	uint32_t irq_mask;
 	uint32_t irq_status;
+	char label[32];
 	int error = 0;
 
 	if (strcmp(target_obj_desc->type, "dprc") == 0 &&
-	    target_obj_desc->id == (int)restool.root_dprc_id) {
-		printf("number of mappable regions: 1\n");
-		printf("number of interrupts: 1\n");
-		error = dprc_get_irq_mask(&restool.mc_io, 0,
-				restool.root_dprc_handle, 0, &irq_mask);
+	    target_obj_desc->id == (int)ctx->root_dprc_id) {
+		output_uint("num_regions", "number of mappable regions", 1);
+		output_uint("num_irqs", "number of interrupts", 1);
+		error = dprc_get_irq_mask(&ctx->mc_io, ctx->cmd_flags,
+				ctx->root_dprc_handle, 0, &irq_mask);
 		if (error < 0) {
-			mc_status = flib_error_to_mc_status(error);
+			ctx->mc_status = flib_error_to_mc_status(error);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				mc_status_to_string(mc_status), mc_status);
+				mc_status_to_string(ctx->mc_status),
+				ctx->mc_status);
 		return error;
 		}
-		printf("interrupt[0] mask: %#x\n", irq_mask);
-		error = dprc_get_irq_status(&restool.mc_io, 0,
-				restool.root_dprc_handle, 0, &irq_status);
+		output_hex("interrupt_0_mask", "interrupt[0] mask", irq_mask);
+		error = dprc_get_irq_status(&ctx->mc_io, ctx->cmd_flags,
+				ctx->root_dprc_handle, 0, &irq_status);
 		if (error < 0) {
-			mc_status = flib_error_to_mc_status(error);
+			ctx->mc_status = flib_error_to_mc_status(error);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				mc_status_to_string(mc_status), mc_status);
+				mc_status_to_string(ctx->mc_status),
+				ctx->mc_status);
 		return error;
 		}
 
-		printf("interrupt[0] status: %#x\n", irq_status);
+		output_hex("interrupt_0_status", "interrupt[0] status",
+			   irq_status);
 		return 0;
 	}
 
-	printf("number of mappable regions: %u\n",
+	output_uint("num_regions", "number of mappable regions",
 		target_obj_desc->region_count);
-	printf("number of interrupts: %u\n", target_obj_desc->irq_count);
+	output_uint("num_irqs", "number of interrupts",
+		    target_obj_desc->irq_count);
 
-	error = ops->obj_open(&restool.mc_io, 0, target_obj_desc->id,
+	error = ops->obj_open(&ctx->mc_io, ctx->cmd_flags, target_obj_desc->id,
 				&obj_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			mc_status_to_string(mc_status), mc_status);
+			mc_status_to_string(ctx->mc_status), ctx->mc_status);
 		return error;
 	}
 
 	for (int j = 0; j < target_obj_desc->irq_count; j++) {
-		ops->obj_get_irq_mask(&restool.mc_io, 0, obj_handle, j,
+		snprintf(label, sizeof(label), "interrupt[%d] mask", j);
+		ops->obj_get_irq_mask(&ctx->mc_io, ctx->cmd_flags, obj_handle,
+				      j,
 					&irq_mask);
-		printf("interrupt[%d] mask: %#x\n", j, irq_mask);
-		ops->obj_get_irq_status(&restool.mc_io, 0, obj_handle, j,
+		output_hex(NULL, label, irq_mask);
+		snprintf(label, sizeof(label), "interrupt[%d] status", j);
+		ops->obj_get_irq_status(&ctx->mc_io, ctx->cmd_flags, obj_handle,
+					j,
 					&irq_status);
-		printf("interrupt[%d] status: %#x\n", j, irq_status);
+		output_hex(NULL, label, irq_status);
 	}
 
-	error = ops->obj_close(&restool.mc_io, 0, obj_handle);
+	error = ops->obj_close(&ctx->mc_io, ctx->cmd_flags, obj_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			mc_status_to_string(mc_status), mc_status);
+			mc_status_to_string(ctx->mc_status), ctx->mc_status);
 	}
 
 	return error;
@@ -607,19 +873,37 @@ bool in_use(const char *obj, const char *situation)
 	return false;
 }
 
-void print_new_obj(char *type, int id, const char *parent)
+void print_new_obj(struct restool *ctx, char *type, int id, const char *parent)
 {
-	if (restool.script) {
-		printf("%s.%d\n", type, id);
+	if (output_is_json()) {
+		output_field("object", "object", "%s.%d", type, id);
+		output_field("parent", "parent", "%s",
+			     parent != NULL ? parent : "dprc.1");
+		return;
+	}
+
+	if (ctx->script) {
+		output_printf("%s.%d\n", type, id);
 		return;
 	}
 
 	if (parent == NULL) { /* by default, parent == dprc.1 */
-		printf("%s.%d is created under dprc.1\n", type, id);
+		output_printf("%s.%d is created under dprc.1\n", type, id);
 		return;
 	}
 
-	printf("%s.%d is created under %s\n", type, id, parent);
+	output_printf("%s.%d is created under %s\n", type, id, parent);
+}
+
+void print_destroyed_obj(const char *type, uint32_t id)
+{
+	if (output_is_json()) {
+		output_field("object", "object", "%s.%u", type, id);
+		output_bool("destroyed", "destroyed", true, "yes");
+		return;
+	}
+
+	output_printf("%s.%u is destroyed\n", type, id);
 }
 
 void print_unexpected_options_error(uint32_t option_mask,
@@ -633,13 +917,14 @@ void print_unexpected_options_error(uint32_t option_mask,
 	}
 }
 
-int get_option_value(int option, long *value, const char *error_msg, long min, long max)
+int get_option_value(struct restool *ctx, int option, long *value,
+		     const char *error_msg, long min, long max)
 {
 	char *str, *endptr;
 	long val;
 
 	errno = 0;
-	str = restool.cmd_option_args[option];
+	str = ctx->cmd_option_args[option];
 	val = strtol(str, &endptr, 0);
 
 	if (STRTOL_ERROR(str, endptr, val, errno) ||
@@ -653,15 +938,16 @@ int get_option_value(int option, long *value, const char *error_msg, long min, l
 	return 0;
 }
 
-int get_parent_dprc_id(uint32_t obj_id, char *obj_type, uint32_t *parent_dprc_id)
+int get_parent_dprc_id(struct restool *ctx, uint32_t obj_id, char *obj_type,
+		       uint32_t *parent_dprc_id)
 {
 	struct dprc_obj_desc target_obj_desc;
 	bool found = false;
 	int error;
 
 	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0, obj_id,
+	error = find_target_obj_desc(ctx, ctx->root_dprc_id,
+				ctx->root_dprc_handle, 0, obj_id,
 				obj_type, &target_obj_desc,
 				parent_dprc_id, &found);
 	if (error || strcmp(target_obj_desc.type, obj_type))
@@ -670,7 +956,294 @@ int get_parent_dprc_id(uint32_t obj_id, char *obj_type, uint32_t *parent_dprc_id
 	return 0;
 }
 
-static void print_usage(void)
+/**
+ * Parses the --fields argument of the info commands, a comma-separated
+ * list of field names, into ctx->info_fields.
+ */
+int parse_info_fields(struct restool *ctx, const char *fields)
+{
+	static const char * const field_names[INFO_FIELD_NUM] = {
+		[INFO_FIELD_VERSION] = "version",
+		[INFO_FIELD_ID] = "id",
+		[INFO_FIELD_STATE] = "state",
+		[INFO_FIELD_ENDPOINT] = "endpoint",
+		[INFO_FIELD_LINK] = "link",
+		[INFO_FIELD_MAC] = "mac",
+		[INFO_FIELD_ATTR] = "attr",
+		[INFO_FIELD_STATS] = "stats",
+		[INFO_FIELD_LABEL] = "label",
+	};
+	uint32_t mask = 0;
+	const char *field = fields;
+
+	if (ctx->mc_fw_version.major < MC_FW_VERSION_10) {
+		ERROR_PRINTF("--fields requires MC firmware 10.x or newer\n");
+		return -EINVAL;
+	}
+
+	while (*field != '\0') {
+		size_t len = strcspn(field, ",");
+		unsigned int i;
+
+		for (i = 0; i < ARRAY_SIZE(field_names); i++) {
+			if (strlen(field_names[i]) == len &&
+			    strncmp(field, field_names[i], len) == 0)
+				break;
+		}
+
+		if (i == ARRAY_SIZE(field_names)) {
+			ERROR_PRINTF("Invalid field: \'%.*s\'\n",
+				     (int)len, field);
+			fprintf(stderr,
+				"Valid fields: version, id, state, endpoint, link,\n"
+				"              mac, attr, stats, label\n");
+			return -EINVAL;
+		}
+
+		mask |= ONE_BIT_MASK(i);
+		field += len;
+		if (*field == ',')
+			field++;
+	}
+
+	if (mask == 0) {
+		ERROR_PRINTF("No field selected\n");
+		return -EINVAL;
+	}
+
+	ctx->info_fields = mask;
+	return 0;
+}
+
+/**
+ * Looks up the descriptor of the object shown by an info command. The
+ * container scan is skipped when neither --verbose nor the selected
+ * fields need the descriptor; a missing object is then reported by the
+ * first MC command sent to it.
+ */
+int find_info_obj_desc(struct restool *ctx, uint32_t obj_id, char *obj_type,
+		       bool verbose,
+		       struct dprc_obj_desc *obj_desc)
+{
+	uint32_t parent_dprc_id;
+	bool found = false;
+	int error;
+
+	memset(obj_desc, 0, sizeof(struct dprc_obj_desc));
+	if (!verbose && !INFO_FIELD(STATE) && !INFO_FIELD(LABEL)) {
+		strncpy(obj_desc->type, obj_type, sizeof(obj_desc->type) - 1);
+		obj_desc->id = obj_id;
+		return 0;
+	}
+
+	error = find_target_obj_desc(ctx, ctx->root_dprc_id,
+				     ctx->root_dprc_handle, 0, obj_id,
+				     obj_type, obj_desc,
+				     &parent_dprc_id, &found);
+	if (error < 0)
+		return error;
+
+	if (strcmp(obj_desc->type, obj_type)) {
+		output_notice("%s.%d does not exist\n", obj_type, obj_id);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/**
+ * Object API versions learned from the MC, see get_obj_api_version()
+ */
+#define API_VERSION_CACHE_FILE	RESTOOL_RUN_DIR "/api_versions"
+
+/**
+ * Guards the API versions in version_lut, which requests on different
+ * threads read and fill in. An entry only changes from 0 to the version
+ * the MC reports for the type.
+ */
+static pthread_mutex_t version_lut_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Looks up a key of the generated dispatch table, see dispatch.h: one
+ * hash picks the bucket, the bucket's displacement the slot
+ */
+static const struct dispatch_entry *dispatch_lookup(const char *obj_type,
+						    uint16_t version,
+						    const char *cmd_name)
+{
+	const struct dispatch_entry *entry;
+	uint32_t bucket;
+	uint32_t slot;
+
+	bucket = dispatch_hash(31, obj_type, version, cmd_name) %
+		 dispatch_num_buckets;
+	slot = dispatch_hash(dispatch_displacement[bucket], obj_type, version,
+			     cmd_name) % dispatch_num_slots;
+	entry = &dispatch_table[slot];
+	if (entry->obj_type == NULL || entry->version != version ||
+	    strcmp(entry->obj_type, obj_type) != 0 ||
+	    strcmp(entry->cmd_name, cmd_name) != 0)
+		return NULL;
+
+	return entry;
+}
+
+static struct lut_entry *find_version_lut_entry(const char *obj_type)
+{
+	const struct dispatch_entry *entry = dispatch_lookup(obj_type, 0, "");
+
+	return entry != NULL ? entry->lut : NULL;
+}
+
+/**
+ * Reads the API version learned for a type, 0.0 if it is not known yet
+ */
+static void get_lut_api_version(struct lut_entry *entry,
+				uint16_t *major_ver, uint16_t *minor_ver)
+{
+	pthread_mutex_lock(&version_lut_lock);
+	*major_ver = entry->api_major;
+	*minor_ver = entry->api_minor;
+	pthread_mutex_unlock(&version_lut_lock);
+}
+
+/**
+ * API versions of the version_lut entries, copied out so that the cache
+ * file is read and written without holding version_lut_lock
+ */
+struct api_versions {
+	uint16_t major[ARRAY_SIZE(version_lut)];
+	uint16_t minor[ARRAY_SIZE(version_lut)];
+};
+
+/**
+ * Loads the object API versions saved by a previous run. The file is
+ * ignored unless it was written for the running MC firmware version.
+ */
+void load_api_version_cache(struct restool *ctx)
+{
+	char obj_type[OBJ_TYPE_MAX_LENGTH + 1];
+	unsigned int major, minor, revision;
+	struct api_versions versions = { 0 };
+	struct lut_entry *entry;
+	FILE *fp;
+
+	fp = fopen(API_VERSION_CACHE_FILE, "r");
+	if (fp == NULL)
+		return;
+
+	if (fscanf(fp, "mc %u.%u.%u\n", &major, &minor, &revision) != 3 ||
+	    major != ctx->mc_fw_version.major ||
+	    minor != ctx->mc_fw_version.minor ||
+	    revision != ctx->mc_fw_version.revision) {
+		DEBUG_PRINTF("ignoring stale %s\n", API_VERSION_CACHE_FILE);
+		fclose(fp);
+		return;
+	}
+
+	while (fscanf(fp, "%" STRINGIFY(OBJ_TYPE_MAX_LENGTH) "s %u.%u\n",
+		      obj_type, &major, &minor) == 3) {
+		entry = find_version_lut_entry(obj_type);
+		if (entry == NULL || major == 0 ||
+		    major > UINT16_MAX || minor > UINT16_MAX)
+			continue;
+
+		versions.major[entry - version_lut] = major;
+		versions.minor[entry - version_lut] = minor;
+	}
+	fclose(fp);
+
+	pthread_mutex_lock(&version_lut_lock);
+	for (unsigned int i = 0; i < ARRAY_SIZE(version_lut); i++) {
+		if (versions.major[i] != 0 && version_lut[i].api_major == 0) {
+			version_lut[i].api_major = versions.major[i];
+			version_lut[i].api_minor = versions.minor[i];
+		}
+	}
+	pthread_mutex_unlock(&version_lut_lock);
+}
+
+static void save_api_version_cache(struct restool *ctx,
+				   const struct api_versions *versions)
+{
+	char tmp_file[] = API_VERSION_CACHE_FILE ".XXXXXX";
+	FILE *fp;
+	int fd;
+
+	(void)mkdir(RESTOOL_RUN_DIR, 0755);
+	fd = mkstemp(tmp_file);
+	if (fd < 0) {
+		DEBUG_PRINTF("cannot create %s: %s\n", tmp_file,
+			     strerror(errno));
+		return;
+	}
+
+	(void)fchmod(fd, 0644);
+	fp = fdopen(fd, "w");
+	if (fp == NULL) {
+		close(fd);
+		unlink(tmp_file);
+		return;
+	}
+
+	fprintf(fp, "mc %u.%u.%u\n",
+		ctx->mc_fw_version.major,
+		ctx->mc_fw_version.minor,
+		ctx->mc_fw_version.revision);
+	for (unsigned int i = 0; i < ARRAY_SIZE(version_lut); i++) {
+		if (versions->major[i] != 0)
+			fprintf(fp, "%s %u.%u\n", version_lut[i].object,
+				versions->major[i], versions->minor[i]);
+	}
+
+	/* rename() keeps concurrent readers from seeing a partial file */
+	if (fclose(fp) != 0 || rename(tmp_file, API_VERSION_CACHE_FILE) < 0) {
+		DEBUG_PRINTF("cannot write %s: %s\n", API_VERSION_CACHE_FILE,
+			     strerror(errno));
+		unlink(tmp_file);
+	}
+}
+
+/**
+ * Returns the API version of an object type. The version does not change
+ * while the same MC firmware runs, so the MC is only asked the first time
+ * a type is seen; the answer is kept in version_lut and saved to
+ * API_VERSION_CACHE_FILE for later runs.
+ */
+int get_obj_api_version(struct restool *ctx, const char *obj_type,
+			get_api_version_t *get_api_version,
+			uint16_t *major_ver, uint16_t *minor_ver)
+{
+	struct api_versions versions;
+	struct lut_entry *entry;
+	int error;
+
+	entry = find_version_lut_entry(obj_type);
+	if (entry != NULL) {
+		get_lut_api_version(entry, major_ver, minor_ver);
+		if (*major_ver != 0)
+			return 0;
+	}
+
+	error = get_api_version(&ctx->mc_io, ctx->cmd_flags, major_ver,
+				minor_ver);
+	if (error < 0 || entry == NULL)
+		return error;
+
+	pthread_mutex_lock(&version_lut_lock);
+	entry->api_major = *major_ver;
+	entry->api_minor = *minor_ver;
+	for (unsigned int i = 0; i < ARRAY_SIZE(version_lut); i++) {
+		versions.major[i] = version_lut[i].api_major;
+		versions.minor[i] = version_lut[i].api_minor;
+	}
+	pthread_mutex_unlock(&version_lut_lock);
+
+	save_api_version_cache(ctx, &versions);
+	return 0;
+}
+
+static void print_usage(struct restool *ctx)
 {
 	static const char usage_msg[] =
 		"OVERVIEW\n"
@@ -699,6 +1272,17 @@ static void print_usage(void)
 		"   -h,-?,--help     Displays general help info\n"
 		"   -s, --script     Display script friendly output\n"
 		"   --root=[dprc]    Specifies root container name\n"
+		"   --output=<fmt>   Output format: text (default) or json\n"
+		"   --trace=<file>   Writes a Chrome trace of the run to <file>\n"
+		"   --retry-wait=<ms>\n"
+		"                    Retries MC commands for up to <ms> milliseconds\n"
+		"                    while the MC is busy (default "
+		STRINGIFY(MC_RETRY_DEFAULT_WAIT_MS) ", 0 disables)\n"
+		"   --priority=<normal|high>\n"
+		"                    Sends the MC commands with the given priority,\n"
+		"                    instead of high for monitoring and teardown\n"
+		"   --dma-phys       Hands key and rule memory to the MC by physical\n"
+		"                    address, only valid when the SMMU bypasses the MC\n"
 		"\n"
 		"  Valid <object-type> values: <dprc|dpni|dpio|dpsw|dpbp|dpci|dpcon|dpseci|dpdmux|\n"
 		"                               dpmcp|dpmac|dpdcei|dpaiop|dpdmai>\n"
@@ -714,51 +1298,79 @@ static void print_usage(void)
 		"\n";
 
 	puts(usage_msg);
-	restool.global_option_mask &= ~ONE_BIT_MASK(GLOBAL_OPT_HELP);
+	ctx->global_option_mask &= ~ONE_BIT_MASK(GLOBAL_OPT_HELP);
 }
 
-static void print_usage_v9(void)
+static const char usage_msg_v9[] =
+	"OVERVIEW\n"
+	"\n"
+	"  For general help info:\n"
+	"    restool --help\n"
+	"\n"
+	"  To see the commands each object suppports:\n"
+	"    restool <object-type> help\n"
+	"\n"
+	"  For object type and command-specific help:\n"
+	"    restool <object-type> <command> --help\n"
+	"\n"
+	"SYNOPSIS\n"
+	"\n"
+	"  restool [<global-opts>] <object-type> <command> <object-name> [ARGS...]\n"
+	"\n"
+	"OPTIONS\n"
+	"\n"
+	"  Valid <global-opts> are:\n"
+	"   -v,--version     Displays tool version info\n"
+	"   -m,--mc-version  Displays mc firmware version\n"
+	"   -h,-?,--help     Displays general help info\n"
+	"   -s, --script     Display script friendly output\n"
+	"   --root=[dprc]    Specifies root container name\n"
+	"   --output=<fmt>   Output format: text (default) or json\n"
+	"   --trace=<file>   Writes a Chrome trace of the run to <file>\n"
+	"   --retry-wait=<ms>\n"
+	"                    Retries MC commands for up to <ms> milliseconds\n"
+	"                    while the MC is busy (default "
+		STRINGIFY(MC_RETRY_DEFAULT_WAIT_MS) ", 0 disables)\n"
+	"   --priority=<normal|high>\n"
+	"                    Sends the MC commands with the given priority,\n"
+	"                    instead of high for monitoring and teardown\n"
+	"   --dma-phys       Hands key and rule memory to the MC by physical\n"
+	"                    address, only valid when the SMMU bypasses the MC\n"
+	"\n"
+	"  Valid <object-type> values: <dprc|dpni|dpio|dpsw|dpbp|dpci|dpcon|dpseci|dpdmux|\n"
+	"                               dpmcp|dpmac|dpdcei|dpaiop|dprtc|dpdmai>\n"
+	"\n"
+	"  Valid commands vary for each object type.\n"
+	"  Most objects support the following commands:\n"
+	"    help\n"
+	"    info\n"
+	"    create\n"
+	"    destroy\n"
+	"\n"
+	"  <object-name> is a string containing object type and ID (e.g. dpni.7)\n"
+	"\n";
+
+static void print_usage_v9(struct restool *ctx)
 {
-	static const char usage_msg[] =
-		"OVERVIEW\n"
-		"\n"
-		"  For general help info:\n"
-		"    restool --help\n"
-		"\n"
-		"  To see the commands each object suppports:\n"
-		"    restool <object-type> help\n"
-		"\n"
-		"  For object type and command-specific help:\n"
-		"    restool <object-type> <command> --help\n"
-		"\n"
-		"SYNOPSIS\n"
-		"\n"
-		"  restool [<global-opts>] <object-type> <command> <object-name> [ARGS...]\n"
-		"\n"
-		"OPTIONS\n"
-		"\n"
-		"  Valid <global-opts> are:\n"
-		"   -v,--version     Displays tool version info\n"
-		"   -m,--mc-version  Displays mc firmware version\n"
-		"   -h,-?,--help     Displays general help info\n"
-		"   -s, --script     Display script friendly output\n"
-		"   --root=[dprc]    Specifies root container name\n"
-		"\n"
-		"  Valid <object-type> values: <dprc|dpni|dpio|dpsw|dpbp|dpci|dpcon|dpseci|dpdmux|\n"
-		"                               dpmcp|dpmac|dpdcei|dpaiop|dprtc|dpdmai>\n"
-		"\n"
-		"  Valid commands vary for each object type.\n"
-		"  Most objects support the following commands:\n"
-		"    help\n"
-		"    info\n"
-		"    create\n"
-		"    destroy\n"
-		"\n"
-		"  <object-name> is a string containing object type and ID (e.g. dpni.7)\n"
+	puts(usage_msg_v9);
+	ctx->global_option_mask &= ~ONE_BIT_MASK(GLOBAL_OPT_HELP);
+}
+
+static void print_usage_v10(struct restool *ctx)
+{
+	static const char monitoring_msg[] =
+		"  Monitoring tools:\n"
+		"    restool monitor [<container>] [ARGS...]\n"
+		"                     reports link, plug state and object changes\n"
+		"    restool top [<container>] [ARGS...]\n"
+		"                     shows the busiest DPNIs and DPMACs\n"
+		"    restool stats <record|dump> [ARGS...]\n"
+		"                     records counters to a ring file and reads it back\n"
 		"\n";
 
-	puts(usage_msg);
-	restool.global_option_mask &= ~ONE_BIT_MASK(GLOBAL_OPT_HELP);
+	fputs(usage_msg_v9, stdout);
+	puts(monitoring_msg);
+	ctx->global_option_mask &= ~ONE_BIT_MASK(GLOBAL_OPT_HELP);
 }
 
 static void print_try_help(void)
@@ -766,20 +1378,20 @@ static void print_try_help(void)
 	ERROR_PRINTF("try 'restool --help'\n");
 }
 
-static void print_version(void)
+static void print_version(struct restool *ctx)
 {
-	printf("restool %s\n", VERSION);
-	restool.global_option_mask &= ~ONE_BIT_MASK(GLOBAL_OPT_VERSION);
+	output_printf("restool %s\n", VERSION);
+	ctx->global_option_mask &= ~ONE_BIT_MASK(GLOBAL_OPT_VERSION);
 }
 
-static void print_mc_version(void)
+static void print_mc_version(struct restool *ctx)
 {
-	printf("MC firmware version: %u.%u.%u\n",
-	       restool.mc_fw_version.major,
-	       restool.mc_fw_version.minor,
-	       restool.mc_fw_version.revision);
+	output_field("mc_version", "MC firmware version", "%u.%u.%u",
+		     ctx->mc_fw_version.major,
+		     ctx->mc_fw_version.minor,
+		     ctx->mc_fw_version.revision);
 
-	restool.global_option_mask &= ~ONE_BIT_MASK(GLOBAL_OPT_MC_VERSION);
+	ctx->global_option_mask &= ~ONE_BIT_MASK(GLOBAL_OPT_MC_VERSION);
 }
 
 int parse_object_name(const char *obj_name, char *expected_obj_type,
@@ -805,17 +1417,17 @@ int parse_object_name(const char *obj_name, char *expected_obj_type,
 	return 0;
 }
 
-int open_dprc(uint32_t dprc_id, uint16_t *dprc_handle)
+int open_dprc(struct restool *ctx, uint32_t dprc_id, uint16_t *dprc_handle)
 {
 	int error;
 
-	error = dprc_open(&restool.mc_io, 0,
+	error = dprc_open(&ctx->mc_io, ctx->cmd_flags,
 			  dprc_id,
 			  dprc_handle);
 	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
+		ctx->mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			mc_status_to_string(mc_status), mc_status);
+			mc_status_to_string(ctx->mc_status), ctx->mc_status);
 		goto out;
 	}
 
@@ -824,7 +1436,7 @@ int open_dprc(uint32_t dprc_id, uint16_t *dprc_handle)
 			"dprc_open() returned invalid handle (auth 0) for dprc.%u\n",
 			dprc_id);
 
-		(void)dprc_close(&restool.mc_io, 0, *dprc_handle);
+		(void)dprc_close(&ctx->mc_io, ctx->cmd_flags, *dprc_handle);
 		error = -ENOENT;
 		goto out;
 	}
@@ -851,19 +1463,79 @@ static int check_arg(char *optarg)
 	return str_len;
 }
 
-static int parse_global_options(int argc, char *argv[],
+/**
+ * getopt keeps its parsing state in globals (optind, optarg), requests on
+ * different threads take turns parsing their command lines
+ */
+static pthread_mutex_t getopt_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int parse_retry_wait(struct restool *ctx, const char *str)
+{
+	char *endptr;
+	long val;
+
+	errno = 0;
+	val = strtol(str, &endptr, 0);
+	if (STRTOL_ERROR(str, endptr, val, errno) ||
+	    val < 0 || val > MC_RETRY_MAX_WAIT_MS) {
+		ERROR_PRINTF("Invalid --retry-wait value: \'%s\', it must be 0 to %d milliseconds\n",
+			     str, MC_RETRY_MAX_WAIT_MS);
+		return -EINVAL;
+	}
+
+	ctx->retry_wait_ms = val;
+	return 0;
+}
+
+static int parse_priority(struct restool *ctx, const char *str)
+{
+	if (strcmp(str, "normal") == 0) {
+		ctx->priority = CMD_PRIORITY_NORMAL;
+	} else if (strcmp(str, "high") == 0) {
+		ctx->priority = CMD_PRIORITY_HIGH;
+	} else {
+		ERROR_PRINTF("Invalid --priority value: \'%s\'\n"
+			     "Valid priorities: normal, high\n", str);
+		return -EINVAL;
+	}
+
+	ctx->priority_set = true;
+	return 0;
+}
+
+/**
+ * cmd_flags for the MC commands of a command of the given priority class,
+ * unless --priority overrides it
+ */
+static uint32_t cmd_priority_flags(struct restool *ctx,
+				   enum cmd_priority priority)
+{
+	if (ctx->priority_set)
+		priority = ctx->priority;
+
+	return priority == CMD_PRIORITY_HIGH ? PRI : 0;
+}
+
+static int parse_global_options(struct restool *ctx, int argc, char *argv[],
 				int *next_argv_index)
 {
 	int c;
 	int opt_index;
 
+	ctx->global_option_mask = 0;
+
+	/* no global options, leave getopt alone */
+	if (argc < 2 || argv[1][0] != '-') {
+		*next_argv_index = 1;
+		return 0;
+	}
+
 	/*
 	 * Initialize getopt global variables:
 	 */
 	optind = 1;
 	optarg = NULL;
 
-	restool.global_option_mask = 0;
 	for ( ; ; ) {
 		opt_index = 0;
 		c = getopt_long(argc, argv, "+h?vmds", global_options, NULL);
@@ -909,7 +1581,8 @@ static int parse_global_options(int argc, char *argv[],
 				return str_len;
 			}
 
-			size_buff = sprintf(restool.specified_dev_file, "%s", optarg);
+			size_buff = sprintf(ctx->specified_dev_file, "%s",
+					    optarg);
 			if (size_buff != str_len) {
 				ERROR_PRINTF("sprintf failed\n");
 				return -1;
@@ -917,6 +1590,26 @@ static int parse_global_options(int argc, char *argv[],
 
 			break;
 
+		case 'o':
+			opt_index = GLOBAL_OPT_OUTPUT;
+			break;
+
+		case 't':
+			opt_index = GLOBAL_OPT_TRACE;
+			break;
+
+		case 'w':
+			opt_index = GLOBAL_OPT_RETRY_WAIT;
+			break;
+
+		case 'p':
+			opt_index = GLOBAL_OPT_PRIORITY;
+			break;
+
+		case 'y':
+			opt_index = GLOBAL_OPT_DMA_PHYS;
+			break;
+
 		default:
 			DEBUG_PRINTF("\n");
 			assert(false);
@@ -924,17 +1617,17 @@ static int parse_global_options(int argc, char *argv[],
 		}
 
 		assert((unsigned int)opt_index < MAX_NUM_CMD_LINE_OPTIONS);
-		if (restool.global_option_mask & ONE_BIT_MASK(opt_index)) {
+		if (ctx->global_option_mask & ONE_BIT_MASK(opt_index)) {
 			ERROR_PRINTF("Duplicated option: %s\n",
 				     global_options[opt_index].name);
 			return -EINVAL;
 		}
 
-		restool.global_option_mask |= ONE_BIT_MASK(opt_index);
+		ctx->global_option_mask |= ONE_BIT_MASK(opt_index);
 		if (global_options[opt_index].has_arg)
-			restool.global_option_args[opt_index] = optarg;
+			ctx->global_option_args[opt_index] = optarg;
 		else
-			restool.global_option_args[opt_index] = NULL;
+			ctx->global_option_args[opt_index] = NULL;
 	}
 
 	DEBUG_PRINTF("optind: %d, argc: %d\n", optind, argc);
@@ -943,8 +1636,9 @@ static int parse_global_options(int argc, char *argv[],
 	return 0;
 }
 
-static int parse_cmd_options(int argc, char *argv[],
+static int parse_cmd_options(struct restool *ctx, int argc, char *argv[],
 			     const struct option options[],
+			     uint32_t arg_option_mask,
 			     int *next_argv_index)
 {
 	int c;
@@ -957,9 +1651,15 @@ static int parse_cmd_options(int argc, char *argv[],
 	optind = 1;
 	optarg = NULL;
 
-	restool.cmd_option_mask = 0;
+	ctx->cmd_option_mask = 0;
 	assert(options != NULL);
 
+	/* nothing to parse, leave getopt alone */
+	if (argc == 1) {
+		*next_argv_index = 1;
+		return 0;
+	}
+
 	for ( ; ; ) {
 		c = getopt_long_only(argc, argv, "+", options, &opt_index);
 		if (c == -1)
@@ -971,18 +1671,18 @@ static int parse_cmd_options(int argc, char *argv[],
 		}
 
 		assert((unsigned int)opt_index < MAX_NUM_CMD_LINE_OPTIONS);
-		if (restool.cmd_option_mask & ONE_BIT_MASK(opt_index)) {
+		if (ctx->cmd_option_mask & ONE_BIT_MASK(opt_index)) {
 			ERROR_PRINTF("Duplicated option: %s\n",
 				     options[opt_index].name);
 			error = -EINVAL;
 			goto error;
 		}
 
-		restool.cmd_option_mask |= ONE_BIT_MASK(opt_index);
-		if (options[opt_index].has_arg)
-			restool.cmd_option_args[opt_index] = optarg;
+		ctx->cmd_option_mask |= ONE_BIT_MASK(opt_index);
+		if (arg_option_mask & ONE_BIT_MASK(opt_index))
+			ctx->cmd_option_args[opt_index] = optarg;
 		else
-			restool.cmd_option_args[opt_index] = NULL;
+			ctx->cmd_option_args[opt_index] = NULL;
 	}
 
 	DEBUG_PRINTF("optind: %d, argc: %d\n", optind, argc);
@@ -995,21 +1695,14 @@ error:
  * This function can be used to get the supported obj version(major) for a
  * specific object and your current MC Firmware Version
  */
-static uint16_t get_obj_version(const char *obj_type)
+static uint16_t get_obj_version(struct restool *ctx, const char *obj_type,
+			       struct lut_entry *lut_obj_entry)
 {
 	unsigned int i;
 	uint16_t obj_version = 0;
-	uint32_t mc_major_version = restool.mc_fw_version.major;
-	struct lut_entry *lut_obj_entry = NULL;
+	uint32_t mc_major_version = ctx->mc_fw_version.major;
 	struct version_table *versions_table;
-
-	/*
-	 * get the specific object version lookup table
-	 */
-	for (i = 0; i < ARRAY_SIZE(version_lut); i++) {
-		if (strcmp(obj_type, version_lut[i].object) == 0)
-			lut_obj_entry = &version_lut[i];
-	}
+	uint16_t api_major, api_minor;
 
 	if (lut_obj_entry == NULL) {
 		ERROR_PRINTF("error: invalid object type \'%s\'\n", obj_type);
@@ -1017,9 +1710,22 @@ static uint16_t get_obj_version(const char *obj_type)
 	}
 
 	/*
-	 * find the supported object version number from the MC Version
+	 * prefer the API version already learned from the MC when there
+	 * are commands for it
 	 */
 	versions_table = lut_obj_entry->versions_table;
+	get_lut_api_version(lut_obj_entry, &api_major, &api_minor);
+	for (i = 0; versions_table[i].mc_major_version != 0; i++) {
+		if (api_major != 0 &&
+		    api_major == versions_table[i].object_version) {
+			obj_version = api_major;
+			goto out;
+		}
+	}
+
+	/*
+	 * find the supported object version number from the MC Version
+	 */
 	for (i = 0; versions_table[i].mc_major_version != 0; i++) {
 		if (mc_major_version == versions_table[i].mc_major_version)
 			obj_version = versions_table[i].object_version;
@@ -1035,108 +1741,91 @@ out:
 	return obj_version;
 }
 
-static struct object_command *get_obj_cmd(const char *obj_type,
-					  const char *cmd_name)
+static bool is_standalone_obj(const char *obj_type)
 {
-	unsigned int i;
-	const struct object_cmd_parser *obj_cmd_parser = NULL;
-	const struct obj_command_versions *obj_cmd_versions;
-	struct object_command *obj_commands;
-	struct object_command *obj_cmd = NULL;
-	uint16_t obj_version;
+	const struct dispatch_entry *entry = dispatch_lookup(obj_type, 0, "");
 
-	/*
-	 * Lookup object command parser:
-	 */
-	for (i = 0; i < ARRAY_SIZE(object_cmd_parsers); i++) {
-		if (strcmp(obj_type, object_cmd_parsers[i].obj_type) == 0) {
-			obj_cmd_parser = &object_cmd_parsers[i];
-			break;
-		}
-	}
+	return entry != NULL && entry->standalone;
+}
+
+static const struct dispatch_entry *get_obj_cmd(struct restool *ctx,
+						const char *obj_type,
+						const char *cmd_name)
+{
+	const struct dispatch_entry *entry;
+	uint16_t obj_version;
 
-	if (obj_cmd_parser == NULL) {
+	entry = dispatch_lookup(obj_type, 0, "");
+	if (entry == NULL) {
 		ERROR_PRINTF("error: invalid object type \'%s\'\n", obj_type);
 		print_try_help();
-		goto out;
+		return NULL;
 	}
 
 	/*
 	 * lookup object version number supported by MC firmware version
 	 */
-	obj_version = get_obj_version(obj_type);
+	obj_version = get_obj_version(ctx, obj_type, entry->lut);
 	if (obj_version == 0)
-		goto out;
+		return NULL;
 
-	/*
-	 * Find the right object_command struct assosiates with version
-	 */
-	obj_cmd_versions = obj_cmd_parser->obj_commands_versions;
-	for (i = 0; obj_cmd_versions[i].obj_commands != NULL; i++) {
-		if (obj_version ==  obj_cmd_versions[i].version)
-			obj_commands = obj_cmd_versions[i].obj_commands;
-	}
-
-	if (obj_commands == NULL) {
+	if (dispatch_lookup(obj_type, obj_version, "") == NULL) {
 		ERROR_PRINTF("error: invalid object version \'%u\'\n",
 			     obj_version);
-		goto out;
+		return NULL;
 	}
 
-	/*
-	 * Lookup object-level command:
-	 */
-	for (i = 0; obj_commands[i].cmd_name != NULL; i++) {
-		if (strcmp(cmd_name, obj_commands[i].cmd_name) == 0) {
-			obj_cmd = &obj_commands[i];
-			break;
-		}
-	}
-
-	if (obj_cmd == NULL) {
+	entry = dispatch_lookup(obj_type, obj_version, cmd_name);
+	if (entry == NULL) {
 		ERROR_PRINTF("Invalid command \'%s\' for object type \'%s\'\n",
 			     cmd_name, obj_type);
 		print_try_help();
-		goto out;
 	}
 
-out:
-	return obj_cmd;
+	return entry;
 }
 
-static int parse_obj_command(const char *obj_type,
+static int parse_obj_command(struct restool *ctx, const char *obj_type,
 			     const char *cmd_name,
 			     int argc,
 			     char *argv[])
 {
 	int error;
 	int next_argv_index;
-	struct object_command *obj_cmd = NULL;
+	const struct dispatch_entry *entry;
+	struct object_command *obj_cmd;
 	struct timespec start_time = { 0 };
 	struct timespec end_time = { 0 };
 	struct timespec latency = { 0 };
+	char span_name[64];
 
 	assert(argv[0] == cmd_name);
-	obj_cmd = get_obj_cmd(obj_type, cmd_name);
-	restool.obj_cmd = obj_cmd;
-	if (restool.obj_cmd == NULL) {
+	entry = get_obj_cmd(ctx, obj_type, cmd_name);
+	if (entry == NULL) {
+		ctx->obj_cmd = NULL;
 		error = -EINVAL;
 		goto out;
 	}
+	obj_cmd = entry->cmd;
+	ctx->obj_cmd = obj_cmd;
+	ctx->cmd_flags = cmd_priority_flags(ctx, obj_cmd->priority);
 	if (argc >= 2 && argv[1][0] != '-') {
-		restool.obj_name = argv[1];
+		ctx->obj_name = argv[1];
 		argv++;
 		argc--;
 	} else {
-		restool.obj_name = NULL;
+		ctx->obj_name = NULL;
 	}
 	/*
 	 * Parse object-level command options:
 	 */
 	if (obj_cmd->options != NULL) {
-		error = parse_cmd_options(argc, argv,
+		pthread_mutex_lock(&getopt_lock);
+		error = parse_cmd_options(ctx, argc, argv,
 					  obj_cmd->options,
+					  entry->arg_option_mask,
 					  &next_argv_index);
+		pthread_mutex_unlock(&getopt_lock);
 
 		if (error != 0)
 			goto out;
@@ -1161,9 +1850,13 @@ static int parse_obj_command(const char *obj_type,
 	 * Execute object-level command:
 	 */
 	clock_gettime(CLOCK_REALTIME, &start_time);
+	snprintf(span_name, sizeof(span_name), "%s %s", obj_type, cmd_name);
+	trace_begin(span_name);
 
-	error = obj_cmd->cmd_func();
+	error = obj_cmd->cmd_func(ctx);
+	container_unlock_all(ctx);
 
+	trace_end();
 	clock_gettime(CLOCK_REALTIME, &end_time);
 	diff_time(&start_time, &end_time, &latency);
 	DEBUG_PRINTF("It takes %ld.%ld seconds to run command\n",
@@ -1171,8 +1864,8 @@ static int parse_obj_command(const char *obj_type,
 
 	if (error < 0)
 		goto out;
-	if (restool.cmd_option_mask != 0) {
-		print_unexpected_options_error(restool.cmd_option_mask,
+	if (ctx->cmd_option_mask != 0) {
+		print_unexpected_options_error(ctx->cmd_option_mask,
 					       obj_cmd->options);
 		error = -EINVAL;
 	}
@@ -1180,31 +1873,29 @@ out:
 	return error;
 }
 
-static int get_device_file(void)
+static int get_device_file(struct restool *ctx)
 {
 	int error = 0;
 	int num_char;
 
-	memset(restool.device_file, '\0', DEV_FILE_SIZE);
-
-	if (restool.specified_dev_file[0] != '\0') {
-		int temp_len = strlen(restool.specified_dev_file);
+	memset(ctx->device_file, '\0', DEV_FILE_SIZE);
 
-		temp_len += 5;
-		num_char = sprintf(restool.device_file, "/dev/%s",
-				   restool.specified_dev_file);
-		if (num_char != temp_len) {
-			ERROR_PRINTF("sprintf failed\n");
+	if (ctx->specified_dev_file[0] != '\0') {
+		num_char = snprintf(ctx->device_file, DEV_FILE_SIZE, "/dev/%s",
+				    ctx->specified_dev_file);
+		if (num_char < 0 || num_char >= DEV_FILE_SIZE) {
+			ERROR_PRINTF("device file name too long: %s\n",
+				     ctx->specified_dev_file);
 			error = -1;
 			goto out;
 		}
-		if (access(restool.device_file, F_OK) != 0) {
+		if (access(ctx->device_file, F_OK) != 0) {
 			error = -1;
 			ERROR_PRINTF("error: %s does not exist\n",
-				     restool.device_file);
+				     ctx->device_file);
 		}
 	} else if (access("/dev/mc_restool", F_OK) == 0) {
-		num_char = sprintf(restool.device_file, "/dev/mc_restool");
+		num_char = sprintf(ctx->device_file, "/dev/mc_restool");
 		if (num_char != 15) {
 			ERROR_PRINTF("sprintf failed\n");
 			error = -1;
@@ -1214,7 +1905,7 @@ static int get_device_file(void)
 		DIR           *d;
 		struct dirent *dir;
 		int num_dev_files = 0;
-		char *dprc_index;
+		char dprc_index[DEV_FILE_SIZE];
 
 		d = opendir("/dev");
 		if (!d) {
@@ -1224,26 +1915,30 @@ static int get_device_file(void)
 		}
 		while ((dir = readdir(d)) != NULL) {
 			if (strncmp(dir->d_name, "dprc.", 5) == 0) {
-				dprc_index = &dir->d_name[5];
+				size_t len = strlen(&dir->d_name[5]);
+
+				/* d_name does not outlive closedir() */
+				if (len >= sizeof(dprc_index))
+					len = sizeof(dprc_index) - 1;
+				memcpy(dprc_index, &dir->d_name[5], len);
+				dprc_index[len] = '\0';
 				num_dev_files += 1;
 			}
 		}
 		closedir(d);
 
 		if (num_dev_files == 1) {
-			int temp_len = strlen(dprc_index);
-
-			temp_len += 10;
-			num_char = sprintf(restool.device_file, "/dev/dprc.%s",
-					   dprc_index);
-			if (num_char != temp_len) {
-				ERROR_PRINTF("sprintf error\n");
+			num_char = snprintf(ctx->device_file, DEV_FILE_SIZE,
+					    "/dev/dprc.%s", dprc_index);
+			if (num_char < 0 || num_char >= DEV_FILE_SIZE) {
+				ERROR_PRINTF("device file name too long: dprc.%s\n",
+					     dprc_index);
 				error = -1;
 				goto out;
 			}
-			restool.root_dprc_id = atoi(dprc_index);
-			if (access(restool.device_file, F_OK) != 0)
-				printf("no such dev file\n");
+			ctx->root_dprc_id = atoi(dprc_index);
+			if (access(ctx->device_file, F_OK) != 0)
+				output_notice("no such dev file\n");
 		} else {
 			error = -1;
 			if (num_dev_files == 0)
@@ -1256,14 +1951,147 @@ out:
 	return error;
 }
 
-static int open_root_container(void)
+/**
+ * Device file, root container and MC firmware version found by an earlier
+ * run, valid for as long as the same device node exists in the same boot
+ */
+#define STARTUP_STATE_FILE	RESTOOL_RUN_DIR "/state"
+
+#define BOOT_ID_FILE		"/proc/sys/kernel/random/boot_id"
+
+/**
+ * Boot id string length, a UUID, plus the null terminator
+ */
+#define BOOT_ID_SIZE		37
+
+static int read_boot_id(char *boot_id)
+{
+	FILE *fp;
+	int n;
+
+	fp = fopen(BOOT_ID_FILE, "r");
+	if (fp == NULL)
+		return -errno;
+
+	n = fscanf(fp, "%36s", boot_id);
+	fclose(fp);
+	return n == 1 ? 0 : -EINVAL;
+}
+
+/**
+ * Restores ctx->device_file, root_dprc_id and mc_fw_version from
+ * STARTUP_STATE_FILE. The state is only used if it was saved in this boot
+ * for the same device node (and for the --root container, if given), so
+ * a valid state replaces the /dev scan and the mc_get_version() command.
+ * Runs given --root do not save the state, so it always holds the
+ * container found without --root.
+ */
+static bool load_startup_state(struct restool *ctx)
+{
+	char boot_id[BOOT_ID_SIZE];
+	char saved_boot_id[BOOT_ID_SIZE];
+	/* one more byte so that overlong names are detected, not truncated */
+	char device_file[DEV_FILE_SIZE + 1];
+	unsigned long long ino, rdev;
+	unsigned int root_id, major, minor, revision;
+	bool valid = false;
+	struct stat st;
+	FILE *fp;
+
+	if (read_boot_id(boot_id) < 0)
+		return false;
+
+	fp = fopen(STARTUP_STATE_FILE, "r");
+	if (fp == NULL)
+		return false;
+
+	if (fscanf(fp, "boot %36s\n", saved_boot_id) != 1 ||
+	    fscanf(fp, "device %" STRINGIFY(DEV_FILE_SIZE) "s %llu %llu\n",
+		   device_file, &ino, &rdev) != 3 ||
+	    fscanf(fp, "root %u\n", &root_id) != 1 ||
+	    fscanf(fp, "mc %u.%u.%u\n", &major, &minor, &revision) != 3)
+		goto out;
+
+	if (strcmp(boot_id, saved_boot_id) != 0 ||
+	    strlen(device_file) >= DEV_FILE_SIZE)
+		goto out;
+
+	if (ctx->specified_dev_file[0] != '\0' &&
+	    (strncmp(device_file, "/dev/", 5) != 0 ||
+	     strcmp(&device_file[5], ctx->specified_dev_file) != 0))
+		goto out;
+
+	if (stat(device_file, &st) < 0 ||
+	    st.st_ino != ino || st.st_rdev != rdev)
+		goto out;
+
+	strcpy(ctx->device_file, device_file);
+	ctx->root_dprc_id = root_id;
+	ctx->mc_fw_version.major = major;
+	ctx->mc_fw_version.minor = minor;
+	ctx->mc_fw_version.revision = revision;
+	valid = true;
+out:
+	fclose(fp);
+	DEBUG_PRINTF("%s %s\n", valid ? "using" : "ignoring",
+		     STARTUP_STATE_FILE);
+	return valid;
+}
+
+static void save_startup_state(struct restool *ctx)
+{
+	char tmp_file[] = STARTUP_STATE_FILE ".XXXXXX";
+	char boot_id[BOOT_ID_SIZE];
+	struct stat st;
+	FILE *fp;
+	int fd;
+
+	if (read_boot_id(boot_id) < 0 || stat(ctx->device_file, &st) < 0)
+		return;
+
+	(void)mkdir(RESTOOL_RUN_DIR, 0755);
+	fd = mkstemp(tmp_file);
+	if (fd < 0) {
+		DEBUG_PRINTF("cannot create %s: %s\n", tmp_file,
+			     strerror(errno));
+		return;
+	}
+
+	(void)fchmod(fd, 0644);
+	fp = fdopen(fd, "w");
+	if (fp == NULL) {
+		close(fd);
+		unlink(tmp_file);
+		return;
+	}
+
+	fprintf(fp, "boot %s\n", boot_id);
+	fprintf(fp, "device %s %llu %llu\n", ctx->device_file,
+		(unsigned long long)st.st_ino,
+		(unsigned long long)st.st_rdev);
+	fprintf(fp, "root %u\n", ctx->root_dprc_id);
+	fprintf(fp, "mc %u.%u.%u\n",
+		ctx->mc_fw_version.major,
+		ctx->mc_fw_version.minor,
+		ctx->mc_fw_version.revision);
+
+	if (fclose(fp) != 0 || rename(tmp_file, STARTUP_STATE_FILE) < 0) {
+		DEBUG_PRINTF("cannot write %s: %s\n", STARTUP_STATE_FILE,
+			     strerror(errno));
+		unlink(tmp_file);
+	}
+}
+
+static int open_root_container(struct restool *ctx, bool root_id_known)
 {
 	int error;
 	uint32_t root_dprc_id;
 
-	if (strcmp(restool.device_file, "/dev/mc_restool") == 0) {
+	if (root_id_known) {
+		root_dprc_id = ctx->root_dprc_id;
+	} else if (strcmp(ctx->device_file, "/dev/mc_restool") == 0) {
 		DEBUG_PRINTF("calling ioctl(RESTOOL_GET_ROOT_DPRC_INFO)\n");
-		error = ioctl(restool.mc_io.fd,
+		error = ioctl(ctx->mc_io.fd,
 			      RESTOOL_GET_ROOT_DPRC_INFO,
 			      &root_dprc_id);
 		if (error == -1) {
@@ -1274,14 +2102,14 @@ static int open_root_container(void)
 		DEBUG_PRINTF("ioctl returned MC-bus's root_dprc_id: %#x\n",
 			     root_dprc_id);
 	} else {
-		char *dev_file = restool.device_file;
+		char *dev_file = ctx->device_file;
 
 		root_dprc_id = atoi(&dev_file[10]);
 	}
 
-	restool.root_dprc_id = root_dprc_id;
-	error = open_dprc(restool.root_dprc_id,
-			  &restool.root_dprc_handle);
+	ctx->root_dprc_id = root_dprc_id;
+	error = open_dprc(ctx, ctx->root_dprc_id,
+			  &ctx->root_dprc_handle);
 	return error;
 }
 
@@ -1293,7 +2121,11 @@ static int get_endianness(void) {
 	return BIG_ENDIAN;
 }
 
-int main(int argc, char *argv[])
+/**
+ * Runs one restool command line. ctx is the state of the request and is
+ * initialized here, concurrent requests each need their own.
+ */
+int restool_run(struct restool *ctx, int argc, char *argv[])
 {
 	int error;
 	int next_argv_index;
@@ -1302,39 +2134,92 @@ int main(int argc, char *argv[])
 	bool mc_io_initialized = false;
 	bool root_dprc_opened = false;
 	bool talk_to_mc = true;
+	bool state_loaded;
 
+	memset(ctx, 0, sizeof(*ctx));
+	ctx->info_fields = INFO_FIELDS_ALL;
+	ctx->lock.fd = -1;
+
+	restool_debug = false;
 	#ifdef DEBUG
-	restool.debug = true;
+	restool_debug = true;
 	#endif
 
-	memset(restool.specified_dev_file, '\0', USR_DEV_FILE_SIZE);
-
-	error = parse_global_options(argc, argv, &next_argv_index);
+	pthread_mutex_lock(&getopt_lock);
+	error = parse_global_options(ctx, argc, argv, &next_argv_index);
+	pthread_mutex_unlock(&getopt_lock);
 	if (error < 0)
 		goto out;
 
-	error = get_device_file();
-	if (error < 0)
-		goto out;
+	if (ctx->global_option_mask & ONE_BIT_MASK(GLOBAL_OPT_TRACE)) {
+		ctx->global_option_mask &= ~ONE_BIT_MASK(GLOBAL_OPT_TRACE);
+		error = trace_open(
+			ctx->global_option_args[GLOBAL_OPT_TRACE]);
+		if (error < 0)
+			goto out;
+	}
+
+	ctx->retry_wait_ms = MC_RETRY_DEFAULT_WAIT_MS;
+	ctx->retry_seed = time(NULL) ^ getpid() ^ (uintptr_t)ctx;
+	if (ctx->global_option_mask & ONE_BIT_MASK(GLOBAL_OPT_RETRY_WAIT)) {
+		ctx->global_option_mask &=
+			~ONE_BIT_MASK(GLOBAL_OPT_RETRY_WAIT);
+		error = parse_retry_wait(ctx,
+			ctx->global_option_args[GLOBAL_OPT_RETRY_WAIT]);
+		if (error < 0)
+			goto out;
+	}
+
+	if (ctx->global_option_mask & ONE_BIT_MASK(GLOBAL_OPT_PRIORITY)) {
+		ctx->global_option_mask &= ~ONE_BIT_MASK(GLOBAL_OPT_PRIORITY);
+		error = parse_priority(ctx,
+			ctx->global_option_args[GLOBAL_OPT_PRIORITY]);
+		if (error < 0)
+			goto out;
+	}
+
+	if (ctx->global_option_mask & ONE_BIT_MASK(GLOBAL_OPT_DMA_PHYS)) {
+		ctx->global_option_mask &= ~ONE_BIT_MASK(GLOBAL_OPT_DMA_PHYS);
+		ctx->dma_phys = true;
+	}
+
+	/* until the command is known */
+	ctx->cmd_flags = cmd_priority_flags(ctx, CMD_PRIORITY_NORMAL);
+
+	state_loaded = load_startup_state(ctx);
+	if (!state_loaded) {
+		trace_begin("get_device_file");
+		error = get_device_file(ctx);
+		trace_end();
+		if (error < 0)
+			goto out;
+	}
 
 	DEBUG_PRINTF("restool built on " __DATE__ " " __TIME__ "\n");
-	error = mc_io_init(&restool.mc_io);
+	trace_begin("mc_io_init");
+	error = mc_io_init(&ctx->mc_io);
+	trace_end();
 	if (error != 0)
 		goto out;
 
 	mc_io_initialized = true;
-	DEBUG_PRINTF("restool.mc_io.fd: %d\n", restool.mc_io.fd);
-
-	error = mc_get_version(&restool.mc_io, 0,
-				&restool.mc_fw_version);
-	if (error != 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			mc_status_to_string(mc_status), mc_status);
-		goto out;
+	DEBUG_PRINTF("ctx->mc_io.fd: %d\n", ctx->mc_io.fd);
+
+	if (!state_loaded) {
+		trace_begin("mc_get_version");
+		error = mc_get_version(&ctx->mc_io, ctx->cmd_flags,
+				       &ctx->mc_fw_version);
+		trace_end();
+		if (error != 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				mc_status_to_string(ctx->mc_status),
+				ctx->mc_status);
+			goto out;
+		}
 	}
 
-	if (restool.mc_fw_version.major < 9) {
+	if (ctx->mc_fw_version.major < 9) {
 		ERROR_PRINTF("This version of restool does no longer support MC\
 			     firmware versions lower than v9. \
 			     Please use restool v1.5\n");
@@ -1342,16 +2227,18 @@ int main(int argc, char *argv[])
 	}
 
 	// MC versions lower or equal to V9 are not big-endian compatible
-	if (restool.mc_fw_version.major <= 9 && get_endianness() == BIG_ENDIAN){
+	if (ctx->mc_fw_version.major <= 9 && get_endianness() == BIG_ENDIAN){
 		ERROR_PRINTF("Restool does not support MC versions lower than \
 				V10 on big-endian systems. Please upgrade your \
 				MC binary\n");
 	}
 
 	DEBUG_PRINTF("MC firmware version: %u.%u.%u\n",
-		     restool.mc_fw_version.major,
-		     restool.mc_fw_version.minor,
-		     restool.mc_fw_version.revision);
+		     ctx->mc_fw_version.major,
+		     ctx->mc_fw_version.minor,
+		     ctx->mc_fw_version.revision);
+
+	load_api_version_cache(ctx);
 
 	for (int i = 0; i < argc; i++) {
 		if (strcmp(argv[i], "-v") == 0 ||
@@ -1369,13 +2256,22 @@ int main(int argc, char *argv[])
 	DEBUG_PRINTF("talk_to_mc = %d\n", talk_to_mc);
 	if (talk_to_mc) {
 
-		error = open_root_container();
+		trace_begin("open_root_container");
+		error = open_root_container(ctx, state_loaded);
+		trace_end();
 
 		if (error < 0)
 			goto out;
 
+		/*
+		 * A --root container is a one-off choice, a later run
+		 * without --root must still find the default one
+		 */
+		if (!state_loaded && ctx->specified_dev_file[0] == '\0')
+			save_startup_state(ctx);
+
 		DEBUG_PRINTF("newly opened restool's root_dprc_handle: %#x\n",
-			     restool.root_dprc_handle);
+			     ctx->root_dprc_handle);
 		root_dprc_opened = true;
 	}
 
@@ -1383,82 +2279,99 @@ int main(int argc, char *argv[])
 		goto out;
 
 	if (next_argv_index == argc) {
-		if (restool.global_option_mask == 0) {
+		if (ctx->global_option_mask == 0) {
 			ERROR_PRINTF("Incomplete command line\n");
 			print_try_help();
 			error = -EINVAL;
 			goto out;
 		}
 
-		if (restool.global_option_mask &
+		if (ctx->global_option_mask &
 		    ONE_BIT_MASK(GLOBAL_OPT_HELP)) {
-			if (restool.mc_fw_version.major == 8)
-				print_usage();
-			else if (restool.mc_fw_version.major == 9)
-				print_usage_v9();
-			else if (restool.mc_fw_version.major == 10)
-				print_usage_v9();
+			if (ctx->mc_fw_version.major == 8)
+				print_usage(ctx);
+			else if (ctx->mc_fw_version.major == 9)
+				print_usage_v9(ctx);
+			else if (ctx->mc_fw_version.major == 10)
+				print_usage_v10(ctx);
 		}
 
-		if (restool.global_option_mask &
+		if (ctx->global_option_mask &
 		    ONE_BIT_MASK(GLOBAL_OPT_VERSION))
-			print_version();
+			print_version(ctx);
 
-		if (restool.global_option_mask &
+		if (ctx->global_option_mask &
 		    ONE_BIT_MASK(GLOBAL_OPT_MC_VERSION))
-			print_mc_version();
+			print_mc_version(ctx);
 
-		if (restool.global_option_mask &
+		if (ctx->global_option_mask &
 		    ONE_BIT_MASK(GLOBAL_OPT_DEBUG)) {
-			restool.global_option_mask &=
+			ctx->global_option_mask &=
 				~ONE_BIT_MASK(GLOBAL_OPT_DEBUG);
 			print_try_help();
 			error = -EINVAL;
 			goto out;
 		}
 
-		if (restool.global_option_mask &
+		if (ctx->global_option_mask &
 		    ONE_BIT_MASK(GLOBAL_OPT_SCRIPT)) {
-			restool.global_option_mask &=
+			ctx->global_option_mask &=
 				~ONE_BIT_MASK(GLOBAL_OPT_SCRIPT);
 			print_try_help();
 			error = -EINVAL;
 			goto out;
 		}
 
-		if (restool.global_option_mask != 0) {
+		if (ctx->global_option_mask != 0) {
 			print_unexpected_options_error(
-				restool.global_option_mask,
+				ctx->global_option_mask,
 				global_options);
 			error = -EINVAL;
 		}
 	} else {
-		if (restool.global_option_mask &
+		if (ctx->global_option_mask &
 		    ONE_BIT_MASK(GLOBAL_OPT_DEBUG)) {
-			restool.global_option_mask &=
+			ctx->global_option_mask &=
 				~ONE_BIT_MASK(GLOBAL_OPT_DEBUG);
-			restool.debug = true;
+			restool_debug = true;
 		}
 
-		if (restool.global_option_mask &
+		if (ctx->global_option_mask &
 		    ONE_BIT_MASK(GLOBAL_OPT_SCRIPT)) {
-			restool.global_option_mask &=
+			ctx->global_option_mask &=
 				~ONE_BIT_MASK(GLOBAL_OPT_SCRIPT);
-			restool.script = true;
+			ctx->script = true;
 		}
 
-		if (restool.global_option_mask &
+		if (ctx->global_option_mask &
 		    ONE_BIT_MASK(GLOBAL_OPT_ROOT)) {
-			restool.global_option_mask &=
+			ctx->global_option_mask &=
 				~ONE_BIT_MASK(GLOBAL_OPT_ROOT);
 		}
 
+		if (ctx->global_option_mask &
+		    ONE_BIT_MASK(GLOBAL_OPT_OUTPUT)) {
+			ctx->global_option_mask &=
+				~ONE_BIT_MASK(GLOBAL_OPT_OUTPUT);
+			error = output_set_format(
+				ctx->global_option_args[GLOBAL_OPT_OUTPUT]);
+			if (error < 0)
+				goto out;
+
+			if (output_is_json() &&
+			    ctx->mc_fw_version.major < MC_FW_VERSION_10) {
+				ERROR_PRINTF("--output=json requires MC firmware 10.x or newer\n");
+				error = -EINVAL;
+				goto out;
+			}
+		}
+
 		int num_remaining_args;
 
 		assert(next_argv_index < argc);
-		if (restool.global_option_mask != 0) {
+		if (ctx->global_option_mask != 0) {
 			print_unexpected_options_error(
-				restool.global_option_mask,
+				ctx->global_option_mask,
 				global_options);
 			print_try_help();
 			error = -EINVAL;
@@ -1466,6 +2379,18 @@ int main(int argc, char *argv[])
 		}
 
 		num_remaining_args = argc - next_argv_index;
+		obj_type = argv[next_argv_index];
+		if (is_standalone_obj(obj_type)) {
+			error = parse_obj_command(ctx, obj_type,
+						  obj_type,
+						  num_remaining_args,
+						  &argv[next_argv_index]);
+			if (error < 0)
+				goto out;
+
+			goto rescan;
+		}
+
 		if (num_remaining_args < 2) {
 			ERROR_PRINTF("Incomplete command line\n");
 			print_try_help();
@@ -1473,9 +2398,8 @@ int main(int argc, char *argv[])
 			goto out;
 		}
 
-		obj_type = argv[next_argv_index];
 		cmd_name = argv[next_argv_index + 1];
-		error = parse_obj_command(obj_type,
+		error = parse_obj_command(ctx, obj_type,
 					  cmd_name,
 					  num_remaining_args - 1,
 					  &argv[next_argv_index + 1]);
@@ -1483,8 +2407,11 @@ int main(int argc, char *argv[])
 			goto out;
 	}
 
+rescan:
 	DEBUG_PRINTF("calling sytem()\n");
+	trace_begin("sysfs rescan");
 	error = system("echo 1 > /sys/bus/fsl-mc/rescan");
+	trace_end();
 	if (error == -1) {
 		error = -errno;
 		DEBUG_PRINTF(
@@ -1493,22 +2420,27 @@ int main(int argc, char *argv[])
 	}
 
 out:
+	output_finish();
 	if (root_dprc_opened) {
 		int error2;
 
-		error2 = dprc_close(&restool.mc_io, 0,
-					restool.root_dprc_handle);
+		error2 = dprc_close(&ctx->mc_io, ctx->cmd_flags,
+					ctx->root_dprc_handle);
 		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
+			ctx->mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				mc_status_to_string(mc_status), mc_status);
+				mc_status_to_string(ctx->mc_status),
+				ctx->mc_status);
 			if (error == 0)
 				error = error2;
 		}
 	}
 	if (mc_io_initialized)
-		mc_io_cleanup(&restool.mc_io);
+		mc_io_cleanup(&ctx->mc_io);
+
+	mc_retry_report(ctx);
 
+	trace_close();
 	return error;
 }
 
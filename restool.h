@@ -36,13 +36,20 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <unistd.h>
 #include <limits.h>
+#include <signal.h>
+#include <time.h>
 #include "mc_v10/fsl_mc_cmd.h"
 #include "mc_v10/fsl_dprc.h"
 #include "mc_v10/fsl_dpmng.h"
 #include "fsl_mc_sys.h"
 #include "fsl_mc_ioctl.h"
+#include "output.h"
+#include "trace.h"
+#include "container_lock.h"
+#include "mc_retry.h"
 
 #define MC_FW_VERSION_9		9
 #define MC_FW_VERSION_10	10
@@ -58,9 +65,9 @@
 #define RES_TYPE_MAX_LENGTH	15
 
 /**
- * Max length of a device file
+ * Max length of a device file, including the null terminator
  */
-#define DEV_FILE_SIZE		15
+#define DEV_FILE_SIZE		16
 
 /**
  * Max accepted size for a user specified device file
@@ -87,24 +94,38 @@
  */
 #define EP_OBJ_TYPE_MAX_LEN 15
 
+/**
+ * Directory holding the state restool keeps between runs
+ */
+#define RESTOOL_RUN_DIR		"/run/restool"
+
+/**
+ * The v9 flib takes the MC command flags where they sit in the first
+ * header word, the v10 flib as the values of the flag bytes
+ */
+#define MC_CMD_FLAG_PRI_V9	0x00008000
+#define MC_CMD_FLAG_INTR_DIS_V9	0x01000000
+
 /**
  * MC command high priority flag, original definition is too long
- * to be an appropriate pass-in parameter for each flib API
+ * to be an appropriate pass-in parameter for each flib API.
+ * Understood by both flib versions.
  */
-#define PRI MC_CMD_FLAG_PRI
+#define PRI (MC_CMD_FLAG_PRI | MC_CMD_FLAG_PRI_V9)
 
 /**
  * MC command command completion flag, original definition is too long
- * to be an appropriate pass-in parameter for each flib API
+ * to be an appropriate pass-in parameter for each flib API.
+ * Understood by both flib versions.
  */
-#define INTR MC_CMD_FLAG_INTR_DIS
+#define INTR (MC_CMD_FLAG_INTR_DIS | MC_CMD_FLAG_INTR_DIS_V9)
 
 /**
  * MC command high priority and command completion flag,
  * original definition is too long
  * to be an appropriate pass-in parameter for each flib API
  */
-#define PRINTR (MC_CMD_FLAG_PRI | INTR MC_CMD_FLAG_INTR_DIS)
+#define PRINTR (PRI | INTR)
 
 /*
  * TODO: Obtain the following constants from the fsl-mc bus driver via an ioctl
@@ -119,7 +140,16 @@
 
 struct restool;
 
-typedef int restool_cmd_func_t(void);
+typedef int restool_cmd_func_t(struct restool *ctx);
+
+/**
+ * Priority class of a command: the MC commands it sends carry PRI when it
+ * is high
+ */
+enum cmd_priority {
+	CMD_PRIORITY_NORMAL = 0,
+	CMD_PRIORITY_HIGH,
+};
 
 struct object_command {
 	/**
@@ -136,6 +166,12 @@ struct object_command {
 	 * Pointer to command function
 	 */
 	restool_cmd_func_t *cmd_func;
+
+	/**
+	 * CMD_PRIORITY_HIGH for monitoring reads and teardown, which must not
+	 * queue behind bulk provisioning
+	 */
+	enum cmd_priority priority;
 };
 
 /**
@@ -166,6 +202,12 @@ struct object_cmd_parser {
 	 * Pointer to array of command/version mappings for the object type
 	 */
 	const struct obj_command_versions *obj_commands_versions;
+
+	/**
+	 * standalone object-types take no <command> argument, the command
+	 * named after the object-type is run instead (e.g. restool monitor)
+	 */
+	bool standalone;
 };
 
 /**
@@ -181,6 +223,13 @@ struct lut_entry {
 	 * array of the different MC Versions this object is found in
 	 */
 	struct version_table *versions_table;
+
+	/**
+	 * API version reported by the MC for this object type, 0 if not
+	 * known yet. Filled by get_obj_api_version() and from the cache file.
+	 */
+	uint16_t api_major;
+	uint16_t api_minor;
 };
 /**
  * holds the MC version as well as the corresponding object version
@@ -198,7 +247,8 @@ struct version_table {
 };
 
 /**
- * Global state of the restool tool
+ * State of one restool request. restool_run() takes it from the caller,
+ * so requests on different threads each use their own.
  */
 struct restool {
 	/**
@@ -253,11 +303,6 @@ struct restool {
 	 */
 	uint16_t root_dprc_handle;
 
-	/**
-	 * global flag to enable debug printing
-	 */
-	bool debug;
-
 	/**
 	 * global flag to enable script printing
 	 * it only print out created object name
@@ -275,8 +320,102 @@ struct restool {
 	 */
 	char specified_dev_file[USR_DEV_FILE_SIZE];
 
+	/**
+	 * Bit mask of the info_field values printed by info commands
+	 */
+	uint32_t info_fields;
+
+	/**
+	 * Status of the last MC command that failed
+	 */
+	enum mc_cmd_status mc_status;
+
+	/**
+	 * The MC firmware does not implement dprc_get_obj_desc(), objects
+	 * are looked up by scanning their container
+	 */
+	bool no_get_obj_desc;
+
+	/**
+	 * Container locks held by this request
+	 */
+	struct container_lock lock;
+
+	/**
+	 * Priority class set with --priority, overriding the one of the
+	 * command
+	 */
+	bool priority_set;
+	enum cmd_priority priority;
+
+	/**
+	 * cmd_flags passed to the flib for the MC commands of this request
+	 */
+	uint32_t cmd_flags;
+
+	/**
+	 * Longest time an MC command is retried while the MC is busy, in
+	 * milliseconds (--retry-wait)
+	 */
+	unsigned int retry_wait_ms;
+
+	/**
+	 * rand_r() state for the backoff jitter
+	 */
+	unsigned int retry_seed;
+
+	/**
+	 * Number of MC command retries and time spent backing off
+	 */
+	unsigned long mc_retries;
+	uint64_t mc_retry_wait_us;
+
+	/**
+	 * Command extensions may be handed to the MC by physical address
+	 * (--dma-phys)
+	 */
+	bool dma_phys;
+
+	/**
+	 * Set by the caller, e.g. from another thread, to end a running
+	 * monitor, top or stats record command at its next pass; cleared
+	 * when the command returns
+	 */
+	volatile sig_atomic_t stop;
 };
 
+/**
+ * Returns the request owning the MC portal session, the flib only hands
+ * mc_io down to mc_send_command()
+ */
+static inline struct restool *restool_from_mc_io(struct fsl_mc_io *mc_io)
+{
+	return (struct restool *)((char *)mc_io -
+				  offsetof(struct restool, mc_io));
+}
+
+/**
+ * Output fields of the info commands, selected with --fields. Only the
+ * MC commands needed by the selected fields are sent.
+ */
+enum info_field {
+	INFO_FIELD_VERSION = 0,	/* object API version */
+	INFO_FIELD_ID,		/* object id */
+	INFO_FIELD_STATE,	/* plugged state */
+	INFO_FIELD_ENDPOINT,	/* connected object */
+	INFO_FIELD_LINK,	/* link state */
+	INFO_FIELD_MAC,		/* primary MAC address */
+	INFO_FIELD_ATTR,	/* object attributes */
+	INFO_FIELD_STATS,	/* counters */
+	INFO_FIELD_LABEL,	/* object label */
+	INFO_FIELD_NUM
+};
+
+#define INFO_FIELDS_ALL		(ONE_BIT_MASK(INFO_FIELD_NUM) - 1)
+
+#define INFO_FIELD(_field) \
+	((ctx->info_fields & ONE_BIT_MASK(INFO_FIELD_##_field)) != 0)
+
 /**
  * Command-line option indices for global restool options
  */
@@ -286,7 +425,12 @@ enum global_options {
 	GLOBAL_OPT_MC_VERSION,
 	GLOBAL_OPT_DEBUG,
 	GLOBAL_OPT_SCRIPT,
-	GLOBAL_OPT_ROOT
+	GLOBAL_OPT_ROOT,
+	GLOBAL_OPT_OUTPUT,
+	GLOBAL_OPT_TRACE,
+	GLOBAL_OPT_RETRY_WAIT,
+	GLOBAL_OPT_PRIORITY,
+	GLOBAL_OPT_DMA_PHYS,
 };
 
 /* object option map entry */
@@ -336,7 +480,7 @@ int parse_generic_create_options(char *options_str,
 				 struct option_entry options_map[],
 				 unsigned int num_options);
 
-int get_option_value(int option, long *value,
+int get_option_value(struct restool *ctx, int option, long *value,
 		     const char *error_msg,
 		     long min, long max);
 
@@ -348,32 +492,71 @@ enum mc_cmd_status flib_error_to_mc_status(int error);
 void print_unexpected_options_error(uint32_t option_mask,
 				    const struct option *options);
 
-void print_obj_label(struct dprc_obj_desc *target_obj_desc);
+void print_obj_label(struct restool *ctx,
+		     struct dprc_obj_desc *target_obj_desc);
 
-int print_obj_verbose(struct dprc_obj_desc *target_obj_desc,
+int print_obj_verbose(struct restool *ctx,
+		      struct dprc_obj_desc *target_obj_desc,
 		      const struct flib_ops *ops);
 
-void print_new_obj(char *type, int id, const char *parent);
+void print_new_obj(struct restool *ctx, char *type, int id, const char *parent);
+void print_destroyed_obj(const char *type, uint32_t id);
 
 /* functions used to handle generic object handling */
-int open_dprc(uint32_t dprc_id, uint16_t *dprc_handle);
+int open_dprc(struct restool *ctx, uint32_t dprc_id, uint16_t *dprc_handle);
+
+bool get_child_obj_desc(struct restool *ctx, uint16_t dprc_handle,
+			const char *obj_type, uint32_t obj_id,
+			struct dprc_obj_desc *obj_desc);
 
-int find_target_obj_desc(uint32_t dprc_id, uint16_t dprc_handle,
+int find_target_obj_desc(struct restool *ctx, uint32_t dprc_id,
+			 uint16_t dprc_handle,
 			int nesting_level,
 			uint32_t target_id, char *target_type,
 			struct dprc_obj_desc *target_obj_desc,
 			uint32_t *target_parent_dprc_id, bool *found);
 
-bool find_obj(char *obj_type, uint32_t obj_id);
+bool find_obj(struct restool *ctx, char *obj_type, uint32_t obj_id);
 
 int check_resource_type(char *res_type);
 
 bool in_use(const char *obj, const char *situation);
 
-int get_parent_dprc_id(uint32_t obj_id, char *obj_type,
+int get_parent_dprc_id(struct restool *ctx, uint32_t obj_id, char *obj_type,
 		       uint32_t *parent_dprc_id);
+int parse_info_fields(struct restool *ctx, const char *fields);
+
+/**
+ * Signature shared by the <obj>_get_api_version_v10() flib functions
+ */
+typedef int get_api_version_t(struct fsl_mc_io *mc_io, uint32_t cmd_flags,
+			      uint16_t *major_ver, uint16_t *minor_ver);
+
+int get_obj_api_version(struct restool *ctx, const char *obj_type,
+			get_api_version_t *get_api_version,
+			uint16_t *major_ver, uint16_t *minor_ver);
+void load_api_version_cache(struct restool *ctx);
+int find_info_obj_desc(struct restool *ctx, uint32_t obj_id, char *obj_type,
+		       bool verbose,
+		       struct dprc_obj_desc *obj_desc);
+
+/**
+ * Callback invoked by walk_dprc_tree() for each object found
+ */
+typedef int walk_obj_cb_t(struct restool *ctx,
+			  uint32_t parent_dprc_id,
+			  uint16_t parent_dprc_handle,
+			  struct dprc_obj_desc *obj_desc,
+			  void *arg);
+
+int walk_dprc_tree(struct restool *ctx, uint32_t dprc_id, uint16_t dprc_handle,
+		   int nesting_level, walk_obj_cb_t *cb, void *arg);
+
+void block_stop_signals(sigset_t *old_mask);
+void unblock_stop_signals(struct restool *ctx, const sigset_t *old_mask);
+bool wait_stop(struct restool *ctx, const struct timespec *timeout);
 
-extern struct restool restool;
+int restool_run(struct restool *ctx, int argc, char *argv[]);
 
 /* command maps for all MC objects */
 extern struct object_command dpaiop_commands_v9[];
@@ -421,5 +604,8 @@ extern struct object_command dpsw_commands[];
 extern struct object_command dpsw_commands_v9[];
 extern struct object_command dpsw_commands_v10[];
 extern struct object_command dpdbg_commands[];
+extern struct object_command monitor_commands[];
+extern struct object_command top_commands[];
+extern struct object_command stats_commands[];
 
 #endif /* _RESTOOL_H_ */
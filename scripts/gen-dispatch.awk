@@ -0,0 +1,355 @@
+# Copyright 2018 NXP
+
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+# * Redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer.
+# * Redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution.
+# * Neither the name of the above-listed copyright holders nor the
+# names of any contributors may be used to endorse or promote products
+# derived from this software without specific prior written permission.
+
+
+# ALTERNATIVELY, this software may be distributed under the terms of the
+# GNU General Public License ("GPL") as published by the Free Software
+# Foundation, either version 2 of that License or (at your option) any
+# later version.
+
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+# Generates dispatch_table.c, the perfect hash table of dispatch.h, from
+# the command tables: awk -f gen-dispatch.awk restool.c *_commands.c
+#
+# restool.c provides version_lut[], the obj_command_versions tables and
+# object_cmd_parsers[]; every other file provides its object_command
+# tables and the option tables and enums they point to. The tables must
+# keep the one-initializer-per-line layout they are written in.
+#
+# The hash is a two-level hash-and-displace scheme: the key hashed with
+# multiplier 31 picks a bucket, and the bucket's displacement picks the
+# multiplier that places each of its keys in a free slot. The hash must
+# match dispatch_hash() in dispatch.h.
+
+function fail(msg)
+{
+	printf("gen-dispatch: %s:%d: %s\n", FILENAME, FNR, msg) > "/dev/stderr"
+	failed = 1
+	exit 1
+}
+
+function quoted(str)
+{
+	if (!match(str, /"[^"]*"/))
+		fail("quoted string expected")
+	return substr(str, RSTART + 1, RLENGTH - 2)
+}
+
+# value of ".field = <identifier or number>" on the line
+function ident(str, field)
+{
+	if (!match(str, "\\." field " = [A-Za-z0-9_]+"))
+		fail("." field " expected")
+	return substr(str, RSTART + length(field) + 4,
+		      RLENGTH - length(field) - 4)
+}
+
+function hash(mult, obj, ver, cmd,	h, i)
+{
+	h = 0
+	for (i = 1; i <= length(obj); i++)
+		h = (h * mult + ord[substr(obj, i, 1)]) % HASH_MOD
+	h = (h * mult + 47) % HASH_MOD
+	h = (h * mult + ver) % HASH_MOD
+	h = (h * mult + 47) % HASH_MOD
+	for (i = 1; i <= length(cmd); i++)
+		h = (h * mult + ord[substr(cmd, i, 1)]) % HASH_MOD
+	return h
+}
+
+function add_key(obj, ver, cmd, ref, mask, lut, standalone)
+{
+	if ((obj, ver, cmd) in key_index)
+		return
+	key_index[obj, ver, cmd] = nkeys
+	key_obj[nkeys] = obj
+	key_ver[nkeys] = ver
+	key_cmd[nkeys] = cmd
+	key_ref[nkeys] = ref
+	key_mask[nkeys] = mask
+	key_lut[nkeys] = lut
+	key_standalone[nkeys] = standalone
+	nkeys++
+}
+
+# bit n set if options[n] of the named option table takes an argument
+function option_mask(file, name)
+{
+	if ((file, name) in opt_bad)
+		fail("unknown option index " opt_bad[file, name] " in " name)
+	if ((file, name) in opt_mask)
+		return opt_mask[file, name]
+	if (name in global_opt_mask)
+		return global_opt_mask[name]
+	fail("unknown option table " name)
+}
+
+BEGIN {
+	HASH_MOD = 65521
+	nkeys = 0
+	# keeps h * mult below 2^32, see dispatch_hash()
+	MAX_MULT = 65000
+
+	for (i = 32; i < 127; i++)
+		ord[sprintf("%c", i)] = i
+}
+
+FNR == 1 {
+	in_enum = 0
+	in_opt = ""
+	in_cmds = ""
+	in_versions = ""
+	in_lut = 0
+	in_parsers = 0
+}
+
+/^};/ {
+	in_enum = 0
+	in_opt = ""
+	in_cmds = ""
+	in_versions = ""
+	in_lut = 0
+	in_parsers = 0
+	next
+}
+
+/^enum [a-z0-9_]+ {/ {
+	in_enum = 1
+	enum_val = -1
+	next
+}
+
+in_enum && /^\t[A-Z][A-Z0-9_]*( = [0-9]+)?,?/ {
+	name = $1
+	sub(/,.*/, "", name)
+	if ($2 == "=") {
+		enum_val = $3
+		sub(/,.*/, "", enum_val)
+		enum_val += 0
+	} else {
+		enum_val++
+	}
+	enum_value[FILENAME, name] = enum_val
+	next
+}
+
+/struct option [a-z0-9_]+\[\] = {/ {
+	in_opt = $0
+	sub(/\[\].*/, "", in_opt)
+	sub(/.* /, "", in_opt)
+	opt_static = $1 == "static"
+	opt_mask[FILENAME, in_opt] = 0
+	opt_pos = -1
+	next
+}
+
+in_opt != "" && /^\t\[[A-Z0-9_]+\] = {/ {
+	name = $1
+	gsub(/[\[\]]/, "", name)
+	# e.g. an enum from a header; only fatal if a command uses the table
+	if (!((FILENAME, name) in enum_value))
+		opt_bad[FILENAME, in_opt] = name
+	opt_pos = enum_value[FILENAME, name]
+	next
+}
+
+in_opt != "" && /^\t{$/ {
+	opt_pos++
+	next
+}
+
+in_opt != "" && /\.has_arg = / {
+	if ($0 ~ /\.has_arg = (0|no_argument),/)
+		next
+	if (opt_pos < 0)
+		fail("option entry expected")
+	if ((FILENAME, in_opt) in opt_bad)
+		next
+	opt_mask[FILENAME, in_opt] += 2 ^ opt_pos
+	if (!opt_static)
+		global_opt_mask[in_opt] = opt_mask[FILENAME, in_opt]
+	next
+}
+
+/^struct object_command [a-z0-9_]+\[\] = {/ {
+	in_cmds = $3
+	sub(/\[\].*/, "", in_cmds)
+	ncmds[in_cmds] = 0
+	cmds_file[in_cmds] = FILENAME
+	next
+}
+
+in_cmds != "" && /\.cmd_name = "/ {
+	cmd_name[in_cmds, ncmds[in_cmds]] = quoted($0)
+	cmd_options[in_cmds, ncmds[in_cmds]] = "NULL"
+	ncmds[in_cmds]++
+}
+
+in_cmds != "" && /\.options = / {
+	cmd_options[in_cmds, ncmds[in_cmds] - 1] = ident($0, "options")
+	next
+}
+
+/^struct lut_entry version_lut\[\] = {/ {
+	in_lut = 1
+	nlut = 0
+	next
+}
+
+in_lut && /\.object = "/ {
+	lut_index[quoted($0)] = nlut++
+	next
+}
+
+/^static const struct obj_command_versions [a-z0-9_]+\[\] = {/ {
+	in_versions = $5
+	sub(/\[\].*/, "", in_versions)
+	nversions[in_versions] = 0
+	next
+}
+
+in_versions != "" && /\.obj_commands = [a-z]/ {
+	n = nversions[in_versions]++
+	version_num[in_versions, n] = ident($0, "version") + 0
+	version_cmds[in_versions, n] = ident($0, "obj_commands")
+	next
+}
+
+/^const struct object_cmd_parser object_cmd_parsers\[\] = {/ {
+	in_parsers = 1
+	nparsers = 0
+	next
+}
+
+in_parsers && /\.obj_type = "/ {
+	parser_type[nparsers] = quoted($0)
+	parser_versions[nparsers] = ident($0, "obj_commands_versions")
+	parser_standalone[nparsers] = 0
+	nparsers++
+}
+
+in_parsers && /\.standalone = true/ {
+	parser_standalone[nparsers - 1] = 1
+	next
+}
+
+END {
+	if (failed)
+		exit 1
+	if (nparsers == 0 || nlut == 0)
+		fail("object_cmd_parsers[] or version_lut[] not found")
+
+	# keys: (type, 0, "") per object type, (type, version, "") per
+	# command table and (type, version, command) per command
+	for (p = 0; p < nparsers; p++) {
+		obj = parser_type[p]
+		lut = obj in lut_index ? "&version_lut[" lut_index[obj] "]" : \
+		      "NULL"
+		add_key(obj, 0, "", "NULL", 0, lut, parser_standalone[p])
+
+		versions = parser_versions[p]
+		if (!(versions in nversions))
+			fail("unknown command versions table " versions)
+		for (v = 0; v < nversions[versions]; v++) {
+			ver = version_num[versions, v]
+			cmds = version_cmds[versions, v]
+			if (!(cmds in ncmds))
+				fail("unknown command table " cmds)
+			add_key(obj, ver, "", "NULL", 0, "NULL", 0)
+			for (c = 0; c < ncmds[cmds]; c++) {
+				opts = cmd_options[cmds, c]
+				mask = opts == "NULL" ? 0 : \
+				       option_mask(cmds_file[cmds], opts)
+				add_key(obj, ver, cmd_name[cmds, c],
+					"&" cmds "[" c "]", mask, "NULL", 0)
+			}
+		}
+	}
+
+	nbuckets = int(nkeys / 4) + 1
+	nslots = 1
+	while (nslots < nkeys + nkeys / 4)
+		nslots *= 2
+
+	max_size = 0
+	for (k = 0; k < nkeys; k++) {
+		b = hash(31, key_obj[k], key_ver[k], key_cmd[k]) % nbuckets
+		bucket_keys[b, bucket_size[b]++] = k
+		if (bucket_size[b] > max_size)
+			max_size = bucket_size[b]
+	}
+
+	# largest buckets first, while most slots are still free
+	for (size = max_size; size > 0; size--) {
+		for (b = 0; b < nbuckets; b++) {
+			if (bucket_size[b] != size)
+				continue
+
+			for (mult = 32; mult < MAX_MULT; mult++) {
+				split("", taken)
+				ok = 1
+				for (i = 0; i < size && ok; i++) {
+					k = bucket_keys[b, i]
+					s = hash(mult, key_obj[k], key_ver[k],
+						 key_cmd[k]) % nslots
+					if ((s in slot_key) || (s in taken))
+						ok = 0
+					taken[s] = k
+				}
+				if (ok)
+					break
+			}
+			if (!ok)
+				fail("no displacement found for bucket " b)
+
+			displacement[b] = mult
+			for (s in taken)
+				slot_key[s] = taken[s]
+		}
+	}
+
+	print "/* Generated by scripts/gen-dispatch.awk, do not edit */"
+	print "#include \"restool.h\""
+	print "#include \"dispatch.h\""
+	print ""
+	printf("const unsigned int dispatch_num_buckets = %d;\n", nbuckets)
+	printf("const unsigned int dispatch_num_slots = %d;\n", nslots)
+	print ""
+	print "const uint16_t dispatch_displacement[] = {"
+	for (b = 0; b < nbuckets; b++)
+		printf("\t%d,\n", b in displacement ? displacement[b] : 0)
+	print "};"
+	print ""
+	printf("const struct dispatch_entry dispatch_table[%d] = {\n", nslots)
+	for (s = 0; s < nslots; s++) {
+		if (!(s in slot_key))
+			continue
+		k = slot_key[s]
+		printf("\t[%d] = { \"%s\", %d, \"%s\", %s, %s, %.0fu, %s },\n", s,
+		       key_obj[k], key_ver[k], key_cmd[k], key_ref[k],
+		       key_lut[k], key_mask[k],
+		       key_standalone[k] ? "true" : "false")
+	}
+	print "};"
+}
@@ -0,0 +1,900 @@
+/* Copyright 2018 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <assert.h>
+#include <getopt.h>
+#include <signal.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "restool.h"
+#include "utils.h"
+#include "mc_v10/fsl_dprc.h"
+#include "mc_v10/fsl_dpni.h"
+#include "mc_v10/fsl_dpmac.h"
+
+#define STATS_DEFAULT_DIR		RESTOOL_RUN_DIR
+#define STATS_DEFAULT_FILE		STATS_DEFAULT_DIR "/stats.ring"
+#define STATS_DEFAULT_RECORDS		65536
+#define STATS_MAX_RECORDS		(16 * 1024 * 1024)
+#define STATS_DEFAULT_INTERVAL_MS	100
+#define STATS_MAX_INTERVAL_MS		3600000
+
+#define STATS_RING_MAGIC		"RSTLSTAT"
+#define STATS_RING_VERSION		1
+
+/* DPNI statistics pages 0, 1 and 2 */
+#define STATS_DPNI_COUNTERS		17
+#define STATS_MAX_COUNTERS		STATS_DPNI_COUNTERS
+
+enum stats_obj_type {
+	STATS_OBJ_DPNI = 1,
+	STATS_OBJ_DPMAC,
+};
+
+#define STATS_LINK_UNKNOWN		0xff
+
+/**
+ * Ring file header, followed by 'capacity' records
+ * @magic: STATS_RING_MAGIC
+ * @version: STATS_RING_VERSION
+ * @record_size: sizeof(struct stats_record)
+ * @capacity: Number of records in the ring
+ * @head: Number of records ever written; record n lives in slot
+ *	n % capacity
+ */
+struct stats_ring_header {
+	char magic[8];
+	uint32_t version;
+	uint32_t record_size;
+	uint64_t capacity;
+	uint64_t head;
+	uint8_t pad[32];
+};
+
+C_ASSERT(sizeof(struct stats_ring_header) == 64);
+
+/**
+ * Sample of one object
+ * @timestamp: CLOCK_REALTIME in nanoseconds
+ * @seq: Record number + 1, written last; a reader seeing a different
+ *	value than expected skips the slot (empty, torn or overwritten)
+ * @obj_id: Object ID
+ * @obj_type: STATS_OBJ_DPNI or STATS_OBJ_DPMAC
+ * @link: 0 down, 1 up, STATS_LINK_UNKNOWN if it could not be read
+ * @num_counters: Number of valid entries in counters[]
+ * @counters: DPNI statistics pages 0-2, or stats_dpmac_counters[] values
+ */
+struct stats_record {
+	uint64_t timestamp;
+	uint64_t seq;
+	uint32_t obj_id;
+	uint8_t obj_type;
+	uint8_t link;
+	uint16_t num_counters;
+	uint64_t counters[STATS_MAX_COUNTERS];
+};
+
+C_ASSERT(sizeof(struct stats_record) == 160);
+
+static const char * const stats_dpni_names[STATS_DPNI_COUNTERS] = {
+	"ingress_all_frames",
+	"ingress_all_bytes",
+	"ingress_multicast_frames",
+	"ingress_multicast_bytes",
+	"ingress_broadcast_frames",
+	"ingress_broadcast_bytes",
+	"egress_all_frames",
+	"egress_all_bytes",
+	"egress_multicast_frames",
+	"egress_multicast_bytes",
+	"egress_broadcast_frames",
+	"egress_broadcast_bytes",
+	"ingress_filtered_frames",
+	"ingress_discarded_frames",
+	"ingress_nobuffer_discards",
+	"egress_discarded_frames",
+	"egress_confirmed_frames",
+};
+
+/* Number of counters of each DPNI statistics page that are recorded */
+static const int stats_dpni_page_counters[] = { 6, 6, 5 };
+
+static const enum dpmac_counter stats_dpmac_counters[] = {
+	DPMAC_CNT_ING_ALL_FRAME,
+	DPMAC_CNT_ING_BYTE,
+	DPMAC_CNT_ING_GOOD_FRAME,
+	DPMAC_CNT_ING_FRAME_DISCARD,
+	DPMAC_CNT_ING_ERR_FRAME,
+	DPMAC_CNT_ING_VALID_PAUSE_FRAME,
+	DPMAC_CNT_ENG_GOOD_FRAME,
+	DPMAC_CNT_EGR_BYTE,
+	DPMAC_CNT_EGR_ERR_FRAME,
+	DPMAC_CNT_EGR_VALID_PAUSE_FRAME,
+};
+
+static const char * const stats_dpmac_names[] = {
+	"ingress_all_frames",
+	"ingress_bytes",
+	"ingress_good_frames",
+	"ingress_discarded_frames",
+	"ingress_error_frames",
+	"ingress_pause_frames",
+	"egress_good_frames",
+	"egress_bytes",
+	"egress_error_frames",
+	"egress_pause_frames",
+};
+
+C_ASSERT(ARRAY_SIZE(stats_dpmac_counters) == ARRAY_SIZE(stats_dpmac_names));
+C_ASSERT(ARRAY_SIZE(stats_dpmac_counters) <= STATS_MAX_COUNTERS);
+
+/**
+ * stats record command options
+ */
+enum stats_record_options {
+	RECORD_OPT_HELP = 0,
+	RECORD_OPT_FILE,
+	RECORD_OPT_RECORDS,
+	RECORD_OPT_INTERVAL,
+	RECORD_OPT_COUNT,
+};
+
+static struct option stats_record_options[] = {
+	[RECORD_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[RECORD_OPT_FILE] = {
+		.name = "file",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[RECORD_OPT_RECORDS] = {
+		.name = "records",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[RECORD_OPT_INTERVAL] = {
+		.name = "interval",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[RECORD_OPT_COUNT] = {
+		.name = "count",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(stats_record_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * stats dump command options
+ */
+enum stats_dump_options {
+	DUMP_OPT_HELP = 0,
+	DUMP_OPT_FILE,
+	DUMP_OPT_SINCE,
+};
+
+static struct option stats_dump_options[] = {
+	[DUMP_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[DUMP_OPT_FILE] = {
+		.name = "file",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[DUMP_OPT_SINCE] = {
+		.name = "since",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(stats_dump_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * Object sampled by the recorder, its handle is held open
+ */
+struct stats_obj {
+	uint8_t obj_type;
+	int id;
+	uint16_t handle;
+};
+
+static __thread struct stats_obj *stats_objs;
+static __thread int stats_num_objs;
+static __thread int stats_max_objs;
+
+static int cmd_stats_help(struct restool *ctx)
+{
+	static const char help_msg[] =
+		"\n"
+		"Usage: restool stats <command> [--help] [ARGS...]\n"
+		"Where <command> can be:\n"
+		"   record - samples DPNI/DPMAC counters and link states into a\n"
+		"            fixed-size ring file.\n"
+		"   dump - prints the samples held in a ring file.\n"
+		"\n"
+		"For command-specific help, use the --help option of each command.\n"
+		"\n";
+
+	(void)ctx;
+	printf(help_msg);
+	return 0;
+}
+
+static uint64_t stats_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_REALTIME, &now);
+	return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+/**
+ * Maps the ring file. For the recorder (capacity != 0) the file is created
+ * or re-initialized unless it already holds a ring of the same geometry,
+ * in which case recording resumes after the existing records.
+ */
+static struct stats_ring_header *stats_map_ring(const char *path,
+						uint64_t capacity)
+{
+	struct stats_ring_header *hdr = NULL;
+	struct stats_ring_header cur;
+	bool writable = capacity != 0;
+	struct stat st;
+	size_t size;
+	int fd;
+
+	if (writable && strcmp(path, STATS_DEFAULT_FILE) == 0)
+		(void)mkdir(STATS_DEFAULT_DIR, 0755);
+
+	fd = open(path, writable ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+	if (fd < 0) {
+		ERROR_PRINTF("cannot open %s: %s\n", path, strerror(errno));
+		return NULL;
+	}
+
+	memset(&cur, 0, sizeof(cur));
+	if (pread(fd, &cur, sizeof(cur), 0) != sizeof(cur) ||
+	    memcmp(cur.magic, STATS_RING_MAGIC, sizeof(cur.magic)) != 0 ||
+	    cur.version != STATS_RING_VERSION ||
+	    cur.record_size != sizeof(struct stats_record) ||
+	    cur.capacity == 0) {
+		if (!writable) {
+			ERROR_PRINTF("%s is not a stats ring file\n", path);
+			goto out;
+		}
+		memset(&cur, 0, sizeof(cur));
+	} else if (writable && cur.capacity != capacity) {
+		memset(&cur, 0, sizeof(cur));
+	}
+
+	if (writable && cur.capacity == 0) {
+		memcpy(cur.magic, STATS_RING_MAGIC, sizeof(cur.magic));
+		cur.version = STATS_RING_VERSION;
+		cur.record_size = sizeof(struct stats_record);
+		cur.capacity = capacity;
+		cur.head = 0;
+
+		size = sizeof(cur) + capacity * sizeof(struct stats_record);
+		if (ftruncate(fd, 0) < 0 || ftruncate(fd, size) < 0 ||
+		    pwrite(fd, &cur, sizeof(cur), 0) != sizeof(cur)) {
+			ERROR_PRINTF("cannot initialize %s: %s\n",
+				     path, strerror(errno));
+			goto out;
+		}
+	}
+
+	size = sizeof(cur) + cur.capacity * sizeof(struct stats_record);
+	if (fstat(fd, &st) < 0 || (uint64_t)st.st_size < size) {
+		ERROR_PRINTF("%s is truncated\n", path);
+		goto out;
+	}
+
+	hdr = mmap(NULL, size, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+		   MAP_SHARED, fd, 0);
+	if (hdr == MAP_FAILED) {
+		ERROR_PRINTF("cannot map %s: %s\n", path, strerror(errno));
+		hdr = NULL;
+	}
+
+out:
+	close(fd);
+	return hdr;
+}
+
+static void stats_unmap_ring(struct stats_ring_header *hdr)
+{
+	munmap(hdr, sizeof(*hdr) + hdr->capacity * sizeof(struct stats_record));
+}
+
+static inline struct stats_record *
+stats_ring_slot(struct stats_ring_header *hdr, uint64_t n)
+{
+	return (struct stats_record *)(hdr + 1) + n % hdr->capacity;
+}
+
+static int stats_add_cb(struct restool *ctx, uint32_t parent_dprc_id,
+			uint16_t parent_dprc_handle,
+			struct dprc_obj_desc *obj_desc,
+			void *arg)
+{
+	struct stats_obj *obj;
+	int error;
+
+	(void)parent_dprc_id;
+	(void)parent_dprc_handle;
+	(void)arg;
+
+	if (strcmp(obj_desc->type, "dpni") != 0 &&
+	    strcmp(obj_desc->type, "dpmac") != 0)
+		return 0;
+
+	if (stats_num_objs == stats_max_objs) {
+		int max_objs = stats_max_objs ? stats_max_objs * 2 : 32;
+
+		obj = realloc(stats_objs, max_objs * sizeof(*obj));
+		if (obj == NULL) {
+			ERROR_PRINTF("realloc() failed\n");
+			return -ENOMEM;
+		}
+
+		stats_objs = obj;
+		stats_max_objs = max_objs;
+	}
+
+	obj = &stats_objs[stats_num_objs];
+	obj->id = obj_desc->id;
+	if (strcmp(obj_desc->type, "dpni") == 0) {
+		obj->obj_type = STATS_OBJ_DPNI;
+		error = dpni_open_v10(&ctx->mc_io, ctx->cmd_flags, obj->id,
+				      &obj->handle);
+	} else {
+		obj->obj_type = STATS_OBJ_DPMAC;
+		error = dpmac_open_v10(&ctx->mc_io, ctx->cmd_flags, obj->id,
+				       &obj->handle);
+	}
+	if (error < 0) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		return error;
+	}
+
+	stats_num_objs++;
+	return 0;
+}
+
+static int stats_sample_dpni(struct restool *ctx, struct stats_obj *obj,
+			     struct stats_record *rec)
+{
+	struct dpni_link_state_v10 link_state;
+	union dpni_statistics_v10 stats;
+	int n = 0;
+	int error;
+
+	for (unsigned int page = 0;
+	     page < ARRAY_SIZE(stats_dpni_page_counters); page++) {
+		error = dpni_get_statistics_v10(&ctx->mc_io, ctx->cmd_flags,
+						obj->handle,
+						page, 0, &stats);
+		if (error < 0)
+			return error;
+
+		for (int i = 0; i < stats_dpni_page_counters[page]; i++)
+			rec->counters[n++] = stats.raw.counter[i];
+	}
+	rec->num_counters = n;
+
+	error = dpni_get_link_state_v10(&ctx->mc_io, ctx->cmd_flags,
+					obj->handle,
+					&link_state);
+	if (error == 0)
+		rec->link = link_state.up ? 1 : 0;
+
+	return 0;
+}
+
+static int stats_sample_dpmac(struct restool *ctx, struct stats_obj *obj,
+			      struct stats_record *rec)
+{
+	struct dprc_endpoint endpoint1;
+	struct dprc_endpoint endpoint2;
+	int state;
+	int error;
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(stats_dpmac_counters); i++) {
+		error = dpmac_get_counter_v10(&ctx->mc_io, ctx->cmd_flags,
+					      obj->handle,
+					      stats_dpmac_counters[i],
+					      &rec->counters[i]);
+		if (error < 0)
+			return error;
+	}
+	rec->num_counters = ARRAY_SIZE(stats_dpmac_counters);
+
+	memset(&endpoint1, 0, sizeof(struct dprc_endpoint));
+	strcpy(endpoint1.type, "dpmac");
+	endpoint1.id = obj->id;
+	error = dprc_get_connection(&ctx->mc_io, ctx->cmd_flags,
+				    ctx->root_dprc_handle,
+				    &endpoint1, &endpoint2, &state);
+	if (error == 0)
+		rec->link = state == 1 ? 1 : 0;
+
+	return 0;
+}
+
+/**
+ * Closes and forgets object i, e.g. after it was destroyed while being
+ * recorded.
+ */
+static void stats_drop_obj(struct restool *ctx, int i)
+{
+	struct stats_obj *obj = &stats_objs[i];
+
+	if (obj->obj_type == STATS_OBJ_DPNI)
+		(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags, obj->handle);
+	else
+		(void)dpmac_close_v10(&ctx->mc_io, ctx->cmd_flags,
+				      obj->handle);
+
+	stats_num_objs--;
+	memmove(obj, obj + 1, (stats_num_objs - i) * sizeof(*obj));
+}
+
+static void stats_close_all(struct restool *ctx)
+{
+	while (stats_num_objs > 0)
+		stats_drop_obj(ctx, stats_num_objs - 1);
+
+	free(stats_objs);
+	stats_objs = NULL;
+	stats_max_objs = 0;
+}
+
+/**
+ * Writes one record per object straight into the mapped ring; nothing
+ * is allocated here. An object that can no longer be read is dropped
+ * and its slot is reused by the next record.
+ */
+static void stats_sample(struct restool *ctx, struct stats_ring_header *hdr)
+{
+	for (int i = 0; i < stats_num_objs; ) {
+		struct stats_obj *obj = &stats_objs[i];
+		uint64_t n = hdr->head;
+		struct stats_record *rec = stats_ring_slot(hdr, n);
+		int error;
+
+		/*
+		 * invalidate the slot while it is rewritten; the fence keeps
+		 * the record stores below from becoming visible before it
+		 */
+		__atomic_store_n(&rec->seq, 0, __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_RELEASE);
+
+		rec->timestamp = stats_now();
+		rec->obj_id = obj->id;
+		rec->obj_type = obj->obj_type;
+		rec->link = STATS_LINK_UNKNOWN;
+		if (obj->obj_type == STATS_OBJ_DPNI)
+			error = stats_sample_dpni(ctx, obj, rec);
+		else
+			error = stats_sample_dpmac(ctx, obj, rec);
+		if (error < 0) {
+			ctx->mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("%s.%d: MC error: %s (status %#x), "
+				     "no longer recorded\n",
+				     obj->obj_type == STATS_OBJ_DPNI ?
+				     "dpni" : "dpmac", obj->id,
+				     mc_status_to_string(ctx->mc_status),
+				     ctx->mc_status);
+			stats_drop_obj(ctx, i);
+			continue;
+		}
+
+		__atomic_store_n(&rec->seq, n + 1, __ATOMIC_RELEASE);
+		__atomic_store_n(&hdr->head, n + 1, __ATOMIC_RELEASE);
+		i++;
+	}
+}
+
+static int cmd_stats_record(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool stats record [<container>] [--file=<path>]\n"
+		"                            [--records=<n>] [--interval=<ms>]\n"
+		"                            [--count=<n>]\n"
+		"\n"
+		"Samples the counters and link state of all DPNIs and DPMACs in\n"
+		"<container> (root container by default) and its child containers,\n"
+		"appending one record per object to a circular file. The oldest\n"
+		"records are overwritten once the file is full.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--file=<path>\n"
+		"   Ring file. Default is " STATS_DEFAULT_FILE ".\n"
+		"--records=<n>\n"
+		"   Ring capacity in records of 160 bytes. Default is 65536.\n"
+		"   An existing ring of a different capacity is re-initialized.\n"
+		"--interval=<ms>\n"
+		"   Sampling period in milliseconds. Default is 100.\n"
+		"--count=<n>\n"
+		"   Stop after <n> samples. Default is to run until interrupted.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Keep about 10 minutes of history for 10 interfaces:\n"
+		"   $ restool stats record --records=60000 &\n"
+		"\n";
+
+	const char *path = STATS_DEFAULT_FILE;
+	long interval_ms = STATS_DEFAULT_INTERVAL_MS;
+	long capacity = STATS_DEFAULT_RECORDS;
+	long count = 0;
+	struct stats_ring_header *hdr = NULL;
+	sigset_t old_mask;
+	struct timespec next;
+	struct timespec now;
+	struct timespec timeout;
+	uint32_t dprc_id;
+	uint16_t dprc_handle;
+	bool dprc_opened = false;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(RECORD_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(RECORD_OPT_HELP);
+		return 0;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(RECORD_OPT_FILE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(RECORD_OPT_FILE);
+		path = ctx->cmd_option_args[RECORD_OPT_FILE];
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(RECORD_OPT_RECORDS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(RECORD_OPT_RECORDS);
+		error = get_option_value(ctx, RECORD_OPT_RECORDS, &capacity,
+					 "Invalid records value",
+					 1, STATS_MAX_RECORDS);
+		if (error)
+			return -EINVAL;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(RECORD_OPT_INTERVAL)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(RECORD_OPT_INTERVAL);
+		error = get_option_value(ctx, RECORD_OPT_INTERVAL, &interval_ms,
+					 "Invalid interval value",
+					 1, STATS_MAX_INTERVAL_MS);
+		if (error)
+			return -EINVAL;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(RECORD_OPT_COUNT)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(RECORD_OPT_COUNT);
+		error = get_option_value(ctx, RECORD_OPT_COUNT, &count,
+					 "Invalid count value", 1, LONG_MAX);
+		if (error)
+			return -EINVAL;
+	}
+
+	dprc_id = ctx->root_dprc_id;
+	dprc_handle = ctx->root_dprc_handle;
+	if (ctx->obj_name != NULL) {
+		error = parse_object_name(ctx->obj_name, "dprc", &dprc_id);
+		if (error < 0)
+			return error;
+
+		if (dprc_id != ctx->root_dprc_id) {
+			error = open_dprc(ctx, dprc_id, &dprc_handle);
+			if (error < 0)
+				return error;
+			dprc_opened = true;
+		}
+	}
+
+	error = walk_dprc_tree(ctx, dprc_id, dprc_handle, 0, stats_add_cb,
+			       NULL);
+	if (dprc_opened)
+		(void)dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
+	if (error < 0)
+		goto out;
+
+	hdr = stats_map_ring(path, capacity);
+	if (hdr == NULL) {
+		error = -EIO;
+		goto out;
+	}
+
+	block_stop_signals(&old_mask);
+
+	/* absolute deadlines, so that sampling time does not add drift */
+	clock_gettime(CLOCK_MONOTONIC, &next);
+	for (long samples = 0; ; ) {
+		stats_sample(ctx, hdr);
+		if (stats_num_objs == 0) {
+			ERROR_PRINTF("no DPNI or DPMAC left to record\n");
+			error = -ENODEV;
+			break;
+		}
+
+		if (count != 0 && ++samples >= count)
+			break;
+
+		next.tv_nsec += (interval_ms % 1000) * 1000000;
+		next.tv_sec += interval_ms / 1000 + next.tv_nsec / 1000000000;
+		next.tv_nsec %= 1000000000;
+
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		timeout.tv_sec = next.tv_sec - now.tv_sec;
+		timeout.tv_nsec = next.tv_nsec - now.tv_nsec;
+		if (timeout.tv_nsec < 0) {
+			timeout.tv_sec--;
+			timeout.tv_nsec += 1000000000;
+		}
+		if (timeout.tv_sec < 0)
+			timeout.tv_sec = timeout.tv_nsec = 0;
+
+		if (wait_stop(ctx, &timeout))
+			break;
+	}
+	unblock_stop_signals(ctx, &old_mask);
+	if (error < 0)
+		goto out;
+
+	error = 0;
+out:
+	if (hdr != NULL)
+		stats_unmap_ring(hdr);
+	stats_close_all(ctx);
+	return error;
+}
+
+/**
+ * Parses --since: "<n>[s|m|h]" is relative to now, "@<seconds>" is an
+ * absolute epoch time. Returns the CLOCK_REALTIME time in nanoseconds.
+ */
+static int stats_parse_since(const char *str, uint64_t *since)
+{
+	char *endptr;
+	uint64_t mult = 1;
+	long long val;
+
+	errno = 0;
+	if (str[0] == '@') {
+		val = strtoll(str + 1, &endptr, 10);
+		if (STRTOL_ERROR(str + 1, endptr, val, errno) ||
+		    *endptr != '\0' || val < 0)
+			return -EINVAL;
+
+		*since = (uint64_t)val * 1000000000;
+		return 0;
+	}
+
+	val = strtoll(str, &endptr, 10);
+	if (errno != 0 || endptr == str || val < 0)
+		return -EINVAL;
+
+	if (strcmp(endptr, "h") == 0)
+		mult = 3600;
+	else if (strcmp(endptr, "m") == 0)
+		mult = 60;
+	else if (strcmp(endptr, "s") != 0 && *endptr != '\0')
+		return -EINVAL;
+
+	*since = stats_now() - (uint64_t)val * mult * 1000000000;
+	return 0;
+}
+
+static void stats_print_record(const struct stats_record *rec)
+{
+	const char * const *names;
+	const char *link;
+
+	if (rec->obj_type == STATS_OBJ_DPNI)
+		names = stats_dpni_names;
+	else
+		names = stats_dpmac_names;
+
+	if (rec->link == STATS_LINK_UNKNOWN)
+		link = "unknown";
+	else
+		link = rec->link ? "up" : "down";
+
+	if (output_is_json()) {
+		output_begin_object(NULL);
+		output_uint("timestamp_ns", "timestamp",
+			    (unsigned long long)rec->timestamp);
+		output_field("object", "object", "%s.%u",
+			     rec->obj_type == STATS_OBJ_DPNI ? "dpni" : "dpmac",
+			     rec->obj_id);
+		output_field("link", "link", "%s", link);
+		output_begin_object("counters");
+		for (int i = 0; i < rec->num_counters; i++)
+			output_uint(names[i], names[i],
+				    (unsigned long long)rec->counters[i]);
+		output_end_object();
+		output_end_object();
+		return;
+	}
+
+	output_printf("%llu.%03llu %s.%u link=%s",
+		      (unsigned long long)(rec->timestamp / 1000000000),
+		      (unsigned long long)(rec->timestamp % 1000000000) /
+		      1000000,
+		      rec->obj_type == STATS_OBJ_DPNI ? "dpni" : "dpmac",
+		      rec->obj_id, link);
+	for (int i = 0; i < rec->num_counters; i++)
+		output_printf(" %s=%llu", names[i],
+			      (unsigned long long)rec->counters[i]);
+	output_printf("\n");
+}
+
+static int cmd_stats_dump(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool stats dump [--file=<path>] [--since=<t>]\n"
+		"\n"
+		"Prints the records of a ring file written by 'restool stats record',\n"
+		"oldest first, one line per object sample.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--file=<path>\n"
+		"   Ring file. Default is " STATS_DEFAULT_FILE ".\n"
+		"--since=<t>\n"
+		"   Only print records taken after <t>, either <n>[s|m|h] ago or\n"
+		"   @<seconds since the epoch>. Default is all records.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Show the last 5 minutes:\n"
+		"   $ restool stats dump --since=5m\n"
+		"\n";
+
+	const char *path = STATS_DEFAULT_FILE;
+	struct stats_ring_header *hdr;
+	uint64_t since = 0;
+	uint64_t head, first;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(DUMP_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(DUMP_OPT_HELP);
+		return 0;
+	}
+
+	if (ctx->obj_name != NULL) {
+		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
+			     ctx->obj_name);
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(DUMP_OPT_FILE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(DUMP_OPT_FILE);
+		path = ctx->cmd_option_args[DUMP_OPT_FILE];
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(DUMP_OPT_SINCE)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(DUMP_OPT_SINCE);
+		error = stats_parse_since(
+				ctx->cmd_option_args[DUMP_OPT_SINCE],
+				&since);
+		if (error < 0) {
+			ERROR_PRINTF("Invalid since value: \'%s\'\n",
+				     ctx->cmd_option_args[DUMP_OPT_SINCE]);
+			puts(usage_msg);
+			return error;
+		}
+	}
+
+	hdr = stats_map_ring(path, 0);
+	if (hdr == NULL)
+		return -EIO;
+
+	head = __atomic_load_n(&hdr->head, __ATOMIC_ACQUIRE);
+	first = head > hdr->capacity ? head - hdr->capacity : 0;
+	output_begin_array("records");
+	for (uint64_t n = first; n < head; n++) {
+		struct stats_record *slot = stats_ring_slot(hdr, n);
+		struct stats_record rec;
+
+		/* the recorder may be overwriting the slot right now */
+		if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != n + 1)
+			continue;
+		memcpy(&rec, slot, sizeof(rec));
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != n + 1)
+			continue;
+
+		if (rec.timestamp < since ||
+		    rec.num_counters > STATS_MAX_COUNTERS)
+			continue;
+
+		stats_print_record(&rec);
+	}
+	output_end_array();
+
+	stats_unmap_ring(hdr);
+	return 0;
+}
+
+struct object_command stats_commands[] = {
+	{ .cmd_name = "help",
+	  .options = NULL,
+	  .cmd_func = cmd_stats_help },
+
+	{ .cmd_name = "record",
+	  .options = stats_record_options,
+	  .cmd_func = cmd_stats_record,
+	  .priority = CMD_PRIORITY_HIGH },
+
+	{ .cmd_name = "dump",
+	  .options = stats_dump_options,
+	  .cmd_func = cmd_stats_dump },
+
+	{ .cmd_name = NULL },
+};
@@ -0,0 +1,656 @@
+/* Copyright 2018 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <assert.h>
+#include <getopt.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include "restool.h"
+#include "utils.h"
+#include "mc_v10/fsl_dprc.h"
+#include "mc_v10/fsl_dpni.h"
+#include "mc_v10/fsl_dpmac.h"
+
+#define TOP_DEFAULT_INTERVAL_MS		1000
+#define TOP_MAX_INTERVAL_MS		3600000
+#define TOP_DEFAULT_MAX_CMDS		128
+
+/* MC commands needed to sample one object */
+#define TOP_DPNI_CMDS			3
+#define TOP_DPMAC_CMDS			ARRAY_SIZE(top_dpmac_counters)
+
+/**
+ * top command options
+ */
+enum top_options {
+	TOP_OPT_HELP = 0,
+	TOP_OPT_INTERVAL,
+	TOP_OPT_SORT,
+	TOP_OPT_MAX_CMDS,
+	TOP_OPT_COUNT,
+};
+
+static struct option top_options[] = {
+	[TOP_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[TOP_OPT_INTERVAL] = {
+		.name = "interval",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[TOP_OPT_SORT] = {
+		.name = "sort",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[TOP_OPT_MAX_CMDS] = {
+		.name = "max-cmds",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[TOP_OPT_COUNT] = {
+		.name = "count",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(top_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+enum top_sort_key {
+	TOP_SORT_PPS = 0,
+	TOP_SORT_BPS,
+	TOP_SORT_DISCARDS,
+};
+
+/**
+ * DPMAC counters read on each sample, in the order they are stored
+ */
+enum top_dpmac_counter_index {
+	TOP_DPMAC_RX_FRAMES = 0,
+	TOP_DPMAC_RX_BYTES,
+	TOP_DPMAC_RX_DISCARDS,
+	TOP_DPMAC_TX_FRAMES,
+	TOP_DPMAC_TX_BYTES,
+	TOP_DPMAC_TX_ERRORS,
+};
+
+static const enum dpmac_counter top_dpmac_counters[] = {
+	[TOP_DPMAC_RX_FRAMES] = DPMAC_CNT_ING_ALL_FRAME,
+	[TOP_DPMAC_RX_BYTES] = DPMAC_CNT_ING_BYTE,
+	[TOP_DPMAC_RX_DISCARDS] = DPMAC_CNT_ING_FRAME_DISCARD,
+	[TOP_DPMAC_TX_FRAMES] = DPMAC_CNT_ENG_GOOD_FRAME,
+	[TOP_DPMAC_TX_BYTES] = DPMAC_CNT_EGR_BYTE,
+	[TOP_DPMAC_TX_ERRORS] = DPMAC_CNT_EGR_ERR_FRAME,
+};
+
+/**
+ * Cumulative counters of one object, as read from the MC
+ */
+struct top_counters {
+	uint64_t rx_frames;
+	uint64_t rx_bytes;
+	uint64_t tx_frames;
+	uint64_t tx_bytes;
+	uint64_t discards;
+};
+
+struct top_obj {
+	char type[OBJ_TYPE_MAX_LENGTH + 1];
+	int id;
+	uint16_t handle;
+	/* number of samples taken, rates are valid from the second one */
+	unsigned int samples;
+	/* not sampled on the last refresh because of the command budget */
+	bool stale;
+	struct timespec last_time;
+	struct top_counters last;
+	double rx_pps;
+	double tx_pps;
+	double rx_bps;
+	double tx_bps;
+	double discard_rate;
+};
+
+static __thread struct top_obj *top_objs;
+/* display order, top_objs itself keeps the sampling order */
+static __thread struct top_obj **top_view;
+static __thread int top_num_objs;
+static __thread int top_max_objs;
+static __thread enum top_sort_key top_sort_key;
+
+static int top_add_cb(struct restool *ctx, uint32_t parent_dprc_id,
+		      uint16_t parent_dprc_handle,
+		      struct dprc_obj_desc *obj_desc,
+		      void *arg)
+{
+	struct top_obj *obj;
+	int error;
+
+	(void)parent_dprc_id;
+	(void)parent_dprc_handle;
+	(void)arg;
+
+	if (strcmp(obj_desc->type, "dpni") != 0 &&
+	    strcmp(obj_desc->type, "dpmac") != 0)
+		return 0;
+
+	if (top_num_objs == top_max_objs) {
+		int max_objs = top_max_objs ? top_max_objs * 2 : 32;
+
+		obj = realloc(top_objs, max_objs * sizeof(*obj));
+		if (obj == NULL) {
+			ERROR_PRINTF("realloc() failed\n");
+			return -ENOMEM;
+		}
+
+		top_objs = obj;
+		top_max_objs = max_objs;
+	}
+
+	obj = &top_objs[top_num_objs];
+	memset(obj, 0, sizeof(*obj));
+	strncpy(obj->type, obj_desc->type, OBJ_TYPE_MAX_LENGTH);
+	obj->id = obj_desc->id;
+
+	if (strcmp(obj->type, "dpni") == 0)
+		error = dpni_open_v10(&ctx->mc_io, ctx->cmd_flags, obj->id,
+				      &obj->handle);
+	else
+		error = dpmac_open_v10(&ctx->mc_io, ctx->cmd_flags, obj->id,
+				       &obj->handle);
+	if (error < 0) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		return error;
+	}
+
+	top_num_objs++;
+	return 0;
+}
+
+static void top_close_all(struct restool *ctx)
+{
+	for (int i = 0; i < top_num_objs; i++) {
+		if (strcmp(top_objs[i].type, "dpni") == 0)
+			(void)dpni_close_v10(&ctx->mc_io, ctx->cmd_flags,
+					     top_objs[i].handle);
+		else
+			(void)dpmac_close_v10(&ctx->mc_io, ctx->cmd_flags,
+					      top_objs[i].handle);
+	}
+
+	free(top_view);
+	top_view = NULL;
+	free(top_objs);
+	top_objs = NULL;
+	top_num_objs = 0;
+	top_max_objs = 0;
+}
+
+static int top_obj_cost(const struct top_obj *obj)
+{
+	return strcmp(obj->type, "dpni") == 0 ?
+		TOP_DPNI_CMDS : (int)TOP_DPMAC_CMDS;
+}
+
+static int top_read_dpni(struct restool *ctx, struct top_obj *obj,
+			 struct top_counters *cnt)
+{
+	union dpni_statistics_v10 stats;
+	int error;
+
+	error = dpni_get_statistics_v10(&ctx->mc_io, ctx->cmd_flags,
+					obj->handle,
+					0, 0, &stats);
+	if (error < 0)
+		return error;
+	cnt->rx_frames = stats.page_0.ingress_all_frames;
+	cnt->rx_bytes = stats.page_0.ingress_all_bytes;
+
+	error = dpni_get_statistics_v10(&ctx->mc_io, ctx->cmd_flags,
+					obj->handle,
+					1, 0, &stats);
+	if (error < 0)
+		return error;
+	cnt->tx_frames = stats.page_1.egress_all_frames;
+	cnt->tx_bytes = stats.page_1.egress_all_bytes;
+
+	error = dpni_get_statistics_v10(&ctx->mc_io, ctx->cmd_flags,
+					obj->handle,
+					2, 0, &stats);
+	if (error < 0)
+		return error;
+	cnt->discards = stats.page_2.ingress_discarded_frames +
+			stats.page_2.ingress_nobuffer_discards +
+			stats.page_2.egress_discarded_frames;
+
+	return 0;
+}
+
+static int top_read_dpmac(struct restool *ctx, struct top_obj *obj,
+			  struct top_counters *cnt)
+{
+	uint64_t values[ARRAY_SIZE(top_dpmac_counters)];
+	int error;
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(top_dpmac_counters); i++) {
+		error = dpmac_get_counter_v10(&ctx->mc_io, ctx->cmd_flags,
+					      obj->handle,
+					      top_dpmac_counters[i],
+					      &values[i]);
+		if (error < 0)
+			return error;
+	}
+
+	cnt->rx_frames = values[TOP_DPMAC_RX_FRAMES];
+	cnt->rx_bytes = values[TOP_DPMAC_RX_BYTES];
+	cnt->tx_frames = values[TOP_DPMAC_TX_FRAMES];
+	cnt->tx_bytes = values[TOP_DPMAC_TX_BYTES];
+	cnt->discards = values[TOP_DPMAC_RX_DISCARDS] +
+			values[TOP_DPMAC_TX_ERRORS];
+
+	return 0;
+}
+
+static double top_rate(uint64_t now, uint64_t before, double seconds)
+{
+	/* counters may be reset under our feet */
+	if (now < before)
+		return 0;
+
+	return (double)(now - before) / seconds;
+}
+
+static int top_sample(struct restool *ctx, struct top_obj *obj)
+{
+	struct top_counters cnt;
+	struct timespec now;
+	struct timespec delta;
+	double seconds;
+	int error;
+
+	memset(&cnt, 0, sizeof(cnt));
+	if (strcmp(obj->type, "dpni") == 0)
+		error = top_read_dpni(ctx, obj, &cnt);
+	else
+		error = top_read_dpmac(ctx, obj, &cnt);
+	if (error < 0) {
+		ctx->mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(ctx->mc_status),
+			     ctx->mc_status);
+		return error;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	if (obj->samples != 0) {
+		diff_time(&obj->last_time, &now, &delta);
+		seconds = delta.tv_sec + delta.tv_nsec / 1e9;
+		if (seconds > 0) {
+			obj->rx_pps = top_rate(cnt.rx_frames,
+					       obj->last.rx_frames, seconds);
+			obj->tx_pps = top_rate(cnt.tx_frames,
+					       obj->last.tx_frames, seconds);
+			obj->rx_bps = 8 * top_rate(cnt.rx_bytes,
+						   obj->last.rx_bytes, seconds);
+			obj->tx_bps = 8 * top_rate(cnt.tx_bytes,
+						   obj->last.tx_bytes, seconds);
+			obj->discard_rate = top_rate(cnt.discards,
+						     obj->last.discards,
+						     seconds);
+		}
+	}
+
+	obj->last = cnt;
+	obj->last_time = now;
+	obj->samples++;
+	obj->stale = false;
+
+	return 0;
+}
+
+/**
+ * Samples as many objects as the command budget allows, resuming the
+ * round-robin where the previous refresh stopped. Returns the number
+ * of MC commands sent, or a negative error.
+ */
+static int top_refresh(struct restool *ctx, int *next, long max_cmds)
+{
+	int num_cmds = 0;
+	int i = *next;
+	int error;
+
+	for (int j = 0; j < top_num_objs; j++)
+		top_objs[j].stale = true;
+
+	for (int j = 0; j < top_num_objs; j++) {
+		int cost = top_obj_cost(&top_objs[i]);
+
+		if (max_cmds != 0 && num_cmds + cost > max_cmds)
+			break;
+
+		error = top_sample(ctx, &top_objs[i]);
+		if (error < 0)
+			return error;
+
+		num_cmds += cost;
+		i = (i + 1) % top_num_objs;
+	}
+
+	*next = i;
+	return num_cmds;
+}
+
+static double top_key(const struct top_obj *obj)
+{
+	switch (top_sort_key) {
+	case TOP_SORT_BPS:
+		return obj->rx_bps + obj->tx_bps;
+	case TOP_SORT_DISCARDS:
+		return obj->discard_rate;
+	case TOP_SORT_PPS:
+	default:
+		return obj->rx_pps + obj->tx_pps;
+	}
+}
+
+static int top_compare(const void *a, const void *b)
+{
+	const struct top_obj *obj_a = *(const struct top_obj * const *)a;
+	const struct top_obj *obj_b = *(const struct top_obj * const *)b;
+	double key_a = top_key(obj_a);
+	double key_b = top_key(obj_b);
+	int cmp;
+
+	if (key_a != key_b)
+		return key_a < key_b ? 1 : -1;
+
+	cmp = strcmp(obj_a->type, obj_b->type);
+	if (cmp != 0)
+		return cmp;
+
+	return obj_a->id - obj_b->id;
+}
+
+static void top_draw(int num_cmds, long max_cmds, bool tty)
+{
+	static const char * const sort_names[] = {
+		[TOP_SORT_PPS] = "pps",
+		[TOP_SORT_BPS] = "bps",
+		[TOP_SORT_DISCARDS] = "discards",
+	};
+	int max_rows = top_num_objs;
+	struct winsize ws;
+
+	qsort(top_view, top_num_objs, sizeof(*top_view), top_compare);
+
+	if (tty) {
+		/* cursor home, clear screen */
+		output_printf("\033[H\033[2J");
+		if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0 &&
+		    ws.ws_row > 3 && ws.ws_row - 3 < max_rows)
+			max_rows = ws.ws_row - 3;
+	}
+
+	output_printf("%d objects, %d/%ld MC commands per refresh, sorted by %s\n",
+		      top_num_objs, num_cmds, max_cmds,
+		      sort_names[top_sort_key]);
+	output_printf("%-12s %12s %12s %10s %10s %10s\n", "object", "rx-pps",
+		      "tx-pps", "rx-Mbps", "tx-Mbps", "discard/s");
+
+	for (int i = 0; i < max_rows; i++) {
+		struct top_obj *obj = top_view[i];
+		char name[OBJ_TYPE_MAX_LENGTH + 16];
+
+		snprintf(name, sizeof(name), "%s.%d%s", obj->type, obj->id,
+			 obj->stale ? "*" : "");
+		if (obj->samples < 2) {
+			output_printf("%-12s %12s %12s %10s %10s %10s\n",
+				      name, "-", "-", "-", "-", "-");
+			continue;
+		}
+
+		output_printf("%-12s %12.0f %12.0f %10.1f %10.1f %10.0f\n",
+			      name, obj->rx_pps, obj->tx_pps,
+			      obj->rx_bps / 1e6, obj->tx_bps / 1e6,
+			      obj->discard_rate);
+	}
+
+	if (!tty)
+		output_printf("\n");
+	output_flush();
+}
+
+static int cmd_top(struct restool *ctx)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool top [<container>] [--interval=<ms>]\n"
+		"                   [--sort=<pps|bps|discards>] [--max-cmds=<n>]\n"
+		"                   [--count=<n>]\n"
+		"\n"
+		"Shows the packet, bit and discard rates of the DPNIs and DPMACs in\n"
+		"<container> (root container by default) and its child containers,\n"
+		"busiest objects first.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--interval=<ms>\n"
+		"   Refresh period in milliseconds. Default is 1000.\n"
+		"--sort=<pps|bps|discards>\n"
+		"   Sort key. Default is pps.\n"
+		"--max-cmds=<n>\n"
+		"   Maximum number of MC commands sent per refresh, 0 for no limit.\n"
+		"   A DPNI costs 3 commands, a DPMAC 6. Objects that do not fit are\n"
+		"   sampled on the next refreshes and marked with '*' meanwhile.\n"
+		"   Default is 128.\n"
+		"--count=<n>\n"
+		"   Stop after <n> refreshes. Default is to run until interrupted.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Show the interfaces dropping the most frames:\n"
+		"   $ restool top --sort=discards\n"
+		"\n";
+
+	long interval_ms = TOP_DEFAULT_INTERVAL_MS;
+	long max_cmds = TOP_DEFAULT_MAX_CMDS;
+	long count = 0;
+	sigset_t old_mask;
+	struct timespec period;
+	uint32_t dprc_id;
+	uint16_t dprc_handle;
+	bool dprc_opened = false;
+	bool tty;
+	int next = 0;
+	int error;
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TOP_OPT_HELP)) {
+		puts(usage_msg);
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TOP_OPT_HELP);
+		return 0;
+	}
+
+	/* a live view, 'stats record' and 'stats dump' are for scripts */
+	if (output_is_json()) {
+		ERROR_PRINTF("top has no JSON output, use stats record/dump\n");
+		return -EINVAL;
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TOP_OPT_INTERVAL)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TOP_OPT_INTERVAL);
+		error = get_option_value(ctx, TOP_OPT_INTERVAL, &interval_ms,
+					 "Invalid interval value",
+					 1, TOP_MAX_INTERVAL_MS);
+		if (error)
+			return -EINVAL;
+	}
+
+	top_sort_key = TOP_SORT_PPS;
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TOP_OPT_SORT)) {
+		char *sort = ctx->cmd_option_args[TOP_OPT_SORT];
+
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TOP_OPT_SORT);
+		if (strcmp(sort, "pps") == 0) {
+			top_sort_key = TOP_SORT_PPS;
+		} else if (strcmp(sort, "bps") == 0) {
+			top_sort_key = TOP_SORT_BPS;
+		} else if (strcmp(sort, "discards") == 0) {
+			top_sort_key = TOP_SORT_DISCARDS;
+		} else {
+			ERROR_PRINTF("Invalid sort key: \'%s\'\n", sort);
+			puts(usage_msg);
+			return -EINVAL;
+		}
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TOP_OPT_MAX_CMDS)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TOP_OPT_MAX_CMDS);
+		error = get_option_value(ctx, TOP_OPT_MAX_CMDS, &max_cmds,
+					 "Invalid max-cmds value",
+					 0, INT_MAX);
+		if (error)
+			return -EINVAL;
+
+		if (max_cmds != 0 && max_cmds < (long)TOP_DPMAC_CMDS) {
+			ERROR_PRINTF("max-cmds must be at least %d\n",
+				     (int)TOP_DPMAC_CMDS);
+			return -EINVAL;
+		}
+	}
+
+	if (ctx->cmd_option_mask & ONE_BIT_MASK(TOP_OPT_COUNT)) {
+		ctx->cmd_option_mask &= ~ONE_BIT_MASK(TOP_OPT_COUNT);
+		error = get_option_value(ctx, TOP_OPT_COUNT, &count,
+					 "Invalid count value", 1, LONG_MAX);
+		if (error)
+			return -EINVAL;
+	}
+
+	dprc_id = ctx->root_dprc_id;
+	dprc_handle = ctx->root_dprc_handle;
+	if (ctx->obj_name != NULL) {
+		error = parse_object_name(ctx->obj_name, "dprc", &dprc_id);
+		if (error < 0)
+			return error;
+
+		if (dprc_id != ctx->root_dprc_id) {
+			error = open_dprc(ctx, dprc_id, &dprc_handle);
+			if (error < 0)
+				return error;
+			dprc_opened = true;
+		}
+	}
+
+	error = walk_dprc_tree(ctx, dprc_id, dprc_handle, 0, top_add_cb, NULL);
+	if (dprc_opened)
+		(void)dprc_close(&ctx->mc_io, ctx->cmd_flags, dprc_handle);
+	if (error < 0)
+		goto out;
+
+	if (top_num_objs == 0) {
+		output_printf("No DPNI or DPMAC objects found\n");
+		goto out;
+	}
+
+	top_view = malloc(top_num_objs * sizeof(*top_view));
+	if (top_view == NULL) {
+		ERROR_PRINTF("malloc() failed\n");
+		error = -ENOMEM;
+		goto out;
+	}
+
+	for (int i = 0; i < top_num_objs; i++)
+		top_view[i] = &top_objs[i];
+
+	period.tv_sec = interval_ms / 1000;
+	period.tv_nsec = (interval_ms % 1000) * 1000000;
+	tty = isatty(STDOUT_FILENO);
+
+	/* first pass only primes the counters */
+	error = top_refresh(ctx, &next, max_cmds);
+	if (error < 0)
+		goto out;
+
+	block_stop_signals(&old_mask);
+	for (long refreshes = 1; ; refreshes++) {
+		if (wait_stop(ctx, &period))
+			break;
+
+		error = top_refresh(ctx, &next, max_cmds);
+		if (error < 0)
+			break;
+
+		top_draw(error, max_cmds, tty);
+
+		if (count != 0 && refreshes >= count)
+			break;
+	}
+	unblock_stop_signals(ctx, &old_mask);
+	if (error < 0)
+		goto out;
+
+	error = 0;
+out:
+	top_close_all(ctx);
+	return error;
+}
+
+struct object_command top_commands[] = {
+	{ .cmd_name = "top",
+	  .options = top_options,
+	  .cmd_func = cmd_top,
+	  .priority = CMD_PRIORITY_HIGH },
+
+	{ .cmd_name = NULL },
+};
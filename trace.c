@@ -0,0 +1,518 @@
+/* Copyright 2018 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <endian.h>
+#include <ctype.h>
+#include "restool.h"
+#include "utils.h"
+#include "mc_v10/fsl_dpaiop_cmd.h"
+#include "mc_v10/fsl_dpbp_cmd.h"
+#include "mc_v10/fsl_dpci_cmd.h"
+#include "mc_v10/fsl_dpcon_cmd.h"
+#include "mc_v10/fsl_dpdcei_cmd.h"
+#include "mc_v10/fsl_dpdmai_cmd.h"
+#include "mc_v10/fsl_dpdmux_cmd.h"
+#include "mc_v10/fsl_dpio_cmd.h"
+#include "mc_v10/fsl_dpmac_cmd.h"
+#include "mc_v10/fsl_dpmcp_cmd.h"
+#include "mc_v10/fsl_dpmng_cmd.h"
+#include "mc_v10/fsl_dpni_cmd.h"
+#include "mc_v10/fsl_dprc_cmd.h"
+#include "mc_v10/fsl_dprtc_cmd.h"
+#include "mc_v10/fsl_dpseci_cmd.h"
+#include "mc_v10/fsl_dpsw_cmd.h"
+
+/**
+ * Deepest span nesting recorded; deeper spans are dropped
+ */
+#define TRACE_MAX_DEPTH		8
+
+#define TRACE_NAME_SIZE		64
+
+/**
+ * Initial size of the event buffer, it grows as needed
+ */
+#define TRACE_BUF_SIZE		16384
+
+struct trace_span {
+	char name[TRACE_NAME_SIZE];
+	char args[TRACE_NAME_SIZE];
+	uint64_t start_ns;
+};
+
+static __thread struct {
+	FILE *fp;
+	char *buf;
+	size_t len;
+	size_t size;
+	int depth;
+	struct trace_span spans[TRACE_MAX_DEPTH];
+
+	/* open command in flight, its token is recorded on success */
+	const struct trace_cmd *open_cmd;
+	/* trace_cmds index + 1 of the open that returned each token */
+	uint8_t token_cmds[UINT16_MAX + 1];
+	/* thread that opened the trace, the only one recording to it */
+	pid_t tid;
+} trace;
+
+#define TRACE_CMD(_prefix, _name) { \
+	.prefix = #_prefix, \
+	.name = #_name, \
+	.cmd_id = MC_CMDID(_prefix##_CMDID_##_name), \
+}
+
+struct trace_cmd {
+	const char *prefix;
+	const char *name;
+	uint16_t cmd_id;
+};
+
+/**
+ * Every *_CMDID_* define of the v10 flib. The same id means different
+ * commands for different objects, so the object type is taken from the
+ * token, see trace.token_cmds.
+ */
+static const struct trace_cmd trace_cmds[] = {
+	TRACE_CMD(DPAIOP, CLOSE),
+	TRACE_CMD(DPAIOP, OPEN),
+	TRACE_CMD(DPAIOP, CREATE),
+	TRACE_CMD(DPAIOP, DESTROY),
+	TRACE_CMD(DPAIOP, GET_API_VERSION),
+	TRACE_CMD(DPAIOP, GET_ATTR),
+	TRACE_CMD(DPAIOP, GET_IRQ_MASK),
+	TRACE_CMD(DPAIOP, GET_IRQ_STATUS),
+	TRACE_CMD(DPAIOP, GET_SL_VERSION),
+	TRACE_CMD(DPAIOP, GET_STATE),
+	TRACE_CMD(DPBP, CLOSE),
+	TRACE_CMD(DPBP, OPEN),
+	TRACE_CMD(DPBP, CREATE),
+	TRACE_CMD(DPBP, DESTROY),
+	TRACE_CMD(DPBP, GET_API_VERSION),
+	TRACE_CMD(DPBP, GET_ATTR),
+	TRACE_CMD(DPBP, GET_IRQ_MASK),
+	TRACE_CMD(DPBP, GET_IRQ_STATUS),
+	TRACE_CMD(DPCI, CLOSE),
+	TRACE_CMD(DPCI, OPEN),
+	TRACE_CMD(DPCI, CREATE),
+	TRACE_CMD(DPCI, DESTROY),
+	TRACE_CMD(DPCI, GET_API_VERSION),
+	TRACE_CMD(DPCI, GET_ATTR),
+	TRACE_CMD(DPCI, GET_PEER_ATTR),
+	TRACE_CMD(DPCI, GET_IRQ_MASK),
+	TRACE_CMD(DPCI, GET_IRQ_STATUS),
+	TRACE_CMD(DPCI, GET_LINK_STATE),
+	TRACE_CMD(DPCON, CLOSE),
+	TRACE_CMD(DPCON, OPEN),
+	TRACE_CMD(DPCON, CREATE),
+	TRACE_CMD(DPCON, DESTROY),
+	TRACE_CMD(DPCON, GET_API_VERSION),
+	TRACE_CMD(DPCON, GET_ATTR),
+	TRACE_CMD(DPCON, GET_IRQ_MASK),
+	TRACE_CMD(DPCON, GET_IRQ_STATUS),
+	TRACE_CMD(DPDCEI, CLOSE),
+	TRACE_CMD(DPDCEI, OPEN),
+	TRACE_CMD(DPDCEI, CREATE),
+	TRACE_CMD(DPDCEI, DESTROY),
+	TRACE_CMD(DPDCEI, GET_API_VERSION),
+	TRACE_CMD(DPDCEI, GET_ATTR),
+	TRACE_CMD(DPDCEI, GET_IRQ_MASK),
+	TRACE_CMD(DPDCEI, GET_IRQ_STATUS),
+	TRACE_CMD(DPDMAI, CLOSE),
+	TRACE_CMD(DPDMAI, OPEN),
+	TRACE_CMD(DPDMAI, CREATE),
+	TRACE_CMD(DPDMAI, DESTROY),
+	TRACE_CMD(DPDMAI, GET_API_VERSION),
+	TRACE_CMD(DPDMAI, GET_ATTR),
+	TRACE_CMD(DPDMAI, GET_IRQ_MASK),
+	TRACE_CMD(DPDMAI, GET_IRQ_STATUS),
+	TRACE_CMD(DPDMUX, CLOSE),
+	TRACE_CMD(DPDMUX, OPEN),
+	TRACE_CMD(DPDMUX, CREATE),
+	TRACE_CMD(DPDMUX, DESTROY),
+	TRACE_CMD(DPDMUX, GET_API_VERSION),
+	TRACE_CMD(DPDMUX, GET_ATTR),
+	TRACE_CMD(DPDMUX, GET_IRQ_MASK),
+	TRACE_CMD(DPDMUX, GET_IRQ_STATUS),
+	TRACE_CMD(DPDMUX, IF_ADD_L2_RULE),
+	TRACE_CMD(DPDMUX, IF_REMOVE_L2_RULE),
+	TRACE_CMD(DPDMUX, SET_CUSTOM_KEY),
+	TRACE_CMD(DPDMUX, ADD_CUSTOM_CLS_ENTRY),
+	TRACE_CMD(DPDMUX, REMOVE_CUSTOM_CLS_ENTRY),
+	TRACE_CMD(DPIO, CLOSE),
+	TRACE_CMD(DPIO, OPEN),
+	TRACE_CMD(DPIO, CREATE),
+	TRACE_CMD(DPIO, DESTROY),
+	TRACE_CMD(DPIO, GET_API_VERSION),
+	TRACE_CMD(DPIO, GET_ATTR),
+	TRACE_CMD(DPIO, GET_IRQ_MASK),
+	TRACE_CMD(DPIO, GET_IRQ_STATUS),
+	TRACE_CMD(DPMAC, CLOSE),
+	TRACE_CMD(DPMAC, OPEN),
+	TRACE_CMD(DPMAC, CREATE),
+	TRACE_CMD(DPMAC, DESTROY),
+	TRACE_CMD(DPMAC, GET_API_VERSION),
+	TRACE_CMD(DPMAC, GET_ATTR),
+	TRACE_CMD(DPMAC, GET_IRQ_MASK),
+	TRACE_CMD(DPMAC, GET_IRQ_STATUS),
+	TRACE_CMD(DPMAC, GET_COUNTER),
+	TRACE_CMD(DPMCP, CLOSE),
+	TRACE_CMD(DPMCP, OPEN),
+	TRACE_CMD(DPMCP, CREATE),
+	TRACE_CMD(DPMCP, DESTROY),
+	TRACE_CMD(DPMCP, GET_API_VERSION),
+	TRACE_CMD(DPMCP, GET_ATTR),
+	TRACE_CMD(DPMCP, GET_IRQ_MASK),
+	TRACE_CMD(DPMCP, GET_IRQ_STATUS),
+	TRACE_CMD(DPMNG, GET_VERSION),
+	TRACE_CMD(DPMNG, GET_SOC_VERSION),
+	TRACE_CMD(DPNI, OPEN),
+	TRACE_CMD(DPNI, CLOSE),
+	TRACE_CMD(DPNI, CREATE),
+	TRACE_CMD(DPNI, DESTROY),
+	TRACE_CMD(DPNI, GET_API_VERSION),
+	TRACE_CMD(DPNI, GET_ATTR),
+	TRACE_CMD(DPNI, SET_PRIM_MAC),
+	TRACE_CMD(DPNI, GET_PRIM_MAC),
+	TRACE_CMD(DPNI, GET_STATISTICS),
+	TRACE_CMD(DPNI, GET_LINK_STATE),
+	TRACE_CMD(DPNI, GET_IRQ_STATUS),
+	TRACE_CMD(DPNI, SET_RX_TC_DIST),
+	TRACE_CMD(DPNI, ADD_FS_ENT),
+	TRACE_CMD(DPNI, REMOVE_FS_ENT),
+	TRACE_CMD(DPNI, CLR_FS_ENT),
+	TRACE_CMD(DPNI, SET_POOLS),
+	TRACE_CMD(DPNI, SET_BUFFER_LAYOUT),
+	TRACE_CMD(DPNI, SET_TAILDROP),
+	TRACE_CMD(DPNI, GET_TAILDROP),
+	TRACE_CMD(DPNI, SET_CONGESTION_NOTIFICATION),
+	TRACE_CMD(DPNI, GET_CONGESTION_NOTIFICATION),
+	TRACE_CMD(DPNI, SET_TX_PRIORITIES),
+	TRACE_CMD(DPNI, SET_TX_SHAPING),
+	TRACE_CMD(DPNI, GET_QUEUE),
+	TRACE_CMD(DPNI, GET_OFFLOAD),
+	TRACE_CMD(DPNI, SET_OFFLOAD),
+	TRACE_CMD(DPNI, ADD_MAC_ADDR),
+	TRACE_CMD(DPNI, REMOVE_MAC_ADDR),
+	TRACE_CMD(DPNI, CLR_MAC_FILTERS),
+	TRACE_CMD(DPNI, ENABLE_VLAN_FILTER),
+	TRACE_CMD(DPNI, ADD_VLAN_ID),
+	TRACE_CMD(DPNI, REMOVE_VLAN_ID),
+	TRACE_CMD(DPNI, CLR_VLAN_FILTERS),
+	TRACE_CMD(DPRC, CLOSE),
+	TRACE_CMD(DPRC, OPEN),
+	TRACE_CMD(DPRC, GET_API_VERSION),
+	TRACE_CMD(DPRC, GET_ATTR),
+	TRACE_CMD(DPRC, CREATE_CONT),
+	TRACE_CMD(DPRC, DESTROY_CONT),
+	TRACE_CMD(DPRC, GET_IRQ_MASK),
+	TRACE_CMD(DPRC, GET_IRQ_STATUS),
+	TRACE_CMD(DPRC, GET_CONT_ID),
+	TRACE_CMD(DPRC, ASSIGN),
+	TRACE_CMD(DPRC, UNASSIGN),
+	TRACE_CMD(DPRC, GET_OBJ_COUNT),
+	TRACE_CMD(DPRC, GET_OBJ),
+	TRACE_CMD(DPRC, GET_RES_COUNT),
+	TRACE_CMD(DPRC, GET_RES_IDS),
+	TRACE_CMD(DPRC, SET_OBJ_LABEL),
+	TRACE_CMD(DPRC, GET_OBJ_DESC),
+	TRACE_CMD(DPRC, CONNECT),
+	TRACE_CMD(DPRC, DISCONNECT),
+	TRACE_CMD(DPRC, GET_POOL),
+	TRACE_CMD(DPRC, GET_POOL_COUNT),
+	TRACE_CMD(DPRC, GET_CONNECTION),
+	TRACE_CMD(DPRTC, CLOSE),
+	TRACE_CMD(DPRTC, OPEN),
+	TRACE_CMD(DPRTC, CREATE),
+	TRACE_CMD(DPRTC, DESTROY),
+	TRACE_CMD(DPRTC, GET_API_VERSION),
+	TRACE_CMD(DPRTC, GET_ATTR),
+	TRACE_CMD(DPRTC, GET_IRQ_MASK),
+	TRACE_CMD(DPRTC, GET_IRQ_STATUS),
+	TRACE_CMD(DPSECI, CLOSE),
+	TRACE_CMD(DPSECI, OPEN),
+	TRACE_CMD(DPSECI, CREATE),
+	TRACE_CMD(DPSECI, DESTROY),
+	TRACE_CMD(DPSECI, GET_API_VERSION),
+	TRACE_CMD(DPSECI, GET_ATTR),
+	TRACE_CMD(DPSECI, GET_IRQ_MASK),
+	TRACE_CMD(DPSECI, GET_IRQ_STATUS),
+	TRACE_CMD(DPSECI, GET_TX_QUEUE),
+	TRACE_CMD(DPSW, CLOSE),
+	TRACE_CMD(DPSW, OPEN),
+	TRACE_CMD(DPSW, CREATE),
+	TRACE_CMD(DPSW, DESTROY),
+	TRACE_CMD(DPSW, GET_API_VERSION),
+	TRACE_CMD(DPSW, GET_ATTR),
+	TRACE_CMD(DPSW, GET_IRQ_MASK),
+	TRACE_CMD(DPSW, GET_IRQ_STATUS),
+};
+
+/* trace.token_cmds holds indexes into trace_cmds */
+C_ASSERT(ARRAY_SIZE(trace_cmds) < UINT8_MAX);
+
+static uint64_t trace_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void trace_append(const char *fmt, ...)
+	__attribute__((format(printf, 1, 2)));
+
+static void trace_append(const char *fmt, ...)
+{
+	va_list ap;
+	int n;
+
+	if (trace.buf == NULL)
+		return;
+
+	for (;;) {
+		va_start(ap, fmt);
+		n = vsnprintf(trace.buf + trace.len, trace.size - trace.len,
+			      fmt, ap);
+		va_end(ap);
+		if (n < 0)
+			return;
+
+		if (trace.len + n < trace.size)
+			break;
+
+		char *buf = realloc(trace.buf, 2 * trace.size + n);
+
+		if (buf == NULL) {
+			/* keep what was recorded so far */
+			trace.buf[trace.len] = '\0';
+			return;
+		}
+		trace.buf = buf;
+		trace.size = 2 * trace.size + n;
+	}
+
+	trace.len += n;
+}
+
+int trace_open(const char *path)
+{
+	if (path == NULL || *path == '\0') {
+		ERROR_PRINTF("--trace requires a file name\n");
+		return -EINVAL;
+	}
+
+	trace.fp = fopen(path, "w");
+	if (trace.fp == NULL) {
+		ERROR_PRINTF("cannot open %s: %s\n", path, strerror(errno));
+		return -errno;
+	}
+
+	trace.buf = malloc(TRACE_BUF_SIZE);
+	if (trace.buf == NULL) {
+		fclose(trace.fp);
+		trace.fp = NULL;
+		return -ENOMEM;
+	}
+
+	trace.size = TRACE_BUF_SIZE;
+	trace.len = 0;
+	trace.tid = syscall(SYS_gettid);
+	trace.depth = 0;
+	return 0;
+}
+
+static void trace_begin_args(const char *name, const char *args)
+{
+	struct trace_span *span;
+
+	if (trace.fp == NULL)
+		return;
+
+	/* spans past the limit are not recorded, but still counted */
+	if (trace.depth++ >= TRACE_MAX_DEPTH)
+		return;
+
+	span = &trace.spans[trace.depth - 1];
+	snprintf(span->name, sizeof(span->name), "%s", name);
+	/* names can come from the command line, keep the JSON valid */
+	for (char *c = span->name; *c != '\0'; c++) {
+		if (*c == '"' || *c == '\\' || (unsigned char)*c < ' ')
+			*c = '_';
+	}
+	snprintf(span->args, sizeof(span->args), "%s", args);
+	span->start_ns = trace_now_ns();
+}
+
+void trace_begin(const char *name)
+{
+	trace_begin_args(name, "");
+}
+
+void trace_end(void)
+{
+	struct trace_span *span;
+	uint64_t end_ns;
+
+	if (trace.fp == NULL || trace.depth == 0)
+		return;
+
+	if (trace.depth-- > TRACE_MAX_DEPTH)
+		return;
+
+	span = &trace.spans[trace.depth];
+	end_ns = trace_now_ns();
+	trace_append("%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,"
+		     "\"ts\":%llu.%03llu,\"dur\":%llu.%03llu,\"args\":{%s}}",
+		     trace.len == 0 ? "" : ",\n",
+		     span->name, (int)getpid(), (int)trace.tid,
+		     (unsigned long long)(span->start_ns / 1000),
+		     (unsigned long long)(span->start_ns % 1000),
+		     (unsigned long long)((end_ns - span->start_ns) / 1000),
+		     (unsigned long long)((end_ns - span->start_ns) % 1000),
+		     span->args);
+}
+
+static const struct trace_cmd *trace_find_cmd(uint16_t cmd_id,
+					      uint16_t token,
+					      bool *ambiguous)
+{
+	const struct trace_cmd *found = NULL;
+	const char *prefix = NULL;
+	unsigned int matches = 0;
+
+	if (trace.token_cmds[token] != 0)
+		prefix = trace_cmds[trace.token_cmds[token] - 1].prefix;
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(trace_cmds); i++) {
+		if (trace_cmds[i].cmd_id != cmd_id)
+			continue;
+
+		if (prefix != NULL &&
+		    strcmp(trace_cmds[i].prefix, prefix) == 0) {
+			*ambiguous = false;
+			return &trace_cmds[i];
+		}
+
+		if (found == NULL)
+			found = &trace_cmds[i];
+		matches++;
+	}
+
+	*ambiguous = matches > 1;
+	return found;
+}
+
+void trace_mc_begin(const struct restool *ctx, uint64_t header)
+{
+	const struct trace_cmd *cmd;
+	char name[TRACE_NAME_SIZE];
+	char args[TRACE_NAME_SIZE];
+	uint16_t cmd_id;
+	uint16_t token;
+	bool ambiguous;
+	int len = 0;
+
+	if (trace.fp == NULL)
+		return;
+
+	cmd_id = mc_header_cmd_id(header);
+	token = mc_header_token(ctx, header);
+	cmd = trace_find_cmd(cmd_id, token, &ambiguous);
+	if (cmd == NULL) {
+		snprintf(name, sizeof(name), "mc_cmd_%#05x", cmd_id);
+	} else {
+		/* "dpni_get_link_state", or "close" if the type is unknown */
+		if (!ambiguous)
+			len = snprintf(name, sizeof(name), "%s_", cmd->prefix);
+		snprintf(name + len, sizeof(name) - len, "%s", cmd->name);
+		for (char *c = name; *c != '\0'; c++)
+			*c = tolower((unsigned char)*c);
+	}
+
+	trace.open_cmd = NULL;
+	if (cmd != NULL && strcmp(cmd->name, "OPEN") == 0)
+		trace.open_cmd = cmd;
+
+	snprintf(args, sizeof(args), "\"cmd_id\":\"%#05x\",\"token\":%u",
+		 cmd_id, token);
+	trace_begin_args(name, args);
+}
+
+void trace_mc_end(const struct restool *ctx, uint64_t header, int error)
+{
+	struct trace_span *span;
+	size_t len;
+
+	if (trace.fp == NULL || trace.depth == 0)
+		return;
+
+	if (error == 0 && trace.open_cmd != NULL)
+		trace.token_cmds[mc_header_token(ctx, header)] =
+			trace.open_cmd - trace_cmds + 1;
+	trace.open_cmd = NULL;
+
+	if (error != 0 && trace.depth <= TRACE_MAX_DEPTH) {
+		span = &trace.spans[trace.depth - 1];
+		len = strlen(span->args);
+		snprintf(span->args + len, sizeof(span->args) - len,
+			 ",\"error\":%d", error);
+	}
+	trace_end();
+}
+
+void trace_close(void)
+{
+	if (trace.fp == NULL)
+		return;
+
+	while (trace.depth > 0)
+		trace_end();
+
+	fprintf(trace.fp, "{\"traceEvents\":[\n%s\n],"
+		"\"displayTimeUnit\":\"ms\"}\n",
+		trace.buf != NULL ? trace.buf : "");
+	if (fclose(trace.fp) != 0)
+		ERROR_PRINTF("cannot write trace file: %s\n",
+			     strerror(errno));
+
+	free(trace.buf);
+	trace.buf = NULL;
+	trace.fp = NULL;
+}